@@ -26,7 +26,7 @@
 
 // Version number for shader translation API.
 // It is incremented every time the API changes.
-#define ANGLE_SH_VERSION 350
+#define ANGLE_SH_VERSION 351
 
 enum ShShaderSpec
 {
@@ -787,6 +787,47 @@ bool Compile(const ShHandle handle,
 // Clears the results from the previous compilation.
 void ClearResults(const ShHandle handle);
 
+//
+// Translator output cache.  Compilers that share a cache skip translating a shader that was
+// already compiled with the same source, shader type, spec, output type, resources and compile
+// options, and return the previous object code, info log and variables instead.  Only successful
+// compilations are cached.  HLSL output is never cached.  A cache may be used by compilers on
+// different threads.
+//
+class TranslatorCache;
+
+// Creates a cache holding up to |maxSize| bytes of translator output in memory.
+TranslatorCache *CreateTranslatorCache(size_t maxSize);
+void DestroyTranslatorCache(TranslatorCache *cache);
+
+// Optional persistent storage for the cache, for example to share translations between processes.
+// The functions have the same semantics as those of EGL_ANDROID_blob_cache: |get| returns the size
+// of the value stored for |key|, or 0 if none, and only copies it if |valueSize| is large enough.
+using TranslatorCacheSetFunc = void (*)(const void *key,
+                                        size_t keySize,
+                                        const void *value,
+                                        size_t valueSize,
+                                        void *userData);
+using TranslatorCacheGetFunc = size_t (*)(const void *key,
+                                          size_t keySize,
+                                          void *value,
+                                          size_t valueSize,
+                                          void *userData);
+void SetTranslatorCacheStorage(TranslatorCache *cache,
+                               TranslatorCacheSetFunc set,
+                               TranslatorCacheGetFunc get,
+                               void *userData);
+
+// Makes Compile() use |cache|.  Pass nullptr to stop using a cache.
+// Parameters:
+// handle: Specifies the compiler
+void SetTranslatorCache(const ShHandle handle, TranslatorCache *cache);
+
+// Returns true if the results of the last Compile() were found in the translator cache.
+// Parameters:
+// handle: Specifies the compiler
+bool IsCompileResultFromCache(const ShHandle handle);
+
 // Return the version of the shader language.
 int GetShaderVersion(const ShHandle handle);
 
@@ -76,6 +76,14 @@ struct FeaturesVk : FeatureSetBase
         &members, "https://anglebug.com/7308"
     };
 
+    FeatureInfo asyncTextureUpload = {
+        "asyncTextureUpload",
+        FeatureCategory::VulkanFeatures,
+        "Convert the data of glTexImage and glTexSubImage calls on a worker thread and "
+        "flush the update when the texture is next used",
+        &members,
+    };
+
     FeatureInfo useVmaForImageSuballocation = {
         "useVmaForImageSuballocation",
         FeatureCategory::VulkanFeatures,
@@ -439,6 +447,14 @@ struct FeaturesVk : FeatureSetBase
         &members, "http://anglebug.com/4551"
     };
 
+    FeatureInfo forceGenerateMipmapOnCPU = {
+        "forceGenerateMipmapOnCPU",
+        FeatureCategory::VulkanWorkarounds,
+        "Generate mipmaps on the CPU even if compute or blit could be used, "
+        "to test and benchmark the fallback path",
+        &members,
+    };
+
     FeatureInfo supportsRenderPassStoreOpNone = {
         "supportsRenderPassStoreOpNone",
         FeatureCategory::VulkanFeatures,
@@ -196,6 +196,30 @@ struct FrontendFeatures : FeatureSetBase
         &members, ""
     };
 
+    FeatureInfo useLz4BlobCacheCompression = {
+        "useLz4BlobCacheCompression",
+        FeatureCategory::FrontendFeatures,
+        "Compress program, shader and pipeline cache blobs with LZ4 instead of gzip, "
+        "trading cache size for faster loads",
+        &members, ""
+    };
+
+    FeatureInfo useDeflateBestBlobCacheCompression = {
+        "useDeflateBestBlobCacheCompression",
+        FeatureCategory::FrontendFeatures,
+        "Compress program, shader and pipeline cache blobs at the highest deflate level, "
+        "trading compression time for smaller cache entries",
+        &members, ""
+    };
+
+    FeatureInfo disableBlobCacheCompression = {
+        "disableBlobCacheCompression",
+        FeatureCategory::FrontendFeatures,
+        "Store program and shader cache blobs uncompressed so cached programs are loaded "
+        "in place, trading cache size for load time",
+        &members, ""
+    };
+
 };
 
 inline FrontendFeatures::FrontendFeatures()  = default;
@@ -51,6 +51,17 @@ static bool ParseIntValue(const std::string &, int emptyDefault, int *outValue);
 
 static void PrintSpirv(const sh::BinaryBlob &blob);
 
+static void CacheSet(const void *key,
+                     size_t keySize,
+                     const void *value,
+                     size_t valueSize,
+                     void *userData);
+static size_t CacheGet(const void *key,
+                       size_t keySize,
+                       void *value,
+                       size_t valueSize,
+                       void *userData);
+
 //
 // Set up the per compile resources
 //
@@ -97,6 +108,11 @@ int main(int argc, char *argv[])
 
     bool printActiveVariables = false;
 
+    // Translations are cached in a directory when given, so a shader is only translated once
+    // across runs.
+    std::string cacheDirectory;
+    sh::TranslatorCache *translatorCache = nullptr;
+
     argc--;
     argv++;
     for (; (argc >= 1) && (failCode == ESuccess); argc--, argv++)
@@ -114,6 +130,19 @@ int main(int argc, char *argv[])
                 case 'u':
                     printActiveVariables = true;
                     break;
+                case 'c':
+                    if (argv[0][2] == '=' && argv[0][3] != '\0' && translatorCache == nullptr)
+                    {
+                        cacheDirectory  = &argv[0][3];
+                        translatorCache = sh::CreateTranslatorCache(0);
+                        sh::SetTranslatorCacheStorage(translatorCache, CacheSet, CacheGet,
+                                                      &cacheDirectory);
+                    }
+                    else
+                    {
+                        failCode = EFailUsage;
+                    }
+                    break;
                 case 's':
                     if (argv[0][2] == '=')
                     {
@@ -357,6 +386,7 @@ int main(int argc, char *argv[])
                         break;
                 }
 
+                sh::SetTranslatorCache(compiler, translatorCache);
                 bool compiled = CompileFile(argv[0], compiler, compileOptions);
 
                 LogMsg("BEGIN", "COMPILER", numCompiles, "INFO LOG");
@@ -434,6 +464,11 @@ int main(int argc, char *argv[])
         sh::Destruct(tessEvalCompiler);
     }
 
+    if (translatorCache)
+    {
+        sh::DestroyTranslatorCache(translatorCache);
+    }
+
     sh::Finalize();
 
     return failCode;
@@ -446,11 +481,12 @@ void usage()
 {
     // clang-format off
     printf(
-        "Usage: translate [-i -o -u -l -b=e -b=g -b=h9 -x=i -x=d] file1 file2 ...\n"
+        "Usage: translate [-i -o -u -l -c=dir -b=e -b=g -b=h9 -x=i -x=d] file1 file2 ...\n"
         "Where: filename : filename ending in .frag*, .vert*, .comp*, .geom*, .tcs* or .tes*\n"
         "       -i       : print intermediate tree\n"
         "       -o       : print translated code\n"
         "       -u       : print active attribs, uniforms, varyings and program outputs\n"
+        "       -c=[DIR] : cache translations in existing directory DIR\n"
         "       -s=e2    : use GLES2 spec (this is by default)\n"
         "       -s=e3    : use GLES3 spec\n"
         "       -s=e31   : use GLES31 spec (in development)\n"
@@ -540,6 +576,54 @@ bool CompileFile(char *fileName, ShHandle compiler, const ShCompileOptions &comp
     return ret ? true : false;
 }
 
+//
+//   Store and load translator cache entries as files named after the hex-encoded key
+//
+static std::string GetCacheFilePath(const void *key, size_t keySize, void *userData)
+{
+    std::ostringstream path;
+    path << *static_cast<const std::string *>(userData) << "/";
+    for (size_t index = 0; index < keySize; ++index)
+    {
+        const unsigned int byte = static_cast<const unsigned char *>(key)[index];
+        path << "0123456789abcdef"[byte >> 4] << "0123456789abcdef"[byte & 0xF];
+    }
+    return path.str();
+}
+
+void CacheSet(const void *key, size_t keySize, const void *value, size_t valueSize, void *userData)
+{
+    FILE *out = fopen(GetCacheFilePath(key, keySize, userData).c_str(), "wb");
+    if (!out)
+    {
+        return;
+    }
+    fwrite(value, 1, valueSize, out);
+    fclose(out);
+}
+
+size_t CacheGet(const void *key, size_t keySize, void *value, size_t valueSize, void *userData)
+{
+    FILE *in = fopen(GetCacheFilePath(key, keySize, userData).c_str(), "rb");
+    if (!in)
+    {
+        return 0;
+    }
+    fseek(in, 0, SEEK_END);
+    const long fileSize = ftell(in);
+    size_t size         = fileSize > 0 ? static_cast<size_t>(fileSize) : 0;
+    if (size > 0 && valueSize >= size)
+    {
+        fseek(in, 0, SEEK_SET);
+        if (fread(value, 1, size, in) != size)
+        {
+            size = 0;
+        }
+    }
+    fclose(in);
+    return size;
+}
+
 void LogMsg(const char *msg, const char *name, const int num, const char *logName)
 {
     printf("#### %s %s %d %s ####\n", msg, name, num, logName);
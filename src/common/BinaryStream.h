@@ -58,16 +58,43 @@ class BinaryInputStream : angle::NonCopyable
         *outValue = readInt<IntT>();
     }
 
+    // The elements are aligned in the stream by writeVector, so when the stream itself is
+    // suitably aligned they are copied straight from the stream into the vector.
     template <class T>
     void readVector(std::vector<T> *param)
     {
         static_assert(std::is_trivially_copyable<T>(), "must be memcpy-able");
         ASSERT(param->empty());
         size_t size = readInt<size_t>();
-        if (size > 0)
+        if (size == 0)
+        {
+            return;
+        }
+
+        alignTo(alignof(T));
+        angle::CheckedNumeric<size_t> checkedLength(size);
+        checkedLength *= sizeof(T);
+        if (!checkedLength.IsValid())
+        {
+            mError = true;
+            return;
+        }
+
+        const uint8_t *elements = getBytes(checkedLength.ValueOrDie());
+        if (elements == nullptr)
+        {
+            return;
+        }
+
+        if (reinterpret_cast<uintptr_t>(elements) % alignof(T) == 0)
+        {
+            const T *typedElements = reinterpret_cast<const T *>(elements);
+            param->assign(typedElements, typedElements + size);
+        }
+        else
         {
             param->resize(size);
-            readBytes(reinterpret_cast<uint8_t *>(param->data()), param->size() * sizeof(T));
+            memcpy(param->data(), elements, checkedLength.ValueOrDie());
         }
     }
 
@@ -161,6 +188,9 @@ class BinaryInputStream : angle::NonCopyable
         mOffset = checkedOffset.ValueOrDie();
     }
 
+    // Skips the padding BinaryOutputStream::alignTo inserted.
+    void alignTo(size_t alignment) { skip(rx::roundUpPow2(mOffset, alignment) - mOffset); }
+
     size_t offset() const { return mOffset; }
     size_t remainingSize() const
     {
@@ -251,6 +281,8 @@ class BinaryOutputStream : angle::NonCopyable
         }
     }
 
+    // The elements are aligned to their type's alignment relative to the start of the stream, so
+    // large arrays such as SPIR-V can be read in place.
     template <class T>
     void writeVector(const std::vector<T> &param)
     {
@@ -258,6 +290,7 @@ class BinaryOutputStream : angle::NonCopyable
         writeInt(param.size());
         if (param.size() > 0)
         {
+            alignTo(alignof(T));
             writeBytes(reinterpret_cast<const uint8_t *>(param.data()), param.size() * sizeof(T));
         }
     }
@@ -308,6 +341,9 @@ class BinaryOutputStream : angle::NonCopyable
 
     void writeFloat(float value) { write(&value, 1); }
 
+    // Pads the stream with zeros so the next write starts at a multiple of |alignment|.
+    void alignTo(size_t alignment) { mData.resize(rx::roundUpPow2(mData.size(), alignment), 0); }
+
     size_t length() const { return mData.size(); }
 
     const void *data() const { return mData.size() ? &mData[0] : nullptr; }
@@ -85,4 +85,38 @@ TEST(BinaryStream, IntVector)
         ASSERT_EQ(writeData[i], readData[i]);
     }
 }
+
+// Test that vector elements are aligned in the stream, and read back correctly whether or not the
+// stream itself is aligned.
+TEST(BinaryStream, AlignedVector)
+{
+    std::vector<uint64_t> writeData = {1, 2, 3, 0xFFFFFFFFFFFFFFFFull};
+
+    gl::BinaryOutputStream out;
+    out.writeBool(true);
+    out.writeVector(writeData);
+    out.writeInt(7u);
+
+    // The bool and the size take 12 bytes, so the elements are padded to start at 16.
+    ASSERT_EQ(52u, out.length());
+    EXPECT_EQ(0, memcmp(out.getData().data() + 16, writeData.data(),
+                        writeData.size() * sizeof(uint64_t)));
+
+    // Read from an aligned and a misaligned copy of the stream.
+    std::vector<uint64_t> storage(out.length() / sizeof(uint64_t) + 2);
+    for (size_t misalignment : {0, 1})
+    {
+        uint8_t *streamData = reinterpret_cast<uint8_t *>(storage.data()) + misalignment;
+        memcpy(streamData, out.data(), out.length());
+
+        gl::BinaryInputStream in(streamData, out.length());
+        EXPECT_TRUE(in.readBool());
+        std::vector<uint64_t> readData;
+        in.readVector(&readData);
+        EXPECT_EQ(writeData, readData);
+        EXPECT_EQ(7u, in.readInt<uint32_t>());
+        EXPECT_FALSE(in.error());
+        EXPECT_TRUE(in.endOfStream());
+    }
+}
 }  // namespace angle
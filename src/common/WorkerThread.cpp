@@ -10,6 +10,8 @@
 
 #include "common/WorkerThread.h"
 
+#include <algorithm>
+
 #include "common/angleutils.h"
 #include "common/system_utils.h"
 
@@ -20,6 +22,7 @@
 #endif  // !defined(ANGLE_STD_ASYNC_WORKERS) && & !defined(ANGLE_ENABLE_WINDOWS_UWP)
 
 #if ANGLE_DELEGATE_WORKERS || ANGLE_STD_ASYNC_WORKERS
+#    include <atomic>
 #    include <future>
 #    include <queue>
 #    include <thread>
@@ -63,13 +66,15 @@ WorkerThreadPool::~WorkerThreadPool() = default;
 class SingleThreadedWorkerPool final : public WorkerThreadPool
 {
   public:
-    std::shared_ptr<WaitableEvent> postWorkerTask(const std::shared_ptr<Closure> &task) override;
+    std::shared_ptr<WaitableEvent> postWorkerTask(const std::shared_ptr<Closure> &task,
+                                                  WorkerTaskPriority priority) override;
     bool isAsync() override;
 };
 
 // SingleThreadedWorkerPool implementation.
 std::shared_ptr<WaitableEvent> SingleThreadedWorkerPool::postWorkerTask(
-    const std::shared_ptr<Closure> &task)
+    const std::shared_ptr<Closure> &task,
+    WorkerTaskPriority priority)
 {
     // Thread safety: This function is thread-safe because the task is run on the calling thread
     // itself.
@@ -84,6 +89,7 @@ bool SingleThreadedWorkerPool::isAsync()
 
 #if ANGLE_STD_ASYNC_WORKERS
 
+// A pool where all threads take tasks from a single queue guarded by a single mutex.
 class AsyncWorkerPool final : public WorkerThreadPool
 {
   public:
@@ -91,10 +97,13 @@ class AsyncWorkerPool final : public WorkerThreadPool
 
     ~AsyncWorkerPool() override;
 
-    std::shared_ptr<WaitableEvent> postWorkerTask(const std::shared_ptr<Closure> &task) override;
+    std::shared_ptr<WaitableEvent> postWorkerTask(const std::shared_ptr<Closure> &task,
+                                                  WorkerTaskPriority priority) override;
 
     bool isAsync() override;
 
+    WorkerThreadPoolCounters getCounters() override;
+
   private:
     void createThreads();
 
@@ -109,6 +118,7 @@ class AsyncWorkerPool final : public WorkerThreadPool
     std::queue<Task> mTaskQueue;
     std::deque<std::thread> mThreads;
     size_t mDesiredThreadCount;
+    WorkerThreadPoolCounters mCounters;
 };
 
 // AsyncWorkerPool implementation.
@@ -146,7 +156,8 @@ void AsyncWorkerPool::createThreads()
     }
 }
 
-std::shared_ptr<WaitableEvent> AsyncWorkerPool::postWorkerTask(const std::shared_ptr<Closure> &task)
+std::shared_ptr<WaitableEvent> AsyncWorkerPool::postWorkerTask(const std::shared_ptr<Closure> &task,
+                                                               WorkerTaskPriority priority)
 {
     // Thread safety: This function is thread-safe because access to |mTaskQueue| is protected by
     // |mMutex|.
@@ -158,6 +169,9 @@ std::shared_ptr<WaitableEvent> AsyncWorkerPool::postWorkerTask(const std::shared
         createThreads();
 
         mTaskQueue.push(std::make_pair(waitable, task));
+
+        ++mCounters.tasksPosted;
+        mCounters.peakQueueDepth = std::max(mCounters.peakQueueDepth, mTaskQueue.size());
     }
     mCondVar.notify_one();
     return waitable;
@@ -199,6 +213,276 @@ bool AsyncWorkerPool::isAsync()
     return true;
 }
 
+WorkerThreadPoolCounters AsyncWorkerPool::getCounters()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    WorkerThreadPoolCounters counters = mCounters;
+    counters.queueDepth               = mTaskQueue.size();
+    return counters;
+}
+
+// A pool where every thread has its own task queues, one per priority.  Tasks posted from outside
+// the pool are distributed round-robin over the threads, and tasks posted by a worker (such as link
+// sub-tasks posted by the main link task) go to that worker's queues.  A thread that runs out of
+// tasks steals from the other threads' queues.  Each queue has its own mutex, so posting threads
+// and workers rarely contend with each other.
+class WorkStealingWorkerPool final : public WorkerThreadPool
+{
+  public:
+    WorkStealingWorkerPool(size_t numThreads);
+
+    ~WorkStealingWorkerPool() override;
+
+    std::shared_ptr<WaitableEvent> postWorkerTask(const std::shared_ptr<Closure> &task,
+                                                  WorkerTaskPriority priority) override;
+
+    bool isAsync() override;
+
+    WorkerThreadPoolCounters getCounters() override;
+
+  private:
+    using Task = std::pair<std::shared_ptr<AsyncWaitableEvent>, std::shared_ptr<Closure>>;
+
+    struct WorkerQueues
+    {
+        std::mutex mutex;
+        std::array<std::deque<Task>, static_cast<size_t>(WorkerTaskPriority::EnumCount)> tasks;
+    };
+
+    void createThreads();
+
+    // Takes the next task to run on thread |threadIndex|, stealing one from the other threads if
+    // its own queues are empty.  Returns false if there are no tasks.
+    bool takeTask(size_t threadIndex, Task *taskOut);
+    bool takeTaskFromQueue(size_t queueIndex, size_t priorityIndex, Task *taskOut);
+
+    // Thread's main loop
+    void threadLoop(size_t threadIndex);
+
+    // The pool and index of the worker running on the current thread, if any.
+    static thread_local WorkStealingWorkerPool *tCurrentPool;
+    static thread_local size_t tCurrentThreadIndex;
+
+    std::vector<std::unique_ptr<WorkerQueues>> mQueues;
+    std::vector<std::thread> mThreads;
+    std::once_flag mCreateThreadsOnce;
+
+    // Used to distribute tasks posted from outside the pool.
+    std::atomic<size_t> mNextQueueIndex;
+    // Number of tasks in all queues.  Incremented before a task is queued, so it is never less
+    // than the actual number of queued tasks.
+    std::atomic<size_t> mQueuedTaskCount;
+
+    // Idle threads sleep on |mCondVar|.  Posting a task only takes |mSleepMutex| if a thread is
+    // idle.
+    std::mutex mSleepMutex;
+    std::condition_variable mCondVar;
+    std::atomic<size_t> mIdleThreadCount;
+    std::atomic<bool> mTerminated;
+
+    std::atomic<uint64_t> mTasksPosted;
+    std::atomic<uint64_t> mTasksStolen;
+    std::atomic<size_t> mPeakQueueDepth;
+};
+
+thread_local WorkStealingWorkerPool *WorkStealingWorkerPool::tCurrentPool = nullptr;
+thread_local size_t WorkStealingWorkerPool::tCurrentThreadIndex           = 0;
+
+// WorkStealingWorkerPool implementation.
+
+WorkStealingWorkerPool::WorkStealingWorkerPool(size_t numThreads)
+    : mNextQueueIndex(0),
+      mQueuedTaskCount(0),
+      mIdleThreadCount(0),
+      mTerminated(false),
+      mTasksPosted(0),
+      mTasksStolen(0),
+      mPeakQueueDepth(0)
+{
+    ASSERT(numThreads != 0);
+
+    // The queues are created upfront so they can be used without locking the pool; only the
+    // threads are created lazily.
+    mQueues.resize(numThreads);
+    for (std::unique_ptr<WorkerQueues> &queues : mQueues)
+    {
+        queues = std::make_unique<WorkerQueues>();
+    }
+}
+
+WorkStealingWorkerPool::~WorkStealingWorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mSleepMutex);
+        mTerminated = true;
+    }
+    mCondVar.notify_all();
+    for (std::thread &thread : mThreads)
+    {
+        ASSERT(thread.get_id() != std::this_thread::get_id());
+        thread.join();
+    }
+}
+
+void WorkStealingWorkerPool::createThreads()
+{
+    mThreads.reserve(mQueues.size());
+    for (size_t threadIndex = 0; threadIndex < mQueues.size(); ++threadIndex)
+    {
+        mThreads.emplace_back(&WorkStealingWorkerPool::threadLoop, this, threadIndex);
+    }
+}
+
+std::shared_ptr<WaitableEvent> WorkStealingWorkerPool::postWorkerTask(
+    const std::shared_ptr<Closure> &task,
+    WorkerTaskPriority priority)
+{
+    // Thread safety: This function is thread-safe because each queue is protected by its own mutex
+    // and the rest of the shared state is atomic.
+    ASSERT(priority < WorkerTaskPriority::EnumCount);
+
+    // Lazily create the threads on first task
+    std::call_once(mCreateThreadsOnce, &WorkStealingWorkerPool::createThreads, this);
+
+    const size_t queueIndex =
+        tCurrentPool == this ? tCurrentThreadIndex
+                             : mNextQueueIndex.fetch_add(1, std::memory_order_relaxed) %
+                                   mQueues.size();
+
+    const size_t queueDepth = mQueuedTaskCount.fetch_add(1) + 1;
+
+    auto waitable = std::make_shared<AsyncWaitableEvent>();
+    {
+        WorkerQueues &queues = *mQueues[queueIndex];
+        std::lock_guard<std::mutex> lock(queues.mutex);
+        queues.tasks[static_cast<size_t>(priority)].emplace_back(waitable, task);
+    }
+
+    mTasksPosted.fetch_add(1, std::memory_order_relaxed);
+    size_t peakQueueDepth = mPeakQueueDepth.load(std::memory_order_relaxed);
+    while (queueDepth > peakQueueDepth &&
+           !mPeakQueueDepth.compare_exchange_weak(peakQueueDepth, queueDepth,
+                                                  std::memory_order_relaxed))
+    {
+    }
+
+    // |mQueuedTaskCount| is incremented before |mIdleThreadCount| is read, and an idle thread
+    // increments |mIdleThreadCount| before checking |mQueuedTaskCount| under |mSleepMutex|, so
+    // either the thread sees the new task or this sees the idle thread.
+    if (mIdleThreadCount.load() > 0)
+    {
+        std::lock_guard<std::mutex> lock(mSleepMutex);
+        mCondVar.notify_one();
+    }
+
+    return waitable;
+}
+
+bool WorkStealingWorkerPool::takeTaskFromQueue(size_t queueIndex,
+                                               size_t priorityIndex,
+                                               Task *taskOut)
+{
+    WorkerQueues &queues = *mQueues[queueIndex];
+    std::lock_guard<std::mutex> lock(queues.mutex);
+
+    std::deque<Task> &tasks = queues.tasks[priorityIndex];
+    if (tasks.empty())
+    {
+        return false;
+    }
+
+    *taskOut = std::move(tasks.front());
+    tasks.pop_front();
+    mQueuedTaskCount.fetch_sub(1);
+    return true;
+}
+
+bool WorkStealingWorkerPool::takeTask(size_t threadIndex, Task *taskOut)
+{
+    if (mQueuedTaskCount.load() == 0)
+    {
+        return false;
+    }
+
+    // A task is never started while a task of higher priority is queued on any thread.
+    const size_t queueCount = mQueues.size();
+    for (size_t priorityIndex = 0;
+         priorityIndex < static_cast<size_t>(WorkerTaskPriority::EnumCount); ++priorityIndex)
+    {
+        if (takeTaskFromQueue(threadIndex, priorityIndex, taskOut))
+        {
+            return true;
+        }
+
+        for (size_t offset = 1; offset < queueCount; ++offset)
+        {
+            if (takeTaskFromQueue((threadIndex + offset) % queueCount, priorityIndex, taskOut))
+            {
+                mTasksStolen.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+void WorkStealingWorkerPool::threadLoop(size_t threadIndex)
+{
+    angle::SetCurrentThreadName("ANGLE-Worker");
+
+    tCurrentPool        = this;
+    tCurrentThreadIndex = threadIndex;
+
+    while (true)
+    {
+        Task task;
+        if (!takeTask(threadIndex, &task))
+        {
+            std::unique_lock<std::mutex> lock(mSleepMutex);
+            ++mIdleThreadCount;
+            mCondVar.wait(lock, [this] { return mQueuedTaskCount.load() > 0 || mTerminated; });
+            --mIdleThreadCount;
+            if (mTerminated)
+            {
+                return;
+            }
+            continue;
+        }
+
+        if (mTerminated)
+        {
+            return;
+        }
+
+        auto &waitable = task.first;
+        auto &closure  = task.second;
+
+        // Note: always add an ANGLE_TRACE_EVENT* macro in the closure.  Then the job will show up
+        // in traces.
+        (*closure)();
+        // Release shared_ptr<Closure> before notifying the event to allow for destructor based
+        // dependencies (example: anglebug.com/8661)
+        task.second.reset();
+        waitable->markAsReady();
+    }
+}
+
+bool WorkStealingWorkerPool::isAsync()
+{
+    return true;
+}
+
+WorkerThreadPoolCounters WorkStealingWorkerPool::getCounters()
+{
+    WorkerThreadPoolCounters counters;
+    counters.tasksPosted    = mTasksPosted.load(std::memory_order_relaxed);
+    counters.tasksStolen    = mTasksStolen.load(std::memory_order_relaxed);
+    counters.queueDepth     = mQueuedTaskCount.load(std::memory_order_relaxed);
+    counters.peakQueueDepth = mPeakQueueDepth.load(std::memory_order_relaxed);
+    return counters;
+}
+
 #endif  // ANGLE_STD_ASYNC_WORKERS
 
 #if ANGLE_DELEGATE_WORKERS
@@ -209,7 +493,8 @@ class DelegateWorkerPool final : public WorkerThreadPool
     DelegateWorkerPool(PlatformMethods *platform) : mPlatform(platform) {}
     ~DelegateWorkerPool() override = default;
 
-    std::shared_ptr<WaitableEvent> postWorkerTask(const std::shared_ptr<Closure> &task) override;
+    std::shared_ptr<WaitableEvent> postWorkerTask(const std::shared_ptr<Closure> &task,
+                                                  WorkerTaskPriority priority) override;
 
     bool isAsync() override;
 
@@ -248,8 +533,11 @@ class DelegateWorkerTask
 
 ANGLE_NO_SANITIZE_CFI_ICALL
 std::shared_ptr<WaitableEvent> DelegateWorkerPool::postWorkerTask(
-    const std::shared_ptr<Closure> &task)
+    const std::shared_ptr<Closure> &task,
+    WorkerTaskPriority priority)
 {
+    // The platform's postWorkerTask has no notion of priority.
+
     if (mPlatform->postWorkerTask == nullptr)
     {
         // In the unexpected case where the platform methods have been changed during execution and
@@ -293,7 +581,7 @@ std::shared_ptr<WorkerThreadPool> WorkerThreadPool::Create(size_t numThreads,
 #if ANGLE_STD_ASYNC_WORKERS
     if (!pool && multithreaded)
     {
-        pool = std::shared_ptr<WorkerThreadPool>(new AsyncWorkerPool(
+        pool = std::shared_ptr<WorkerThreadPool>(new WorkStealingWorkerPool(
             numThreads == 0 ? std::thread::hardware_concurrency() : numThreads));
     }
 #endif
@@ -303,4 +591,18 @@ std::shared_ptr<WorkerThreadPool> WorkerThreadPool::Create(size_t numThreads,
     }
     return pool;
 }
+
+// static
+std::shared_ptr<WorkerThreadPool> WorkerThreadPool::CreateSharedQueuePoolForTesting(
+    size_t numThreads)
+{
+#if ANGLE_STD_ASYNC_WORKERS
+    if (numThreads != 1)
+    {
+        return std::shared_ptr<WorkerThreadPool>(new AsyncWorkerPool(
+            numThreads == 0 ? std::thread::hardware_concurrency() : numThreads));
+    }
+#endif
+    return std::shared_ptr<WorkerThreadPool>(new SingleThreadedWorkerPool());
+}
 }  // namespace angle
@@ -100,6 +100,33 @@ class AsyncWaitableEvent final : public WaitableEvent
     std::condition_variable mCondition;
 };
 
+// The order in which queued tasks are picked up by the workers.  Tasks of a higher priority are
+// started before any task of a lower priority, but running tasks are never preempted.
+enum class WorkerTaskPriority
+{
+    // Work the application is about to block on, such as link sub-tasks.
+    High,
+    // Shader compilation, program linking and other work triggered by the application.
+    Normal,
+    // Background work that nothing waits on, such as pipeline warm-up and cache persistence.
+    Low,
+
+    InvalidEnum,
+    EnumCount = InvalidEnum,
+};
+
+// Statistics collected by pools that queue tasks themselves.  All values are cumulative since the
+// creation of the pool, except |queueDepth|.
+struct WorkerThreadPoolCounters
+{
+    uint64_t tasksPosted = 0;
+    // Tasks that were run by a different worker than the one they were queued on.
+    uint64_t tasksStolen = 0;
+    // Number of tasks queued but not yet picked up by a worker.
+    size_t queueDepth     = 0;
+    size_t peakQueueDepth = 0;
+};
+
 // Request WorkerThreads from the WorkerThreadPool. Each pool can keep worker threads around so
 // we avoid the costly spin up and spin down time.
 class WorkerThreadPool : angle::NonCopyable
@@ -116,12 +143,25 @@ class WorkerThreadPool : angle::NonCopyable
     // hook into the provided PlatformMethods::postWorkerTask, in which case numThreads is ignored.
     static std::shared_ptr<WorkerThreadPool> Create(size_t numThreads, PlatformMethods *platform);
 
+    // Creates a pool where all threads share a single task queue, which is what Create() used
+    // before switching to a work-stealing pool.  Priorities are ignored.  Only used to compare the
+    // two in tests and benchmarks.
+    static std::shared_ptr<WorkerThreadPool> CreateSharedQueuePoolForTesting(size_t numThreads);
+
     // Returns an event to wait on for the task to finish.  If the pool fails to create the task,
     // returns null.  This function is thread-safe.
-    virtual std::shared_ptr<WaitableEvent> postWorkerTask(const std::shared_ptr<Closure> &task) = 0;
+    std::shared_ptr<WaitableEvent> postWorkerTask(const std::shared_ptr<Closure> &task)
+    {
+        return postWorkerTask(task, WorkerTaskPriority::Normal);
+    }
+    virtual std::shared_ptr<WaitableEvent> postWorkerTask(const std::shared_ptr<Closure> &task,
+                                                          WorkerTaskPriority priority) = 0;
 
     virtual bool isAsync() = 0;
 
+    // Pools that delegate to the platform or run tasks immediately don't collect statistics.
+    virtual WorkerThreadPoolCounters getCounters() { return {}; }
+
   private:
 };
 
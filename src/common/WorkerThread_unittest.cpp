@@ -8,6 +8,9 @@
 
 #include <gtest/gtest.h>
 #include <array>
+#include <atomic>
+#include <mutex>
+#include <vector>
 
 #include "common/WorkerThread.h"
 
@@ -48,4 +51,156 @@ TEST(WorkerPoolTest, SimpleTask)
     }
 }
 
+// Tests that queued tasks are started in priority order.
+TEST(WorkerPoolTest, Priorities)
+{
+    std::shared_ptr<WorkerThreadPool> pool = WorkerThreadPool::Create(2, ANGLEPlatformCurrent());
+
+    // Occupies a thread until released, so the other tasks queue up behind it.
+    class BlockingTask : public Closure
+    {
+      public:
+        void operator()() override
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            started = true;
+            condition.notify_all();
+            condition.wait(lock, [this] { return released; });
+        }
+
+        void waitForStart()
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [this] { return started; });
+        }
+
+        void release()
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            released = true;
+            condition.notify_all();
+        }
+
+      private:
+        std::mutex mutex;
+        std::condition_variable condition;
+        bool started  = false;
+        bool released = false;
+    };
+
+    class RecordTask : public Closure
+    {
+      public:
+        RecordTask(std::mutex *mutex, std::vector<WorkerTaskPriority> *order, WorkerTaskPriority p)
+            : mMutex(mutex), mOrder(order), mPriority(p)
+        {}
+        void operator()() override
+        {
+            std::lock_guard<std::mutex> lock(*mMutex);
+            mOrder->push_back(mPriority);
+        }
+
+      private:
+        std::mutex *mMutex;
+        std::vector<WorkerTaskPriority> *mOrder;
+        WorkerTaskPriority mPriority;
+    };
+
+    std::array<std::shared_ptr<BlockingTask>, 2> blockingTasks = {
+        {std::make_shared<BlockingTask>(), std::make_shared<BlockingTask>()}};
+    std::vector<std::shared_ptr<WaitableEvent>> blockingWaitables;
+    for (const std::shared_ptr<BlockingTask> &blockingTask : blockingTasks)
+    {
+        blockingWaitables.push_back(pool->postWorkerTask(blockingTask));
+        blockingTask->waitForStart();
+    }
+
+    std::mutex orderMutex;
+    std::vector<WorkerTaskPriority> order;
+    std::vector<std::shared_ptr<WaitableEvent>> waitables;
+    for (WorkerTaskPriority priority :
+         {WorkerTaskPriority::Low, WorkerTaskPriority::Normal, WorkerTaskPriority::High})
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            waitables.push_back(pool->postWorkerTask(
+                std::make_shared<RecordTask>(&orderMutex, &order, priority), priority));
+        }
+    }
+
+    // Free a single thread so the queued tasks run one after the other, stealing from the other
+    // thread's queues.
+    blockingTasks[0]->release();
+    WaitableEvent::WaitMany(&waitables);
+    blockingTasks[1]->release();
+    WaitableEvent::WaitMany(&blockingWaitables);
+
+    ASSERT_EQ(order.size(), 12u);
+    for (size_t i = 1; i < order.size(); ++i)
+    {
+        EXPECT_LE(order[i - 1], order[i]);
+    }
+
+    WorkerThreadPoolCounters counters = pool->getCounters();
+    EXPECT_EQ(counters.tasksPosted, 14u);
+    EXPECT_EQ(counters.queueDepth, 0u);
+    EXPECT_EQ(counters.peakQueueDepth, 12u);
+    EXPECT_GE(counters.tasksStolen, 6u);
+}
+
+// Tests tasks that post more tasks and wait on them, like the main link task does.
+TEST(WorkerPoolTest, NestedTasks)
+{
+    constexpr size_t kSubTaskCount = 16;
+
+    class SubTask : public Closure
+    {
+      public:
+        SubTask(std::atomic<size_t> *counter) : mCounter(counter) {}
+        void operator()() override { ++*mCounter; }
+
+      private:
+        std::atomic<size_t> *mCounter;
+    };
+
+    class MainTask : public Closure
+    {
+      public:
+        MainTask(WorkerThreadPool *pool, std::atomic<size_t> *counter)
+            : mPool(pool), mCounter(counter)
+        {}
+        void operator()() override
+        {
+            std::vector<std::shared_ptr<WaitableEvent>> waitables;
+            for (size_t i = 0; i < kSubTaskCount; ++i)
+            {
+                waitables.push_back(mPool->postWorkerTask(std::make_shared<SubTask>(mCounter),
+                                                          WorkerTaskPriority::High));
+            }
+            WaitableEvent::WaitMany(&waitables);
+        }
+
+      private:
+        WorkerThreadPool *mPool;
+        std::atomic<size_t> *mCounter;
+    };
+
+    std::array<std::shared_ptr<WorkerThreadPool>, 3> pools = {
+        {WorkerThreadPool::Create(1, ANGLEPlatformCurrent()),
+         WorkerThreadPool::Create(4, ANGLEPlatformCurrent()),
+         WorkerThreadPool::CreateSharedQueuePoolForTesting(4)}};
+    for (auto &pool : pools)
+    {
+        std::atomic<size_t> counter(0);
+        std::vector<std::shared_ptr<WaitableEvent>> waitables;
+        for (int i = 0; i < 2; ++i)
+        {
+            waitables.push_back(
+                pool->postWorkerTask(std::make_shared<MainTask>(pool.get(), &counter)));
+        }
+        WaitableEvent::WaitMany(&waitables);
+        EXPECT_EQ(counter.load(), 2 * kSubTaskCount);
+    }
+}
+
 }  // anonymous namespace
@@ -0,0 +1,661 @@
+//
+// Copyright 2024 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// index_range_utils.cpp: Vectorized computation of the range of an index buffer.
+//
+// With primitive restart enabled, the restart index is the largest value of the index type, so it
+// never lowers the minimum.  The maximum is instead computed over the indices plus one: restart
+// indices wrap around to zero and drop out, and the other indices don't overflow.
+//
+
+#include "common/index_range_utils.h"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+
+#include "common/utilities.h"
+
+#if defined(ANGLE_USE_SSE) && \
+    (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#    define ANGLE_INDEX_RANGE_SSE2 1
+#    include <emmintrin.h>
+#    include <immintrin.h>
+#    if defined(__clang__) || defined(__GNUC__)
+#        define ANGLE_AVX2_TARGET __attribute__((target("avx2")))
+#    else
+#        define ANGLE_AVX2_TARGET
+#    endif
+#endif
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+#    define ANGLE_INDEX_RANGE_NEON 1
+#    include <arm_neon.h>
+#endif
+
+namespace gl
+{
+namespace
+{
+template <class IndexType>
+IndexRange ComputeTypedIndexRangeScalar(const IndexType *indices,
+                                        size_t count,
+                                        bool primitiveRestartEnabled)
+{
+    ASSERT(count > 0);
+
+    constexpr IndexType kPrimitiveRestartIndex = GetPrimitiveRestartIndexFromType<IndexType>();
+
+    IndexType minIndex                = 0;
+    IndexType maxIndex                = 0;
+    size_t nonPrimitiveRestartIndices = 0;
+
+    if (primitiveRestartEnabled)
+    {
+        // Find the first non-primitive restart index to initialize the min and max values
+        size_t i = 0;
+        for (; i < count; i++)
+        {
+            if (indices[i] != kPrimitiveRestartIndex)
+            {
+                minIndex = indices[i];
+                maxIndex = indices[i];
+                break;
+            }
+        }
+
+        // Loop over the rest of the indices, starting with the one found above so it's counted
+        // once
+        for (; i < count; i++)
+        {
+            if (indices[i] != kPrimitiveRestartIndex)
+            {
+                if (minIndex > indices[i])
+                {
+                    minIndex = indices[i];
+                }
+                if (maxIndex < indices[i])
+                {
+                    maxIndex = indices[i];
+                }
+                nonPrimitiveRestartIndices++;
+            }
+        }
+    }
+    else
+    {
+        minIndex                   = indices[0];
+        maxIndex                   = indices[0];
+        nonPrimitiveRestartIndices = count;
+
+        for (size_t i = 1; i < count; i++)
+        {
+            if (minIndex > indices[i])
+            {
+                minIndex = indices[i];
+            }
+            if (maxIndex < indices[i])
+            {
+                maxIndex = indices[i];
+            }
+        }
+    }
+
+    return IndexRange(static_cast<size_t>(minIndex), static_cast<size_t>(maxIndex),
+                      nonPrimitiveRestartIndices);
+}
+
+// Combines the per-lane results of a vectorized loop over [0, processed) with the remaining
+// indices.  With primitive restart enabled, |maxLanes| holds the maximum index plus one.
+template <class IndexType, size_t kLanes>
+IndexRange FinishVectorizedIndexRange(const std::array<IndexType, kLanes> &minLanes,
+                                      const std::array<IndexType, kLanes> &maxLanes,
+                                      const IndexType *indices,
+                                      size_t processed,
+                                      size_t count,
+                                      bool primitiveRestartEnabled,
+                                      size_t primitiveRestartCount)
+{
+    ASSERT(count > 0);
+
+    constexpr IndexType kPrimitiveRestartIndex = GetPrimitiveRestartIndexFromType<IndexType>();
+
+    size_t minIndex = *std::min_element(minLanes.begin(), minLanes.end());
+    size_t maxIndex = *std::max_element(maxLanes.begin(), maxLanes.end());
+
+    if (!primitiveRestartEnabled)
+    {
+        for (size_t i = processed; i < count; ++i)
+        {
+            minIndex = std::min<size_t>(minIndex, indices[i]);
+            maxIndex = std::max<size_t>(maxIndex, indices[i]);
+        }
+        return IndexRange(minIndex, maxIndex, count);
+    }
+
+    size_t maxIndexPlusOne = maxIndex;
+    for (size_t i = processed; i < count; ++i)
+    {
+        if (indices[i] == kPrimitiveRestartIndex)
+        {
+            ++primitiveRestartCount;
+            continue;
+        }
+        minIndex        = std::min<size_t>(minIndex, indices[i]);
+        maxIndexPlusOne = std::max<size_t>(maxIndexPlusOne, indices[i] + size_t(1));
+    }
+
+    const size_t nonPrimitiveRestartIndices = count - primitiveRestartCount;
+    if (nonPrimitiveRestartIndices == 0)
+    {
+        return IndexRange(0, 0, 0);
+    }
+    return IndexRange(minIndex, maxIndexPlusOne - 1, nonPrimitiveRestartIndices);
+}
+
+// Computes the range with 128-bit vectors.  |Ops| wraps the instructions of the architecture for
+// the index type.
+template <class Ops>
+IndexRange ComputeTypedIndexRangeVectorized(const typename Ops::IndexType *indices,
+                                            size_t count,
+                                            bool primitiveRestartEnabled)
+{
+    using IndexType         = typename Ops::IndexType;
+    using Vec               = typename Ops::Vec;
+    constexpr size_t kLanes = sizeof(Vec) / sizeof(IndexType);
+    constexpr IndexType kPrimitiveRestartIndex = GetPrimitiveRestartIndexFromType<IndexType>();
+
+    Vec minVec                   = Ops::Set1(std::numeric_limits<IndexType>::max());
+    Vec maxVec                   = Ops::Set1(0);
+    size_t primitiveRestartCount = 0;
+    size_t i                     = 0;
+
+    if (!primitiveRestartEnabled)
+    {
+        for (; i + kLanes <= count; i += kLanes)
+        {
+            const Vec values = Ops::Load(indices + i);
+            minVec           = Ops::Min(minVec, values);
+            maxVec           = Ops::Max(maxVec, values);
+        }
+    }
+    else
+    {
+        const Vec one          = Ops::Set1(1);
+        const Vec restartIndex = Ops::Set1(kPrimitiveRestartIndex);
+        for (; i + kLanes <= count; i += kLanes)
+        {
+            const Vec values = Ops::Load(indices + i);
+            minVec           = Ops::Min(minVec, values);
+            maxVec           = Ops::Max(maxVec, Ops::Add(values, one));
+            primitiveRestartCount += Ops::CountEqual(values, restartIndex);
+        }
+    }
+
+    std::array<IndexType, kLanes> minLanes;
+    std::array<IndexType, kLanes> maxLanes;
+    Ops::Store(minLanes.data(), minVec);
+    Ops::Store(maxLanes.data(), maxVec);
+
+    return FinishVectorizedIndexRange(minLanes, maxLanes, indices, i, count,
+                                      primitiveRestartEnabled, primitiveRestartCount);
+}
+
+#if defined(ANGLE_INDEX_RANGE_SSE2)
+template <class IndexType>
+struct SSE2Ops;
+
+template <class IndexType>
+struct SSE2OpsBase
+{
+    using Vec = __m128i;
+
+    static ANGLE_INLINE Vec Load(const IndexType *src)
+    {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+    }
+    static ANGLE_INLINE void Store(IndexType *dst, Vec value)
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), value);
+    }
+    // Number of lanes of a comparison result that are set.
+    static ANGLE_INLINE size_t CountSetLanes(Vec mask)
+    {
+        return BitCount(static_cast<uint32_t>(_mm_movemask_epi8(mask))) / sizeof(IndexType);
+    }
+};
+
+template <>
+struct SSE2Ops<uint8_t> : SSE2OpsBase<uint8_t>
+{
+    using IndexType = uint8_t;
+
+    static ANGLE_INLINE Vec Set1(uint8_t value) { return _mm_set1_epi8(static_cast<char>(value)); }
+    static ANGLE_INLINE Vec Min(Vec a, Vec b) { return _mm_min_epu8(a, b); }
+    static ANGLE_INLINE Vec Max(Vec a, Vec b) { return _mm_max_epu8(a, b); }
+    static ANGLE_INLINE Vec Add(Vec a, Vec b) { return _mm_add_epi8(a, b); }
+    static ANGLE_INLINE size_t CountEqual(Vec a, Vec b)
+    {
+        return CountSetLanes(_mm_cmpeq_epi8(a, b));
+    }
+};
+
+// SSE2 has no unsigned 16-bit min and max, but they can be derived from saturating subtraction.
+template <>
+struct SSE2Ops<uint16_t> : SSE2OpsBase<uint16_t>
+{
+    using IndexType = uint16_t;
+
+    static ANGLE_INLINE Vec Set1(uint16_t value)
+    {
+        return _mm_set1_epi16(static_cast<short>(value));
+    }
+    static ANGLE_INLINE Vec Min(Vec a, Vec b) { return _mm_sub_epi16(a, _mm_subs_epu16(a, b)); }
+    static ANGLE_INLINE Vec Max(Vec a, Vec b) { return _mm_add_epi16(a, _mm_subs_epu16(b, a)); }
+    static ANGLE_INLINE Vec Add(Vec a, Vec b) { return _mm_add_epi16(a, b); }
+    static ANGLE_INLINE size_t CountEqual(Vec a, Vec b)
+    {
+        return CountSetLanes(_mm_cmpeq_epi16(a, b));
+    }
+};
+
+// SSE2 only has signed 32-bit comparisons, so values are biased before comparing.
+template <>
+struct SSE2Ops<uint32_t> : SSE2OpsBase<uint32_t>
+{
+    using IndexType = uint32_t;
+
+    static ANGLE_INLINE Vec Set1(uint32_t value) { return _mm_set1_epi32(static_cast<int>(value)); }
+    static ANGLE_INLINE Vec GreaterThan(Vec a, Vec b)
+    {
+        const Vec bias = _mm_set1_epi32(static_cast<int>(0x80000000u));
+        return _mm_cmpgt_epi32(_mm_xor_si128(a, bias), _mm_xor_si128(b, bias));
+    }
+    static ANGLE_INLINE Vec Min(Vec a, Vec b)
+    {
+        const Vec aIsGreater = GreaterThan(a, b);
+        return _mm_or_si128(_mm_and_si128(aIsGreater, b), _mm_andnot_si128(aIsGreater, a));
+    }
+    static ANGLE_INLINE Vec Max(Vec a, Vec b)
+    {
+        const Vec aIsGreater = GreaterThan(a, b);
+        return _mm_or_si128(_mm_and_si128(aIsGreater, a), _mm_andnot_si128(aIsGreater, b));
+    }
+    static ANGLE_INLINE Vec Add(Vec a, Vec b) { return _mm_add_epi32(a, b); }
+    static ANGLE_INLINE size_t CountEqual(Vec a, Vec b)
+    {
+        return CountSetLanes(_mm_cmpeq_epi32(a, b));
+    }
+};
+
+template <class IndexType>
+IndexRange ComputeTypedIndexRangeSSE2(const IndexType *indices,
+                                      size_t count,
+                                      bool primitiveRestartEnabled)
+{
+    return ComputeTypedIndexRangeVectorized<SSE2Ops<IndexType>>(indices, count,
+                                                                primitiveRestartEnabled);
+}
+
+template <class IndexType>
+struct AVX2Ops;
+
+template <>
+struct AVX2Ops<uint8_t>
+{
+    ANGLE_AVX2_TARGET static ANGLE_INLINE __m256i Set1(uint8_t value)
+    {
+        return _mm256_set1_epi8(static_cast<char>(value));
+    }
+    ANGLE_AVX2_TARGET static ANGLE_INLINE __m256i Min(__m256i a, __m256i b)
+    {
+        return _mm256_min_epu8(a, b);
+    }
+    ANGLE_AVX2_TARGET static ANGLE_INLINE __m256i Max(__m256i a, __m256i b)
+    {
+        return _mm256_max_epu8(a, b);
+    }
+    ANGLE_AVX2_TARGET static ANGLE_INLINE __m256i Add(__m256i a, __m256i b)
+    {
+        return _mm256_add_epi8(a, b);
+    }
+    ANGLE_AVX2_TARGET static ANGLE_INLINE __m256i CmpEq(__m256i a, __m256i b)
+    {
+        return _mm256_cmpeq_epi8(a, b);
+    }
+};
+
+template <>
+struct AVX2Ops<uint16_t>
+{
+    ANGLE_AVX2_TARGET static ANGLE_INLINE __m256i Set1(uint16_t value)
+    {
+        return _mm256_set1_epi16(static_cast<short>(value));
+    }
+    ANGLE_AVX2_TARGET static ANGLE_INLINE __m256i Min(__m256i a, __m256i b)
+    {
+        return _mm256_min_epu16(a, b);
+    }
+    ANGLE_AVX2_TARGET static ANGLE_INLINE __m256i Max(__m256i a, __m256i b)
+    {
+        return _mm256_max_epu16(a, b);
+    }
+    ANGLE_AVX2_TARGET static ANGLE_INLINE __m256i Add(__m256i a, __m256i b)
+    {
+        return _mm256_add_epi16(a, b);
+    }
+    ANGLE_AVX2_TARGET static ANGLE_INLINE __m256i CmpEq(__m256i a, __m256i b)
+    {
+        return _mm256_cmpeq_epi16(a, b);
+    }
+};
+
+template <>
+struct AVX2Ops<uint32_t>
+{
+    ANGLE_AVX2_TARGET static ANGLE_INLINE __m256i Set1(uint32_t value)
+    {
+        return _mm256_set1_epi32(static_cast<int>(value));
+    }
+    ANGLE_AVX2_TARGET static ANGLE_INLINE __m256i Min(__m256i a, __m256i b)
+    {
+        return _mm256_min_epu32(a, b);
+    }
+    ANGLE_AVX2_TARGET static ANGLE_INLINE __m256i Max(__m256i a, __m256i b)
+    {
+        return _mm256_max_epu32(a, b);
+    }
+    ANGLE_AVX2_TARGET static ANGLE_INLINE __m256i Add(__m256i a, __m256i b)
+    {
+        return _mm256_add_epi32(a, b);
+    }
+    ANGLE_AVX2_TARGET static ANGLE_INLINE __m256i CmpEq(__m256i a, __m256i b)
+    {
+        return _mm256_cmpeq_epi32(a, b);
+    }
+};
+
+// Same as ComputeTypedIndexRangeVectorized, but with 256-bit vectors.  Kept separate because every
+// function using AVX2 instructions has to be compiled for AVX2, including the loop itself.
+template <class IndexType>
+ANGLE_AVX2_TARGET IndexRange ComputeTypedIndexRangeAVX2(const IndexType *indices,
+                                                        size_t count,
+                                                        bool primitiveRestartEnabled)
+{
+    using Ops               = AVX2Ops<IndexType>;
+    constexpr size_t kLanes = sizeof(__m256i) / sizeof(IndexType);
+    constexpr IndexType kPrimitiveRestartIndex = GetPrimitiveRestartIndexFromType<IndexType>();
+
+    __m256i minVec               = Ops::Set1(std::numeric_limits<IndexType>::max());
+    __m256i maxVec               = _mm256_setzero_si256();
+    size_t primitiveRestartCount = 0;
+    size_t i                     = 0;
+
+    if (!primitiveRestartEnabled)
+    {
+        for (; i + kLanes <= count; i += kLanes)
+        {
+            const __m256i values =
+                _mm256_loadu_si256(reinterpret_cast<const __m256i *>(indices + i));
+            minVec = Ops::Min(minVec, values);
+            maxVec = Ops::Max(maxVec, values);
+        }
+    }
+    else
+    {
+        const __m256i one          = Ops::Set1(1);
+        const __m256i restartIndex = Ops::Set1(kPrimitiveRestartIndex);
+        for (; i + kLanes <= count; i += kLanes)
+        {
+            const __m256i values =
+                _mm256_loadu_si256(reinterpret_cast<const __m256i *>(indices + i));
+            minVec = Ops::Min(minVec, values);
+            maxVec = Ops::Max(maxVec, Ops::Add(values, one));
+            const uint32_t restartMask =
+                static_cast<uint32_t>(_mm256_movemask_epi8(Ops::CmpEq(values, restartIndex)));
+            primitiveRestartCount += BitCount(restartMask) / sizeof(IndexType);
+        }
+    }
+
+    std::array<IndexType, kLanes> minLanes;
+    std::array<IndexType, kLanes> maxLanes;
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(minLanes.data()), minVec);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(maxLanes.data()), maxVec);
+
+    return FinishVectorizedIndexRange(minLanes, maxLanes, indices, i, count,
+                                      primitiveRestartEnabled, primitiveRestartCount);
+}
+
+bool SupportsAVX2()
+{
+#    if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+    {
+        return false;
+    }
+
+    // AVX2 needs AVX, and the OS must save the YMM registers on context switches.
+    __cpuid(info, 1);
+    const bool osUsesXSave = (info[2] & (1 << 27)) != 0;
+    const bool hasAVX      = (info[2] & (1 << 28)) != 0;
+    if (!osUsesXSave || !hasAVX || (_xgetbv(0) & 0x6) != 0x6)
+    {
+        return false;
+    }
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#    else
+    return __builtin_cpu_supports("avx2");
+#    endif
+}
+#endif  // defined(ANGLE_INDEX_RANGE_SSE2)
+
+#if defined(ANGLE_INDEX_RANGE_NEON)
+template <class IndexType>
+struct NEONOps;
+
+template <>
+struct NEONOps<uint8_t>
+{
+    using IndexType = uint8_t;
+    using Vec       = uint8x16_t;
+
+    static ANGLE_INLINE Vec Load(const uint8_t *src) { return vld1q_u8(src); }
+    static ANGLE_INLINE void Store(uint8_t *dst, Vec value) { vst1q_u8(dst, value); }
+    static ANGLE_INLINE Vec Set1(uint8_t value) { return vdupq_n_u8(value); }
+    static ANGLE_INLINE Vec Min(Vec a, Vec b) { return vminq_u8(a, b); }
+    static ANGLE_INLINE Vec Max(Vec a, Vec b) { return vmaxq_u8(a, b); }
+    static ANGLE_INLINE Vec Add(Vec a, Vec b) { return vaddq_u8(a, b); }
+    static ANGLE_INLINE size_t CountEqual(Vec a, Vec b)
+    {
+        return vaddvq_u8(vshrq_n_u8(vceqq_u8(a, b), 7));
+    }
+};
+
+template <>
+struct NEONOps<uint16_t>
+{
+    using IndexType = uint16_t;
+    using Vec       = uint16x8_t;
+
+    static ANGLE_INLINE Vec Load(const uint16_t *src) { return vld1q_u16(src); }
+    static ANGLE_INLINE void Store(uint16_t *dst, Vec value) { vst1q_u16(dst, value); }
+    static ANGLE_INLINE Vec Set1(uint16_t value) { return vdupq_n_u16(value); }
+    static ANGLE_INLINE Vec Min(Vec a, Vec b) { return vminq_u16(a, b); }
+    static ANGLE_INLINE Vec Max(Vec a, Vec b) { return vmaxq_u16(a, b); }
+    static ANGLE_INLINE Vec Add(Vec a, Vec b) { return vaddq_u16(a, b); }
+    static ANGLE_INLINE size_t CountEqual(Vec a, Vec b)
+    {
+        return vaddvq_u16(vshrq_n_u16(vceqq_u16(a, b), 15));
+    }
+};
+
+template <>
+struct NEONOps<uint32_t>
+{
+    using IndexType = uint32_t;
+    using Vec       = uint32x4_t;
+
+    static ANGLE_INLINE Vec Load(const uint32_t *src) { return vld1q_u32(src); }
+    static ANGLE_INLINE void Store(uint32_t *dst, Vec value) { vst1q_u32(dst, value); }
+    static ANGLE_INLINE Vec Set1(uint32_t value) { return vdupq_n_u32(value); }
+    static ANGLE_INLINE Vec Min(Vec a, Vec b) { return vminq_u32(a, b); }
+    static ANGLE_INLINE Vec Max(Vec a, Vec b) { return vmaxq_u32(a, b); }
+    static ANGLE_INLINE Vec Add(Vec a, Vec b) { return vaddq_u32(a, b); }
+    static ANGLE_INLINE size_t CountEqual(Vec a, Vec b)
+    {
+        return vaddvq_u32(vshrq_n_u32(vceqq_u32(a, b), 31));
+    }
+};
+
+template <class IndexType>
+IndexRange ComputeTypedIndexRangeNEON(const IndexType *indices,
+                                      size_t count,
+                                      bool primitiveRestartEnabled)
+{
+    return ComputeTypedIndexRangeVectorized<NEONOps<IndexType>>(indices, count,
+                                                                primitiveRestartEnabled);
+}
+#endif  // defined(ANGLE_INDEX_RANGE_NEON)
+
+template <template <class> class Kernel>
+IndexRange ComputeIndexRangeForType(DrawElementsType indexType,
+                                    const void *indices,
+                                    size_t count,
+                                    bool primitiveRestartEnabled)
+{
+    switch (indexType)
+    {
+        case DrawElementsType::UnsignedByte:
+            return Kernel<GLubyte>::Compute(static_cast<const GLubyte *>(indices), count,
+                                            primitiveRestartEnabled);
+        case DrawElementsType::UnsignedShort:
+            return Kernel<GLushort>::Compute(static_cast<const GLushort *>(indices), count,
+                                             primitiveRestartEnabled);
+        case DrawElementsType::UnsignedInt:
+            return Kernel<GLuint>::Compute(static_cast<const GLuint *>(indices), count,
+                                           primitiveRestartEnabled);
+        default:
+            UNREACHABLE();
+            return IndexRange();
+    }
+}
+
+template <class IndexType>
+struct ScalarKernel
+{
+    static IndexRange Compute(const IndexType *indices, size_t count, bool primitiveRestartEnabled)
+    {
+        return ComputeTypedIndexRangeScalar(indices, count, primitiveRestartEnabled);
+    }
+};
+
+#if defined(ANGLE_INDEX_RANGE_SSE2)
+template <class IndexType>
+struct SSE2Kernel
+{
+    static IndexRange Compute(const IndexType *indices, size_t count, bool primitiveRestartEnabled)
+    {
+        return ComputeTypedIndexRangeSSE2(indices, count, primitiveRestartEnabled);
+    }
+};
+
+template <class IndexType>
+struct AVX2Kernel
+{
+    static IndexRange Compute(const IndexType *indices, size_t count, bool primitiveRestartEnabled)
+    {
+        return ComputeTypedIndexRangeAVX2(indices, count, primitiveRestartEnabled);
+    }
+};
+#endif  // defined(ANGLE_INDEX_RANGE_SSE2)
+
+#if defined(ANGLE_INDEX_RANGE_NEON)
+template <class IndexType>
+struct NEONKernel
+{
+    static IndexRange Compute(const IndexType *indices, size_t count, bool primitiveRestartEnabled)
+    {
+        return ComputeTypedIndexRangeNEON(indices, count, primitiveRestartEnabled);
+    }
+};
+#endif  // defined(ANGLE_INDEX_RANGE_NEON)
+
+IndexRangeKernel SelectPreferredIndexRangeKernel()
+{
+    for (IndexRangeKernel kernel :
+         {IndexRangeKernel::AVX2, IndexRangeKernel::NEON, IndexRangeKernel::SSE2})
+    {
+        if (IsIndexRangeKernelSupported(kernel))
+        {
+            return kernel;
+        }
+    }
+    return IndexRangeKernel::Scalar;
+}
+}  // anonymous namespace
+
+bool IsIndexRangeKernelSupported(IndexRangeKernel kernel)
+{
+    switch (kernel)
+    {
+        case IndexRangeKernel::Scalar:
+            return true;
+#if defined(ANGLE_INDEX_RANGE_SSE2)
+        case IndexRangeKernel::SSE2:
+            return true;
+        case IndexRangeKernel::AVX2:
+        {
+            static const bool kSupportsAVX2 = SupportsAVX2();
+            return kSupportsAVX2;
+        }
+#endif  // defined(ANGLE_INDEX_RANGE_SSE2)
+#if defined(ANGLE_INDEX_RANGE_NEON)
+        case IndexRangeKernel::NEON:
+            return true;
+#endif  // defined(ANGLE_INDEX_RANGE_NEON)
+        default:
+            return false;
+    }
+}
+
+IndexRangeKernel GetPreferredIndexRangeKernel()
+{
+    static const IndexRangeKernel kPreferredKernel = SelectPreferredIndexRangeKernel();
+    return kPreferredKernel;
+}
+
+IndexRange ComputeIndexRangeWithKernel(IndexRangeKernel kernel,
+                                       DrawElementsType indexType,
+                                       const void *indices,
+                                       size_t count,
+                                       bool primitiveRestartEnabled)
+{
+    ASSERT(IsIndexRangeKernelSupported(kernel));
+
+    switch (kernel)
+    {
+#if defined(ANGLE_INDEX_RANGE_SSE2)
+        case IndexRangeKernel::SSE2:
+            return ComputeIndexRangeForType<SSE2Kernel>(indexType, indices, count,
+                                                        primitiveRestartEnabled);
+        case IndexRangeKernel::AVX2:
+            return ComputeIndexRangeForType<AVX2Kernel>(indexType, indices, count,
+                                                        primitiveRestartEnabled);
+#endif  // defined(ANGLE_INDEX_RANGE_SSE2)
+#if defined(ANGLE_INDEX_RANGE_NEON)
+        case IndexRangeKernel::NEON:
+            return ComputeIndexRangeForType<NEONKernel>(indexType, indices, count,
+                                                        primitiveRestartEnabled);
+#endif  // defined(ANGLE_INDEX_RANGE_NEON)
+        default:
+            return ComputeIndexRangeForType<ScalarKernel>(indexType, indices, count,
+                                                          primitiveRestartEnabled);
+    }
+}
+}  // namespace gl
@@ -0,0 +1,43 @@
+//
+// Copyright 2024 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// index_range_utils.h: Vectorized computation of the range of an index buffer.
+//
+
+#ifndef COMMON_INDEX_RANGE_UTILS_H_
+#define COMMON_INDEX_RANGE_UTILS_H_
+
+#include "common/PackedEnums.h"
+#include "common/mathutil.h"
+
+namespace gl
+{
+// The implementations of ComputeIndexRange.  Only the scalar one is available everywhere; the
+// others depend on the architecture and, for AVX2, on the CPU.
+enum class IndexRangeKernel
+{
+    Scalar,
+    SSE2,
+    AVX2,
+    NEON,
+
+    InvalidEnum,
+    EnumCount = InvalidEnum,
+};
+
+bool IsIndexRangeKernelSupported(IndexRangeKernel kernel);
+
+// The fastest kernel supported by the CPU.  Selected on first use.
+IndexRangeKernel GetPreferredIndexRangeKernel();
+
+// Same as ComputeIndexRange, using the given kernel, which must be supported.
+IndexRange ComputeIndexRangeWithKernel(IndexRangeKernel kernel,
+                                       DrawElementsType indexType,
+                                       const void *indices,
+                                       size_t count,
+                                       bool primitiveRestartEnabled);
+}  // namespace gl
+
+#endif  // COMMON_INDEX_RANGE_UTILS_H_
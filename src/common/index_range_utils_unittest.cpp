@@ -0,0 +1,146 @@
+//
+// Copyright 2024 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// index_range_utils_unittest: Tests that the vectorized index range kernels match the scalar one.
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "common/index_range_utils.h"
+#include "common/utilities.h"
+
+using namespace gl;
+
+namespace
+{
+constexpr IndexRangeKernel kVectorKernels[] = {IndexRangeKernel::SSE2, IndexRangeKernel::AVX2,
+                                               IndexRangeKernel::NEON};
+
+void ExpectSameRange(const IndexRange &expected, const IndexRange &actual)
+{
+    EXPECT_EQ(expected.start, actual.start);
+    EXPECT_EQ(expected.end, actual.end);
+    EXPECT_EQ(expected.vertexIndexCount, actual.vertexIndexCount);
+}
+
+template <typename IndexType>
+void TestKernels(DrawElementsType indexType)
+{
+    constexpr IndexType kRestartIndex = GetPrimitiveRestartIndexFromType<IndexType>();
+    std::mt19937 rng(static_cast<uint32_t>(indexType));
+
+    // Cover counts below, at and above the vector widths, and unaligned starting addresses.
+    for (size_t count : {1, 2, 7, 15, 16, 17, 31, 32, 33, 63, 64, 65, 1000, 4099})
+    {
+        for (size_t offset : {0, 1, 3})
+        {
+            for (uint32_t restartFrequency : {0, 2, 16})
+            {
+                std::vector<IndexType> storage(count + offset);
+                for (IndexType &index : storage)
+                {
+                    index = static_cast<IndexType>(rng() % kRestartIndex);
+                    if (restartFrequency != 0 && rng() % restartFrequency == 0)
+                    {
+                        index = kRestartIndex;
+                    }
+                }
+                const IndexType *indices = storage.data() + offset;
+
+                for (bool restartEnabled : {false, true})
+                {
+                    const IndexRange expected = ComputeIndexRangeWithKernel(
+                        IndexRangeKernel::Scalar, indexType, indices, count, restartEnabled);
+                    for (IndexRangeKernel kernel : kVectorKernels)
+                    {
+                        if (IsIndexRangeKernelSupported(kernel))
+                        {
+                            ExpectSameRange(expected,
+                                            ComputeIndexRangeWithKernel(
+                                                kernel, indexType, indices, count, restartEnabled));
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+template <typename IndexType>
+void TestEdgeValues(DrawElementsType indexType)
+{
+    constexpr IndexType kRestartIndex = GetPrimitiveRestartIndexFromType<IndexType>();
+
+    // All restart indices, only zeros with restart indices, and values next to the restart index.
+    const std::vector<std::vector<IndexType>> inputs = {
+        std::vector<IndexType>(100, kRestartIndex),
+        std::vector<IndexType>(100, 0),
+        std::vector<IndexType>(100, static_cast<IndexType>(kRestartIndex - 1)),
+    };
+
+    for (std::vector<IndexType> input : inputs)
+    {
+        input[50] = kRestartIndex;
+        for (bool restartEnabled : {false, true})
+        {
+            const IndexRange expected = ComputeIndexRangeWithKernel(
+                IndexRangeKernel::Scalar, indexType, input.data(), input.size(), restartEnabled);
+            for (IndexRangeKernel kernel : kVectorKernels)
+            {
+                if (IsIndexRangeKernelSupported(kernel))
+                {
+                    ExpectSameRange(expected,
+                                    ComputeIndexRangeWithKernel(kernel, indexType, input.data(),
+                                                                input.size(), restartEnabled));
+                }
+            }
+        }
+    }
+}
+
+// Tests the kernels with unsigned byte indices.
+TEST(IndexRangeUtils, UnsignedByte)
+{
+    TestKernels<GLubyte>(DrawElementsType::UnsignedByte);
+    TestEdgeValues<GLubyte>(DrawElementsType::UnsignedByte);
+}
+
+// Tests the kernels with unsigned short indices.
+TEST(IndexRangeUtils, UnsignedShort)
+{
+    TestKernels<GLushort>(DrawElementsType::UnsignedShort);
+    TestEdgeValues<GLushort>(DrawElementsType::UnsignedShort);
+}
+
+// Tests the kernels with unsigned int indices.
+TEST(IndexRangeUtils, UnsignedInt)
+{
+    TestKernels<GLuint>(DrawElementsType::UnsignedInt);
+    TestEdgeValues<GLuint>(DrawElementsType::UnsignedInt);
+}
+
+// Tests the scalar kernel against known ranges.
+TEST(IndexRangeUtils, KnownRanges)
+{
+    const GLushort indices[] = {5, 0xFFFF, 3, 9, 0xFFFF, 4};
+
+    IndexRange range = ComputeIndexRange(DrawElementsType::UnsignedShort, indices, 6, false);
+    EXPECT_EQ(range.start, 3u);
+    EXPECT_EQ(range.end, 0xFFFFu);
+    EXPECT_EQ(range.vertexIndexCount, 6u);
+
+    range = ComputeIndexRange(DrawElementsType::UnsignedShort, indices, 6, true);
+    EXPECT_EQ(range.start, 3u);
+    EXPECT_EQ(range.end, 9u);
+    EXPECT_EQ(range.vertexIndexCount, 4u);
+
+    range = ComputeIndexRange(DrawElementsType::UnsignedShort, indices + 1, 1, true);
+    EXPECT_EQ(range.start, 0u);
+    EXPECT_EQ(range.end, 0u);
+    EXPECT_EQ(range.vertexIndexCount, 0u);
+}
+}  // anonymous namespace
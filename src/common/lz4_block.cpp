@@ -0,0 +1,294 @@
+//
+// Copyright 2024 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// lz4_block: A small, dependency-free encoder and decoder for the LZ4 block format.
+//
+
+#include "common/lz4_block.h"
+
+#include <array>
+#include <cstring>
+
+namespace angle
+{
+namespace
+{
+// Constants dictated by the LZ4 block format.
+constexpr size_t kMinMatch = 4;
+// The last 5 bytes of the input are always literals.
+constexpr size_t kLastLiterals = 5;
+// The last match must start at least 12 bytes before the end of the input.
+constexpr size_t kMatchFindLimit = 12;
+constexpr size_t kMaxOffset      = 65535;
+constexpr uint32_t kRunMask      = 15;
+
+// A 4K-entry hash table keeps the encoder's state in L1 cache.
+constexpr uint32_t kHashLog     = 12;
+constexpr size_t kHashTableSize = 1 << kHashLog;
+constexpr uint32_t kSkipTrigger = 6;
+
+uint32_t Read32(const uint8_t *ptr)
+{
+    uint32_t value;
+    memcpy(&value, ptr, sizeof(value));
+    return value;
+}
+
+uint32_t HashSequence(uint32_t sequence)
+{
+    return (sequence * 2654435761u) >> (32 - kHashLog);
+}
+
+// Writes a length that did not fit in a token nibble.  Returns nullptr if out of space.
+uint8_t *WriteLengthExtension(size_t length, uint8_t *op, const uint8_t *opEnd)
+{
+    while (length >= 255)
+    {
+        if (op >= opEnd)
+        {
+            return nullptr;
+        }
+        *op++ = 255;
+        length -= 255;
+    }
+    if (op >= opEnd)
+    {
+        return nullptr;
+    }
+    *op++ = static_cast<uint8_t>(length);
+    return op;
+}
+
+// Emits a token, the literals [literals, literals + literalLength) and, if |matchLength| is
+// non-zero, the match offset and length.  Returns nullptr if out of space.
+uint8_t *WriteSequence(const uint8_t *literals,
+                       size_t literalLength,
+                       size_t offset,
+                       size_t matchLength,
+                       uint8_t *op,
+                       const uint8_t *opEnd)
+{
+    if (op >= opEnd)
+    {
+        return nullptr;
+    }
+    uint8_t *token = op++;
+
+    if (literalLength >= kRunMask)
+    {
+        *token = static_cast<uint8_t>(kRunMask << 4);
+        op     = WriteLengthExtension(literalLength - kRunMask, op, opEnd);
+        if (op == nullptr)
+        {
+            return nullptr;
+        }
+    }
+    else
+    {
+        *token = static_cast<uint8_t>(literalLength << 4);
+    }
+
+    if (static_cast<size_t>(opEnd - op) < literalLength)
+    {
+        return nullptr;
+    }
+    memcpy(op, literals, literalLength);
+    op += literalLength;
+
+    // The final sequence carries literals only.
+    if (matchLength == 0)
+    {
+        return op;
+    }
+
+    if (opEnd - op < 2)
+    {
+        return nullptr;
+    }
+    *op++ = static_cast<uint8_t>(offset & 0xFF);
+    *op++ = static_cast<uint8_t>(offset >> 8);
+
+    const size_t encodedMatchLength = matchLength - kMinMatch;
+    if (encodedMatchLength >= kRunMask)
+    {
+        *token |= kRunMask;
+        op = WriteLengthExtension(encodedMatchLength - kRunMask, op, opEnd);
+    }
+    else
+    {
+        *token |= static_cast<uint8_t>(encodedMatchLength);
+    }
+
+    return op;
+}
+
+// Reads a length extension.  Returns false if the input ends prematurely.
+bool ReadLengthExtension(const uint8_t *src, size_t srcSize, size_t *ip, size_t *lengthInOut)
+{
+    uint8_t byte;
+    do
+    {
+        if (*ip >= srcSize)
+        {
+            return false;
+        }
+        byte = src[(*ip)++];
+        *lengthInOut += byte;
+    } while (byte == 255);
+    return true;
+}
+}  // anonymous namespace
+
+size_t Lz4BlockCompressBound(size_t srcSize)
+{
+    return srcSize + srcSize / 255 + 16;
+}
+
+size_t Lz4BlockCompress(const uint8_t *src, size_t srcSize, uint8_t *dst, size_t dstCapacity)
+{
+    uint8_t *op          = dst;
+    const uint8_t *opEnd = dst + dstCapacity;
+    size_t anchor        = 0;
+
+    if (srcSize > kMatchFindLimit)
+    {
+        // Positions are stored off by one so that zero means "empty".
+        std::array<uint32_t, kHashTableSize> hashTable = {};
+
+        const size_t matchStartLimit = srcSize - kMatchFindLimit;
+        const size_t matchEndLimit   = srcSize - kLastLiterals;
+        size_t ip                    = 0;
+        uint32_t searchCount         = 1 << kSkipTrigger;
+
+        while (ip <= matchStartLimit)
+        {
+            const uint32_t sequence = Read32(src + ip);
+            const uint32_t hash     = HashSequence(sequence);
+            const uint32_t entry    = hashTable[hash];
+            hashTable[hash]         = static_cast<uint32_t>(ip + 1);
+
+            if (entry == 0 || ip - (entry - 1) > kMaxOffset || Read32(src + entry - 1) != sequence)
+            {
+                // Step faster through incompressible data.
+                ip += searchCount++ >> kSkipTrigger;
+                continue;
+            }
+            searchCount = 1 << kSkipTrigger;
+
+            size_t matchPos = entry - 1;
+
+            // Extend the match backwards into the pending literals.
+            while (ip > anchor && matchPos > 0 && src[ip - 1] == src[matchPos - 1])
+            {
+                --ip;
+                --matchPos;
+            }
+
+            size_t matchLength = kMinMatch;
+            while (ip + matchLength < matchEndLimit &&
+                   src[matchPos + matchLength] == src[ip + matchLength])
+            {
+                ++matchLength;
+            }
+
+            op = WriteSequence(src + anchor, ip - anchor, ip - matchPos, matchLength, op, opEnd);
+            if (op == nullptr)
+            {
+                return 0;
+            }
+
+            ip += matchLength;
+            anchor = ip;
+
+            // Seed the table with a position inside the match to help find the next one.
+            if (ip - 2 <= matchStartLimit)
+            {
+                hashTable[HashSequence(Read32(src + ip - 2))] = static_cast<uint32_t>(ip - 2 + 1);
+            }
+        }
+    }
+
+    op = WriteSequence(src + anchor, srcSize - anchor, 0, 0, op, opEnd);
+    if (op == nullptr)
+    {
+        return 0;
+    }
+
+    return op - dst;
+}
+
+bool Lz4BlockDecompress(const uint8_t *src, size_t srcSize, uint8_t *dst, size_t dstSize)
+{
+    size_t ip = 0;
+    size_t op = 0;
+
+    while (ip < srcSize)
+    {
+        const uint8_t token = src[ip++];
+
+        size_t literalLength = token >> 4;
+        if (literalLength == kRunMask && !ReadLengthExtension(src, srcSize, &ip, &literalLength))
+        {
+            return false;
+        }
+
+        if (literalLength > srcSize - ip || literalLength > dstSize - op)
+        {
+            return false;
+        }
+        memcpy(dst + op, src + ip, literalLength);
+        ip += literalLength;
+        op += literalLength;
+
+        // The last sequence ends right after its literals.
+        if (ip == srcSize)
+        {
+            return op == dstSize;
+        }
+
+        if (srcSize - ip < 2)
+        {
+            return false;
+        }
+        const size_t offset = src[ip] | (static_cast<size_t>(src[ip + 1]) << 8);
+        ip += 2;
+        if (offset == 0 || offset > op)
+        {
+            return false;
+        }
+
+        size_t matchLength = token & kRunMask;
+        if (matchLength == kRunMask && !ReadLengthExtension(src, srcSize, &ip, &matchLength))
+        {
+            return false;
+        }
+        matchLength += kMinMatch;
+
+        if (matchLength > dstSize - op)
+        {
+            return false;
+        }
+
+        const uint8_t *match = dst + op - offset;
+        if (offset >= matchLength)
+        {
+            memcpy(dst + op, match, matchLength);
+        }
+        else
+        {
+            // Overlapping copy, used to encode runs.
+            for (size_t i = 0; i < matchLength; ++i)
+            {
+                dst[op + i] = match[i];
+            }
+        }
+        op += matchLength;
+    }
+
+    // An empty input is only valid for an empty output.
+    return srcSize == 0 && dstSize == 0;
+}
+
+}  // namespace angle
@@ -0,0 +1,34 @@
+//
+// Copyright 2024 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// lz4_block: A small, dependency-free encoder and decoder for the LZ4 block format.  Used where
+//   decompression latency matters more than compression ratio, such as loading blobs from the
+//   program and pipeline caches at startup.
+//
+
+#ifndef COMMON_LZ4_BLOCK_H_
+#define COMMON_LZ4_BLOCK_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace angle
+{
+
+// Returns the maximum size the compressed output can take for |srcSize| bytes of input.
+size_t Lz4BlockCompressBound(size_t srcSize);
+
+// Compresses |srcSize| bytes from |src| into |dst|.  Returns the number of bytes written, or 0 if
+// |dstCapacity| is too small.  A capacity of Lz4BlockCompressBound(srcSize) always suffices.
+size_t Lz4BlockCompress(const uint8_t *src, size_t srcSize, uint8_t *dst, size_t dstCapacity);
+
+// Decompresses |srcSize| bytes from |src| into |dst|, which must be exactly |dstSize| bytes (the
+// uncompressed size is not stored in the block format).  Returns false if the input is malformed
+// or does not decode to exactly |dstSize| bytes.  Never reads or writes out of bounds.
+bool Lz4BlockDecompress(const uint8_t *src, size_t srcSize, uint8_t *dst, size_t dstSize);
+
+}  // namespace angle
+
+#endif  // COMMON_LZ4_BLOCK_H_
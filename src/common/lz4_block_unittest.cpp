@@ -0,0 +1,119 @@
+//
+// Copyright 2024 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// lz4_block_unittest: Tests for the LZ4 block encoder and decoder.
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "common/lz4_block.h"
+
+using namespace angle;
+
+namespace
+{
+std::vector<uint8_t> Compress(const std::vector<uint8_t> &input)
+{
+    std::vector<uint8_t> compressed(Lz4BlockCompressBound(input.size()));
+    size_t compressedSize =
+        Lz4BlockCompress(input.data(), input.size(), compressed.data(), compressed.size());
+    EXPECT_NE(compressedSize, 0u);
+    compressed.resize(compressedSize);
+    return compressed;
+}
+
+void CheckRoundTrip(const std::vector<uint8_t> &input)
+{
+    std::vector<uint8_t> compressed = Compress(input);
+    std::vector<uint8_t> decompressed(input.size());
+    ASSERT_TRUE(Lz4BlockDecompress(compressed.data(), compressed.size(), decompressed.data(),
+                                   decompressed.size()));
+    EXPECT_EQ(input, decompressed);
+}
+
+// Tests inputs too small to contain a match.
+TEST(Lz4BlockTest, TinyInputs)
+{
+    for (size_t size = 0; size < 32; ++size)
+    {
+        std::vector<uint8_t> input(size, 0x5A);
+        CheckRoundTrip(input);
+    }
+}
+
+// Tests that repetitive data round-trips and actually compresses.
+TEST(Lz4BlockTest, Compressible)
+{
+    std::vector<uint8_t> input(256 * 1024);
+    for (size_t i = 0; i < input.size(); ++i)
+    {
+        input[i] = static_cast<uint8_t>((i % 61) * 3);
+    }
+    CheckRoundTrip(input);
+    EXPECT_LT(Compress(input).size(), input.size() / 10);
+
+    // Long runs of a single byte exercise overlapping matches.
+    std::vector<uint8_t> run(100000, 7);
+    CheckRoundTrip(run);
+}
+
+// Tests that random data round-trips and stays within the bound.
+TEST(Lz4BlockTest, Incompressible)
+{
+    std::mt19937 rng(1);
+    std::vector<uint8_t> input(70000);
+    for (uint8_t &byte : input)
+    {
+        byte = static_cast<uint8_t>(rng());
+    }
+    CheckRoundTrip(input);
+    EXPECT_LE(Compress(input).size(), Lz4BlockCompressBound(input.size()));
+}
+
+// Tests that compression fails cleanly when the destination is too small.
+TEST(Lz4BlockTest, DestinationTooSmall)
+{
+    std::vector<uint8_t> input(1000, 1);
+    std::vector<uint8_t> compressed(4);
+    EXPECT_EQ(0u,
+              Lz4BlockCompress(input.data(), input.size(), compressed.data(), compressed.size()));
+}
+
+// Tests that malformed input is rejected.
+TEST(Lz4BlockTest, MalformedInput)
+{
+    std::vector<uint8_t> input(4096);
+    for (size_t i = 0; i < input.size(); ++i)
+    {
+        input[i] = static_cast<uint8_t>(i / 16);
+    }
+    std::vector<uint8_t> compressed = Compress(input);
+    std::vector<uint8_t> decompressed(input.size());
+
+    // Truncated input.
+    EXPECT_FALSE(Lz4BlockDecompress(compressed.data(), compressed.size() - 1, decompressed.data(),
+                                    decompressed.size()));
+
+    // Wrong output size.
+    EXPECT_FALSE(Lz4BlockDecompress(compressed.data(), compressed.size(), decompressed.data(),
+                                    decompressed.size() - 1));
+
+    // An offset pointing before the start of the output.
+    const uint8_t badOffset[] = {0x10, 'a', 0xFF, 0x00, 0x00};
+    EXPECT_FALSE(Lz4BlockDecompress(badOffset, sizeof(badOffset), decompressed.data(),
+                                    decompressed.size()));
+
+    // Random garbage must not crash.
+    std::mt19937 rng(2);
+    for (uint8_t &byte : compressed)
+    {
+        byte = static_cast<uint8_t>(rng());
+    }
+    Lz4BlockDecompress(compressed.data(), compressed.size(), decompressed.data(),
+                       decompressed.size());
+}
+}  // anonymous namespace
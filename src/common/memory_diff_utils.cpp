@@ -0,0 +1,146 @@
+//
+// Copyright 2024 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// memory_diff_utils.cpp: Finds the parts of a memory range that changed since it was captured.
+//
+
+#include "common/memory_diff_utils.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+#include "common/debug.h"
+
+#if defined(ANGLE_USE_SSE) && \
+    (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#    define ANGLE_MEMORY_DIFF_SSE2 1
+#    include <emmintrin.h>
+#endif
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+#    define ANGLE_MEMORY_DIFF_NEON 1
+#    include <arm_neon.h>
+#endif
+
+namespace angle
+{
+namespace
+{
+bool IsBlockChanged(const uint8_t *current, const uint8_t *captured)
+{
+    static_assert(kMemoryDiffBlockSize % 16 == 0, "Blocks are compared 16 bytes at a time");
+
+#if defined(ANGLE_MEMORY_DIFF_SSE2)
+    __m128i equal = _mm_set1_epi8(-1);
+    for (size_t offset = 0; offset < kMemoryDiffBlockSize; offset += 16)
+    {
+        __m128i currentBytes =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(current + offset));
+        __m128i capturedBytes =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(captured + offset));
+        equal = _mm_and_si128(equal, _mm_cmpeq_epi8(currentBytes, capturedBytes));
+    }
+    return _mm_movemask_epi8(equal) != 0xFFFF;
+#elif defined(ANGLE_MEMORY_DIFF_NEON)
+    uint8x16_t equal = vdupq_n_u8(0xFF);
+    for (size_t offset = 0; offset < kMemoryDiffBlockSize; offset += 16)
+    {
+        equal = vandq_u8(equal, vceqq_u8(vld1q_u8(current + offset), vld1q_u8(captured + offset)));
+    }
+    return vminvq_u8(equal) != 0xFF;
+#else
+    return memcmp(current, captured, kMemoryDiffBlockSize) != 0;
+#endif
+}
+}  // anonymous namespace
+
+void FindChangedByteRanges(const uint8_t *current,
+                           const uint8_t *captured,
+                           size_t size,
+                           std::vector<ByteRange> *changedRangesOut)
+{
+    const size_t firstNewRange = changedRangesOut->size();
+
+    for (size_t offset = 0; offset < size; offset += kMemoryDiffBlockSize)
+    {
+        size_t blockSize = std::min(kMemoryDiffBlockSize, size - offset);
+        bool changed     = blockSize == kMemoryDiffBlockSize
+                               ? IsBlockChanged(current + offset, captured + offset)
+                               : memcmp(current + offset, captured + offset, blockSize) != 0;
+        if (!changed)
+        {
+            continue;
+        }
+
+        if (changedRangesOut->size() > firstNewRange)
+        {
+            ByteRange &lastRange = changedRangesOut->back();
+            if (offset - (lastRange.offset + lastRange.size) <= kMemoryDiffMergeDistance)
+            {
+                lastRange.size = offset + blockSize - lastRange.offset;
+                continue;
+            }
+        }
+
+        changedRangesOut->push_back({offset, blockSize});
+    }
+}
+
+CapturedMemory::CapturedMemory()  = default;
+CapturedMemory::~CapturedMemory() = default;
+
+void CapturedMemory::init(size_t size, size_t pageCount)
+{
+    ASSERT(pageCount > 0);
+    mData.resize(size);
+    mCapturedPages.assign(pageCount, false);
+}
+
+void CapturedMemory::capture(const uint8_t *current,
+                             size_t offset,
+                             size_t size,
+                             size_t startPage,
+                             size_t endPage,
+                             std::vector<ByteRange> *changedRangesOut)
+{
+    ASSERT(offset + size <= mData.size());
+    ASSERT(startPage < endPage && endPage <= mCapturedPages.size());
+
+    uint8_t *captured = mData.data() + offset;
+
+    auto pagesBegin = mCapturedPages.begin() + startPage;
+    auto pagesEnd   = mCapturedPages.begin() + endPage;
+    if (std::find(pagesBegin, pagesEnd, false) != pagesEnd)
+    {
+        // The content of these pages in the replay is unknown, so they are captured whole.
+        changedRangesOut->push_back({offset, size});
+        std::fill(pagesBegin, pagesEnd, true);
+    }
+    else
+    {
+        const size_t firstNewRange = changedRangesOut->size();
+        FindChangedByteRanges(current, captured, size, changedRangesOut);
+        for (size_t index = firstNewRange; index < changedRangesOut->size(); ++index)
+        {
+            (*changedRangesOut)[index].offset += offset;
+        }
+    }
+
+    memcpy(captured, current, size);
+}
+
+void CapturedMemory::invalidatePages(size_t startPage, size_t endPage)
+{
+    if (!isInitialized())
+    {
+        // Nothing was captured yet.
+        return;
+    }
+
+    ASSERT(startPage <= endPage && endPage <= mCapturedPages.size());
+    std::fill(mCapturedPages.begin() + startPage, mCapturedPages.begin() + endPage, false);
+}
+}  // namespace angle
@@ -0,0 +1,73 @@
+//
+// Copyright 2024 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// memory_diff_utils.h: Finds the parts of a memory range that changed since it was captured.
+//
+
+#ifndef COMMON_MEMORY_DIFF_UTILS_H_
+#define COMMON_MEMORY_DIFF_UTILS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "common/angleutils.h"
+
+namespace angle
+{
+// Memory is compared with the data captured before in blocks of this many bytes.  Changed blocks
+// closer than the merge distance are reported as one range, as each range costs a call in the
+// replay.
+constexpr size_t kMemoryDiffBlockSize     = 64;
+constexpr size_t kMemoryDiffMergeDistance = 256;
+
+// A range of bytes, relative to the start of the memory it is in.
+struct ByteRange
+{
+    size_t offset;
+    size_t size;
+};
+
+// Appends the ranges of the |size| bytes at |current| that differ from |captured|.  The offsets of
+// the ranges are relative to |current|.
+void FindChangedByteRanges(const uint8_t *current,
+                           const uint8_t *captured,
+                           size_t size,
+                           std::vector<ByteRange> *changedRangesOut);
+
+// Keeps a copy of the data last captured from a memory range, divided in pages by the user.  Pages
+// that were never captured, or whose copy was invalidated, are captured whole; other pages are
+// compared with the copy.
+class CapturedMemory final : angle::NonCopyable
+{
+  public:
+    CapturedMemory();
+    ~CapturedMemory();
+
+    // Allocates the copy on first use, as it's as large as the memory range.
+    bool isInitialized() const { return !mCapturedPages.empty(); }
+    void init(size_t size, size_t pageCount);
+
+    // Captures the |size| bytes at |current|, which are at |offset| in the memory range and span
+    // the pages [startPage, endPage), appending the ranges that must be captured.
+    void capture(const uint8_t *current,
+                 size_t offset,
+                 size_t size,
+                 size_t startPage,
+                 size_t endPage,
+                 std::vector<ByteRange> *changedRangesOut);
+
+    // Forgets the copy of the pages [startPage, endPage), for when they were modified by means
+    // other than the ones captured.
+    void invalidatePages(size_t startPage, size_t endPage);
+
+  private:
+    std::vector<uint8_t> mData;
+    std::vector<bool> mCapturedPages;
+};
+}  // namespace angle
+
+#endif  // COMMON_MEMORY_DIFF_UTILS_H_
@@ -0,0 +1,179 @@
+//
+// Copyright 2024 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// memory_diff_utils_unittest: Tests for finding the changes in captured memory.
+
+#include <gtest/gtest.h>
+
+#include <ostream>
+#include <vector>
+
+#include "common/memory_diff_utils.h"
+
+using namespace angle;
+
+namespace angle
+{
+bool operator==(const ByteRange &a, const ByteRange &b)
+{
+    return a.offset == b.offset && a.size == b.size;
+}
+
+std::ostream &operator<<(std::ostream &os, const ByteRange &range)
+{
+    return os << "{" << range.offset << ", " << range.size << "}";
+}
+}  // namespace angle
+
+namespace
+{
+constexpr size_t kPageSize = 4096;
+
+std::vector<ByteRange> FindChanges(const std::vector<uint8_t> &current,
+                                   const std::vector<uint8_t> &captured)
+{
+    std::vector<ByteRange> changedRanges;
+    FindChangedByteRanges(current.data(), captured.data(), current.size(), &changedRanges);
+    return changedRanges;
+}
+
+// Tests that identical data has no changes.
+TEST(MemoryDiffUtilsTest, NoChange)
+{
+    std::vector<uint8_t> data(kPageSize, 7);
+    EXPECT_TRUE(FindChanges(data, data).empty());
+}
+
+// Tests that a changed byte is reported as the block containing it.
+TEST(MemoryDiffUtilsTest, SingleChange)
+{
+    std::vector<uint8_t> captured(kPageSize, 0);
+    std::vector<uint8_t> current          = captured;
+    current[kMemoryDiffBlockSize * 3 + 5] = 1;
+
+    std::vector<ByteRange> expected = {{kMemoryDiffBlockSize * 3, kMemoryDiffBlockSize}};
+    EXPECT_EQ(expected, FindChanges(current, captured));
+}
+
+// Tests that changed blocks within the merge distance are merged, and blocks further apart
+// aren't.
+TEST(MemoryDiffUtilsTest, MergeBlocks)
+{
+    std::vector<uint8_t> captured(kPageSize, 0);
+    std::vector<uint8_t> current = captured;
+
+    // Two blocks separated by exactly the merge distance.
+    const size_t secondBlock = kMemoryDiffBlockSize + kMemoryDiffMergeDistance;
+    current[0]               = 1;
+    current[secondBlock]     = 1;
+
+    // A block further than the merge distance from the second one.
+    const size_t thirdBlock = secondBlock + kMemoryDiffBlockSize + kMemoryDiffMergeDistance +
+                              kMemoryDiffBlockSize;
+    current[thirdBlock + kMemoryDiffBlockSize - 1] = 1;
+
+    std::vector<ByteRange> expected = {{0, secondBlock + kMemoryDiffBlockSize},
+                                       {thirdBlock, kMemoryDiffBlockSize}};
+    EXPECT_EQ(expected, FindChanges(current, captured));
+}
+
+// Tests that a last block smaller than the block size is compared, and reported with its actual
+// size.
+TEST(MemoryDiffUtilsTest, TailBlock)
+{
+    constexpr size_t kSize = kMemoryDiffBlockSize * 4 + 10;
+    std::vector<uint8_t> captured(kSize, 0);
+    std::vector<uint8_t> current = captured;
+
+    EXPECT_TRUE(FindChanges(current, captured).empty());
+
+    current[kSize - 1]              = 1;
+    std::vector<ByteRange> expected = {{kMemoryDiffBlockSize * 4, 10}};
+    EXPECT_EQ(expected, FindChanges(current, captured));
+
+    // Merged with a preceding block.
+    current[kMemoryDiffBlockSize * 2] = 1;
+    expected                          = {{kMemoryDiffBlockSize * 2, kMemoryDiffBlockSize * 2 + 10}};
+    EXPECT_EQ(expected, FindChanges(current, captured));
+}
+
+// Tests that ranges found by an earlier call are not merged with new ones.
+TEST(MemoryDiffUtilsTest, AppendRanges)
+{
+    std::vector<uint8_t> captured(kPageSize, 0);
+    std::vector<uint8_t> current = captured;
+    current[0]                   = 1;
+
+    std::vector<ByteRange> changedRanges = {{100, 1}};
+    FindChangedByteRanges(current.data(), captured.data(), current.size(), &changedRanges);
+
+    std::vector<ByteRange> expected = {{100, 1}, {0, kMemoryDiffBlockSize}};
+    EXPECT_EQ(expected, changedRanges);
+}
+
+// Tests that pages are captured whole the first time, and only their changes afterwards.
+TEST(MemoryDiffUtilsTest, CapturedMemoryFirstCapture)
+{
+    constexpr size_t kPageCount = 4;
+    std::vector<uint8_t> memory(kPageSize * kPageCount, 0);
+
+    CapturedMemory capturedMemory;
+    EXPECT_FALSE(capturedMemory.isInitialized());
+    capturedMemory.init(memory.size(), kPageCount);
+    EXPECT_TRUE(capturedMemory.isInitialized());
+
+    // First capture of pages 1 and 2: captured whole, even without changes.
+    std::vector<ByteRange> changedRanges;
+    capturedMemory.capture(memory.data() + kPageSize, kPageSize, kPageSize * 2, 1, 3,
+                           &changedRanges);
+    std::vector<ByteRange> expected = {{kPageSize, kPageSize * 2}};
+    EXPECT_EQ(expected, changedRanges);
+
+    // Unchanged since.
+    changedRanges.clear();
+    capturedMemory.capture(memory.data() + kPageSize, kPageSize, kPageSize * 2, 1, 3,
+                           &changedRanges);
+    EXPECT_TRUE(changedRanges.empty());
+
+    // Only the change is captured, at its offset in the memory.
+    memory[kPageSize * 2 + 1] = 1;
+    capturedMemory.capture(memory.data() + kPageSize * 2, kPageSize * 2, kPageSize, 2, 3,
+                           &changedRanges);
+    expected = {{kPageSize * 2, kMemoryDiffBlockSize}};
+    EXPECT_EQ(expected, changedRanges);
+
+    // A range including a page never captured before is captured whole.
+    changedRanges.clear();
+    capturedMemory.capture(memory.data() + kPageSize * 2, kPageSize * 2, kPageSize * 2, 2, 4,
+                           &changedRanges);
+    expected = {{kPageSize * 2, kPageSize * 2}};
+    EXPECT_EQ(expected, changedRanges);
+}
+
+// Tests that invalidated pages are captured whole again, even if their content matches the copy.
+TEST(MemoryDiffUtilsTest, CapturedMemoryInvalidate)
+{
+    constexpr size_t kPageCount = 3;
+    std::vector<uint8_t> memory(kPageSize * kPageCount, 0);
+
+    // Invalidating before anything is captured does nothing.
+    CapturedMemory capturedMemory;
+    capturedMemory.invalidatePages(0, kPageCount);
+
+    capturedMemory.init(memory.size(), kPageCount);
+    std::vector<ByteRange> changedRanges;
+    capturedMemory.capture(memory.data(), 0, memory.size(), 0, kPageCount, &changedRanges);
+
+    capturedMemory.invalidatePages(1, 2);
+
+    changedRanges.clear();
+    capturedMemory.capture(memory.data(), 0, kPageSize, 0, 1, &changedRanges);
+    EXPECT_TRUE(changedRanges.empty());
+
+    capturedMemory.capture(memory.data() + kPageSize, kPageSize, kPageSize, 1, 2, &changedRanges);
+    std::vector<ByteRange> expected = {{kPageSize, kPageSize}};
+    EXPECT_EQ(expected, changedRanges);
+}
+}  // anonymous namespace
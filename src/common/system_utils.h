@@ -191,6 +191,42 @@ bool UnprotectMemory(uintptr_t start, size_t size);
 
 size_t GetPageSize();
 
+// Maps a whole file into memory with copy-on-write semantics, so the data can be modified without
+// changing the file.  Returns nullptr if the file can't be mapped or is empty.
+void *MapFile(const char *path, size_t *sizeOut);
+void UnmapFile(void *data, size_t size);
+
+class MemoryMappedFile : angle::NonCopyable
+{
+  public:
+    MemoryMappedFile() {}
+    ~MemoryMappedFile() { close(); }
+
+    [[nodiscard]] bool open(const char *path)
+    {
+        close();
+        mData = static_cast<uint8_t *>(MapFile(path, &mSize));
+        return mData != nullptr;
+    }
+
+    void close()
+    {
+        if (mData)
+        {
+            UnmapFile(mData, mSize);
+            mData = nullptr;
+            mSize = 0;
+        }
+    }
+
+    uint8_t *data() const { return mData; }
+    size_t size() const { return mSize; }
+
+  private:
+    uint8_t *mData = nullptr;
+    size_t mSize   = 0;
+};
+
 // Return type of the PageFaultCallback
 enum class PageFaultHandlerRangeType
 {
@@ -13,6 +13,7 @@
 #include <iostream>
 
 #include <dlfcn.h>
+#include <fcntl.h>
 #include <grp.h>
 #include <inttypes.h>
 #include <pwd.h>
@@ -478,6 +479,36 @@ size_t GetPageSize()
     return static_cast<size_t>(pageSize);
 }
 
+void *MapFile(const char *path, size_t *sizeOut)
+{
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        return nullptr;
+    }
+
+    struct stat fileStat;
+    void *data = nullptr;
+    if (fstat(fd, &fileStat) == 0 && fileStat.st_size > 0)
+    {
+        *sizeOut = static_cast<size_t>(fileStat.st_size);
+        data     = mmap(nullptr, *sizeOut, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED)
+        {
+            data = nullptr;
+        }
+    }
+
+    // The mapping keeps its own reference to the file.
+    close(fd);
+    return data;
+}
+
+void UnmapFile(void *data, size_t size)
+{
+    munmap(data, size);
+}
+
 PageFaultHandler *CreatePageFaultHandler(PageFaultCallback callback)
 {
     gPosixPageFaultHandler = new PosixPageFaultHandler(callback);
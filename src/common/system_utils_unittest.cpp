@@ -214,9 +214,11 @@ TEST(SystemUtils, IsFullPath)
 #if defined(ANGLE_PLATFORM_ANDROID)
 #    define MAYBE_CreateAndDeleteTemporaryFile DISABLED_CreateAndDeleteTemporaryFile
 #    define MAYBE_CreateAndDeleteFileInTempDir DISABLED_CreateAndDeleteFileInTempDir
+#    define MAYBE_MemoryMappedFile DISABLED_MemoryMappedFile
 #else
 #    define MAYBE_CreateAndDeleteTemporaryFile CreateAndDeleteTemporaryFile
 #    define MAYBE_CreateAndDeleteFileInTempDir CreateAndDeleteFileInTempDir
+#    define MAYBE_MemoryMappedFile MemoryMappedFile
 #endif  // defined(ANGLE_PLATFORM_ANDROID)
 
 // Test creating/using temporary file
@@ -282,6 +284,45 @@ TEST(SystemUtils, MAYBE_CreateAndDeleteFileInTempDir)
     EXPECT_TRUE(DeleteSystemFile(path.value().c_str()));
 }
 
+// Test mapping a file into memory
+TEST(SystemUtils, MAYBE_MemoryMappedFile)
+{
+    Optional<std::string> path = CreateTemporaryFile();
+    ASSERT_TRUE(path.valid());
+
+    const std::string testContents = "mapped contents";
+
+    std::ofstream out;
+    out.open(path.value(), std::ios::binary);
+    ASSERT_TRUE(out.is_open());
+    out << testContents;
+    out.close();
+
+    {
+        MemoryMappedFile file;
+        ASSERT_TRUE(file.open(path.value().c_str()));
+        ASSERT_EQ(testContents.size(), file.size());
+        EXPECT_EQ(0, memcmp(testContents.data(), file.data(), file.size()));
+
+        // Writes to the mapping are private and don't change the file.
+        file.data()[0] = 'M';
+    }
+
+    std::ifstream in;
+    in.open(path.value(), std::ios::binary);
+    std::ostringstream sstr;
+    sstr << in.rdbuf();
+    EXPECT_EQ(testContents, sstr.str());
+    in.close();
+
+    EXPECT_TRUE(DeleteSystemFile(path.value().c_str()));
+
+    // Missing files can't be mapped.
+    MemoryMappedFile missing;
+    EXPECT_FALSE(missing.open(path.value().c_str()));
+    EXPECT_EQ(nullptr, missing.data());
+}
+
 // Test retrieving page size
 TEST(SystemUtils, PageSize)
 {
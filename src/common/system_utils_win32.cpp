@@ -222,6 +222,39 @@ size_t GetPageSize()
     return static_cast<size_t>(info.dwPageSize);
 }
 
+void *MapFile(const char *path, size_t *sizeOut)
+{
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return nullptr;
+    }
+
+    void *data = nullptr;
+    LARGE_INTEGER fileSize;
+    if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0)
+    {
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+        if (mapping != nullptr)
+        {
+            *sizeOut = static_cast<size_t>(fileSize.QuadPart);
+            data     = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+
+            // The view keeps its own reference to the mapping and the file.
+            CloseHandle(mapping);
+        }
+    }
+
+    CloseHandle(file);
+    return data;
+}
+
+void UnmapFile(void *data, size_t size)
+{
+    UnmapViewOfFile(data);
+}
+
 PageFaultHandler *CreatePageFaultHandler(PageFaultCallback callback)
 {
     gWin32PageFaultHandler = new Win32PageFaultHandler(callback);
@@ -104,6 +104,17 @@ size_t GetPageSize()
     return 4096;
 }
 
+void *MapFile(const char *path, size_t *sizeOut)
+{
+    UNIMPLEMENTED();
+    return nullptr;
+}
+
+void UnmapFile(void *data, size_t size)
+{
+    UNIMPLEMENTED();
+}
+
 PageFaultHandler *CreatePageFaultHandler(PageFaultCallback callback)
 {
     return new UwpPageFaultHandler(callback);
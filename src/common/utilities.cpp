@@ -8,6 +8,7 @@
 
 #include "common/utilities.h"
 #include "GLES3/gl3.h"
+#include "common/index_range_utils.h"
 #include "common/mathutil.h"
 #include "common/platform.h"
 #include "common/string_utils.h"
@@ -21,78 +22,6 @@
 #    include <wrl/wrappers/corewrappers.h>
 #endif
 
-namespace
-{
-
-template <class IndexType>
-gl::IndexRange ComputeTypedIndexRange(const IndexType *indices,
-                                      size_t count,
-                                      bool primitiveRestartEnabled,
-                                      GLuint primitiveRestartIndex)
-{
-    ASSERT(count > 0);
-
-    IndexType minIndex                = 0;
-    IndexType maxIndex                = 0;
-    size_t nonPrimitiveRestartIndices = 0;
-
-    if (primitiveRestartEnabled)
-    {
-        // Find the first non-primitive restart index to initialize the min and max values
-        size_t i = 0;
-        for (; i < count; i++)
-        {
-            if (indices[i] != primitiveRestartIndex)
-            {
-                minIndex = indices[i];
-                maxIndex = indices[i];
-                nonPrimitiveRestartIndices++;
-                break;
-            }
-        }
-
-        // Loop over the rest of the indices
-        for (; i < count; i++)
-        {
-            if (indices[i] != primitiveRestartIndex)
-            {
-                if (minIndex > indices[i])
-                {
-                    minIndex = indices[i];
-                }
-                if (maxIndex < indices[i])
-                {
-                    maxIndex = indices[i];
-                }
-                nonPrimitiveRestartIndices++;
-            }
-        }
-    }
-    else
-    {
-        minIndex                   = indices[0];
-        maxIndex                   = indices[0];
-        nonPrimitiveRestartIndices = count;
-
-        for (size_t i = 1; i < count; i++)
-        {
-            if (minIndex > indices[i])
-            {
-                minIndex = indices[i];
-            }
-            if (maxIndex < indices[i])
-            {
-                maxIndex = indices[i];
-            }
-        }
-    }
-
-    return gl::IndexRange(static_cast<size_t>(minIndex), static_cast<size_t>(maxIndex),
-                          nonPrimitiveRestartIndices);
-}
-
-}  // anonymous namespace
-
 namespace gl
 {
 
@@ -699,24 +628,8 @@ IndexRange ComputeIndexRange(DrawElementsType indexType,
                              size_t count,
                              bool primitiveRestartEnabled)
 {
-    switch (indexType)
-    {
-        case DrawElementsType::UnsignedByte:
-            return ComputeTypedIndexRange(static_cast<const GLubyte *>(indices), count,
-                                          primitiveRestartEnabled,
-                                          GetPrimitiveRestartIndex(indexType));
-        case DrawElementsType::UnsignedShort:
-            return ComputeTypedIndexRange(static_cast<const GLushort *>(indices), count,
-                                          primitiveRestartEnabled,
-                                          GetPrimitiveRestartIndex(indexType));
-        case DrawElementsType::UnsignedInt:
-            return ComputeTypedIndexRange(static_cast<const GLuint *>(indices), count,
-                                          primitiveRestartEnabled,
-                                          GetPrimitiveRestartIndex(indexType));
-        default:
-            UNREACHABLE();
-            return IndexRange();
-    }
+    return ComputeIndexRangeWithKernel(GetPreferredIndexRangeKernel(), indexType, indices, count,
+                                       primitiveRestartEnabled);
 }
 
 GLuint GetPrimitiveRestartIndex(DrawElementsType indexType)
@@ -14,6 +14,7 @@
 #include "common/CompiledShaderState.h"
 #include "common/PackedEnums.h"
 #include "common/angle_version_info.h"
+#include "common/system_utils.h"
 
 #include "compiler/translator/CallDAG.h"
 #include "compiler/translator/CollectVariables.h"
@@ -340,6 +341,157 @@ bool ValidateFragColorAndFragData(GLenum shaderType,
     return true;
 }
 
+// Hashes the resources field by field.  Hashing the struct as raw bytes would include its padding
+// and the address of the hash function, which differs between runs with ASLR.  Fields added to
+// ShBuiltInResources need to be added here too.
+void HashBuiltInResources(const ShBuiltInResources &resources,
+                          angle::base::SecureHashAlgorithm *hasher)
+{
+    auto hashField = [hasher](const auto &field) { hasher->Update(&field, sizeof(field)); };
+
+    hashField(resources.MaxVertexAttribs);
+    hashField(resources.MaxVertexUniformVectors);
+    hashField(resources.MaxVaryingVectors);
+    hashField(resources.MaxVertexTextureImageUnits);
+    hashField(resources.MaxCombinedTextureImageUnits);
+    hashField(resources.MaxTextureImageUnits);
+    hashField(resources.MaxFragmentUniformVectors);
+    hashField(resources.MaxDrawBuffers);
+    hashField(resources.OES_standard_derivatives);
+    hashField(resources.OES_EGL_image_external);
+    hashField(resources.OES_EGL_image_external_essl3);
+    hashField(resources.NV_EGL_stream_consumer_external);
+    hashField(resources.ARB_texture_rectangle);
+    hashField(resources.EXT_blend_func_extended);
+    hashField(resources.EXT_conservative_depth);
+    hashField(resources.EXT_draw_buffers);
+    hashField(resources.EXT_frag_depth);
+    hashField(resources.EXT_shader_texture_lod);
+    hashField(resources.EXT_shader_framebuffer_fetch);
+    hashField(resources.EXT_shader_framebuffer_fetch_non_coherent);
+    hashField(resources.NV_shader_framebuffer_fetch);
+    hashField(resources.NV_shader_noperspective_interpolation);
+    hashField(resources.ARM_shader_framebuffer_fetch);
+    hashField(resources.OVR_multiview);
+    hashField(resources.OVR_multiview2);
+    hashField(resources.EXT_multisampled_render_to_texture);
+    hashField(resources.EXT_multisampled_render_to_texture2);
+    hashField(resources.EXT_YUV_target);
+    hashField(resources.EXT_geometry_shader);
+    hashField(resources.OES_geometry_shader);
+    hashField(resources.OES_shader_io_blocks);
+    hashField(resources.EXT_shader_io_blocks);
+    hashField(resources.EXT_gpu_shader5);
+    hashField(resources.EXT_shader_non_constant_global_initializers);
+    hashField(resources.OES_texture_storage_multisample_2d_array);
+    hashField(resources.OES_texture_3D);
+    hashField(resources.ANGLE_shader_pixel_local_storage);
+    hashField(resources.ANGLE_texture_multisample);
+    hashField(resources.ANGLE_multi_draw);
+    hashField(resources.ANGLE_base_vertex_base_instance);
+    hashField(resources.WEBGL_video_texture);
+    hashField(resources.APPLE_clip_distance);
+    hashField(resources.OES_texture_cube_map_array);
+    hashField(resources.EXT_texture_cube_map_array);
+    hashField(resources.EXT_shadow_samplers);
+    hashField(resources.OES_shader_multisample_interpolation);
+    hashField(resources.OES_shader_image_atomic);
+    hashField(resources.EXT_tessellation_shader);
+    hashField(resources.OES_texture_buffer);
+    hashField(resources.EXT_texture_buffer);
+    hashField(resources.OES_sample_variables);
+    hashField(resources.EXT_clip_cull_distance);
+    hashField(resources.ANGLE_clip_cull_distance);
+    hashField(resources.EXT_primitive_bounding_box);
+    hashField(resources.OES_primitive_bounding_box);
+    hashField(resources.EXT_separate_shader_objects);
+    hashField(resources.ANGLE_base_vertex_base_instance_shader_builtin);
+    hashField(resources.ANDROID_extension_pack_es31a);
+    hashField(resources.KHR_blend_equation_advanced);
+    hashField(resources.NV_draw_buffers);
+    hashField(resources.FragmentPrecisionHigh);
+    hashField(resources.MaxVertexOutputVectors);
+    hashField(resources.MaxFragmentInputVectors);
+    hashField(resources.MinProgramTexelOffset);
+    hashField(resources.MaxProgramTexelOffset);
+    hashField(resources.MaxDualSourceDrawBuffers);
+    hashField(resources.MaxViewsOVR);
+
+    // The address of the hash function changes from run to run, but only whether names are hashed
+    // affects the output.
+    const bool hasHashFunction = resources.HashFunction != nullptr;
+    hashField(hasHashFunction);
+
+    hashField(resources.MaxExpressionComplexity);
+    hashField(resources.MaxCallStackDepth);
+    hashField(resources.MaxFunctionParameters);
+    hashField(resources.MinProgramTextureGatherOffset);
+    hashField(resources.MaxProgramTextureGatherOffset);
+    hashField(resources.MaxImageUnits);
+    hashField(resources.MaxSamples);
+    hashField(resources.MaxVertexImageUniforms);
+    hashField(resources.MaxFragmentImageUniforms);
+    hashField(resources.MaxComputeImageUniforms);
+    hashField(resources.MaxCombinedImageUniforms);
+    hashField(resources.MaxUniformLocations);
+    hashField(resources.MaxCombinedShaderOutputResources);
+    hashField(resources.MaxComputeWorkGroupCount);
+    hashField(resources.MaxComputeWorkGroupSize);
+    hashField(resources.MaxComputeUniformComponents);
+    hashField(resources.MaxComputeTextureImageUnits);
+    hashField(resources.MaxComputeAtomicCounters);
+    hashField(resources.MaxComputeAtomicCounterBuffers);
+    hashField(resources.MaxVertexAtomicCounters);
+    hashField(resources.MaxFragmentAtomicCounters);
+    hashField(resources.MaxCombinedAtomicCounters);
+    hashField(resources.MaxAtomicCounterBindings);
+    hashField(resources.MaxVertexAtomicCounterBuffers);
+    hashField(resources.MaxFragmentAtomicCounterBuffers);
+    hashField(resources.MaxCombinedAtomicCounterBuffers);
+    hashField(resources.MaxAtomicCounterBufferSize);
+    hashField(resources.MaxUniformBufferBindings);
+    hashField(resources.MaxShaderStorageBufferBindings);
+    hashField(resources.MinPointSize);
+    hashField(resources.MaxPointSize);
+    hashField(resources.MaxGeometryUniformComponents);
+    hashField(resources.MaxGeometryUniformBlocks);
+    hashField(resources.MaxGeometryInputComponents);
+    hashField(resources.MaxGeometryOutputComponents);
+    hashField(resources.MaxGeometryOutputVertices);
+    hashField(resources.MaxGeometryTotalOutputComponents);
+    hashField(resources.MaxGeometryTextureImageUnits);
+    hashField(resources.MaxGeometryAtomicCounterBuffers);
+    hashField(resources.MaxGeometryAtomicCounters);
+    hashField(resources.MaxGeometryShaderStorageBlocks);
+    hashField(resources.MaxGeometryShaderInvocations);
+    hashField(resources.MaxGeometryImageUniforms);
+    hashField(resources.MaxTessControlInputComponents);
+    hashField(resources.MaxTessControlOutputComponents);
+    hashField(resources.MaxTessControlTextureImageUnits);
+    hashField(resources.MaxTessControlUniformComponents);
+    hashField(resources.MaxTessControlTotalOutputComponents);
+    hashField(resources.MaxTessControlImageUniforms);
+    hashField(resources.MaxTessControlAtomicCounters);
+    hashField(resources.MaxTessControlAtomicCounterBuffers);
+    hashField(resources.MaxTessPatchComponents);
+    hashField(resources.MaxPatchVertices);
+    hashField(resources.MaxTessGenLevel);
+    hashField(resources.MaxTessEvaluationInputComponents);
+    hashField(resources.MaxTessEvaluationOutputComponents);
+    hashField(resources.MaxTessEvaluationTextureImageUnits);
+    hashField(resources.MaxTessEvaluationUniformComponents);
+    hashField(resources.MaxTessEvaluationImageUniforms);
+    hashField(resources.MaxTessEvaluationAtomicCounters);
+    hashField(resources.MaxTessEvaluationAtomicCounterBuffers);
+    hashField(resources.SubPixelBits);
+    hashField(resources.MaxClipDistances);
+    hashField(resources.MaxCullDistances);
+    hashField(resources.MaxCombinedClipAndCullDistances);
+    hashField(resources.MaxPixelLocalStoragePlanes);
+    hashField(resources.MaxColorAttachmentsWithActivePixelLocalStorage);
+    hashField(resources.MaxCombinedDrawBuffersAndPixelLocalStoragePlanes);
+}
+
 }  // namespace
 
 TShHandleBase::TShHandleBase()
@@ -357,6 +509,11 @@ TShHandleBase::~TShHandleBase()
 TCompiler::TCompiler(sh::GLenum type, ShShaderSpec spec, ShShaderOutput output)
     : mVariablesCollected(false),
       mGLPositionInitialized(false),
+      mASTConstructsValid(false),
+      mSkipUntriggeredPasses(true),
+      mPassTimingEnabled(false),
+      mTranslatorCache(nullptr),
+      mCompileResultFromCache(false),
       mShaderType(type),
       mShaderSpec(spec),
       mOutputType(output),
@@ -747,11 +904,65 @@ void TCompiler::enableValidateNoMoreTransformations()
     mValidateASTOptions.validateNoMoreTransformations = true;
 }
 
+template <typename Pass>
+bool TCompiler::runPass(TIntermBlock *root,
+                        const char *name,
+                        ASTConstructSet triggers,
+                        ASTConstructSet introduces,
+                        Pass &&pass)
+{
+    if (triggers.any() && mSkipUntriggeredPasses)
+    {
+        // A single traversal finds the constructs that all the following passes look for, until a
+        // pass makes unknown changes to the tree.
+        if (!mASTConstructsValid)
+        {
+            const double scanStartTime = mPassTimingEnabled ? angle::GetCurrentSystemTime() : 0;
+            mASTConstructs             = ScanASTConstructs(root);
+            mASTConstructsValid        = true;
+            if (mPassTimingEnabled)
+            {
+                mPassTimings.push_back(
+                    {"ScanASTConstructs", angle::GetCurrentSystemTime() - scanStartTime, false});
+            }
+        }
+
+        if ((mASTConstructs & triggers).none())
+        {
+            if (mPassTimingEnabled)
+            {
+                mPassTimings.push_back({name, 0, true});
+            }
+            return true;
+        }
+    }
+
+    const double startTime = mPassTimingEnabled ? angle::GetCurrentSystemTime() : 0;
+    const bool result      = pass();
+    if (mPassTimingEnabled)
+    {
+        mPassTimings.push_back({name, angle::GetCurrentSystemTime() - startTime, false});
+    }
+
+    if (introduces == kAnyASTConstruct)
+    {
+        mASTConstructsValid = false;
+    }
+    else
+    {
+        mASTConstructs |= introduces;
+    }
+
+    return result;
+}
+
 bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
                                     const TParseContext &parseContext,
                                     const ShCompileOptions &compileOptions)
 {
     mValidateASTOptions = {};
+    mASTConstructsValid = false;
+    mPassTimings.clear();
 
     // Desktop GLSL shaders don't have precision, so don't expect them to be specified.
     mValidateASTOptions.validatePrecision = !IsDesktopGLSpec(mShaderSpec);
@@ -780,13 +991,17 @@ bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
     }
 
     // Disallow expressions deemed too complex.
-    if (compileOptions.limitExpressionComplexity && !limitExpressionComplexity(root))
+    if (compileOptions.limitExpressionComplexity &&
+        !runPass(root, "LimitExpressionComplexity", {}, {},
+                 [&] { return limitExpressionComplexity(root); }))
     {
         return false;
     }
 
     if (shouldRunLoopAndIndexingValidation(compileOptions) &&
-        !ValidateLimitations(root, mShaderType, &mSymbolTable, &mDiagnostics))
+        !runPass(root, "ValidateLimitations", {}, {}, [&] {
+            return ValidateLimitations(root, mShaderType, &mSymbolTable, &mDiagnostics);
+        }))
     {
         return false;
     }
@@ -798,7 +1013,8 @@ bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
 
     // Fold expressions that could not be folded before validation that was done as a part of
     // parsing.
-    if (!FoldExpressions(this, root, &mDiagnostics))
+    if (!runPass(root, "FoldExpressions", {}, {},
+                 [&] { return FoldExpressions(this, root, &mDiagnostics); }))
     {
         return false;
     }
@@ -815,9 +1031,12 @@ bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
         parseContext.isExtensionEnabled(TExtension::APPLE_clip_distance))
     {
         bool isClipDistanceUsed = false;
-        if (!ValidateClipCullDistance(this, root, &mDiagnostics,
-                                      mResources.MaxCombinedClipAndCullDistances,
-                                      &mClipDistanceSize, &mCullDistanceSize, &isClipDistanceUsed))
+        if (!runPass(root, "ValidateClipCullDistance", {}, {}, [&] {
+                return ValidateClipCullDistance(this, root, &mDiagnostics,
+                                                mResources.MaxCombinedClipAndCullDistances,
+                                                &mClipDistanceSize, &mCullDistanceSize,
+                                                &isClipDistanceUsed);
+            }))
         {
             return false;
         }
@@ -825,7 +1044,9 @@ bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
     }
 
     // Validate no barrier() after return before prunning it in |PruneNoOps()| below.
-    if (mShaderType == GL_TESS_CONTROL_SHADER && !ValidateBarrierFunctionCall(root, &mDiagnostics))
+    if (mShaderType == GL_TESS_CONTROL_SHADER &&
+        !runPass(root, "ValidateBarrierFunctionCall", {}, {},
+                 [&] { return ValidateBarrierFunctionCall(root, &mDiagnostics); }))
     {
         return false;
     }
@@ -838,7 +1059,7 @@ bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
     //      invalid ESSL.
     //   3. Any unreachable statement after a discard, return, break or continue.
     // After this empty declarations are not allowed in the AST.
-    if (!PruneNoOps(this, root, &mSymbolTable))
+    if (!runPass(root, "PruneNoOps", {}, {}, [&] { return PruneNoOps(this, root, &mSymbolTable); }))
     {
         return false;
     }
@@ -865,15 +1086,20 @@ bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
     // This is because MSL doesn't allow statically initialized non-const globals.
     bool forceDeferNonConstGlobalInitializers = getOutputType() == SH_MSL_METAL_OUTPUT;
 
+    auto deferGlobalInitializers = [&] {
+        return DeferGlobalInitializers(this, root, initializeLocalsAndGlobals,
+                                       canUseLoopsToInitialize, highPrecisionSupported,
+                                       forceDeferNonConstGlobalInitializers, &mSymbolTable);
+    };
     if (enableNonConstantInitializers &&
-        !DeferGlobalInitializers(this, root, initializeLocalsAndGlobals, canUseLoopsToInitialize,
-                                 highPrecisionSupported, forceDeferNonConstGlobalInitializers,
-                                 &mSymbolTable))
+        !runPass(root, "DeferGlobalInitializers", {}, kAnyASTConstruct, deferGlobalInitializers))
     {
         return false;
     }
 
-    if (!SeparateStructFromFunctionDeclarations(*this, *root))
+    if (!runPass(root, "SeparateStructFromFunctionDeclarations", {},
+                 ASTConstructSet{ASTConstruct::StructSymbol},
+                 [&] { return SeparateStructFromFunctionDeclarations(*this, *root); }))
     {
         return false;
     }
@@ -897,44 +1123,56 @@ bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
         return false;
     }
 
-    if (!pruneUnusedFunctions(root))
+    if (!runPass(root, "PruneUnusedFunctions", {}, {}, [&] { return pruneUnusedFunctions(root); }))
     {
         return false;
     }
 
     if (IsSpecWithFunctionBodyNewScope(mShaderSpec, mShaderVersion))
     {
-        if (!ReplaceShadowingVariables(this, root, &mSymbolTable))
+        if (!runPass(root, "ReplaceShadowingVariables", {}, {},
+                     [&] { return ReplaceShadowingVariables(this, root, &mSymbolTable); }))
         {
             return false;
         }
     }
 
-    if (mShaderVersion >= 310 && !ValidateVaryingLocations(root, &mDiagnostics, mShaderType))
+    if (mShaderVersion >= 310 &&
+        !runPass(root, "ValidateVaryingLocations", {}, {},
+                 [&] { return ValidateVaryingLocations(root, &mDiagnostics, mShaderType); }))
     {
         return false;
     }
 
     // anglebug.com/7484: The ESSL spec has a bug with images as function arguments. The recommended
     // workaround is to inline functions that accept image arguments.
-    if (mShaderVersion >= 310 && !MonomorphizeUnsupportedFunctions(
-                                     this, root, &mSymbolTable, compileOptions,
-                                     UnsupportedFunctionArgsBitSet{UnsupportedFunctionArgs::Image}))
+    if (mShaderVersion >= 310 &&
+        !runPass(root, "MonomorphizeUnsupportedFunctions", {}, kAnyASTConstruct, [&] {
+            return MonomorphizeUnsupportedFunctions(
+                this, root, &mSymbolTable, compileOptions,
+                UnsupportedFunctionArgsBitSet{UnsupportedFunctionArgs::Image});
+        }))
     {
         return false;
     }
 
     if (mShaderVersion >= 300 && mShaderType == GL_FRAGMENT_SHADER &&
-        !ValidateOutputs(root, getExtensionBehavior(), mResources, hasPixelLocalStorageUniforms(),
-                         IsWebGLBasedSpec(mShaderSpec), &mDiagnostics))
+        !runPass(root, "ValidateOutputs", {}, {}, [&] {
+            return ValidateOutputs(root, getExtensionBehavior(), mResources,
+                                   hasPixelLocalStorageUniforms(), IsWebGLBasedSpec(mShaderSpec),
+                                   &mDiagnostics);
+        }))
     {
         return false;
     }
 
-    // Clamping uniform array bounds needs to happen after validateLimitations pass.
+    // Clamping uniform array bounds needs to happen after validateLimitations pass.  Indices into
+    // runtime-sized arrays are clamped with the length() method.
     if (compileOptions.clampIndirectArrayBounds)
     {
-        if (!ClampIndirectIndices(this, root, &mSymbolTable))
+        if (!runPass(root, "ClampIndirectIndices", ASTConstructSet{ASTConstruct::IndirectIndex},
+                     ASTConstructSet{ASTConstruct::ArrayLengthMethod},
+                     [&] { return ClampIndirectIndices(this, root, &mSymbolTable); }))
         {
             return false;
         }
@@ -945,8 +1183,12 @@ bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
          parseContext.isExtensionEnabled(TExtension::OVR_multiview)) &&
         getShaderType() != GL_COMPUTE_SHADER)
     {
-        if (!DeclareAndInitBuiltinsForInstancedMultiview(
-                this, root, mNumViews, mShaderType, compileOptions, mOutputType, &mSymbolTable))
+        if (!runPass(root, "DeclareAndInitBuiltinsForInstancedMultiview", {}, kAnyASTConstruct,
+                     [&] {
+                         return DeclareAndInitBuiltinsForInstancedMultiview(
+                             this, root, mNumViews, mShaderType, compileOptions, mOutputType,
+                             &mSymbolTable);
+                     }))
         {
             return false;
         }
@@ -955,7 +1197,8 @@ bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
     // This pass might emit short circuits so keep it before the short circuit unfolding
     if (compileOptions.rewriteDoWhileLoops)
     {
-        if (!RewriteDoWhile(this, root, &mSymbolTable))
+        if (!runPass(root, "RewriteDoWhile", ASTConstructSet{ASTConstruct::DoWhileLoop}, {},
+                     [&] { return RewriteDoWhile(this, root, &mSymbolTable); }))
         {
             return false;
         }
@@ -963,7 +1206,9 @@ bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
 
     if (compileOptions.addAndTrueToLoopCondition)
     {
-        if (!AddAndTrueToLoopCondition(this, root))
+        if (!runPass(root, "AddAndTrueToLoopCondition", ASTConstructSet{ASTConstruct::Loop},
+                     ASTConstructSet{ASTConstruct::LogicalAndOr},
+                     [&] { return AddAndTrueToLoopCondition(this, root); }))
         {
             return false;
         }
@@ -971,7 +1216,8 @@ bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
 
     if (compileOptions.unfoldShortCircuit)
     {
-        if (!UnfoldShortCircuitAST(this, root))
+        if (!runPass(root, "UnfoldShortCircuitAST", ASTConstructSet{ASTConstruct::LogicalAndOr},
+                     {}, [&] { return UnfoldShortCircuitAST(this, root); }))
         {
             return false;
         }
@@ -979,7 +1225,8 @@ bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
 
     if (compileOptions.regenerateStructNames)
     {
-        if (!RegenerateStructNames(this, root, &mSymbolTable))
+        if (!runPass(root, "RegenerateStructNames", ASTConstructSet{ASTConstruct::StructSymbol},
+                     {}, [&] { return RegenerateStructNames(this, root, &mSymbolTable); }))
         {
             return false;
         }
@@ -990,7 +1237,8 @@ bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
     {
         if (compileOptions.emulateGLDrawID)
         {
-            if (!EmulateGLDrawID(this, root, &mSymbolTable, &mUniforms))
+            if (!runPass(root, "EmulateGLDrawID", {}, kAnyASTConstruct,
+                         [&] { return EmulateGLDrawID(this, root, &mSymbolTable, &mUniforms); }))
             {
                 return false;
             }
@@ -1003,8 +1251,10 @@ bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
     {
         if (compileOptions.emulateGLBaseVertexBaseInstance)
         {
-            if (!EmulateGLBaseVertexBaseInstance(this, root, &mSymbolTable, &mUniforms,
-                                                 compileOptions.addBaseVertexToVertexID))
+            if (!runPass(root, "EmulateGLBaseVertexBaseInstance", {}, kAnyASTConstruct, [&] {
+                    return EmulateGLBaseVertexBaseInstance(this, root, &mSymbolTable, &mUniforms,
+                                                           compileOptions.addBaseVertexToVertexID);
+                }))
             {
                 return false;
             }
@@ -1015,9 +1265,12 @@ bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
         mResources.MaxDrawBuffers > 1 &&
         IsExtensionEnabled(mExtensionBehavior, TExtension::EXT_draw_buffers))
     {
-        if (!EmulateGLFragColorBroadcast(this, root, mResources.MaxDrawBuffers,
-                                         mResources.MaxDualSourceDrawBuffers, &mOutputVariables,
-                                         &mSymbolTable, mShaderVersion))
+        if (!runPass(root, "EmulateGLFragColorBroadcast", {}, kAnyASTConstruct, [&] {
+                return EmulateGLFragColorBroadcast(this, root, mResources.MaxDrawBuffers,
+                                                   mResources.MaxDualSourceDrawBuffers,
+                                                   &mOutputVariables, &mSymbolTable,
+                                                   mShaderVersion);
+            }))
         {
             return false;
         }
@@ -1026,24 +1279,28 @@ bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
     // Split multi declarations and remove calls to array length().
     // Note that SimplifyLoopConditions needs to be run before any other AST transformations
     // that may need to generate new statements from loop conditions or loop expressions.
-    if (!SimplifyLoopConditions(this, root,
-                                IntermNodePatternMatcher::kMultiDeclaration |
-                                    IntermNodePatternMatcher::kArrayLengthMethod,
-                                &getSymbolTable()))
+    if (!runPass(root, "SimplifyLoopConditions", ASTConstructSet{ASTConstruct::Loop}, {}, [&] {
+            return SimplifyLoopConditions(this, root,
+                                          IntermNodePatternMatcher::kMultiDeclaration |
+                                              IntermNodePatternMatcher::kArrayLengthMethod,
+                                          &getSymbolTable());
+        }))
     {
         return false;
     }
 
     // Note that separate declarations need to be run before other AST transformations that
     // generate new statements from expressions.
-    if (!SeparateDeclarations(*this, *root))
+    if (!runPass(root, "SeparateDeclarations", {}, {},
+                 [&] { return SeparateDeclarations(*this, *root); }))
     {
         return false;
     }
 
     if (compileOptions.rescopeGlobalVariables)
     {
-        if (!RescopeGlobalVariables(*this, *root))
+        if (!runPass(root, "RescopeGlobalVariables", {}, {},
+                     [&] { return RescopeGlobalVariables(*this, *root); }))
         {
             return false;
         }
@@ -1051,23 +1308,30 @@ bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
 
     mValidateASTOptions.validateMultiDeclarations = true;
 
-    if (!SplitSequenceOperator(this, root, IntermNodePatternMatcher::kArrayLengthMethod,
-                               &getSymbolTable()))
+    if (!runPass(root, "SplitSequenceOperator", ASTConstructSet{ASTConstruct::SequenceOperator},
+                 {}, [&] {
+                     return SplitSequenceOperator(this, root,
+                                                  IntermNodePatternMatcher::kArrayLengthMethod,
+                                                  &getSymbolTable());
+                 }))
     {
         return false;
     }
 
-    if (!RemoveArrayLengthMethod(this, root))
+    if (!runPass(root, "RemoveArrayLengthMethod", ASTConstructSet{ASTConstruct::ArrayLengthMethod},
+                 {}, [&] { return RemoveArrayLengthMethod(this, root); }))
     {
         return false;
     }
     // Fold the expressions again, because |RemoveArrayLengthMethod| can introduce new constants.
-    if (!FoldExpressions(this, root, &mDiagnostics))
+    if (!runPass(root, "FoldExpressions", {}, {},
+                 [&] { return FoldExpressions(this, root, &mDiagnostics); }))
     {
         return false;
     }
 
-    if (!RemoveUnreferencedVariables(this, root, &mSymbolTable))
+    if (!runPass(root, "RemoveUnreferencedVariables", {}, {},
+                 [&] { return RemoveUnreferencedVariables(this, root, &mSymbolTable); }))
     {
         return false;
     }
@@ -1078,14 +1342,17 @@ bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
     // left switch statements that only contained an empty declaration inside the final case in an
     // invalid state. Relies on that PruneNoOps and RemoveUnreferencedVariables have already been
     // run.
-    if (!PruneEmptyCases(this, root))
+    if (!runPass(root, "PruneEmptyCases", ASTConstructSet{ASTConstruct::Switch}, {},
+                 [&] { return PruneEmptyCases(this, root); }))
     {
         return false;
     }
 
     // Run after RemoveUnreferencedVariables, validate that the shader does not have excessively
     // large variables.
-    if (shouldLimitTypeSizes() && !ValidateTypeSizeLimitations(root, &mSymbolTable, &mDiagnostics))
+    if (shouldLimitTypeSizes() &&
+        !runPass(root, "ValidateTypeSizeLimitations", {}, {},
+                 [&] { return ValidateTypeSizeLimitations(root, &mSymbolTable, &mDiagnostics); }))
     {
         return false;
     }
@@ -1098,7 +1365,8 @@ bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
 
     if (compileOptions.scalarizeVecAndMatConstructorArgs)
     {
-        if (!ScalarizeVecAndMatConstructorArgs(this, root, &mSymbolTable))
+        if (!runPass(root, "ScalarizeVecAndMatConstructorArgs", {}, kAnyASTConstruct,
+                     [&] { return ScalarizeVecAndMatConstructorArgs(this, root, &mSymbolTable); }))
         {
             return false;
         }
@@ -1184,9 +1452,7 @@ bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
     // initializers before we generate the DAG, since initializers may call functions which must not
     // be optimized out
     if (!enableNonConstantInitializers &&
-        !DeferGlobalInitializers(this, root, initializeLocalsAndGlobals, canUseLoopsToInitialize,
-                                 highPrecisionSupported, forceDeferNonConstGlobalInitializers,
-                                 &mSymbolTable))
+        !runPass(root, "DeferGlobalInitializers", {}, kAnyASTConstruct, deferGlobalInitializers))
     {
         return false;
     }
@@ -1203,17 +1469,24 @@ bool TCompiler::checkAndSimplifyAST(TIntermBlock *root,
 
         if (!shouldRunLoopAndIndexingValidation(compileOptions))
         {
-            if (!SimplifyLoopConditions(this, root,
-                                        IntermNodePatternMatcher::kArrayDeclaration |
-                                            IntermNodePatternMatcher::kNamelessStructDeclaration,
-                                        &getSymbolTable()))
+            if (!runPass(root, "SimplifyLoopConditions", ASTConstructSet{ASTConstruct::Loop}, {},
+                         [&] {
+                             return SimplifyLoopConditions(
+                                 this, root,
+                                 IntermNodePatternMatcher::kArrayDeclaration |
+                                     IntermNodePatternMatcher::kNamelessStructDeclaration,
+                                 &getSymbolTable());
+                         }))
             {
                 return false;
             }
         }
 
-        if (!InitializeUninitializedLocals(this, root, getShaderVersion(), canUseLoopsToInitialize,
-                                           highPrecisionSupported, &getSymbolTable()))
+        if (!runPass(root, "InitializeUninitializedLocals", {}, kAnyASTConstruct, [&] {
+                return InitializeUninitializedLocals(this, root, getShaderVersion(),
+                                                     canUseLoopsToInitialize,
+                                                     highPrecisionSupported, &getSymbolTable());
+            }))
         {
             return false;
         }
@@ -1280,16 +1553,62 @@ bool TCompiler::postParseChecks(const TParseContext &parseContext)
 
 bool TCompiler::compile(const char *const shaderStrings[],
                         size_t numStrings,
-                        const ShCompileOptions &compileOptionsIn)
+                        const ShCompileOptions &compileOptions)
 {
 #if defined(ANGLE_FUZZER_CORPUS_OUTPUT_DIR)
     DumpFuzzerCase(shaderStrings, numStrings, mShaderType, mShaderSpec, mOutputType,
-                   compileOptionsIn);
+                   compileOptions);
 #endif  // defined(ANGLE_FUZZER_CORPUS_OUTPUT_DIR)
 
     if (numStrings == 0)
         return true;
 
+    mCompileResultFromCache = false;
+
+    // The HLSL translator has results that are not serialized, such as register assignments.
+    const bool useTranslatorCache = mTranslatorCache != nullptr && !IsOutputHLSL(mOutputType);
+    TranslatorCache::Key cacheKey;
+    if (useTranslatorCache)
+    {
+        computeTranslatorCacheKey(shaderStrings, numStrings, compileOptions, &cacheKey);
+
+        std::vector<uint8_t> cachedResults;
+        if (mTranslatorCache->get(cacheKey, &cachedResults))
+        {
+            mCompileOptions = compileOptions;
+            clearResults();
+
+            gl::BinaryInputStream stream(cachedResults.data(), cachedResults.size());
+            if (deserializeResults(&stream))
+            {
+                mCompileResultFromCache = true;
+                return true;
+            }
+
+            // Corrupt data from the persistent storage; translate the shader again.
+            mTranslatorCache->remove(cacheKey);
+        }
+    }
+
+    if (!compileImpl(shaderStrings, numStrings, compileOptions))
+    {
+        return false;
+    }
+
+    if (useTranslatorCache)
+    {
+        gl::BinaryOutputStream stream;
+        serializeResults(&stream);
+        mTranslatorCache->put(cacheKey, std::vector<uint8_t>(stream.getData()));
+    }
+
+    return true;
+}
+
+bool TCompiler::compileImpl(const char *const shaderStrings[],
+                            size_t numStrings,
+                            const ShCompileOptions &compileOptionsIn)
+{
     ShCompileOptions compileOptions = compileOptionsIn;
 
     // Apply key workarounds.
@@ -1359,6 +1678,198 @@ bool TCompiler::compile(const char *const shaderStrings[],
     return false;
 }
 
+void TCompiler::computeTranslatorCacheKey(const char *const shaderStrings[],
+                                          size_t numStrings,
+                                          const ShCompileOptions &compileOptions,
+                                          TranslatorCache::Key *keyOut) const
+{
+    angle::base::SecureHashAlgorithm hasher;
+    hasher.Init();
+
+    // The output of the translator changes with its source.
+    hasher.Update(angle::GetANGLEShaderProgramVersion(),
+                  angle::GetANGLEShaderProgramVersionHashSize());
+
+    hasher.Update(&mShaderType, sizeof(mShaderType));
+    hasher.Update(&mShaderSpec, sizeof(mShaderSpec));
+    hasher.Update(&mOutputType, sizeof(mOutputType));
+
+    // ShCompileOptions is zero-initialized, including padding, and holds no pointers, so it can be
+    // hashed as raw bytes.
+    hasher.Update(&compileOptions, sizeof(compileOptions));
+    HashBuiltInResources(mResources, &hasher);
+
+    // Include the length of each string, as the strings are numbered by the preprocessor.
+    for (size_t index = 0; index < numStrings; ++index)
+    {
+        const size_t length = strlen(shaderStrings[index]);
+        hasher.Update(&length, sizeof(length));
+        hasher.Update(shaderStrings[index], length);
+    }
+
+    hasher.Final();
+    memcpy(keyOut->data(), hasher.Digest(), angle::base::kSHA1Length);
+}
+
+void TCompiler::serializeResults(gl::BinaryOutputStream *stream) const
+{
+    auto writeVariables = [stream](const std::vector<sh::ShaderVariable> &variables) {
+        stream->writeInt(variables.size());
+        for (const sh::ShaderVariable &variable : variables)
+        {
+            gl::WriteShaderVar(stream, variable);
+        }
+    };
+    auto writeBlocks = [stream](const std::vector<sh::InterfaceBlock> &blocks) {
+        stream->writeInt(blocks.size());
+        for (const sh::InterfaceBlock &block : blocks)
+        {
+            gl::WriteShInterfaceBlock(stream, block);
+        }
+    };
+
+    stream->writeInt(mShaderVersion);
+    stream->writeString(mInfoSink.info.str());
+    stream->writeBool(mInfoSink.obj.isBinary());
+    if (mInfoSink.obj.isBinary())
+    {
+        stream->writeVector(mInfoSink.obj.getBinary());
+    }
+    else
+    {
+        stream->writeString(mInfoSink.obj.str());
+    }
+
+    writeVariables(mAttributes);
+    writeVariables(mOutputVariables);
+    writeVariables(mUniforms);
+    writeVariables(mInputVaryings);
+    writeVariables(mOutputVaryings);
+    writeVariables(mSharedVariables);
+    writeBlocks(mUniformBlocks);
+    writeBlocks(mShaderStorageBlocks);
+
+    stream->writeInt(mMetadataFlags.bits());
+    stream->writeInt(mSpecConstUsageBits.bits());
+    stream->writeBool(mEarlyFragmentTestsSpecified);
+    stream->writeBool(mComputeShaderLocalSizeDeclared);
+    stream->writeStruct(mComputeShaderLocalSize);
+    stream->writeInt(mNumViews);
+    stream->writeInt(mClipDistanceSize);
+    stream->writeInt(mCullDistanceSize);
+
+    stream->writeInt(mGeometryShaderMaxVertices);
+    stream->writeInt(mGeometryShaderInvocations);
+    stream->writeEnum(mGeometryShaderInputPrimitiveType);
+    stream->writeEnum(mGeometryShaderOutputPrimitiveType);
+
+    stream->writeInt(mTessControlShaderOutputVertices);
+    stream->writeEnum(mTessEvaluationShaderInputPrimitiveType);
+    stream->writeEnum(mTessEvaluationShaderInputVertexSpacingType);
+    stream->writeEnum(mTessEvaluationShaderInputOrderingType);
+    stream->writeEnum(mTessEvaluationShaderInputPointType);
+
+    stream->writeBool(mHasAnyPreciseType);
+    stream->writeInt(mAdvancedBlendEquations.bits());
+    stream->writeBool(mHasPixelLocalStorageUniforms);
+    stream->writeBool(mUsesDerivatives);
+
+    stream->writeInt(mNameMap.size());
+    for (const auto &name : mNameMap)
+    {
+        stream->writeString(name.first);
+        stream->writeString(name.second);
+    }
+}
+
+bool TCompiler::deserializeResults(gl::BinaryInputStream *stream)
+{
+    auto readVariables = [stream](std::vector<sh::ShaderVariable> *variables) {
+        variables->resize(stream->readInt<size_t>());
+        for (sh::ShaderVariable &variable : *variables)
+        {
+            gl::LoadShaderVar(stream, &variable);
+        }
+    };
+    auto readBlocks = [stream](std::vector<sh::InterfaceBlock> *blocks) {
+        blocks->resize(stream->readInt<size_t>());
+        for (sh::InterfaceBlock &block : *blocks)
+        {
+            gl::LoadShInterfaceBlock(stream, &block);
+        }
+    };
+
+    stream->readInt(&mShaderVersion);
+    std::string infoLog;
+    stream->readString(&infoLog);
+    mInfoSink.info << infoLog;
+    if (stream->readBool())
+    {
+        BinaryBlob binary;
+        stream->readVector(&binary);
+        mInfoSink.obj.setBinary(std::move(binary));
+    }
+    else
+    {
+        std::string objectCode;
+        stream->readString(&objectCode);
+        mInfoSink.obj << objectCode;
+    }
+
+    readVariables(&mAttributes);
+    readVariables(&mOutputVariables);
+    readVariables(&mUniforms);
+    readVariables(&mInputVaryings);
+    readVariables(&mOutputVaryings);
+    readVariables(&mSharedVariables);
+    readBlocks(&mUniformBlocks);
+    readBlocks(&mShaderStorageBlocks);
+    collectInterfaceBlocks();
+    mVariablesCollected = true;
+
+    mMetadataFlags      = MetadataFlagBits(stream->readInt<uint32_t>());
+    mSpecConstUsageBits = SpecConstUsageBits(stream->readInt<uint32_t>());
+    mEarlyFragmentTestsSpecified    = stream->readBool();
+    mComputeShaderLocalSizeDeclared = stream->readBool();
+    stream->readStruct(&mComputeShaderLocalSize);
+    stream->readInt(&mNumViews);
+    stream->readInt(&mClipDistanceSize);
+    stream->readInt(&mCullDistanceSize);
+
+    stream->readInt(&mGeometryShaderMaxVertices);
+    stream->readInt(&mGeometryShaderInvocations);
+    stream->readEnum(&mGeometryShaderInputPrimitiveType);
+    stream->readEnum(&mGeometryShaderOutputPrimitiveType);
+
+    stream->readInt(&mTessControlShaderOutputVertices);
+    stream->readEnum(&mTessEvaluationShaderInputPrimitiveType);
+    stream->readEnum(&mTessEvaluationShaderInputVertexSpacingType);
+    stream->readEnum(&mTessEvaluationShaderInputOrderingType);
+    stream->readEnum(&mTessEvaluationShaderInputPointType);
+
+    mHasAnyPreciseType            = stream->readBool();
+    mAdvancedBlendEquations       = AdvancedBlendEquations(stream->readInt<uint32_t>());
+    mHasPixelLocalStorageUniforms = stream->readBool();
+    mUsesDerivatives              = stream->readBool();
+
+    const size_t nameCount = stream->readInt<size_t>();
+    for (size_t index = 0; index < nameCount && !stream->error(); ++index)
+    {
+        std::string name;
+        std::string hashedName;
+        stream->readString(&name);
+        stream->readString(&hashedName);
+        mNameMap[name] = hashedName;
+    }
+
+    if (stream->error() || !stream->endOfStream())
+    {
+        clearResults();
+        return false;
+    }
+    return true;
+}
+
 bool TCompiler::initBuiltInSymbolTable(const ShBuiltInResources &resources)
 {
     if (resources.MaxDrawBuffers < 1)
@@ -25,7 +25,15 @@
 #include "compiler/translator/InfoSink.h"
 #include "compiler/translator/Pragma.h"
 #include "compiler/translator/SymbolTable.h"
+#include "compiler/translator/TranslatorCache.h"
 #include "compiler/translator/ValidateAST.h"
+#include "compiler/translator/tree_util/ScanASTConstructs.h"
+
+namespace gl
+{
+class BinaryInputStream;
+class BinaryOutputStream;
+}  // namespace gl
 
 namespace sh
 {
@@ -108,6 +116,11 @@ class TCompiler : public TShHandleBase
                  size_t numStrings,
                  const ShCompileOptions &compileOptions);
 
+    // When set, compile() returns the results of a previous compilation of the same shader from
+    // the cache instead of translating it again.
+    void setTranslatorCache(TranslatorCache *cache) { mTranslatorCache = cache; }
+    bool isCompileResultFromCache() const { return mCompileResultFromCache; }
+
     // Get results of the last compilation.
     int getShaderVersion() const { return mShaderVersion; }
     TInfoSink &getInfoSink() { return mInfoSink; }
@@ -232,6 +245,22 @@ class TCompiler : public TShHandleBase
         return mShaderVersion == 100 && !IsWebGLBasedSpec(mShaderSpec);
     }
 
+    // Time spent in each pass of checkAndSimplifyAST during the last compilation.  Only recorded
+    // once enabled with setPassTimingEnabled().
+    struct PassTiming
+    {
+        const char *name;
+        double seconds;
+        // Whether the pass was skipped because the tree had nothing for it to do.
+        bool skipped;
+    };
+    void setPassTimingEnabled(bool enabled) { mPassTimingEnabled = enabled; }
+    const std::vector<PassTiming> &getPassTimings() const { return mPassTimings; }
+
+    // Passes that only transform certain constructs are skipped when the tree doesn't contain
+    // them.  Can be disabled to measure the benefit.
+    void setSkipUntriggeredPassesForTesting(bool skip) { mSkipUntriggeredPasses = skip; }
+
   protected:
     // Add emulated functions to the built-in function emulator.
     virtual void initBuiltInFunctionEmulator(BuiltInFunctionEmulator *emu,
@@ -309,6 +338,21 @@ class TCompiler : public TShHandleBase
                                   size_t numStrings,
                                   const ShCompileOptions &compileOptions);
 
+    // Parses and translates the shader, without the translator cache.
+    bool compileImpl(const char *const shaderStrings[],
+                     size_t numStrings,
+                     const ShCompileOptions &compileOptions);
+
+    // Hashes everything that affects the results of compile().
+    void computeTranslatorCacheKey(const char *const shaderStrings[],
+                                   size_t numStrings,
+                                   const ShCompileOptions &compileOptions,
+                                   TranslatorCache::Key *keyOut) const;
+    // Stores and restores the results of the last compilation that can be queried through
+    // ShaderLang.h.
+    void serializeResults(gl::BinaryOutputStream *stream) const;
+    bool deserializeResults(gl::BinaryInputStream *stream);
+
     // Fetches and stores shader metadata that is not stored within the AST itself, such as shader
     // version.
     void setASTMetadata(const TParseContext &parseContext);
@@ -321,6 +365,28 @@ class TCompiler : public TShHandleBase
                              const TParseContext &parseContext,
                              const ShCompileOptions &compileOptions);
 
+    // Runs one pass of checkAndSimplifyAST.  Unless |triggers| is empty, the pass is skipped if
+    // the tree contains none of these constructs.  |introduces| are the constructs the pass may
+    // add to the tree; kAnyASTConstruct means the tree is scanned again before the next pass that
+    // may be skipped.
+    template <typename Pass>
+    bool runPass(TIntermBlock *root,
+                 const char *name,
+                 ASTConstructSet triggers,
+                 ASTConstructSet introduces,
+                 Pass &&pass);
+
+    // Constructs found in the tree by the last scan, plus those added by passes since.
+    ASTConstructSet mASTConstructs;
+    bool mASTConstructsValid;
+    bool mSkipUntriggeredPasses;
+
+    bool mPassTimingEnabled;
+    std::vector<PassTiming> mPassTimings;
+
+    TranslatorCache *mTranslatorCache;
+    bool mCompileResultFromCache;
+
     bool postParseChecks(const TParseContext &parseContext);
 
     sh::GLenum mShaderType;
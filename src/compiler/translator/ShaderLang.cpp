@@ -415,6 +415,39 @@ void ClearResults(const ShHandle handle)
     compiler->clearResults();
 }
 
+TranslatorCache *CreateTranslatorCache(size_t maxSize)
+{
+    return new TranslatorCache(maxSize);
+}
+
+void DestroyTranslatorCache(TranslatorCache *cache)
+{
+    delete cache;
+}
+
+void SetTranslatorCacheStorage(TranslatorCache *cache,
+                               TranslatorCacheSetFunc set,
+                               TranslatorCacheGetFunc get,
+                               void *userData)
+{
+    ASSERT(cache);
+    cache->setStorage(set, get, userData);
+}
+
+void SetTranslatorCache(const ShHandle handle, TranslatorCache *cache)
+{
+    TCompiler *compiler = GetCompilerFromHandle(handle);
+    ASSERT(compiler);
+    compiler->setTranslatorCache(cache);
+}
+
+bool IsCompileResultFromCache(const ShHandle handle)
+{
+    TCompiler *compiler = GetCompilerFromHandle(handle);
+    ASSERT(compiler);
+    return compiler->isCompileResultFromCache();
+}
+
 int GetShaderVersion(const ShHandle handle)
 {
     TCompiler *compiler = GetCompilerFromHandle(handle);
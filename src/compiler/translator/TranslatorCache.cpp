@@ -0,0 +1,147 @@
+//
+// Copyright 2024 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// TranslatorCache.cpp: Implements the translator output cache.
+//
+
+#include "compiler/translator/TranslatorCache.h"
+
+#include <string.h>
+
+namespace sh
+{
+
+size_t TranslatorCache::KeyHash::operator()(const Key &key) const
+{
+    // The key is a SHA-1 digest, so any part of it is a good hash.
+    size_t hash;
+    memcpy(&hash, key.data(), sizeof(hash));
+    return hash;
+}
+
+TranslatorCache::TranslatorCache(size_t maxSize)
+    : mSize(0), mMaxSize(maxSize), mSetFunc(nullptr), mGetFunc(nullptr), mUserData(nullptr)
+{}
+
+TranslatorCache::~TranslatorCache() = default;
+
+void TranslatorCache::setStorage(TranslatorCacheSetFunc set,
+                                 TranslatorCacheGetFunc get,
+                                 void *userData)
+{
+    std::lock_guard<angle::SimpleMutex> lock(mMutex);
+    mSetFunc  = set;
+    mGetFunc  = get;
+    mUserData = userData;
+}
+
+bool TranslatorCache::get(const Key &key, std::vector<uint8_t> *valueOut)
+{
+    TranslatorCacheGetFunc getFunc = nullptr;
+    void *userData                 = nullptr;
+    {
+        std::lock_guard<angle::SimpleMutex> lock(mMutex);
+        auto iter = mEntryMap.find(key);
+        if (iter != mEntryMap.end())
+        {
+            mEntries.splice(mEntries.begin(), mEntries, iter->second);
+            *valueOut = iter->second->second;
+            return true;
+        }
+        getFunc  = mGetFunc;
+        userData = mUserData;
+    }
+
+    if (getFunc == nullptr)
+    {
+        return false;
+    }
+
+    // Don't hold the lock while calling into the storage, which may read from disk.
+    const size_t valueSize = getFunc(key.data(), key.size(), nullptr, 0, userData);
+    if (valueSize == 0)
+    {
+        return false;
+    }
+    valueOut->resize(valueSize);
+    if (getFunc(key.data(), key.size(), valueOut->data(), valueSize, userData) != valueSize)
+    {
+        return false;
+    }
+
+    std::lock_guard<angle::SimpleMutex> lock(mMutex);
+    if (mEntryMap.count(key) == 0)
+    {
+        insertLocked(key, std::vector<uint8_t>(*valueOut));
+    }
+    return true;
+}
+
+void TranslatorCache::put(const Key &key, std::vector<uint8_t> &&value)
+{
+    TranslatorCacheSetFunc setFunc = nullptr;
+    void *userData                 = nullptr;
+    {
+        std::lock_guard<angle::SimpleMutex> lock(mMutex);
+        setFunc  = mSetFunc;
+        userData = mUserData;
+    }
+
+    if (setFunc != nullptr)
+    {
+        setFunc(key.data(), key.size(), value.data(), value.size(), userData);
+    }
+
+    std::lock_guard<angle::SimpleMutex> lock(mMutex);
+    if (mEntryMap.count(key) == 0)
+    {
+        insertLocked(key, std::move(value));
+    }
+}
+
+void TranslatorCache::remove(const Key &key)
+{
+    std::lock_guard<angle::SimpleMutex> lock(mMutex);
+    auto iter = mEntryMap.find(key);
+    if (iter != mEntryMap.end())
+    {
+        mSize -= iter->second->second.size();
+        mEntries.erase(iter->second);
+        mEntryMap.erase(iter);
+    }
+}
+
+size_t TranslatorCache::size() const
+{
+    std::lock_guard<angle::SimpleMutex> lock(mMutex);
+    return mSize;
+}
+
+void TranslatorCache::insertLocked(const Key &key, std::vector<uint8_t> &&value)
+{
+    if (value.size() > mMaxSize)
+    {
+        return;
+    }
+
+    evictLocked(value.size());
+
+    mSize += value.size();
+    mEntries.emplace_front(key, std::move(value));
+    mEntryMap[key] = mEntries.begin();
+}
+
+void TranslatorCache::evictLocked(size_t neededSize)
+{
+    while (!mEntries.empty() && mSize + neededSize > mMaxSize)
+    {
+        const Entry &oldest = mEntries.back();
+        mSize -= oldest.second.size();
+        mEntryMap.erase(oldest.first);
+        mEntries.pop_back();
+    }
+}
+
+}  // namespace sh
@@ -0,0 +1,71 @@
+//
+// Copyright 2024 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// TranslatorCache.h: A cache of translator output keyed on the hash of everything that affects
+// the translation, so compilers in different contexts (or, with persistent storage, different
+// processes) don't translate the same shader twice.
+//
+
+#ifndef COMPILER_TRANSLATOR_TRANSLATORCACHE_H_
+#define COMPILER_TRANSLATOR_TRANSLATORCACHE_H_
+
+#include <array>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+#include "GLSLANG/ShaderLang.h"
+#include "common/SimpleMutex.h"
+#include "common/angleutils.h"
+#include "common/base/anglebase/sha1.h"
+
+namespace sh
+{
+
+class TranslatorCache final : angle::NonCopyable
+{
+  public:
+    using Key = std::array<uint8_t, angle::base::kSHA1Length>;
+
+    explicit TranslatorCache(size_t maxSize);
+    ~TranslatorCache();
+
+    void setStorage(TranslatorCacheSetFunc set, TranslatorCacheGetFunc get, void *userData);
+
+    // Copies the value stored for |key| to |valueOut|, looking in persistent storage if it's not
+    // in memory.
+    bool get(const Key &key, std::vector<uint8_t> *valueOut);
+    void put(const Key &key, std::vector<uint8_t> &&value);
+    // Removes an entry that turned out to be unusable.
+    void remove(const Key &key);
+
+    size_t size() const;
+
+  private:
+    struct KeyHash
+    {
+        size_t operator()(const Key &key) const;
+    };
+    using Entry = std::pair<Key, std::vector<uint8_t>>;
+
+    void insertLocked(const Key &key, std::vector<uint8_t> &&value);
+    void evictLocked(size_t neededSize);
+
+    mutable angle::SimpleMutex mMutex;
+
+    // Most recently used entries are at the front.
+    std::list<Entry> mEntries;
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> mEntryMap;
+    size_t mSize;
+    const size_t mMaxSize;
+
+    TranslatorCacheSetFunc mSetFunc;
+    TranslatorCacheGetFunc mGetFunc;
+    void *mUserData;
+};
+
+}  // namespace sh
+
+#endif  // COMPILER_TRANSLATOR_TRANSLATORCACHE_H_
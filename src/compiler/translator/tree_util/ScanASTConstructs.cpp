@@ -0,0 +1,93 @@
+//
+// Copyright 2024 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// ScanASTConstructs.cpp: Finds which of the constructs that trigger AST transformations are
+// present in a tree.
+
+#include "compiler/translator/tree_util/ScanASTConstructs.h"
+
+#include "compiler/translator/Symbol.h"
+#include "compiler/translator/tree_util/IntermTraverse.h"
+
+namespace sh
+{
+namespace
+{
+class ScanASTConstructsTraverser : public TIntermTraverser
+{
+  public:
+    ScanASTConstructsTraverser() : TIntermTraverser(true, false, false) {}
+
+    ASTConstructSet getConstructs() const { return mConstructs; }
+
+    void visitSymbol(TIntermSymbol *node) override
+    {
+        const TStructure *structure = node->getType().getStruct();
+        if (structure != nullptr && structure->symbolType() != SymbolType::BuiltIn &&
+            structure->symbolType() != SymbolType::Empty)
+        {
+            mConstructs.set(ASTConstruct::StructSymbol);
+        }
+    }
+
+    bool visitBinary(Visit visit, TIntermBinary *node) override
+    {
+        switch (node->getOp())
+        {
+            case EOpLogicalAnd:
+            case EOpLogicalOr:
+                mConstructs.set(ASTConstruct::LogicalAndOr);
+                break;
+            case EOpComma:
+                mConstructs.set(ASTConstruct::SequenceOperator);
+                break;
+            case EOpIndexIndirect:
+                mConstructs.set(ASTConstruct::IndirectIndex);
+                break;
+            default:
+                break;
+        }
+        return true;
+    }
+
+    bool visitUnary(Visit visit, TIntermUnary *node) override
+    {
+        if (node->getOp() == EOpArrayLength)
+        {
+            mConstructs.set(ASTConstruct::ArrayLengthMethod);
+        }
+        return true;
+    }
+
+    bool visitSwitch(Visit visit, TIntermSwitch *node) override
+    {
+        mConstructs.set(ASTConstruct::Switch);
+        return true;
+    }
+
+    bool visitLoop(Visit visit, TIntermLoop *node) override
+    {
+        mConstructs.set(ASTConstruct::Loop);
+        if (node->getType() == ELoopDoWhile)
+        {
+            mConstructs.set(ASTConstruct::DoWhileLoop);
+        }
+        return true;
+    }
+
+  private:
+    ASTConstructSet mConstructs;
+};
+}  // anonymous namespace
+
+ASTConstructSet ScanASTConstructs(TIntermNode *root)
+{
+    ScanASTConstructsTraverser traverser;
+    root->traverse(&traverser);
+    return traverser.getConstructs();
+}
+
+}  // namespace sh
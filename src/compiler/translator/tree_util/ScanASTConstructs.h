@@ -0,0 +1,47 @@
+//
+// Copyright 2024 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// ScanASTConstructs.h: Finds which of the constructs that trigger AST transformations are present
+// in a tree, so that transformations with nothing to do can be skipped without traversing it.
+
+#ifndef COMPILER_TRANSLATOR_TREEUTIL_SCANASTCONSTRUCTS_H_
+#define COMPILER_TRANSLATOR_TREEUTIL_SCANASTCONSTRUCTS_H_
+
+#include "common/PackedEnums.h"
+
+namespace sh
+{
+class TIntermNode;
+
+enum class ASTConstruct
+{
+    // Any loop.
+    Loop,
+    DoWhileLoop,
+    // && and ||.
+    LogicalAndOr,
+    // The , operator.
+    SequenceOperator,
+    IndirectIndex,
+    ArrayLengthMethod,
+    Switch,
+    // A symbol whose type is a user-defined, named struct.
+    StructSymbol,
+
+    InvalidEnum,
+    EnumCount = InvalidEnum,
+};
+
+using ASTConstructSet = angle::PackedEnumBitSet<ASTConstruct, uint32_t>;
+
+// For transformations that may add any of the constructs to the tree.
+constexpr ASTConstructSet kAnyASTConstruct = ASTConstructSet::Mask(ASTConstructSet::size());
+
+// Traverses the tree once and returns the constructs found in it.
+ASTConstructSet ScanASTConstructs(TIntermNode *root);
+}  // namespace sh
+
+#endif  // COMPILER_TRANSLATOR_TREEUTIL_SCANASTCONSTRUCTS_H_
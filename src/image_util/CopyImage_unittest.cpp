@@ -0,0 +1,192 @@
+//
+// Copyright 2024 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// CopyImage_unittest.cpp: Unit tests for the specialized pixel conversions used by PackPixels.
+
+#include <gmock/gmock.h>
+#include <random>
+#include <vector>
+
+#include "image_util/copyimage.h"
+
+using namespace angle;
+using namespace testing;
+
+namespace
+{
+
+using CopyFunction = void (*)(const uint8_t *, int, int, uint8_t *, int, int, int, int);
+
+// Converts a pixel through gl::ColorF, like PackPixels does for formats without a fast path.
+template <typename SourceType, typename DestType>
+void GenericCopyPixel(const uint8_t *source, uint8_t *dest)
+{
+    gl::ColorF color;
+    ReadColor<SourceType, float>(source, reinterpret_cast<uint8_t *>(&color));
+    WriteColor<DestType, float>(reinterpret_cast<const uint8_t *>(&color), dest);
+}
+
+struct Conversion
+{
+    const char *name;
+    CopyFunction copyFunction;
+    void (*genericCopyPixel)(const uint8_t *, uint8_t *);
+    int sourcePixelBytes;
+    int destPixelBytes;
+};
+
+const Conversion kConversions[] = {
+    {"BGRA8_to_RGBA8", CopyBGRA8ToRGBA8, GenericCopyPixel<B8G8R8A8, R8G8B8A8>, 4, 4},
+    {"RGBA8_to_BGRA8", CopyRGBA8ToBGRA8, GenericCopyPixel<R8G8B8A8, B8G8R8A8>, 4, 4},
+    {"BGRX8_to_RGBA8", CopyBGRX8ToRGBA8, GenericCopyPixel<B8G8R8X8, R8G8B8A8>, 4, 4},
+    {"RGBX8_to_RGBA8", CopyRGBX8ToRGBA8, GenericCopyPixel<R8G8B8X8, R8G8B8A8>, 4, 4},
+    {"R5G6B5_to_RGBA8", CopyR5G6B5ToRGBA8, GenericCopyPixel<R5G6B5, R8G8B8A8>, 2, 4},
+    {"RGBA8_to_R5G6B5", CopyRGBA8ToR5G6B5, GenericCopyPixel<R8G8B8A8, R5G6B5>, 4, 2},
+    {"RGBA16F_to_RGBA32F", CopyRGBA16FToRGBA32F, GenericCopyPixel<R16G16B16A16F, R32G32B32A32F>,
+     8, 16},
+};
+
+// Converts |width| x |height| pixels of |source| with the generic path, reading the source with
+// the given pitches and writing a packed destination.
+std::vector<uint8_t> GenericCopy(const Conversion &conversion,
+                                 const uint8_t *source,
+                                 int srcXAxisPitch,
+                                 int srcYAxisPitch,
+                                 int width,
+                                 int height)
+{
+    std::vector<uint8_t> dest(width * height * conversion.destPixelBytes);
+    for (int y = 0; y < height; ++y)
+    {
+        for (int x = 0; x < width; ++x)
+        {
+            conversion.genericCopyPixel(source + y * srcYAxisPitch + x * srcXAxisPitch,
+                                        &dest[(y * width + x) * conversion.destPixelBytes]);
+        }
+    }
+    return dest;
+}
+
+// Fills the image with random pixels.  Half-float sources avoid NaNs, whose payloads the two
+// paths are not required to agree on.
+std::vector<uint8_t> RandomImage(const Conversion &conversion, int pixelCount, std::mt19937 *rng)
+{
+    std::vector<uint8_t> image(pixelCount * conversion.sourcePixelBytes);
+    for (uint8_t &byte : image)
+    {
+        byte = static_cast<uint8_t>((*rng)());
+    }
+    if (conversion.sourcePixelBytes == 8)
+    {
+        uint16_t *halfs = reinterpret_cast<uint16_t *>(image.data());
+        for (int i = 0; i < pixelCount * 4; ++i)
+        {
+            halfs[i] &= 0xBFFF;
+        }
+    }
+    return image;
+}
+
+// Test that the specialized conversions match the generic path for packed rows, which use the
+// vectorized kernels where available.  The odd width leaves a tail for the scalar code.
+TEST(CopyImage, PackedRowsMatchGenericConversion)
+{
+    constexpr int kWidth  = 67;
+    constexpr int kHeight = 13;
+
+    std::mt19937 rng(0);
+    for (const Conversion &conversion : kConversions)
+    {
+        const std::vector<uint8_t> source = RandomImage(conversion, kWidth * kHeight, &rng);
+        const int srcRowPitch             = kWidth * conversion.sourcePixelBytes;
+        const int destRowPitch            = kWidth * conversion.destPixelBytes;
+
+        std::vector<uint8_t> actual(destRowPitch * kHeight);
+        conversion.copyFunction(source.data(), conversion.sourcePixelBytes, srcRowPitch,
+                                actual.data(), conversion.destPixelBytes, destRowPitch, kWidth,
+                                kHeight);
+
+        EXPECT_EQ(GenericCopy(conversion, source.data(), conversion.sourcePixelBytes, srcRowPitch,
+                              kWidth, kHeight),
+                  actual)
+            << conversion.name;
+    }
+}
+
+// Test that flipped and rotated reads, which walk the source with negative or row-sized pitches,
+// match the generic path.
+TEST(CopyImage, FlippedAndRotatedMatchGenericConversion)
+{
+    constexpr int kWidth  = 19;
+    constexpr int kHeight = 11;
+
+    std::mt19937 rng(1);
+    for (const Conversion &conversion : kConversions)
+    {
+        const std::vector<uint8_t> source = RandomImage(conversion, kWidth * kHeight, &rng);
+        const int pixelBytes              = conversion.sourcePixelBytes;
+        const int srcRowPitch             = kWidth * pixelBytes;
+        const int destRowPitch            = kWidth * conversion.destPixelBytes;
+
+        // Y-flip: start at the last row and walk up.
+        const uint8_t *flippedSource = source.data() + (kHeight - 1) * srcRowPitch;
+        std::vector<uint8_t> flipped(destRowPitch * kHeight);
+        conversion.copyFunction(flippedSource, pixelBytes, -srcRowPitch, flipped.data(),
+                                conversion.destPixelBytes, destRowPitch, kWidth, kHeight);
+        EXPECT_EQ(GenericCopy(conversion, flippedSource, pixelBytes, -srcRowPitch, kWidth, kHeight),
+                  flipped)
+            << conversion.name << " flipped";
+
+        // 90 degree rotation: each destination row is a source column.
+        const int rotatedRowPitch = kHeight * conversion.destPixelBytes;
+        std::vector<uint8_t> rotated(rotatedRowPitch * kWidth);
+        conversion.copyFunction(source.data(), srcRowPitch, pixelBytes, rotated.data(),
+                                conversion.destPixelBytes, rotatedRowPitch, kHeight, kWidth);
+        EXPECT_EQ(GenericCopy(conversion, source.data(), srcRowPitch, pixelBytes, kHeight, kWidth),
+                  rotated)
+            << conversion.name << " rotated";
+    }
+}
+
+// Test every RGB565 value, since the bit replication and rounding differ from the float math.
+TEST(CopyImage, AllR5G6B5Values)
+{
+    std::vector<uint16_t> source(0x10000);
+    for (size_t i = 0; i < source.size(); ++i)
+    {
+        source[i] = static_cast<uint16_t>(i);
+    }
+
+    const Conversion &conversion = kConversions[4];
+    ASSERT_EQ(conversion.copyFunction, CopyR5G6B5ToRGBA8);
+
+    const uint8_t *sourceBytes = reinterpret_cast<const uint8_t *>(source.data());
+    const int width            = static_cast<int>(source.size());
+    std::vector<uint8_t> actual(width * 4);
+    CopyR5G6B5ToRGBA8(sourceBytes, 2, width * 2, actual.data(), 4, width * 4, width, 1);
+    EXPECT_EQ(GenericCopy(conversion, sourceBytes, 2, width * 2, width, 1), actual);
+}
+
+// Test every 8-bit channel value when quantizing to RGB565.
+TEST(CopyImage, AllRGBA8ChannelValuesToR5G6B5)
+{
+    std::vector<uint8_t> source(256 * 4);
+    for (int i = 0; i < 256; ++i)
+    {
+        source[i * 4 + 0] = static_cast<uint8_t>(i);
+        source[i * 4 + 1] = static_cast<uint8_t>(255 - i);
+        source[i * 4 + 2] = static_cast<uint8_t>(i * 7);
+        source[i * 4 + 3] = 255;
+    }
+
+    const Conversion &conversion = kConversions[5];
+    ASSERT_EQ(conversion.copyFunction, CopyRGBA8ToR5G6B5);
+
+    std::vector<uint8_t> actual(256 * 2);
+    CopyRGBA8ToR5G6B5(source.data(), 4, 256 * 4, actual.data(), 2, 256 * 2, 256, 1);
+    EXPECT_EQ(GenericCopy(conversion, source.data(), 4, 256 * 4, 256, 1), actual);
+}
+
+}  // namespace
@@ -0,0 +1,161 @@
+//
+// Copyright 2024 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// GenerateMip_unittest.cpp: Unit tests for the row kernels used to generate 2D mip levels.
+
+#include <gmock/gmock.h>
+#include <random>
+#include <vector>
+
+#include "common/mathutil.h"
+#include "image_util/generatemip.h"
+
+using namespace angle;
+using namespace testing;
+
+namespace
+{
+
+// Odd sizes, so that the last source row and column are dropped and the kernels leave a tail of
+// pixels for the scalar code.
+constexpr size_t kSourceWidth  = 75;
+constexpr size_t kSourceHeight = 9;
+constexpr size_t kDestWidth    = kSourceWidth / 2;
+constexpr size_t kDestHeight   = kSourceHeight / 2;
+
+std::vector<uint8_t> RandomImage(size_t size, std::mt19937 *rng)
+{
+    std::vector<uint8_t> image(size);
+    for (uint8_t &byte : image)
+    {
+        byte = static_cast<uint8_t>((*rng)());
+    }
+    return image;
+}
+
+// Generates the next level by averaging each 2x2 block with T::average, the way GenerateMip did
+// before it had row kernels.
+template <typename T>
+std::vector<uint8_t> GenerateMipWithAverage(const std::vector<uint8_t> &source)
+{
+    const T *sourcePixels = reinterpret_cast<const T *>(source.data());
+    std::vector<uint8_t> dest(kDestWidth * kDestHeight * sizeof(T));
+    T *destPixels = reinterpret_cast<T *>(dest.data());
+
+    for (size_t y = 0; y < kDestHeight; y++)
+    {
+        for (size_t x = 0; x < kDestWidth; x++)
+        {
+            const T *top    = sourcePixels + y * 2 * kSourceWidth + x * 2;
+            const T *bottom = top + kSourceWidth;
+
+            T left;
+            T right;
+            T::average(&left, top, bottom);
+            T::average(&right, top + 1, bottom + 1);
+            T::average(&destPixels[y * kDestWidth + x], &left, &right);
+        }
+    }
+    return dest;
+}
+
+template <typename T>
+std::vector<uint8_t> GenerateMipWithKernels(const std::vector<uint8_t> &source)
+{
+    std::vector<uint8_t> dest(kDestWidth * kDestHeight * sizeof(T));
+    GenerateMip<T>(kSourceWidth, kSourceHeight, 1, source.data(), kSourceWidth * sizeof(T),
+                   source.size(), dest.data(), kDestWidth * sizeof(T), dest.size());
+    return dest;
+}
+
+template <typename T>
+void TestMatchesAverage(std::mt19937 *rng)
+{
+    const std::vector<uint8_t> source = RandomImage(kSourceWidth * kSourceHeight * sizeof(T), rng);
+    EXPECT_EQ(GenerateMipWithAverage<T>(source), GenerateMipWithKernels<T>(source));
+}
+
+// Test that the integer and float kernels give the same results as averaging with T::average.
+TEST(GenerateMip, KernelsMatchAverage)
+{
+    std::mt19937 rng(0);
+    TestMatchesAverage<R8>(&rng);
+    TestMatchesAverage<L8A8>(&rng);
+    TestMatchesAverage<R8G8B8A8>(&rng);
+    TestMatchesAverage<B8G8R8X8>(&rng);
+    TestMatchesAverage<R16G16B16A16>(&rng);
+
+    // Use floats in [0, 1), since random bits make NaNs.
+    std::vector<uint8_t> source(kSourceWidth * kSourceHeight * sizeof(R32G32B32A32F));
+    float *sourceFloats = reinterpret_cast<float *>(source.data());
+    std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+    for (size_t i = 0; i < source.size() / sizeof(float); i++)
+    {
+        sourceFloats[i] = distribution(rng);
+    }
+    EXPECT_EQ(GenerateMipWithAverage<R32G32B32A32F>(source),
+              GenerateMipWithKernels<R32G32B32A32F>(source));
+}
+
+// Test that half floats are averaged with a single rounding.
+TEST(GenerateMip, HalfFloat)
+{
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> distribution(-4.0f, 4.0f);
+
+    std::vector<uint16_t> source(kSourceWidth * kSourceHeight * 4);
+    for (uint16_t &value : source)
+    {
+        value = gl::float32ToFloat16(distribution(rng));
+    }
+    const std::vector<uint8_t> sourceBytes(reinterpret_cast<const uint8_t *>(source.data()),
+                                           reinterpret_cast<const uint8_t *>(source.data()) +
+                                               source.size() * sizeof(uint16_t));
+
+    const std::vector<uint8_t> destBytes = GenerateMipWithKernels<R16G16B16A16F>(sourceBytes);
+    const uint16_t *dest                 = reinterpret_cast<const uint16_t *>(destBytes.data());
+
+    for (size_t y = 0; y < kDestHeight; y++)
+    {
+        for (size_t x = 0; x < kDestWidth * 4; x++)
+        {
+            const size_t topLeft    = y * 2 * kSourceWidth * 4 + (x / 4) * 8 + x % 4;
+            const size_t bottomLeft = topLeft + kSourceWidth * 4;
+
+            const float left = (gl::float16ToFloat32(source[topLeft]) +
+                                gl::float16ToFloat32(source[bottomLeft])) *
+                               0.5f;
+            const float right = (gl::float16ToFloat32(source[topLeft + 4]) +
+                                 gl::float16ToFloat32(source[bottomLeft + 4])) *
+                                0.5f;
+            EXPECT_EQ(gl::float32ToFloat16((left + right) * 0.5f), dest[y * kDestWidth * 4 + x]);
+        }
+    }
+}
+
+// Test that sRGB colors are averaged in linear space, and alpha isn't.
+TEST(GenerateMip, SRGB)
+{
+    std::vector<uint8_t> source(kSourceWidth * kSourceHeight * 4);
+    for (size_t pixel = 0; pixel < kSourceWidth * kSourceHeight; pixel++)
+    {
+        // Alternate black and white columns.
+        const uint8_t color   = (pixel % kSourceWidth) % 2 == 0 ? 0 : 255;
+        source[pixel * 4 + 0] = color;
+        source[pixel * 4 + 1] = color;
+        source[pixel * 4 + 2] = color;
+        source[pixel * 4 + 3] = color;
+    }
+
+    const std::vector<uint8_t> dest = GenerateMipWithKernels<R8G8B8A8SRGB>(source);
+    for (size_t pixel = 0; pixel < kDestWidth * kDestHeight; pixel++)
+    {
+        // Half of the light of white is 188 in sRGB.
+        EXPECT_THAT(std::vector<uint8_t>(&dest[pixel * 4], &dest[pixel * 4 + 4]),
+                    ElementsAre(188, 188, 188, 127));
+    }
+}
+
+}  // namespace
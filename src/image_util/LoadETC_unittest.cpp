@@ -0,0 +1,149 @@
+//
+// Copyright 2024 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// LoadETC_unittest.cpp: Unit tests for ETC and EAC decoding functions.
+
+#include <gmock/gmock.h>
+#include <random>
+#include <vector>
+
+#include "common/WorkerThread.h"
+#include "image_util/loadimage.h"
+
+using namespace angle;
+using namespace testing;
+
+namespace
+{
+
+using LoadFunction = void (*)(const ImageLoadContext &,
+                              size_t,
+                              size_t,
+                              size_t,
+                              const uint8_t *,
+                              size_t,
+                              size_t,
+                              uint8_t *,
+                              size_t,
+                              size_t);
+
+// Decodes a single ETC1 block to RGBA8.
+std::vector<uint8_t> DecodeETC1Block(const uint8_t block[8])
+{
+    std::vector<uint8_t> output(4 * 4 * 4);
+    LoadETC1RGB8ToRGBA8(ImageLoadContext(), 4, 4, 1, block, 8, 8, output.data(), 16, 64);
+    return output;
+}
+
+// Test decoding an individual mode block whose two subblocks have different colors.
+TEST(LoadETC, ETC1IndividualBlock)
+{
+    // Red 0x8 and blue 0x4 in the first subblock, green 0x8 in the second one, with the smallest
+    // intensity modifiers and every pixel using modifier index 0 (+2).
+    const uint8_t block[8] = {0x80, 0x08, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00};
+
+    std::vector<uint8_t> output = DecodeETC1Block(block);
+    for (size_t y = 0; y < 4; y++)
+    {
+        for (size_t x = 0; x < 4; x++)
+        {
+            const uint8_t *pixel = &output[(y * 4 + x) * 4];
+            if (x < 2)
+            {
+                EXPECT_THAT(std::vector<uint8_t>(pixel, pixel + 4), ElementsAre(138, 2, 70, 255));
+            }
+            else
+            {
+                EXPECT_THAT(std::vector<uint8_t>(pixel, pixel + 4), ElementsAre(2, 138, 2, 255));
+            }
+        }
+    }
+}
+
+// Test that modifiers which take a channel out of range are clamped.
+TEST(LoadETC, ETC1Clamping)
+{
+    // White and black subblocks with the largest intensity modifiers, flipped so the subblocks
+    // are the top and bottom halves.  The white half uses the large positive modifier (index 1)
+    // and the black half the large negative one (index 3).
+    const uint8_t block[8] = {0xF0, 0xF0, 0xF0, 0xFD, 0xCC, 0xCC, 0xFF, 0xFF};
+
+    std::vector<uint8_t> output = DecodeETC1Block(block);
+    for (size_t y = 0; y < 4; y++)
+    {
+        for (size_t x = 0; x < 4; x++)
+        {
+            const uint8_t expected = y < 2 ? 255 : 0;
+            const uint8_t *pixel   = &output[(y * 4 + x) * 4];
+            EXPECT_THAT(std::vector<uint8_t>(pixel, pixel + 4),
+                        ElementsAre(expected, expected, expected, 255))
+                << x << ", " << y;
+        }
+    }
+}
+
+// Test that decoding large images on a multithreaded pool gives the same results as decoding on
+// the calling thread, for every ETC2 mode.
+TEST(LoadETC, MultithreadedDecode)
+{
+    struct Format
+    {
+        const char *name;
+        LoadFunction loadFunction;
+        size_t inputBlockSize;
+        size_t outputBlockSize;
+    };
+    // Decoded formats are given the size of the 4x4 pixels of a block.
+    const Format kFormats[] = {
+        {"ETC2_RGB8A1_to_RGBA8", LoadETC2RGB8A1ToRGBA8, 8, 64},
+        {"ETC2_RGBA8_to_RGBA8", LoadETC2RGBA8ToRGBA8, 16, 64},
+        {"EAC_R11S_to_R8", LoadEACR11SToR8, 8, 16},
+        {"EAC_RG11_to_RG16F", LoadEACRG11ToRG16F, 16, 64},
+        {"ETC2_RGB8_to_BC1", LoadETC2RGB8ToBC1, 8, 8},
+        {"ETC2_RGBA8_to_BC3", LoadETC2RGBA8ToBC3, 16, 16},
+        {"EAC_RG11S_to_BC5", LoadEACRG11SToBC5, 16, 16},
+    };
+
+    // Not a multiple of the block size, and with several slices.
+    constexpr size_t kWidth  = 509;
+    constexpr size_t kHeight = 263;
+    constexpr size_t kDepth  = 2;
+
+    constexpr size_t kBlocksPerRow    = (kWidth + 3) / 4;
+    constexpr size_t kBlocksPerColumn = (kHeight + 3) / 4;
+
+    ImageLoadContext multithreadedContext;
+    multithreadedContext.multiThreadPool = WorkerThreadPool::Create(4, ANGLEPlatformCurrent());
+
+    std::mt19937 rng(0);
+    for (const Format &format : kFormats)
+    {
+        const size_t inputRowPitch   = kBlocksPerRow * format.inputBlockSize;
+        const size_t inputDepthPitch = inputRowPitch * kBlocksPerColumn;
+        std::vector<uint8_t> input(inputDepthPitch * kDepth);
+        for (uint8_t &byte : input)
+        {
+            byte = static_cast<uint8_t>(rng());
+        }
+
+        // Use a pitch that works for both decoded and transcoded formats.
+        const size_t outputRowPitch   = kBlocksPerRow * format.outputBlockSize;
+        const size_t outputDepthPitch = outputRowPitch * kBlocksPerColumn * 4;
+
+        std::vector<uint8_t> expected(outputDepthPitch * kDepth);
+        format.loadFunction(ImageLoadContext(), kWidth, kHeight, kDepth, input.data(),
+                            inputRowPitch, inputDepthPitch, expected.data(), outputRowPitch,
+                            outputDepthPitch);
+
+        std::vector<uint8_t> actual(outputDepthPitch * kDepth);
+        format.loadFunction(multithreadedContext, kWidth, kHeight, kDepth, input.data(),
+                            inputRowPitch, inputDepthPitch, actual.data(), outputRowPitch,
+                            outputDepthPitch);
+
+        EXPECT_EQ(expected, actual) << format.name;
+    }
+}
+
+}  // namespace
@@ -8,11 +8,30 @@
 
 #include "image_util/copyimage.h"
 
+#include <string.h>
+
+#include "common/mathutil.h"
+
+#if defined(ANGLE_USE_SSE) && \
+    (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#    define ANGLE_COPY_IMAGE_SSE2 1
+#    include <emmintrin.h>
+#endif
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+#    define ANGLE_COPY_IMAGE_NEON 1
+#    include <arm_neon.h>
+#endif
+
 namespace angle
 {
 
 namespace
 {
+// Pixel conversions used by CopyImage.  Each one converts single pixels with ConvertPixel, and
+// may convert a prefix of a row of tightly packed pixels faster with ConvertRow, which returns
+// the number of pixels it converted.
+
 inline uint32_t SwizzleBGRAToRGBA(uint32_t argb)
 {
     return ((argb & 0x000000FF) << 16) |  // Move BGRA blue to RGBA blue
@@ -20,21 +39,212 @@ inline uint32_t SwizzleBGRAToRGBA(uint32_t argb)
            ((argb & 0xFF00FF00));         // Keep alpha and green
 }
 
-void CopyBGRA8ToRGBA8Fast(const uint8_t *source,
-                          int srcYAxisPitch,
-                          uint8_t *dest,
-                          int destYAxisPitch,
-                          int destWidth,
-                          int destHeight)
+// Swaps the red and blue channels of 8-bit RGBA pixels, which converts both from BGRA to RGBA and
+// from RGBA to BGRA.  If |kOpaque|, the alpha channel is set to 1 instead of copied, for formats
+// whose fourth channel is unused.
+template <bool kSwapRedBlue, bool kOpaque>
+struct SwizzleRGBA8
+{
+    static constexpr int kSourcePixelBytes = 4;
+    static constexpr int kDestPixelBytes   = 4;
+    static constexpr uint32_t kAlphaMask   = kOpaque ? 0xFF000000 : 0;
+
+    static void ConvertPixel(const uint8_t *src, uint8_t *dst)
+    {
+        uint32_t pixel;
+        memcpy(&pixel, src, sizeof(pixel));
+        pixel = (kSwapRedBlue ? SwizzleBGRAToRGBA(pixel) : pixel) | kAlphaMask;
+        memcpy(dst, &pixel, sizeof(pixel));
+    }
+
+    static int ConvertRow(const uint8_t *src, uint8_t *dst, int width)
+    {
+        int x = 0;
+#if defined(ANGLE_COPY_IMAGE_SSE2)
+        const __m128i redBlueMask = _mm_set1_epi32(0x00FF00FF);
+        const __m128i alphaMask   = _mm_set1_epi32(static_cast<int>(kAlphaMask));
+        for (; x + 4 <= width; x += 4)
+        {
+            __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + x * 4));
+            if (kSwapRedBlue)
+            {
+                const __m128i redBlue    = _mm_and_si128(pixels, redBlueMask);
+                const __m128i greenAlpha = _mm_andnot_si128(redBlueMask, pixels);
+                pixels = _mm_or_si128(greenAlpha, _mm_or_si128(_mm_slli_epi32(redBlue, 16),
+                                                              _mm_srli_epi32(redBlue, 16)));
+            }
+            pixels = _mm_or_si128(pixels, alphaMask);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + x * 4), pixels);
+        }
+#elif defined(ANGLE_COPY_IMAGE_NEON)
+        for (; x + 16 <= width; x += 16)
+        {
+            uint8x16x4_t pixels = vld4q_u8(src + x * 4);
+            if (kSwapRedBlue)
+            {
+                const uint8x16_t first = pixels.val[0];
+                pixels.val[0]          = pixels.val[2];
+                pixels.val[2]          = first;
+            }
+            if (kOpaque)
+            {
+                pixels.val[3] = vdupq_n_u8(0xFF);
+            }
+            vst4q_u8(dst + x * 4, pixels);
+        }
+#endif
+        return x;
+    }
+};
+
+// Expands RGB565 to RGBA8.  Multiplying by 527 (or 259 for green) and shifting is the same as
+// rounding v * 255 / 31 (or 63), so this matches converting through normalized floats.  Bit
+// replication would be off by one for some values.
+struct R5G6B5ToRGBA8
+{
+    static constexpr int kSourcePixelBytes = 2;
+    static constexpr int kDestPixelBytes   = 4;
+
+    static uint8_t Expand5(uint32_t value) { return static_cast<uint8_t>((value * 527 + 23) >> 6); }
+    static uint8_t Expand6(uint32_t value) { return static_cast<uint8_t>((value * 259 + 33) >> 6); }
+
+    static void ConvertPixel(const uint8_t *src, uint8_t *dst)
+    {
+        uint16_t pixel;
+        memcpy(&pixel, src, sizeof(pixel));
+
+        dst[0] = Expand5((pixel >> 11) & 0x1F);
+        dst[1] = Expand6((pixel >> 5) & 0x3F);
+        dst[2] = Expand5(pixel & 0x1F);
+        dst[3] = 0xFF;
+    }
+
+    static int ConvertRow(const uint8_t *src, uint8_t *dst, int width)
+    {
+        int x = 0;
+#if defined(ANGLE_COPY_IMAGE_SSE2)
+        const __m128i fiveBitMask = _mm_set1_epi16(0x1F);
+        const __m128i sixBitMask  = _mm_set1_epi16(0x3F);
+        const __m128i fiveBitMul  = _mm_set1_epi16(527);
+        const __m128i sixBitMul   = _mm_set1_epi16(259);
+        const __m128i fiveBitBias = _mm_set1_epi16(23);
+        const __m128i sixBitBias  = _mm_set1_epi16(33);
+        const __m128i opaque      = _mm_set1_epi16(static_cast<short>(0xFF00));
+        for (; x + 8 <= width; x += 8)
+        {
+            const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + x * 2));
+
+            __m128i red   = _mm_and_si128(_mm_srli_epi16(pixels, 11), fiveBitMask);
+            __m128i green = _mm_and_si128(_mm_srli_epi16(pixels, 5), sixBitMask);
+            __m128i blue  = _mm_and_si128(pixels, fiveBitMask);
+
+            // The products fit in 15 bits.
+            red   = _mm_add_epi16(_mm_mullo_epi16(red, fiveBitMul), fiveBitBias);
+            green = _mm_add_epi16(_mm_mullo_epi16(green, sixBitMul), sixBitBias);
+            blue  = _mm_add_epi16(_mm_mullo_epi16(blue, fiveBitMul), fiveBitBias);
+            red   = _mm_srli_epi16(red, 6);
+            green = _mm_srli_epi16(green, 6);
+            blue  = _mm_srli_epi16(blue, 6);
+
+            // Interleave into 16-bit RG and BA pairs, then into RGBA pixels.
+            const __m128i redGreen  = _mm_or_si128(red, _mm_slli_epi16(green, 8));
+            const __m128i blueAlpha = _mm_or_si128(blue, opaque);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + x * 4),
+                             _mm_unpacklo_epi16(redGreen, blueAlpha));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + x * 4 + 16),
+                             _mm_unpackhi_epi16(redGreen, blueAlpha));
+        }
+#elif defined(ANGLE_COPY_IMAGE_NEON)
+        const uint16x8_t fiveBitMask = vdupq_n_u16(0x1F);
+        const uint16x8_t sixBitMask  = vdupq_n_u16(0x3F);
+        const uint16x8_t fiveBitBias = vdupq_n_u16(23);
+        const uint16x8_t sixBitBias  = vdupq_n_u16(33);
+        for (; x + 8 <= width; x += 8)
+        {
+            const uint16x8_t pixels = vreinterpretq_u16_u8(vld1q_u8(src + x * 2));
+
+            const uint16x8_t red   = vshrq_n_u16(pixels, 11);
+            const uint16x8_t green = vandq_u16(vshrq_n_u16(pixels, 5), sixBitMask);
+            const uint16x8_t blue  = vandq_u16(pixels, fiveBitMask);
+
+            uint8x8x4_t rgba;
+            rgba.val[0] = vshrn_n_u16(vmlaq_n_u16(fiveBitBias, red, 527), 6);
+            rgba.val[1] = vshrn_n_u16(vmlaq_n_u16(sixBitBias, green, 259), 6);
+            rgba.val[2] = vshrn_n_u16(vmlaq_n_u16(fiveBitBias, blue, 527), 6);
+            rgba.val[3] = vdup_n_u8(0xFF);
+            vst4_u8(dst + x * 4, rgba);
+        }
+#endif
+        return x;
+    }
+};
+
+// Packs RGBA8 into RGB565, rounding to nearest.  Exact ties can't happen, so this matches
+// converting through normalized floats.
+struct RGBA8ToR5G6B5
+{
+    static constexpr int kSourcePixelBytes = 4;
+    static constexpr int kDestPixelBytes   = 2;
+
+    static uint32_t Quantize(uint32_t value, uint32_t maxValue)
+    {
+        return (value * maxValue * 2 + 255) / 510;
+    }
+
+    static void ConvertPixel(const uint8_t *src, uint8_t *dst)
+    {
+        const uint16_t pixel =
+            static_cast<uint16_t>((Quantize(src[0], 0x1F) << 11) | (Quantize(src[1], 0x3F) << 5) |
+                                  Quantize(src[2], 0x1F));
+        memcpy(dst, &pixel, sizeof(pixel));
+    }
+
+    static int ConvertRow(const uint8_t *src, uint8_t *dst, int width) { return 0; }
+};
+
+// Widens RGBA16F to RGBA32F.
+struct RGBA16FToRGBA32F
+{
+    static constexpr int kSourcePixelBytes = 8;
+    static constexpr int kDestPixelBytes   = 16;
+
+    static void ConvertPixel(const uint8_t *src, uint8_t *dst)
+    {
+        uint16_t halfs[4];
+        memcpy(halfs, src, sizeof(halfs));
+        const float floats[4] = {gl::float16ToFloat32(halfs[0]), gl::float16ToFloat32(halfs[1]),
+                                 gl::float16ToFloat32(halfs[2]), gl::float16ToFloat32(halfs[3])};
+        memcpy(dst, floats, sizeof(floats));
+    }
+
+    static int ConvertRow(const uint8_t *src, uint8_t *dst, int width) { return 0; }
+};
+
+// Copies an image with |Conversion|.  Rows are converted with Conversion::ConvertRow when their
+// pixels are tightly packed in both images, which is the case unless the source is rotated.  A
+// negative |srcYAxisPitch| flips the image as it is copied.
+template <typename Conversion>
+void CopyImage(const uint8_t *source,
+               int srcXAxisPitch,
+               int srcYAxisPitch,
+               uint8_t *dest,
+               int destXAxisPitch,
+               int destYAxisPitch,
+               int destWidth,
+               int destHeight)
 {
+    const bool packedRows = srcXAxisPitch == Conversion::kSourcePixelBytes &&
+                            destXAxisPitch == Conversion::kDestPixelBytes;
+
     for (int y = 0; y < destHeight; ++y)
     {
-        const uint32_t *src32 = reinterpret_cast<const uint32_t *>(source + y * srcYAxisPitch);
-        uint32_t *dest32      = reinterpret_cast<uint32_t *>(dest + y * destYAxisPitch);
-        const uint32_t *end32 = src32 + destWidth;
-        while (src32 != end32)
+        const uint8_t *src = source + y * srcYAxisPitch;
+        uint8_t *dst       = dest + y * destYAxisPitch;
+
+        int x = packedRows ? Conversion::ConvertRow(src, dst, destWidth) : 0;
+        for (; x < destWidth; ++x)
         {
-            *dest32++ = SwizzleBGRAToRGBA(*src32++);
+            Conversion::ConvertPixel(src + x * srcXAxisPitch, dst + x * destXAxisPitch);
         }
     }
 }
@@ -49,26 +259,86 @@ void CopyBGRA8ToRGBA8(const uint8_t *source,
                       int destWidth,
                       int destHeight)
 {
-    if (srcXAxisPitch == 4 && destXAxisPitch == 4)
-    {
-        CopyBGRA8ToRGBA8Fast(source, srcYAxisPitch, dest, destYAxisPitch, destWidth, destHeight);
-        return;
-    }
+    CopyImage<SwizzleRGBA8<true, false>>(source, srcXAxisPitch, srcYAxisPitch, dest,
+                                         destXAxisPitch, destYAxisPitch, destWidth, destHeight);
+}
 
-    for (int y = 0; y < destHeight; ++y)
-    {
-        uint8_t *dst       = dest + y * destYAxisPitch;
-        const uint8_t *src = source + y * srcYAxisPitch;
-        const uint8_t *end = src + destWidth * srcXAxisPitch;
+void CopyRGBA8ToBGRA8(const uint8_t *source,
+                      int srcXAxisPitch,
+                      int srcYAxisPitch,
+                      uint8_t *dest,
+                      int destXAxisPitch,
+                      int destYAxisPitch,
+                      int destWidth,
+                      int destHeight)
+{
+    CopyImage<SwizzleRGBA8<true, false>>(source, srcXAxisPitch, srcYAxisPitch, dest,
+                                         destXAxisPitch, destYAxisPitch, destWidth, destHeight);
+}
 
-        while (src != end)
-        {
-            *reinterpret_cast<uint32_t *>(dst) =
-                SwizzleBGRAToRGBA(*reinterpret_cast<const uint32_t *>(src));
-            src += srcXAxisPitch;
-            dst += destXAxisPitch;
-        }
-    }
+void CopyBGRX8ToRGBA8(const uint8_t *source,
+                      int srcXAxisPitch,
+                      int srcYAxisPitch,
+                      uint8_t *dest,
+                      int destXAxisPitch,
+                      int destYAxisPitch,
+                      int destWidth,
+                      int destHeight)
+{
+    CopyImage<SwizzleRGBA8<true, true>>(source, srcXAxisPitch, srcYAxisPitch, dest,
+                                        destXAxisPitch, destYAxisPitch, destWidth, destHeight);
+}
+
+void CopyRGBX8ToRGBA8(const uint8_t *source,
+                      int srcXAxisPitch,
+                      int srcYAxisPitch,
+                      uint8_t *dest,
+                      int destXAxisPitch,
+                      int destYAxisPitch,
+                      int destWidth,
+                      int destHeight)
+{
+    CopyImage<SwizzleRGBA8<false, true>>(source, srcXAxisPitch, srcYAxisPitch, dest,
+                                         destXAxisPitch, destYAxisPitch, destWidth, destHeight);
+}
+
+void CopyR5G6B5ToRGBA8(const uint8_t *source,
+                       int srcXAxisPitch,
+                       int srcYAxisPitch,
+                       uint8_t *dest,
+                       int destXAxisPitch,
+                       int destYAxisPitch,
+                       int destWidth,
+                       int destHeight)
+{
+    CopyImage<R5G6B5ToRGBA8>(source, srcXAxisPitch, srcYAxisPitch, dest, destXAxisPitch,
+                             destYAxisPitch, destWidth, destHeight);
+}
+
+void CopyRGBA8ToR5G6B5(const uint8_t *source,
+                       int srcXAxisPitch,
+                       int srcYAxisPitch,
+                       uint8_t *dest,
+                       int destXAxisPitch,
+                       int destYAxisPitch,
+                       int destWidth,
+                       int destHeight)
+{
+    CopyImage<RGBA8ToR5G6B5>(source, srcXAxisPitch, srcYAxisPitch, dest, destXAxisPitch,
+                             destYAxisPitch, destWidth, destHeight);
+}
+
+void CopyRGBA16FToRGBA32F(const uint8_t *source,
+                          int srcXAxisPitch,
+                          int srcYAxisPitch,
+                          uint8_t *dest,
+                          int destXAxisPitch,
+                          int destYAxisPitch,
+                          int destWidth,
+                          int destHeight)
+{
+    CopyImage<RGBA16FToRGBA32F>(source, srcXAxisPitch, srcYAxisPitch, dest, destXAxisPitch,
+                                destYAxisPitch, destWidth, destHeight);
 }
 
 }  // namespace angle
@@ -30,6 +30,8 @@ void ReadDepthStencil(const uint8_t *source, uint8_t *dest);
 template <typename DestType>
 void WriteDepthStencil(const uint8_t *source, uint8_t *dest);
 
+// Specialized conversions that PackPixels uses instead of converting each pixel through
+// gl::ColorF.  Their arguments are the same as rx::FastCopyFunction's.
 void CopyBGRA8ToRGBA8(const uint8_t *source,
                       int srcXAxisPitch,
                       int srcYAxisPitch,
@@ -39,6 +41,60 @@ void CopyBGRA8ToRGBA8(const uint8_t *source,
                       int destWidth,
                       int destHeight);
 
+void CopyRGBA8ToBGRA8(const uint8_t *source,
+                      int srcXAxisPitch,
+                      int srcYAxisPitch,
+                      uint8_t *dest,
+                      int destXAxisPitch,
+                      int destYAxisPitch,
+                      int destWidth,
+                      int destHeight);
+
+void CopyBGRX8ToRGBA8(const uint8_t *source,
+                      int srcXAxisPitch,
+                      int srcYAxisPitch,
+                      uint8_t *dest,
+                      int destXAxisPitch,
+                      int destYAxisPitch,
+                      int destWidth,
+                      int destHeight);
+
+void CopyRGBX8ToRGBA8(const uint8_t *source,
+                      int srcXAxisPitch,
+                      int srcYAxisPitch,
+                      uint8_t *dest,
+                      int destXAxisPitch,
+                      int destYAxisPitch,
+                      int destWidth,
+                      int destHeight);
+
+void CopyR5G6B5ToRGBA8(const uint8_t *source,
+                       int srcXAxisPitch,
+                       int srcYAxisPitch,
+                       uint8_t *dest,
+                       int destXAxisPitch,
+                       int destYAxisPitch,
+                       int destWidth,
+                       int destHeight);
+
+void CopyRGBA8ToR5G6B5(const uint8_t *source,
+                       int srcXAxisPitch,
+                       int srcYAxisPitch,
+                       uint8_t *dest,
+                       int destXAxisPitch,
+                       int destYAxisPitch,
+                       int destWidth,
+                       int destHeight);
+
+void CopyRGBA16FToRGBA32F(const uint8_t *source,
+                          int srcXAxisPitch,
+                          int srcYAxisPitch,
+                          uint8_t *dest,
+                          int destXAxisPitch,
+                          int destYAxisPitch,
+                          int destWidth,
+                          int destHeight);
+
 }  // namespace angle
 
 #include "copyimage.inc"
@@ -0,0 +1,363 @@
+//
+// Copyright 2024 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// generatemip.cpp: Defines the row kernels GenerateMip uses to downsample 2D images.
+
+#include "image_util/generatemip.h"
+
+#include <array>
+
+#include "common/mathutil.h"
+
+#if defined(ANGLE_USE_SSE) && \
+    (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#    define ANGLE_GENERATE_MIP_SSE2 1
+#    include <emmintrin.h>
+#endif
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+#    define ANGLE_GENERATE_MIP_NEON 1
+#    include <arm_neon.h>
+#endif
+
+namespace angle
+{
+
+namespace
+{
+#if defined(ANGLE_GENERATE_MIP_SSE2) || defined(ANGLE_GENERATE_MIP_NEON)
+#    define ANGLE_GENERATE_MIP_SIMD 1
+
+// The vectorized kernels work on 16 bytes at a time.  Each one reads two vectors from each source
+// row, averages them vertically, separates the even and odd pixels and averages those.  This is
+// the order in which the scalar GenerateMip_XY averages the four pixels, so the results are
+// identical.
+#    if defined(ANGLE_GENERATE_MIP_SSE2)
+using Vector = __m128i;
+
+inline Vector LoadVector(const uint8_t *src)
+{
+    return _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+}
+
+inline void StoreVector(uint8_t *dst, Vector value)
+{
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), value);
+}
+
+// _mm_avg_epu8 and _mm_avg_epu16 round up, while gl::average rounds down.
+inline Vector AverageUNorm8(Vector a, Vector b)
+{
+    const __m128i roundedUp = _mm_and_si128(_mm_xor_si128(a, b), _mm_set1_epi8(1));
+    return _mm_sub_epi8(_mm_avg_epu8(a, b), roundedUp);
+}
+
+inline Vector AverageUNorm16(Vector a, Vector b)
+{
+    const __m128i roundedUp = _mm_and_si128(_mm_xor_si128(a, b), _mm_set1_epi16(1));
+    return _mm_sub_epi16(_mm_avg_epu16(a, b), roundedUp);
+}
+
+inline Vector AverageFloat32(Vector a, Vector b)
+{
+    const __m128 sum = _mm_add_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b));
+    return _mm_castps_si128(_mm_mul_ps(sum, _mm_set1_ps(0.5f)));
+}
+
+inline Vector SetOpaque(Vector pixels)
+{
+    return _mm_or_si128(pixels, _mm_set1_epi32(static_cast<int>(0xFF000000u)));
+}
+
+template <size_t kPixelBytes>
+void Deinterleave(Vector first, Vector second, Vector *even, Vector *odd);
+
+template <>
+void Deinterleave<1>(Vector first, Vector second, Vector *even, Vector *odd)
+{
+    const __m128i lowBytes = _mm_set1_epi16(0x00FF);
+    *even = _mm_packus_epi16(_mm_and_si128(first, lowBytes), _mm_and_si128(second, lowBytes));
+    *odd  = _mm_packus_epi16(_mm_srli_epi16(first, 8), _mm_srli_epi16(second, 8));
+}
+
+template <>
+void Deinterleave<2>(Vector first, Vector second, Vector *even, Vector *odd)
+{
+    // Sign extension makes the saturating pack keep the bits of every 16-bit pixel.
+    const __m128i firstEven  = _mm_srai_epi32(_mm_slli_epi32(first, 16), 16);
+    const __m128i secondEven = _mm_srai_epi32(_mm_slli_epi32(second, 16), 16);
+    *even = _mm_packs_epi32(firstEven, secondEven);
+    *odd  = _mm_packs_epi32(_mm_srai_epi32(first, 16), _mm_srai_epi32(second, 16));
+}
+
+template <>
+void Deinterleave<4>(Vector first, Vector second, Vector *even, Vector *odd)
+{
+    const __m128 firstFloats  = _mm_castsi128_ps(first);
+    const __m128 secondFloats = _mm_castsi128_ps(second);
+    *even = _mm_castps_si128(_mm_shuffle_ps(firstFloats, secondFloats, _MM_SHUFFLE(2, 0, 2, 0)));
+    *odd  = _mm_castps_si128(_mm_shuffle_ps(firstFloats, secondFloats, _MM_SHUFFLE(3, 1, 3, 1)));
+}
+
+template <>
+void Deinterleave<8>(Vector first, Vector second, Vector *even, Vector *odd)
+{
+    *even = _mm_unpacklo_epi64(first, second);
+    *odd  = _mm_unpackhi_epi64(first, second);
+}
+#    else
+using Vector = uint8x16_t;
+
+inline Vector LoadVector(const uint8_t *src)
+{
+    return vld1q_u8(src);
+}
+
+inline void StoreVector(uint8_t *dst, Vector value)
+{
+    vst1q_u8(dst, value);
+}
+
+// Halving adds round down, like gl::average.
+inline Vector AverageUNorm8(Vector a, Vector b)
+{
+    return vhaddq_u8(a, b);
+}
+
+inline Vector AverageUNorm16(Vector a, Vector b)
+{
+    return vreinterpretq_u8_u16(vhaddq_u16(vreinterpretq_u16_u8(a), vreinterpretq_u16_u8(b)));
+}
+
+inline Vector AverageFloat32(Vector a, Vector b)
+{
+    const float32x4_t sum = vaddq_f32(vreinterpretq_f32_u8(a), vreinterpretq_f32_u8(b));
+    return vreinterpretq_u8_f32(vmulq_n_f32(sum, 0.5f));
+}
+
+inline Vector SetOpaque(Vector pixels)
+{
+    return vreinterpretq_u8_u32(vorrq_u32(vreinterpretq_u32_u8(pixels), vdupq_n_u32(0xFF000000u)));
+}
+
+template <size_t kPixelBytes>
+void Deinterleave(Vector first, Vector second, Vector *even, Vector *odd);
+
+template <>
+void Deinterleave<1>(Vector first, Vector second, Vector *even, Vector *odd)
+{
+    const uint8x16x2_t pixels = vuzpq_u8(first, second);
+    *even                     = pixels.val[0];
+    *odd                      = pixels.val[1];
+}
+
+template <>
+void Deinterleave<2>(Vector first, Vector second, Vector *even, Vector *odd)
+{
+    const uint16x8x2_t pixels =
+        vuzpq_u16(vreinterpretq_u16_u8(first), vreinterpretq_u16_u8(second));
+    *even = vreinterpretq_u8_u16(pixels.val[0]);
+    *odd  = vreinterpretq_u8_u16(pixels.val[1]);
+}
+
+template <>
+void Deinterleave<4>(Vector first, Vector second, Vector *even, Vector *odd)
+{
+    const uint32x4x2_t pixels =
+        vuzpq_u32(vreinterpretq_u32_u8(first), vreinterpretq_u32_u8(second));
+    *even = vreinterpretq_u8_u32(pixels.val[0]);
+    *odd  = vreinterpretq_u8_u32(pixels.val[1]);
+}
+
+template <>
+void Deinterleave<8>(Vector first, Vector second, Vector *even, Vector *odd)
+{
+    *even = vcombine_u8(vget_low_u8(first), vget_low_u8(second));
+    *odd  = vcombine_u8(vget_high_u8(first), vget_high_u8(second));
+}
+#    endif
+
+// A pixel of 16 bytes fills a vector, so there is nothing to separate.
+template <>
+void Deinterleave<16>(Vector first, Vector second, Vector *even, Vector *odd)
+{
+    *even = first;
+    *odd  = second;
+}
+
+template <size_t kPixelBytes, Vector (*Average)(Vector, Vector), bool kOpaque = false>
+size_t GenerateMipRowXY(const uint8_t *sourceRow0,
+                        const uint8_t *sourceRow1,
+                        uint8_t *destRow,
+                        size_t destWidth)
+{
+    constexpr size_t kDestPixelsPerIteration = 16 / kPixelBytes;
+
+    size_t x = 0;
+    for (; x + kDestPixelsPerIteration <= destWidth; x += kDestPixelsPerIteration)
+    {
+        const uint8_t *top    = sourceRow0 + x * 2 * kPixelBytes;
+        const uint8_t *bottom = sourceRow1 + x * 2 * kPixelBytes;
+
+        const Vector first  = Average(LoadVector(top), LoadVector(bottom));
+        const Vector second = Average(LoadVector(top + 16), LoadVector(bottom + 16));
+
+        Vector even;
+        Vector odd;
+        Deinterleave<kPixelBytes>(first, second, &even, &odd);
+
+        Vector result = Average(even, odd);
+        if (kOpaque)
+        {
+            result = SetOpaque(result);
+        }
+        StoreVector(destRow + x * kPixelBytes, result);
+    }
+    return x;
+}
+#endif  // defined(ANGLE_GENERATE_MIP_SSE2) || defined(ANGLE_GENERATE_MIP_NEON)
+
+const std::array<float, 256> &GetSRGBToLinearTable()
+{
+    static const std::array<float, 256> kTable = []() {
+        std::array<float, 256> table;
+        for (size_t value = 0; value < table.size(); ++value)
+        {
+            table[value] = gl::sRGBToLinear(static_cast<uint8_t>(value));
+        }
+        return table;
+    }();
+    return kTable;
+}
+}  // anonymous namespace
+
+size_t GenerateMipRowXY_R8(const uint8_t *sourceRow0,
+                           const uint8_t *sourceRow1,
+                           uint8_t *destRow,
+                           size_t destWidth)
+{
+#if defined(ANGLE_GENERATE_MIP_SIMD)
+    return GenerateMipRowXY<1, AverageUNorm8>(sourceRow0, sourceRow1, destRow, destWidth);
+#else
+    return 0;
+#endif
+}
+
+size_t GenerateMipRowXY_R8G8(const uint8_t *sourceRow0,
+                             const uint8_t *sourceRow1,
+                             uint8_t *destRow,
+                             size_t destWidth)
+{
+#if defined(ANGLE_GENERATE_MIP_SIMD)
+    return GenerateMipRowXY<2, AverageUNorm8>(sourceRow0, sourceRow1, destRow, destWidth);
+#else
+    return 0;
+#endif
+}
+
+size_t GenerateMipRowXY_R8G8B8A8(const uint8_t *sourceRow0,
+                                 const uint8_t *sourceRow1,
+                                 uint8_t *destRow,
+                                 size_t destWidth)
+{
+#if defined(ANGLE_GENERATE_MIP_SIMD)
+    return GenerateMipRowXY<4, AverageUNorm8>(sourceRow0, sourceRow1, destRow, destWidth);
+#else
+    return 0;
+#endif
+}
+
+size_t GenerateMipRowXY_R8G8B8X8(const uint8_t *sourceRow0,
+                                 const uint8_t *sourceRow1,
+                                 uint8_t *destRow,
+                                 size_t destWidth)
+{
+#if defined(ANGLE_GENERATE_MIP_SIMD)
+    return GenerateMipRowXY<4, AverageUNorm8, true>(sourceRow0, sourceRow1, destRow, destWidth);
+#else
+    return 0;
+#endif
+}
+
+size_t GenerateMipRowXY_R16G16B16A16(const uint8_t *sourceRow0,
+                                     const uint8_t *sourceRow1,
+                                     uint8_t *destRow,
+                                     size_t destWidth)
+{
+#if defined(ANGLE_GENERATE_MIP_SIMD)
+    return GenerateMipRowXY<8, AverageUNorm16>(sourceRow0, sourceRow1, destRow, destWidth);
+#else
+    return 0;
+#endif
+}
+
+size_t GenerateMipRowXY_R32G32B32A32F(const uint8_t *sourceRow0,
+                                      const uint8_t *sourceRow1,
+                                      uint8_t *destRow,
+                                      size_t destWidth)
+{
+#if defined(ANGLE_GENERATE_MIP_SIMD)
+    return GenerateMipRowXY<16, AverageFloat32>(sourceRow0, sourceRow1, destRow, destWidth);
+#else
+    return 0;
+#endif
+}
+
+size_t GenerateMipRowXY_R16G16B16A16F(const uint8_t *sourceRow0,
+                                      const uint8_t *sourceRow1,
+                                      uint8_t *destRow,
+                                      size_t destWidth)
+{
+    const uint16_t *top    = reinterpret_cast<const uint16_t *>(sourceRow0);
+    const uint16_t *bottom = reinterpret_cast<const uint16_t *>(sourceRow1);
+    uint16_t *dest         = reinterpret_cast<uint16_t *>(destRow);
+
+    // Average the four pixels in float and convert back once, instead of rounding the two
+    // intermediate averages to half float.
+    for (size_t x = 0; x < destWidth; ++x)
+    {
+        for (size_t channel = 0; channel < 4; ++channel)
+        {
+            const size_t left  = x * 8 + channel;
+            const size_t right = left + 4;
+
+            const float leftAverage =
+                (gl::float16ToFloat32(top[left]) + gl::float16ToFloat32(bottom[left])) * 0.5f;
+            const float rightAverage =
+                (gl::float16ToFloat32(top[right]) + gl::float16ToFloat32(bottom[right])) * 0.5f;
+            dest[x * 4 + channel] = gl::float32ToFloat16((leftAverage + rightAverage) * 0.5f);
+        }
+    }
+    return destWidth;
+}
+
+size_t GenerateMipRowXY_R8G8B8A8SRGB(const uint8_t *sourceRow0,
+                                     const uint8_t *sourceRow1,
+                                     uint8_t *destRow,
+                                     size_t destWidth)
+{
+    const std::array<float, 256> &toLinear = GetSRGBToLinearTable();
+
+    // Average the color of the four pixels in linear space and encode the result once.  Alpha is
+    // linear, and is averaged like in R8G8B8A8SRGB::average.
+    for (size_t x = 0; x < destWidth; ++x)
+    {
+        const uint8_t *top    = sourceRow0 + x * 8;
+        const uint8_t *bottom = sourceRow1 + x * 8;
+        uint8_t *dest         = destRow + x * 4;
+
+        for (size_t channel = 0; channel < 3; ++channel)
+        {
+            const float sum = toLinear[top[channel]] + toLinear[bottom[channel]] +
+                              toLinear[top[channel + 4]] + toLinear[bottom[channel + 4]];
+            dest[channel] = gl::linearToSRGB(sum * 0.25f);
+        }
+        dest[3] = gl::average(gl::average(top[3], bottom[3]), gl::average(top[7], bottom[7]));
+    }
+    return destWidth;
+}
+
+}  // namespace angle
@@ -27,6 +27,45 @@ inline void GenerateMip(size_t sourceWidth,
                         size_t destRowPitch,
                         size_t destDepthPitch);
 
+// Kernels that GenerateMip uses to average the 2x2 blocks of two rows of a 2D image into a row of
+// the next level.  They return the number of destination pixels written, and the caller
+// generates the rest one pixel at a time.  Formats that store the same bytes share a kernel.
+size_t GenerateMipRowXY_R8(const uint8_t *sourceRow0,
+                           const uint8_t *sourceRow1,
+                           uint8_t *destRow,
+                           size_t destWidth);
+size_t GenerateMipRowXY_R8G8(const uint8_t *sourceRow0,
+                             const uint8_t *sourceRow1,
+                             uint8_t *destRow,
+                             size_t destWidth);
+size_t GenerateMipRowXY_R8G8B8A8(const uint8_t *sourceRow0,
+                                 const uint8_t *sourceRow1,
+                                 uint8_t *destRow,
+                                 size_t destWidth);
+size_t GenerateMipRowXY_R8G8B8X8(const uint8_t *sourceRow0,
+                                 const uint8_t *sourceRow1,
+                                 uint8_t *destRow,
+                                 size_t destWidth);
+size_t GenerateMipRowXY_R16G16B16A16(const uint8_t *sourceRow0,
+                                     const uint8_t *sourceRow1,
+                                     uint8_t *destRow,
+                                     size_t destWidth);
+size_t GenerateMipRowXY_R32G32B32A32F(const uint8_t *sourceRow0,
+                                      const uint8_t *sourceRow1,
+                                      uint8_t *destRow,
+                                      size_t destWidth);
+
+// Unlike T::average, these average the four pixels at once, rounding only the final result.  The
+// sRGB one also averages in linear space.
+size_t GenerateMipRowXY_R16G16B16A16F(const uint8_t *sourceRow0,
+                                      const uint8_t *sourceRow1,
+                                      uint8_t *destRow,
+                                      size_t destWidth);
+size_t GenerateMipRowXY_R8G8B8A8SRGB(const uint8_t *sourceRow0,
+                                     const uint8_t *sourceRow1,
+                                     uint8_t *destRow,
+                                     size_t destWidth);
+
 }  // namespace angle
 
 #include "generatemip.inc"
@@ -8,11 +8,25 @@
 
 #include "image_util/loadimage.h"
 
+#include <functional>
+#include <thread>
 #include <type_traits>
+#include "common/WorkerThread.h"
 #include "common/mathutil.h"
 
 #include "image_util/imageformats.h"
 
+#if defined(ANGLE_USE_SSE) && \
+    (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#    define ANGLE_ETC_DECODE_SSE2 1
+#    include <emmintrin.h>
+#endif
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+#    define ANGLE_ETC_DECODE_NEON 1
+#    include <arm_neon.h>
+#endif
+
 namespace angle
 {
 namespace
@@ -52,6 +66,154 @@ static IntensityModifier intensityModifierNonOpaque[] =
 
 static const int kNumPixelsInBlock = 16;
 
+// Each block decodes to a palette of at most eight values, which is computed once per block
+// instead of once per pixel.
+constexpr size_t kPaletteSize = 8;
+
+// Clamps the values of a palette to [lower, upper].
+void ClampPalette(int16_t *palette, int16_t lower, int16_t upper)
+{
+#if defined(ANGLE_ETC_DECODE_SSE2)
+    __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i *>(palette));
+    values         = _mm_max_epi16(values, _mm_set1_epi16(lower));
+    values         = _mm_min_epi16(values, _mm_set1_epi16(upper));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(palette), values);
+#elif defined(ANGLE_ETC_DECODE_NEON)
+    int16x8_t values = vld1q_s16(palette);
+    values           = vmaxq_s16(values, vdupq_n_s16(lower));
+    values           = vminq_s16(values, vdupq_n_s16(upper));
+    vst1q_s16(palette, values);
+#else
+    for (size_t i = 0; i < kPaletteSize; i++)
+    {
+        palette[i] = gl::clamp(palette[i], lower, upper);
+    }
+#endif
+}
+
+// Computes the four colors of a subblock in individual or differential mode, which are the base
+// color plus each intensity modifier, clamped to [0, 255].
+void ComputeSubblockColors(int r, int g, int b, const int *modifiers, R8G8B8A8 *colorsOut)
+{
+#if defined(ANGLE_ETC_DECODE_SSE2)
+    const __m128i base = _mm_setr_epi16(r, g, b, 0, r, g, b, 0);
+    const __m128i modifiers01 =
+        _mm_setr_epi16(modifiers[0], modifiers[0], modifiers[0], 0, modifiers[1], modifiers[1],
+                       modifiers[1], 0);
+    const __m128i modifiers23 =
+        _mm_setr_epi16(modifiers[2], modifiers[2], modifiers[2], 0, modifiers[3], modifiers[3],
+                       modifiers[3], 0);
+    __m128i colors = _mm_packus_epi16(_mm_add_epi16(base, modifiers01),
+                                      _mm_add_epi16(base, modifiers23));
+    colors         = _mm_or_si128(colors, _mm_set1_epi32(static_cast<int>(0xFF000000u)));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(colorsOut), colors);
+#elif defined(ANGLE_ETC_DECODE_NEON)
+    const int16_t baseValues[8] = {static_cast<int16_t>(r), static_cast<int16_t>(g),
+                                   static_cast<int16_t>(b), 0,
+                                   static_cast<int16_t>(r), static_cast<int16_t>(g),
+                                   static_cast<int16_t>(b), 0};
+    const int16x8_t base        = vld1q_s16(baseValues);
+    int16_t modifierValues[16];
+    for (size_t i = 0; i < 4; i++)
+    {
+        const int16_t modifier    = static_cast<int16_t>(modifiers[i]);
+        modifierValues[i * 4 + 0] = modifier;
+        modifierValues[i * 4 + 1] = modifier;
+        modifierValues[i * 4 + 2] = modifier;
+        modifierValues[i * 4 + 3] = 0;
+    }
+    const uint8x16_t colors =
+        vcombine_u8(vqmovun_s16(vaddq_s16(base, vld1q_s16(modifierValues))),
+                    vqmovun_s16(vaddq_s16(base, vld1q_s16(modifierValues + 8))));
+    const uint32x4_t opaque = vorrq_u32(vreinterpretq_u32_u8(colors), vdupq_n_u32(0xFF000000u));
+    vst1q_u32(reinterpret_cast<uint32_t *>(colorsOut), opaque);
+#else
+    for (size_t i = 0; i < 4; i++)
+    {
+        colorsOut[i].R = static_cast<uint8_t>(gl::clamp(r + modifiers[i], 0, 255));
+        colorsOut[i].G = static_cast<uint8_t>(gl::clamp(g + modifiers[i], 0, 255));
+        colorsOut[i].B = static_cast<uint8_t>(gl::clamp(b + modifiers[i], 0, 255));
+        colorsOut[i].A = 255;
+    }
+#endif
+}
+
+// Returns the max number of threads to use when decoding in parallel.
+size_t MaxThreads()
+{
+    static const size_t numThreads =
+        std::min<size_t>(16, std::max(1u, std::thread::hardware_concurrency()));
+    return numThreads;
+}
+
+// For smaller images the overhead of multithreading exceeds the benefits.
+constexpr size_t kMinBlocksForMultithreadedDecode = 64 * 64;
+
+using DecodeBlockRowFunc = std::function<void(size_t z, size_t y)>;
+
+// Decodes the block rows in [begin, end), counted over all slices.
+class DecodeBlockRowsTask final : public Closure
+{
+  public:
+    DecodeBlockRowsTask(const DecodeBlockRowFunc &decodeBlockRow,
+                        size_t blockRowsPerSlice,
+                        size_t begin,
+                        size_t end)
+        : mDecodeBlockRow(decodeBlockRow),
+          mBlockRowsPerSlice(blockRowsPerSlice),
+          mBegin(begin),
+          mEnd(end)
+    {}
+
+    void operator()() override
+    {
+        for (size_t blockRow = mBegin; blockRow < mEnd; blockRow++)
+        {
+            mDecodeBlockRow(blockRow / mBlockRowsPerSlice, (blockRow % mBlockRowsPerSlice) * 4);
+        }
+    }
+
+  private:
+    const DecodeBlockRowFunc &mDecodeBlockRow;
+    size_t mBlockRowsPerSlice;
+    size_t mBegin;
+    size_t mEnd;
+};
+
+// Calls |decodeBlockRow| with the slice and the first pixel row of every row of blocks.  Large
+// images are split in bands of block rows that are decoded in parallel on the multithreaded pool
+// of the context, if any.
+void ForEachBlockRow(const ImageLoadContext &context,
+                     size_t width,
+                     size_t height,
+                     size_t depth,
+                     const DecodeBlockRowFunc &decodeBlockRow)
+{
+    const size_t blockRowsPerSlice = (height + 3) / 4;
+    const size_t blockRowCount     = blockRowsPerSlice * depth;
+    const size_t blockCount        = blockRowCount * ((width + 3) / 4);
+
+    const size_t bandCount = std::min(MaxThreads(), blockRowCount);
+    if (!context.multiThreadPool || blockCount < kMinBlocksForMultithreadedDecode ||
+        bandCount <= 1)
+    {
+        DecodeBlockRowsTask(decodeBlockRow, blockRowsPerSlice, 0, blockRowCount)();
+        return;
+    }
+
+    std::vector<std::shared_ptr<WaitableEvent>> waitEvents;
+    waitEvents.reserve(bandCount);
+    for (size_t band = 0; band < bandCount; band++)
+    {
+        const size_t begin = blockRowCount * band / bandCount;
+        const size_t end   = blockRowCount * (band + 1) / bandCount;
+        waitEvents.push_back(context.multiThreadPool->postWorkerTask(
+            std::make_shared<DecodeBlockRowsTask>(decodeBlockRow, blockRowsPerSlice, begin, end),
+            WorkerTaskPriority::High));
+    }
+    WaitableEvent::WaitMany(&waitEvents);
+}
+
 struct ETC2Block
 {
     // Decodes unsigned single or dual channel ETC2 block to 8-bit color
@@ -64,20 +226,17 @@ struct ETC2Block
                                    size_t destRowPitch,
                                    bool isSigned) const
     {
+        int16_t palette[kPaletteSize];
+        getSingleETC2ChannelPalette(palette, isSigned);
+        const uint64_t indices = getSingleChannelIndices();
+
         for (size_t j = 0; j < 4 && (y + j) < h; j++)
         {
             uint8_t *row = dest + (j * destRowPitch);
             for (size_t i = 0; i < 4 && (x + i) < w; i++)
             {
                 uint8_t *pixel = row + (i * destPixelStride);
-                if (isSigned)
-                {
-                    *pixel = clampSByte(getSingleETC2Channel(i, j, isSigned));
-                }
-                else
-                {
-                    *pixel = clampByte(getSingleETC2Channel(i, j, isSigned));
-                }
+                *pixel = static_cast<uint8_t>(palette[GetSingleChannelIndex(indices, i, j)]);
             }
         }
     }
@@ -88,6 +247,10 @@ struct ETC2Block
     void transcodeAsBC4(uint8_t *dest, size_t x, size_t y, size_t w, size_t h, bool isSigned) const
     {
         static constexpr int kIndexMap[] = {1, 7, 6, 5, 4, 3, 2, 0};
+        int16_t palette[kPaletteSize];
+        getSingleETC2ChannelPalette(palette, isSigned);
+        const uint64_t indices = getSingleChannelIndices();
+
         int alpha[16];
         size_t k     = 0;
         int minAlpha = std::numeric_limits<int>::max();
@@ -96,14 +259,7 @@ struct ETC2Block
         {
             for (size_t i = 0; i < 4; i++)
             {
-                if (isSigned)
-                {
-                    alpha[k] = clampSByte(getSingleETC2Channel(i, j, isSigned));
-                }
-                else
-                {
-                    alpha[k] = clampByte(getSingleETC2Channel(i, j, isSigned));
-                }
+                alpha[k] = palette[GetSingleChannelIndex(indices, i, j)];
                 minAlpha = std::min(minAlpha, alpha[k]);
                 maxAlpha = std::max(maxAlpha, alpha[k]);
                 k++;
@@ -150,27 +306,34 @@ struct ETC2Block
                                   bool isSigned,
                                   bool isFloat) const
     {
+        // Renormalize (and convert to float) the palette instead of every pixel.
+        int16_t values[kPaletteSize];
+        getSingleEACChannelPalette(values, isSigned);
+        uint16_t palette[kPaletteSize];
+        for (size_t k = 0; k < kPaletteSize; k++)
+        {
+            if (isSigned)
+            {
+                int16_t tempPixel = renormalizeEAC<int16_t>(values[k]);
+                palette[k] =
+                    isFloat ? gl::float32ToFloat16(float(gl::normalize(tempPixel))) : tempPixel;
+            }
+            else
+            {
+                uint16_t tempPixel = renormalizeEAC<uint16_t>(values[k]);
+                palette[k] =
+                    isFloat ? gl::float32ToFloat16(float(gl::normalize(tempPixel))) : tempPixel;
+            }
+        }
+        const uint64_t indices = getSingleChannelIndices();
+
         for (size_t j = 0; j < 4 && (y + j) < h; j++)
         {
             uint16_t *row = reinterpret_cast<uint16_t *>(reinterpret_cast<uint8_t *>(dest) +
                                                          (j * destRowPitch));
             for (size_t i = 0; i < 4 && (x + i) < w; i++)
             {
-                uint16_t *pixel = row + (i * destPixelStride);
-                if (isSigned)
-                {
-                    int16_t tempPixel =
-                        renormalizeEAC<int16_t>(getSingleEACChannel(i, j, isSigned));
-                    *pixel =
-                        isFloat ? gl::float32ToFloat16(float(gl::normalize(tempPixel))) : tempPixel;
-                }
-                else
-                {
-                    uint16_t tempPixel =
-                        renormalizeEAC<uint16_t>(getSingleEACChannel(i, j, isSigned));
-                    *pixel =
-                        isFloat ? gl::float32ToFloat16(float(gl::normalize(tempPixel))) : tempPixel;
-                }
+                row[i * destPixelStride] = palette[GetSingleChannelIndex(indices, i, j)];
             }
         }
     }
@@ -421,11 +584,6 @@ struct ETC2Block
         return static_cast<unsigned char>(gl::clamp(value, 0, 255));
     }
 
-    static signed char clampSByte(int value)
-    {
-        return static_cast<signed char>(gl::clamp(value, -128, 127));
-    }
-
     template <typename T>
     static T renormalizeEAC(int value)
     {
@@ -535,15 +693,10 @@ struct ETC2Block
 
         R8G8B8A8 subblockColors0[4];
         R8G8B8A8 subblockColors1[4];
-        for (size_t modifierIdx = 0; modifierIdx < 4; modifierIdx++)
-        {
-            const int i1                 = intensityModifier[u.idht.mode.idm.cw1][modifierIdx];
-            subblockColors0[modifierIdx] = createRGBA(r1 + i1, g1 + i1, b1 + i1);
-
-            const int i2                 = intensityModifier[u.idht.mode.idm.cw2][modifierIdx];
-            subblockColors1[modifierIdx] = createRGBA(r2 + i2, g2 + i2, b2 + i2);
-        }
+        ComputeSubblockColors(r1, g1, b1, intensityModifier[u.idht.mode.idm.cw1], subblockColors0);
+        ComputeSubblockColors(r2, g2, b2, intensityModifier[u.idht.mode.idm.cw2], subblockColors1);
 
+        const uint32_t indices = getIndices();
         if (u.idht.mode.idm.flipbit)
         {
             uint8_t *curPixel = dest;
@@ -552,7 +705,7 @@ struct ETC2Block
                 R8G8B8A8 *row = reinterpret_cast<R8G8B8A8 *>(curPixel);
                 for (size_t i = 0; i < 4 && (x + i) < w; i++)
                 {
-                    row[i]   = subblockColors0[getIndex(i, j)];
+                    row[i]   = subblockColors0[GetIndex(indices, i, j)];
                     row[i].A = alphaValues[j][i];
                 }
                 curPixel += destRowPitch;
@@ -562,7 +715,7 @@ struct ETC2Block
                 R8G8B8A8 *row = reinterpret_cast<R8G8B8A8 *>(curPixel);
                 for (size_t i = 0; i < 4 && (x + i) < w; i++)
                 {
-                    row[i]   = subblockColors1[getIndex(i, j)];
+                    row[i]   = subblockColors1[GetIndex(indices, i, j)];
                     row[i].A = alphaValues[j][i];
                 }
                 curPixel += destRowPitch;
@@ -576,12 +729,12 @@ struct ETC2Block
                 R8G8B8A8 *row = reinterpret_cast<R8G8B8A8 *>(curPixel);
                 for (size_t i = 0; i < 2 && (x + i) < w; i++)
                 {
-                    row[i]   = subblockColors0[getIndex(i, j)];
+                    row[i]   = subblockColors0[GetIndex(indices, i, j)];
                     row[i].A = alphaValues[j][i];
                 }
                 for (size_t i = 2; i < 4 && (x + i) < w; i++)
                 {
-                    row[i]   = subblockColors1[getIndex(i, j)];
+                    row[i]   = subblockColors1[GetIndex(indices, i, j)];
                     row[i].A = alphaValues[j][i];
                 }
                 curPixel += destRowPitch;
@@ -622,13 +775,14 @@ struct ETC2Block
             createRGBA(r2 - d, g2 - d, b2 - d),
         };
 
-        uint8_t *curPixel = dest;
+        const uint32_t indices = getIndices();
+        uint8_t *curPixel      = dest;
         for (size_t j = 0; j < 4 && (y + j) < h; j++)
         {
             R8G8B8A8 *row = reinterpret_cast<R8G8B8A8 *>(curPixel);
             for (size_t i = 0; i < 4 && (x + i) < w; i++)
             {
-                row[i]   = paintColors[getIndex(i, j)];
+                row[i]   = paintColors[GetIndex(indices, i, j)];
                 row[i].A = alphaValues[j][i];
             }
             curPixel += destRowPitch;
@@ -671,13 +825,14 @@ struct ETC2Block
             createRGBA(r2 - d, g2 - d, b2 - d),
         };
 
-        uint8_t *curPixel = dest;
+        const uint32_t indices = getIndices();
+        uint8_t *curPixel      = dest;
         for (size_t j = 0; j < 4 && (y + j) < h; j++)
         {
             R8G8B8A8 *row = reinterpret_cast<R8G8B8A8 *>(curPixel);
             for (size_t i = 0; i < 4 && (x + i) < w; i++)
             {
-                row[i]   = paintColors[getIndex(i, j)];
+                row[i]   = paintColors[GetIndex(indices, i, j)];
                 row[i].A = alphaValues[j][i];
             }
             curPixel += destRowPitch;
@@ -727,14 +882,29 @@ struct ETC2Block
         }
     }
 
-    // Index for individual, differential, H and T modes
-    size_t getIndex(size_t x, size_t y) const
+    // Indices for individual, differential, H and T modes.  The most and least significant bits
+    // of the indices are stored in separate big-endian words, with pixel (x, y) at bit x * 4 + y.
+    // They are interleaved so pixel (x, y) is at bits 2 * (x * 4 + y) of the result.
+    uint32_t getIndices() const
+    {
+        const uint32_t msb = u.idht.pixelIndexMSB[0] << 8 | u.idht.pixelIndexMSB[1];
+        const uint32_t lsb = u.idht.pixelIndexLSB[0] << 8 | u.idht.pixelIndexLSB[1];
+        return SpreadBits(msb) << 1 | SpreadBits(lsb);
+    }
+
+    static uint32_t SpreadBits(uint32_t bits)
     {
-        size_t bitIndex  = x * 4 + y;
-        size_t bitOffset = bitIndex & 7;
-        size_t lsb       = (u.idht.pixelIndexLSB[1 - (bitIndex >> 3)] >> bitOffset) & 1;
-        size_t msb       = (u.idht.pixelIndexMSB[1 - (bitIndex >> 3)] >> bitOffset) & 1;
-        return (msb << 1) | lsb;
+        bits = (bits | bits << 8) & 0x00FF00FF;
+        bits = (bits | bits << 4) & 0x0F0F0F0F;
+        bits = (bits | bits << 2) & 0x33333333;
+        bits = (bits | bits << 1) & 0x55555555;
+        return bits;
+    }
+
+    static size_t GetIndex(uint32_t indices, size_t x, size_t y)
+    {
+        ASSERT(x < 4 && y < 4);
+        return (indices >> (2 * (x * 4 + y))) & 3;
     }
 
     void decodePunchThroughAlphaBlock(uint8_t *dest,
@@ -744,13 +914,14 @@ struct ETC2Block
                                       size_t h,
                                       size_t destRowPitch) const
     {
-        uint8_t *curPixel = dest;
+        const uint32_t indices = getIndices();
+        uint8_t *curPixel      = dest;
         for (size_t j = 0; j < 4 && (y + j) < h; j++)
         {
             R8G8B8A8 *row = reinterpret_cast<R8G8B8A8 *>(curPixel);
             for (size_t i = 0; i < 4 && (x + i) < w; i++)
             {
-                if (getIndex(i, j) == 2)  //  msb == 1 && lsb == 0
+                if (GetIndex(indices, i, j) == 2)  //  msb == 1 && lsb == 0
                 {
                     row[i] = createRGBA(0, 0, 0, 0);
                 }
@@ -1026,12 +1197,13 @@ struct ETC2Block
             std::swap(dxEnd, dyEnd);
         }
 
+        const uint32_t indices = getIndices();
         for (size_t j = dyBegin; j < dyEnd; j++)
         {
             int *row = &pixelIndices[j * 4];
             for (size_t i = dxBegin; i < dxEnd; i++)
             {
-                const size_t pixelIndex = subblockIdx * 4 + getIndex(i, j);
+                const size_t pixelIndex = subblockIdx * 4 + GetIndex(indices, i, j);
                 row[i]                  = static_cast<int>(pixelIndex);
                 pixelIndicesCounts[pixelIndex]++;
             }
@@ -1288,6 +1460,7 @@ struct ETC2Block
             createRGBA(r2 - d, g2 - d, b2 - d),
         };
 
+        const uint32_t indices = getIndices();
         int pixelIndices[kNumPixelsInBlock];
         int pixelIndexCounts[kNumColors] = {0};
         for (size_t j = 0; j < 4; j++)
@@ -1295,7 +1468,7 @@ struct ETC2Block
             int *row = &pixelIndices[j * 4];
             for (size_t i = 0; i < 4; i++)
             {
-                const size_t pixelIndex = getIndex(i, j);
+                const size_t pixelIndex = GetIndex(indices, i, j);
                 row[i]                  = static_cast<int>(pixelIndex);
                 pixelIndexCounts[pixelIndex]++;
             }
@@ -1344,6 +1517,7 @@ struct ETC2Block
             createRGBA(r2 - d, g2 - d, b2 - d),
         };
 
+        const uint32_t indices = getIndices();
         int pixelIndices[kNumPixelsInBlock];
         int pixelIndexCounts[kNumColors] = {0};
         for (size_t j = 0; j < 4; j++)
@@ -1351,7 +1525,7 @@ struct ETC2Block
             int *row = &pixelIndices[j * 4];
             for (size_t i = 0; i < 4; i++)
             {
-                const size_t pixelIndex = getIndex(i, j);
+                const size_t pixelIndex = GetIndex(indices, i, j);
                 row[i]                  = static_cast<int>(pixelIndex);
                 pixelIndexCounts[pixelIndex]++;
             }
@@ -1391,48 +1565,55 @@ struct ETC2Block
     }
 
     // Single channel utility functions
-    int getSingleEACChannel(size_t x, size_t y, bool isSigned) const
+    void getSingleEACChannelPalette(int16_t *palette, bool isSigned) const
+    {
+        int codeword         = isSigned ? u.scblk.base_codeword.s : u.scblk.base_codeword.us;
+        int multiplier       = (u.scblk.multiplier == 0) ? 1 : u.scblk.multiplier * 8;
+        const int *modifiers = getSingleChannelModifiers();
+        for (size_t k = 0; k < kPaletteSize; k++)
+        {
+            palette[k] = static_cast<int16_t>(codeword * 8 + 4 + modifiers[k] * multiplier);
+        }
+    }
+
+    void getSingleETC2ChannelPalette(int16_t *palette, bool isSigned) const
     {
-        int codeword   = isSigned ? u.scblk.base_codeword.s : u.scblk.base_codeword.us;
-        int multiplier = (u.scblk.multiplier == 0) ? 1 : u.scblk.multiplier * 8;
-        return codeword * 8 + 4 + getSingleChannelModifier(x, y) * multiplier;
+        int codeword         = isSigned ? u.scblk.base_codeword.s : u.scblk.base_codeword.us;
+        const int *modifiers = getSingleChannelModifiers();
+        for (size_t k = 0; k < kPaletteSize; k++)
+        {
+            palette[k] = static_cast<int16_t>(codeword + modifiers[k] * u.scblk.multiplier);
+        }
+        if (isSigned)
+        {
+            ClampPalette(palette, -128, 127);
+        }
+        else
+        {
+            ClampPalette(palette, 0, 255);
+        }
     }
 
-    int getSingleETC2Channel(size_t x, size_t y, bool isSigned) const
+    // The 3-bit indices of the pixels are stored big-endian after the base codeword, table index
+    // and multiplier, starting with pixel (0, 0) and going down columns.
+    uint64_t getSingleChannelIndices() const
     {
-        int codeword = isSigned ? u.scblk.base_codeword.s : u.scblk.base_codeword.us;
-        return codeword + getSingleChannelModifier(x, y) * u.scblk.multiplier;
+        const uint8_t *bytes = reinterpret_cast<const uint8_t *>(&u) + 2;
+        uint64_t indices     = 0;
+        for (size_t byte = 0; byte < 6; byte++)
+        {
+            indices = (indices << 8) | bytes[byte];
+        }
+        return indices;
     }
 
-    int getSingleChannelIndex(size_t x, size_t y) const
+    static size_t GetSingleChannelIndex(uint64_t indices, size_t x, size_t y)
     {
         ASSERT(x < 4 && y < 4);
-
-        // clang-format off
-        switch (x * 4 + y)
-        {
-            case 0: return u.scblk.ma;
-            case 1: return u.scblk.mb;
-            case 2: return u.scblk.mc1 << 1 | u.scblk.mc2;
-            case 3: return u.scblk.md;
-            case 4: return u.scblk.me;
-            case 5: return u.scblk.mf1 << 2 | u.scblk.mf2;
-            case 6: return u.scblk.mg;
-            case 7: return u.scblk.mh;
-            case 8: return u.scblk.mi;
-            case 9: return u.scblk.mj;
-            case 10: return u.scblk.mk1 << 1 | u.scblk.mk2;
-            case 11: return u.scblk.ml;
-            case 12: return u.scblk.mm;
-            case 13: return u.scblk.mn1 << 2 | u.scblk.mn2;
-            case 14: return u.scblk.mo;
-            case 15: return u.scblk.mp;
-            default: UNREACHABLE(); return 0;
-        }
-        // clang-format on
+        return static_cast<size_t>(indices >> (45 - 3 * (x * 4 + y))) & 7;
     }
 
-    int getSingleChannelModifier(size_t x, size_t y) const
+    const int *getSingleChannelModifiers() const
     {
         // clang-format off
         static const int modifierTable[16][8] =
@@ -1456,7 +1637,7 @@ struct ETC2Block
         };
         // clang-format on
 
-        return modifierTable[u.scblk.table_index][getSingleChannelIndex(x, y)];
+        return modifierTable[u.scblk.table_index];
     }
 };
 
@@ -1482,25 +1663,21 @@ void LoadR11EACToR8(const ImageLoadContext &context,
                     size_t outputDepthPitch,
                     bool isSigned)
 {
-    for (size_t z = 0; z < depth; z++)
-    {
-        for (size_t y = 0; y < height; y += 4)
-        {
-            const ETC2Block *sourceRow =
-                priv::OffsetDataPointer<ETC2Block>(input, y / 4, z, inputRowPitch, inputDepthPitch);
-            uint8_t *destRow =
-                priv::OffsetDataPointer<uint8_t>(output, y, z, outputRowPitch, outputDepthPitch);
+    ForEachBlockRow(context, width, height, depth, [&](size_t z, size_t y) {
+        const ETC2Block *sourceRow =
+            priv::OffsetDataPointer<ETC2Block>(input, y / 4, z, inputRowPitch, inputDepthPitch);
+        uint8_t *destRow =
+            priv::OffsetDataPointer<uint8_t>(output, y, z, outputRowPitch, outputDepthPitch);
 
-            for (size_t x = 0; x < width; x += 4)
-            {
-                const ETC2Block *sourceBlock = sourceRow + (x / 4);
-                uint8_t *destPixels          = destRow + x;
+        for (size_t x = 0; x < width; x += 4)
+        {
+            const ETC2Block *sourceBlock = sourceRow + (x / 4);
+            uint8_t *destPixels          = destRow + x;
 
-                sourceBlock->decodeAsSingleETC2Channel(destPixels, x, y, width, height, 1,
-                                                       outputRowPitch, isSigned);
-            }
+            sourceBlock->decodeAsSingleETC2Channel(destPixels, x, y, width, height, 1,
+                                                   outputRowPitch, isSigned);
         }
-    }
+    });
 }
 
 void LoadRG11EACToRG8(const ImageLoadContext &context,
@@ -1515,29 +1692,25 @@ void LoadRG11EACToRG8(const ImageLoadContext &context,
                       size_t outputDepthPitch,
                       bool isSigned)
 {
-    for (size_t z = 0; z < depth; z++)
-    {
-        for (size_t y = 0; y < height; y += 4)
-        {
-            const ETC2Block *sourceRow =
-                priv::OffsetDataPointer<ETC2Block>(input, y / 4, z, inputRowPitch, inputDepthPitch);
-            uint8_t *destRow =
-                priv::OffsetDataPointer<uint8_t>(output, y, z, outputRowPitch, outputDepthPitch);
+    ForEachBlockRow(context, width, height, depth, [&](size_t z, size_t y) {
+        const ETC2Block *sourceRow =
+            priv::OffsetDataPointer<ETC2Block>(input, y / 4, z, inputRowPitch, inputDepthPitch);
+        uint8_t *destRow =
+            priv::OffsetDataPointer<uint8_t>(output, y, z, outputRowPitch, outputDepthPitch);
 
-            for (size_t x = 0; x < width; x += 4)
-            {
-                uint8_t *destPixelsRed          = destRow + (x * 2);
-                const ETC2Block *sourceBlockRed = sourceRow + (x / 2);
-                sourceBlockRed->decodeAsSingleETC2Channel(destPixelsRed, x, y, width, height, 2,
-                                                          outputRowPitch, isSigned);
-
-                uint8_t *destPixelsGreen          = destPixelsRed + 1;
-                const ETC2Block *sourceBlockGreen = sourceBlockRed + 1;
-                sourceBlockGreen->decodeAsSingleETC2Channel(destPixelsGreen, x, y, width, height, 2,
-                                                            outputRowPitch, isSigned);
-            }
+        for (size_t x = 0; x < width; x += 4)
+        {
+            uint8_t *destPixelsRed          = destRow + (x * 2);
+            const ETC2Block *sourceBlockRed = sourceRow + (x / 2);
+            sourceBlockRed->decodeAsSingleETC2Channel(destPixelsRed, x, y, width, height, 2,
+                                                      outputRowPitch, isSigned);
+
+            uint8_t *destPixelsGreen          = destPixelsRed + 1;
+            const ETC2Block *sourceBlockGreen = sourceBlockRed + 1;
+            sourceBlockGreen->decodeAsSingleETC2Channel(destPixelsGreen, x, y, width, height, 2,
+                                                        outputRowPitch, isSigned);
         }
-    }
+    });
 }
 
 void LoadR11EACToR16(const ImageLoadContext &context,
@@ -1553,25 +1726,21 @@ void LoadR11EACToR16(const ImageLoadContext &context,
                      bool isSigned,
                      bool isFloat)
 {
-    for (size_t z = 0; z < depth; z++)
-    {
-        for (size_t y = 0; y < height; y += 4)
-        {
-            const ETC2Block *sourceRow =
-                priv::OffsetDataPointer<ETC2Block>(input, y / 4, z, inputRowPitch, inputDepthPitch);
-            uint16_t *destRow =
-                priv::OffsetDataPointer<uint16_t>(output, y, z, outputRowPitch, outputDepthPitch);
+    ForEachBlockRow(context, width, height, depth, [&](size_t z, size_t y) {
+        const ETC2Block *sourceRow =
+            priv::OffsetDataPointer<ETC2Block>(input, y / 4, z, inputRowPitch, inputDepthPitch);
+        uint16_t *destRow =
+            priv::OffsetDataPointer<uint16_t>(output, y, z, outputRowPitch, outputDepthPitch);
 
-            for (size_t x = 0; x < width; x += 4)
-            {
-                const ETC2Block *sourceBlock = sourceRow + (x / 4);
-                uint16_t *destPixels         = destRow + x;
+        for (size_t x = 0; x < width; x += 4)
+        {
+            const ETC2Block *sourceBlock = sourceRow + (x / 4);
+            uint16_t *destPixels         = destRow + x;
 
-                sourceBlock->decodeAsSingleEACChannel(destPixels, x, y, width, height, 1,
-                                                      outputRowPitch, isSigned, isFloat);
-            }
+            sourceBlock->decodeAsSingleEACChannel(destPixels, x, y, width, height, 1,
+                                                  outputRowPitch, isSigned, isFloat);
         }
-    }
+    });
 }
 
 void LoadRG11EACToRG16(const ImageLoadContext &context,
@@ -1587,29 +1756,25 @@ void LoadRG11EACToRG16(const ImageLoadContext &context,
                        bool isSigned,
                        bool isFloat)
 {
-    for (size_t z = 0; z < depth; z++)
-    {
-        for (size_t y = 0; y < height; y += 4)
-        {
-            const ETC2Block *sourceRow =
-                priv::OffsetDataPointer<ETC2Block>(input, y / 4, z, inputRowPitch, inputDepthPitch);
-            uint16_t *destRow =
-                priv::OffsetDataPointer<uint16_t>(output, y, z, outputRowPitch, outputDepthPitch);
+    ForEachBlockRow(context, width, height, depth, [&](size_t z, size_t y) {
+        const ETC2Block *sourceRow =
+            priv::OffsetDataPointer<ETC2Block>(input, y / 4, z, inputRowPitch, inputDepthPitch);
+        uint16_t *destRow =
+            priv::OffsetDataPointer<uint16_t>(output, y, z, outputRowPitch, outputDepthPitch);
 
-            for (size_t x = 0; x < width; x += 4)
-            {
-                uint16_t *destPixelsRed         = destRow + (x * 2);
-                const ETC2Block *sourceBlockRed = sourceRow + (x / 2);
-                sourceBlockRed->decodeAsSingleEACChannel(destPixelsRed, x, y, width, height, 2,
-                                                         outputRowPitch, isSigned, isFloat);
-
-                uint16_t *destPixelsGreen         = destPixelsRed + 1;
-                const ETC2Block *sourceBlockGreen = sourceBlockRed + 1;
-                sourceBlockGreen->decodeAsSingleEACChannel(destPixelsGreen, x, y, width, height, 2,
-                                                           outputRowPitch, isSigned, isFloat);
-            }
+        for (size_t x = 0; x < width; x += 4)
+        {
+            uint16_t *destPixelsRed         = destRow + (x * 2);
+            const ETC2Block *sourceBlockRed = sourceRow + (x / 2);
+            sourceBlockRed->decodeAsSingleEACChannel(destPixelsRed, x, y, width, height, 2,
+                                                     outputRowPitch, isSigned, isFloat);
+
+            uint16_t *destPixelsGreen         = destPixelsRed + 1;
+            const ETC2Block *sourceBlockGreen = sourceBlockRed + 1;
+            sourceBlockGreen->decodeAsSingleEACChannel(destPixelsGreen, x, y, width, height, 2,
+                                                       outputRowPitch, isSigned, isFloat);
         }
-    }
+    });
 }
 
 void LoadETC2RGB8ToRGBA8(const ImageLoadContext &context,
@@ -1624,25 +1789,21 @@ void LoadETC2RGB8ToRGBA8(const ImageLoadContext &context,
                          size_t outputDepthPitch,
                          bool punchthroughAlpha)
 {
-    for (size_t z = 0; z < depth; z++)
-    {
-        for (size_t y = 0; y < height; y += 4)
-        {
-            const ETC2Block *sourceRow =
-                priv::OffsetDataPointer<ETC2Block>(input, y / 4, z, inputRowPitch, inputDepthPitch);
-            uint8_t *destRow =
-                priv::OffsetDataPointer<uint8_t>(output, y, z, outputRowPitch, outputDepthPitch);
+    ForEachBlockRow(context, width, height, depth, [&](size_t z, size_t y) {
+        const ETC2Block *sourceRow =
+            priv::OffsetDataPointer<ETC2Block>(input, y / 4, z, inputRowPitch, inputDepthPitch);
+        uint8_t *destRow =
+            priv::OffsetDataPointer<uint8_t>(output, y, z, outputRowPitch, outputDepthPitch);
 
-            for (size_t x = 0; x < width; x += 4)
-            {
-                const ETC2Block *sourceBlock = sourceRow + (x / 4);
-                uint8_t *destPixels          = destRow + (x * 4);
+        for (size_t x = 0; x < width; x += 4)
+        {
+            const ETC2Block *sourceBlock = sourceRow + (x / 4);
+            uint8_t *destPixels          = destRow + (x * 4);
 
-                sourceBlock->decodeAsRGB(destPixels, x, y, width, height, outputRowPitch,
-                                         DefaultETCAlphaValues, punchthroughAlpha);
-            }
+            sourceBlock->decodeAsRGB(destPixels, x, y, width, height, outputRowPitch,
+                                     DefaultETCAlphaValues, punchthroughAlpha);
         }
-    }
+    });
 }
 
 void LoadETC2RGB8ToBC1(const ImageLoadContext &context,
@@ -1657,25 +1818,21 @@ void LoadETC2RGB8ToBC1(const ImageLoadContext &context,
                        size_t outputDepthPitch,
                        bool punchthroughAlpha)
 {
-    for (size_t z = 0; z < depth; z++)
-    {
-        for (size_t y = 0; y < height; y += 4)
-        {
-            const ETC2Block *sourceRow =
-                priv::OffsetDataPointer<ETC2Block>(input, y / 4, z, inputRowPitch, inputDepthPitch);
-            uint8_t *destRow = priv::OffsetDataPointer<uint8_t>(output, y / 4, z, outputRowPitch,
-                                                                outputDepthPitch);
+    ForEachBlockRow(context, width, height, depth, [&](size_t z, size_t y) {
+        const ETC2Block *sourceRow =
+            priv::OffsetDataPointer<ETC2Block>(input, y / 4, z, inputRowPitch, inputDepthPitch);
+        uint8_t *destRow = priv::OffsetDataPointer<uint8_t>(output, y / 4, z, outputRowPitch,
+                                                            outputDepthPitch);
 
-            for (size_t x = 0; x < width; x += 4)
-            {
-                const ETC2Block *sourceBlock = sourceRow + (x / 4);
-                uint8_t *destPixels          = destRow + (x * 2);
+        for (size_t x = 0; x < width; x += 4)
+        {
+            const ETC2Block *sourceBlock = sourceRow + (x / 4);
+            uint8_t *destPixels          = destRow + (x * 2);
 
-                sourceBlock->transcodeAsBC1(destPixels, x, y, width, height, DefaultETCAlphaValues,
-                                            punchthroughAlpha);
-            }
+            sourceBlock->transcodeAsBC1(destPixels, x, y, width, height, DefaultETCAlphaValues,
+                                        punchthroughAlpha);
         }
-    }
+    });
 }
 
 void LoadETC2RGBA8ToBC3(const ImageLoadContext &context,
@@ -1691,30 +1848,26 @@ void LoadETC2RGBA8ToBC3(const ImageLoadContext &context,
                         bool punchthroughAlpha,
                         bool isSigned)
 {
-    for (size_t z = 0; z < depth; z++)
-    {
-        for (size_t y = 0; y < height; y += 4)
-        {
-            const ETC2Block *sourceRow =
-                priv::OffsetDataPointer<ETC2Block>(input, y / 4, z, inputRowPitch, inputDepthPitch);
-            uint8_t *destRow = priv::OffsetDataPointer<uint8_t>(output, y / 4, z, outputRowPitch,
-                                                                outputDepthPitch);
+    ForEachBlockRow(context, width, height, depth, [&](size_t z, size_t y) {
+        const ETC2Block *sourceRow =
+            priv::OffsetDataPointer<ETC2Block>(input, y / 4, z, inputRowPitch, inputDepthPitch);
+        uint8_t *destRow = priv::OffsetDataPointer<uint8_t>(output, y / 4, z, outputRowPitch,
+                                                            outputDepthPitch);
 
-            for (size_t x = 0; x < width; x += 4)
-            {
-                const ETC2Block *sourceAlphaBlock = sourceRow + (x / 4) * 2;
-                uint8_t *destAlphaPixels          = destRow + (x * 4);
+        for (size_t x = 0; x < width; x += 4)
+        {
+            const ETC2Block *sourceAlphaBlock = sourceRow + (x / 4) * 2;
+            uint8_t *destAlphaPixels          = destRow + (x * 4);
 
-                const ETC2Block *sourceRgbBlock = sourceAlphaBlock + 1;
-                uint8_t *destRgbPixels          = destAlphaPixels + 8;
+            const ETC2Block *sourceRgbBlock = sourceAlphaBlock + 1;
+            uint8_t *destRgbPixels          = destAlphaPixels + 8;
 
-                sourceRgbBlock->transcodeAsBC1(destRgbPixels, x, y, width, height,
-                                               DefaultETCAlphaValues, punchthroughAlpha);
+            sourceRgbBlock->transcodeAsBC1(destRgbPixels, x, y, width, height,
+                                           DefaultETCAlphaValues, punchthroughAlpha);
 
-                sourceAlphaBlock->transcodeAsBC4(destAlphaPixels, x, y, width, height, isSigned);
-            }
+            sourceAlphaBlock->transcodeAsBC4(destAlphaPixels, x, y, width, height, isSigned);
         }
-    }
+    });
 }
 
 void LoadETC2RGBA8ToRGBA8(const ImageLoadContext &context,
@@ -1729,31 +1882,26 @@ void LoadETC2RGBA8ToRGBA8(const ImageLoadContext &context,
                           size_t outputDepthPitch,
                           bool srgb)
 {
-    uint8_t decodedAlphaValues[4][4];
+    ForEachBlockRow(context, width, height, depth, [&](size_t z, size_t y) {
+        uint8_t decodedAlphaValues[4][4];
 
-    for (size_t z = 0; z < depth; z++)
-    {
-        for (size_t y = 0; y < height; y += 4)
-        {
-            const ETC2Block *sourceRow =
-                priv::OffsetDataPointer<ETC2Block>(input, y / 4, z, inputRowPitch, inputDepthPitch);
-            uint8_t *destRow =
-                priv::OffsetDataPointer<uint8_t>(output, y, z, outputRowPitch, outputDepthPitch);
+        const ETC2Block *sourceRow =
+            priv::OffsetDataPointer<ETC2Block>(input, y / 4, z, inputRowPitch, inputDepthPitch);
+        uint8_t *destRow =
+            priv::OffsetDataPointer<uint8_t>(output, y, z, outputRowPitch, outputDepthPitch);
 
-            for (size_t x = 0; x < width; x += 4)
-            {
-                const ETC2Block *sourceBlockAlpha = sourceRow + (x / 2);
-                sourceBlockAlpha->decodeAsSingleETC2Channel(
-                    reinterpret_cast<uint8_t *>(decodedAlphaValues), x, y, width, height, 1, 4,
-                    false);
-
-                uint8_t *destPixels             = destRow + (x * 4);
-                const ETC2Block *sourceBlockRGB = sourceBlockAlpha + 1;
-                sourceBlockRGB->decodeAsRGB(destPixels, x, y, width, height, outputRowPitch,
-                                            decodedAlphaValues, false);
-            }
+        for (size_t x = 0; x < width; x += 4)
+        {
+            const ETC2Block *sourceBlockAlpha = sourceRow + (x / 2);
+            sourceBlockAlpha->decodeAsSingleETC2Channel(
+                reinterpret_cast<uint8_t *>(decodedAlphaValues), x, y, width, height, 1, 4, false);
+
+            uint8_t *destPixels             = destRow + (x * 4);
+            const ETC2Block *sourceBlockRGB = sourceBlockAlpha + 1;
+            sourceBlockRGB->decodeAsRGB(destPixels, x, y, width, height, outputRowPitch,
+                                        decodedAlphaValues, false);
         }
-    }
+    });
 }
 
 }  // anonymous namespace
@@ -2160,23 +2308,19 @@ void LoadEACR11ToBC4(const ImageLoadContext &context,
                      size_t outputDepthPitch,
                      bool isSigned)
 {
-    for (size_t z = 0; z < depth; z++)
-    {
-        for (size_t y = 0; y < height; y += 4)
-        {
-            const ETC2Block *sourceRow =
-                priv::OffsetDataPointer<ETC2Block>(input, y / 4, z, inputRowPitch, inputDepthPitch);
-            uint8_t *destRow = priv::OffsetDataPointer<uint8_t>(output, y / 4, z, outputRowPitch,
-                                                                outputDepthPitch);
+    ForEachBlockRow(context, width, height, depth, [&](size_t z, size_t y) {
+        const ETC2Block *sourceRow =
+            priv::OffsetDataPointer<ETC2Block>(input, y / 4, z, inputRowPitch, inputDepthPitch);
+        uint8_t *destRow = priv::OffsetDataPointer<uint8_t>(output, y / 4, z, outputRowPitch,
+                                                            outputDepthPitch);
 
-            for (size_t x = 0; x < width; x += 4)
-            {
-                const ETC2Block *sourceR11Block = sourceRow + (x / 4);
-                uint8_t *destR11Pixels          = destRow + (x * 2);
-                sourceR11Block->transcodeAsBC4(destR11Pixels, x, y, width, height, isSigned);
-            }
+        for (size_t x = 0; x < width; x += 4)
+        {
+            const ETC2Block *sourceR11Block = sourceRow + (x / 4);
+            uint8_t *destR11Pixels          = destRow + (x * 2);
+            sourceR11Block->transcodeAsBC4(destR11Pixels, x, y, width, height, isSigned);
         }
-    }
+    });
 }
 
 void LoadEACRG11ToBC5(const ImageLoadContext &context,
@@ -2191,27 +2335,23 @@ void LoadEACRG11ToBC5(const ImageLoadContext &context,
                       size_t outputDepthPitch,
                       bool isSigned)
 {
-    for (size_t z = 0; z < depth; z++)
-    {
-        for (size_t y = 0; y < height; y += 4)
-        {
-            const ETC2Block *sourceRow =
-                priv::OffsetDataPointer<ETC2Block>(input, y / 4, z, inputRowPitch, inputDepthPitch);
-            uint8_t *destRow = priv::OffsetDataPointer<uint8_t>(output, y / 4, z, outputRowPitch,
-                                                                outputDepthPitch);
+    ForEachBlockRow(context, width, height, depth, [&](size_t z, size_t y) {
+        const ETC2Block *sourceRow =
+            priv::OffsetDataPointer<ETC2Block>(input, y / 4, z, inputRowPitch, inputDepthPitch);
+        uint8_t *destRow = priv::OffsetDataPointer<uint8_t>(output, y / 4, z, outputRowPitch,
+                                                            outputDepthPitch);
 
-            for (size_t x = 0; x < width; x += 4)
-            {
-                const ETC2Block *sourceR11Block = sourceRow + (x / 2);
-                uint8_t *destR11Pixels          = destRow + (x * 4);
+        for (size_t x = 0; x < width; x += 4)
+        {
+            const ETC2Block *sourceR11Block = sourceRow + (x / 2);
+            uint8_t *destR11Pixels          = destRow + (x * 4);
 
-                const ETC2Block *sourceG11Block = sourceR11Block + 1;
-                uint8_t *destG11Pixels          = destR11Pixels + 8;
-                sourceR11Block->transcodeAsBC4(destR11Pixels, x, y, width, height, isSigned);
-                sourceG11Block->transcodeAsBC4(destG11Pixels, x, y, width, height, isSigned);
-            }
+            const ETC2Block *sourceG11Block = sourceR11Block + 1;
+            uint8_t *destG11Pixels          = destR11Pixels + 8;
+            sourceR11Block->transcodeAsBC4(destR11Pixels, x, y, width, height, isSigned);
+            sourceG11Block->transcodeAsBC4(destG11Pixels, x, y, width, height, isSigned);
         }
-    }
+    });
 }
 
 void LoadEACR11ToBC4(const ImageLoadContext &context,
@@ -17,7 +17,12 @@
 namespace egl
 {
 BlobCache::BlobCache(size_t maxCacheSizeBytes)
-    : mBlobCache(maxCacheSizeBytes), mSetBlobFunc(nullptr), mGetBlobFunc(nullptr)
+    : mBlobCache(maxCacheSizeBytes),
+      mRecordedGetCount(0),
+      mSetBlobFunc(nullptr),
+      mGetBlobFunc(nullptr),
+      mBlobCacheFuncsSet(false),
+      mCompressionCodec(angle::BlobCompressionCodec::Gzip)
 {}
 
 BlobCache::~BlobCache() {}
@@ -41,7 +46,8 @@ bool BlobCache::compressAndPut(const BlobCache::Key &key,
                                size_t *compressedSize)
 {
     angle::MemoryBuffer compressedValue;
-    if (!angle::CompressBlob(uncompressedValue.size(), uncompressedValue.data(), &compressedValue))
+    if (!angle::CompressBlob(uncompressedValue.size(), uncompressedValue.data(), &compressedValue,
+                             mCompressionCodec))
     {
         return false;
     }
@@ -62,13 +68,16 @@ void BlobCache::putApplication(const BlobCache::Key &key, const angle::MemoryBuf
 
 void BlobCache::populate(const BlobCache::Key &key, angle::MemoryBuffer &&value, CacheSource source)
 {
-    std::scoped_lock<angle::SimpleMutex> lock(mBlobCacheMutex);
+    std::unique_lock<std::shared_mutex> lock(mCacheMutex);
+    replayRecordedGets();
+
     CacheEntry newEntry;
-    newEntry.first  = std::move(value);
+    newEntry.first  = std::make_shared<angle::MemoryBuffer>(std::move(value));
     newEntry.second = source;
 
     // Cache it inside blob cache only if caching inside the application is not possible.
-    mBlobCache.put(key, std::move(newEntry), newEntry.first.size());
+    const size_t entrySize = newEntry.first->size();
+    mBlobCache.put(key, std::move(newEntry), entrySize);
 }
 
 bool BlobCache::get(angle::ScratchBuffer *scratchBuffer,
@@ -111,14 +120,15 @@ bool BlobCache::get(angle::ScratchBuffer *scratchBuffer,
         return true;
     }
 
-    std::scoped_lock<angle::SimpleMutex> lock(mBlobCacheMutex);
     // Otherwise we are doing caching internally, so try to find it there
+    std::shared_lock<std::shared_mutex> lock(mCacheMutex);
     const CacheEntry *entry;
-    bool result = mBlobCache.get(key, &entry);
+    bool result = mBlobCache.peek(key, &entry);
 
     if (result)
     {
-        *valueOut = BlobCache::Value(entry->first.data(), entry->first.size());
+        recordGet(key);
+        *valueOut = BlobCache::Value(entry->first->data(), entry->first->size());
     }
 
     return result;
@@ -126,12 +136,14 @@ bool BlobCache::get(angle::ScratchBuffer *scratchBuffer,
 
 bool BlobCache::getAt(size_t index, const BlobCache::Key **keyOut, BlobCache::Value *valueOut)
 {
-    std::scoped_lock<angle::SimpleMutex> lock(mBlobCacheMutex);
+    std::unique_lock<std::shared_mutex> lock(mCacheMutex);
+    replayRecordedGets();
+
     const CacheEntry *valueBuf;
     bool result = mBlobCache.getAt(index, keyOut, &valueBuf);
     if (result)
     {
-        *valueOut = BlobCache::Value(valueBuf->first.data(), valueBuf->first.size());
+        *valueOut = BlobCache::Value(valueBuf->first->data(), valueBuf->first->size());
     }
     return result;
 }
@@ -144,46 +156,209 @@ BlobCache::GetAndDecompressResult BlobCache::getAndDecompress(
 {
     ASSERT(uncompressedValueOut);
 
+    // Hold a reference to a blob found in this object's cache, so it can be decompressed without
+    // any lock even if it is evicted in the meantime.
+    std::shared_ptr<angle::MemoryBuffer> blob;
     Value compressedValue;
-    if (!get(scratchBuffer, key, &compressedValue))
+    if (areBlobCacheFuncsSet())
     {
-        return GetAndDecompressResult::NotFound;
+        if (!get(scratchBuffer, key, &compressedValue))
+        {
+            return GetAndDecompressResult::NotFound;
+        }
+    }
+    else
+    {
+        if (!findEntry(key, &blob))
+        {
+            return GetAndDecompressResult::NotFound;
+        }
+        compressedValue = Value(blob->data(), blob->size());
     }
 
+    if (!angle::DecompressBlob(compressedValue.data(), compressedValue.size(),
+                               maxUncompressedDataSize, uncompressedValueOut))
     {
-        // This needs to be locked because `DecompressBlob` is reading shared memory from
-        // `compressedValue.data()`.
+        return GetAndDecompressResult::DecompressFailure;
+    }
+
+    return GetAndDecompressResult::Success;
+}
+
+BlobCache::GetAndDecompressResult BlobCache::getUncompressed(const BlobCache::Key &key,
+                                                             size_t maxUncompressedDataSize,
+                                                             UncompressedValue *valueOut)
+{
+    ASSERT(valueOut);
+
+    Value blob;
+    if (areBlobCacheFuncsSet())
+    {
+        // Read the blob straight into |storage|, so a stored blob needs no further copy.
         std::scoped_lock<angle::SimpleMutex> lock(mBlobCacheMutex);
-        if (!angle::DecompressBlob(compressedValue.data(), compressedValue.size(),
-                                   maxUncompressedDataSize, uncompressedValueOut))
+        EGLsizeiANDROID valueSize = mGetBlobFunc(key.data(), key.size(), nullptr, 0);
+        if (valueSize <= 0)
+        {
+            return GetAndDecompressResult::NotFound;
+        }
+
+        if (!valueOut->storage.resize(valueSize))
+        {
+            ERR() << "Failed to allocate memory for binary blob";
+            return GetAndDecompressResult::NotFound;
+        }
+
+        if (mGetBlobFunc(key.data(), key.size(), valueOut->storage.data(), valueSize) !=
+            valueSize)
+        {
+            WARN() << "Binary blob no longer available in cache (removed by a thread?)";
+            return GetAndDecompressResult::NotFound;
+        }
+
+        blob = Value(valueOut->storage.data(), valueOut->storage.size());
+    }
+    else
+    {
+        std::shared_ptr<angle::MemoryBuffer> entry;
+        if (!findEntry(key, &entry))
+        {
+            return GetAndDecompressResult::NotFound;
+        }
+
+        valueOut->entry = std::move(entry);
+        blob            = Value(valueOut->entry->data(), valueOut->entry->size());
+    }
+
+    const uint8_t *uncompressedData = nullptr;
+    size_t uncompressedSize         = 0;
+    if (angle::GetUncompressedBlobData(blob.data(), blob.size(), &uncompressedData,
+                                       &uncompressedSize))
+    {
+        if (uncompressedSize > maxUncompressedDataSize)
         {
             return GetAndDecompressResult::DecompressFailure;
         }
+        valueOut->value = Value(uncompressedData, uncompressedSize);
+        return GetAndDecompressResult::Success;
     }
 
+    // The blob is held by |valueOut|, so it can be decompressed without the lock.
+    angle::MemoryBuffer uncompressed;
+    if (!angle::DecompressBlob(blob.data(), blob.size(), maxUncompressedDataSize, &uncompressed))
+    {
+        return GetAndDecompressResult::DecompressFailure;
+    }
+
+    valueOut->storage = std::move(uncompressed);
+    valueOut->entry.reset();
+    valueOut->value = Value(valueOut->storage.data(), valueOut->storage.size());
     return GetAndDecompressResult::Success;
 }
 
 void BlobCache::remove(const BlobCache::Key &key)
 {
-    std::scoped_lock<angle::SimpleMutex> lock(mBlobCacheMutex);
+    std::unique_lock<std::shared_mutex> lock(mCacheMutex);
+    replayRecordedGets();
     mBlobCache.eraseByKey(key);
 }
 
+void BlobCache::clear()
+{
+    std::unique_lock<std::shared_mutex> lock(mCacheMutex);
+    mRecordedGetCount = 0;
+    mBlobCache.clear();
+}
+
+void BlobCache::resize(size_t maxCacheSizeBytes)
+{
+    std::unique_lock<std::shared_mutex> lock(mCacheMutex);
+    mRecordedGetCount = 0;
+    mBlobCache.resize(maxCacheSizeBytes);
+}
+
+size_t BlobCache::entryCount() const
+{
+    std::shared_lock<std::shared_mutex> lock(mCacheMutex);
+    return mBlobCache.entryCount();
+}
+
+size_t BlobCache::trim(size_t limit)
+{
+    std::unique_lock<std::shared_mutex> lock(mCacheMutex);
+    replayRecordedGets();
+    return mBlobCache.shrinkToSize(limit);
+}
+
+size_t BlobCache::size() const
+{
+    std::shared_lock<std::shared_mutex> lock(mCacheMutex);
+    return mBlobCache.size();
+}
+
+bool BlobCache::empty() const
+{
+    std::shared_lock<std::shared_mutex> lock(mCacheMutex);
+    return mBlobCache.empty();
+}
+
+size_t BlobCache::maxSize() const
+{
+    std::shared_lock<std::shared_mutex> lock(mCacheMutex);
+    return mBlobCache.maxSize();
+}
+
 void BlobCache::setBlobCacheFuncs(EGLSetBlobFuncANDROID set, EGLGetBlobFuncANDROID get)
 {
     std::scoped_lock<angle::SimpleMutex> lock(mBlobCacheMutex);
+    // Either none or both of the callbacks should be set.
+    ASSERT((set != nullptr) == (get != nullptr));
+
     mSetBlobFunc = set;
     mGetBlobFunc = get;
+    mBlobCacheFuncsSet.store(set != nullptr && get != nullptr, std::memory_order_release);
 }
 
 bool BlobCache::areBlobCacheFuncsSet() const
 {
-    std::scoped_lock<angle::SimpleMutex> lock(mBlobCacheMutex);
-    // Either none or both of the callbacks should be set.
-    ASSERT((mSetBlobFunc != nullptr) == (mGetBlobFunc != nullptr));
+    return mBlobCacheFuncsSet.load(std::memory_order_acquire);
+}
+
+bool BlobCache::findEntry(const BlobCache::Key &key,
+                          std::shared_ptr<angle::MemoryBuffer> *blobOut) const
+{
+    std::shared_lock<std::shared_mutex> lock(mCacheMutex);
+    const CacheEntry *entry;
+    if (!mBlobCache.peek(key, &entry))
+    {
+        return false;
+    }
 
-    return mSetBlobFunc != nullptr && mGetBlobFunc != nullptr;
+    recordGet(key);
+    *blobOut = entry->first;
+    return true;
+}
+
+void BlobCache::recordGet(const BlobCache::Key &key) const
+{
+    // Each lookup claims its own slot, and the slots are only read with the exclusive lock held.
+    const size_t index = mRecordedGetCount.fetch_add(1, std::memory_order_relaxed);
+    if (index < kMaxRecordedGets)
+    {
+        mRecordedGets[index] = key;
+    }
+}
+
+void BlobCache::replayRecordedGets()
+{
+    const size_t count = std::min(mRecordedGetCount.load(std::memory_order_relaxed),
+                                  kMaxRecordedGets);
+    for (size_t index = 0; index < count; ++index)
+    {
+        // The blob may have been removed since.
+        const CacheEntry *entry;
+        mBlobCache.get(mRecordedGets[index], &entry);
+    }
+    mRecordedGetCount.store(0, std::memory_order_relaxed);
 }
 
 }  // namespace egl
@@ -11,7 +11,10 @@
 #define LIBANGLE_BLOB_CACHE_H_
 
 #include <array>
+#include <atomic>
 #include <cstring>
+#include <memory>
+#include <shared_mutex>
 
 #include "common/SimpleMutex.h"
 #include "libANGLE/Error.h"
@@ -97,29 +100,44 @@ class BlobCache final : angle::NonCopyable
         size_t maxUncompressedDataSize,
         angle::MemoryBuffer *uncompressedValueOut);
 
+    // The uncompressed contents of a blob.  Blobs stored with BlobCompressionCodec::Uncompressed
+    // are referenced in place, either in |entry| when found in this object's cache or in |storage|
+    // when read from the application's cache.  Other blobs are decompressed into |storage|.
+    struct UncompressedValue
+    {
+        Value value;
+        angle::MemoryBuffer storage;
+        std::shared_ptr<const angle::MemoryBuffer> entry;
+    };
+    // Like getAndDecompress, but avoids copying blobs that were stored uncompressed.  The blob
+    // stays valid as long as |valueOut|, even if it is evicted from the cache in the meantime.
+    [[nodiscard]] GetAndDecompressResult getUncompressed(const BlobCache::Key &key,
+                                                         size_t maxUncompressedDataSize,
+                                                         UncompressedValue *valueOut);
+
     // Evict a blob from the binary cache.
     void remove(const BlobCache::Key &key);
 
     // Empty the cache.
-    void clear() { mBlobCache.clear(); }
+    void clear();
 
     // Resize the cache. Discards current contents.
-    void resize(size_t maxCacheSizeBytes) { mBlobCache.resize(maxCacheSizeBytes); }
+    void resize(size_t maxCacheSizeBytes);
 
     // Returns the number of entries in the cache.
-    size_t entryCount() const { return mBlobCache.entryCount(); }
+    size_t entryCount() const;
 
     // Reduces the current cache size and returns the number of bytes freed.
-    size_t trim(size_t limit) { return mBlobCache.shrinkToSize(limit); }
+    size_t trim(size_t limit);
 
     // Returns the current cache size in bytes.
-    size_t size() const { return mBlobCache.size(); }
+    size_t size() const;
 
     // Returns whether the cache is empty
-    bool empty() const { return mBlobCache.empty(); }
+    bool empty() const;
 
     // Returns the maximum cache size in bytes.
-    size_t maxSize() const { return mBlobCache.maxSize(); }
+    size_t maxSize() const;
 
     void setBlobCacheFuncs(EGLSetBlobFuncANDROID set, EGLGetBlobFuncANDROID get);
 
@@ -127,17 +145,47 @@ class BlobCache final : angle::NonCopyable
 
     bool isCachingEnabled() const { return areBlobCacheFuncsSet() || maxSize() > 0; }
 
+    // Serializes calls into the application's cache callbacks.  Lookups in this object's cache
+    // don't take this lock.
     angle::SimpleMutex &getMutex() { return mBlobCacheMutex; }
 
+    // The codec used by compressAndPut and by users that compress blobs themselves before calling
+    // put().  Blobs compressed with any codec can be read back regardless of this setting.
+    void setCompressionCodec(angle::BlobCompressionCodec codec) { mCompressionCodec = codec; }
+    angle::BlobCompressionCodec getCompressionCodec() const { return mCompressionCodec; }
+
   private:
-    // This internal cache is used only if the application is not providing caching callbacks
-    using CacheEntry = std::pair<angle::MemoryBuffer, CacheSource>;
+    // This internal cache is used only if the application is not providing caching callbacks.
+    // Blobs are shared so that getUncompressed can hand them out without holding the lock.
+    using CacheEntry = std::pair<std::shared_ptr<angle::MemoryBuffer>, CacheSource>;
+
+    // Looks up a blob in this object's cache, holding only a shared lock.
+    bool findEntry(const BlobCache::Key &key, std::shared_ptr<angle::MemoryBuffer> *blobOut) const;
+
+    // Lookups only take a shared lock on |mBlobCache|, so they can't make the blob they find the
+    // most recently used.  Instead, they record the key, and the recorded lookups are replayed in
+    // order the next time the cache is modified, which keeps the eviction order of SizedMRUCache.
+    // Lookups beyond the capacity of the record in between two modifications are not replayed.
+    static constexpr size_t kMaxRecordedGets = 256;
+    void recordGet(const BlobCache::Key &key) const;
+    // Must be called with |mCacheMutex| exclusively locked.
+    void replayRecordedGets();
 
     mutable angle::SimpleMutex mBlobCacheMutex;
+
+    // Guards |mBlobCache|.  Lookups take a shared lock, modifications an exclusive one.
+    mutable std::shared_mutex mCacheMutex;
     angle::SizedMRUCache<BlobCache::Key, CacheEntry> mBlobCache;
 
+    mutable std::array<BlobCache::Key, kMaxRecordedGets> mRecordedGets;
+    mutable std::atomic<size_t> mRecordedGetCount;
+
     EGLSetBlobFuncANDROID mSetBlobFunc;
     EGLGetBlobFuncANDROID mGetBlobFunc;
+    // Whether the callbacks above are set, checked on every lookup without taking a lock.
+    std::atomic<bool> mBlobCacheFuncsSet;
+
+    angle::BlobCompressionCodec mCompressionCodec;
 };
 
 }  // namespace egl
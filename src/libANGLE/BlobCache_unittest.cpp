@@ -7,6 +7,8 @@
 
 #include <gtest/gtest.h>
 
+#include <thread>
+
 #include "libANGLE/BlobCache.h"
 
 namespace egl
@@ -127,4 +129,197 @@ TEST(BlobCacheTest, OversizeValue)
     EXPECT_FALSE(blobCache.get(nullptr, MakeKey(5), &qvalue));
 }
 
+// Tests that looking up a blob makes it the most recently used, so it outlives older blobs.
+TEST(BlobCacheTest, GetRefreshesEntry)
+{
+    constexpr size_t kSize = 4;
+    BlobCache blobCache(kSize);
+
+    for (uint8_t value = 0; value < kSize; ++value)
+    {
+        blobCache.populate(MakeKey(value), MakeBlob(1, value));
+    }
+
+    Blob qvalue;
+    EXPECT_TRUE(blobCache.get(nullptr, MakeKey(0), &qvalue));
+    EXPECT_TRUE(blobCache.get(nullptr, MakeKey(1), &qvalue));
+
+    // The blobs that were not looked up are evicted first.
+    blobCache.populate(MakeKey(kSize), MakeBlob(1, kSize));
+    blobCache.populate(MakeKey(kSize + 1), MakeBlob(1, kSize + 1));
+
+    EXPECT_TRUE(blobCache.get(nullptr, MakeKey(0), &qvalue));
+    EXPECT_TRUE(blobCache.get(nullptr, MakeKey(1), &qvalue));
+    EXPECT_FALSE(blobCache.get(nullptr, MakeKey(2), &qvalue));
+    EXPECT_FALSE(blobCache.get(nullptr, MakeKey(3), &qvalue));
+}
+
+// Tests looking up blobs from many threads while another thread adds blobs.
+TEST(BlobCacheTest, ConcurrentGets)
+{
+    constexpr size_t kBlobSize    = 64;
+    constexpr size_t kBlobCount   = 16;
+    constexpr size_t kThreadCount = 8;
+    BlobCache blobCache(1024 * 1024);
+    blobCache.setCompressionCodec(angle::BlobCompressionCodec::Uncompressed);
+
+    for (uint8_t value = 0; value < kBlobCount; ++value)
+    {
+        ASSERT_TRUE(blobCache.compressAndPut(MakeKey(value), MakeBlob(kBlobSize, value), nullptr));
+    }
+
+    std::vector<std::thread> threads;
+    for (size_t threadIndex = 0; threadIndex < kThreadCount; ++threadIndex)
+    {
+        threads.emplace_back([&blobCache, threadIndex]() {
+            for (size_t iteration = 0; iteration < 1000; ++iteration)
+            {
+                const uint8_t value = static_cast<uint8_t>(iteration % kBlobCount);
+                if (threadIndex == 0)
+                {
+                    EXPECT_TRUE(blobCache.compressAndPut(MakeKey(value + kBlobCount),
+                                                         MakeBlob(kBlobSize, value), nullptr));
+                    continue;
+                }
+
+                BlobCache::UncompressedValue uncompressed;
+                ASSERT_EQ(BlobCache::GetAndDecompressResult::Success,
+                          blobCache.getUncompressed(MakeKey(value), kBlobSize, &uncompressed));
+                ASSERT_NE(0u, uncompressed.value.size());
+                EXPECT_EQ(value, uncompressed.value[0]);
+            }
+        });
+    }
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(kBlobCount * 2, blobCache.entryCount());
+}
+
+// Tests that blobs round-trip through compressAndPut and getAndDecompress with every codec, and
+// that blobs stay readable after the codec is changed.
+TEST(BlobCacheTest, CompressionCodecs)
+{
+    constexpr size_t kSize     = 64 * 1024;
+    constexpr size_t kBlobSize = 4096;
+    BlobCache blobCache(kSize);
+
+    constexpr angle::BlobCompressionCodec kCodecs[] = {
+        angle::BlobCompressionCodec::Gzip,
+        angle::BlobCompressionCodec::Lz4,
+        angle::BlobCompressionCodec::DeflateBest,
+    };
+
+    for (uint8_t index = 0; index < ArraySize(kCodecs); ++index)
+    {
+        blobCache.setCompressionCodec(kCodecs[index]);
+
+        size_t compressedSize = 0;
+        EXPECT_TRUE(blobCache.compressAndPut(MakeKey(index), MakeBlob(kBlobSize, index),
+                                             &compressedSize));
+        EXPECT_LT(compressedSize, kBlobSize);
+
+        Blob compressed;
+        ASSERT_TRUE(blobCache.get(nullptr, MakeKey(index), &compressed));
+        EXPECT_EQ(kCodecs[index],
+                  angle::GetBlobCompressionCodec(compressed.data(), compressed.size()));
+    }
+
+    // Read everything back with a codec different from the one each blob was written with.
+    blobCache.setCompressionCodec(angle::BlobCompressionCodec::Lz4);
+    for (uint8_t index = 0; index < ArraySize(kCodecs); ++index)
+    {
+        angle::MemoryBuffer uncompressed;
+        EXPECT_EQ(BlobCache::GetAndDecompressResult::Success,
+                  blobCache.getAndDecompress(nullptr, MakeKey(index), kBlobSize, &uncompressed));
+
+        BlobPut expected = MakeBlob(kBlobSize, index);
+        ASSERT_EQ(expected.size(), uncompressed.size());
+        EXPECT_EQ(0, memcmp(expected.data(), uncompressed.data(), expected.size()));
+    }
+}
+
+// Tests that corrupted tagged blobs are rejected rather than decoded.
+TEST(BlobCacheTest, CorruptCompressedValue)
+{
+    constexpr size_t kSize     = 64 * 1024;
+    constexpr size_t kBlobSize = 4096;
+    BlobCache blobCache(kSize);
+
+    blobCache.setCompressionCodec(angle::BlobCompressionCodec::Lz4);
+    BlobPut blob = MakeBlob(kBlobSize);
+    angle::MemoryBuffer compressed;
+    ASSERT_TRUE(angle::CompressBlob(blob.size(), blob.data(), &compressed,
+                                    angle::BlobCompressionCodec::Lz4));
+
+    // Truncate the payload.
+    compressed.trim(compressed.size() - 1);
+    blobCache.populate(MakeKey(0), std::move(compressed));
+
+    angle::MemoryBuffer uncompressed;
+    EXPECT_EQ(BlobCache::GetAndDecompressResult::DecompressFailure,
+              blobCache.getAndDecompress(nullptr, MakeKey(0), kBlobSize, &uncompressed));
+
+    // A blob whose recorded size exceeds the limit must be rejected too.
+    angle::MemoryBuffer oversized;
+    ASSERT_TRUE(angle::CompressBlob(blob.size(), blob.data(), &oversized,
+                                    angle::BlobCompressionCodec::DeflateBest));
+    blobCache.populate(MakeKey(1), std::move(oversized));
+    EXPECT_EQ(BlobCache::GetAndDecompressResult::DecompressFailure,
+              blobCache.getAndDecompress(nullptr, MakeKey(1), kBlobSize - 1, &uncompressed));
+}
+
+// Tests that getUncompressed returns uncompressed blobs in place, keeps them alive after they are
+// evicted, and still decompresses blobs written with other codecs.
+TEST(BlobCacheTest, GetUncompressedInPlace)
+{
+    constexpr size_t kBlobSize = 4096;
+    constexpr size_t kSize     = 2 * kBlobSize;
+    BlobCache blobCache(kSize);
+
+    blobCache.setCompressionCodec(angle::BlobCompressionCodec::Uncompressed);
+    ASSERT_TRUE(blobCache.compressAndPut(MakeKey(0), MakeBlob(kBlobSize, 0), nullptr));
+    blobCache.setCompressionCodec(angle::BlobCompressionCodec::Lz4);
+    ASSERT_TRUE(blobCache.compressAndPut(MakeKey(1), MakeBlob(kBlobSize, 1), nullptr));
+
+    Blob stored;
+    ASSERT_TRUE(blobCache.get(nullptr, MakeKey(0), &stored));
+    EXPECT_EQ(angle::BlobCompressionCodec::Uncompressed,
+              angle::GetBlobCompressionCodec(stored.data(), stored.size()));
+
+    BlobCache::UncompressedValue inPlace;
+    ASSERT_EQ(BlobCache::GetAndDecompressResult::Success,
+              blobCache.getUncompressed(MakeKey(0), kBlobSize, &inPlace));
+    EXPECT_GT(inPlace.value.data(), stored.data());
+    EXPECT_LT(inPlace.value.data(), stored.data() + stored.size());
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(inPlace.value.data()) % 16);
+    EXPECT_TRUE(inPlace.storage.empty());
+
+    BlobCache::UncompressedValue decompressed;
+    ASSERT_EQ(BlobCache::GetAndDecompressResult::Success,
+              blobCache.getUncompressed(MakeKey(1), kBlobSize, &decompressed));
+    EXPECT_EQ(decompressed.storage.data(), decompressed.value.data());
+
+    // Evicting the stored blob must not free the memory |inPlace| points to.
+    blobCache.remove(MakeKey(0));
+    BlobPut expected = MakeBlob(kBlobSize, 0);
+    ASSERT_EQ(expected.size(), inPlace.value.size());
+    EXPECT_EQ(0, memcmp(expected.data(), inPlace.value.data(), expected.size()));
+
+    expected = MakeBlob(kBlobSize, 1);
+    ASSERT_EQ(expected.size(), decompressed.value.size());
+    EXPECT_EQ(0, memcmp(expected.data(), decompressed.value.data(), expected.size()));
+
+    // Blobs larger than allowed are rejected without being copied.
+    blobCache.setCompressionCodec(angle::BlobCompressionCodec::Uncompressed);
+    ASSERT_TRUE(blobCache.compressAndPut(MakeKey(2), MakeBlob(kBlobSize, 2), nullptr));
+    BlobCache::UncompressedValue oversized;
+    EXPECT_EQ(BlobCache::GetAndDecompressResult::DecompressFailure,
+              blobCache.getUncompressed(MakeKey(2), kBlobSize - 1, &oversized));
+    EXPECT_EQ(BlobCache::GetAndDecompressResult::NotFound,
+              blobCache.getUncompressed(MakeKey(3), kBlobSize, &oversized));
+}
+
 }  // namespace egl
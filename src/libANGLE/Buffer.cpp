@@ -368,8 +368,24 @@ angle::Result Buffer::getIndexRange(const gl::Context *context,
         return angle::Result::Continue;
     }
 
-    ANGLE_TRY(
-        mImpl->getIndexRange(context, type, offset, count, primitiveRestartEnabled, outRange));
+    // Large queries go through the block summaries so that only the parts of the buffer modified
+    // since the last query are scanned.
+    std::vector<IndexRangeSpan> spans;
+    if (mIndexRangeCache.beginBlockQuery(type, offset, count, primitiveRestartEnabled,
+                                         static_cast<size_t>(mState.mSize), &spans))
+    {
+        if (!spans.empty())
+        {
+            ANGLE_TRY(mImpl->getIndexRanges(context, type, primitiveRestartEnabled, &spans));
+        }
+        *outRange =
+            mIndexRangeCache.endBlockQuery(type, offset, count, primitiveRestartEnabled, spans);
+    }
+    else
+    {
+        ANGLE_TRY(
+            mImpl->getIndexRange(context, type, offset, count, primitiveRestartEnabled, outRange));
+    }
 
     mIndexRangeCache.addRange(type, offset, count, primitiveRestartEnabled, *outRange);
 
@@ -30,7 +30,8 @@ Compiler::Compiler(rx::GLImplFactory *implFactory, const State &state, egl::Disp
     : mImplementation(implFactory->createCompiler()),
       mSpec(SelectShaderSpec(state)),
       mOutputType(mImplementation->getTranslatorOutputType()),
-      mResources()
+      mResources(),
+      mTranslatorCache(display->getTranslatorCache())
 {
     // TODO(http://anglebug.com/3819): Update for GL version specific validation
     ASSERT(state.getClientMajorVersion() == 1 || state.getClientMajorVersion() == 2 ||
@@ -300,6 +301,7 @@ ShCompilerInstance Compiler::getInstance(ShaderType type)
     {
         ShHandle handle = sh::ConstructCompiler(ToGLenum(type), mSpec, mOutputType, &mResources);
         ASSERT(handle);
+        sh::SetTranslatorCache(handle, mTranslatorCache);
         return ShCompilerInstance(handle, mOutputType, type);
     }
     else
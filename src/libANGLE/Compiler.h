@@ -48,6 +48,8 @@ class Compiler final : public RefCountObjectNoID
     ShShaderSpec mSpec;
     ShShaderOutput mOutputType;
     ShBuiltInResources mResources;
+    // Shared by the compilers of all contexts of the display.
+    sh::TranslatorCache *mTranslatorCache;
     ShaderMap<std::vector<ShCompilerInstance>> mPools;
 };
 
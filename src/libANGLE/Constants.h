@@ -19,6 +19,10 @@ namespace gl
 // The binary cache is currently left disable by default, and the application can enable it.
 const size_t kDefaultMaxProgramCacheMemoryBytes = 0;
 
+// Translator output is cached in memory so shaders compiled by several contexts are only
+// translated once.
+const size_t kDefaultMaxTranslatorCacheMemoryBytes = 4 * 1024 * 1024;
+
 enum
 {
     // Implementation upper limits, real maximums depend on the hardware
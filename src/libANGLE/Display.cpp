@@ -949,6 +949,7 @@ Display::Display(EGLenum platform, EGLNativeDisplayType displayId, Device *eglDe
       mBlobCache(gl::kDefaultMaxProgramCacheMemoryBytes),
       mMemoryProgramCache(mBlobCache),
       mMemoryShaderCache(mBlobCache),
+      mTranslatorCache(sh::CreateTranslatorCache(gl::kDefaultMaxTranslatorCacheMemoryBytes)),
       mGlobalTextureShareGroupUsers(0),
       mGlobalSemaphoreShareGroupUsers(0),
       mTerminatedByApi(false)
@@ -999,6 +1000,7 @@ Display::~Display()
 
     SafeDelete(mDevice);
     SafeDelete(mImplementation);
+    sh::DestroyTranslatorCache(mTranslatorCache);
 }
 
 void Display::setLabel(EGLLabelKHR label)
@@ -1121,6 +1123,23 @@ Error Display::initialize()
     mFrontendFeatures.populateFeatureList(&mFeatures);
     mImplementation->populateFeatureList(&mFeatures);
 
+    if (mFrontendFeatures.disableBlobCacheCompression.enabled)
+    {
+        mBlobCache.setCompressionCodec(angle::BlobCompressionCodec::Uncompressed);
+    }
+    else if (mFrontendFeatures.useLz4BlobCacheCompression.enabled)
+    {
+        mBlobCache.setCompressionCodec(angle::BlobCompressionCodec::Lz4);
+    }
+    else if (mFrontendFeatures.useDeflateBestBlobCacheCompression.enabled)
+    {
+        mBlobCache.setCompressionCodec(angle::BlobCompressionCodec::DeflateBest);
+    }
+    else
+    {
+        mBlobCache.setCompressionCodec(angle::BlobCompressionCodec::Gzip);
+    }
+
     initDisplayExtensions();
     initVendorString();
     initVersionString();
@@ -286,6 +286,7 @@ class Display final : public LabeledObject,
     angle::SimpleMutex &getProgramCacheMutex() { return mProgramCacheMutex; }
 
     gl::MemoryShaderCache *getMemoryShaderCache() { return &mMemoryShaderCache; }
+    sh::TranslatorCache *getTranslatorCache() { return mTranslatorCache; }
 
     // Installs LoggingAnnotator as the global DebugAnnotator, for back-ends that do not implement
     // their own DebugAnnotator.
@@ -407,6 +408,7 @@ class Display final : public LabeledObject,
     BlobCache mBlobCache;
     gl::MemoryProgramCache mMemoryProgramCache;
     gl::MemoryShaderCache mMemoryShaderCache;
+    sh::TranslatorCache *mTranslatorCache;
     size_t mGlobalTextureShareGroupUsers;
     size_t mGlobalSemaphoreShareGroupUsers;
 
@@ -96,20 +96,31 @@ void HandleAllocator::release(GLuint handle)
         WARN() << "HandleAllocator::release releasing " << handle << std::endl;
     }
 
-    // Try consolidating the ranges first.
-    for (HandleRange &handleRange : mUnallocatedList)
-    {
-        if (handleRange.begin - 1 == handle)
-        {
-            handleRange.begin--;
-            return;
-        }
+    // Try consolidating the ranges first.  The unallocated ranges are sorted and disjoint, so only
+    // the ranges on either side of the handle can be extended, found in logarithmic time.
+    auto nextIt = std::lower_bound(mUnallocatedList.begin(), mUnallocatedList.end(), handle,
+                                   HandleRangeComparator());
+    ASSERT(nextIt == mUnallocatedList.end() || nextIt->begin > handle);
 
-        if (handleRange.end == handle - 1)
-        {
-            handleRange.end++;
-            return;
-        }
+    const bool extendsNext = nextIt != mUnallocatedList.end() && nextIt->begin - 1 == handle;
+    const bool extendsPrev = nextIt != mUnallocatedList.begin() && (nextIt - 1)->end == handle - 1;
+
+    if (extendsPrev && extendsNext)
+    {
+        // The handle bridges the two ranges, merge them.
+        (nextIt - 1)->end = nextIt->end;
+        mUnallocatedList.erase(nextIt);
+        return;
+    }
+    if (extendsPrev)
+    {
+        (nextIt - 1)->end++;
+        return;
+    }
+    if (extendsNext)
+    {
+        nextIt->begin--;
+        return;
     }
 
     // Add to released list, logarithmic time for push_heap.
@@ -124,23 +135,19 @@ void HandleAllocator::reserve(GLuint handle)
         WARN() << "HandleAllocator::reserve reserving " << handle << std::endl;
     }
 
-    // Clear from released list -- might be a slow operation.
-    if (!mReleasedList.empty())
-    {
-        auto releasedIt = std::find(mReleasedList.begin(), mReleasedList.end(), handle);
-        if (releasedIt != mReleasedList.end())
-        {
-            mReleasedList.erase(releasedIt);
-            std::make_heap(mReleasedList.begin(), mReleasedList.end(), std::greater<GLuint>());
-            return;
-        }
-    }
-
-    // Not in released list, reserve in the unallocated list.
+    // Look in the unallocated list first, which takes logarithmic time.
     auto boundIt = std::lower_bound(mUnallocatedList.begin(), mUnallocatedList.end(), handle,
                                     HandleRangeComparator());
 
-    ASSERT(boundIt != mUnallocatedList.end());
+    if (boundIt == mUnallocatedList.end() || boundIt->begin > handle)
+    {
+        // Not in the unallocated list, clear from released list -- might be a slow operation.
+        auto releasedIt = std::find(mReleasedList.begin(), mReleasedList.end(), handle);
+        ASSERT(releasedIt != mReleasedList.end());
+        mReleasedList.erase(releasedIt);
+        std::make_heap(mReleasedList.begin(), mReleasedList.end(), std::greater<GLuint>());
+        return;
+    }
 
     GLuint begin = boundIt->begin;
     GLuint end   = boundIt->end;
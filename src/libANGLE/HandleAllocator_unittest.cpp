@@ -240,4 +240,43 @@ TEST(HandleAllocatorTest, ConsolidateRangeDuringRelease)
     EXPECT_NE(handle, static_cast<GLuint>(-1));
 }
 
+// Tests that releasing handles between reserved ranges, in any order, merges them back so that
+// every handle can be reserved and allocated again.
+TEST(HandleAllocatorTest, ReleaseBetweenRanges)
+{
+    gl::HandleAllocator allocator;
+
+    constexpr GLuint kHandleCount = 64;
+    for (GLuint handle = 2; handle <= kHandleCount; handle += 2)
+    {
+        allocator.reserve(handle);
+    }
+    for (GLuint handle = 1; handle <= kHandleCount; handle += 2)
+    {
+        EXPECT_EQ(handle, allocator.allocate());
+    }
+
+    std::vector<GLuint> handles;
+    for (GLuint handle = 1; handle <= kHandleCount; ++handle)
+    {
+        handles.push_back(handle);
+    }
+    std::reverse(handles.begin() + kHandleCount / 2, handles.end());
+    for (GLuint handle : handles)
+    {
+        allocator.release(handle);
+    }
+
+    allocator.reserve(kHandleCount / 2);
+    std::set<GLuint> allocatedList = {kHandleCount / 2};
+    for (GLuint allocationNum = 1; allocationNum < kHandleCount; ++allocationNum)
+    {
+        GLuint handle = allocator.allocate();
+        EXPECT_EQ(0u, allocatedList.count(handle));
+        allocatedList.insert(handle);
+    }
+    EXPECT_EQ(1u, *allocatedList.begin());
+    EXPECT_EQ(kHandleCount, *allocatedList.rbegin());
+}
+
 }  // anonymous namespace
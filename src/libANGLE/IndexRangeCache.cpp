@@ -12,10 +12,12 @@
 #include "common/debug.h"
 #include "libANGLE/formatutils.h"
 
+#include <algorithm>
+
 namespace gl
 {
 
-IndexRangeCache::IndexRangeCache() {}
+IndexRangeCache::IndexRangeCache() : mBufferSize(0), mBlockSize(0), mBlockCount(0) {}
 
 IndexRangeCache::~IndexRangeCache() {}
 
@@ -53,8 +55,141 @@ bool IndexRangeCache::findRange(DrawElementsType type,
     }
 }
 
+bool IndexRangeCache::beginBlockQuery(DrawElementsType type,
+                                      size_t offset,
+                                      size_t count,
+                                      bool primitiveRestartEnabled,
+                                      size_t bufferSize,
+                                      std::vector<IndexRangeSpan> *spansOut)
+{
+    ASSERT(spansOut->empty());
+
+    if (bufferSize != mBufferSize)
+    {
+        // Lay out the blocks for the current size of the buffer.  Any summaries made for another
+        // size are stale.
+        for (std::array<BlockSummary, 2> &summaries : mBlockSummaries)
+        {
+            summaries.fill(BlockSummary());
+        }
+
+        mBufferSize = bufferSize;
+        mBlockSize  = kMinBlockSize;
+        while (mBufferSize / mBlockSize > kMaxBlockCount)
+        {
+            mBlockSize *= 2;
+        }
+        mBlockCount = mBufferSize / mBlockSize;
+    }
+
+    size_t firstBlock = 0;
+    size_t lastBlock  = 0;
+    if (!getQueryBlocks(type, offset, count, &firstBlock, &lastBlock))
+    {
+        return false;
+    }
+
+    const size_t typeSize   = GetDrawElementsTypeSize(type);
+    const size_t end        = offset + count * typeSize;
+    const size_t blocksFrom = firstBlock * mBlockSize;
+    const size_t blocksTo   = lastBlock * mBlockSize;
+
+    if (offset < blocksFrom)
+    {
+        spansOut->push_back({offset, (blocksFrom - offset) / typeSize, IndexRangeSpan::kNoBlock,
+                             IndexRange()});
+    }
+
+    const BlockSummary &summary = getBlockSummary(type, primitiveRestartEnabled);
+    if (summary.dirtyBlockCount > 0)
+    {
+        for (size_t block = firstBlock; block < lastBlock; ++block)
+        {
+            if (summary.dirtyBlocks[block])
+            {
+                spansOut->push_back(
+                    {block * mBlockSize, mBlockSize / typeSize, block, IndexRange()});
+            }
+        }
+    }
+
+    if (blocksTo < end)
+    {
+        spansOut->push_back(
+            {blocksTo, (end - blocksTo) / typeSize, IndexRangeSpan::kNoBlock, IndexRange()});
+    }
+
+    return true;
+}
+
+IndexRange IndexRangeCache::endBlockQuery(DrawElementsType type,
+                                          size_t offset,
+                                          size_t count,
+                                          bool primitiveRestartEnabled,
+                                          const std::vector<IndexRangeSpan> &spans)
+{
+    size_t firstBlock = 0;
+    size_t lastBlock  = 0;
+
+    [[maybe_unused]] bool useBlocks = getQueryBlocks(type, offset, count, &firstBlock, &lastBlock);
+    ASSERT(useBlocks);
+
+    BlockSummary &summary = getBlockSummary(type, primitiveRestartEnabled);
+
+    BlockRange result = {0, 0, 0};
+    for (const IndexRangeSpan &span : spans)
+    {
+        if (span.block == IndexRangeSpan::kNoBlock)
+        {
+            const BlockRange spanRange = {static_cast<uint32_t>(span.range.start),
+                                          static_cast<uint32_t>(span.range.end),
+                                          span.range.vertexIndexCount};
+            result                     = CombineBlockRanges(result, spanRange);
+        }
+        else
+        {
+            updateBlock(&summary, span.block, span.range);
+        }
+    }
+
+    // All the blocks of the query are clean now, and so are the nodes of the tree above them.
+    result = CombineBlockRanges(result, queryBlocks(summary, firstBlock, lastBlock));
+
+    if (result.vertexIndexCount == 0)
+    {
+        return IndexRange();
+    }
+    return IndexRange(result.start, result.end, static_cast<size_t>(result.vertexIndexCount));
+}
+
 void IndexRangeCache::invalidateRange(size_t offset, size_t size)
 {
+    if (mBlockCount > 0 && size > 0 && offset < mBufferSize)
+    {
+        const size_t firstBlock = offset / mBlockSize;
+        const size_t lastBlock =
+            std::min((offset + size + mBlockSize - 1) / mBlockSize, mBlockCount);
+
+        for (std::array<BlockSummary, 2> &summaries : mBlockSummaries)
+        {
+            for (BlockSummary &summary : summaries)
+            {
+                if (summary.tree.empty())
+                {
+                    continue;
+                }
+                for (size_t block = firstBlock; block < lastBlock; ++block)
+                {
+                    if (!summary.dirtyBlocks[block])
+                    {
+                        summary.dirtyBlocks[block] = true;
+                        ++summary.dirtyBlockCount;
+                    }
+                }
+            }
+        }
+    }
+
     size_t invalidateStart = offset;
     size_t invalidateEnd   = offset + size;
 
@@ -79,6 +214,103 @@ void IndexRangeCache::invalidateRange(size_t offset, size_t size)
 void IndexRangeCache::clear()
 {
     mIndexRangeCache.clear();
+
+    for (std::array<BlockSummary, 2> &summaries : mBlockSummaries)
+    {
+        summaries.fill(BlockSummary());
+    }
+    mBufferSize = 0;
+    mBlockSize  = 0;
+    mBlockCount = 0;
+}
+
+bool IndexRangeCache::getQueryBlocks(DrawElementsType type,
+                                     size_t offset,
+                                     size_t count,
+                                     size_t *firstBlockOut,
+                                     size_t *lastBlockOut) const
+{
+    // Misaligned queries would not line up with the indices in the blocks.
+    const size_t typeSize = GetDrawElementsTypeSize(type);
+    if (mBlockCount == 0 || offset % typeSize != 0 || offset > mBufferSize ||
+        count > (mBufferSize - offset) / typeSize)
+    {
+        return false;
+    }
+
+    const size_t end = offset + count * typeSize;
+    *firstBlockOut   = (offset + mBlockSize - 1) / mBlockSize;
+    *lastBlockOut    = std::min(end / mBlockSize, mBlockCount);
+    return *firstBlockOut < *lastBlockOut;
+}
+
+IndexRangeCache::BlockSummary &IndexRangeCache::getBlockSummary(DrawElementsType type,
+                                                                bool primitiveRestartEnabled)
+{
+    BlockSummary &summary = mBlockSummaries[type][primitiveRestartEnabled];
+    if (summary.tree.empty())
+    {
+        summary.tree.resize(2 * mBlockCount, {0, 0, 0});
+        summary.dirtyBlocks.assign(mBlockCount, true);
+        summary.dirtyBlockCount = mBlockCount;
+    }
+    return summary;
+}
+
+void IndexRangeCache::updateBlock(BlockSummary *summary, size_t block, const IndexRange &range)
+{
+    ASSERT(block < mBlockCount);
+
+    if (summary->dirtyBlocks[block])
+    {
+        summary->dirtyBlocks[block] = false;
+        --summary->dirtyBlockCount;
+    }
+
+    size_t node         = block + mBlockCount;
+    summary->tree[node] = {static_cast<uint32_t>(range.start), static_cast<uint32_t>(range.end),
+                           range.vertexIndexCount};
+    for (; node > 1; node /= 2)
+    {
+        summary->tree[node / 2] = CombineBlockRanges(summary->tree[node], summary->tree[node ^ 1]);
+    }
+}
+
+IndexRangeCache::BlockRange IndexRangeCache::queryBlocks(const BlockSummary &summary,
+                                                         size_t firstBlock,
+                                                         size_t lastBlock) const
+{
+    BlockRange result = {0, 0, 0};
+    for (size_t first = firstBlock + mBlockCount, last = lastBlock + mBlockCount; first < last;
+         first /= 2, last /= 2)
+    {
+        if (first % 2 == 1)
+        {
+            result = CombineBlockRanges(result, summary.tree[first++]);
+        }
+        if (last % 2 == 1)
+        {
+            result = CombineBlockRanges(result, summary.tree[--last]);
+        }
+    }
+    return result;
+}
+
+// static
+IndexRangeCache::BlockRange IndexRangeCache::CombineBlockRanges(const BlockRange &a,
+                                                                const BlockRange &b)
+{
+    // Ranges with no indices other than primitive restart don't contribute to the min and max.
+    if (a.vertexIndexCount == 0)
+    {
+        return b;
+    }
+    if (b.vertexIndexCount == 0)
+    {
+        return a;
+    }
+    return {std::min(a.start, b.start), std::max(a.end, b.end),
+            a.vertexIndexCount + b.vertexIndexCount};
 }
 
 IndexRangeCache::IndexRangeKey::IndexRangeKey()
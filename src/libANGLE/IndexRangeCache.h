@@ -15,10 +15,26 @@
 #include "common/angleutils.h"
 #include "common/mathutil.h"
 
+#include <limits>
 #include <map>
+#include <vector>
 
 namespace gl
 {
+// A part of an index range query that has to be computed from the buffer data.
+struct IndexRangeSpan
+{
+    // Offset in bytes and number of indices.
+    size_t offset;
+    size_t count;
+    // The block of the buffer that this span covers, or kNoBlock for the parts of a query at either
+    // end that don't cover a whole block.
+    size_t block;
+    // Filled by the backend.
+    IndexRange range;
+
+    static constexpr size_t kNoBlock = std::numeric_limits<size_t>::max();
+};
 
 class IndexRangeCache
 {
@@ -37,9 +53,33 @@ class IndexRangeCache
                    bool primitiveRestartEnabled,
                    IndexRange *outRange) const;
 
+    // Large queries are answered from per-block summaries of the buffer, so that after a partial
+    // update only the modified blocks have to be scanned again.  beginBlockQuery returns false if
+    // the query is too small to use the summaries, otherwise it fills |spansOut| with the parts of
+    // the query that need to be computed from the buffer data.  Once their ranges are filled in,
+    // endBlockQuery updates the summaries and returns the range of the whole query.
+    bool beginBlockQuery(DrawElementsType type,
+                         size_t offset,
+                         size_t count,
+                         bool primitiveRestartEnabled,
+                         size_t bufferSize,
+                         std::vector<IndexRangeSpan> *spansOut);
+    IndexRange endBlockQuery(DrawElementsType type,
+                             size_t offset,
+                             size_t count,
+                             bool primitiveRestartEnabled,
+                             const std::vector<IndexRangeSpan> &spans);
+
     void invalidateRange(size_t offset, size_t size);
     void clear();
 
+    // Blocks are at least kMinBlockSize bytes.  Larger buffers use larger blocks so that there are
+    // never more than kMaxBlockCount of them, which bounds the memory used by the summaries.
+    static constexpr size_t kMinBlockSize  = 4096;
+    static constexpr size_t kMaxBlockCount = 8192;
+
+    size_t getBlockSizeForTesting() const { return mBlockSize; }
+
   private:
     struct IndexRangeKey
     {
@@ -56,6 +96,42 @@ class IndexRangeCache
 
     typedef std::map<IndexRangeKey, IndexRange> IndexRangeMap;
     IndexRangeMap mIndexRangeCache;
+
+    // Range of a block, or of a node of the summary tree.  Kept compact as there can be many.
+    struct BlockRange
+    {
+        uint32_t start;
+        uint32_t end;
+        uint64_t vertexIndexCount;
+    };
+
+    // Segment tree over the blocks of the buffer for one index type and primitive restart state.
+    // Leaves are at [blockCount, 2 * blockCount) and node i combines nodes 2i and 2i+1.  Dirty
+    // leaves are stale, as are the nodes above them; queries recompute the dirty leaves they cover
+    // before reading the tree.
+    struct BlockSummary
+    {
+        std::vector<BlockRange> tree;
+        std::vector<bool> dirtyBlocks;
+        size_t dirtyBlockCount = 0;
+    };
+
+    bool getQueryBlocks(DrawElementsType type,
+                        size_t offset,
+                        size_t count,
+                        size_t *firstBlockOut,
+                        size_t *lastBlockOut) const;
+    BlockSummary &getBlockSummary(DrawElementsType type, bool primitiveRestartEnabled);
+    void updateBlock(BlockSummary *summary, size_t block, const IndexRange &range);
+    BlockRange queryBlocks(const BlockSummary &summary, size_t firstBlock, size_t lastBlock) const;
+
+    static BlockRange CombineBlockRanges(const BlockRange &a, const BlockRange &b);
+
+    // Set on first use of the summaries, and reset with clear().
+    size_t mBufferSize;
+    size_t mBlockSize;
+    size_t mBlockCount;
+    angle::PackedEnumMap<DrawElementsType, std::array<BlockSummary, 2>> mBlockSummaries;
 };
 
 }  // namespace gl
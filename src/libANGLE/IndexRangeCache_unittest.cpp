@@ -0,0 +1,147 @@
+//
+// Copyright 2024 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// IndexRangeCache_unittest.cpp: Unit tests for the block summaries of the index range cache.
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "common/utilities.h"
+#include "libANGLE/IndexRangeCache.h"
+#include "libANGLE/formatutils.h"
+
+namespace gl
+{
+namespace
+{
+class IndexRangeCacheTest : public testing::Test
+{
+  protected:
+    void setBufferData(size_t size)
+    {
+        mData.resize(size);
+        for (size_t offset = 0; offset < size; offset += sizeof(uint32_t))
+        {
+            const uint32_t value = mRNG();
+            memcpy(mData.data() + offset, &value, std::min(sizeof(uint32_t), size - offset));
+        }
+        mCache.clear();
+    }
+
+    void writeBytes(size_t offset, size_t size)
+    {
+        for (size_t i = 0; i < size; ++i)
+        {
+            mData[offset + i] = static_cast<uint8_t>(mRNG());
+        }
+        mCache.invalidateRange(offset, size);
+    }
+
+    // Does what gl::Buffer::getIndexRange does on a cache miss, and counts the indices scanned.
+    IndexRange query(DrawElementsType type, size_t offset, size_t count, bool restart)
+    {
+        std::vector<IndexRangeSpan> spans;
+        if (!mCache.beginBlockQuery(type, offset, count, restart, mData.size(), &spans))
+        {
+            mScannedIndices += count;
+            return ComputeIndexRange(type, mData.data() + offset, count, restart);
+        }
+
+        for (IndexRangeSpan &span : spans)
+        {
+            span.range = ComputeIndexRange(type, mData.data() + span.offset, span.count, restart);
+            mScannedIndices += span.count;
+        }
+        return mCache.endBlockQuery(type, offset, count, restart, spans);
+    }
+
+    void expectRange(DrawElementsType type, size_t offset, size_t count, bool restart)
+    {
+        const IndexRange expected = ComputeIndexRange(type, mData.data() + offset, count, restart);
+        const IndexRange actual   = query(type, offset, count, restart);
+        EXPECT_EQ(expected.start, actual.start);
+        EXPECT_EQ(expected.end, actual.end);
+        EXPECT_EQ(expected.vertexIndexCount, actual.vertexIndexCount);
+    }
+
+    std::mt19937 mRNG{0};
+    std::vector<uint8_t> mData;
+    IndexRangeCache mCache;
+    size_t mScannedIndices = 0;
+};
+
+// Tests that queries answered from the block summaries match a full scan after random updates,
+// for all index types and primitive restart states.
+TEST_F(IndexRangeCacheTest, MatchesFullScan)
+{
+    constexpr size_t kBufferSize = 37 * IndexRangeCache::kMinBlockSize + 100;
+    setBufferData(kBufferSize);
+
+    for (int iteration = 0; iteration < 200; ++iteration)
+    {
+        const size_t writeOffset = mRNG() % kBufferSize;
+        writeBytes(writeOffset, std::min<size_t>(mRNG() % 10000, kBufferSize - writeOffset));
+
+        for (DrawElementsType type : {DrawElementsType::UnsignedByte,
+                                      DrawElementsType::UnsignedShort,
+                                      DrawElementsType::UnsignedInt})
+        {
+            const size_t typeSize   = GetDrawElementsTypeSize(type);
+            const size_t maxIndices = kBufferSize / typeSize;
+            const size_t first      = mRNG() % maxIndices;
+            const size_t count      = 1 + mRNG() % (maxIndices - first);
+            const bool restart      = mRNG() % 2 == 0;
+            expectRange(type, first * typeSize, count, restart);
+        }
+    }
+}
+
+// Tests that blocks of primitive restart indices only don't affect the range.
+TEST_F(IndexRangeCacheTest, PrimitiveRestartBlocks)
+{
+    constexpr size_t kBufferSize = 8 * IndexRangeCache::kMinBlockSize;
+    setBufferData(kBufferSize);
+    std::fill(mData.begin(), mData.begin() + 3 * IndexRangeCache::kMinBlockSize, 0xFF);
+
+    expectRange(DrawElementsType::UnsignedShort, 0, kBufferSize / 2, true);
+    expectRange(DrawElementsType::UnsignedShort, 0, kBufferSize / 2, false);
+    expectRange(DrawElementsType::UnsignedInt, 0, IndexRangeCache::kMinBlockSize, true);
+}
+
+// Tests that after a small update only the modified block is scanned again.
+TEST_F(IndexRangeCacheTest, RescansOnlyModifiedBlocks)
+{
+    constexpr size_t kBufferSize = 64 * IndexRangeCache::kMinBlockSize;
+    constexpr size_t kCount      = kBufferSize / 2;
+    setBufferData(kBufferSize);
+
+    expectRange(DrawElementsType::UnsignedShort, 0, kCount, false);
+
+    mScannedIndices = 0;
+    writeBytes(10 * IndexRangeCache::kMinBlockSize + 16, 64);
+    expectRange(DrawElementsType::UnsignedShort, 0, kCount, false);
+    EXPECT_EQ(IndexRangeCache::kMinBlockSize / 2, mScannedIndices);
+
+    mScannedIndices = 0;
+    expectRange(DrawElementsType::UnsignedShort, 0, kCount, false);
+    EXPECT_EQ(0u, mScannedIndices);
+}
+
+// Tests that large buffers use larger blocks to bound the size of the summaries.
+TEST_F(IndexRangeCacheTest, BoundedBlockCount)
+{
+    constexpr size_t kBufferSize =
+        2 * IndexRangeCache::kMaxBlockCount * IndexRangeCache::kMinBlockSize;
+    setBufferData(kBufferSize);
+
+    expectRange(DrawElementsType::UnsignedInt, 0, kBufferSize / 4, false);
+    EXPECT_EQ(2 * IndexRangeCache::kMinBlockSize, mCache.getBlockSizeForTesting());
+
+    writeBytes(kBufferSize / 2, 4);
+    expectRange(DrawElementsType::UnsignedInt, 4, kBufferSize / 4 - 2, false);
+}
+}  // anonymous namespace
+}  // namespace gl
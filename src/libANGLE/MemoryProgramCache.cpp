@@ -123,9 +123,9 @@ angle::Result MemoryProgramCache::getProgram(const Context *context,
 
     ComputeHash(context, program, hashOut);
 
-    angle::MemoryBuffer uncompressedData;
-    switch (mBlobCache.getAndDecompress(context->getScratchBuffer(), *hashOut,
-                                        kMaxUncompressedProgramSize, &uncompressedData))
+    // Programs stored uncompressed are deserialized in place from the cache entry.
+    egl::BlobCache::UncompressedValue uncompressedData;
+    switch (mBlobCache.getUncompressed(*hashOut, kMaxUncompressedProgramSize, &uncompressedData))
     {
         case egl::BlobCache::GetAndDecompressResult::NotFound:
             return angle::Result::Continue;
@@ -139,8 +139,9 @@ angle::Result MemoryProgramCache::getProgram(const Context *context,
             return angle::Result::Continue;
 
         case egl::BlobCache::GetAndDecompressResult::Success:
-            ANGLE_TRY(program->loadBinary(context, uncompressedData.data(),
-                                          static_cast<int>(uncompressedData.size()), resultOut));
+            ANGLE_TRY(program->loadBinary(context, uncompressedData.value.data(),
+                                          static_cast<int>(uncompressedData.value.size()),
+                                          resultOut));
 
             // Result is either Success or Rejected
             ASSERT(*resultOut != egl::CacheGetResult::NotFound);
@@ -186,7 +187,8 @@ angle::Result MemoryProgramCache::putProgram(const egl::BlobCache::Key &programH
     const angle::MemoryBuffer &serializedProgram = program->getSerializedBinary();
 
     angle::MemoryBuffer compressedData;
-    if (!angle::CompressBlob(serializedProgram.size(), serializedProgram.data(), &compressedData))
+    if (!angle::CompressBlob(serializedProgram.size(), serializedProgram.data(), &compressedData,
+                             mBlobCache.getCompressionCodec()))
     {
         ANGLE_PERF_WARNING(context->getState().getDebug(), GL_DEBUG_SEVERITY_LOW,
                            "Error compressing binary data.");
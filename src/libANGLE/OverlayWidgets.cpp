@@ -531,6 +531,22 @@ void AppendWidgetDataHelper::AppendVulkanDescriptorCacheKeySize(const overlay::W
     AppendTextCommon(widget, imageExtent, text.str(), textWidget, widgetCounts);
 }
 
+void AppendWidgetDataHelper::AppendVulkanDescriptorCacheEvictions(
+    const overlay::Widget *widget,
+    const gl::Extents &imageExtent,
+    TextWidgetData *textWidget,
+    GraphWidgetData *graphWidget,
+    OverlayWidgetCounts *widgetCounts)
+{
+    auto format = [](uint64_t curValue, uint64_t maxValue) {
+        std::ostringstream text;
+        text << "Descriptor Cache Evictions (Max: " << maxValue << ")";
+        return text.str();
+    };
+
+    AppendRunningGraphCommon(widget, imageExtent, textWidget, graphWidget, widgetCounts, format);
+}
+
 void AppendWidgetDataHelper::AppendVulkanAttemptedSubmissions(const overlay::Widget *widget,
                                                               const gl::Extents &imageExtent,
                                                               TextWidgetData *textWidget,
@@ -38,6 +38,8 @@ enum class WidgetId
     VulkanUniformDescriptorCacheSize,
     // Total size of all keys in the descriptor set caches
     VulkanDescriptorCacheKeySize,
+    // Number of descriptor sets evicted to keep the caches within their budget
+    VulkanDescriptorCacheEvictions,
     // Number of times the Vulkan backend attempted to submit commands
     VulkanAttemptedSubmissions,
     // Number of times the Vulkan backend actually submitted commands
@@ -70,6 +72,7 @@ enum class WidgetId
     PROC(VulkanTextureDescriptorCacheSize)      \
     PROC(VulkanUniformDescriptorCacheSize)      \
     PROC(VulkanDescriptorCacheKeySize)          \
+    PROC(VulkanDescriptorCacheEvictions)        \
     PROC(VulkanAttemptedSubmissions)            \
     PROC(VulkanActualSubmissions)               \
     PROC(VulkanPipelineCacheLookups)            \
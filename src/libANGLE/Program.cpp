@@ -98,12 +98,13 @@ class LinkEventDone final : public LinkEvent
 
 void ScheduleSubTasks(const std::shared_ptr<angle::WorkerThreadPool> &workerThreadPool,
                       std::vector<std::shared_ptr<rx::LinkSubTask>> &tasks,
+                      angle::WorkerTaskPriority priority,
                       std::vector<std::shared_ptr<angle::WaitableEvent>> *eventsOut)
 {
     eventsOut->reserve(tasks.size());
     for (const std::shared_ptr<rx::LinkSubTask> &subTask : tasks)
     {
-        eventsOut->push_back(workerThreadPool->postWorkerTask(subTask));
+        eventsOut->push_back(workerThreadPool->postWorkerTask(subTask, priority));
     }
 }
 }  // anonymous namespace
@@ -574,13 +575,18 @@ class Program::MainLinkLoadTask : public angle::Closure
         // currently, there is no support for ordering them.
         ASSERT(linkSubTasks.empty() || postLinkSubTasks.empty());
 
-        // Schedule link subtasks
+        // Schedule link subtasks.  The main link task waits on them, so they are run ahead of
+        // other work.
         mSubTasks = std::move(linkSubTasks);
-        ScheduleSubTasks(mSubTaskWorkerPool, mSubTasks, &mSubTaskWaitableEvents);
+        ScheduleSubTasks(mSubTaskWorkerPool, mSubTasks, angle::WorkerTaskPriority::High,
+                         &mSubTaskWaitableEvents);
 
-        // Schedule post-link subtasks
+        // Schedule post-link subtasks.  These only warm up caches (such as the Vulkan pipeline
+        // cache) and nothing waits on them until the program is next used, so they yield to
+        // compiles and links the application is waiting on.
         mState.mExecutable->mPostLinkSubTasks = std::move(postLinkSubTasks);
         ScheduleSubTasks(mSubTaskWorkerPool, mState.mExecutable->mPostLinkSubTasks,
+                         angle::WorkerTaskPriority::Low,
                          &mState.mExecutable->mPostLinkSubTaskWaitableEvents);
 
         // No further use for worker pool.  Release it earlier than the destructor (to avoid
@@ -5,7 +5,7 @@
 //
 // ResourceMap:
 //   An optimized resource map which packs the first set of allocated objects into a
-//   flat array, and then falls back to an unordered map for the higher handle values.
+//   flat array, and then falls back to a paged table for the higher handle values.
 //
 
 #ifndef LIBANGLE_RESOURCE_MAP_H_
@@ -31,8 +31,8 @@ class ResourceMap final : angle::NonCopyable
             ResourceType *value = mFlatResources[handle];
             return (value == InvalidPointer() ? nullptr : value);
         }
-        auto it = mHashedResources.find(handle);
-        return (it == mHashedResources.end() ? nullptr : it->second);
+        ResourceType *value = queryPaged(handle);
+        return (value == InvalidPointer() ? nullptr : value);
     }
 
     // Returns true if the handle was reserved. Not necessarily if the resource is created.
@@ -47,7 +47,6 @@ class ResourceMap final : angle::NonCopyable
     void clear();
 
     using IndexAndResource = std::pair<GLuint, ResourceType *>;
-    using HashMap          = angle::HashMap<GLuint, ResourceType *>;
 
     class Iterator final
     {
@@ -60,15 +59,12 @@ class ResourceMap final : angle::NonCopyable
 
       private:
         friend class ResourceMap;
-        Iterator(const ResourceMap &origin,
-                 GLuint flatIndex,
-                 typename HashMap::const_iterator hashIndex,
-                 bool skipNulls);
+        Iterator(const ResourceMap &origin, uint64_t index, bool skipNulls);
         void updateValue();
 
         const ResourceMap &mOrigin;
-        GLuint mFlatIndex;
-        typename HashMap::const_iterator mHashIndex;
+        // The handle of the current element, or kEndIndex.
+        uint64_t mIndex;
         IndexAndResource mValue;
         bool mSkipNulls;
     };
@@ -87,12 +83,77 @@ class ResourceMap final : angle::NonCopyable
   private:
     friend class Iterator;
 
-    GLuint nextResource(size_t flatIndex, bool skipNulls) const;
+    // Handles above the flat array are stored in fixed-size pages, found through a radix tree
+    // indexed by the high bits of the handle: the top byte selects a directory, the next byte a
+    // page table and the next byte a page.  Each node holds 256 entries (2KB with 64-bit
+    // pointers), so an isolated large handle costs about 6KB.  Nodes are allocated on first use,
+    // and a page is freed once it holds no elements.
+    static constexpr uint32_t kLevelShift     = 8;
+    static constexpr size_t kLevelSize        = size_t(1) << kLevelShift;
+    static constexpr uint32_t kPageShift      = kLevelShift;
+    static constexpr uint32_t kTableShift     = kPageShift + kLevelShift;
+    static constexpr uint32_t kDirectoryShift = kTableShift + kLevelShift;
+    static constexpr size_t kPageSize         = size_t(1) << kPageShift;
+    static constexpr size_t kDirectoryCount   = size_t(1) << (32 - kDirectoryShift);
+    static_assert(kDirectoryCount == kLevelSize, "The root must hold one level of the handle");
+
+    struct Page
+    {
+        ResourceType *resources[kPageSize];
+        // The number of reserved handles in the page.
+        size_t count;
+    };
+    struct PageTable
+    {
+        Page *pages[kLevelSize];
+    };
+    struct Directory
+    {
+        PageTable *tables[kLevelSize];
+    };
+
+    static ANGLE_INLINE size_t GetLevelIndex(uint64_t handle, uint32_t shift)
+    {
+        return static_cast<size_t>(handle >> shift) & (kLevelSize - 1);
+    }
+
+    // Returns nullptr if the page of the handle is not allocated.
+    ANGLE_INLINE const Page *findPage(GLuint handle) const
+    {
+        if (mDirectories == nullptr)
+        {
+            return nullptr;
+        }
+        const Directory *directory = mDirectories[handle >> kDirectoryShift];
+        if (directory == nullptr)
+        {
+            return nullptr;
+        }
+        const PageTable *table = directory->tables[GetLevelIndex(handle, kTableShift)];
+        return (table == nullptr ? nullptr : table->pages[GetLevelIndex(handle, kPageShift)]);
+    }
+
+    // Returns InvalidPointer() if the handle is not reserved.
+    ANGLE_INLINE ResourceType *queryPaged(GLuint handle) const
+    {
+        const Page *page = findPage(handle);
+        return (page == nullptr ? InvalidPointer() : page->resources[handle & (kPageSize - 1)]);
+    }
+
+    void assignPaged(GLuint handle, ResourceType *resource);
+    bool erasePaged(GLuint handle, ResourceType **resourceOut);
+    void releasePages();
+
+    // Returns the first element at or after |index|, or kEndIndex.
+    uint64_t nextResource(uint64_t index, bool skipNulls) const;
 
     // constexpr methods cannot contain reinterpret_cast, so we need a static method.
     static ResourceType *InvalidPointer();
     static constexpr intptr_t kInvalidPointer = static_cast<intptr_t>(-1);
 
+    // One past the largest handle.
+    static constexpr uint64_t kEndIndex = uint64_t(1) << 32;
+
     // Start with 32 maximum elements in the map, which can grow.
     static constexpr size_t kInitialFlatResourcesSize = 0x20;
 
@@ -105,14 +166,16 @@ class ResourceMap final : angle::NonCopyable
     size_t mFlatResourcesSize;
     ResourceType **mFlatResources;
 
-    // A map of GL objects indexed by object ID.
-    HashMap mHashedResources;
+    // The root of the radix tree, with kDirectoryCount directories of GL objects indexed by the
+    // top byte of the object ID, or nullptr if no handle beyond the flat array was ever assigned.
+    Directory **mDirectories;
 };
 
 template <typename ResourceType, typename IDType>
 ResourceMap<ResourceType, IDType>::ResourceMap()
     : mFlatResourcesSize(kInitialFlatResourcesSize),
-      mFlatResources(new ResourceType *[kInitialFlatResourcesSize])
+      mFlatResources(new ResourceType *[kInitialFlatResourcesSize]),
+      mDirectories(nullptr)
 {
     memset(mFlatResources, kInvalidPointer, mFlatResourcesSize * kElementSize);
 }
@@ -122,6 +185,7 @@ ResourceMap<ResourceType, IDType>::~ResourceMap()
 {
     ASSERT(empty());
     delete[] mFlatResources;
+    releasePages();
 }
 
 template <typename ResourceType, typename IDType>
@@ -132,7 +196,7 @@ ANGLE_INLINE bool ResourceMap<ResourceType, IDType>::contains(IDType id) const
     {
         return (mFlatResources[handle] != InvalidPointer());
     }
-    return (mHashedResources.find(handle) != mHashedResources.end());
+    return (queryPaged(handle) != InvalidPointer());
 }
 
 template <typename ResourceType, typename IDType>
@@ -151,13 +215,7 @@ bool ResourceMap<ResourceType, IDType>::erase(IDType id, ResourceType **resource
     }
     else
     {
-        auto it = mHashedResources.find(handle);
-        if (it == mHashedResources.end())
-        {
-            return false;
-        }
-        *resourceOut = it->second;
-        mHashedResources.erase(it);
+        return erasePaged(handle, resourceOut);
     }
     return true;
 }
@@ -191,51 +249,136 @@ void ResourceMap<ResourceType, IDType>::assign(IDType id, ResourceType *resource
     }
     else
     {
-        mHashedResources[handle] = resource;
+        assignPaged(handle, resource);
+    }
+}
+
+template <typename ResourceType, typename IDType>
+void ResourceMap<ResourceType, IDType>::assignPaged(GLuint handle, ResourceType *resource)
+{
+    if (mDirectories == nullptr)
+    {
+        mDirectories = new Directory *[kDirectoryCount]();
+    }
+
+    Directory *&directory = mDirectories[handle >> kDirectoryShift];
+    if (directory == nullptr)
+    {
+        directory = new Directory();
+    }
+
+    PageTable *&table = directory->tables[GetLevelIndex(handle, kTableShift)];
+    if (table == nullptr)
+    {
+        table = new PageTable();
+    }
+
+    Page *&page = table->pages[GetLevelIndex(handle, kPageShift)];
+    if (page == nullptr)
+    {
+        page = new Page;
+        memset(page->resources, kInvalidPointer, kPageSize * kElementSize);
+        page->count = 0;
+    }
+
+    ResourceType *&value = page->resources[handle & (kPageSize - 1)];
+    if (value == InvalidPointer())
+    {
+        page->count++;
+    }
+    value = resource;
+}
+
+template <typename ResourceType, typename IDType>
+bool ResourceMap<ResourceType, IDType>::erasePaged(GLuint handle, ResourceType **resourceOut)
+{
+    if (queryPaged(handle) == InvalidPointer())
+    {
+        return false;
+    }
+
+    Directory *directory = mDirectories[handle >> kDirectoryShift];
+    PageTable *table     = directory->tables[GetLevelIndex(handle, kTableShift)];
+    Page *&page          = table->pages[GetLevelIndex(handle, kPageShift)];
+
+    ResourceType *&value = page->resources[handle & (kPageSize - 1)];
+    *resourceOut         = value;
+    value                = InvalidPointer();
+
+    ASSERT(page->count > 0);
+    if (--page->count == 0)
+    {
+        delete page;
+        page = nullptr;
+    }
+    return true;
+}
+
+template <typename ResourceType, typename IDType>
+void ResourceMap<ResourceType, IDType>::releasePages()
+{
+    if (mDirectories == nullptr)
+    {
+        return;
+    }
+
+    for (size_t directoryIndex = 0; directoryIndex < kDirectoryCount; ++directoryIndex)
+    {
+        Directory *directory = mDirectories[directoryIndex];
+        if (directory == nullptr)
+        {
+            continue;
+        }
+        for (PageTable *table : directory->tables)
+        {
+            if (table == nullptr)
+            {
+                continue;
+            }
+            for (Page *page : table->pages)
+            {
+                delete page;
+            }
+            delete table;
+        }
+        delete directory;
     }
+    delete[] mDirectories;
+    mDirectories = nullptr;
 }
 
 template <typename ResourceType, typename IDType>
 typename ResourceMap<ResourceType, IDType>::Iterator ResourceMap<ResourceType, IDType>::begin()
     const
 {
-    return Iterator(*this, nextResource(0, true), mHashedResources.begin(), true);
+    return Iterator(*this, nextResource(0, true), true);
 }
 
 template <typename ResourceType, typename IDType>
 typename ResourceMap<ResourceType, IDType>::Iterator ResourceMap<ResourceType, IDType>::end() const
 {
-    return Iterator(*this, static_cast<GLuint>(mFlatResourcesSize), mHashedResources.end(), true);
+    return Iterator(*this, kEndIndex, true);
 }
 
 template <typename ResourceType, typename IDType>
 typename ResourceMap<ResourceType, IDType>::Iterator
 ResourceMap<ResourceType, IDType>::beginWithNull() const
 {
-    return Iterator(*this, nextResource(0, false), mHashedResources.begin(), false);
+    return Iterator(*this, nextResource(0, false), false);
 }
 
 template <typename ResourceType, typename IDType>
 typename ResourceMap<ResourceType, IDType>::Iterator
 ResourceMap<ResourceType, IDType>::endWithNull() const
 {
-    return Iterator(*this, static_cast<GLuint>(mFlatResourcesSize), mHashedResources.end(), false);
+    return Iterator(*this, kEndIndex, false);
 }
 
 template <typename ResourceType, typename IDType>
 typename ResourceMap<ResourceType, IDType>::Iterator ResourceMap<ResourceType, IDType>::find(
     IDType handle) const
 {
-    if (handle < mFlatResourcesSize)
-    {
-        return (mFlatResources[handle] != InvalidPointer()
-                    ? Iterator(handle, mHashedResources.begin())
-                    : end());
-    }
-    else
-    {
-        return mHashedResources.find(handle);
-    }
+    return (contains(handle) ? Iterator(*this, GetIDValue(handle), true) : end());
 }
 
 template <typename ResourceType, typename IDType>
@@ -249,21 +392,62 @@ void ResourceMap<ResourceType, IDType>::clear()
 {
     memset(mFlatResources, kInvalidPointer, kInitialFlatResourcesSize * kElementSize);
     mFlatResourcesSize = kInitialFlatResourcesSize;
-    mHashedResources.clear();
+    releasePages();
 }
 
 template <typename ResourceType, typename IDType>
-GLuint ResourceMap<ResourceType, IDType>::nextResource(size_t flatIndex, bool skipNulls) const
+uint64_t ResourceMap<ResourceType, IDType>::nextResource(uint64_t index, bool skipNulls) const
 {
-    for (size_t index = flatIndex; index < mFlatResourcesSize; index++)
+    for (; index < mFlatResourcesSize; index++)
     {
         if ((mFlatResources[index] != nullptr || !skipNulls) &&
             mFlatResources[index] != InvalidPointer())
         {
-            return static_cast<GLuint>(index);
+            return index;
         }
     }
-    return static_cast<GLuint>(mFlatResourcesSize);
+
+    if (mDirectories == nullptr)
+    {
+        return kEndIndex;
+    }
+
+    // Skip over the directories, tables and pages that were never allocated or have been freed.
+    index = std::max<uint64_t>(index, kFlatResourcesLimit);
+    while (index < kEndIndex)
+    {
+        const Directory *directory = mDirectories[index >> kDirectoryShift];
+        if (directory == nullptr)
+        {
+            index = (index | ((uint64_t(1) << kDirectoryShift) - 1)) + 1;
+            continue;
+        }
+
+        const PageTable *table = directory->tables[GetLevelIndex(index, kTableShift)];
+        if (table == nullptr)
+        {
+            index = (index | ((uint64_t(1) << kTableShift) - 1)) + 1;
+            continue;
+        }
+
+        const Page *page = table->pages[GetLevelIndex(index, kPageShift)];
+        if (page == nullptr)
+        {
+            index = (index | (kPageSize - 1)) + 1;
+            continue;
+        }
+
+        const uint64_t pageEnd = (index | (kPageSize - 1)) + 1;
+        for (; index < pageEnd; index++)
+        {
+            ResourceType *value = page->resources[index & (kPageSize - 1)];
+            if ((value != nullptr || !skipNulls) && value != InvalidPointer())
+            {
+                return index;
+            }
+        }
+    }
+    return kEndIndex;
 }
 
 template <typename ResourceType, typename IDType>
@@ -274,12 +458,10 @@ ResourceType *ResourceMap<ResourceType, IDType>::InvalidPointer()
 }
 
 template <typename ResourceType, typename IDType>
-ResourceMap<ResourceType, IDType>::Iterator::Iterator(
-    const ResourceMap &origin,
-    GLuint flatIndex,
-    typename ResourceMap<ResourceType, IDType>::HashMap::const_iterator hashIndex,
-    bool skipNulls)
-    : mOrigin(origin), mFlatIndex(flatIndex), mHashIndex(hashIndex), mSkipNulls(skipNulls)
+ResourceMap<ResourceType, IDType>::Iterator::Iterator(const ResourceMap &origin,
+                                                      uint64_t index,
+                                                      bool skipNulls)
+    : mOrigin(origin), mIndex(index), mSkipNulls(skipNulls)
 {
     updateValue();
 }
@@ -287,7 +469,7 @@ ResourceMap<ResourceType, IDType>::Iterator::Iterator(
 template <typename ResourceType, typename IDType>
 bool ResourceMap<ResourceType, IDType>::Iterator::operator==(const Iterator &other) const
 {
-    return (mFlatIndex == other.mFlatIndex && mHashIndex == other.mHashIndex);
+    return (mIndex == other.mIndex);
 }
 
 template <typename ResourceType, typename IDType>
@@ -300,14 +482,7 @@ template <typename ResourceType, typename IDType>
 typename ResourceMap<ResourceType, IDType>::Iterator &
 ResourceMap<ResourceType, IDType>::Iterator::operator++()
 {
-    if (mFlatIndex < static_cast<GLuint>(mOrigin.mFlatResourcesSize))
-    {
-        mFlatIndex = mOrigin.nextResource(mFlatIndex + 1, mSkipNulls);
-    }
-    else
-    {
-        mHashIndex++;
-    }
+    mIndex = mOrigin.nextResource(mIndex + 1, mSkipNulls);
     updateValue();
     return *this;
 }
@@ -329,15 +504,15 @@ ResourceMap<ResourceType, IDType>::Iterator::operator*() const
 template <typename ResourceType, typename IDType>
 void ResourceMap<ResourceType, IDType>::Iterator::updateValue()
 {
-    if (mFlatIndex < static_cast<GLuint>(mOrigin.mFlatResourcesSize))
+    if (mIndex < mOrigin.mFlatResourcesSize)
     {
-        mValue.first  = mFlatIndex;
-        mValue.second = mOrigin.mFlatResources[mFlatIndex];
+        mValue.first  = static_cast<GLuint>(mIndex);
+        mValue.second = mOrigin.mFlatResources[mIndex];
     }
-    else if (mHashIndex != mOrigin.mHashedResources.end())
+    else if (mIndex < kEndIndex)
     {
-        mValue.first  = mHashIndex->first;
-        mValue.second = mHashIndex->second;
+        mValue.first  = static_cast<GLuint>(mIndex);
+        mValue.second = mOrigin.queryPaged(mValue.first);
     }
 }
 
@@ -133,4 +133,125 @@ TEST(ResourceMapTest, QueryUnassigned)
     ASSERT_FALSE(resourceMap.contains(100));
     ASSERT_EQ(nullptr, resourceMap.query(100));
 }
+
+// Tests assigning, iterating and erasing sparse handles far beyond the flat array.
+TEST(ResourceMapTest, SparseLargeHandles)
+{
+    const GLuint kHandles[] = {1,        0x3FFF,     0x4000,     0x4FFF,    0x5000,
+                               0x123456, 0x7FFFFFFF, 0xFFFFFFFE, 0xFFFFFFFF};
+
+    ResourceMap<size_t, GLuint> resourceMap;
+    std::vector<size_t> objects(std::size(kHandles));
+    for (size_t index = 0; index < std::size(kHandles); ++index)
+    {
+        resourceMap.assign(kHandles[index], &objects[index]);
+    }
+
+    for (size_t index = 0; index < std::size(kHandles); ++index)
+    {
+        ASSERT_TRUE(resourceMap.contains(kHandles[index]));
+        ASSERT_EQ(&objects[index], resourceMap.query(kHandles[index]));
+    }
+    ASSERT_FALSE(resourceMap.contains(0x4001));
+    ASSERT_FALSE(resourceMap.contains(0x123457));
+    ASSERT_FALSE(resourceMap.contains(0x80000000));
+
+    // Elements are visited in handle order.
+    size_t visitedCount = 0;
+    for (const auto &handleAndObject : resourceMap)
+    {
+        ASSERT_LT(visitedCount, std::size(kHandles));
+        ASSERT_EQ(kHandles[visitedCount], handleAndObject.first);
+        ASSERT_EQ(&objects[visitedCount], handleAndObject.second);
+        ++visitedCount;
+    }
+    ASSERT_EQ(std::size(kHandles), visitedCount);
+
+    for (size_t index = 0; index < std::size(kHandles); ++index)
+    {
+        size_t *found = nullptr;
+        ASSERT_TRUE(resourceMap.erase(kHandles[index], &found));
+        ASSERT_EQ(&objects[index], found);
+        ASSERT_FALSE(resourceMap.erase(kHandles[index], &found));
+        ASSERT_EQ(nullptr, resourceMap.query(kHandles[index]));
+    }
+
+    ASSERT_TRUE(resourceMap.empty());
+}
+
+// Tests handles on both sides of the boundaries between pages, page tables and directories of
+// the paged part of the map, where each level is indexed by one byte of the handle.
+TEST(ResourceMapTest, PagedLevelBoundaries)
+{
+    const GLuint kHandles[] = {0x40FF, 0x4100, 0xFFFF, 0x10000, 0xFFFFFF, 0x1000000};
+
+    ResourceMap<size_t, GLuint> resourceMap;
+    std::vector<size_t> objects(std::size(kHandles));
+    for (size_t index = 0; index < std::size(kHandles); ++index)
+    {
+        resourceMap.assign(kHandles[index], &objects[index]);
+    }
+
+    size_t visitedCount = 0;
+    for (const auto &handleAndObject : resourceMap)
+    {
+        ASSERT_LT(visitedCount, std::size(kHandles));
+        ASSERT_EQ(kHandles[visitedCount], handleAndObject.first);
+        ASSERT_EQ(&objects[visitedCount], handleAndObject.second);
+        ++visitedCount;
+    }
+    ASSERT_EQ(std::size(kHandles), visitedCount);
+
+    // Erasing the only handle of a page frees the page without affecting its neighbors.
+    for (size_t index = 0; index < std::size(kHandles); index += 2)
+    {
+        size_t *found = nullptr;
+        ASSERT_TRUE(resourceMap.erase(kHandles[index], &found));
+        ASSERT_EQ(&objects[index], found);
+        ASSERT_FALSE(resourceMap.contains(kHandles[index]));
+        ASSERT_EQ(&objects[index + 1], resourceMap.query(kHandles[index + 1]));
+    }
+
+    auto iter = resourceMap.begin();
+    for (size_t index = 1; index < std::size(kHandles); index += 2, ++iter)
+    {
+        ASSERT_NE(resourceMap.end(), iter);
+        ASSERT_EQ(kHandles[index], iter->first);
+    }
+    ASSERT_EQ(resourceMap.end(), iter);
+
+    resourceMap.clear();
+    ASSERT_TRUE(resourceMap.empty());
+}
+
+// Tests that reserved handles beyond the flat array are only visited when including nulls.
+TEST(ResourceMapTest, LargeReservedHandles)
+{
+    constexpr GLuint kReservedHandle = 0x10000;
+    constexpr GLuint kCreatedHandle  = 0x20000;
+
+    ResourceMap<size_t, GLuint> resourceMap;
+    size_t object = 0;
+    resourceMap.assign(kReservedHandle, nullptr);
+    resourceMap.assign(kCreatedHandle, &object);
+
+    ASSERT_TRUE(resourceMap.contains(kReservedHandle));
+    ASSERT_EQ(nullptr, resourceMap.query(kReservedHandle));
+
+    auto iter = resourceMap.begin();
+    ASSERT_NE(resourceMap.end(), iter);
+    ASSERT_EQ(kCreatedHandle, iter->first);
+    ASSERT_EQ(resourceMap.end(), ++iter);
+
+    auto iterWithNull = resourceMap.beginWithNull();
+    ASSERT_EQ(kReservedHandle, iterWithNull->first);
+    ASSERT_EQ(nullptr, iterWithNull->second);
+    ++iterWithNull;
+    ASSERT_EQ(kCreatedHandle, iterWithNull->first);
+    ASSERT_EQ(resourceMap.endWithNull(), ++iterWithNull);
+
+    resourceMap.clear();
+    ASSERT_TRUE(resourceMap.empty());
+    ASSERT_FALSE(resourceMap.contains(kReservedHandle));
+}
 }  // anonymous namespace
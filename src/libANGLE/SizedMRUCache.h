@@ -53,6 +53,19 @@ class SizedMRUCache final : angle::NonCopyable
         return true;
     }
 
+    // Like get, but does not make the entry the most recently used, so it can be called
+    // concurrently with other const methods.
+    bool peek(const Key &key, const Value **valueOut) const
+    {
+        const auto &iter = mStore.Peek(key);
+        if (iter == mStore.end())
+        {
+            return false;
+        }
+        *valueOut = &iter->second.value;
+        return true;
+    }
+
     bool getAt(size_t index, const Key **keyOut, const Value **valueOut)
     {
         if (index < mStore.size())
@@ -7,11 +7,13 @@
 // angletypes.h : Defines a variety of structures and enum types that are used throughout libGLESv2
 
 #include "libANGLE/angletypes.h"
+#include "common/lz4_block.h"
 #include "libANGLE/Program.h"
 #include "libANGLE/State.h"
 #include "libANGLE/VertexArray.h"
 #include "libANGLE/VertexAttribute.h"
 
+#include <array>
 #include <limits>
 
 #define USE_SYSTEM_ZLIB
@@ -1070,7 +1072,50 @@ GLsizeiptr GetBoundBufferAvailableSize(const OffsetBindingPointer<Buffer> &bindi
    //
 namespace angle
 {
-bool CompressBlob(const size_t cacheSize, const uint8_t *cacheData, MemoryBuffer *compressedData)
+namespace
+{
+// Header prepended to blobs compressed with any codec other than gzip.  Gzip streams always start
+// with the bytes 0x1f 0x8b, so untagged legacy blobs can't be mistaken for tagged ones.  The header
+// is 16 bytes so that uncompressed payloads keep the alignment of the buffer holding the blob.
+constexpr std::array<uint8_t, 4> kBlobCodecMagic = {'A', 'B', 'C', '2'};
+
+struct BlobCodecHeader
+{
+    std::array<uint8_t, 4> magic;
+    BlobCompressionCodec codec;
+    uint8_t padding[3];
+    uint32_t uncompressedSize;
+    uint32_t reserved;
+};
+static_assert(sizeof(BlobCodecHeader) == 16, "Payloads must stay 16-byte aligned");
+
+bool ReadBlobCodecHeader(const uint8_t *compressedData,
+                         const size_t compressedSize,
+                         BlobCodecHeader *headerOut)
+{
+    if (compressedSize < sizeof(BlobCodecHeader))
+    {
+        return false;
+    }
+    memcpy(headerOut, compressedData, sizeof(BlobCodecHeader));
+    return headerOut->magic == kBlobCodecMagic &&
+           headerOut->codec < BlobCompressionCodec::InvalidEnum;
+}
+
+void WriteBlobCodecHeader(BlobCompressionCodec codec,
+                          const size_t uncompressedSize,
+                          MemoryBuffer *compressedData)
+{
+    BlobCodecHeader header  = {};
+    header.magic            = kBlobCodecMagic;
+    header.codec            = codec;
+    header.uncompressedSize = static_cast<uint32_t>(uncompressedSize);
+    memcpy(compressedData->data(), &header, sizeof(BlobCodecHeader));
+}
+
+bool CompressBlobGzip(const size_t cacheSize,
+                      const uint8_t *cacheData,
+                      MemoryBuffer *compressedData)
 {
     uLong uncompressedSize       = static_cast<uLong>(cacheSize);
     uLong expectedCompressedSize = zlib_internal::GzipExpectedCompressedSize(uncompressedSize);
@@ -1099,10 +1144,85 @@ bool CompressBlob(const size_t cacheSize, const uint8_t *cacheData, MemoryBuffer
     return true;
 }
 
-bool DecompressBlob(const uint8_t *compressedData,
-                    const size_t compressedSize,
-                    size_t maxUncompressedDataSize,
-                    MemoryBuffer *uncompressedData)
+bool CompressBlobLz4(const size_t cacheSize, const uint8_t *cacheData, MemoryBuffer *compressedData)
+{
+    const size_t expectedCompressedSize = Lz4BlockCompressBound(cacheSize);
+
+    if (!compressedData->resize(sizeof(BlobCodecHeader) + expectedCompressedSize))
+    {
+        ERR() << "Failed to allocate memory for compression";
+        return false;
+    }
+
+    const size_t actualCompressedSize =
+        Lz4BlockCompress(cacheData, cacheSize, compressedData->data() + sizeof(BlobCodecHeader),
+                         expectedCompressedSize);
+    if (actualCompressedSize == 0)
+    {
+        ERR() << "Failed to compress cache data with LZ4";
+        return false;
+    }
+
+    WriteBlobCodecHeader(BlobCompressionCodec::Lz4, cacheSize, compressedData);
+    compressedData->trim(sizeof(BlobCodecHeader) + actualCompressedSize);
+
+    return true;
+}
+
+bool CompressBlobDeflateBest(const size_t cacheSize,
+                             const uint8_t *cacheData,
+                             MemoryBuffer *compressedData)
+{
+    uLong uncompressedSize       = static_cast<uLong>(cacheSize);
+    uLong expectedCompressedSize = compressBound(uncompressedSize);
+    uLong actualCompressedSize   = expectedCompressedSize;
+
+    if (!compressedData->resize(sizeof(BlobCodecHeader) + expectedCompressedSize))
+    {
+        ERR() << "Failed to allocate memory for compression";
+        return false;
+    }
+
+    int zResult = zlib_internal::CompressHelper(
+        zlib_internal::ZRAW, compressedData->data() + sizeof(BlobCodecHeader),
+        &actualCompressedSize, cacheData, uncompressedSize, Z_BEST_COMPRESSION, nullptr, nullptr);
+
+    if (zResult != Z_OK)
+    {
+        ERR() << "Failed to compress cache data: " << zResult;
+        return false;
+    }
+
+    ASSERT(actualCompressedSize <= expectedCompressedSize);
+    WriteBlobCodecHeader(BlobCompressionCodec::DeflateBest, cacheSize, compressedData);
+    compressedData->trim(sizeof(BlobCodecHeader) + actualCompressedSize);
+
+    return true;
+}
+
+bool CompressBlobUncompressed(const size_t cacheSize,
+                              const uint8_t *cacheData,
+                              MemoryBuffer *compressedData)
+{
+    if (!compressedData->resize(sizeof(BlobCodecHeader) + cacheSize))
+    {
+        ERR() << "Failed to allocate memory for uncompressed blob";
+        return false;
+    }
+
+    WriteBlobCodecHeader(BlobCompressionCodec::Uncompressed, cacheSize, compressedData);
+    if (cacheSize > 0)
+    {
+        memcpy(compressedData->data() + sizeof(BlobCodecHeader), cacheData, cacheSize);
+    }
+
+    return true;
+}
+
+bool DecompressBlobGzip(const uint8_t *compressedData,
+                        const size_t compressedSize,
+                        size_t maxUncompressedDataSize,
+                        MemoryBuffer *uncompressedData)
 {
     // Call zlib function to decompress.
     uint32_t uncompressedSize =
@@ -1139,6 +1259,151 @@ bool DecompressBlob(const uint8_t *compressedData,
     return true;
 }
 
+bool DecompressBlobTagged(const BlobCodecHeader &header,
+                          const uint8_t *payload,
+                          const size_t payloadSize,
+                          size_t maxUncompressedDataSize,
+                          MemoryBuffer *uncompressedData)
+{
+    if (header.uncompressedSize > maxUncompressedDataSize)
+    {
+        ERR() << "Decompressed data size is larger than the maximum supported ("
+              << header.uncompressedSize << " vs " << maxUncompressedDataSize << ")";
+        return false;
+    }
+
+    if (!uncompressedData->resize(header.uncompressedSize))
+    {
+        ERR() << "Failed to allocate memory for decompression";
+        return false;
+    }
+
+    switch (header.codec)
+    {
+        case BlobCompressionCodec::Lz4:
+            if (!Lz4BlockDecompress(payload, payloadSize, uncompressedData->data(),
+                                    header.uncompressedSize))
+            {
+                WARN() << "Failed to decompress LZ4 data";
+                return false;
+            }
+            return true;
+
+        case BlobCompressionCodec::DeflateBest:
+        {
+            uLong destLen = header.uncompressedSize;
+            int zResult   = zlib_internal::UncompressHelper(
+                zlib_internal::ZRAW, uncompressedData->data(), &destLen, payload,
+                static_cast<uLong>(payloadSize));
+            if (zResult != Z_OK || destLen != header.uncompressedSize)
+            {
+                WARN() << "Failed to decompress data: " << zResult << "\n";
+                return false;
+            }
+            return true;
+        }
+
+        case BlobCompressionCodec::Uncompressed:
+            if (payloadSize != header.uncompressedSize)
+            {
+                WARN() << "Uncompressed blob has an unexpected size";
+                return false;
+            }
+            if (payloadSize > 0)
+            {
+                memcpy(uncompressedData->data(), payload, payloadSize);
+            }
+            return true;
+
+        default:
+            UNREACHABLE();
+            return false;
+    }
+}
+}  // anonymous namespace
+
+bool CompressBlob(const size_t cacheSize,
+                  const uint8_t *cacheData,
+                  MemoryBuffer *compressedData,
+                  BlobCompressionCodec codec)
+{
+    // Tagged blobs record the uncompressed size in 32 bits, the same limit gzip has.
+    if (cacheSize > std::numeric_limits<uint32_t>::max())
+    {
+        ERR() << "Cache data is too large to compress: " << cacheSize;
+        return false;
+    }
+
+    switch (codec)
+    {
+        case BlobCompressionCodec::Gzip:
+            return CompressBlobGzip(cacheSize, cacheData, compressedData);
+        case BlobCompressionCodec::Lz4:
+            return CompressBlobLz4(cacheSize, cacheData, compressedData);
+        case BlobCompressionCodec::DeflateBest:
+            return CompressBlobDeflateBest(cacheSize, cacheData, compressedData);
+        case BlobCompressionCodec::Uncompressed:
+            return CompressBlobUncompressed(cacheSize, cacheData, compressedData);
+        default:
+            UNREACHABLE();
+            return false;
+    }
+}
+
+bool DecompressBlob(const uint8_t *compressedData,
+                    const size_t compressedSize,
+                    size_t maxUncompressedDataSize,
+                    MemoryBuffer *uncompressedData)
+{
+    BlobCodecHeader header;
+    if (ReadBlobCodecHeader(compressedData, compressedSize, &header))
+    {
+        return DecompressBlobTagged(header, compressedData + sizeof(BlobCodecHeader),
+                                    compressedSize - sizeof(BlobCodecHeader),
+                                    maxUncompressedDataSize, uncompressedData);
+    }
+
+    return DecompressBlobGzip(compressedData, compressedSize, maxUncompressedDataSize,
+                              uncompressedData);
+}
+
+BlobCompressionCodec GetBlobCompressionCodec(const uint8_t *compressedData,
+                                             const size_t compressedSize)
+{
+    BlobCodecHeader header;
+    if (ReadBlobCodecHeader(compressedData, compressedSize, &header))
+    {
+        return header.codec;
+    }
+
+    constexpr uint8_t kGzipMagic[2] = {0x1f, 0x8b};
+    if (compressedSize >= sizeof(kGzipMagic) && compressedData[0] == kGzipMagic[0] &&
+        compressedData[1] == kGzipMagic[1])
+    {
+        return BlobCompressionCodec::Gzip;
+    }
+
+    return BlobCompressionCodec::InvalidEnum;
+}
+
+bool GetUncompressedBlobData(const uint8_t *blobData,
+                             const size_t blobSize,
+                             const uint8_t **dataOut,
+                             size_t *dataSizeOut)
+{
+    BlobCodecHeader header;
+    if (!ReadBlobCodecHeader(blobData, blobSize, &header) ||
+        header.codec != BlobCompressionCodec::Uncompressed ||
+        blobSize - sizeof(BlobCodecHeader) != header.uncompressedSize)
+    {
+        return false;
+    }
+
+    *dataOut     = blobData + sizeof(BlobCodecHeader);
+    *dataSizeOut = header.uncompressedSize;
+    return true;
+}
+
 uint32_t GenerateCrc(const uint8_t *data, size_t size)
 {
     return static_cast<uint32_t>(crc32_z(0u, data, size));
@@ -1274,11 +1274,42 @@ class BlobCacheValue  // To be replaced with std::span when C++20 is required
     size_t mSize;
 };
 
-bool CompressBlob(const size_t cacheSize, const uint8_t *cacheData, MemoryBuffer *compressedData);
+// Codecs used to compress blobs stored in the blob cache.  Blobs produced with any codec other
+// than Gzip are prefixed with a small header identifying the codec, so DecompressBlob can tell them
+// apart.  Gzip blobs are stored untagged, which keeps blobs written by older versions readable.
+enum class BlobCompressionCodec : uint8_t
+{
+    // zlib's gzip wrapper at the default compression level.
+    Gzip,
+    // LZ4 block format.  Compresses less, but decompresses several times faster than Gzip.
+    Lz4,
+    // Raw deflate at the highest compression level.  Slowest to compress, smallest output.
+    DeflateBest,
+    // Not compressed.  The payload is 16-byte aligned within the blob, so it can be read in place
+    // with GetUncompressedBlobData instead of being copied out.
+    Uncompressed,
+
+    InvalidEnum,
+    EnumCount = InvalidEnum,
+};
+
+bool CompressBlob(const size_t cacheSize,
+                  const uint8_t *cacheData,
+                  MemoryBuffer *compressedData,
+                  BlobCompressionCodec codec = BlobCompressionCodec::Gzip);
 bool DecompressBlob(const uint8_t *compressedData,
                     const size_t compressedSize,
                     size_t maxUncompressedDataSize,
                     MemoryBuffer *uncompressedData);
+// Returns the codec |compressedData| was compressed with, or InvalidEnum if it can't be told.
+BlobCompressionCodec GetBlobCompressionCodec(const uint8_t *compressedData,
+                                             const size_t compressedSize);
+// If |blobData| was stored with BlobCompressionCodec::Uncompressed, returns true and points
+// |dataOut| at its payload inside |blobData|.
+bool GetUncompressedBlobData(const uint8_t *blobData,
+                             const size_t blobSize,
+                             const uint8_t **dataOut,
+                             size_t *dataSizeOut);
 uint32_t GenerateCrc(const uint8_t *data, size_t size);
 }  // namespace angle
 
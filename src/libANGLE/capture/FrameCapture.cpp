@@ -21,7 +21,9 @@
 #include "common/angle_version_info.h"
 #include "common/frame_capture_utils.h"
 #include "common/gl_enum_utils.h"
+#include "common/hash_utils.h"
 #include "common/mathutil.h"
+#include "common/memory_diff_utils.h"
 #include "common/serializer/JsonSerializer.h"
 #include "common/string_utils.h"
 #include "common/system_utils.h"
@@ -58,6 +60,11 @@
 #define USE_SYSTEM_ZLIB
 #include "compression_utils_portable.h"
 
+#if defined(ANGLE_PLATFORM_LINUX) || defined(ANGLE_PLATFORM_ANDROID)
+#    include <fcntl.h>
+#    include <unistd.h>
+#endif
+
 #if !ANGLE_CAPTURE_ENABLED
 #    error Frame capture must be enabled to include this file.
 #endif  // !ANGLE_CAPTURE_ENABLED
@@ -82,6 +89,9 @@ constexpr char kValidationExprVarName[] = "ANGLE_CAPTURE_VALIDATION_EXPR";
 constexpr char kSourceExtVarName[]      = "ANGLE_CAPTURE_SOURCE_EXT";
 constexpr char kSourceSizeVarName[]     = "ANGLE_CAPTURE_SOURCE_SIZE";
 constexpr char kForceShadowVarName[]    = "ANGLE_CAPTURE_FORCE_SHADOW";
+constexpr char kMemoryBudgetVarName[]   = "ANGLE_CAPTURE_MEMORY_BUDGET";
+constexpr char kCoherentDiffVarName[]   = "ANGLE_CAPTURE_COHERENT_DIFF";
+constexpr char kSoftDirtyVarName[]      = "ANGLE_CAPTURE_SOFT_DIRTY";
 
 constexpr size_t kBinaryAlignment   = 16;
 constexpr size_t kFunctionSizeLimit = 5000;
@@ -89,6 +99,16 @@ constexpr size_t kFunctionSizeLimit = 5000;
 // Limit based on MSVC Compiler Error C2026
 constexpr size_t kStringLengthLimit = 16380;
 
+// Size of the buffer the binary data is compressed into, before it is written to the file.
+constexpr size_t kBinaryDataCompressionBufferSize = 1024 * 1024;
+
+// Default limit to the memory held by the binary data and by the files waiting to be written, in
+// megabytes.  Half of it goes to each.
+constexpr size_t kDefaultMemoryBudgetMB = 1024;
+
+// Mid-execution capture reads back texture levels in batches of about this many bytes.
+constexpr size_t kTextureReadbackBatchSize = 64 * 1024 * 1024;
+
 // Default limit to number of bytes in a capture source files.
 constexpr char kDefaultSourceFileExt[]           = "cpp";
 constexpr size_t kDefaultSourceFileSizeThreshold = 400000;
@@ -106,6 +126,9 @@ constexpr char kAndroidValidationExpr[] = "debug.angle.capture.validation_expr";
 constexpr char kAndroidSourceExt[]      = "debug.angle.capture.source_ext";
 constexpr char kAndroidSourceSize[]     = "debug.angle.capture.source_size";
 constexpr char kAndroidForceShadow[]    = "debug.angle.capture.force_shadow";
+constexpr char kAndroidMemoryBudget[]   = "debug.angle.capture.memory_budget";
+constexpr char kAndroidCoherentDiff[]   = "debug.angle.capture.coherent_diff";
+constexpr char kAndroidSoftDirty[]      = "debug.angle.capture.soft_dirty";
 
 struct FramebufferCaptureFuncs
 {
@@ -645,7 +668,7 @@ void WriteStringParamReplay(ReplayWriter &replayWriter,
                             std::ostream &header,
                             const CallCapture &call,
                             const ParamCapture &param,
-                            std::vector<uint8_t> *binaryData)
+                            BinaryDataStore *binaryData)
 {
     const std::vector<uint8_t> &data = param.data[0];
     // null terminate C style string
@@ -656,10 +679,8 @@ void WriteStringParamReplay(ReplayWriter &replayWriter,
     if (str.size() > kMaxInlineStringLength)
     {
         // Store in binary file if the string is too long.
-        // Round up to 16-byte boundary for cross ABI safety.
-        size_t offset = rx::roundUpPow2(binaryData->size(), kBinaryAlignment);
-        binaryData->resize(offset + str.size() + 1);
-        memcpy(binaryData->data() + offset, str.data(), str.size() + 1);
+        size_t offset = binaryData->append(reinterpret_cast<const uint8_t *>(str.c_str()),
+                                           str.size() + 1);
         out << "(const char *)&gBinaryData[" << offset << "]";
     }
     else if (str.find('\n') != std::string::npos)
@@ -779,7 +800,7 @@ void WriteBinaryParamReplay(ReplayWriter &replayWriter,
                             std::ostream &header,
                             const CallCapture &call,
                             const ParamCapture &param,
-                            std::vector<uint8_t> *binaryData)
+                            BinaryDataStore *binaryData)
 {
     std::string varName = replayWriter.getInlineVariableName(call.entryPoint, param.name);
 
@@ -804,10 +825,7 @@ void WriteBinaryParamReplay(ReplayWriter &replayWriter,
     else
     {
         // Store in binary file if data are not of type string
-        // Round up to 16-byte boundary for cross ABI safety
-        size_t offset = rx::roundUpPow2(binaryData->size(), kBinaryAlignment);
-        binaryData->resize(offset + data.size());
-        memcpy(binaryData->data() + offset, data.data(), data.size());
+        size_t offset = binaryData->append(data.data(), data.size());
         out << "(" << ParamTypeToString(overrideType) << ")&gBinaryData[" << offset << "]";
     }
 }
@@ -816,7 +834,7 @@ void WriteCppReplayForCall(const CallCapture &call,
                            ReplayWriter &replayWriter,
                            std::ostream &out,
                            std::ostream &header,
-                           std::vector<uint8_t> *binaryData,
+                           BinaryDataStore *binaryData,
                            size_t *maxResourceIDBufferSize)
 {
     std::ostringstream callOut;
@@ -970,43 +988,6 @@ std::string GetBinaryDataFilePath(bool compression, const std::string &captureLa
     return fnameStream.str();
 }
 
-void SaveBinaryData(bool compression,
-                    const std::string &outDir,
-                    gl::ContextID contextId,
-                    const std::string &captureLabel,
-                    const std::vector<uint8_t> &binaryData)
-{
-    std::string binaryDataFileName = GetBinaryDataFilePath(compression, captureLabel);
-    std::string dataFilepath       = outDir + binaryDataFileName;
-
-    SaveFileHelper saveData(dataFilepath);
-
-    if (compression)
-    {
-        // Save compressed data.
-        uLong uncompressedSize       = static_cast<uLong>(binaryData.size());
-        uLong expectedCompressedSize = zlib_internal::GzipExpectedCompressedSize(uncompressedSize);
-
-        std::vector<uint8_t> compressedData(expectedCompressedSize, 0);
-
-        uLong compressedSize = expectedCompressedSize;
-        int zResult = zlib_internal::GzipCompressHelper(compressedData.data(), &compressedSize,
-                                                        binaryData.data(), uncompressedSize,
-                                                        nullptr, nullptr);
-
-        if (zResult != Z_OK)
-        {
-            FATAL() << "Error compressing binary data: " << zResult;
-        }
-
-        saveData.write(compressedData.data(), compressedSize);
-    }
-    else
-    {
-        saveData.write(binaryData.data(), binaryData.size());
-    }
-}
-
 void WriteInitReplayCall(bool compression,
                          std::ostream &out,
                          gl::ContextID contextID,
@@ -1076,7 +1057,7 @@ void MaybeResetResources(gl::ContextID contextID,
                          std::stringstream &out,
                          std::stringstream &header,
                          ResourceTracker *resourceTracker,
-                         std::vector<uint8_t> *binaryData,
+                         BinaryDataStore *binaryData,
                          bool &anyResourceReset,
                          size_t *maxResourceIDBufferSize)
 {
@@ -1515,7 +1496,7 @@ void MaybeResetFenceSyncObjects(std::stringstream &out,
                                 ReplayWriter &replayWriter,
                                 std::stringstream &header,
                                 ResourceTracker *resourceTracker,
-                                std::vector<uint8_t> *binaryData,
+                                BinaryDataStore *binaryData,
                                 size_t *maxResourceIDBufferSize)
 {
     FenceSyncCalls &fenceSyncRegenCalls = resourceTracker->getFenceSyncRegenCalls();
@@ -1589,7 +1570,7 @@ void MaybeResetDefaultUniforms(std::stringstream &out,
                                std::stringstream &header,
                                const gl::Context *context,
                                ResourceTracker *resourceTracker,
-                               std::vector<uint8_t> *binaryData,
+                               BinaryDataStore *binaryData,
                                size_t *maxResourceIDBufferSize)
 {
     DefaultUniformLocationsPerProgramMap &defaultUniformsToReset =
@@ -1656,7 +1637,7 @@ void MaybeResetOpaqueTypeObjects(ReplayWriter &replayWriter,
                                  std::stringstream &header,
                                  const gl::Context *context,
                                  ResourceTracker *resourceTracker,
-                                 std::vector<uint8_t> *binaryData,
+                                 BinaryDataStore *binaryData,
                                  size_t *maxResourceIDBufferSize)
 {
     MaybeResetFenceSyncObjects(out, replayWriter, header, resourceTracker, binaryData,
@@ -1671,7 +1652,7 @@ void MaybeResetContextState(ReplayWriter &replayWriter,
                             std::stringstream &header,
                             ResourceTracker *resourceTracker,
                             const gl::Context *context,
-                            std::vector<uint8_t> *binaryData,
+                            BinaryDataStore *binaryData,
                             StateResetHelper &stateResetHelper,
                             size_t *maxResourceIDBufferSize)
 {
@@ -1771,7 +1752,7 @@ void WriteCppReplayFunctionWithParts(const gl::ContextID contextID,
                                      ReplayFunc replayFunc,
                                      ReplayWriter &replayWriter,
                                      uint32_t frameIndex,
-                                     std::vector<uint8_t> *binaryData,
+                                     BinaryDataStore *binaryData,
                                      const std::vector<CallCapture> &calls,
                                      std::stringstream &header,
                                      std::stringstream &out,
@@ -1846,7 +1827,7 @@ void WriteCppReplayFunctionWithPartsMultiContext(const gl::ContextID contextID,
                                                  ReplayFunc replayFunc,
                                                  ReplayWriter &replayWriter,
                                                  uint32_t frameIndex,
-                                                 std::vector<uint8_t> *binaryData,
+                                                 BinaryDataStore *binaryData,
                                                  std::vector<CallCapture> &calls,
                                                  std::stringstream &header,
                                                  std::stringstream &out,
@@ -1997,7 +1978,7 @@ void WriteAuxiliaryContextCppSetupReplay(ReplayWriter &replayWriter,
                                          const std::string &captureLabel,
                                          uint32_t frameIndex,
                                          const std::vector<CallCapture> &setupCalls,
-                                         std::vector<uint8_t> *binaryData,
+                                         BinaryDataStore *binaryData,
                                          bool serializeStateEnabled,
                                          const FrameCaptureShared &frameCaptureShared,
                                          size_t *maxResourceIDBufferSize)
@@ -2049,7 +2030,7 @@ void WriteShareGroupCppSetupReplay(ReplayWriter &replayWriter,
                                    uint32_t frameCount,
                                    const std::vector<CallCapture> &setupCalls,
                                    ResourceTracker *resourceTracker,
-                                   std::vector<uint8_t> *binaryData,
+                                   BinaryDataStore *binaryData,
                                    bool serializeStateEnabled,
                                    gl::ContextID windowSurfaceContextID,
                                    size_t *maxResourceIDBufferSize)
@@ -3560,6 +3541,172 @@ void CaptureTextureContents(std::vector<CallCapture> *setupCalls,
     }
 }
 
+// Reads back the contents of texture levels for mid-execution capture in batches.  Each level is
+// copied into a staging pixel pack buffer, which lets the backend record the copies of a whole
+// batch before waiting on any of them instead of stalling on every level.  The setup calls of the
+// levels are captured with placeholder data, which is filled in once their batch is read back.  A
+// batch is only read back after the next one is submitted, so that copying its data out overlaps
+// with the GPU copies of the next batch.
+class TextureReadbackBatcher final : angle::NonCopyable
+{
+  public:
+    TextureReadbackBatcher(gl::Context *context, gl::State *replayState)
+        : mContext(context), mReplayState(replayState)
+    {
+        mPackState.alignment = 1;
+    }
+
+    ~TextureReadbackBatcher()
+    {
+        ASSERT(mRecordingBatch.levels.empty());
+        ASSERT(mSubmittedBatch.levels.empty());
+    }
+
+    static bool CanBatch(const gl::InternalFormat &format)
+    {
+        // Compressed and paletted levels are read back differently, and depth and stencil cannot
+        // be copied to a buffer by the GPU.
+        return !format.compressed && !format.paletted && format.depthBits == 0 &&
+               format.stencilBits == 0;
+    }
+
+    void addLevel(const CallVector &callVector,
+                  gl::Texture *texture,
+                  const gl::ImageIndex &index,
+                  const gl::ImageDesc &desc);
+
+    // Reads back all the levels added so far and fills in their setup calls.
+    void finish();
+
+  private:
+    struct PendingLevel
+    {
+        const gl::Texture *texture;
+        gl::ImageIndex index;
+        gl::ImageDesc desc;
+        size_t offset;
+        size_t size;
+        // The placeholder calls to fill in, each as a call list and an index in it.
+        std::vector<std::pair<std::vector<CallCapture> *, size_t>> placeholders;
+    };
+
+    struct Batch
+    {
+        gl::Buffer *buffer = nullptr;
+        size_t capacity    = 0;
+        size_t size        = 0;
+        std::vector<PendingLevel> levels;
+    };
+
+    void submitRecordingBatch();
+    void completeBatch(Batch *batch);
+
+    gl::Context *mContext;
+    gl::State *mReplayState;
+    gl::PixelPackState mPackState;
+    Batch mRecordingBatch;
+    Batch mSubmittedBatch;
+};
+
+void TextureReadbackBatcher::addLevel(const CallVector &callVector,
+                                      gl::Texture *texture,
+                                      const gl::ImageIndex &index,
+                                      const gl::ImageDesc &desc)
+{
+    const gl::InternalFormat &format = *desc.format.info;
+    const gl::Extents extents(desc.size.width, desc.size.height, desc.size.depth);
+
+    GLuint endByte = 0;
+    bool result = format.computePackUnpackEndByte(format.type, extents, mPackState, true, &endByte);
+    ASSERT(result);
+
+    // Keep the levels aligned to their pixel size, which the GPU copies need.
+    size_t offset = rx::roundUp<size_t>(mRecordingBatch.size, format.pixelBytes * kBinaryAlignment);
+    if (mRecordingBatch.buffer != nullptr && offset + endByte > mRecordingBatch.capacity)
+    {
+        submitRecordingBatch();
+        offset = 0;
+    }
+
+    if (mRecordingBatch.buffer == nullptr)
+    {
+        mRecordingBatch.capacity = std::max<size_t>(kTextureReadbackBatchSize, endByte);
+        mRecordingBatch.buffer   = new gl::Buffer(mContext->getImplementation(),
+                                                  {std::numeric_limits<GLuint>::max()});
+        mRecordingBatch.buffer->addRef();
+        (void)mRecordingBatch.buffer->bufferData(
+            mContext, gl::BufferBinding::PixelPack, nullptr,
+            static_cast<GLsizeiptr>(mRecordingBatch.capacity), gl::BufferUsage::StreamRead);
+    }
+
+    (void)texture->getTexImage(mContext, mPackState, mRecordingBatch.buffer, index.getTarget(),
+                               index.getLevelIndex(), format.format, format.type,
+                               reinterpret_cast<void *>(offset));
+
+    PendingLevel level = {texture, index, desc, offset, endByte, {}};
+    for (std::vector<CallCapture> *calls : callVector)
+    {
+        CaptureTextureContents(calls, mReplayState, texture, index, desc, 0, nullptr);
+        level.placeholders.emplace_back(calls, calls->size() - 1);
+    }
+
+    mRecordingBatch.levels.emplace_back(std::move(level));
+    mRecordingBatch.size = offset + endByte;
+}
+
+void TextureReadbackBatcher::finish()
+{
+    if (mRecordingBatch.buffer != nullptr)
+    {
+        submitRecordingBatch();
+    }
+    if (mSubmittedBatch.buffer != nullptr)
+    {
+        completeBatch(&mSubmittedBatch);
+    }
+}
+
+void TextureReadbackBatcher::submitRecordingBatch()
+{
+    // Get the GPU started on the copies of this batch while the previous one is copied out.
+    mContext->flush();
+
+    if (mSubmittedBatch.buffer != nullptr)
+    {
+        completeBatch(&mSubmittedBatch);
+    }
+
+    mSubmittedBatch = std::move(mRecordingBatch);
+    mRecordingBatch = {};
+}
+
+void TextureReadbackBatcher::completeBatch(Batch *batch)
+{
+    gl::Buffer *buffer = batch->buffer;
+    (void)buffer->mapRange(mContext, 0, static_cast<GLsizeiptr>(batch->size), GL_MAP_READ_BIT);
+    const uint8_t *data = static_cast<const uint8_t *>(buffer->getMapPointer());
+
+    for (const PendingLevel &level : batch->levels)
+    {
+        // Only replace the parameters, as the placeholder calls may have been updated since.
+        for (const auto &[calls, callIndex] : level.placeholders)
+        {
+            std::vector<CallCapture> levelCalls;
+            CaptureTextureContents(&levelCalls, mReplayState, level.texture, level.index,
+                                   level.desc, static_cast<GLuint>(level.size),
+                                   data + level.offset);
+            ASSERT(levelCalls.size() == 1);
+            (*calls)[callIndex].params = std::move(levelCalls.back().params);
+        }
+    }
+
+    GLboolean dontCare;
+    (void)buffer->unmap(mContext, &dontCare);
+    buffer->release(mContext);
+
+    *batch = {};
+}
+
 void CaptureCustomUniformBlockBinding(const CallCapture &callIn, std::vector<CallCapture> &callsOut)
 {
     const ParamBuffer &paramsIn = callIn.params;
@@ -4115,7 +4262,8 @@ void CaptureShareGroupMidExecutionSetup(
     std::vector<CallCapture> *setupCalls,
     ResourceTracker *resourceTracker,
     gl::State &replayState,
-    const PackedEnumMap<ResourceIDType, uint32_t> &maxAccessedResourceIDs)
+    const PackedEnumMap<ResourceIDType, uint32_t> &maxAccessedResourceIDs,
+    PackedEnumMap<ResourceIDType, double> *captureTimes)
 {
     FrameCaptureShared *frameCaptureShared = context->getShareGroup()->getFrameCaptureShared();
     const gl::State &apiState              = context->getState();
@@ -4123,6 +4271,14 @@ void CaptureShareGroupMidExecutionSetup(
     // Small helper function to make the code more readable.
     auto cap = [setupCalls](CallCapture &&call) { setupCalls->emplace_back(std::move(call)); };
 
+    // Accumulates the time spent since the last call into the capture time of |type|.
+    double sectionStartTime = angle::GetCurrentSystemTime();
+    auto endSection         = [captureTimes, &sectionStartTime](ResourceIDType type) {
+        const double time = angle::GetCurrentSystemTime();
+        (*captureTimes)[type] += time - sectionStartTime;
+        sectionStartTime = time;
+    };
+
     // Capture Buffer data.
     const gl::BufferManager &buffers = apiState.getBufferManagerForCapture();
     for (const auto &bufferIter : buffers)
@@ -4225,6 +4381,8 @@ void CaptureShareGroupMidExecutionSetup(
         replayState.setBufferBinding(context, gl::BufferBinding::Array, nullptr);
     }
 
+    endSection(ResourceIDType::Buffer);
+
     // Set a unpack alignment of 1. Otherwise, computeRowPitch() will compute the wrong value,
     // leading to a crash in memcpy() when capturing the texture contents.
     gl::PixelUnpackState &currentUnpackState = replayState.getUnpackState();
@@ -4264,8 +4422,11 @@ void CaptureShareGroupMidExecutionSetup(
         }
     }
 
+    endSection(ResourceIDType::Image);
+
     // Capture Texture setup and data.
     const gl::TextureManager &textures = apiState.getTextureManagerForCapture();
+    TextureReadbackBatcher textureReadbacks(context, &replayState);
 
     for (const auto &textureIter : textures)
     {
@@ -4505,6 +4666,12 @@ void CaptureShareGroupMidExecutionSetup(
                                        replayState, true, gl::TextureType::External, eglImageID));
                 }
             }
+            else if (context->getExtensions().getImageANGLE &&
+                     TextureReadbackBatcher::CanBatch(format))
+            {
+                // Use ANGLE_get_image to read back pixel data with the other levels.
+                textureReadbacks.addLevel(texSetupCalls, texture, index, desc);
+            }
             else if (context->getExtensions().getImageANGLE)
             {
                 // Use ANGLE_get_image to read back pixel data.
@@ -4589,6 +4756,9 @@ void CaptureShareGroupMidExecutionSetup(
             gl::Range<size_t>(textureSetupStart, textureSetupEnd));
     }
 
+    textureReadbacks.finish();
+    endSection(ResourceIDType::Texture);
+
     // Capture Renderbuffers.
     const gl::RenderbufferManager &renderbuffers = apiState.getRenderbufferManagerForCapture();
     FramebufferCaptureFuncs framebufferFuncs(context->isGLES1());
@@ -4643,6 +4813,8 @@ void CaptureShareGroupMidExecutionSetup(
         // TODO: Capture renderbuffer contents. http://anglebug.com/3662
     }
 
+    endSection(ResourceIDType::Renderbuffer);
+
     // Capture Shaders and Programs.
     const gl::ShaderProgramManager &shadersAndPrograms =
         apiState.getShaderProgramManagerForCapture();
@@ -4825,6 +4997,8 @@ void CaptureShareGroupMidExecutionSetup(
         resourceTracker->setShaderProgramType(id, ShaderProgramType::ShaderType);
     }
 
+    endSection(ResourceIDType::ShaderProgram);
+
     // Capture Sampler Objects
     const gl::SamplerManager &samplers = apiState.getSamplerManagerForCapture();
     for (const auto &samplerIter : samplers)
@@ -4890,6 +5064,8 @@ void CaptureShareGroupMidExecutionSetup(
         }
     }
 
+    endSection(ResourceIDType::Sampler);
+
     // Capture Sync Objects
     const gl::SyncManager &syncs = apiState.getSyncManagerForCapture();
     for (const auto &syncIter : syncs)
@@ -4909,6 +5085,8 @@ void CaptureShareGroupMidExecutionSetup(
         resourceTracker->getStartingFenceSyncs().insert(syncID);
     }
 
+    endSection(ResourceIDType::Sync);
+
     // Capture EGL Sync Objects
     const egl::SyncMap &eglSyncMap = context->getDisplay()->getSyncsForCapture();
     for (const auto &eglSyncIter : eglSyncMap)
@@ -4932,6 +5110,8 @@ void CaptureShareGroupMidExecutionSetup(
             .insert(eglSyncID.value);
     }
 
+    endSection(ResourceIDType::egl_Sync);
+
     GLint contextUnpackAlignment = context->getState().getUnpackState().alignment;
     if (currentUnpackState.alignment != contextUnpackAlignment)
     {
@@ -6053,6 +6233,21 @@ std::string GetBaseName(const std::string &nameWithPath)
     ASSERT(!result.empty());
     return result.back();
 }
+
+#if defined(ANGLE_PLATFORM_LINUX) || defined(ANGLE_PLATFORM_ANDROID)
+// The soft-dirty bit of an entry in /proc/self/pagemap.
+// See: https://www.kernel.org/doc/Documentation/admin-guide/mm/soft-dirty.rst
+constexpr uint64_t kPagemapSoftDirtyBit = uint64_t(1) << 55;
+
+// Returns the offset of the entry of a page in /proc/self/pagemap.
+off_t GetPagemapOffset(size_t page, size_t pageSize)
+{
+    // Heap pointers may be tagged in the top byte on Android, which is not part of the page.
+    constexpr uint64_t kUntaggedAddressMask = (uint64_t(1) << 56) - 1;
+    size_t untaggedPage = page & static_cast<size_t>(kUntaggedAddressMask / pageSize);
+    return static_cast<off_t>(untaggedPage * sizeof(uint64_t));
+}
+#endif
 }  // namespace
 
 FrameCapture::FrameCapture()  = default;
@@ -6064,7 +6259,8 @@ void FrameCapture::reset()
 }
 
 FrameCaptureShared::FrameCaptureShared()
-    : mEnabled(true),
+    : mBinaryDataMemoryBudget(0),
+      mEnabled(true),
       mSerializeStateEnabled(false),
       mCompression(true),
       mClientVertexArrayMap{},
@@ -6079,10 +6275,15 @@ FrameCaptureShared::FrameCaptureShared()
       mMaxAccessedResourceIDs{},
       mCaptureTrigger(0),
       mCaptureActive(false),
+      mCaptureCallTime(0),
+      mMidExecutionCaptureTimes{},
       mWindowSurfaceContextID({0})
 {
     reset();
 
+    mReplayWriter.setFileWriter(&mFileWriter);
+    setMemoryBudget(kDefaultMemoryBudgetMB * 1024 * 1024);
+
     std::string enabledFromEnv =
         GetEnvironmentVarOrUnCachedAndroidProperty(kEnabledVarName, kAndroidEnabled);
     if (enabledFromEnv == "0")
@@ -6199,6 +6400,44 @@ FrameCaptureShared::FrameCaptureShared()
         mCoherentBufferTracker.enableShadowMemory();
     }
 
+    std::string softDirtyFromEnv =
+        GetEnvironmentVarOrUnCachedAndroidProperty(kSoftDirtyVarName, kAndroidSoftDirty);
+    if (softDirtyFromEnv == "1")
+    {
+        if (mCoherentBufferTracker.enableSoftDirtyTracking())
+        {
+            INFO() << "Using soft-dirty page tracking and shadow memory for coherent buffers.";
+        }
+        else
+        {
+            WARN() << "Soft-dirty page tracking is not supported, using memory protection for "
+                      "coherent buffers.";
+        }
+    }
+
+    std::string coherentDiffFromEnv =
+        GetEnvironmentVarOrUnCachedAndroidProperty(kCoherentDiffVarName, kAndroidCoherentDiff);
+    if (coherentDiffFromEnv == "0")
+    {
+        INFO() << "Capturing whole dirty pages of coherent buffers.";
+        mCoherentBufferTracker.disableDiff();
+    }
+
+    std::string memoryBudgetFromEnv =
+        GetEnvironmentVarOrUnCachedAndroidProperty(kMemoryBudgetVarName, kAndroidMemoryBudget);
+    if (!memoryBudgetFromEnv.empty())
+    {
+        int memoryBudget = atoi(memoryBudgetFromEnv.c_str());
+        if (memoryBudget <= 0)
+        {
+            WARN() << "Invalid capture memory budget: " << memoryBudgetFromEnv;
+        }
+        else
+        {
+            setMemoryBudget(static_cast<size_t>(memoryBudget) * 1024 * 1024);
+        }
+    }
+
     if (mFrameIndex == mCaptureStartFrame)
     {
         // Capture is starting from the first frame, so set the capture active to ensure all GLES
@@ -6259,8 +6498,10 @@ uintptr_t AddressRange::end()
 CoherentBuffer::CoherentBuffer(uintptr_t start,
                                size_t size,
                                size_t pageSize,
-                               bool isShadowMemoryEnabled)
+                               bool isShadowMemoryEnabled,
+                               bool useProtection)
     : mPageSize(pageSize),
+      mProtectionEnabled(useProtection),
       mShadowMemoryEnabled(isShadowMemoryEnabled),
       mBufferStart(start),
       mShadowMemory(nullptr),
@@ -6356,6 +6597,42 @@ AddressRange CoherentBuffer::getDirtyAddressRange(const PageRange &dirtyPageRang
     return range;
 }
 
+std::vector<AddressRange> CoherentBuffer::getChangedAddressRanges(const PageRange &dirtyPageRange)
+{
+    AddressRange dirtyRange = getDirtyAddressRange(dirtyPageRange);
+
+    if (!mCapturedMemory.isInitialized())
+    {
+        mCapturedMemory.init(mRange.size, mPageCount);
+    }
+
+    std::vector<ByteRange> changedByteRanges;
+    mCapturedMemory.capture(reinterpret_cast<const uint8_t *>(dirtyRange.start),
+                            dirtyRange.start - mRange.start, dirtyRange.size, dirtyPageRange.start,
+                            dirtyPageRange.end, &changedByteRanges);
+
+    std::vector<AddressRange> changedRanges;
+    for (const ByteRange &byteRange : changedByteRanges)
+    {
+        changedRanges.emplace_back(mRange.start + byteRange.offset, byteRange.size);
+    }
+    return changedRanges;
+}
+
+void CoherentBuffer::invalidateCapturedData(size_t offset, size_t size)
+{
+    ASSERT(offset + size <= mRange.size);
+    if (size == 0)
+    {
+        return;
+    }
+
+    size_t protectionOffset = mRange.start + offset - mProtectionRange.start;
+    size_t startPage        = protectionOffset / mPageSize;
+    size_t endPage          = rx::roundUpPow2(protectionOffset + size, mPageSize) / mPageSize;
+    mCapturedMemory.invalidatePages(startPage, endPage);
+}
+
 CoherentBuffer::~CoherentBuffer()
 {
     if (mShadowMemory != nullptr)
@@ -6430,6 +6707,12 @@ void CoherentBuffer::setDirty(size_t relativePage, bool dirty)
         ASSERT(mProtectionRange.end() == pageStart + mPageSize);
     }
 
+    if (!mProtectionEnabled)
+    {
+        mDirtyPages[relativePage] = dirty;
+        return;
+    }
+
     bool ret;
     if (dirty)
     {
@@ -6450,6 +6733,11 @@ void CoherentBuffer::setDirty(size_t relativePage, bool dirty)
 
 void CoherentBuffer::removeProtection(PageSharingType sharingType)
 {
+    if (!mProtectionEnabled)
+    {
+        return;
+    }
+
     uintptr_t start = mProtectionRange.start;
     size_t size     = mProtectionRange.size;
 
@@ -6568,7 +6856,13 @@ bool CoherentBufferTracker::canProtectDirectly(gl::Context *context)
     return canProtect;
 }
 
-CoherentBufferTracker::CoherentBufferTracker() : mEnabled(false), mShadowMemoryEnabled(false)
+CoherentBufferTracker::CoherentBufferTracker()
+    : mEnabled(false),
+      mShadowMemoryEnabled(false),
+      mSoftDirtyEnabled(false),
+      mDiffEnabled(true),
+      mPagemapFd(-1),
+      mClearRefsFd(-1)
 {
     mPageSize = GetPageSize();
 }
@@ -6576,6 +6870,109 @@ CoherentBufferTracker::CoherentBufferTracker() : mEnabled(false), mShadowMemoryE
 CoherentBufferTracker::~CoherentBufferTracker()
 {
     disable();
+
+#if defined(ANGLE_PLATFORM_LINUX) || defined(ANGLE_PLATFORM_ANDROID)
+    if (mPagemapFd >= 0)
+    {
+        close(mPagemapFd);
+    }
+    if (mClearRefsFd >= 0)
+    {
+        close(mClearRefsFd);
+    }
+#endif
+}
+
+bool CoherentBufferTracker::enableSoftDirtyTracking()
+{
+#if defined(ANGLE_PLATFORM_LINUX) || defined(ANGLE_PLATFORM_ANDROID)
+    mPagemapFd   = open("/proc/self/pagemap", O_RDONLY | O_CLOEXEC);
+    mClearRefsFd = open("/proc/self/clear_refs", O_WRONLY | O_CLOEXEC);
+
+    // Kernels built without CONFIG_MEM_SOFT_DIRTY accept clearing the bits but never set them, so
+    // check that a write to a test page is seen.
+    bool supported = false;
+    if (mPagemapFd >= 0 && mClearRefsFd >= 0)
+    {
+        volatile uint8_t *testPage = static_cast<uint8_t *>(AlignedAlloc(mPageSize, mPageSize));
+        testPage[0]                = 1;
+        clearSoftDirtyBits();
+        testPage[0] = 2;
+
+        size_t page    = reinterpret_cast<uintptr_t>(testPage) / mPageSize;
+        off_t offset   = GetPagemapOffset(page, mPageSize);
+        uint64_t entry = 0;
+        ssize_t result = pread(mPagemapFd, &entry, sizeof(entry), offset);
+        supported      = result == static_cast<ssize_t>(sizeof(entry)) &&
+                    (entry & kPagemapSoftDirtyBit) != 0;
+        AlignedFree(const_cast<uint8_t *>(testPage));
+    }
+
+    if (!supported)
+    {
+        return false;
+    }
+
+    // The kernel does not track the soft-dirty bits of the graphics memory mapped by the driver,
+    // so the app writes to shadow memory instead.
+    mSoftDirtyEnabled    = true;
+    mShadowMemoryEnabled = true;
+    return true;
+#else
+    return false;
+#endif
+}
+
+void CoherentBufferTracker::clearSoftDirtyBits()
+{
+#if defined(ANGLE_PLATFORM_LINUX) || defined(ANGLE_PLATFORM_ANDROID)
+    // This clears the bits of the whole process, so the bits of all buffers must have been read
+    // before.
+    if (write(mClearRefsFd, "4", 1) != 1)
+    {
+        ERR() << "Could not clear the soft-dirty bits: " << strerror(errno);
+    }
+#endif
+}
+
+void CoherentBufferTracker::updateSoftDirtyPages()
+{
+#if defined(ANGLE_PLATFORM_LINUX) || defined(ANGLE_PLATFORM_ANDROID)
+    ASSERT(mSoftDirtyEnabled);
+
+    std::vector<uint64_t> entries;
+    bool anyDirty = false;
+
+    for (const auto &pair : mBuffers)
+    {
+        std::shared_ptr<CoherentBuffer> buffer = pair.second;
+        PageRange pages                        = buffer->getProtectionPageRange();
+
+        entries.resize(pages.end - pages.start);
+        size_t size  = entries.size() * sizeof(uint64_t);
+        off_t offset = GetPagemapOffset(pages.start, mPageSize);
+        if (pread(mPagemapFd, entries.data(), size, offset) != static_cast<ssize_t>(size))
+        {
+            // Capture the whole buffer rather than miss an update.
+            ERR() << "Could not read the soft-dirty bits of buffer " << pair.first;
+            entries.assign(entries.size(), kPagemapSoftDirtyBit);
+        }
+
+        for (size_t relativePage = 0; relativePage < entries.size(); relativePage++)
+        {
+            if ((entries[relativePage] & kPagemapSoftDirtyBit) != 0)
+            {
+                buffer->setDirty(relativePage, true);
+                anyDirty = true;
+            }
+        }
+    }
+
+    if (anyDirty)
+    {
+        clearSoftDirtyBits();
+    }
+#endif
 }
 
 PageFaultHandlerRangeType CoherentBufferTracker::handleWrite(uintptr_t address)
@@ -6651,6 +7048,13 @@ void CoherentBufferTracker::enable()
         return;
     }
 
+    if (mSoftDirtyEnabled)
+    {
+        // Writes are not trapped, the dirty pages are read from the kernel when capturing.
+        mEnabled = true;
+        return;
+    }
+
     PageFaultCallback callback = [this](uintptr_t address) { return handleWrite(address); };
 
     // This needs to be initialized after canProtectDirectly ran and can only be initialized once.
@@ -6701,7 +7105,7 @@ void CoherentBufferTracker::disable()
         return;
     }
 
-    if (mPageFaultHandler->disable())
+    if (mSoftDirtyEnabled || mPageFaultHandler->disable())
     {
         mEnabled = false;
     }
@@ -6727,7 +7131,8 @@ uintptr_t CoherentBufferTracker::addBuffer(gl::BufferID id, uintptr_t start, siz
         return buffer->getRange().start;
     }
 
-    auto buffer = std::make_shared<CoherentBuffer>(start, size, mPageSize, mShadowMemoryEnabled);
+    auto buffer = std::make_shared<CoherentBuffer>(start, size, mPageSize, mShadowMemoryEnabled,
+                                                   !mSoftDirtyEnabled);
     uintptr_t realOrShadowStart = buffer->getRange().start;
 
     mBuffers.insert(std::make_pair(id.value, std::move(buffer)));
@@ -6737,6 +7142,14 @@ uintptr_t CoherentBufferTracker::addBuffer(gl::BufferID id, uintptr_t start, siz
 
 void CoherentBufferTracker::maybeUpdateShadowMemory()
 {
+    // Keep the pages the app wrote dirty, as updating the shadow memory sets the soft-dirty bits
+    // of the pages it writes, which are cleared below.
+    if (mSoftDirtyEnabled)
+    {
+        updateSoftDirtyPages();
+    }
+
+    bool anyUpdated = false;
     for (const auto &pair : mBuffers)
     {
         std::shared_ptr<CoherentBuffer> cb = pair.second;
@@ -6745,8 +7158,14 @@ void CoherentBufferTracker::maybeUpdateShadowMemory()
             cb->removeProtection(PageSharingType::NoneShared);
             cb->updateShadowMemory();
             cb->protectAll();
+            anyUpdated = true;
         }
     }
+
+    if (mSoftDirtyEnabled && anyUpdated)
+    {
+        clearSoftDirtyBits();
+    }
 }
 
 void CoherentBufferTracker::markAllShadowDirty()
@@ -6758,6 +7177,44 @@ void CoherentBufferTracker::markAllShadowDirty()
     }
 }
 
+void CoherentBufferTracker::invalidateCapturedData(gl::Buffer *buffer,
+                                                   GLintptr offset,
+                                                   GLsizeiptr size)
+{
+    if (!mDiffEnabled || buffer == nullptr || !haveBuffer(buffer->id()))
+    {
+        return;
+    }
+
+    // Only the part of the write inside the mapped range is tracked.
+    GLint64 mapStart = buffer->getMapOffset();
+    GLint64 mapEnd   = mapStart + buffer->getMapLength();
+    GLint64 start    = std::max<GLint64>(offset, mapStart);
+    GLint64 end      = std::min<GLint64>(offset + size, mapEnd);
+    if (start >= end)
+    {
+        return;
+    }
+
+    std::shared_ptr<CoherentBuffer> cb = mBuffers[buffer->id().value];
+    cb->invalidateCapturedData(static_cast<size_t>(start - mapStart),
+                               static_cast<size_t>(end - start));
+}
+
+void CoherentBufferTracker::invalidateAllCapturedData()
+{
+    if (!mDiffEnabled)
+    {
+        return;
+    }
+
+    for (const auto &pair : mBuffers)
+    {
+        std::shared_ptr<CoherentBuffer> cb = pair.second;
+        cb->invalidateCapturedData(0, cb->getRange().size);
+    }
+}
+
 PageSharingType CoherentBufferTracker::doesBufferSharePage(gl::BufferID id)
 {
     bool firstPageShared = false;
@@ -7369,6 +7826,11 @@ void FrameCaptureShared::maybeCaptureCoherentBuffers(const gl::Context *context)
 
     std::lock_guard<angle::SimpleMutex> lock(mCoherentBufferTracker.mMutex);
 
+    if (mCoherentBufferTracker.isSoftDirtyEnabled())
+    {
+        mCoherentBufferTracker.updateSoftDirtyPages();
+    }
+
     for (const auto &pair : mCoherentBufferTracker.mBuffers)
     {
         gl::BufferID id = {pair.first};
@@ -8322,6 +8784,8 @@ void FrameCaptureShared::captureCall(gl::Context *context, CallCapture &&inCall,
         return;
     }
 
+    const double startTime = angle::GetCurrentSystemTime();
+
     if (isCallValid)
     {
         // Save the call's contextID
@@ -8394,6 +8858,8 @@ void FrameCaptureShared::captureCall(gl::Context *context, CallCapture &&inCall,
             INFO() << msg.str();
         }
     }
+
+    mCaptureCallTime += angle::GetCurrentSystemTime() - startTime;
 }
 
 void FrameCaptureShared::maybeCapturePostCallUpdates(const gl::Context *context)
@@ -8472,6 +8938,21 @@ void FrameCaptureShared::maybeCapturePostCallUpdates(const gl::Context *context)
                     cb->protectAll();
                 }
             }
+
+            // The replay writes these bytes with the captured call rather than through the
+            // mapping, so the next snapshot can't be diffed against the previous one.
+            if (lastCall.entryPoint == EntryPoint::GLBufferSubData)
+            {
+                gl::BufferBinding target =
+                    lastCall.params.getParam("targetPacked", ParamType::TBufferBinding, 0)
+                        .value.BufferBindingVal;
+                GLintptr offset =
+                    lastCall.params.getParam("offset", ParamType::TGLintptr, 1).value.GLintptrVal;
+                GLsizeiptr size = lastCall.params.getParam("size", ParamType::TGLsizeiptr, 2)
+                                      .value.GLsizeiptrVal;
+                mCoherentBufferTracker.invalidateCapturedData(
+                    context->getState().getTargetBuffer(target), offset, size);
+            }
             break;
         }
 
@@ -8494,9 +8975,20 @@ void FrameCaptureShared::maybeCapturePostCallUpdates(const gl::Context *context)
                     cb->markShadowDirty();
                 }
             }
+
+            gl::BufferBinding writeTarget =
+                lastCall.params.getParam("writeTargetPacked", ParamType::TBufferBinding, 1)
+                    .value.BufferBindingVal;
+            GLintptr writeOffset =
+                lastCall.params.getParam("writeOffset", ParamType::TGLintptr, 3).value.GLintptrVal;
+            GLsizeiptr size =
+                lastCall.params.getParam("size", ParamType::TGLsizeiptr, 4).value.GLsizeiptrVal;
+            mCoherentBufferTracker.invalidateCapturedData(
+                context->getState().getTargetBuffer(writeTarget), writeOffset, size);
             break;
         }
         case EntryPoint::GLDispatchCompute:
+        case EntryPoint::GLDispatchComputeIndirect:
         {
             // When using shadow memory, we need to mark all buffer's shadowDirty bit to true
             // so they will be synchronized with real memory on the next glFinish call.
@@ -8504,6 +8996,32 @@ void FrameCaptureShared::maybeCapturePostCallUpdates(const gl::Context *context)
             {
                 mCoherentBufferTracker.markAllShadowDirty();
             }
+
+            // Shaders may write to any buffer.
+            mCoherentBufferTracker.invalidateAllCapturedData();
+            break;
+        }
+        case EntryPoint::GLEndTransformFeedback:
+        case EntryPoint::GLPauseTransformFeedback:
+        case EntryPoint::GLMemoryBarrier:
+        case EntryPoint::GLMemoryBarrierByRegion:
+        {
+            // Transform feedback and shader writes from draws are visible to the application
+            // after these calls.
+            mCoherentBufferTracker.invalidateAllCapturedData();
+            break;
+        }
+        case EntryPoint::GLReadPixels:
+        case EntryPoint::GLReadnPixels:
+        case EntryPoint::GLReadnPixelsEXT:
+        {
+            gl::Buffer *packBuffer =
+                context->getState().getTargetBuffer(gl::BufferBinding::PixelPack);
+            if (packBuffer != nullptr)
+            {
+                mCoherentBufferTracker.invalidateCapturedData(packBuffer, 0,
+                                                              packBuffer->getSize());
+            }
             break;
         }
         default:
@@ -8597,11 +9115,28 @@ void FrameCaptureShared::captureCoherentBufferSnapshot(const gl::Context *contex
 
     AddressRange wholeRange = coherentBuffer->getRange();
 
+    std::vector<AddressRange> dirtyRanges;
     for (PageRange &pageRange : dirtyPageRanges)
     {
         // Write protect the memory already, so the app is blocked on writing during our capture
         coherentBuffer->protectPageRange(pageRange);
 
+        // Only capture the bytes that changed since the last snapshot, as apps streaming through
+        // a large buffer often touch a small part of each page.
+        if (mCoherentBufferTracker.isDiffEnabled())
+        {
+            std::vector<AddressRange> changedRanges =
+                coherentBuffer->getChangedAddressRanges(pageRange);
+            dirtyRanges.insert(dirtyRanges.end(), changedRanges.begin(), changedRanges.end());
+        }
+        else
+        {
+            dirtyRanges.push_back(coherentBuffer->getDirtyAddressRange(pageRange));
+        }
+    }
+
+    for (AddressRange &dirtyRange : dirtyRanges)
+    {
         // Create the parameters to our helper for use during replay
         ParamBuffer dataParamBuffer;
 
@@ -8611,7 +9146,6 @@ void FrameCaptureShared::captureCoherentBufferSnapshot(const gl::Context *contex
         // Capture the current buffer data with a binary param
         ParamCapture captureData("source", ParamType::TvoidConstPointer);
 
-        AddressRange dirtyRange = coherentBuffer->getDirtyAddressRange(pageRange);
         CaptureMemory(reinterpret_cast<void *>(dirtyRange.start), dirtyRange.size, &captureData);
         dataParamBuffer.addParam(std::move(captureData));
 
@@ -8769,7 +9303,8 @@ void FrameCaptureShared::runMidExecutionCapture(gl::Context *mainContext)
     mainContextReplayState.initializeForCapture(mainContext);
 
     CaptureShareGroupMidExecutionSetup(mainContext, &mShareGroupSetupCalls, &mResourceTracker,
-                                       mainContextReplayState, mMaxAccessedResourceIDs);
+                                       mainContextReplayState, mMaxAccessedResourceIDs,
+                                       &mMidExecutionCaptureTimes);
 
     scanSetupCalls(mShareGroupSetupCalls);
 
@@ -8784,10 +9319,13 @@ void FrameCaptureShared::runMidExecutionCapture(gl::Context *mainContext)
 
         if (shareContext.second->id() == mainContext->id())
         {
+            const double startTime = angle::GetCurrentSystemTime();
             CaptureMidExecutionSetup(shareContext.second, &frameCapture->getSetupCalls(),
                                      frameCapture->getStateResetHelper(), &mShareGroupSetupCalls,
                                      &mResourceIDToSetupCalls, &mResourceTracker,
                                      mainContextReplayState, mValidateSerializedState);
+            mMidExecutionCaptureTimes[ResourceIDType::Context] +=
+                angle::GetCurrentSystemTime() - startTime;
             scanSetupCalls(frameCapture->getSetupCalls());
 
             std::stringstream protoStream;
@@ -8821,10 +9359,13 @@ void FrameCaptureShared::runMidExecutionCapture(gl::Context *mainContext)
                 INFO() << "MEC unable to make secondary context current";
             }
 
+            const double startTime = angle::GetCurrentSystemTime();
             CaptureMidExecutionSetup(shareContext.second, &frameCapture->getSetupCalls(),
                                      frameCapture->getStateResetHelper(), &mShareGroupSetupCalls,
                                      &mResourceIDToSetupCalls, &mResourceTracker,
                                      auxContextReplayState, mValidateSerializedState);
+            mMidExecutionCaptureTimes[ResourceIDType::Context] +=
+                angle::GetCurrentSystemTime() - startTime;
 
             scanSetupCalls(frameCapture->getSetupCalls());
 
@@ -8842,10 +9383,22 @@ void FrameCaptureShared::runMidExecutionCapture(gl::Context *mainContext)
     {
         INFO() << "MEC unable to make main context current again";
     }
+
+    for (ResourceIDType type : AllEnums<ResourceIDType>())
+    {
+        if (mMidExecutionCaptureTimes[type] > 0)
+        {
+            INFO() << "MEC spent " << mMidExecutionCaptureTimes[type] * 1000.0 << " ms on "
+                   << GetResourceIDTypeName(type);
+        }
+    }
 }
 
 void FrameCaptureShared::onEndFrame(gl::Context *context)
 {
+    const double captureCallTime = mCaptureCallTime;
+    mCaptureCallTime             = 0;
+
     if (!enabled() || mFrameIndex > mCaptureEndFrame)
     {
         setCaptureInactive();
@@ -8893,6 +9446,7 @@ void FrameCaptureShared::onEndFrame(gl::Context *context)
     {
         mActiveFrameIndices.push_back(getReplayFrameIndex());
     }
+    mFrameCaptureCallTimes.push_back(captureCallTime);
 
     // Make sure all pending work for every Context in the share group has completed so all data
     // (buffers, textures, etc.) has been updated and no resources are in use.
@@ -8908,6 +9462,12 @@ void FrameCaptureShared::onEndFrame(gl::Context *context)
     writeMainContextCppReplay(context, frameCapture->getSetupCalls(),
                               frameCapture->getStateResetHelper());
 
+    // Write out the binary data captured so far once it goes over the budget.
+    if (mBinaryData.getResidentSize() > mBinaryDataMemoryBudget)
+    {
+        saveBinaryData(false);
+    }
+
     if (mFrameIndex == mCaptureEndFrame)
     {
         // Write shared MEC after frame sequence so we can eliminate unused assets like programs
@@ -8918,8 +9478,7 @@ void FrameCaptureShared::onEndFrame(gl::Context *context)
 
         // Save the index files after the last frame.
         writeCppReplayIndexFiles(context, false);
-        SaveBinaryData(mCompression, mOutDirectory, kSharedContextId, mCaptureLabel, mBinaryData);
-        mBinaryData.clear();
+        saveBinaryData(true);
         mWroteIndexFile = true;
     }
 
@@ -8927,6 +9486,37 @@ void FrameCaptureShared::onEndFrame(gl::Context *context)
     mFrameIndex++;
 }
 
+void FrameCaptureShared::saveBinaryData(bool flushAll)
+{
+    if (!mFileWriter.isWritingBinaryDataFile())
+    {
+        mFileWriter.beginBinaryDataFile(
+            mOutDirectory + GetBinaryDataFilePath(mCompression, mCaptureLabel), mCompression);
+    }
+
+    mBinaryData.flush(&mFileWriter, flushAll);
+
+    if (flushAll)
+    {
+        INFO() << "Saved " << mBinaryData.size() << " bytes of binary data, deduplication saved "
+               << mBinaryData.getDeduplicatedSize() << " bytes";
+
+        mFileWriter.endBinaryDataFile();
+        mBinaryData.clear();
+
+        // Make sure the capture is on disk once it is reported as complete.
+        mFileWriter.finish();
+    }
+}
+
+void FrameCaptureShared::setMemoryBudget(size_t memoryBudget)
+{
+    // The binary data that is written out moves to the file writer, so splitting the budget keeps
+    // the peak within it.
+    mBinaryDataMemoryBudget = memoryBudget / 2;
+    mFileWriter.setMemoryBudget(memoryBudget - mBinaryDataMemoryBudget);
+}
+
 void FrameCaptureShared::onDestroyContext(const gl::Context *context)
 {
     if (!mEnabled)
@@ -8941,8 +9531,7 @@ void FrameCaptureShared::onDestroyContext(const gl::Context *context)
         mFrameIndex -= 1;
         mCaptureEndFrame = mFrameIndex;
         writeCppReplayIndexFiles(context, true);
-        SaveBinaryData(mCompression, mOutDirectory, kSharedContextId, mCaptureLabel, mBinaryData);
-        mBinaryData.clear();
+        saveBinaryData(true);
         mWroteIndexFile = true;
     }
 }
@@ -8970,6 +9559,320 @@ int DataCounters::getAndIncrement(EntryPoint entryPoint, const std::string &para
     return mData[counterKey]++;
 }
 
+// Writes the binary data file, compressing it on the way if needed.
+class CaptureFileWriter::BinaryDataFile final : angle::NonCopyable
+{
+  public:
+    BinaryDataFile(const std::string &path, bool compression)
+        : mFile(path), mCompression(compression), mStream{}
+    {
+        if (mCompression)
+        {
+            // Compress the pieces into a single gzip stream, so that no contiguous copy of the
+            // whole data is needed.
+            int zResult = deflateInit2(&mStream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, MAX_WBITS + 16,
+                                       8, Z_DEFAULT_STRATEGY);
+            if (zResult != Z_OK)
+            {
+                FATAL() << "Error compressing binary data: " << zResult;
+            }
+            mCompressedData.resize(kBinaryDataCompressionBufferSize);
+        }
+    }
+
+    ~BinaryDataFile()
+    {
+        if (mCompression)
+        {
+            int zResult = compress(Z_FINISH);
+            ASSERT(zResult == Z_STREAM_END);
+            deflateEnd(&mStream);
+        }
+    }
+
+    void write(const uint8_t *data, size_t size)
+    {
+        if (!mCompression)
+        {
+            mFile.write(data, size);
+            return;
+        }
+
+        mStream.next_in  = const_cast<Bytef *>(data);
+        mStream.avail_in = static_cast<uInt>(size);
+        compress(Z_NO_FLUSH);
+    }
+
+  private:
+    int compress(int flush)
+    {
+        int zResult;
+        do
+        {
+            mStream.next_out  = mCompressedData.data();
+            mStream.avail_out = static_cast<uInt>(mCompressedData.size());
+            zResult           = deflate(&mStream, flush);
+            if (zResult != Z_OK && zResult != Z_STREAM_END && zResult != Z_BUF_ERROR)
+            {
+                FATAL() << "Error compressing binary data: " << zResult;
+            }
+            mFile.write(mCompressedData.data(), mCompressedData.size() - mStream.avail_out);
+        } while (mStream.avail_out == 0);
+        return zResult;
+    }
+
+    SaveFileHelper mFile;
+    bool mCompression;
+    z_stream mStream;
+    std::vector<uint8_t> mCompressedData;
+};
+
+CaptureFileWriter::CaptureFileWriter()
+    : mMemoryBudget(kDefaultMemoryBudgetMB * 1024 * 1024),
+      mIsWritingBinaryDataFile(false),
+      mPendingTaskCount(0),
+      mPendingSize(0),
+      mExiting(false)
+{}
+
+CaptureFileWriter::~CaptureFileWriter()
+{
+    // Complete the binary data file if the capture did not get to finish it.
+    if (mIsWritingBinaryDataFile)
+    {
+        endBinaryDataFile();
+    }
+
+    if (mThread.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mExiting = true;
+        }
+        mTaskAvailable.notify_one();
+        mThread.join();
+    }
+}
+
+void CaptureFileWriter::writeFile(const std::string &path, std::string &&contents)
+{
+    submit({TaskType::WriteFile, path, std::move(contents), nullptr, 0, false});
+}
+
+void CaptureFileWriter::beginBinaryDataFile(const std::string &path, bool compression)
+{
+    ASSERT(!mIsWritingBinaryDataFile);
+    mIsWritingBinaryDataFile = true;
+    submit({TaskType::BeginBinaryDataFile, path, std::string(), nullptr, 0, compression});
+}
+
+void CaptureFileWriter::appendBinaryData(std::unique_ptr<uint8_t[]> &&data, size_t size)
+{
+    ASSERT(mIsWritingBinaryDataFile);
+    submit(
+        {TaskType::AppendBinaryData, std::string(), std::string(), std::move(data), size, false});
+}
+
+void CaptureFileWriter::endBinaryDataFile()
+{
+    ASSERT(mIsWritingBinaryDataFile);
+    mIsWritingBinaryDataFile = false;
+    submit({TaskType::EndBinaryDataFile, std::string(), std::string(), nullptr, 0, false});
+}
+
+void CaptureFileWriter::finish()
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+    mTaskDone.wait(lock, [this] { return mPendingTaskCount == 0; });
+}
+
+void CaptureFileWriter::submit(Task &&task)
+{
+    const size_t taskSize = task.contents.size() + task.dataSize;
+
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+
+        // Let the pending work free up memory before taking more, unless there is no pending
+        // work, in which case this task is over the budget on its own.
+        mTaskDone.wait(lock, [this, taskSize] {
+            return mPendingTaskCount == 0 || mPendingSize + taskSize <= mMemoryBudget;
+        });
+
+        mTasks.push_back(std::move(task));
+        mPendingTaskCount++;
+        mPendingSize += taskSize;
+
+        // The thread is only started once there is something to write.
+        if (!mThread.joinable())
+        {
+            mThread = std::thread(&CaptureFileWriter::processTasks, this);
+        }
+    }
+
+    mTaskAvailable.notify_one();
+}
+
+void CaptureFileWriter::processTasks()
+{
+    angle::SetCurrentThreadName("ANGLE-Capture");
+
+    while (true)
+    {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mTaskAvailable.wait(lock, [this] { return !mTasks.empty() || mExiting; });
+            if (mTasks.empty())
+            {
+                return;
+            }
+            task = std::move(mTasks.front());
+            mTasks.pop_front();
+        }
+
+        const size_t taskSize = task.contents.size() + task.dataSize;
+        runTask(task);
+        // Free the memory held by the task before it is accounted for.
+        task = {};
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mPendingTaskCount--;
+            mPendingSize -= taskSize;
+        }
+        mTaskDone.notify_all();
+    }
+}
+
+void CaptureFileWriter::runTask(Task &task)
+{
+    switch (task.type)
+    {
+        case TaskType::WriteFile:
+        {
+            SaveFileHelper saveData(task.path);
+            saveData.write(reinterpret_cast<const uint8_t *>(task.contents.data()),
+                           task.contents.size());
+            break;
+        }
+        case TaskType::BeginBinaryDataFile:
+            ASSERT(!mBinaryDataFile);
+            mBinaryDataFile = std::make_unique<BinaryDataFile>(task.path, task.compression);
+            break;
+        case TaskType::AppendBinaryData:
+            mBinaryDataFile->write(task.data.get(), task.dataSize);
+            break;
+        case TaskType::EndBinaryDataFile:
+            mBinaryDataFile.reset();
+            break;
+    }
+}
+
+BinaryDataStore::BinaryDataStore() : mFlushedChunkCount(0), mSize(0), mDeduplicatedSize(0) {}
+
+BinaryDataStore::~BinaryDataStore() = default;
+
+size_t BinaryDataStore::append(const uint8_t *data, size_t size)
+{
+    // Only the whole words of the payload are hashed; the bytes are compared on a match anyway.
+    const size_t hash = ComputeGenericHash(data, size & ~size_t(3)) ^ size;
+
+    auto range = mOffsetsByHash.equal_range(hash);
+    for (auto iter = range.first; iter != range.second; ++iter)
+    {
+        if (matches(iter->second, data, size))
+        {
+            mDeduplicatedSize += size;
+            return iter->second;
+        }
+    }
+
+    // Round up to 16-byte boundary for cross ABI safety.
+    ASSERT(mFlushedChunkCount * kChunkSize <= mSize);
+    const size_t offset  = rx::roundUpPow2(mSize, kBinaryAlignment);
+    const size_t newSize = offset + size;
+    while (mChunks.size() * kChunkSize < newSize)
+    {
+        // Zero-initialized, so that the padding between payloads is deterministic.
+        mChunks.emplace_back(new uint8_t[kChunkSize]());
+    }
+
+    copy(offset, data, size);
+    mSize = newSize;
+    mOffsetsByHash.emplace(hash, offset);
+    return offset;
+}
+
+void BinaryDataStore::flush(CaptureFileWriter *writer, bool flushAll)
+{
+    const size_t chunkCount =
+        flushAll ? rx::roundUpPow2(mSize, kChunkSize) / kChunkSize : mSize / kChunkSize;
+    if (chunkCount <= mFlushedChunkCount)
+    {
+        return;
+    }
+
+    for (size_t chunkIndex = mFlushedChunkCount; chunkIndex < chunkCount; ++chunkIndex)
+    {
+        const size_t chunkSize = std::min(kChunkSize, mSize - chunkIndex * kChunkSize);
+        writer->appendBinaryData(std::move(mChunks[chunkIndex]), chunkSize);
+    }
+    mFlushedChunkCount = chunkCount;
+
+    // Forget the payloads that are no longer entirely in memory.
+    const size_t flushedSize = mFlushedChunkCount * kChunkSize;
+    for (auto iter = mOffsetsByHash.begin(); iter != mOffsetsByHash.end();)
+    {
+        iter = iter->second < flushedSize ? mOffsetsByHash.erase(iter) : std::next(iter);
+    }
+}
+
+void BinaryDataStore::clear()
+{
+    mChunks.clear();
+    mFlushedChunkCount = 0;
+    mSize              = 0;
+    mDeduplicatedSize  = 0;
+    mOffsetsByHash.clear();
+}
+
+bool BinaryDataStore::matches(size_t offset, const uint8_t *data, size_t size) const
+{
+    ASSERT(offset >= mFlushedChunkCount * kChunkSize);
+    if (offset + size > mSize)
+    {
+        return false;
+    }
+
+    while (size > 0)
+    {
+        const size_t chunkOffset = offset % kChunkSize;
+        const size_t copySize    = std::min(size, kChunkSize - chunkOffset);
+        if (memcmp(mChunks[offset / kChunkSize].get() + chunkOffset, data, copySize) != 0)
+        {
+            return false;
+        }
+        offset += copySize;
+        data += copySize;
+        size -= copySize;
+    }
+    return true;
+}
+
+void BinaryDataStore::copy(size_t offset, const uint8_t *data, size_t size)
+{
+    while (size > 0)
+    {
+        const size_t chunkOffset = offset % kChunkSize;
+        const size_t copySize    = std::min(size, kChunkSize - chunkOffset);
+        memcpy(mChunks[offset / kChunkSize].get() + chunkOffset, data, copySize);
+        offset += copySize;
+        data += copySize;
+        size -= copySize;
+    }
+}
+
 DataTracker::DataTracker() = default;
 
 DataTracker::~DataTracker() = default;
@@ -9337,14 +10240,45 @@ void FrameCaptureShared::writeJSON(const gl::Context *context)
 
     json.addScalar("WindowSurfaceContextID", contextId.value);
 
+    {
+        // The overhead of the capture on the captured application.
+        std::vector<double> captureCallTimesMs;
+        double totalCaptureCallTimeMs = 0;
+        for (double captureCallTime : mFrameCaptureCallTimes)
+        {
+            captureCallTimesMs.push_back(captureCallTime * 1000.0);
+            totalCaptureCallTimeMs += captureCallTimesMs.back();
+        }
+
+        json.startGroup("CaptureMetrics");
+        json.addVector("CaptureCallTimePerFrameMs", captureCallTimesMs);
+        json.addScalar("CaptureCallTimeTotalMs", totalCaptureCallTimeMs);
+        json.addScalar("BinaryDataSize", mBinaryData.size());
+        json.addScalar("BinaryDataDeduplicatedSize", mBinaryData.getDeduplicatedSize());
+        json.addScalar("MemoryBudget", mFileWriter.getMemoryBudget());
+        if (usesMidExecutionCapture())
+        {
+            json.startGroup("MidExecutionCaptureTimeMs");
+            for (ResourceIDType type : AllEnums<ResourceIDType>())
+            {
+                if (mMidExecutionCaptureTimes[type] > 0)
+                {
+                    json.addScalar(GetResourceIDTypeName(type),
+                                   mMidExecutionCaptureTimes[type] * 1000.0);
+                }
+            }
+            json.endGroup();
+        }
+        json.endGroup();
+    }
+
     {
         std::stringstream jsonFileNameStream;
         jsonFileNameStream << mOutDirectory << FmtCapturePrefix(kNoContextId, mCaptureLabel)
                            << ".json";
         std::string jsonFileName = jsonFileNameStream.str();
 
-        SaveFileHelper saveData(jsonFileName);
-        saveData.write(reinterpret_cast<const uint8_t *>(json.data()), json.length());
+        mFileWriter.writeFile(jsonFileName, std::string(json.data(), json.length()));
     }
 }
 
@@ -9949,7 +10883,8 @@ void CaptureShaderStrings(GLsizei count,
 ReplayWriter::ReplayWriter()
     : mSourceFileExtension(kDefaultSourceFileExt),
       mSourceFileSizeThreshold(kDefaultSourceFileSizeThreshold),
-      mFrameIndex(1)
+      mFrameIndex(1),
+      mFileWriter(nullptr)
 {}
 
 ReplayWriter::~ReplayWriter()
@@ -9995,6 +10930,11 @@ void ReplayWriter::setHeaderPrologue(const std::string &prologue)
     mHeaderPrologue = prologue;
 }
 
+void ReplayWriter::setFileWriter(CaptureFileWriter *fileWriter)
+{
+    mFileWriter = fileWriter;
+}
+
 void ReplayWriter::addPublicFunction(const std::string &functionProto,
                                      const std::stringstream &headerStream,
                                      const std::stringstream &bodyStream)
@@ -10134,7 +11074,7 @@ void ReplayWriter::saveHeader()
     headerPathStream << mFilenamePattern << ".h";
     std::string headerPath = headerPathStream.str();
 
-    SaveFileHelper saveH(headerPath);
+    std::stringstream saveH;
 
     saveH << mHeaderPrologue << "\n";
 
@@ -10157,6 +11097,8 @@ void ReplayWriter::saveHeader()
         saveH << "extern " << globalVar << ";\n";
     }
 
+    mFileWriter->writeFile(headerPath, saveH.str());
+
     mPublicFunctionPrototypes.clear();
     mPrivateFunctionPrototypes.clear();
     mGlobalVariableDeclarations.clear();
@@ -10190,7 +11132,7 @@ void ReplayWriter::saveSetupFile()
 
 void ReplayWriter::writeReplaySource(const std::string &filename)
 {
-    SaveFileHelper saveCpp(filename);
+    std::stringstream saveCpp;
 
     saveCpp << mSourcePrologue << "\n";
     for (const std::string &header : mReplayHeaders)
@@ -10225,6 +11167,8 @@ void ReplayWriter::writeReplaySource(const std::string &filename)
         saveCpp << "}  // extern \"C\"\n";
     }
 
+    mFileWriter->writeFile(filename, saveCpp.str());
+
     mReplayHeaders.clear();
     mPrivateFunctions.clear();
     mPublicFunctions.clear();
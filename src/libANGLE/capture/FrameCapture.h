@@ -10,9 +10,15 @@
 #ifndef LIBANGLE_FRAME_CAPTURE_H_
 #define LIBANGLE_FRAME_CAPTURE_H_
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
 #include "common/PackedEnums.h"
 #include "common/SimpleMutex.h"
 #include "common/frame_capture_utils.h"
+#include "common/memory_diff_utils.h"
 #include "common/system_utils.h"
 #include "libANGLE/Context.h"
 #include "libANGLE/ShareGroup.h"
@@ -71,6 +77,115 @@ class DataTracker final : angle::NonCopyable
     StringCounters mStringCounters;
 };
 
+// Writes the files of a capture on a background thread, so that the GL thread neither waits on the
+// file system nor compresses the binary data.  The work is done in the order it is submitted.  The
+// memory held by the pending work is limited to a budget; once it is reached, submitting more work
+// waits for the pending work to make progress.
+class CaptureFileWriter final : angle::NonCopyable
+{
+  public:
+    CaptureFileWriter();
+    ~CaptureFileWriter();
+
+    void setMemoryBudget(size_t memoryBudget) { mMemoryBudget = memoryBudget; }
+    size_t getMemoryBudget() const { return mMemoryBudget; }
+
+    void writeFile(const std::string &path, std::string &&contents);
+
+    // The binary data file is written in pieces, and is gzip compressed if |compression| is set.
+    void beginBinaryDataFile(const std::string &path, bool compression);
+    bool isWritingBinaryDataFile() const { return mIsWritingBinaryDataFile; }
+    void appendBinaryData(std::unique_ptr<uint8_t[]> &&data, size_t size);
+    void endBinaryDataFile();
+
+    // Waits for all the submitted work to be done.
+    void finish();
+
+  private:
+    class BinaryDataFile;
+
+    enum class TaskType
+    {
+        WriteFile,
+        BeginBinaryDataFile,
+        AppendBinaryData,
+        EndBinaryDataFile,
+    };
+
+    struct Task
+    {
+        TaskType type;
+        std::string path;
+        std::string contents;
+        std::unique_ptr<uint8_t[]> data;
+        size_t dataSize;
+        bool compression;
+    };
+
+    void submit(Task &&task);
+    void processTasks();
+    void runTask(Task &task);
+
+    size_t mMemoryBudget;
+    bool mIsWritingBinaryDataFile;
+
+    // Only accessed by the writer thread.
+    std::unique_ptr<BinaryDataFile> mBinaryDataFile;
+
+    std::thread mThread;
+    std::mutex mMutex;
+    std::condition_variable mTaskAvailable;
+    std::condition_variable mTaskDone;
+    std::deque<Task> mTasks;
+    // The tasks that are queued or running, and the memory they hold.
+    size_t mPendingTaskCount;
+    size_t mPendingSize;
+    bool mExiting;
+};
+
+// The binary data of a replay, which is saved to its .angledata file and referenced from the
+// replay source by offset.  Identical payloads, such as an atlas uploaded again on every level
+// load, are only stored once.  The data is kept in fixed-size chunks so that the data captured so
+// far never has to be moved as it grows, and so that the chunks that are complete can be written
+// to the file before the capture ends.  Payloads are only deduplicated against the data that is
+// still in memory.
+class BinaryDataStore final : angle::NonCopyable
+{
+  public:
+    static constexpr size_t kChunkSize = 16 * 1024 * 1024;
+
+    BinaryDataStore();
+    ~BinaryDataStore();
+
+    // Returns the offset in the file of a copy of |size| bytes of |data|.
+    size_t append(const uint8_t *data, size_t size);
+
+    // Hands the complete chunks to |writer|, or all of them if |flushAll| is set, after which no
+    // more data may be appended until the store is cleared.
+    void flush(CaptureFileWriter *writer, bool flushAll);
+
+    void clear();
+
+    // The size of the file.
+    size_t size() const { return mSize; }
+    // The size of the chunks that are still in memory.
+    size_t getResidentSize() const { return (mChunks.size() - mFlushedChunkCount) * kChunkSize; }
+    // The number of bytes that were not stored because identical data was already in the store.
+    size_t getDeduplicatedSize() const { return mDeduplicatedSize; }
+
+  private:
+    bool matches(size_t offset, const uint8_t *data, size_t size) const;
+    void copy(size_t offset, const uint8_t *data, size_t size);
+
+    // Chunks that were flushed are null.
+    std::vector<std::unique_ptr<uint8_t[]>> mChunks;
+    size_t mFlushedChunkCount;
+    size_t mSize;
+    size_t mDeduplicatedSize;
+    // The offsets of the payloads in memory, by hash of their contents.
+    std::unordered_multimap<size_t, size_t> mOffsetsByHash;
+};
+
 class ReplayWriter final : angle::NonCopyable
 {
   public:
@@ -83,6 +198,7 @@ class ReplayWriter final : angle::NonCopyable
     void setCaptureLabel(const std::string &label);
     void setSourcePrologue(const std::string &prologue);
     void setHeaderPrologue(const std::string &prologue);
+    void setFileWriter(CaptureFileWriter *fileWriter);
 
     void addPublicFunction(const std::string &functionProto,
                            const std::stringstream &headerStream,
@@ -116,6 +232,7 @@ class ReplayWriter final : angle::NonCopyable
     size_t mSourceFileSizeThreshold;
     size_t mFrameIndex;
 
+    CaptureFileWriter *mFileWriter;
     DataTracker mDataTracker;
     std::string mFilenamePattern;
     std::string mCaptureLabel;
@@ -472,7 +589,11 @@ enum class PageSharingType
 class CoherentBuffer
 {
   public:
-    CoherentBuffer(uintptr_t start, size_t size, size_t pageSize, bool useShadowMemory);
+    CoherentBuffer(uintptr_t start,
+                   size_t size,
+                   size_t pageSize,
+                   bool useShadowMemory,
+                   bool useProtection);
     ~CoherentBuffer();
 
     // Sets the a range in the buffer clean and protects a selected range
@@ -501,6 +622,22 @@ class CoherentBuffer
     AddressRange getDirtyAddressRange(const PageRange &dirtyPageRange);
     AddressRange getRange();
 
+    // Compares the data in a dirty page range with the data returned by the previous calls and
+    // returns the address ranges that changed.  Pages that were never returned before are
+    // returned whole, as their content in the replay is unknown.
+    std::vector<AddressRange> getChangedAddressRanges(const PageRange &dirtyPageRange);
+
+    // Forgets the data returned by getChangedAddressRanges for the pages holding a range of the
+    // buffer, for when the range is written other than through the mapping.  The replay doesn't
+    // write these bytes to the mapping, so the pages are returned whole when next dirty.
+    void invalidateCapturedData(size_t offset, size_t size);
+
+    // Returns the absolute pages of the page aligned protected area
+    PageRange getProtectionPageRange()
+    {
+        return PageRange(mProtectionStartPage, mProtectionEndPage);
+    }
+
     void markShadowDirty() { mShadowDirty = true; }
     bool isShadowDirty() { return mShadowDirty; }
 
@@ -518,8 +655,12 @@ class CoherentBuffer
     size_t mPageCount;
     size_t mPageSize;
 
-    // Clean pages are protected
+    // Clean pages are protected, unless the dirty pages are tracked without protection
     std::vector<bool> mDirtyPages;
+    bool mProtectionEnabled;
+
+    // Data as of the last call to getChangedAddressRanges
+    CapturedMemory mCapturedMemory;
 
     // shadow memory releated fields
     bool mShadowMemoryEnabled;
@@ -543,6 +684,19 @@ class CoherentBufferTracker final : angle::NonCopyable
     bool haveBuffer(gl::BufferID id);
     bool isShadowMemoryEnabled() { return mShadowMemoryEnabled; }
     void enableShadowMemory() { mShadowMemoryEnabled = true; }
+    // Tracks the dirty pages with the soft-dirty bits of the kernel instead of memory protection.
+    // Returns false if the platform does not support it.
+    bool enableSoftDirtyTracking();
+    bool isSoftDirtyEnabled() { return mSoftDirtyEnabled; }
+    // Marks the pages written since the last call dirty, when using soft-dirty tracking
+    void updateSoftDirtyPages();
+    bool isDiffEnabled() { return mDiffEnabled; }
+    void disableDiff() { mDiffEnabled = false; }
+    // Invalidates the captured data of buffers written by GL commands, see
+    // CoherentBuffer::invalidateCapturedData.  The range is relative to the start of the buffer.
+    void invalidateCapturedData(gl::Buffer *buffer, GLintptr offset, GLsizeiptr size);
+    // Same for all buffers, for writes whose destination isn't tracked, like shader writes.
+    void invalidateAllCapturedData();
     void maybeUpdateShadowMemory();
     void markAllShadowDirty();
     // Determine whether memory protection can be used directly on graphics memory
@@ -556,6 +710,7 @@ class CoherentBufferTracker final : angle::NonCopyable
     // For addresses that are in a page shared by 2 buffers, 2 results are returned.
     HashMap<std::shared_ptr<CoherentBuffer>, size_t> getBufferPagesForAddress(uintptr_t address);
     PageFaultHandlerRangeType handleWrite(uintptr_t address);
+    void clearSoftDirtyBits();
 
   public:
     angle::SimpleMutex mMutex;
@@ -567,6 +722,12 @@ class CoherentBufferTracker final : angle::NonCopyable
     size_t mPageSize;
 
     bool mShadowMemoryEnabled;
+    bool mSoftDirtyEnabled;
+    bool mDiffEnabled;
+
+    // /proc/self/pagemap and /proc/self/clear_refs, when using soft-dirty tracking
+    int mPagemapFd;
+    int mClearRefsFd;
 };
 
 // Shared class for any items that need to be tracked by FrameCapture across shared contexts
@@ -727,6 +888,8 @@ class FrameCaptureShared final : angle::NonCopyable
     void writeMainContextCppReplay(const gl::Context *context,
                                    const std::vector<CallCapture> &setupCalls,
                                    StateResetHelper &StateResetHelper);
+    void saveBinaryData(bool flushAll);
+    void setMemoryBudget(size_t memoryBudget);
 
     void captureClientArraySnapshot(const gl::Context *context,
                                     size_t vertexCount,
@@ -773,7 +936,12 @@ class FrameCaptureShared final : angle::NonCopyable
 
     // We save one large buffer of binary data for the whole CPP replay.
     // This simplifies a lot of file management.
-    std::vector<uint8_t> mBinaryData;
+    BinaryDataStore mBinaryData;
+
+    // Writes the replay files and the binary data in the background.
+    CaptureFileWriter mFileWriter;
+    // The binary data is written out once it holds more memory than this.
+    size_t mBinaryDataMemoryBudget;
 
     bool mEnabled;
     bool mSerializeStateEnabled;
@@ -810,6 +978,13 @@ class FrameCaptureShared final : angle::NonCopyable
     bool mCaptureActive;
     std::vector<uint32_t> mActiveFrameIndices;
 
+    // Time spent in captureCall() during the current frame, and during each captured frame, in
+    // seconds.
+    double mCaptureCallTime;
+    std::vector<double> mFrameCaptureCallTimes;
+    // Time spent capturing the initial state of each type of resource in mid-execution capture.
+    PackedEnumMap<ResourceIDType, double> mMidExecutionCaptureTimes;
+
     // Cache most recently compiled and linked sources.
     ShaderSourceMap mCachedShaderSource;
     ProgramSourceMap mCachedProgramSources;
@@ -24,6 +24,12 @@ TrackedResource::TrackedResource() {}
 TrackedResource::~TrackedResource() {}
 StateResetHelper::StateResetHelper() {}
 StateResetHelper::~StateResetHelper() {}
+class CaptureFileWriter::BinaryDataFile final : angle::NonCopyable
+{};
+CaptureFileWriter::CaptureFileWriter() {}
+CaptureFileWriter::~CaptureFileWriter() {}
+BinaryDataStore::BinaryDataStore() {}
+BinaryDataStore::~BinaryDataStore() {}
 DataTracker::DataTracker() {}
 DataTracker::~DataTracker() {}
 DataCounters::DataCounters() {}
@@ -0,0 +1,195 @@
+//
+// Copyright 2024 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// FrameCapture_unittest.cpp:
+//   Tests that the binary data of a capture is saved to its .angledata file as it was appended.
+//
+
+#include <gtest/gtest.h>
+#include <zlib.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+
+#include "common/system_utils.h"
+#include "libANGLE/capture/FrameCapture.h"
+#include "util/test_utils.h"
+
+namespace angle
+{
+namespace
+{
+constexpr size_t kChunkSize = BinaryDataStore::kChunkSize;
+
+// Makes |size| bytes that differ for each |seed|.
+std::vector<uint8_t> MakePayload(size_t size, uint32_t seed)
+{
+    std::vector<uint8_t> payload(size);
+    for (size_t index = 0; index < size; ++index)
+    {
+        payload[index] = static_cast<uint8_t>((index * 31 + seed) ^ (index >> 12) ^ (seed >> 8));
+    }
+    return payload;
+}
+
+class BinaryDataStoreTest : public ::testing::TestWithParam<bool>
+{
+  protected:
+    void SetUp() override
+    {
+        Optional<std::string> path = CreateTemporaryFile();
+        ASSERT_TRUE(path.valid());
+        mPath = path.value();
+        mWriter.beginBinaryDataFile(mPath, GetParam());
+    }
+
+    void TearDown() override { DeleteSystemFile(mPath.c_str()); }
+
+    // Appends |payload| to the store, and where it is stored to the expected file contents.
+    size_t append(const std::vector<uint8_t> &payload)
+    {
+        const size_t offset = mStore.append(payload.data(), payload.size());
+        if (offset + payload.size() > mExpected.size())
+        {
+            mExpected.resize(offset + payload.size(), 0);
+        }
+        std::copy(payload.begin(), payload.end(), mExpected.begin() + offset);
+        return offset;
+    }
+
+    // Flushes the rest of the store and returns the data saved to the file.
+    std::vector<uint8_t> finish()
+    {
+        mStore.flush(&mWriter, true);
+        mWriter.endBinaryDataFile();
+        mWriter.finish();
+
+        std::ifstream file(mPath, std::ios::binary);
+        std::vector<uint8_t> fileData((std::istreambuf_iterator<char>(file)),
+                                      std::istreambuf_iterator<char>());
+        return GetParam() ? uncompress(fileData) : fileData;
+    }
+
+    std::vector<uint8_t> uncompress(const std::vector<uint8_t> &compressedData)
+    {
+        z_stream stream = {};
+        EXPECT_EQ(Z_OK, inflateInit2(&stream, MAX_WBITS + 16));
+        stream.next_in  = const_cast<Bytef *>(compressedData.data());
+        stream.avail_in = static_cast<uInt>(compressedData.size());
+
+        std::vector<uint8_t> data;
+        std::vector<uint8_t> buffer(1024 * 1024);
+        int zResult;
+        do
+        {
+            stream.next_out  = buffer.data();
+            stream.avail_out = static_cast<uInt>(buffer.size());
+            zResult          = inflate(&stream, Z_NO_FLUSH);
+            data.insert(data.end(), buffer.begin(), buffer.end() - stream.avail_out);
+        } while (zResult == Z_OK);
+
+        EXPECT_EQ(Z_STREAM_END, zResult);
+        EXPECT_EQ(0u, stream.avail_in);
+        inflateEnd(&stream);
+        return data;
+    }
+
+    std::string mPath;
+    CaptureFileWriter mWriter;
+    BinaryDataStore mStore;
+    // The payloads at their offsets, with the padding between them zeroed.
+    std::vector<uint8_t> mExpected;
+};
+
+// Tests that a flush only writes the complete chunks, and that the chunk still being filled is
+// written once the rest of the data is flushed.
+TEST_P(BinaryDataStoreTest, FlushWithPartialChunk)
+{
+    append(MakePayload(kChunkSize / 2 + 3, 1));
+    append(MakePayload(kChunkSize / 2 + 5, 2));
+    append(MakePayload(100, 3));
+    ASSERT_GT(mStore.size(), kChunkSize);
+    ASSERT_LT(mStore.size(), 2 * kChunkSize);
+
+    mStore.flush(&mWriter, false);
+    EXPECT_EQ(kChunkSize, mStore.getResidentSize());
+
+    // Nothing is written while the next chunk is incomplete.
+    mStore.flush(&mWriter, false);
+    EXPECT_EQ(kChunkSize, mStore.getResidentSize());
+
+    EXPECT_EQ(mExpected.size(), mStore.size());
+    EXPECT_EQ(mExpected, finish());
+}
+
+// Tests that payloads that were written out are no longer deduplicated, while the payloads that
+// are still in memory are.
+TEST_P(BinaryDataStoreTest, FlushForgetsWrittenPayloads)
+{
+    const std::vector<uint8_t> flushedPayload  = MakePayload(1000, 1);
+    const std::vector<uint8_t> straddlePayload = MakePayload(2000, 2);
+    const std::vector<uint8_t> residentPayload = MakePayload(3000, 3);
+
+    const size_t flushedOffset = append(flushedPayload);
+    append(MakePayload(kChunkSize - 2000, 4));
+    const size_t straddleOffset = append(straddlePayload);
+    const size_t residentOffset = append(residentPayload);
+    ASSERT_LT(straddleOffset, kChunkSize);
+    ASSERT_GT(straddleOffset + straddlePayload.size(), kChunkSize);
+    ASSERT_GE(residentOffset, kChunkSize);
+
+    // All payloads are deduplicated while they are in memory.
+    EXPECT_EQ(flushedOffset, append(flushedPayload));
+    EXPECT_EQ(straddleOffset, append(straddlePayload));
+    EXPECT_EQ(residentOffset, append(residentPayload));
+    EXPECT_EQ(flushedPayload.size() + straddlePayload.size() + residentPayload.size(),
+              mStore.getDeduplicatedSize());
+
+    mStore.flush(&mWriter, false);
+    const size_t deduplicatedSize = mStore.getDeduplicatedSize();
+
+    // The payloads that begin in the written chunk are stored again.
+    const size_t sizeBeforeReappend = mStore.size();
+    EXPECT_GE(append(flushedPayload), sizeBeforeReappend);
+    EXPECT_GE(append(straddlePayload), sizeBeforeReappend);
+    EXPECT_EQ(residentOffset, append(residentPayload));
+    EXPECT_EQ(deduplicatedSize + residentPayload.size(), mStore.getDeduplicatedSize());
+
+    EXPECT_EQ(mExpected, finish());
+}
+
+// Tests appending after a partial flush, including payloads that span several chunks.
+TEST_P(BinaryDataStoreTest, AppendAfterPartialFlush)
+{
+    append(MakePayload(kChunkSize + 7, 1));
+    mStore.flush(&mWriter, false);
+    EXPECT_EQ(kChunkSize, mStore.getResidentSize());
+
+    append(MakePayload(11, 2));
+    append(MakePayload(2 * kChunkSize + 13, 3));
+    mStore.flush(&mWriter, false);
+    EXPECT_EQ(kChunkSize, mStore.getResidentSize());
+
+    append(MakePayload(kChunkSize / 4, 4));
+    mStore.flush(&mWriter, false);
+    append(MakePayload(17, 5));
+
+    EXPECT_EQ(mExpected.size(), mStore.size());
+    EXPECT_EQ(mExpected, finish());
+}
+
+// Tests that flushing an empty store writes an empty file.
+TEST_P(BinaryDataStoreTest, FlushEmpty)
+{
+    mStore.flush(&mWriter, false);
+    EXPECT_EQ(0u, mStore.getResidentSize());
+    EXPECT_TRUE(finish().empty());
+}
+
+// Runs each test with and without compression.
+INSTANTIATE_TEST_SUITE_P(, BinaryDataStoreTest, ::testing::Bool());
+}  // namespace
+}  // namespace angle
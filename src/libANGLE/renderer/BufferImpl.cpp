@@ -8,6 +8,8 @@
 
 #include "libANGLE/renderer/BufferImpl.h"
 
+#include "libANGLE/IndexRangeCache.h"
+
 namespace rx
 {
 
@@ -31,6 +33,19 @@ angle::Result BufferImpl::setDataWithUsageFlags(const gl::Context *context,
     return setData(context, target, data, size, usage);
 }
 
+angle::Result BufferImpl::getIndexRanges(const gl::Context *context,
+                                         gl::DrawElementsType type,
+                                         bool primitiveRestartEnabled,
+                                         std::vector<gl::IndexRangeSpan> *spans)
+{
+    for (gl::IndexRangeSpan &span : *spans)
+    {
+        ANGLE_TRY(getIndexRange(context, type, span.offset, span.count, primitiveRestartEnabled,
+                                &span.range));
+    }
+    return angle::Result::Continue;
+}
+
 angle::Result BufferImpl::onLabelUpdate(const gl::Context *context)
 {
     return angle::Result::Continue;
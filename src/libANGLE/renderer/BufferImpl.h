@@ -16,11 +16,13 @@
 #include "libANGLE/Observer.h"
 
 #include <stdint.h>
+#include <vector>
 
 namespace gl
 {
 class BufferState;
 class Context;
+struct IndexRangeSpan;
 }  // namespace gl
 
 namespace rx
@@ -72,6 +74,14 @@ class BufferImpl : public angle::Subject
                                         bool primitiveRestartEnabled,
                                         gl::IndexRange *outRange) = 0;
 
+    // Fills in the ranges of several parts of the buffer, sorted by offset.  The default
+    // implementation calls getIndexRange for each of them; backends that need to map the buffer
+    // should override it to map only once.
+    virtual angle::Result getIndexRanges(const gl::Context *context,
+                                         gl::DrawElementsType type,
+                                         bool primitiveRestartEnabled,
+                                         std::vector<gl::IndexRangeSpan> *spans);
+
     virtual angle::Result getSubData(const gl::Context *context,
                                      GLintptr offset,
                                      GLsizeiptr size,
@@ -0,0 +1,518 @@
+//
+// Copyright 2024 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// copyvertex.cpp: Defines the vectorized vertex conversions used by the copyvertex.h templates
+
+#include "libANGLE/renderer/copyvertex.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <limits>
+
+#if defined(ANGLE_USE_SSE) && \
+    (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#    define ANGLE_COPY_VERTEX_SSE2 1
+#    include <emmintrin.h>
+#endif
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+#    define ANGLE_COPY_VERTEX_NEON 1
+#    include <arm_neon.h>
+#endif
+
+namespace rx
+{
+namespace priv
+{
+namespace
+{
+#if defined(ANGLE_COPY_VERTEX_SSE2) || defined(ANGLE_COPY_VERTEX_NEON)
+constexpr size_t kVectorBytes = 16;
+
+constexpr size_t GetComponentSize(VertexComponentType componentType)
+{
+    switch (componentType)
+    {
+        case VertexComponentType::Byte:
+        case VertexComponentType::UnsignedByte:
+            return 1;
+        case VertexComponentType::Short:
+        case VertexComponentType::UnsignedShort:
+            return 2;
+        default:
+            return 4;
+    }
+}
+
+// Each vertex is converted with a load of four input components and a store of four floats, which
+// may read the start of the next input vertex and write the start of the next output vertex (which
+// is converted afterwards).  Returns how many of the vertices can be converted that way without
+// accessing memory beyond the last vertex.
+size_t GetVectorizableVertexCount(size_t inputVertexSize,
+                                  size_t loadSize,
+                                  size_t outputVertexSize,
+                                  size_t stride,
+                                  size_t count)
+{
+    if (count == 0 || stride == 0)
+    {
+        return 0;
+    }
+
+    const size_t inputEnd  = (count - 1) * stride + inputVertexSize;
+    const size_t outputEnd = count * outputVertexSize;
+    if (inputEnd < loadSize || outputEnd < kVectorBytes)
+    {
+        return 0;
+    }
+
+    return std::min({count, (inputEnd - loadSize) / stride + 1,
+                     (outputEnd - kVectorBytes) / outputVertexSize + 1});
+}
+
+constexpr bool IsSigned(VertexComponentType componentType)
+{
+    return componentType == VertexComponentType::Byte ||
+           componentType == VertexComponentType::Short ||
+           componentType == VertexComponentType::Int;
+}
+
+// Normalized components are divided by the maximum value of their type, as in
+// CopyToFloatVertexData.
+constexpr float GetNormalizationDivisor(VertexComponentType componentType)
+{
+    switch (componentType)
+    {
+        case VertexComponentType::Byte:
+            return static_cast<float>(std::numeric_limits<GLbyte>::max());
+        case VertexComponentType::UnsignedByte:
+            return static_cast<float>(std::numeric_limits<GLubyte>::max());
+        case VertexComponentType::Short:
+            return static_cast<float>(std::numeric_limits<GLshort>::max());
+        case VertexComponentType::UnsignedShort:
+            return static_cast<float>(std::numeric_limits<GLushort>::max());
+        default:
+            return static_cast<float>(std::numeric_limits<GLint>::max());
+    }
+}
+
+// Components that are not in the input are replaced with 0, except for the alpha channel which is
+// 1 when the output has one.  |inputLanes| is set to a mask of the lanes that are kept.
+void GetPadding(size_t inputComponentCount,
+                size_t outputComponentCount,
+                uint32_t *inputLanes,
+                float *padding)
+{
+    for (size_t j = 0; j < 4; j++)
+    {
+        inputLanes[j] = j < inputComponentCount ? 0xFFFFFFFFu : 0;
+        padding[j]    = 0.0f;
+    }
+    if (inputComponentCount < 4 && outputComponentCount == 4)
+    {
+        padding[3] = 1.0f;
+    }
+}
+#endif
+
+#if defined(ANGLE_COPY_VERTEX_SSE2)
+template <VertexComponentType kComponentType>
+inline __m128i LoadComponents(const uint8_t *input)
+{
+    const __m128i zero = _mm_setzero_si128();
+    switch (kComponentType)
+    {
+        case VertexComponentType::Byte:
+        case VertexComponentType::UnsignedByte:
+        {
+            int32_t bytes;
+            memcpy(&bytes, input, sizeof(bytes));
+            const __m128i components = _mm_cvtsi32_si128(bytes);
+            if (kComponentType == VertexComponentType::Byte)
+            {
+                // Sign extend by moving each byte to the top of its lane.
+                const __m128i shorts = _mm_unpacklo_epi8(components, components);
+                return _mm_srai_epi32(_mm_unpacklo_epi16(shorts, shorts), 24);
+            }
+            return _mm_unpacklo_epi16(_mm_unpacklo_epi8(components, zero), zero);
+        }
+        case VertexComponentType::Short:
+        case VertexComponentType::UnsignedShort:
+        {
+            const __m128i components = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(input));
+            if (kComponentType == VertexComponentType::Short)
+            {
+                return _mm_srai_epi32(_mm_unpacklo_epi16(components, components), 16);
+            }
+            return _mm_unpacklo_epi16(components, zero);
+        }
+        default:
+            return _mm_loadu_si128(reinterpret_cast<const __m128i *>(input));
+    }
+}
+
+template <VertexComponentType kComponentType, bool kNormalized>
+size_t CopyToFloatVertexRunImpl(size_t inputComponentCount,
+                                size_t outputComponentCount,
+                                const uint8_t *input,
+                                size_t stride,
+                                size_t count,
+                                uint8_t *output)
+{
+    constexpr size_t kComponentSize = GetComponentSize(kComponentType);
+
+    const size_t outputVertexSize = outputComponentCount * sizeof(float);
+    const size_t vertexCount = GetVectorizableVertexCount(
+        inputComponentCount * kComponentSize, 4 * kComponentSize, outputVertexSize, stride, count);
+
+    alignas(16) uint32_t inputLanes[4];
+    alignas(16) float padding[4];
+    GetPadding(inputComponentCount, outputComponentCount, inputLanes, padding);
+
+    const __m128 inputMask  = _mm_load_ps(reinterpret_cast<const float *>(inputLanes));
+    const __m128 paddingVec = _mm_load_ps(padding);
+    const __m128 divisor    = _mm_set1_ps(GetNormalizationDivisor(kComponentType));
+    const __m128 minusOne   = _mm_set1_ps(-1.0f);
+    const __m128 fixedScale = _mm_set1_ps(1.0f / (1 << 16));
+
+    for (size_t i = 0; i < vertexCount; i++)
+    {
+        __m128 components = _mm_cvtepi32_ps(LoadComponents<kComponentType>(input + i * stride));
+        if (kComponentType == VertexComponentType::Fixed)
+        {
+            components = _mm_mul_ps(components, fixedScale);
+        }
+        else if (kNormalized)
+        {
+            components = _mm_div_ps(components, divisor);
+            if (IsSigned(kComponentType))
+            {
+                components = _mm_max_ps(components, minusOne);
+            }
+        }
+        components = _mm_or_ps(_mm_and_ps(components, inputMask), paddingVec);
+        _mm_storeu_ps(reinterpret_cast<float *>(output + i * outputVertexSize), components);
+    }
+
+    return vertexCount;
+}
+
+template <bool kSigned, bool kNormalized, int kShift>
+inline __m128 ConvertPackedRGB(__m128i packed)
+{
+    if (kSigned)
+    {
+        // Sign extend by moving the channel to the top of the lane.
+        __m128 value = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_slli_epi32(packed, 22 - kShift), 22));
+        if (kNormalized)
+        {
+            const __m128 minValue = _mm_set1_ps(-511.0f);
+            value                 = _mm_max_ps(value, minValue);
+            value = _mm_sub_ps(_mm_div_ps(_mm_sub_ps(value, minValue), _mm_set1_ps(511.0f)),
+                               _mm_set1_ps(1.0f));
+        }
+        return value;
+    }
+
+    __m128 value =
+        _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(packed, kShift), _mm_set1_epi32(0x3FF)));
+    if (kNormalized)
+    {
+        value = _mm_div_ps(value, _mm_set1_ps(1023.0f));
+    }
+    return value;
+}
+
+template <bool kSigned, bool kNormalized>
+inline __m128 ConvertPackedAlpha(__m128i packed)
+{
+    if (kSigned)
+    {
+        __m128 value = _mm_cvtepi32_ps(_mm_srai_epi32(packed, 30));
+        return kNormalized ? _mm_max_ps(value, _mm_set1_ps(-1.0f)) : value;
+    }
+
+    __m128 value = _mm_cvtepi32_ps(_mm_srli_epi32(packed, 30));
+    return kNormalized ? _mm_div_ps(value, _mm_set1_ps(3.0f)) : value;
+}
+
+template <bool kSigned, bool kNormalized>
+size_t CopyXYZ10W2ToXYZWFloatVertexRunImpl(const uint8_t *input,
+                                           size_t stride,
+                                           size_t count,
+                                           uint8_t *output)
+{
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        alignas(16) uint32_t packedValues[4];
+        for (size_t j = 0; j < 4; j++)
+        {
+            memcpy(&packedValues[j], input + (i + j) * stride, sizeof(uint32_t));
+        }
+        const __m128i packed = _mm_load_si128(reinterpret_cast<const __m128i *>(packedValues));
+
+        __m128 red   = ConvertPackedRGB<kSigned, kNormalized, 0>(packed);
+        __m128 green = ConvertPackedRGB<kSigned, kNormalized, 10>(packed);
+        __m128 blue  = ConvertPackedRGB<kSigned, kNormalized, 20>(packed);
+        __m128 alpha = ConvertPackedAlpha<kSigned, kNormalized>(packed);
+        _MM_TRANSPOSE4_PS(red, green, blue, alpha);
+
+        float *offsetOutput = reinterpret_cast<float *>(output) + i * 4;
+        _mm_storeu_ps(offsetOutput + 0, red);
+        _mm_storeu_ps(offsetOutput + 4, green);
+        _mm_storeu_ps(offsetOutput + 8, blue);
+        _mm_storeu_ps(offsetOutput + 12, alpha);
+    }
+    return i;
+}
+#elif defined(ANGLE_COPY_VERTEX_NEON)
+template <VertexComponentType kComponentType>
+inline float32x4_t LoadComponents(const uint8_t *input)
+{
+    switch (kComponentType)
+    {
+        case VertexComponentType::Byte:
+        case VertexComponentType::UnsignedByte:
+        {
+            uint32_t bytes;
+            memcpy(&bytes, input, sizeof(bytes));
+            if (kComponentType == VertexComponentType::Byte)
+            {
+                const int16x8_t shorts = vmovl_s8(vcreate_s8(bytes));
+                return vcvtq_f32_s32(vmovl_s16(vget_low_s16(shorts)));
+            }
+            const uint16x8_t shorts = vmovl_u8(vcreate_u8(bytes));
+            return vcvtq_f32_u32(vmovl_u16(vget_low_u16(shorts)));
+        }
+        case VertexComponentType::Short:
+        case VertexComponentType::UnsignedShort:
+        {
+            uint64_t shorts;
+            memcpy(&shorts, input, sizeof(shorts));
+            if (kComponentType == VertexComponentType::Short)
+            {
+                return vcvtq_f32_s32(vmovl_s16(vcreate_s16(shorts)));
+            }
+            return vcvtq_f32_u32(vmovl_u16(vcreate_u16(shorts)));
+        }
+        default:
+        {
+            int32_t ints[4];
+            memcpy(ints, input, sizeof(ints));
+            return vcvtq_f32_s32(vld1q_s32(ints));
+        }
+    }
+}
+
+template <VertexComponentType kComponentType, bool kNormalized>
+size_t CopyToFloatVertexRunImpl(size_t inputComponentCount,
+                                size_t outputComponentCount,
+                                const uint8_t *input,
+                                size_t stride,
+                                size_t count,
+                                uint8_t *output)
+{
+    constexpr size_t kComponentSize = GetComponentSize(kComponentType);
+
+    const size_t outputVertexSize = outputComponentCount * sizeof(float);
+    const size_t vertexCount = GetVectorizableVertexCount(
+        inputComponentCount * kComponentSize, 4 * kComponentSize, outputVertexSize, stride, count);
+
+    uint32_t inputLanes[4];
+    float padding[4];
+    GetPadding(inputComponentCount, outputComponentCount, inputLanes, padding);
+
+    const uint32x4_t inputMask   = vld1q_u32(inputLanes);
+    const float32x4_t paddingVec = vld1q_f32(padding);
+    const float32x4_t divisor    = vdupq_n_f32(GetNormalizationDivisor(kComponentType));
+    const float32x4_t minusOne   = vdupq_n_f32(-1.0f);
+    const float32x4_t fixedScale = vdupq_n_f32(1.0f / (1 << 16));
+
+    for (size_t i = 0; i < vertexCount; i++)
+    {
+        float32x4_t components = LoadComponents<kComponentType>(input + i * stride);
+        if (kComponentType == VertexComponentType::Fixed)
+        {
+            components = vmulq_f32(components, fixedScale);
+        }
+        else if (kNormalized)
+        {
+            components = vdivq_f32(components, divisor);
+            if (IsSigned(kComponentType))
+            {
+                components = vmaxq_f32(components, minusOne);
+            }
+        }
+        components = vbslq_f32(inputMask, components, paddingVec);
+        vst1q_f32(reinterpret_cast<float *>(output + i * outputVertexSize), components);
+    }
+
+    return vertexCount;
+}
+
+template <bool kSigned, bool kNormalized, int kShift>
+inline float32x4_t ConvertPackedRGB(uint32x4_t packed)
+{
+    if (kSigned)
+    {
+        // Sign extend by moving the channel to the top of the lane.
+        const int32x4_t channel =
+            vshrq_n_s32(vreinterpretq_s32_u32(vshlq_n_u32(packed, 22 - kShift)), 22);
+        float32x4_t value = vcvtq_f32_s32(channel);
+        if (kNormalized)
+        {
+            const float32x4_t minValue = vdupq_n_f32(-511.0f);
+            value                      = vmaxq_f32(value, minValue);
+            value = vsubq_f32(vdivq_f32(vsubq_f32(value, minValue), vdupq_n_f32(511.0f)),
+                              vdupq_n_f32(1.0f));
+        }
+        return value;
+    }
+
+    uint32x4_t channel = packed;
+    if constexpr (kShift > 0)
+    {
+        channel = vshrq_n_u32(packed, kShift);
+    }
+    float32x4_t value = vcvtq_f32_u32(vandq_u32(channel, vdupq_n_u32(0x3FF)));
+    if (kNormalized)
+    {
+        value = vdivq_f32(value, vdupq_n_f32(1023.0f));
+    }
+    return value;
+}
+
+template <bool kSigned, bool kNormalized>
+inline float32x4_t ConvertPackedAlpha(uint32x4_t packed)
+{
+    if (kSigned)
+    {
+        float32x4_t value = vcvtq_f32_s32(vshrq_n_s32(vreinterpretq_s32_u32(packed), 30));
+        return kNormalized ? vmaxq_f32(value, vdupq_n_f32(-1.0f)) : value;
+    }
+
+    float32x4_t value = vcvtq_f32_u32(vshrq_n_u32(packed, 30));
+    return kNormalized ? vdivq_f32(value, vdupq_n_f32(3.0f)) : value;
+}
+
+template <bool kSigned, bool kNormalized>
+size_t CopyXYZ10W2ToXYZWFloatVertexRunImpl(const uint8_t *input,
+                                           size_t stride,
+                                           size_t count,
+                                           uint8_t *output)
+{
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        uint32_t packedValues[4];
+        for (size_t j = 0; j < 4; j++)
+        {
+            memcpy(&packedValues[j], input + (i + j) * stride, sizeof(uint32_t));
+        }
+        const uint32x4_t packed = vld1q_u32(packedValues);
+
+        float32x4x4_t vertices;
+        vertices.val[0] = ConvertPackedRGB<kSigned, kNormalized, 0>(packed);
+        vertices.val[1] = ConvertPackedRGB<kSigned, kNormalized, 10>(packed);
+        vertices.val[2] = ConvertPackedRGB<kSigned, kNormalized, 20>(packed);
+        vertices.val[3] = ConvertPackedAlpha<kSigned, kNormalized>(packed);
+        vst4q_f32(reinterpret_cast<float *>(output) + i * 4, vertices);
+    }
+    return i;
+}
+#endif
+
+#if defined(ANGLE_COPY_VERTEX_SSE2) || defined(ANGLE_COPY_VERTEX_NEON)
+template <VertexComponentType kComponentType>
+size_t CopyToFloatVertexRunImpl(bool normalized,
+                                size_t inputComponentCount,
+                                size_t outputComponentCount,
+                                const uint8_t *input,
+                                size_t stride,
+                                size_t count,
+                                uint8_t *output)
+{
+    return normalized ? CopyToFloatVertexRunImpl<kComponentType, true>(
+                            inputComponentCount, outputComponentCount, input, stride, count, output)
+                      : CopyToFloatVertexRunImpl<kComponentType, false>(
+                            inputComponentCount, outputComponentCount, input, stride, count,
+                            output);
+}
+#endif
+}  // anonymous namespace
+
+size_t CopyToFloatVertexRun(VertexComponentType componentType,
+                            bool normalized,
+                            size_t inputComponentCount,
+                            size_t outputComponentCount,
+                            const uint8_t *input,
+                            size_t stride,
+                            size_t count,
+                            uint8_t *output)
+{
+    ASSERT(inputComponentCount <= outputComponentCount && outputComponentCount <= 4);
+
+#if defined(ANGLE_COPY_VERTEX_SSE2) || defined(ANGLE_COPY_VERTEX_NEON)
+    switch (componentType)
+    {
+        case VertexComponentType::Byte:
+            return CopyToFloatVertexRunImpl<VertexComponentType::Byte>(
+                normalized, inputComponentCount, outputComponentCount, input, stride, count,
+                output);
+        case VertexComponentType::UnsignedByte:
+            return CopyToFloatVertexRunImpl<VertexComponentType::UnsignedByte>(
+                normalized, inputComponentCount, outputComponentCount, input, stride, count,
+                output);
+        case VertexComponentType::Short:
+            return CopyToFloatVertexRunImpl<VertexComponentType::Short>(
+                normalized, inputComponentCount, outputComponentCount, input, stride, count,
+                output);
+        case VertexComponentType::UnsignedShort:
+            return CopyToFloatVertexRunImpl<VertexComponentType::UnsignedShort>(
+                normalized, inputComponentCount, outputComponentCount, input, stride, count,
+                output);
+        case VertexComponentType::Int:
+            return CopyToFloatVertexRunImpl<VertexComponentType::Int>(
+                normalized, inputComponentCount, outputComponentCount, input, stride, count,
+                output);
+        case VertexComponentType::Fixed:
+            return CopyToFloatVertexRunImpl<VertexComponentType::Fixed, false>(
+                inputComponentCount, outputComponentCount, input, stride, count, output);
+        default:
+            UNREACHABLE();
+            return 0;
+    }
+#else
+    return 0;
+#endif
+}
+
+size_t CopyXYZ10W2ToXYZWFloatVertexRun(bool isSigned,
+                                       bool normalized,
+                                       const uint8_t *input,
+                                       size_t stride,
+                                       size_t count,
+                                       uint8_t *output)
+{
+#if defined(ANGLE_COPY_VERTEX_SSE2) || defined(ANGLE_COPY_VERTEX_NEON)
+    if (isSigned)
+    {
+        return normalized
+                   ? CopyXYZ10W2ToXYZWFloatVertexRunImpl<true, true>(input, stride, count, output)
+                   : CopyXYZ10W2ToXYZWFloatVertexRunImpl<true, false>(input, stride, count,
+                                                                      output);
+    }
+    return normalized
+               ? CopyXYZ10W2ToXYZWFloatVertexRunImpl<false, true>(input, stride, count, output)
+               : CopyXYZ10W2ToXYZWFloatVertexRunImpl<false, false>(input, stride, count, output);
+#else
+    return 0;
+#endif
+}
+}  // namespace priv
+}  // namespace rx
@@ -9,6 +9,7 @@
 #ifndef LIBANGLE_RENDERER_COPYVERTEX_H_
 #define LIBANGLE_RENDERER_COPYVERTEX_H_
 
+#include "angle_gl.h"
 #include "common/mathutil.h"
 
 namespace rx
@@ -73,6 +74,44 @@ void CopyW2XYZ10ToXYZWFloatVertexData(const uint8_t *input,
                                       size_t count,
                                       uint8_t *output);
 
+namespace priv
+{
+enum class VertexComponentType
+{
+    Byte,
+    UnsignedByte,
+    Short,
+    UnsignedShort,
+    Int,
+    Fixed,
+
+    InvalidEnum,
+};
+
+// Vectorized conversions of runs of vertices used by the templates above.  Each one converts a
+// prefix of the run exactly like the scalar code does, and returns the number of vertices it
+// converted.  The rest, if any, are left to the scalar code.
+
+// Converts integer or fixed-point components to float like CopyToFloatVertexData and
+// Copy32FixedTo32FVertexData.
+size_t CopyToFloatVertexRun(VertexComponentType componentType,
+                            bool normalized,
+                            size_t inputComponentCount,
+                            size_t outputComponentCount,
+                            const uint8_t *input,
+                            size_t stride,
+                            size_t count,
+                            uint8_t *output);
+
+// Converts packed 10_10_10_2 vertices to float like CopyXYZ10W2ToXYZWFloatVertexData.
+size_t CopyXYZ10W2ToXYZWFloatVertexRun(bool isSigned,
+                                       bool normalized,
+                                       const uint8_t *input,
+                                       size_t stride,
+                                       size_t count,
+                                       uint8_t *output);
+}  // namespace priv
+
 }  // namespace rx
 
 #include "copyvertex.inc.h"
@@ -9,49 +9,43 @@
 namespace rx
 {
 
-// Returns an aligned buffer to read the input from
-template <typename T, size_t inputComponentCount>
-inline const T *GetAlignedOffsetInput(const T *offsetInput, T *alignedElement)
+namespace priv
 {
-    if (reinterpret_cast<uintptr_t>(offsetInput) % sizeof(T) != 0)
-    {
-        // Applications may pass in arbitrarily aligned buffers as input.
-        // Certain architectures have restrictions regarding unaligned reads. Specifically, we crash
-        // on armeabi-v7a devices with a SIGBUS error when performing such operations. arm64 and
-        // x86-64 devices do not appear to have such issues.
-        //
-        // The workaround is to detect if the input buffer is unaligned and if so, perform a
-        // byte-wise copy of the unaligned portion and a memcpy of the rest of the buffer.
-        uint8_t *alignedBuffer               = reinterpret_cast<uint8_t *>(&alignedElement[0]);
-        uintptr_t unalignedInputStartAddress = reinterpret_cast<uintptr_t>(offsetInput);
-        constexpr size_t kAlignmentMinusOne  = sizeof(T) - 1;
-        uintptr_t alignedInputStartAddress =
-            (reinterpret_cast<uintptr_t>(offsetInput) + kAlignmentMinusOne) & ~(kAlignmentMinusOne);
-        ASSERT(alignedInputStartAddress >= unalignedInputStartAddress);
-
-        const size_t totalBytesToCopy     = sizeof(T) * inputComponentCount;
-        const size_t unalignedBytesToCopy = alignedInputStartAddress - unalignedInputStartAddress;
-        ASSERT(totalBytesToCopy >= unalignedBytesToCopy);
-
-        // byte-wise copy of unaligned portion
-        for (size_t i = 0; i < unalignedBytesToCopy; i++)
-        {
-            alignedBuffer[i] = reinterpret_cast<const uint8_t *>(&offsetInput[0])[i];
-        }
 
-        // memcpy remaining buffer
-        memcpy(&alignedBuffer[unalignedBytesToCopy],
-               &reinterpret_cast<const uint8_t *>(&offsetInput[0])[unalignedBytesToCopy],
-               totalBytesToCopy - unalignedBytesToCopy);
-
-        return alignedElement;
+template <typename T>
+constexpr VertexComponentType GetVertexComponentType()
+{
+    if constexpr (std::is_same<T, GLbyte>::value)
+    {
+        return VertexComponentType::Byte;
+    }
+    else if constexpr (std::is_same<T, GLubyte>::value)
+    {
+        return VertexComponentType::UnsignedByte;
+    }
+    else if constexpr (std::is_same<T, GLshort>::value)
+    {
+        return VertexComponentType::Short;
+    }
+    else if constexpr (std::is_same<T, GLushort>::value)
+    {
+        return VertexComponentType::UnsignedShort;
+    }
+    else if constexpr (std::is_same<T, GLint>::value)
+    {
+        return VertexComponentType::Int;
     }
     else
     {
-        return offsetInput;
+        return VertexComponentType::InvalidEnum;
     }
 }
 
+}  // namespace priv
+
+// Applications may pass in arbitrarily aligned buffers as input, and certain architectures
+// (armeabi-v7a) crash with SIGBUS on unaligned reads, so the input is only ever read with memcpy.
+
 template <typename T,
           size_t inputComponentCount,
           size_t outputComponentCount,
@@ -70,14 +64,7 @@ inline void CopyNativeVertexData(const uint8_t *input, size_t stride, size_t cou
     {
         for (size_t i = 0; i < count; i++)
         {
-            const T *offsetInput = reinterpret_cast<const T *>(input + (i * stride));
-            T offsetInputAligned[inputComponentCount];
-            offsetInput =
-                GetAlignedOffsetInput<T, inputComponentCount>(offsetInput, &offsetInputAligned[0]);
-
-            T *offsetOutput = reinterpret_cast<T *>(output) + i * outputComponentCount;
-
-            memcpy(offsetOutput, offsetInput, attribSize);
+            memcpy(output + i * attribSize, input + i * stride, attribSize);
         }
         return;
     }
@@ -85,17 +72,32 @@ inline void CopyNativeVertexData(const uint8_t *input, size_t stride, size_t cou
     const T defaultAlphaValue                = gl::bitCast<T>(alphaDefaultValueBits);
     const size_t lastNonAlphaOutputComponent = std::min<size_t>(outputComponentCount, 3);
 
-    for (size_t i = 0; i < count; i++)
+    size_t firstVertex = 0;
+    if constexpr (inputComponentCount == 3 && outputComponentCount == 4 && sizeof(T) <= 2)
     {
-        const T *offsetInput = reinterpret_cast<const T *>(input + (i * stride));
-        T offsetInputAligned[inputComponentCount];
-        ASSERT(sizeof(offsetInputAligned) == attribSize);
-        offsetInput =
-            GetAlignedOffsetInput<T, inputComponentCount>(offsetInput, &offsetInputAligned[0]);
+        // Pad three-component vertices a whole output vertex at a time.  The load also reads the
+        // first component of the next vertex, so the last vertex is left to the loop below.
+        using VertexBits = std::conditional_t<sizeof(T) == 1, uint32_t, uint64_t>;
+        constexpr size_t kAlphaShift  = 3 * sizeof(T) * 8;
+        constexpr VertexBits kRGBMask = (VertexBits(1) << kAlphaShift) - 1;
+        const VertexBits alphaBits =
+            static_cast<VertexBits>(gl::bitCast<std::make_unsigned_t<T>>(defaultAlphaValue))
+            << kAlphaShift;
+
+        for (; IsLittleEndian() && firstVertex + 1 < count; firstVertex++)
+        {
+            VertexBits vertex;
+            memcpy(&vertex, input + firstVertex * stride, sizeof(vertex));
+            vertex = (vertex & kRGBMask) | alphaBits;
+            memcpy(output + firstVertex * sizeof(vertex), &vertex, sizeof(vertex));
+        }
+    }
 
+    for (size_t i = firstVertex; i < count; i++)
+    {
         T *offsetOutput = reinterpret_cast<T *>(output) + i * outputComponentCount;
 
-        memcpy(offsetOutput, offsetInput, attribSize);
+        memcpy(offsetOutput, input + i * stride, attribSize);
 
         if (inputComponentCount < lastNonAlphaOutputComponent)
         {
@@ -193,28 +195,20 @@ inline void Copy32FixedTo32FVertexData(const uint8_t *input,
 {
     static const float divisor = 1.0f / (1 << 16);
 
-    for (size_t i = 0; i < count; i++)
-    {
-        const uint8_t *offsetInput = input + i * stride;
-        float *offsetOutput        = reinterpret_cast<float *>(output) + i * outputComponentCount;
+    const size_t firstVertex = priv::CopyToFloatVertexRun(
+        priv::VertexComponentType::Fixed, false, inputComponentCount, outputComponentCount, input,
+        stride, count, output);
 
+    for (size_t i = firstVertex; i < count; i++)
+    {
         // GLfixed access must be 4-byte aligned on arm32, input and stride sometimes are not
-        if (reinterpret_cast<uintptr_t>(offsetInput) % sizeof(GLfixed) == 0)
-        {
-            for (size_t j = 0; j < inputComponentCount; j++)
-            {
-                offsetOutput[j] =
-                    static_cast<float>(reinterpret_cast<const GLfixed *>(offsetInput)[j]) * divisor;
-            }
-        }
-        else
+        GLfixed offsetInput[inputComponentCount];
+        memcpy(offsetInput, input + i * stride, sizeof(offsetInput));
+        float *offsetOutput = reinterpret_cast<float *>(output) + i * outputComponentCount;
+
+        for (size_t j = 0; j < inputComponentCount; j++)
         {
-            for (size_t j = 0; j < inputComponentCount; j++)
-            {
-                GLfixed alignedInput;
-                memcpy(&alignedInput, offsetInput + j * sizeof(GLfixed), sizeof(GLfixed));
-                offsetOutput[j] = static_cast<float>(alignedInput) * divisor;
-            }
+            offsetOutput[j] = static_cast<float>(offsetInput[j]) * divisor;
         }
 
         // 4-component output formats would need special padding in the alpha channel.
@@ -242,16 +236,23 @@ inline void CopyToFloatVertexData(const uint8_t *input,
     typedef std::numeric_limits<T> NL;
     typedef typename std::conditional<toHalf, GLhalf, float>::type outputType;
 
-    for (size_t i = 0; i < count; i++)
+    constexpr priv::VertexComponentType kComponentType = priv::GetVertexComponentType<T>();
+
+    size_t firstVertex = 0;
+    if constexpr (!toHalf && kComponentType != priv::VertexComponentType::InvalidEnum)
+    {
+        firstVertex = priv::CopyToFloatVertexRun(kComponentType, normalized, inputComponentCount,
+                                                 outputComponentCount, input, stride, count,
+                                                 output);
+    }
+
+    for (size_t i = firstVertex; i < count; i++)
     {
-        const T *offsetInput = reinterpret_cast<const T *>(input + (stride * i));
+        T offsetInput[inputComponentCount];
+        memcpy(offsetInput, input + (stride * i), sizeof(offsetInput));
         outputType *offsetOutput =
             reinterpret_cast<outputType *>(output) + i * outputComponentCount;
 
-        T offsetInputAligned[inputComponentCount];
-        offsetInput =
-            GetAlignedOffsetInput<T, inputComponentCount>(offsetInput, &offsetInputAligned[0]);
-
         for (size_t j = 0; j < inputComponentCount; j++)
         {
             float result = 0;
@@ -296,7 +297,7 @@ inline void CopyToFloatVertexData(const uint8_t *input,
             }
             else
             {
-                offsetOutput[3] = static_cast<outputType>(gl::Float32One);
+                offsetOutput[3] = static_cast<outputType>(gl::bitCast<float>(gl::Float32One));
             }
         }
     }
@@ -552,9 +553,17 @@ inline void CopyXYZ10W2ToXYZWFloatVertexData(const uint8_t *input,
     const uint32_t alphaMask = 0x3;  // 1 set in bits 0 and 1
     const size_t alphaShift  = 30;   // Alpha is the 30 and 31 bits
 
-    for (size_t i = 0; i < count; i++)
+    size_t firstVertex = 0;
+    if constexpr (toFloat && !toHalf)
     {
-        GLuint packedValue    = *reinterpret_cast<const GLuint *>(input + (i * stride));
+        firstVertex = priv::CopyXYZ10W2ToXYZWFloatVertexRun(isSigned, normalized, input, stride,
+                                                            count, output);
+    }
+
+    for (size_t i = firstVertex; i < count; i++)
+    {
+        GLuint packedValue;
+        memcpy(&packedValue, input + (i * stride), sizeof(packedValue));
         uint8_t *offsetOutput = output + (i * outputComponentSize * componentCount);
 
         priv::CopyPackedRGB<isSigned, normalized, toFloat, toHalf>(
@@ -0,0 +1,239 @@
+//
+// Copyright 2024 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// copyvertex_unittest:
+//   Unit tests for the vertex conversion functions, which check that the vectorized conversions
+//   of runs of vertices give the same results as converting the vertices one at a time.
+//
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "libANGLE/renderer/copyvertex.h"
+
+namespace rx
+{
+namespace
+{
+// Vertex counts that exercise both the vectorized conversions and the vertices at the end of the
+// run that are left to the scalar code.
+constexpr size_t kVertexCounts[] = {1, 2, 3, 4, 5, 17, 64};
+
+// Random vertices that start at an odd address, with no slack after the last vertex.
+std::vector<uint8_t> MakeVertices(size_t vertexSize, size_t stride, size_t count)
+{
+    static std::mt19937 rng(0);
+    std::vector<uint8_t> vertices(1 + (count - 1) * stride + vertexSize);
+    for (uint8_t &byte : vertices)
+    {
+        byte = static_cast<uint8_t>(rng());
+    }
+    return vertices;
+}
+
+template <typename T, size_t inputComponentCount, size_t outputComponentCount, bool normalized>
+void TestCopyToFloat()
+{
+    using NL                     = std::numeric_limits<T>;
+    constexpr size_t kAttribSize = sizeof(T) * inputComponentCount;
+
+    for (size_t stride : {kAttribSize, kAttribSize + 1, size_t(20)})
+    {
+        for (size_t count : kVertexCounts)
+        {
+            std::vector<uint8_t> input = MakeVertices(kAttribSize, stride, count);
+            std::vector<float> output(count * outputComponentCount);
+            CopyToFloatVertexData<T, inputComponentCount, outputComponentCount, normalized, false>(
+                input.data() + 1, stride, count, reinterpret_cast<uint8_t *>(output.data()));
+
+            for (size_t i = 0; i < count; i++)
+            {
+                T components[inputComponentCount];
+                memcpy(components, input.data() + 1 + i * stride, kAttribSize);
+
+                for (size_t j = 0; j < outputComponentCount; j++)
+                {
+                    float expected = j == 3 ? 1.0f : 0.0f;
+                    if (j < inputComponentCount)
+                    {
+                        expected = static_cast<float>(components[j]);
+                        if (normalized)
+                        {
+                            expected = std::max(expected / static_cast<float>(NL::max()), -1.0f);
+                        }
+                    }
+                    EXPECT_EQ(expected, output[i * outputComponentCount + j])
+                        << "stride " << stride << " count " << count << " vertex " << i
+                        << " component " << j;
+                }
+            }
+        }
+    }
+}
+
+// Test converting normalized and integer components to float.
+TEST(CopyVertexTest, ToFloat)
+{
+    TestCopyToFloat<GLbyte, 1, 1, true>();
+    TestCopyToFloat<GLbyte, 2, 2, true>();
+    TestCopyToFloat<GLbyte, 3, 4, true>();
+    TestCopyToFloat<GLbyte, 4, 4, false>();
+    TestCopyToFloat<GLubyte, 3, 3, true>();
+    TestCopyToFloat<GLubyte, 3, 4, false>();
+    TestCopyToFloat<GLubyte, 4, 4, true>();
+    TestCopyToFloat<GLshort, 1, 1, false>();
+    TestCopyToFloat<GLshort, 3, 4, true>();
+    TestCopyToFloat<GLshort, 4, 4, true>();
+    TestCopyToFloat<GLushort, 2, 2, true>();
+    TestCopyToFloat<GLushort, 3, 3, false>();
+    TestCopyToFloat<GLushort, 4, 4, true>();
+    TestCopyToFloat<GLint, 3, 3, false>();
+    TestCopyToFloat<GLint, 4, 4, true>();
+}
+
+template <size_t inputComponentCount, size_t outputComponentCount>
+void TestCopyFixedToFloat()
+{
+    constexpr size_t kAttribSize = sizeof(GLfixed) * inputComponentCount;
+
+    for (size_t stride : {kAttribSize, kAttribSize + 2})
+    {
+        for (size_t count : kVertexCounts)
+        {
+            std::vector<uint8_t> input = MakeVertices(kAttribSize, stride, count);
+            std::vector<float> output(count * outputComponentCount);
+            Copy32FixedTo32FVertexData<inputComponentCount, outputComponentCount>(
+                input.data() + 1, stride, count, reinterpret_cast<uint8_t *>(output.data()));
+
+            for (size_t i = 0; i < count; i++)
+            {
+                GLfixed components[inputComponentCount];
+                memcpy(components, input.data() + 1 + i * stride, kAttribSize);
+
+                for (size_t j = 0; j < outputComponentCount; j++)
+                {
+                    const float expected =
+                        j < inputComponentCount ? components[j] * (1.0f / (1 << 16)) : 0.0f;
+                    EXPECT_EQ(expected, output[i * outputComponentCount + j])
+                        << "stride " << stride << " count " << count << " vertex " << i
+                        << " component " << j;
+                }
+            }
+        }
+    }
+}
+
+// Test converting fixed-point components to float.
+TEST(CopyVertexTest, FixedToFloat)
+{
+    TestCopyFixedToFloat<1, 1>();
+    TestCopyFixedToFloat<2, 2>();
+    TestCopyFixedToFloat<3, 3>();
+    TestCopyFixedToFloat<4, 4>();
+}
+
+template <typename T, uint32_t alphaDefaultValueBits>
+void TestPadding()
+{
+    constexpr size_t kAttribSize = sizeof(T) * 3;
+
+    for (size_t stride : {kAttribSize, kAttribSize + 1, size_t(16)})
+    {
+        for (size_t count : kVertexCounts)
+        {
+            std::vector<uint8_t> input = MakeVertices(kAttribSize, stride, count);
+            std::vector<T> output(count * 4);
+            CopyNativeVertexData<T, 3, 4, alphaDefaultValueBits>(
+                input.data() + 1, stride, count, reinterpret_cast<uint8_t *>(output.data()));
+
+            for (size_t i = 0; i < count; i++)
+            {
+                T expected[4];
+                memcpy(expected, input.data() + 1 + i * stride, kAttribSize);
+                expected[3] = gl::bitCast<T>(alphaDefaultValueBits);
+                EXPECT_EQ(0, memcmp(expected, &output[i * 4], sizeof(expected)))
+                    << "stride " << stride << " count " << count << " vertex " << i;
+            }
+        }
+    }
+}
+
+// Test padding three-component vertices to four components.
+TEST(CopyVertexTest, Padding)
+{
+    TestPadding<GLbyte, 1>();
+    TestPadding<GLubyte, 0xFF>();
+    TestPadding<GLshort, 0x7FFF>();
+    TestPadding<GLushort, 1>();
+    TestPadding<GLhalf, gl::Float16One>();
+    TestPadding<GLfloat, gl::Float32One>();
+}
+
+// Mirrors CopyPackedRGB and CopyPackedAlpha.
+float UnpackXYZ10W2(uint32_t packedValue, size_t channel, bool isSigned, bool normalized)
+{
+    const uint32_t bits  = channel == 3 ? 2 : 10;
+    const uint32_t value = (packedValue >> (channel * 10)) & ((1u << bits) - 1);
+    if (!isSigned)
+    {
+        return normalized ? value / static_cast<float>((1u << bits) - 1)
+                          : static_cast<float>(value);
+    }
+
+    const int32_t signedValue =
+        (value & (1u << (bits - 1))) ? static_cast<int32_t>(value) - (1 << bits) : value;
+    if (!normalized)
+    {
+        return static_cast<float>(signedValue);
+    }
+    if (channel == 3)
+    {
+        return std::max(static_cast<float>(signedValue), -1.0f);
+    }
+    const float clamped = std::max(static_cast<float>(signedValue), -511.0f);
+    return (clamped + 511.0f) / 511.0f - 1.0f;
+}
+
+template <bool isSigned, bool normalized>
+void TestCopyXYZ10W2ToFloat()
+{
+    for (size_t stride : {size_t(4), size_t(7)})
+    {
+        for (size_t count : kVertexCounts)
+        {
+            std::vector<uint8_t> input = MakeVertices(4, stride, count);
+            std::vector<float> output(count * 4);
+            CopyXYZ10W2ToXYZWFloatVertexData<isSigned, normalized, true, false>(
+                input.data() + 1, stride, count, reinterpret_cast<uint8_t *>(output.data()));
+
+            for (size_t i = 0; i < count; i++)
+            {
+                uint32_t packedValue;
+                memcpy(&packedValue, input.data() + 1 + i * stride, sizeof(packedValue));
+
+                for (size_t j = 0; j < 4; j++)
+                {
+                    EXPECT_EQ(UnpackXYZ10W2(packedValue, j, isSigned, normalized),
+                              output[i * 4 + j])
+                        << "stride " << stride << " count " << count << " vertex " << i
+                        << " component " << j;
+                }
+            }
+        }
+    }
+}
+
+// Test converting packed 10_10_10_2 vertices to float.
+TEST(CopyVertexTest, XYZ10W2ToFloat)
+{
+    TestCopyXYZ10W2ToFloat<false, false>();
+    TestCopyXYZ10W2ToFloat<false, true>();
+    TestCopyXYZ10W2ToFloat<true, false>();
+    TestCopyXYZ10W2ToFloat<true, true>();
+}
+}  // anonymous namespace
+}  // namespace rx
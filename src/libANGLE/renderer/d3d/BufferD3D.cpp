@@ -10,6 +10,7 @@
 
 #include "common/mathutil.h"
 #include "common/utilities.h"
+#include "libANGLE/IndexRangeCache.h"
 #include "libANGLE/renderer/d3d/IndexBuffer.h"
 #include "libANGLE/renderer/d3d/RendererD3D.h"
 #include "libANGLE/renderer/d3d/VertexBuffer.h"
@@ -188,4 +189,20 @@ angle::Result BufferD3D::getIndexRange(const gl::Context *context,
     return angle::Result::Continue;
 }
 
+angle::Result BufferD3D::getIndexRanges(const gl::Context *context,
+                                        gl::DrawElementsType type,
+                                        bool primitiveRestartEnabled,
+                                        std::vector<gl::IndexRangeSpan> *spans)
+{
+    const uint8_t *data = nullptr;
+    ANGLE_TRY(getData(context, &data));
+
+    for (gl::IndexRangeSpan &span : *spans)
+    {
+        span.range =
+            gl::ComputeIndexRange(type, data + span.offset, span.count, primitiveRestartEnabled);
+    }
+    return angle::Result::Continue;
+}
+
 }  // namespace rx
@@ -64,10 +64,7 @@ template_autogen_inl = """// GENERATED FILE - DO NOT EDIT.
 namespace angle
 {{
 
-static constexpr rx::FastCopyFunctionMap::Entry BGRAEntry = {{angle::FormatID::R8G8B8A8_UNORM,
-                                                             CopyBGRA8ToRGBA8}};
-static constexpr rx::FastCopyFunctionMap BGRACopyFunctions = {{&BGRAEntry, 1}};
-static constexpr rx::FastCopyFunctionMap NoCopyFunctions;
+{fast_copy_functions}static constexpr rx::FastCopyFunctionMap NoCopyFunctions;
 
 const Format gFormatInfoTable[] = {{
     // clang-format off
@@ -277,6 +274,35 @@ def get_vertex_attrib_type(format_id):
     return "InvalidEnum"
 
 
+# Specialized conversions PackPixels uses instead of converting each pixel through gl::ColorF,
+# keyed by the source format.  These cover the common glReadPixels format pairs.
+fast_copy_functions = {
+    "B8G8R8A8_UNORM": [("R8G8B8A8_UNORM", "CopyBGRA8ToRGBA8")],
+    "B8G8R8X8_UNORM": [("R8G8B8A8_UNORM", "CopyBGRX8ToRGBA8")],
+    "R16G16B16A16_FLOAT": [("R32G32B32A32_FLOAT", "CopyRGBA16FToRGBA32F")],
+    "R5G6B5_UNORM": [("R8G8B8A8_UNORM", "CopyR5G6B5ToRGBA8")],
+    "R8G8B8A8_UNORM": [("B8G8R8A8_UNORM", "CopyRGBA8ToBGRA8"),
+                       ("R5G6B5_UNORM", "CopyRGBA8ToR5G6B5")],
+    "R8G8B8X8_UNORM": [("R8G8B8A8_UNORM", "CopyRGBX8ToRGBA8")],
+}
+
+fast_copy_functions_template = """static constexpr rx::FastCopyFunctionMap::Entry {format_id}CopyEntries[] = {{
+{entries}}};
+static constexpr rx::FastCopyFunctionMap {format_id}CopyFunctions = {{
+    {format_id}CopyEntries, {count}}};
+"""
+
+
+def gen_fast_copy_functions():
+    result = ""
+    for format_id, functions in sorted(fast_copy_functions.items()):
+        entries = ",\n".join("    {{angle::FormatID::{}, {}}}".format(dest_format_id, function)
+                             for dest_format_id, function in functions)
+        result += fast_copy_functions_template.format(
+            format_id=format_id, entries=entries, count=len(functions))
+    return result
+
+
 def bool_str(cond):
     return "true" if cond else "false"
 
@@ -321,8 +347,8 @@ def json_to_table_data(format_id, json, angle_to_gl):
 
     parsed["namedComponentType"] = get_named_component_type(parsed["componentType"])
 
-    if format_id == "B8G8R8A8_UNORM":
-        parsed["fastCopyFunctions"] = "BGRACopyFunctions"
+    if format_id in fast_copy_functions:
+        parsed["fastCopyFunctions"] = format_id + "CopyFunctions"
 
     is_block = format_id.endswith("_BLOCK")
 
@@ -431,6 +457,7 @@ def main():
     switch_data = gen_map_switch_string(gl_to_angle)
     output_cpp = template_autogen_inl.format(
         script_name=os.path.basename(sys.argv[0]),
+        fast_copy_functions=gen_fast_copy_functions(),
         angle_format_info_cases=angle_format_cases,
         angle_format_switch=switch_data,
         data_source_name=data_source_name)
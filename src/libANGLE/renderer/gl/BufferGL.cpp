@@ -11,6 +11,7 @@
 #include "common/debug.h"
 #include "common/utilities.h"
 #include "libANGLE/Context.h"
+#include "libANGLE/IndexRangeCache.h"
 #include "libANGLE/angletypes.h"
 #include "libANGLE/formatutils.h"
 #include "libANGLE/renderer/gl/ContextGL.h"
@@ -329,6 +330,59 @@ angle::Result BufferGL::getIndexRange(const gl::Context *context,
     return angle::Result::Continue;
 }
 
+angle::Result BufferGL::getIndexRanges(const gl::Context *context,
+                                       gl::DrawElementsType type,
+                                       bool primitiveRestartEnabled,
+                                       std::vector<gl::IndexRangeSpan> *spans)
+{
+    if (mShadowCopy.has_value())
+    {
+        for (gl::IndexRangeSpan &span : *spans)
+        {
+            span.range = gl::ComputeIndexRange(type, mShadowCopy->data() + span.offset, span.count,
+                                               primitiveRestartEnabled);
+        }
+        return angle::Result::Continue;
+    }
+
+    ContextGL *contextGL         = GetImplAs<ContextGL>(context);
+    const FunctionsGL *functions = GetFunctionsGL(context);
+    StateManagerGL *stateManager = GetStateManagerGL(context);
+
+    ASSERT(!mIsMapped);
+
+    stateManager->bindBuffer(DestBufferOperationTarget, mBufferID);
+
+    // Map once for all the spans, which are sorted by offset.
+    const size_t typeBytes = gl::GetDrawElementsTypeSize(type);
+    const size_t mapOffset = spans->front().offset;
+    const size_t mapEnd    = spans->back().offset + spans->back().count * typeBytes;
+    const uint8_t *bufferData =
+        MapBufferRangeWithFallback(functions, gl::ToGLenum(DestBufferOperationTarget), mapOffset,
+                                   mapEnd - mapOffset, GL_MAP_READ_BIT);
+    if (bufferData)
+    {
+        for (gl::IndexRangeSpan &span : *spans)
+        {
+            span.range = gl::ComputeIndexRange(type, bufferData + (span.offset - mapOffset),
+                                               span.count, primitiveRestartEnabled);
+        }
+        ANGLE_GL_TRY(context, functions->unmapBuffer(gl::ToGLenum(DestBufferOperationTarget)));
+    }
+    else
+    {
+        // Workaround the null driver not having map support.
+        for (gl::IndexRangeSpan &span : *spans)
+        {
+            span.range = gl::IndexRange(0, 0, 1);
+        }
+    }
+
+    contextGL->markWorkSubmitted();
+
+    return angle::Result::Continue;
+}
+
 size_t BufferGL::getBufferSize() const
 {
     return mBufferSize;
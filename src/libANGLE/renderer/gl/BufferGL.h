@@ -57,6 +57,10 @@ class BufferGL : public BufferImpl
                                 size_t count,
                                 bool primitiveRestartEnabled,
                                 gl::IndexRange *outRange) override;
+    angle::Result getIndexRanges(const gl::Context *context,
+                                 gl::DrawElementsType type,
+                                 bool primitiveRestartEnabled,
+                                 std::vector<gl::IndexRangeSpan> *spans) override;
 
     size_t getBufferSize() const;
     GLuint getBufferID() const;
@@ -147,6 +147,10 @@ class BufferMtl : public BufferImpl, public BufferHolderMtl
                                 size_t count,
                                 bool primitiveRestartEnabled,
                                 gl::IndexRange *outRange) override;
+    angle::Result getIndexRanges(const gl::Context *context,
+                                 gl::DrawElementsType type,
+                                 bool primitiveRestartEnabled,
+                                 std::vector<gl::IndexRangeSpan> *spans) override;
 
     void onDataChanged() override;
 
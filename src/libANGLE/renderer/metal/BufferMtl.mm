@@ -11,6 +11,7 @@
 
 #include "common/debug.h"
 #include "common/utilities.h"
+#include "libANGLE/IndexRangeCache.h"
 #include "libANGLE/renderer/metal/ContextMtl.h"
 #include "libANGLE/renderer/metal/DisplayMtl.h"
 #include "libANGLE/renderer/metal/mtl_buffer_manager.h"
@@ -276,6 +277,23 @@ angle::Result BufferMtl::getIndexRange(const gl::Context *context,
     return angle::Result::Continue;
 }
 
+angle::Result BufferMtl::getIndexRanges(const gl::Context *context,
+                                        gl::DrawElementsType type,
+                                        bool primitiveRestartEnabled,
+                                        std::vector<gl::IndexRangeSpan> *spans)
+{
+    // Synchronize the data with the GPU only once for all the spans.
+    const uint8_t *data = getBufferDataReadOnly(mtl::GetImpl(context));
+
+    for (gl::IndexRangeSpan &span : *spans)
+    {
+        span.range =
+            gl::ComputeIndexRange(type, data + span.offset, span.count, primitiveRestartEnabled);
+    }
+
+    return angle::Result::Continue;
+}
+
 angle::Result BufferMtl::getFirstLastIndices(ContextMtl *contextMtl,
                                              gl::DrawElementsType type,
                                              size_t offset,
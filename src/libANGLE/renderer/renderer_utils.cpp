@@ -9,11 +9,13 @@
 
 #include "libANGLE/renderer/renderer_utils.h"
 
+#include "common/WorkerThread.h"
 #include "common/string_utils.h"
 #include "common/system_utils.h"
 #include "common/utilities.h"
 #include "image_util/copyimage.h"
 #include "image_util/imageformats.h"
+#include "image_util/loadimage.h"
 #include "libANGLE/AttributeMap.h"
 #include "libANGLE/Context.h"
 #include "libANGLE/Context.inl.h"
@@ -25,6 +27,7 @@
 
 #include <string.h>
 #include <cctype>
+#include <thread>
 
 namespace angle
 {
@@ -531,6 +534,160 @@ void PackPixels(const PackPixelsParams &params,
     }
 }
 
+namespace
+{
+// For smaller levels the overhead of multithreading exceeds the benefits.
+constexpr size_t kMinPixelsForMultithreadedMipGeneration = 256 * 256;
+
+// Returns the max number of bands a level is split in.
+size_t MaxMipGenerationBands()
+{
+    static const size_t numThreads =
+        std::min<size_t>(16, std::max(1u, std::thread::hardware_concurrency()));
+    return numThreads;
+}
+
+// Generates the rows [begin, end) of |dest|, in every slice.
+void GenerateMipLevelRows(MipGenerationFunction mipGenerationFunction,
+                          const MipLevelData &source,
+                          const MipLevelData &dest,
+                          size_t begin,
+                          size_t end)
+{
+    if (begin == 0 && end == dest.height)
+    {
+        mipGenerationFunction(source.width, source.height, source.depth, source.data,
+                              source.rowPitch, source.depthPitch, dest.data, dest.rowPitch,
+                              dest.depthPitch);
+        return;
+    }
+
+    // Each row is made from two source rows, so a band is generated like an image of its own.
+    ASSERT(source.height > 1);
+    mipGenerationFunction(source.width, (end - begin) * 2, source.depth,
+                          source.data + begin * 2 * source.rowPitch, source.rowPitch,
+                          source.depthPitch, dest.data + begin * dest.rowPitch, dest.rowPitch,
+                          dest.depthPitch);
+}
+
+void GenerateMipmapChain(MipGenerationFunction mipGenerationFunction,
+                         const std::vector<MipLevelData> &chain)
+{
+    for (size_t level = 1; level < chain.size(); ++level)
+    {
+        GenerateMipLevelRows(mipGenerationFunction, chain[level - 1], chain[level], 0,
+                             chain[level].height);
+    }
+}
+
+class GenerateMipmapChainTask final : public angle::Closure
+{
+  public:
+    GenerateMipmapChainTask(MipGenerationFunction mipGenerationFunction,
+                            const std::vector<MipLevelData> &chain)
+        : mMipGenerationFunction(mipGenerationFunction), mChain(chain)
+    {}
+
+    void operator()() override { GenerateMipmapChain(mMipGenerationFunction, mChain); }
+
+  private:
+    MipGenerationFunction mMipGenerationFunction;
+    const std::vector<MipLevelData> &mChain;
+};
+
+class GenerateMipLevelRowsTask final : public angle::Closure
+{
+  public:
+    GenerateMipLevelRowsTask(MipGenerationFunction mipGenerationFunction,
+                             const MipLevelData &source,
+                             const MipLevelData &dest,
+                             size_t begin,
+                             size_t end)
+        : mMipGenerationFunction(mipGenerationFunction),
+          mSource(source),
+          mDest(dest),
+          mBegin(begin),
+          mEnd(end)
+    {}
+
+    void operator()() override
+    {
+        GenerateMipLevelRows(mMipGenerationFunction, mSource, mDest, mBegin, mEnd);
+    }
+
+  private:
+    MipGenerationFunction mMipGenerationFunction;
+    const MipLevelData &mSource;
+    const MipLevelData &mDest;
+    size_t mBegin;
+    size_t mEnd;
+};
+}  // anonymous namespace
+
+void GenerateMipmapChainsWithCPU(const angle::ImageLoadContext &imageLoadContext,
+                                 MipGenerationFunction mipGenerationFunction,
+                                 const std::vector<std::vector<MipLevelData>> &chains)
+{
+    ASSERT(!chains.empty() && !chains[0].empty());
+    const MipLevelData &base = chains[0][0];
+    const size_t pixelCount  = base.width * base.height * base.depth * chains.size();
+
+    const std::shared_ptr<angle::WorkerThreadPool> &workerPool = imageLoadContext.multiThreadPool;
+    if (!workerPool || pixelCount < kMinPixelsForMultithreadedMipGeneration)
+    {
+        for (const std::vector<MipLevelData> &chain : chains)
+        {
+            GenerateMipmapChain(mipGenerationFunction, chain);
+        }
+        return;
+    }
+
+    std::vector<std::shared_ptr<angle::WaitableEvent>> waitEvents;
+
+    // The layers of arrays and cube maps are independent, so each one is generated by a task.
+    if (chains.size() > 1)
+    {
+        waitEvents.reserve(chains.size());
+        for (const std::vector<MipLevelData> &chain : chains)
+        {
+            waitEvents.push_back(workerPool->postWorkerTask(
+                std::make_shared<GenerateMipmapChainTask>(mipGenerationFunction, chain),
+                angle::WorkerTaskPriority::High));
+        }
+        angle::WaitableEvent::WaitMany(&waitEvents);
+        return;
+    }
+
+    // Otherwise, split the large levels in bands of rows.  Every level needs the whole previous
+    // one, so the bands of a level are waited on before the next level starts.
+    const std::vector<MipLevelData> &chain = chains[0];
+    for (size_t level = 1; level < chain.size(); ++level)
+    {
+        const MipLevelData &source = chain[level - 1];
+        const MipLevelData &dest   = chain[level];
+
+        const size_t bandCount = std::min(MaxMipGenerationBands(), dest.height);
+        if (dest.width * dest.height * dest.depth < kMinPixelsForMultithreadedMipGeneration ||
+            bandCount <= 1)
+        {
+            GenerateMipLevelRows(mipGenerationFunction, source, dest, 0, dest.height);
+            continue;
+        }
+
+        waitEvents.clear();
+        for (size_t band = 0; band < bandCount; ++band)
+        {
+            const size_t begin = dest.height * band / bandCount;
+            const size_t end   = dest.height * (band + 1) / bandCount;
+            waitEvents.push_back(workerPool->postWorkerTask(
+                std::make_shared<GenerateMipLevelRowsTask>(mipGenerationFunction, source, dest,
+                                                           begin, end),
+                angle::WorkerTaskPriority::High));
+        }
+        angle::WaitableEvent::WaitMany(&waitEvents);
+    }
+}
+
 bool FastCopyFunctionMap::has(angle::FormatID formatID) const
 {
     return (get(formatID) != nullptr);
@@ -14,6 +14,7 @@
 
 #include <limits>
 #include <map>
+#include <vector>
 
 #include "GLSLANG/ShaderLang.h"
 #include "common/angleutils.h"
@@ -85,6 +86,25 @@ using MipGenerationFunction = void (*)(size_t sourceWidth,
                                        size_t destRowPitch,
                                        size_t destDepthPitch);
 
+// One level of a mip chain generated on the CPU.
+struct MipLevelData
+{
+    size_t width;
+    size_t height;
+    size_t depth;
+    size_t rowPitch;
+    size_t depthPitch;
+    uint8_t *data;
+};
+
+// Generates every level of each chain from the level before it.  The first level of each chain
+// must already hold the image.  With a multithreaded pool in |imageLoadContext|, the chains of
+// different layers are generated in parallel, and the large levels of a single chain are split in
+// bands of rows.
+void GenerateMipmapChainsWithCPU(const angle::ImageLoadContext &imageLoadContext,
+                                 MipGenerationFunction mipGenerationFunction,
+                                 const std::vector<std::vector<MipLevelData>> &chains);
+
 typedef void (*PixelReadFunction)(const uint8_t *source, uint8_t *dest);
 typedef void (*PixelWriteFunction)(const uint8_t *source, uint8_t *dest);
 typedef void (*FastCopyFunction)(const uint8_t *source,
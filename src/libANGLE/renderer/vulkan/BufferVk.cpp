@@ -14,6 +14,7 @@
 #include "common/mathutil.h"
 #include "common/utilities.h"
 #include "libANGLE/Context.h"
+#include "libANGLE/IndexRangeCache.h"
 #include "libANGLE/renderer/vulkan/ContextVk.h"
 #include "libANGLE/renderer/vulkan/vk_renderer.h"
 
@@ -869,6 +870,43 @@ angle::Result BufferVk::getIndexRange(const gl::Context *context,
     return angle::Result::Continue;
 }
 
+angle::Result BufferVk::getIndexRanges(const gl::Context *context,
+                                       gl::DrawElementsType type,
+                                       bool primitiveRestartEnabled,
+                                       std::vector<gl::IndexRangeSpan> *spans)
+{
+    ContextVk *contextVk   = vk::GetImpl(context);
+    vk::Renderer *renderer = contextVk->getRenderer();
+
+    if (renderer->isMockICDEnabled())
+    {
+        for (gl::IndexRangeSpan &span : *spans)
+        {
+            span.range = gl::IndexRange();
+        }
+        return angle::Result::Continue;
+    }
+
+    ANGLE_TRACE_EVENT0("gpu.angle", "BufferVk::getIndexRanges");
+
+    // Map once for all the spans, which are sorted by offset.
+    const size_t typeSize  = gl::GetDrawElementsTypeSize(type);
+    const size_t mapOffset = spans->front().offset;
+    const size_t mapEnd    = spans->back().offset + spans->back().count * typeSize;
+
+    void *mapPtr;
+    ANGLE_TRY(mapRangeImpl(contextVk, mapOffset, mapEnd - mapOffset, GL_MAP_READ_BIT, &mapPtr));
+    const uint8_t *mapBytes = static_cast<const uint8_t *>(mapPtr);
+
+    for (gl::IndexRangeSpan &span : *spans)
+    {
+        span.range = gl::ComputeIndexRange(type, mapBytes + (span.offset - mapOffset), span.count,
+                                           primitiveRestartEnabled);
+    }
+
+    return unmapImpl(contextVk);
+}
+
 angle::Result BufferVk::updateBuffer(ContextVk *contextVk,
                                      size_t bufferSize,
                                      const BufferDataSource &dataSource,
@@ -106,6 +106,10 @@ class BufferVk : public BufferImpl
                                 size_t count,
                                 bool primitiveRestartEnabled,
                                 gl::IndexRange *outRange) override;
+    angle::Result getIndexRanges(const gl::Context *context,
+                                 gl::DrawElementsType type,
+                                 bool primitiveRestartEnabled,
+                                 std::vector<gl::IndexRangeSpan> *spans) override;
 
     GLint64 getSize() const { return mState.getSize(); }
 
@@ -527,7 +527,8 @@ angle::Result CLCommandQueueVk::flush()
     // TODO: Ideally we should try to find better impl. to avoid spawning a submit-thread/Task here
     // https://anglebug.com/8669
     std::shared_ptr<angle::WaitableEvent> asyncEvent =
-        getPlatform()->postMultiThreadWorkerTask(std::make_shared<CLAsyncFinishTask>(this));
+        getPlatform()->postMultiThreadWorkerTask(std::make_shared<CLAsyncFinishTask>(this),
+                                                 angle::WorkerTaskPriority::Normal);
     ASSERT(asyncEvent != nullptr);
 
     return angle::Result::Continue;
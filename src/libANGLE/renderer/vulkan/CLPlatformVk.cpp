@@ -287,10 +287,16 @@ bool CLPlatformVk::getBlob(const angle::BlobCacheKey &key, angle::BlobCacheValue
     return result;
 }
 
+angle::BlobCompressionCodec CLPlatformVk::getBlobCompressionCodec() const
+{
+    return angle::BlobCompressionCodec::Gzip;
+}
+
 std::shared_ptr<angle::WaitableEvent> CLPlatformVk::postMultiThreadWorkerTask(
-    const std::shared_ptr<angle::Closure> &task)
+    const std::shared_ptr<angle::Closure> &task,
+    angle::WorkerTaskPriority priority)
 {
-    return mPlatform.getMultiThreadPool()->postWorkerTask(task);
+    return mPlatform.getMultiThreadPool()->postWorkerTask(task, priority);
 }
 
 void CLPlatformVk::notifyDeviceLost()
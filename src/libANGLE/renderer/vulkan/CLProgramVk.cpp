@@ -387,9 +387,11 @@ angle::Result CLProgramVk::build(const cl::DevicePtrs &devices,
     if (notify)
     {
         std::shared_ptr<angle::WaitableEvent> asyncEvent =
-            getPlatform()->postMultiThreadWorkerTask(std::make_shared<CLAsyncBuildTask>(
-                this, devicePtrs, std::string(options ? options : ""), "", buildType,
-                LinkProgramsList{}, notify));
+            getPlatform()->postMultiThreadWorkerTask(
+                std::make_shared<CLAsyncBuildTask>(this, devicePtrs,
+                                                   std::string(options ? options : ""), "",
+                                                   buildType, LinkProgramsList{}, notify),
+                angle::WorkerTaskPriority::Normal);
         ASSERT(asyncEvent != nullptr);
     }
     else
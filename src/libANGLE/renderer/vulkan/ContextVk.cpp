@@ -858,6 +858,8 @@ ContextVk::ContextVk(const gl::State &state, gl::ErrorSet *errorSet, vk::Rendere
       mGraphicsDirtyBitHandlers{},
       mComputeDirtyBitHandlers{},
       mRenderPassCommandBuffer(nullptr),
+      mTimelineTracer(renderer->getTimelineTracer()),
+      mTimelineTrack(state.getContextID().value),
       mCurrentGraphicsPipeline(nullptr),
       mCurrentGraphicsPipelineShaders(nullptr),
       mCurrentGraphicsPipelineVertexInput(nullptr),
@@ -1336,6 +1338,11 @@ angle::Result ContextVk::initialize(const angle::ImageLoadContext &imageLoadCont
 
     mImageLoadContext = imageLoadContext;
 
+    if (mTimelineTracer != nullptr)
+    {
+        mTimelineTracer->setTrackName(mTimelineTrack, "Context " + std::to_string(mTimelineTrack));
+    }
+
     ANGLE_TRY(mShareGroupVk->unifyContextsPriority(this));
 
     ANGLE_TRY(mQueryPools[gl::QueryType::AnySamples].init(this, VK_QUERY_TYPE_OCCLUSION,
@@ -1597,6 +1604,13 @@ angle::Result ContextVk::setupDraw(const gl::Context *context,
 
     ASSERT(mState.getAndResetDirtyUniformBlocks().none());
 
+    if (ANGLE_UNLIKELY(mTimelineTracer != nullptr))
+    {
+        mTimelineTracer->addInstant(mTimelineTrack, "Draw",
+                                    {"count", static_cast<uint64_t>(vertexOrIndexCount)},
+                                    {"instances", static_cast<uint64_t>(instanceCount)});
+    }
+
     return angle::Result::Continue;
 }
 
@@ -1830,6 +1844,11 @@ angle::Result ContextVk::setupDispatch(const gl::Context *context)
 
     ASSERT(mState.getAndResetDirtyUniformBlocks().none());
 
+    if (ANGLE_UNLIKELY(mTimelineTracer != nullptr))
+    {
+        mTimelineTracer->addInstant(mTimelineTrack, "Dispatch");
+    }
+
     return angle::Result::Continue;
 }
 
@@ -3426,6 +3445,7 @@ void ContextVk::syncObjectPerfCounters(const angle::VulkanPerfCounters &commandQ
 {
     mPerfCounters.descriptorSetCacheTotalSize                = 0;
     mPerfCounters.descriptorSetCacheKeySizeBytes             = 0;
+    mPerfCounters.descriptorSetCacheEvictions                = 0;
     mPerfCounters.uniformsAndXfbDescriptorSetCacheHits       = 0;
     mPerfCounters.uniformsAndXfbDescriptorSetCacheMisses     = 0;
     mPerfCounters.uniformsAndXfbDescriptorSetCacheTotalSize  = 0;
@@ -3466,6 +3486,9 @@ void ContextVk::syncObjectPerfCounters(const angle::VulkanPerfCounters &commandQ
     mPerfCounters.descriptorSetCacheTotalSize =
         uniCacheStats.getSize() + texCacheStats.getSize() + resCacheStats.getSize() +
         mVulkanCacheStats[VulkanCacheType::DriverUniformsDescriptors].getSize();
+    mPerfCounters.descriptorSetCacheEvictions = uniCacheStats.getEvictionCount() +
+                                                texCacheStats.getEvictionCount() +
+                                                resCacheStats.getEvictionCount();
 
     mPerfCounters.descriptorSetCacheKeySizeBytes = 0;
 
@@ -3489,6 +3512,11 @@ void ContextVk::syncObjectPerfCounters(const angle::VulkanPerfCounters &commandQ
     // Return current drawFramebuffer's cache stats
     mPerfCounters.framebufferCacheSize = mShareGroupVk->getFramebufferCache().getSize();
 
+    CacheStats spirvTransformCacheStats;
+    mShareGroupVk->getSpirvTransformCache().getCacheStats(&spirvTransformCacheStats);
+    mPerfCounters.spirvTransformCacheHits   = spirvTransformCacheStats.getHitCount();
+    mPerfCounters.spirvTransformCacheMisses = spirvTransformCacheStats.getMissCount();
+
     mPerfCounters.pendingSubmissionGarbageObjects =
         static_cast<uint64_t>(mRenderer->getPendingSubmissionGarbageSize());
 }
@@ -3617,6 +3645,13 @@ void ContextVk::addOverlayUsedBuffersCount(vk::CommandBufferHelperCommon *comman
         descriptorCacheSize->add(mPerfCounters.descriptorSetCacheTotalSize);
         descriptorCacheSize->next();
     }
+
+    {
+        gl::RunningGraphWidget *descriptorCacheEvictions =
+            overlay->getRunningGraphWidget(gl::WidgetId::VulkanDescriptorCacheEvictions);
+        descriptorCacheEvictions->add(mPerfCounters.descriptorSetCacheEvictions);
+        descriptorCacheEvictions->next();
+    }
 }
 
 angle::Result ContextVk::submitCommands(const vk::Semaphore *signalSemaphore,
@@ -3639,9 +3674,23 @@ angle::Result ContextVk::submitCommands(const vk::Semaphore *signalSemaphore,
     ASSERT(QueueSerialsHaveDifferentIndexOrSmaller(mLastSubmittedQueueSerial,
                                                    mLastFlushedQueueSerial));
 
+    const double submitStartTime = mTimelineTracer != nullptr ? angle::GetCurrentSystemTime() : 0;
+
     ANGLE_TRY(mRenderer->submitCommands(this, getProtectionType(), mContextPriority,
                                         signalSemaphore, externalFence, mLastFlushedQueueSerial));
 
+    if (mTimelineTracer != nullptr)
+    {
+        mTimelineTracer->addCompleteSlice(mTimelineTrack, "Submit", submitStartTime,
+                                          {"renderPasses", mPerfCounters.renderPasses});
+        mTimelineTracer->addCounters(mTimelineTrack, "PipelineCache",
+                                     {"hits", mPerfCounters.pipelineCreationCacheHits},
+                                     {"misses", mPerfCounters.pipelineCreationCacheMisses});
+        mTimelineTracer->addCounters(mTimelineTrack, "DescriptorSets",
+                                     {"allocations", mPerfCounters.descriptorSetAllocations},
+                                     {"writes", mPerfCounters.writeDescriptorSets});
+    }
+
     mLastSubmittedQueueSerial = mLastFlushedQueueSerial;
     mSubmittedResourceUse.setQueueSerial(mLastSubmittedQueueSerial);
 
@@ -6163,7 +6212,7 @@ ProgramImpl *ContextVk::createProgram(const gl::ProgramState &state)
 
 ProgramExecutableImpl *ContextVk::createProgramExecutable(const gl::ProgramExecutable *executable)
 {
-    return new ProgramExecutableVk(executable);
+    return new ProgramExecutableVk(executable, &mShareGroupVk->getSpirvTransformCache());
 }
 
 FramebufferImpl *ContextVk::createFramebuffer(const gl::FramebufferState &state)
@@ -7889,6 +7938,11 @@ angle::Result ContextVk::beginNewRenderPass(
         colorAttachmentCount, depthStencilAttachmentIndex, clearValues, renderPassQueueSerial,
         commandBufferOut));
 
+    if (mTimelineTracer != nullptr)
+    {
+        mTimelineTracer->addSliceBegin(mTimelineTrack, "RenderPass");
+    }
+
     // By default all render pass should allow to be reactivated.
     mAllowRenderPassToReactivate = true;
 
@@ -7964,6 +8018,12 @@ angle::Result ContextVk::flushCommandsAndEndRenderPassWithoutSubmit(RenderPassCl
 
     onRenderPassFinished(reason);
 
+    if (mTimelineTracer != nullptr)
+    {
+        mTimelineTracer->addSliceEnd(mTimelineTrack, "RenderPass",
+                                     kRenderPassClosureReason[reason]);
+    }
+
     if (mGpuEventsEnabled)
     {
         EventName eventName = GetTraceEventName("RP", mPerfCounters.renderPasses);
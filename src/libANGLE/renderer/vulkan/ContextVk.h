@@ -1436,6 +1436,11 @@ class ContextVk : public ContextImpl, public vk::Context, public MultisampleText
 
     vk::RenderPassCommandBuffer *mRenderPassCommandBuffer;
 
+    // Timeline tracing, nullptr unless enabled.  The context's work is recorded on the track of
+    // its ID.
+    vk::TimelineTracer *mTimelineTracer;
+    uint32_t mTimelineTrack;
+
     vk::PipelineHelper *mCurrentGraphicsPipeline;
     vk::PipelineHelper *mCurrentGraphicsPipelineShaders;
     vk::PipelineHelper *mCurrentGraphicsPipelineVertexInput;
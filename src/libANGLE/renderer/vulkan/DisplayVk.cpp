@@ -668,10 +668,16 @@ bool DisplayVk::getBlob(const angle::BlobCacheKey &key, angle::BlobCacheValue *v
     return getBlobCache()->get(&mScratchBuffer, key, valueOut);
 }
 
+angle::BlobCompressionCodec DisplayVk::getBlobCompressionCodec() const
+{
+    return getBlobCache()->getCompressionCodec();
+}
+
 std::shared_ptr<angle::WaitableEvent> DisplayVk::postMultiThreadWorkerTask(
-    const std::shared_ptr<angle::Closure> &task)
+    const std::shared_ptr<angle::Closure> &task,
+    angle::WorkerTaskPriority priority)
 {
-    return mState.multiThreadPool->postWorkerTask(task);
+    return mState.multiThreadPool->postWorkerTask(task, priority);
 }
 
 void DisplayVk::notifyDeviceLost()
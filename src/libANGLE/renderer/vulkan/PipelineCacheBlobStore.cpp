@@ -0,0 +1,484 @@
+//
+// Copyright 2024 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// PipelineCacheBlobStore.cpp:
+//    Implements the class methods for PipelineCacheBlobStore.
+//
+
+#include "libANGLE/renderer/vulkan/PipelineCacheBlobStore.h"
+
+#include <algorithm>
+#include <array>
+#include <sstream>
+
+#include "common/debug.h"
+#include "libANGLE/angletypes.h"
+#include "xxhash.h"
+
+namespace rx
+{
+namespace vk
+{
+namespace
+{
+#if defined(ANGLE_ENABLE_CRC_FOR_PIPELINE_CACHE)
+constexpr bool kEnableCRCForPipelineCache = true;
+#else
+constexpr bool kEnableCRCForPipelineCache = false;
+#endif
+
+// Format version of the stored manifest and chunks.  It should be incremented any time there is an
+// update to their layout.
+constexpr uint32_t kPipelineCacheVersion = 3;
+
+// The largest blob stored.  The Android blob cache rejects anything larger.
+constexpr size_t kMaxBlobCacheSize = 64 * 1024;
+
+// Chunk size limits.  The maximum leaves room for the chunk header and for compression expanding
+// incompressible data, so a chunk always fits in a blob.
+constexpr size_t kMinChunkSize = 16 * 1024;
+constexpr size_t kMaxChunkSize = 48 * 1024;
+// A boundary is placed where the top bits of the rolling hash are zero.  With 14 bits, boundaries
+// are on average 16KB apart after the minimum chunk size.
+constexpr uint32_t kChunkBoundaryBits = 14;
+constexpr uint64_t kChunkBoundaryMask =
+    ((uint64_t(1) << kChunkBoundaryBits) - 1) << (64 - kChunkBoundaryBits);
+
+constexpr uint64_t kContentHashSeed = 0x414E474C45504300ull;
+
+static_assert(kMaxChunkSize + 1024 < kMaxBlobCacheSize, "Chunks must fit in a blob");
+
+ANGLE_ENABLE_STRUCT_PADDING_WARNINGS
+struct ManifestHeader
+{
+    uint32_t version;
+    uint32_t chunkCount;
+    uint64_t cacheDataSize;
+};
+
+struct ManifestEntry
+{
+    uint64_t contentHash;
+    uint32_t size;
+    uint32_t reserved;
+};
+
+struct ChunkHeader
+{
+    uint32_t version;
+    uint32_t size;
+    uint64_t contentHash;
+};
+ANGLE_DISABLE_STRUCT_PADDING_WARNINGS
+
+// Random values for the gear rolling hash, generated at compile time with splitmix64.
+constexpr std::array<uint64_t, 256> MakeGearTable()
+{
+    std::array<uint64_t, 256> table = {};
+    uint64_t state                  = 0x9E3779B97F4A7C15ull;
+    for (uint64_t &entry : table)
+    {
+        state += 0x9E3779B97F4A7C15ull;
+        uint64_t value = state;
+        value          = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+        value          = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+        entry          = value ^ (value >> 31);
+    }
+    return table;
+}
+constexpr std::array<uint64_t, 256> kGearTable = MakeGearTable();
+
+uint64_t ComputeContentHash(const uint8_t *data, size_t size)
+{
+    return XXH64(data, size, kContentHashSeed);
+}
+
+void ReportCorruption(const char *message, uint64_t expected, uint64_t actual)
+{
+    if (kEnableCRCForPipelineCache)
+    {
+        ERR() << message << ": expected 0x" << std::hex << expected << ", actual 0x" << actual;
+        FATAL() << "Pipeline cache content hash check failed; possible data corruption.";
+    }
+    else
+    {
+        WARN() << message << ": expected 0x" << std::hex << expected << ", actual 0x" << actual;
+    }
+}
+}  // anonymous namespace
+
+PipelineCacheBlobStore::PipelineCacheBlobStore() = default;
+
+PipelineCacheBlobStore::~PipelineCacheBlobStore() = default;
+
+void PipelineCacheBlobStore::init(const std::string &keyPrefix)
+{
+    mKeyPrefix = keyPrefix;
+    mStoredChunkHashes.clear();
+}
+
+// static
+void PipelineCacheBlobStore::ComputeChunkSizes(const uint8_t *data,
+                                               size_t size,
+                                               std::vector<size_t> *sizesOut)
+{
+    sizesOut->clear();
+
+    size_t chunkStart = 0;
+    while (chunkStart < size)
+    {
+        const size_t remaining = size - chunkStart;
+        if (remaining <= kMinChunkSize)
+        {
+            sizesOut->push_back(remaining);
+            break;
+        }
+
+        const size_t limit = std::min(remaining, kMaxChunkSize);
+        size_t chunkSize   = kMinChunkSize;
+        uint64_t hash      = 0;
+
+        // Prime the rolling hash with the bytes preceding the earliest possible boundary, so the
+        // boundary only depends on the data in its neighborhood.
+        for (size_t i = kMinChunkSize - 64; i < kMinChunkSize; ++i)
+        {
+            hash = (hash << 1) + kGearTable[data[chunkStart + i]];
+        }
+
+        while (chunkSize < limit && (hash & kChunkBoundaryMask) != 0)
+        {
+            hash = (hash << 1) + kGearTable[data[chunkStart + chunkSize]];
+            ++chunkSize;
+        }
+
+        sizesOut->push_back(chunkSize);
+        chunkStart += chunkSize;
+    }
+}
+
+// static
+bool PipelineCacheBlobStore::IsContentHashMismatchFatal()
+{
+    return kEnableCRCForPipelineCache;
+}
+
+angle::BlobCacheKey PipelineCacheBlobStore::computeKey(const char *kind,
+                                                       uint64_t contentHash) const
+{
+    std::ostringstream hashStream(mKeyPrefix, std::ios_base::ate);
+    hashStream << kind << std::hex << contentHash;
+
+    const std::string &hashString = hashStream.str();
+    angle::BlobCacheKey key;
+    angle::base::SHA1HashBytes(reinterpret_cast<const unsigned char *>(hashString.c_str()),
+                               hashString.length(), key.data());
+    return key;
+}
+
+bool PipelineCacheBlobStore::isChunkStored(GlobalOps *globalOps, uint64_t contentHash) const
+{
+    angle::BlobCacheValue chunkBlob;
+    return globalOps->getBlob(computeKey("chunk", contentHash), &chunkBlob) &&
+           chunkBlob.size() >= sizeof(ChunkHeader);
+}
+
+bool PipelineCacheBlobStore::detectEviction(GlobalOps *globalOps)
+{
+    if (mStoredChunkHashes.empty())
+    {
+        return false;
+    }
+
+    // The manifest is replaced on every store, so it is missing or different only if the blob
+    // cache was cleared or written by someone else.
+    angle::BlobCacheValue manifestBlob;
+    if (!globalOps->getBlob(computeKey("manifest", 0), &manifestBlob) ||
+        ComputeContentHash(manifestBlob.data(), manifestBlob.size()) != mStoredManifestHash)
+    {
+        return true;
+    }
+
+    // Looking the chunk up makes it the most recently used, so the next store checks the one that
+    // follows it.
+    const uint64_t oldestChunkHash = mChunkCheckOrder.front();
+    std::rotate(mChunkCheckOrder.begin(), mChunkCheckOrder.begin() + 1, mChunkCheckOrder.end());
+    return !isChunkStored(globalOps, oldestChunkHash);
+}
+
+void PipelineCacheBlobStore::reset()
+{
+    mStoredChunkHashes.clear();
+    mChunkCheckOrder.clear();
+    mStoredManifestHash = 0;
+    mStoredDataHash     = 0;
+    mStoredDataSize     = 0;
+}
+
+bool PipelineCacheBlobStore::store(GlobalOps *globalOps,
+                                   const uint8_t *cacheData,
+                                   size_t cacheDataSize,
+                                   size_t maxTotalSize,
+                                   StoreStats *statsOut)
+{
+    *statsOut = {};
+
+    if (cacheDataSize >= maxTotalSize)
+    {
+        WARN() << "Skip syncing pipeline cache data when it's larger than maxTotalSize.";
+        return false;
+    }
+
+    // Without evictions, storing the data that was last stored or loaded changes nothing.
+    const bool evictionDetected = detectEviction(globalOps);
+    const uint64_t dataHash     = ComputeContentHash(cacheData, cacheDataSize);
+    if (!evictionDetected && !mStoredChunkHashes.empty() && cacheDataSize == mStoredDataSize &&
+        dataHash == mStoredDataHash)
+    {
+        statsOut->unchanged = true;
+        return true;
+    }
+
+    std::vector<size_t> chunkSizes;
+    ComputeChunkSizes(cacheData, cacheDataSize, &chunkSizes);
+
+    const size_t manifestSize = sizeof(ManifestHeader) + chunkSizes.size() * sizeof(ManifestEntry);
+    if (manifestSize > kMaxBlobCacheSize)
+    {
+        WARN() << "Skip syncing pipeline cache data as it has too many chunks: "
+               << chunkSizes.size();
+        return false;
+    }
+
+    angle::MemoryBuffer manifest;
+    if (!manifest.resize(manifestSize))
+    {
+        WARN() << "Skip syncing pipeline cache data due to out of memory.";
+        return false;
+    }
+
+    ManifestHeader manifestHeader = {};
+    manifestHeader.version        = kPipelineCacheVersion;
+    manifestHeader.chunkCount     = static_cast<uint32_t>(chunkSizes.size());
+    manifestHeader.cacheDataSize  = cacheDataSize;
+    memcpy(manifest.data(), &manifestHeader, sizeof(ManifestHeader));
+
+    const angle::BlobCompressionCodec codec = globalOps->getBlobCompressionCodec();
+    angle::HashSet<uint64_t> chunkHashes;
+    std::vector<uint64_t> newChunkHashes;
+    angle::MemoryBuffer compressedData;
+    angle::MemoryBuffer chunkBlob;
+    size_t offset = 0;
+
+    for (size_t chunkIndex = 0; chunkIndex < chunkSizes.size(); ++chunkIndex)
+    {
+        const uint8_t *chunkData = cacheData + offset;
+        const size_t chunkSize   = chunkSizes[chunkIndex];
+        const uint64_t chunkHash = ComputeContentHash(chunkData, chunkSize);
+        offset += chunkSize;
+
+        ManifestEntry entry = {};
+        entry.contentHash   = chunkHash;
+        entry.size          = static_cast<uint32_t>(chunkSize);
+        memcpy(manifest.data() + sizeof(ManifestHeader) + chunkIndex * sizeof(ManifestEntry),
+               &entry, sizeof(ManifestEntry));
+
+        // Identical chunks are only stored once.
+        if (!chunkHashes.insert(chunkHash).second)
+        {
+            continue;
+        }
+
+        // Unchanged chunks were already stored.  Once the blob cache is found to have evicted
+        // some, they are looked up to find which.
+        if (mStoredChunkHashes.count(chunkHash) != 0 &&
+            (!evictionDetected || isChunkStored(globalOps, chunkHash)))
+        {
+            if (evictionDetected)
+            {
+                newChunkHashes.push_back(chunkHash);
+            }
+            continue;
+        }
+        newChunkHashes.push_back(chunkHash);
+
+        if (!angle::CompressBlob(chunkSize, chunkData, &compressedData, codec))
+        {
+            WARN() << "Skip syncing pipeline cache data as it failed compression.";
+            return false;
+        }
+
+        if (!chunkBlob.resize(sizeof(ChunkHeader) + compressedData.size()))
+        {
+            WARN() << "Skip syncing pipeline cache data due to out of memory.";
+            return false;
+        }
+        ASSERT(chunkBlob.size() <= kMaxBlobCacheSize);
+
+        ChunkHeader chunkHeader = {};
+        chunkHeader.version     = kPipelineCacheVersion;
+        chunkHeader.size        = static_cast<uint32_t>(chunkSize);
+        chunkHeader.contentHash = chunkHash;
+        memcpy(chunkBlob.data(), &chunkHeader, sizeof(ChunkHeader));
+        memcpy(chunkBlob.data() + sizeof(ChunkHeader), compressedData.data(),
+               compressedData.size());
+
+        globalOps->putBlob(computeKey("chunk", chunkHash), chunkBlob);
+
+        statsOut->chunksStored++;
+        statsOut->bytesCompressed += chunkSize;
+        statsOut->compressedBytes += compressedData.size();
+    }
+
+    // The manifest is stored last, so an interrupted sync leaves the previous manifest pointing to
+    // chunks that are still all present.
+    globalOps->putBlob(computeKey("manifest", 0), manifest);
+
+    statsOut->chunkCount = chunkSizes.size();
+
+    // The chunks that weren't looked up or stored keep their place in the eviction order, ahead
+    // of the ones that were.
+    std::vector<uint64_t> checkOrder;
+    checkOrder.reserve(chunkHashes.size());
+    if (!evictionDetected)
+    {
+        for (uint64_t chunkHash : mChunkCheckOrder)
+        {
+            if (chunkHashes.count(chunkHash) != 0)
+            {
+                checkOrder.push_back(chunkHash);
+            }
+        }
+    }
+    checkOrder.insert(checkOrder.end(), newChunkHashes.begin(), newChunkHashes.end());
+
+    mStoredChunkHashes  = std::move(chunkHashes);
+    mChunkCheckOrder    = std::move(checkOrder);
+    mStoredManifestHash = ComputeContentHash(manifest.data(), manifest.size());
+    mStoredDataHash     = dataHash;
+    mStoredDataSize     = cacheDataSize;
+
+    return true;
+}
+
+bool PipelineCacheBlobStore::load(GlobalOps *globalOps,
+                                  size_t maxTotalSize,
+                                  angle::MemoryBuffer *cacheDataOut)
+{
+    reset();
+
+    angle::BlobCacheValue manifestBlob;
+    if (!globalOps->getBlob(computeKey("manifest", 0), &manifestBlob) ||
+        manifestBlob.size() < sizeof(ManifestHeader))
+    {
+        // Nothing in the cache.
+        return false;
+    }
+
+    ManifestHeader manifestHeader;
+    memcpy(&manifestHeader, manifestBlob.data(), sizeof(ManifestHeader));
+    if (manifestHeader.version != kPipelineCacheVersion)
+    {
+        WARN() << "Change in cache header version detected: " << "newVersion = "
+               << kPipelineCacheVersion << ", existingVersion = " << manifestHeader.version;
+        return false;
+    }
+
+    if (manifestBlob.size() !=
+            sizeof(ManifestHeader) + manifestHeader.chunkCount * sizeof(ManifestEntry) ||
+        manifestHeader.cacheDataSize >= maxTotalSize)
+    {
+        WARN() << "Pipeline cache manifest corrupted: chunkCount = " << manifestHeader.chunkCount
+               << ", cacheDataSize = " << manifestHeader.cacheDataSize
+               << ", manifest size = " << manifestBlob.size();
+        return false;
+    }
+
+    const uint64_t manifestHash = ComputeContentHash(manifestBlob.data(), manifestBlob.size());
+
+    // The manifest blob may be backed by scratch memory reused by the following getBlob calls.
+    std::vector<ManifestEntry> entries(manifestHeader.chunkCount);
+    memcpy(entries.data(), manifestBlob.data() + sizeof(ManifestHeader),
+           entries.size() * sizeof(ManifestEntry));
+
+    if (!cacheDataOut->resize(static_cast<size_t>(manifestHeader.cacheDataSize)))
+    {
+        WARN() << "Failed to allocate memory for pipeline cache data.";
+        return false;
+    }
+
+    angle::HashSet<uint64_t> chunkHashes;
+    std::vector<uint64_t> checkOrder;
+    angle::MemoryBuffer chunkData;
+    size_t offset = 0;
+
+    for (size_t chunkIndex = 0; chunkIndex < entries.size(); ++chunkIndex)
+    {
+        const ManifestEntry &entry = entries[chunkIndex];
+
+        angle::BlobCacheValue chunkBlob;
+        if (!globalOps->getBlob(computeKey("chunk", entry.contentHash), &chunkBlob) ||
+            chunkBlob.size() < sizeof(ChunkHeader))
+        {
+            // Can't find every part of the cache data.
+            WARN() << "Failed to get pipeline cache chunk " << chunkIndex << " of "
+                   << entries.size();
+            return false;
+        }
+
+        ChunkHeader chunkHeader;
+        memcpy(&chunkHeader, chunkBlob.data(), sizeof(ChunkHeader));
+        if (chunkHeader.version != kPipelineCacheVersion || chunkHeader.size != entry.size ||
+            chunkHeader.contentHash != entry.contentHash ||
+            offset + entry.size > cacheDataOut->size())
+        {
+            WARN() << "Pipeline cache chunk header corrupted: chunkIndex = " << chunkIndex
+                   << ", version = " << chunkHeader.version << ", size = " << chunkHeader.size
+                   << ", expected size = " << entry.size;
+            return false;
+        }
+
+        if (!angle::DecompressBlob(chunkBlob.data() + sizeof(ChunkHeader),
+                                   chunkBlob.size() - sizeof(ChunkHeader), entry.size,
+                                   &chunkData) ||
+            chunkData.size() != entry.size)
+        {
+            WARN() << "Failed to decompress pipeline cache chunk " << chunkIndex;
+            return false;
+        }
+
+        const uint64_t actualHash = ComputeContentHash(chunkData.data(), chunkData.size());
+        if (actualHash != entry.contentHash)
+        {
+            ReportCorruption("Pipeline cache chunk content hash mismatch", entry.contentHash,
+                             actualHash);
+            return false;
+        }
+
+        memcpy(cacheDataOut->data() + offset, chunkData.data(), chunkData.size());
+        offset += chunkData.size();
+        if (chunkHashes.insert(entry.contentHash).second)
+        {
+            checkOrder.push_back(entry.contentHash);
+        }
+    }
+
+    if (offset != cacheDataOut->size())
+    {
+        WARN() << "Expected pipeline cache size = " << cacheDataOut->size()
+               << ", Actual size = " << offset;
+        return false;
+    }
+
+    // Everything referenced by the manifest is known to be present, so the next sync only needs
+    // to store new chunks.
+    mStoredChunkHashes  = std::move(chunkHashes);
+    mChunkCheckOrder    = std::move(checkOrder);
+    mStoredManifestHash = manifestHash;
+    mStoredDataHash     = ComputeContentHash(cacheDataOut->data(), cacheDataOut->size());
+    mStoredDataSize     = cacheDataOut->size();
+    return true;
+}
+}  // namespace vk
+}  // namespace rx
@@ -0,0 +1,98 @@
+//
+// Copyright 2024 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// PipelineCacheBlobStore.h:
+//    Persists the contents of a VkPipelineCache in the blob cache as content-defined chunks, so
+//    that a sync only compresses and stores the parts of the cache that changed since the last one.
+//
+
+#ifndef LIBANGLE_RENDERER_VULKAN_PIPELINECACHEBLOBSTORE_H_
+#define LIBANGLE_RENDERER_VULKAN_PIPELINECACHEBLOBSTORE_H_
+
+#include <string>
+#include <vector>
+
+#include "common/angleutils.h"
+#include "libANGLE/renderer/vulkan/vk_utils.h"
+
+namespace rx
+{
+namespace vk
+{
+// The pipeline cache data is split into chunks at boundaries chosen by a rolling hash of the data,
+// so inserting or growing pipelines in the middle of the cache only changes the chunks around the
+// modification.  Each chunk is compressed independently and stored under a key derived from its
+// content hash.  A manifest stored under a fixed key lists the hashes of the chunks making up the
+// cache, in order.
+//
+// Chunks that were already stored (or loaded) are not compressed or stored again, which makes the
+// cost of a sync proportional to the amount of new data rather than to the size of the cache.
+// Reading chunks back from the blob cache copies them through the application's callbacks, so
+// the stored chunks are only looked up again once an eviction is detected.
+class PipelineCacheBlobStore final : angle::NonCopyable
+{
+  public:
+    struct StoreStats
+    {
+        size_t chunkCount      = 0;
+        size_t chunksStored    = 0;
+        size_t bytesCompressed = 0;
+        size_t compressedBytes = 0;
+        // Set if the data was the same as the data last stored or loaded, so nothing was stored.
+        bool unchanged = false;
+    };
+
+    PipelineCacheBlobStore();
+    ~PipelineCacheBlobStore();
+
+    // |keyPrefix| identifies the device the pipeline cache belongs to, and is included in every
+    // key so caches of different devices don't collide.
+    void init(const std::string &keyPrefix);
+
+    // Stores |cacheData| in the blob cache.  Returns false if the data could not be stored, in
+    // which case the previously stored cache (if any) is left intact.
+    bool store(GlobalOps *globalOps,
+               const uint8_t *cacheData,
+               size_t cacheDataSize,
+               size_t maxTotalSize,
+               StoreStats *statsOut);
+
+    // Loads the cache previously stored with store().  Returns false if there is no stored cache
+    // or it is incomplete or corrupt.
+    bool load(GlobalOps *globalOps, size_t maxTotalSize, angle::MemoryBuffer *cacheDataOut);
+
+    // Forgets which chunks were stored, so the next store() stores everything again.
+    void reset();
+
+    // Splits |data| into content-defined chunks, returning the size of each chunk.  Exposed for
+    // testing.
+    static void ComputeChunkSizes(const uint8_t *data, size_t size, std::vector<size_t> *sizesOut);
+
+    // Whether a chunk content hash mismatch is fatal rather than just failing load().  Exposed for
+    // testing.
+    static bool IsContentHashMismatchFatal();
+
+  private:
+    angle::BlobCacheKey computeKey(const char *kind, uint64_t contentHash) const;
+    bool isChunkStored(GlobalOps *globalOps, uint64_t contentHash) const;
+    bool detectEviction(GlobalOps *globalOps);
+
+    std::string mKeyPrefix;
+    // Hashes of the chunks known to be in the blob cache.  Only chunks referenced by the last
+    // stored or loaded manifest are remembered.
+    angle::HashSet<uint64_t> mStoredChunkHashes;
+    // The same chunks, least recently stored or looked up first.  The blob cache evicts the least
+    // recently used blobs first, so checking that the first chunk is still there detects that
+    // chunks were evicted.
+    std::vector<uint64_t> mChunkCheckOrder;
+    // Hashes of the last stored or loaded manifest and cache data.
+    uint64_t mStoredManifestHash = 0;
+    uint64_t mStoredDataHash     = 0;
+    size_t mStoredDataSize       = 0;
+};
+}  // namespace vk
+}  // namespace rx
+
+#endif  // LIBANGLE_RENDERER_VULKAN_PIPELINECACHEBLOBSTORE_H_
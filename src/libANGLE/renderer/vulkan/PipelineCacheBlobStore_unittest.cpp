@@ -0,0 +1,359 @@
+//
+// Copyright 2024 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// PipelineCacheBlobStore_unittest.cpp:
+//   Unit tests for storing the Vulkan pipeline cache in the blob cache as chunks.
+//
+
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <map>
+#include <random>
+
+#include "libANGLE/renderer/vulkan/PipelineCacheBlobStore.h"
+
+namespace rx
+{
+namespace vk
+{
+namespace
+{
+constexpr size_t kMaxTotalSize = std::numeric_limits<size_t>::max();
+
+// Stores blobs in memory, standing in for the blob cache.  Like the blob cache, it evicts the least
+// recently used blobs first.
+class MemoryGlobalOps : public GlobalOps
+{
+  public:
+    void putBlob(const angle::BlobCacheKey &key, const angle::MemoryBuffer &value) override
+    {
+        mBlobs[key].assign(value.data(), value.data() + value.size());
+        mLastUse[key] = ++mUseCount;
+        mLastPutKey   = key;
+    }
+
+    bool getBlob(const angle::BlobCacheKey &key, angle::BlobCacheValue *valueOut) override
+    {
+        if (key != mLastPutKey)
+        {
+            mChunkLookups++;
+        }
+
+        auto iter = mBlobs.find(key);
+        if (iter == mBlobs.end())
+        {
+            return false;
+        }
+        *valueOut     = angle::BlobCacheValue(iter->second.data(), iter->second.size());
+        mLastUse[key] = ++mUseCount;
+        return true;
+    }
+
+    angle::BlobCompressionCodec getBlobCompressionCodec() const override { return mCodec; }
+
+    std::shared_ptr<angle::WaitableEvent> postMultiThreadWorkerTask(
+        const std::shared_ptr<angle::Closure> &task,
+        angle::WorkerTaskPriority priority) override
+    {
+        (*task)();
+        return std::make_shared<angle::WaitableEventDone>();
+    }
+
+    void notifyDeviceLost() override {}
+
+    void setBlobCompressionCodec(angle::BlobCompressionCodec codec) { mCodec = codec; }
+
+    // The manifest is the last blob stored by PipelineCacheBlobStore::store().
+    std::vector<uint8_t> &manifest() { return mBlobs[mLastPutKey]; }
+
+    // Returns the chunks, which are all the blobs but the manifest.
+    std::vector<std::vector<uint8_t> *> chunks()
+    {
+        std::vector<std::vector<uint8_t> *> chunks;
+        for (auto &blob : mBlobs)
+        {
+            if (blob.first != mLastPutKey)
+            {
+                chunks.push_back(&blob.second);
+            }
+        }
+        return chunks;
+    }
+
+    // Evicts the least recently used chunk.
+    void evictChunk()
+    {
+        auto evicted = mBlobs.end();
+        for (auto iter = mBlobs.begin(); iter != mBlobs.end(); ++iter)
+        {
+            if (iter->first != mLastPutKey &&
+                (evicted == mBlobs.end() || mLastUse[iter->first] < mLastUse[evicted->first]))
+            {
+                evicted = iter;
+            }
+        }
+        ASSERT_NE(evicted, mBlobs.end());
+        mBlobs.erase(evicted);
+    }
+
+    void evictManifest() { mBlobs.erase(mLastPutKey); }
+
+    // The number of times a chunk was looked up, which copies it through the application's
+    // callbacks.
+    size_t chunkLookups() const { return mChunkLookups; }
+
+  private:
+    std::map<angle::BlobCacheKey, std::vector<uint8_t>> mBlobs;
+    std::map<angle::BlobCacheKey, uint64_t> mLastUse;
+    uint64_t mUseCount   = 0;
+    size_t mChunkLookups = 0;
+    angle::BlobCacheKey mLastPutKey;
+    angle::BlobCompressionCodec mCodec = angle::BlobCompressionCodec::Gzip;
+};
+
+std::vector<uint8_t> MakeCacheData(size_t size, uint32_t seed)
+{
+    std::mt19937 generator(seed);
+    std::vector<uint8_t> data(size);
+    for (uint8_t &byte : data)
+    {
+        byte = static_cast<uint8_t>(generator());
+    }
+    return data;
+}
+
+class PipelineCacheBlobStoreTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        mCacheData = MakeCacheData(256 * 1024, 1);
+        mBlobStore.init("PipelineCacheBlobStoreTest");
+    }
+
+    bool store()
+    {
+        return mBlobStore.store(&mGlobalOps, mCacheData.data(), mCacheData.size(), kMaxTotalSize,
+                                &mStats);
+    }
+
+    // Loads with a fresh store, as a new process would.
+    bool load(angle::MemoryBuffer *cacheDataOut)
+    {
+        PipelineCacheBlobStore blobStore;
+        blobStore.init("PipelineCacheBlobStoreTest");
+        return blobStore.load(&mGlobalOps, kMaxTotalSize, cacheDataOut);
+    }
+
+    void expectLoadedCacheData()
+    {
+        angle::MemoryBuffer loaded;
+        ASSERT_TRUE(load(&loaded));
+        ASSERT_EQ(loaded.size(), mCacheData.size());
+        EXPECT_EQ(memcmp(loaded.data(), mCacheData.data(), mCacheData.size()), 0);
+    }
+
+    std::vector<uint8_t> mCacheData;
+    MemoryGlobalOps mGlobalOps;
+    PipelineCacheBlobStore mBlobStore;
+    PipelineCacheBlobStore::StoreStats mStats;
+};
+
+// Tests that chunk boundaries only depend on the data around them, so a modification only changes
+// the chunks it touches.
+TEST(PipelineCacheBlobStoreChunkTest, ChunkBoundariesAreContentDefined)
+{
+    std::vector<uint8_t> data = MakeCacheData(512 * 1024, 2);
+
+    std::vector<size_t> sizes;
+    PipelineCacheBlobStore::ComputeChunkSizes(data.data(), data.size(), &sizes);
+    ASSERT_GT(sizes.size(), 4u);
+
+    size_t total = 0;
+    for (size_t size : sizes)
+    {
+        total += size;
+    }
+    EXPECT_EQ(total, data.size());
+
+    // Insert data in the middle of the second chunk.
+    std::vector<uint8_t> inserted = MakeCacheData(1000, 3);
+    data.insert(data.begin() + sizes[0] + sizes[1] / 2, inserted.begin(), inserted.end());
+
+    std::vector<size_t> newSizes;
+    PipelineCacheBlobStore::ComputeChunkSizes(data.data(), data.size(), &newSizes);
+    EXPECT_EQ(newSizes[0], sizes[0]);
+    EXPECT_EQ(newSizes.back(), sizes.back());
+}
+
+// Tests that the stored cache is loaded back intact.
+TEST_F(PipelineCacheBlobStoreTest, StoreAndLoad)
+{
+    ASSERT_TRUE(store());
+    EXPECT_GT(mStats.chunkCount, 1u);
+    EXPECT_EQ(mStats.chunksStored, mStats.chunkCount);
+
+    expectLoadedCacheData();
+}
+
+// Tests that storing an unmodified cache again doesn't store any chunk, and that modifying it
+// only stores the modified chunks.
+TEST_F(PipelineCacheBlobStoreTest, StoreOnlyChangedChunks)
+{
+    ASSERT_TRUE(store());
+    const size_t chunkCount = mStats.chunkCount;
+
+    ASSERT_TRUE(store());
+    EXPECT_EQ(mStats.chunksStored, 0u);
+
+    mCacheData[mCacheData.size() / 2] ^= 0xFF;
+    ASSERT_TRUE(store());
+    EXPECT_GE(mStats.chunksStored, 1u);
+    EXPECT_LT(mStats.chunksStored, chunkCount);
+
+    expectLoadedCacheData();
+}
+
+// Tests that chunks are compressed with the codec of the blob cache, and that a cache stored with
+// any codec is loaded back intact.
+TEST_F(PipelineCacheBlobStoreTest, CompressionCodecs)
+{
+    constexpr angle::BlobCompressionCodec kCodecs[] = {
+        angle::BlobCompressionCodec::Gzip,
+        angle::BlobCompressionCodec::Lz4,
+        angle::BlobCompressionCodec::DeflateBest,
+        angle::BlobCompressionCodec::Uncompressed,
+    };
+
+    constexpr size_t kChunkHeaderSize = 16;
+    for (angle::BlobCompressionCodec codec : kCodecs)
+    {
+        mGlobalOps.setBlobCompressionCodec(codec);
+        mBlobStore.reset();
+        ASSERT_TRUE(store());
+
+        for (const std::vector<uint8_t> *chunk : mGlobalOps.chunks())
+        {
+            ASSERT_GT(chunk->size(), kChunkHeaderSize);
+            EXPECT_EQ(codec, angle::GetBlobCompressionCodec(chunk->data() + kChunkHeaderSize,
+                                                            chunk->size() - kChunkHeaderSize));
+        }
+
+        expectLoadedCacheData();
+    }
+}
+
+// Tests that an unchanged chunk evicted from the blob cache is stored again by the next store.
+TEST_F(PipelineCacheBlobStoreTest, StoreAfterChunkEviction)
+{
+    ASSERT_TRUE(store());
+
+    mGlobalOps.evictChunk();
+    angle::MemoryBuffer loaded;
+    EXPECT_FALSE(load(&loaded));
+
+    ASSERT_TRUE(store());
+    EXPECT_EQ(mStats.chunksStored, 1u);
+
+    expectLoadedCacheData();
+}
+
+// Tests that stored chunks are not looked up again by the following stores, and that storing
+// the same data again stores nothing.
+TEST_F(PipelineCacheBlobStoreTest, StoreWithoutChunkLookups)
+{
+    ASSERT_TRUE(store());
+    EXPECT_FALSE(mStats.unchanged);
+
+    // Each store only checks the least recently used chunk for evictions.
+    size_t chunkLookups = mGlobalOps.chunkLookups();
+    ASSERT_TRUE(store());
+    EXPECT_TRUE(mStats.unchanged);
+    EXPECT_EQ(mStats.chunksStored, 0u);
+    EXPECT_EQ(mGlobalOps.chunkLookups(), chunkLookups + 1);
+
+    chunkLookups = mGlobalOps.chunkLookups();
+    mCacheData[mCacheData.size() / 2] ^= 0xFF;
+    ASSERT_TRUE(store());
+    EXPECT_FALSE(mStats.unchanged);
+    EXPECT_GE(mStats.chunksStored, 1u);
+    EXPECT_EQ(mGlobalOps.chunkLookups(), chunkLookups + 1);
+
+    expectLoadedCacheData();
+}
+
+// Tests that all chunks are checked again once the manifest is found to have been evicted.
+TEST_F(PipelineCacheBlobStoreTest, StoreAfterManifestEviction)
+{
+    ASSERT_TRUE(store());
+    const size_t chunkCount = mStats.chunkCount;
+
+    mGlobalOps.evictManifest();
+    const size_t chunkLookups = mGlobalOps.chunkLookups();
+    ASSERT_TRUE(store());
+    EXPECT_FALSE(mStats.unchanged);
+    EXPECT_EQ(mStats.chunksStored, 0u);
+    EXPECT_EQ(mGlobalOps.chunkLookups(), chunkLookups + chunkCount);
+
+    expectLoadedCacheData();
+}
+
+// Tests that a truncated manifest is rejected.
+TEST_F(PipelineCacheBlobStoreTest, CorruptedManifest)
+{
+    ASSERT_TRUE(store());
+
+    mGlobalOps.manifest().pop_back();
+
+    angle::MemoryBuffer loaded;
+    EXPECT_FALSE(load(&loaded));
+}
+
+// Tests that a manifest of another version is rejected.
+TEST_F(PipelineCacheBlobStoreTest, ManifestVersionMismatch)
+{
+    ASSERT_TRUE(store());
+
+    // The version is the first field of the manifest.
+    mGlobalOps.manifest()[0] ^= 0xFF;
+
+    angle::MemoryBuffer loaded;
+    EXPECT_FALSE(load(&loaded));
+}
+
+// Tests that a chunk whose data doesn't match the content hash recorded in the manifest is
+// rejected.
+TEST_F(PipelineCacheBlobStoreTest, ChunkContentHashMismatch)
+{
+    ASSERT_TRUE(store());
+
+    // Keep the chunk header, which holds the expected size and hash, and replace the data with
+    // other data of the same size.
+    constexpr size_t kChunkHeaderSize = 16;
+    std::vector<uint8_t> &chunk       = *mGlobalOps.chunks()[0];
+    uint32_t chunkSize                = 0;
+    memcpy(&chunkSize, chunk.data() + sizeof(uint32_t), sizeof(uint32_t));
+
+    std::vector<uint8_t> otherData = MakeCacheData(chunkSize, 4);
+    angle::MemoryBuffer compressed;
+    ASSERT_TRUE(angle::CompressBlob(otherData.size(), otherData.data(), &compressed));
+
+    chunk.resize(kChunkHeaderSize);
+    chunk.insert(chunk.end(), compressed.data(), compressed.data() + compressed.size());
+
+    angle::MemoryBuffer loaded;
+    if (PipelineCacheBlobStore::IsContentHashMismatchFatal())
+    {
+        EXPECT_DEATH_IF_SUPPORTED(load(&loaded), "");
+    }
+    else
+    {
+        EXPECT_FALSE(load(&loaded));
+    }
+}
+}  // anonymous namespace
+}  // namespace vk
+}  // namespace rx
@@ -211,8 +211,11 @@ void GetPipelineCacheData(ContextVk *contextVk,
             return;
         }
 
-        // Compress it.
-        if (!angle::CompressBlob(pipelineCacheData.size(), pipelineCacheData.data(), cacheDataOut))
+        // Compress it with the codec of the blob cache the program binary ends up in.
+        const angle::BlobCompressionCodec codec =
+            contextVk->getRenderer()->getGlobalOps()->getBlobCompressionCodec();
+        if (!angle::CompressBlob(pipelineCacheData.size(), pipelineCacheData.data(), cacheDataOut,
+                                 codec))
         {
             cacheDataOut->clear();
         }
@@ -542,12 +545,11 @@ angle::Result ProgramInfo::initProgram(vk::Context *context,
                                        bool isTransformFeedbackProgram,
                                        const ShaderInfo &shaderInfo,
                                        ProgramTransformOptions optionBits,
-                                       const ShaderInterfaceVariableInfoMap &variableInfoMap)
+                                       const ShaderInterfaceVariableInfoMap &variableInfoMap,
+                                       SpirvTransformCache *spirvTransformCache)
 {
     const gl::ShaderMap<angle::spirv::Blob> &originalSpirvBlobs = shaderInfo.getSpirvBlobs();
     const angle::spirv::Blob &originalSpirvBlob                 = originalSpirvBlobs[shaderType];
-    gl::ShaderMap<angle::spirv::Blob> transformedSpirvBlobs;
-    angle::spirv::Blob &transformedSpirvBlob = transformedSpirvBlobs[shaderType];
 
     SpvTransformOptions options;
     options.shaderType               = shaderType;
@@ -562,11 +564,12 @@ angle::Result ProgramInfo::initProgram(vk::Context *context,
     options.useSpirvVaryingPrecisionFixer =
         context->getFeatures().varyingsRequireMatchingPrecisionInSpirv.enabled;
 
-    ANGLE_TRY(
-        SpvTransformSpirvCode(options, variableInfoMap, originalSpirvBlob, &transformedSpirvBlob));
+    std::shared_ptr<const angle::spirv::Blob> transformedSpirvBlob;
+    ANGLE_TRY(spirvTransformCache->getTransformedSpirv(context, options, variableInfoMap,
+                                                       originalSpirvBlob, &transformedSpirvBlob));
     ANGLE_TRY(vk::InitShaderModule(context, &mShaders[shaderType].get(),
-                                   transformedSpirvBlob.data(),
-                                   transformedSpirvBlob.size() * sizeof(uint32_t)));
+                                   transformedSpirvBlob->data(),
+                                   transformedSpirvBlob->size() * sizeof(uint32_t)));
 
     mProgramHelper.setShader(shaderType, &mShaders[shaderType]);
 
@@ -583,11 +586,13 @@ void ProgramInfo::release(ContextVk *contextVk)
     }
 }
 
-ProgramExecutableVk::ProgramExecutableVk(const gl::ProgramExecutable *executable)
+ProgramExecutableVk::ProgramExecutableVk(const gl::ProgramExecutable *executable,
+                                         SpirvTransformCache *spirvTransformCache)
     : ProgramExecutableImpl(executable),
       mImmutableSamplersMaxDescriptorCount(1),
       mUniformBufferDescriptorType(VK_DESCRIPTOR_TYPE_MAX_ENUM),
       mDynamicUniformDescriptorOffsets{},
+      mSpirvTransformCache(spirvTransformCache),
       mWarmUpGraphicsPipelineDesc{}
 {
     mDescriptorSets.fill(VK_NULL_HANDLE);
@@ -671,12 +676,13 @@ void ProgramExecutableVk::reset(ContextVk *contextVk)
 
 angle::Result ProgramExecutableVk::initializePipelineCache(vk::Context *context,
                                                            bool compressed,
-                                                           const std::vector<uint8_t> &pipelineData)
+                                                           const uint8_t *pipelineData,
+                                                           size_t pipelineDataSize)
 {
     ASSERT(!mPipelineCache.valid());
 
-    size_t dataSize            = pipelineData.size();
-    const uint8_t *dataPointer = pipelineData.data();
+    size_t dataSize            = pipelineDataSize;
+    const uint8_t *dataPointer = pipelineData;
 
     angle::MemoryBuffer uncompressedData;
     if (compressed)
@@ -742,14 +748,20 @@ angle::Result ProgramExecutableVk::load(ContextVk *contextVk,
         size_t compressedPipelineDataSize = 0;
         stream->readInt<size_t>(&compressedPipelineDataSize);
 
-        std::vector<uint8_t> compressedPipelineData(compressedPipelineDataSize);
         if (compressedPipelineDataSize > 0)
         {
             bool compressedData = false;
             stream->readBool(&compressedData);
-            stream->readBytes(compressedPipelineData.data(), compressedPipelineDataSize);
+            // The pipeline cache data is consumed in place.
+            const uint8_t *compressedPipelineData = stream->getBytes(compressedPipelineDataSize);
+            if (compressedPipelineData == nullptr)
+            {
+                *resultOut = egl::CacheGetResult::Rejected;
+                return angle::Result::Continue;
+            }
             // Initialize the pipeline cache based on cached data.
-            ANGLE_TRY(initializePipelineCache(contextVk, compressedData, compressedPipelineData));
+            ANGLE_TRY(initializePipelineCache(contextVk, compressedData, compressedPipelineData,
+                                              compressedPipelineDataSize));
         }
     }
 
@@ -77,7 +77,8 @@ class ProgramInfo final : angle::NonCopyable
                               bool isTransformFeedbackProgram,
                               const ShaderInfo &shaderInfo,
                               ProgramTransformOptions optionBits,
-                              const ShaderInterfaceVariableInfoMap &variableInfoMap);
+                              const ShaderInterfaceVariableInfoMap &variableInfoMap,
+                              SpirvTransformCache *spirvTransformCache);
     void release(ContextVk *contextVk);
 
     ANGLE_INLINE bool valid(gl::ShaderType shaderType) const
@@ -115,7 +116,8 @@ using DefaultUniformBlockMap = gl::ShaderMap<std::shared_ptr<DefaultUniformBlock
 class ProgramExecutableVk : public ProgramExecutableImpl
 {
   public:
-    ProgramExecutableVk(const gl::ProgramExecutable *executable);
+    ProgramExecutableVk(const gl::ProgramExecutable *executable,
+                        SpirvTransformCache *spirvTransformCache);
     ~ProgramExecutableVk() override;
 
     void destroy(const gl::Context *context) override;
@@ -426,7 +428,7 @@ class ProgramExecutableVk : public ProgramExecutableImpl
         {
             ANGLE_TRY(programInfo->initProgram(context, shaderType, isLastPreFragmentStage,
                                                isTransformFeedbackProgram, mOriginalShaderInfo,
-                                               optionBits, variableInfoMap));
+                                               optionBits, variableInfoMap, mSpirvTransformCache));
         }
         ASSERT(programInfo->valid(shaderType));
 
@@ -513,7 +515,8 @@ class ProgramExecutableVk : public ProgramExecutableImpl
     // the cache is lazily created as needed.
     angle::Result initializePipelineCache(vk::Context *context,
                                           bool compressed,
-                                          const std::vector<uint8_t> &pipelineData);
+                                          const uint8_t *pipelineData,
+                                          size_t pipelineDataSize);
     angle::Result ensurePipelineCacheInitialized(vk::Context *context);
 
     void initializeWriteDescriptorDesc(vk::Context *context);
@@ -538,6 +541,9 @@ class ProgramExecutableVk : public ProgramExecutableImpl
 
     ShaderInterfaceVariableInfoMap mVariableInfoMap;
 
+    // The share group's cache of transformed SPIR-V.
+    SpirvTransformCache *mSpirvTransformCache;
+
     // We store all permutations of surface rotation and transformed SPIR-V programs here. We may
     // need some LRU algorithm to free least used programs to reduce the number of programs.
     ProgramInfo mGraphicsProgramInfos[ProgramTransformOptions::kPermutationCount];
@@ -372,8 +372,10 @@ void SecondaryCommandBuffer::executeCommands(PrimaryCommandBuffer *primary)
                 {
                     const CopyBufferToImageParams *params =
                         getParamPtr<CopyBufferToImageParams>(currentCommand);
+                    const VkBufferImageCopy *regions =
+                        GetFirstArrayParameter<VkBufferImageCopy>(params);
                     vkCmdCopyBufferToImage(cmdBuffer, params->srcBuffer, params->dstImage,
-                                           params->dstImageLayout, 1, &params->region);
+                                           params->dstImageLayout, params->regionCount, regions);
                     break;
                 }
                 case CommandID::CopyImage:
@@ -269,7 +269,8 @@ struct CopyBufferToImageParams
     VkImageLayout dstImageLayout;
     VkBuffer srcBuffer;
     VkImage dstImage;
-    VkBufferImageCopy region;
+    uint32_t regionCount;
+    uint32_t padding;
 };
 VERIFY_8_BYTE_ALIGNMENT(CopyBufferToImageParams)
 
@@ -1495,13 +1496,16 @@ ANGLE_INLINE void SecondaryCommandBuffer::copyBufferToImage(VkBuffer srcBuffer,
                                                             uint32_t regionCount,
                                                             const VkBufferImageCopy *regions)
 {
-    ASSERT(regionCount == 1);
-    CopyBufferToImageParams *paramStruct =
-        initCommand<CopyBufferToImageParams>(CommandID::CopyBufferToImage);
+    uint8_t *writePtr;
+    const ArrayParamSize regionSize = calculateArrayParameterSize<VkBufferImageCopy>(regionCount);
+    CopyBufferToImageParams *paramStruct = initCommand<CopyBufferToImageParams>(
+        CommandID::CopyBufferToImage, regionSize.allocateBytes, &writePtr);
     paramStruct->srcBuffer      = srcBuffer;
     paramStruct->dstImage       = dstImage.getHandle();
     paramStruct->dstImageLayout = dstImageLayout;
-    paramStruct->region         = regions[0];
+    paramStruct->regionCount    = regionCount;
+    // Copy variable sized data
+    storeArrayParameter(writePtr, regions, regionSize);
 }
 
 ANGLE_INLINE void SecondaryCommandBuffer::copyImage(const Image &srcImage,
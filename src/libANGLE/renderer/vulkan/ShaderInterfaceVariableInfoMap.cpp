@@ -96,6 +96,43 @@ void ShaderInterfaceVariableInfoMap::save(gl::BinaryOutputStream *stream)
         ASSERT(xfbInfoCount == mPod.xfbInfoCount);
     }
 }
+
+void ShaderInterfaceVariableInfoMap::saveShaderInterface(gl::ShaderType shaderType,
+                                                         gl::BinaryOutputStream *stream) const
+{
+    const IdToIndexMap &idToIndexMap = mIdToIndexMap[shaderType];
+    stream->writeInt(idToIndexMap.size());
+    for (const VariableIndex &variableIndex : idToIndexMap)
+    {
+        const bool isValid = variableIndex.index != VariableIndex::kInvalid;
+        stream->writeBool(isValid);
+        if (!isValid)
+        {
+            continue;
+        }
+
+        stream->writeStruct(mData[variableIndex.index]);
+
+        const bool hasXfbInfo =
+            variableIndex.index < mXFBData.size() && mXFBData[variableIndex.index];
+        stream->writeBool(hasXfbInfo);
+        if (hasXfbInfo)
+        {
+            const XFBInterfaceVariableInfo &info = *mXFBData[variableIndex.index];
+            SaveShaderInterfaceVariableXfbInfo(info.xfb, stream);
+            stream->writeInt(info.fieldXfb.size());
+            for (const ShaderInterfaceVariableXfbInfo &xfb : info.fieldXfb)
+            {
+                SaveShaderInterfaceVariableXfbInfo(xfb, stream);
+            }
+        }
+    }
+
+    stream->writeStruct(mPod.inputPerVertexActiveMembers[shaderType]);
+    stream->writeStruct(mPod.outputPerVertexActiveMembers[shaderType]);
+    stream->writeBool(mPod.hasAliasingAttributes);
+}
+
 void ShaderInterfaceVariableInfoMap::load(gl::BinaryInputStream *stream)
 {
     stream->readStruct(&mPod);
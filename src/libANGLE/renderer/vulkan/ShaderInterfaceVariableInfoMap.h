@@ -50,6 +50,10 @@ class ShaderInterfaceVariableInfoMap final : angle::NonCopyable
     void clear();
     void load(gl::BinaryInputStream *stream);
     void save(gl::BinaryOutputStream *stream);
+    // Writes out the information used when transforming the SPIR-V of |shaderType|, i.e. that of
+    // the variables of that stage.  Unlike |save|, the output is independent of how the variables
+    // are laid out in the map, so that it can be compared across programs.
+    void saveShaderInterface(gl::ShaderType shaderType, gl::BinaryOutputStream *stream) const;
 
     ShaderInterfaceVariableInfo &add(gl::ShaderType shaderType, uint32_t id);
     void addResource(gl::ShaderBitSet shaderTypes,
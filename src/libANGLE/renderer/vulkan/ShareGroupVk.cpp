@@ -225,8 +225,11 @@ angle::Result ShareGroupVk::scheduleMonolithicPipelineCreationTask(
                                                  &compatibleRenderPass));
     taskOut->setRenderPass(compatibleRenderPass);
 
+    // Monolithic pipelines only replace the linked pipelines that are already usable, so they are
+    // created behind any work the application may be waiting on.
     mMonolithicPipelineCreationEvent =
-        contextVk->getRenderer()->getGlobalOps()->postMultiThreadWorkerTask(taskOut->getTask());
+        contextVk->getRenderer()->getGlobalOps()->postMultiThreadWorkerTask(
+            taskOut->getTask(), angle::WorkerTaskPriority::Low);
 
     taskOut->onSchedule(mMonolithicPipelineCreationEvent);
 
@@ -51,6 +51,8 @@ class ShareGroupVk : public ShareGroupImpl
     // synchronous update to the caches.
     PipelineLayoutCache &getPipelineLayoutCache() { return mPipelineLayoutCache; }
     DescriptorSetLayoutCache &getDescriptorSetLayoutCache() { return mDescriptorSetLayoutCache; }
+    // The SpirvTransformCache is internally synchronized, as it is also used by link tasks.
+    SpirvTransformCache &getSpirvTransformCache() { return mSpirvTransformCache; }
     const egl::ContextMap &getContexts() const { return mState.getContexts(); }
     vk::DescriptorSetArray<vk::MetaDescriptorPool> &getMetaDescriptorPools()
     {
@@ -110,6 +112,9 @@ class ShareGroupVk : public ShareGroupImpl
     // DescriptorSetLayouts are also managed in a cache.
     DescriptorSetLayoutCache mDescriptorSetLayoutCache;
 
+    // SPIR-V transformed for each program variant, shared by programs that use the same shaders.
+    SpirvTransformCache mSpirvTransformCache;
+
     // Descriptor set caches
     vk::DescriptorSetArray<vk::MetaDescriptorPool> mMetaDescriptorPools;
 
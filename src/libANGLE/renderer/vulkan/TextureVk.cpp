@@ -918,8 +918,11 @@ angle::Result TextureVk::setSubImageImpl(const gl::Context *context,
             getRequiredImageAccess(), applyUpdate, &updateAppliedImmediately));
     }
 
-    // If we used context's staging buffer, flush out the updates
-    if (!updateAppliedImmediately)
+    // If we used context's staging buffer, flush out the updates.  Updates whose data is still
+    // being loaded on a worker thread are left staged instead, and are flushed when the texture is
+    // next used.
+    const bool isLoadPending = mOwnsImage && mImage->hasPendingStagedUpdateLoads();
+    if (!updateAppliedImmediately && !isLoadPending)
     {
         if (applyUpdate != vk::ApplyImageUpdate::Defer)
         {
@@ -2289,20 +2292,26 @@ angle::Result TextureVk::generateMipmapsWithCPU(const gl::Context *context)
     GLuint sourceDepthPitch          = sourceRowPitch * baseLevelExtents.height;
     size_t baseLevelAllocationSize   = sourceDepthPitch * baseLevelExtents.depth;
 
-    // We now have the base level available to be manipulated in the imageData pointer. Generate all
-    // the missing mipmaps with the slow path. For each layer, use the copied data to generate all
-    // the mips.
+    // We now have the base level available to be manipulated in the imageData pointer.  Staging
+    // updates isn't thread-safe, so first stage all the missing mips of every layer.  Then
+    // generate them from the copied data with the slow path, possibly on the worker threads.
+    std::vector<std::vector<MipLevelData>> mipChains(imageLayerCount);
     for (GLuint layer = 0; layer < imageLayerCount; layer++)
     {
         size_t bufferOffset = layer * baseLevelAllocationSize;
 
-        ANGLE_TRY(generateMipmapLevelsWithCPU(contextVk, angleFormat, layer, baseLevelGL + 1,
-                                              gl::LevelIndex(mState.getMipmapMaxLevel()),
-                                              baseLevelExtents.width, baseLevelExtents.height,
-                                              baseLevelExtents.depth, sourceRowPitch,
-                                              sourceDepthPitch, imageData + bufferOffset));
+        mipChains[layer].push_back({static_cast<size_t>(baseLevelExtents.width),
+                                    static_cast<size_t>(baseLevelExtents.height),
+                                    static_cast<size_t>(baseLevelExtents.depth), sourceRowPitch,
+                                    sourceDepthPitch, imageData + bufferOffset});
+        ANGLE_TRY(stageMipmapLevelsForCPU(contextVk, angleFormat, layer, baseLevelGL + 1,
+                                          gl::LevelIndex(mState.getMipmapMaxLevel()),
+                                          &mipChains[layer]));
     }
 
+    GenerateMipmapChainsWithCPU(contextVk->getImageLoadContext(),
+                                angleFormat.mipGenerationFunction, mipChains);
+
     ASSERT(!TextureHasAnyRedefinedLevels(mRedefinedLevels));
     return flushImageStagedUpdates(contextVk);
 }
@@ -2326,6 +2335,12 @@ angle::Result TextureVk::generateMipmap(const gl::Context *context)
     vk::LevelIndex maxLevel  = mImage->toVkLevel(gl::LevelIndex(mState.getMipmapMaxLevel()));
     ASSERT(maxLevel != vk::LevelIndex(0));
 
+    // The GPU paths are skipped to test and benchmark the CPU fallback.
+    if (renderer->getFeatures().forceGenerateMipmapOnCPU.enabled)
+    {
+        return generateMipmapsWithCPU(context);
+    }
+
     // If it's possible to generate mipmap in compute, that would give the best possible
     // performance on some hardware.
     if (CanGenerateMipmapWithCompute(renderer, mImage->getType(), mImage->getActualFormatID(),
@@ -3835,36 +3850,26 @@ uint32_t TextureVk::getMaxLevelCount() const
     return mState.getMipmapMaxLevel() + 1;
 }
 
-angle::Result TextureVk::generateMipmapLevelsWithCPU(ContextVk *contextVk,
-                                                     const angle::Format &sourceFormat,
-                                                     GLuint layer,
-                                                     gl::LevelIndex firstMipLevel,
-                                                     gl::LevelIndex maxMipLevel,
-                                                     const size_t sourceWidth,
-                                                     const size_t sourceHeight,
-                                                     const size_t sourceDepth,
-                                                     const size_t sourceRowPitch,
-                                                     const size_t sourceDepthPitch,
-                                                     uint8_t *sourceData)
+angle::Result TextureVk::stageMipmapLevelsForCPU(ContextVk *contextVk,
+                                                 const angle::Format &format,
+                                                 GLuint layer,
+                                                 gl::LevelIndex firstMipLevel,
+                                                 gl::LevelIndex maxMipLevel,
+                                                 std::vector<MipLevelData> *mipChainInOut)
 {
-    size_t previousLevelWidth      = sourceWidth;
-    size_t previousLevelHeight     = sourceHeight;
-    size_t previousLevelDepth      = sourceDepth;
-    uint8_t *previousLevelData     = sourceData;
-    size_t previousLevelRowPitch   = sourceRowPitch;
-    size_t previousLevelDepthPitch = sourceDepthPitch;
-
     for (gl::LevelIndex currentMipLevel = firstMipLevel; currentMipLevel <= maxMipLevel;
          ++currentMipLevel)
     {
+        const MipLevelData &previousLevel = mipChainInOut->back();
+
         // Compute next level width and height.
-        size_t mipWidth  = std::max<size_t>(1, previousLevelWidth >> 1);
-        size_t mipHeight = std::max<size_t>(1, previousLevelHeight >> 1);
-        size_t mipDepth  = std::max<size_t>(1, previousLevelDepth >> 1);
+        size_t mipWidth  = std::max<size_t>(1, previousLevel.width >> 1);
+        size_t mipHeight = std::max<size_t>(1, previousLevel.height >> 1);
+        size_t mipDepth  = std::max<size_t>(1, previousLevel.depth >> 1);
 
         // With the width and height of the next mip, we can allocate the next buffer we need.
         uint8_t *destData     = nullptr;
-        size_t destRowPitch   = mipWidth * sourceFormat.pixelBytes;
+        size_t destRowPitch   = mipWidth * format.pixelBytes;
         size_t destDepthPitch = destRowPitch * mipHeight;
 
         size_t mipAllocationSize = destDepthPitch * mipDepth;
@@ -3874,20 +3879,10 @@ angle::Result TextureVk::generateMipmapLevelsWithCPU(ContextVk *contextVk,
         ANGLE_TRY(mImage->stageSubresourceUpdateAndGetData(
             contextVk, mipAllocationSize,
             gl::ImageIndex::MakeFromType(mState.getType(), currentMipLevel.get(), layer),
-            mipLevelExtents, gl::Offset(), &destData, sourceFormat.id));
-
-        // Generate the mipmap into that new buffer
-        sourceFormat.mipGenerationFunction(
-            previousLevelWidth, previousLevelHeight, previousLevelDepth, previousLevelData,
-            previousLevelRowPitch, previousLevelDepthPitch, destData, destRowPitch, destDepthPitch);
-
-        // Swap for the next iteration
-        previousLevelWidth      = mipWidth;
-        previousLevelHeight     = mipHeight;
-        previousLevelDepth      = mipDepth;
-        previousLevelData       = destData;
-        previousLevelRowPitch   = destRowPitch;
-        previousLevelDepthPitch = destDepthPitch;
+            mipLevelExtents, gl::Offset(), &destData, format.id));
+
+        mipChainInOut->push_back(
+            {mipWidth, mipHeight, mipDepth, destRowPitch, destDepthPitch, destData});
     }
 
     return angle::Result::Continue;
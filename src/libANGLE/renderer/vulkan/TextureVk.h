@@ -418,17 +418,14 @@ class TextureVk : public TextureImpl, public angle::ObserverInterface
 
     angle::Result generateMipmapsWithCPU(const gl::Context *context);
 
-    angle::Result generateMipmapLevelsWithCPU(ContextVk *contextVk,
-                                              const angle::Format &sourceFormat,
-                                              GLuint layer,
-                                              gl::LevelIndex firstMipLevel,
-                                              gl::LevelIndex maxMipLevel,
-                                              const size_t sourceWidth,
-                                              const size_t sourceHeight,
-                                              const size_t sourceDepth,
-                                              const size_t sourceRowPitch,
-                                              const size_t sourceDepthPitch,
-                                              uint8_t *sourceData);
+    // Stages the levels [firstMipLevel, maxMipLevel] of a layer, and appends where they are to be
+    // generated to |mipChainInOut|, which starts with the level before |firstMipLevel|.
+    angle::Result stageMipmapLevelsForCPU(ContextVk *contextVk,
+                                          const angle::Format &format,
+                                          GLuint layer,
+                                          gl::LevelIndex firstMipLevel,
+                                          gl::LevelIndex maxMipLevel,
+                                          std::vector<MipLevelData> *mipChainInOut);
 
     angle::Result copySubImageImpl(const gl::Context *context,
                                    const gl::ImageIndex &index,
@@ -0,0 +1,173 @@
+//
+// Copyright 2024 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// TimelineTracing.cpp:
+//    Implements the class methods in TimelineTracing.h.
+//
+
+#include "libANGLE/renderer/vulkan/TimelineTracing.h"
+
+#include <iomanip>
+
+#include "common/debug.h"
+#include "common/system_utils.h"
+
+namespace rx
+{
+namespace vk
+{
+namespace
+{
+// The trace only ever contains this process.
+constexpr uint32_t kProcessId = 1;
+}  // anonymous namespace
+
+// static
+std::unique_ptr<TimelineTracer> TimelineTracer::Create()
+{
+    const std::string path = angle::GetEnvironmentVarOrAndroidProperty(
+        "ANGLE_VK_TIMELINE_TRACE_FILE", "angle.vk_timeline_trace_file");
+    if (path.empty())
+    {
+        return nullptr;
+    }
+
+    std::ofstream file(path, std::ofstream::binary);
+    if (!file.is_open())
+    {
+        ERR() << "Failed to open \"" << path << "\" for the timeline trace";
+        return nullptr;
+    }
+
+    INFO() << "Recording timeline trace to: \"" << path << "\"";
+    return std::unique_ptr<TimelineTracer>(new TimelineTracer(std::move(file)));
+}
+
+TimelineTracer::TimelineTracer(std::ofstream &&file)
+    : mFile(std::move(file)), mStartTime(angle::GetCurrentSystemTime()), mFirstEvent(true)
+{
+    mEvents.reserve(kMaxBufferedEvents);
+    mFile << std::fixed << std::setprecision(3);
+    mFile << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+}
+
+TimelineTracer::~TimelineTracer()
+{
+    writeBufferedEvents();
+    mFile << "\n]}\n";
+}
+
+void TimelineTracer::setTrackName(uint32_t track, const std::string &name)
+{
+    std::unique_lock<angle::SimpleMutex> lock(mMutex);
+
+    mFile << (mFirstEvent ? "\n" : ",\n");
+    mFirstEvent = false;
+    mFile << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << kProcessId
+          << ",\"tid\":" << track << ",\"args\":{\"name\":\"" << name << "\"}}";
+}
+
+void TimelineTracer::addInstant(uint32_t track,
+                                const char *name,
+                                const TimelineArg &arg0,
+                                const TimelineArg &arg1)
+{
+    addEvent({'i', track, name, angle::GetCurrentSystemTime(), 0, nullptr, {arg0, arg1}});
+}
+
+void TimelineTracer::addSliceBegin(uint32_t track, const char *name)
+{
+    addEvent({'B', track, name, angle::GetCurrentSystemTime(), 0, nullptr, {}});
+}
+
+void TimelineTracer::addSliceEnd(uint32_t track, const char *name, const char *reason)
+{
+    addEvent({'E', track, name, angle::GetCurrentSystemTime(), 0, reason, {}});
+}
+
+void TimelineTracer::addCompleteSlice(uint32_t track,
+                                      const char *name,
+                                      double startTime,
+                                      const TimelineArg &arg0)
+{
+    const double endTime = angle::GetCurrentSystemTime();
+    addEvent({'X', track, name, startTime, endTime - startTime, nullptr, {arg0, {}}});
+}
+
+void TimelineTracer::addCounters(uint32_t track,
+                                 const char *name,
+                                 const TimelineArg &arg0,
+                                 const TimelineArg &arg1)
+{
+    addEvent({'C', track, name, angle::GetCurrentSystemTime(), 0, nullptr, {arg0, arg1}});
+}
+
+void TimelineTracer::addEvent(const Event &event)
+{
+    std::unique_lock<angle::SimpleMutex> lock(mMutex);
+
+    mEvents.push_back(event);
+    if (mEvents.size() >= kMaxBufferedEvents)
+    {
+        writeBufferedEvents();
+    }
+}
+
+void TimelineTracer::writeEvent(const Event &event)
+{
+    mFile << (mFirstEvent ? "\n" : ",\n");
+    mFirstEvent = false;
+
+    // Timestamps and durations are in microseconds.
+    mFile << "{\"name\":\"" << event.name << "\",\"ph\":\"" << event.phase
+          << "\",\"pid\":" << kProcessId << ",\"tid\":" << event.track
+          << ",\"ts\":" << (event.timestamp - mStartTime) * 1'000'000.0;
+
+    switch (event.phase)
+    {
+        case 'i':
+            // Scope the instant events to their track.
+            mFile << ",\"s\":\"t\"";
+            break;
+        case 'X':
+            mFile << ",\"dur\":" << event.duration * 1'000'000.0;
+            break;
+        case 'C':
+            // Keep the counters of each track separate.
+            mFile << ",\"id\":" << event.track;
+            break;
+        default:
+            break;
+    }
+
+    mFile << ",\"args\":{";
+    const char *separator = "";
+    if (event.reason != nullptr)
+    {
+        mFile << "\"reason\":\"" << event.reason << "\"";
+        separator = ",";
+    }
+    for (const TimelineArg &arg : event.args)
+    {
+        if (arg.name != nullptr)
+        {
+            mFile << separator << "\"" << arg.name << "\":" << arg.value;
+            separator = ",";
+        }
+    }
+    mFile << "}}";
+}
+
+void TimelineTracer::writeBufferedEvents()
+{
+    for (const Event &event : mEvents)
+    {
+        writeEvent(event);
+    }
+    mEvents.clear();
+    mFile.flush();
+}
+}  // namespace vk
+}  // namespace rx
@@ -0,0 +1,101 @@
+//
+// Copyright 2024 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// TimelineTracing.h:
+//    Defines the TimelineTracer class, which records a timeline of the work done by the Vulkan
+//    backend (draws, dispatches, render passes and submissions) along with a few counters, and
+//    writes it to a file in the JSON trace event format that Perfetto's UI and trace processor
+//    can load.
+//
+
+#ifndef LIBANGLE_RENDERER_VULKAN_TIMELINETRACING_H_
+#define LIBANGLE_RENDERER_VULKAN_TIMELINETRACING_H_
+
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/SimpleMutex.h"
+#include "common/angleutils.h"
+
+namespace rx
+{
+namespace vk
+{
+// A named value attached to a timeline event.  Events with no name are not written out.
+struct TimelineArg
+{
+    const char *name = nullptr;
+    uint64_t value   = 0;
+};
+
+// The tracer is enabled by setting ANGLE_VK_TIMELINE_TRACE_FILE, or the
+// angle.vk_timeline_trace_file property on Android, to the path of the file to write.  When not
+// enabled, no tracer is created and the only cost at the call sites is a null check.
+//
+// Each context records on its own track.  Events are buffered in memory and periodically written
+// to the file, which is finalized when the tracer is destroyed.  All names and strings passed to
+// the tracer must outlive it, i.e. be string literals or static tables.
+class TimelineTracer final : angle::NonCopyable
+{
+  public:
+    // Number of events kept in memory before they are written to the file.
+    static constexpr size_t kMaxBufferedEvents = 16384;
+
+    // Returns nullptr if tracing is not enabled or the file cannot be created.
+    static std::unique_ptr<TimelineTracer> Create();
+
+    ~TimelineTracer();
+
+    void setTrackName(uint32_t track, const std::string &name);
+
+    void addInstant(uint32_t track,
+                    const char *name,
+                    const TimelineArg &arg0 = {},
+                    const TimelineArg &arg1 = {});
+    void addSliceBegin(uint32_t track, const char *name);
+    void addSliceEnd(uint32_t track, const char *name, const char *reason);
+    // A slice whose begin and end are recorded at once; |startTime| is in seconds as returned by
+    // angle::GetCurrentSystemTime(), and the slice ends now.
+    void addCompleteSlice(uint32_t track,
+                          const char *name,
+                          double startTime,
+                          const TimelineArg &arg0 = {});
+    void addCounters(uint32_t track,
+                     const char *name,
+                     const TimelineArg &arg0,
+                     const TimelineArg &arg1 = {});
+
+  private:
+    struct Event
+    {
+        char phase;
+        uint32_t track;
+        const char *name;
+        // In seconds.
+        double timestamp;
+        double duration;
+        const char *reason;
+        TimelineArg args[2];
+    };
+
+    TimelineTracer(std::ofstream &&file);
+
+    void addEvent(const Event &event);
+    void writeEvent(const Event &event);
+    void writeBufferedEvents();
+
+    angle::SimpleMutex mMutex;
+    std::ofstream mFile;
+    std::vector<Event> mEvents;
+    // Timestamps are written relative to the creation of the tracer.
+    double mStartTime;
+    bool mFirstEvent;
+};
+}  // namespace vk
+}  // namespace rx
+
+#endif  // LIBANGLE_RENDERER_VULKAN_TIMELINETRACING_H_
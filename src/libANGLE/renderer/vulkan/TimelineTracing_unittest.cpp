@@ -0,0 +1,193 @@
+//
+// Copyright 2024 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// TimelineTracing_unittest.cpp:
+//   Unit tests for writing the timeline of the Vulkan backend in the JSON trace event format.
+//
+
+#include <gtest/gtest.h>
+#include <rapidjson/document.h>
+
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include "common/system_utils.h"
+#include "libANGLE/renderer/vulkan/TimelineTracing.h"
+#include "util/test_utils.h"
+
+namespace js = rapidjson;
+
+namespace rx
+{
+namespace vk
+{
+namespace
+{
+constexpr char kTraceFileVarName[] = "ANGLE_VK_TIMELINE_TRACE_FILE";
+constexpr uint32_t kTrack          = 3;
+
+size_t CountOccurrences(const std::string &str, const std::string &substr)
+{
+    size_t count = 0;
+    for (size_t pos = str.find(substr); pos != std::string::npos; pos = str.find(substr, pos + 1))
+    {
+        ++count;
+    }
+    return count;
+}
+
+class TimelineTracingTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        Optional<std::string> path = angle::CreateTemporaryFile();
+        ASSERT_TRUE(path.valid());
+        mPath = path.value();
+        ASSERT_TRUE(angle::SetEnvironmentVar(kTraceFileVarName, mPath.c_str()));
+    }
+
+    void TearDown() override
+    {
+        angle::UnsetEnvironmentVar(kTraceFileVarName);
+        angle::DeleteSystemFile(mPath.c_str());
+    }
+
+    std::string readFile() const
+    {
+        std::ifstream file(mPath, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    // Parses the trace, which is only complete once the tracer is destroyed, and returns its
+    // events.
+    const js::Value &parseEvents()
+    {
+        mDocument.Parse(readFile().c_str());
+        EXPECT_FALSE(mDocument.HasParseError());
+        EXPECT_TRUE(mDocument.IsObject());
+        EXPECT_STREQ("ns", mDocument["displayTimeUnit"].GetString());
+        EXPECT_TRUE(mDocument["traceEvents"].IsArray());
+        return mDocument["traceEvents"];
+    }
+
+    std::string mPath;
+    js::Document mDocument;
+};
+
+// Tests that the fields of each kind of event are written.
+TEST_F(TimelineTracingTest, WritesEvents)
+{
+    std::unique_ptr<TimelineTracer> tracer = TimelineTracer::Create();
+    ASSERT_NE(nullptr, tracer);
+
+    const double submitStartTime = angle::GetCurrentSystemTime();
+    tracer->setTrackName(kTrack, "Context 3");
+    tracer->addInstant(kTrack, "Draw", {"vertexCount", 36}, {"instanceCount", 2});
+    tracer->addSliceBegin(kTrack, "RenderPass");
+    tracer->addSliceEnd(kTrack, "RenderPass", "Swap");
+    tracer->addCompleteSlice(kTrack, "Submit", submitStartTime, {"commandBuffers", 1});
+    tracer->addCounters(kTrack, "PipelineCache", {"hits", 5}, {"misses", 1});
+    tracer.reset();
+
+    const js::Value &events = parseEvents();
+    ASSERT_EQ(6u, events.Size());
+
+    for (const js::Value &event : events.GetArray())
+    {
+        EXPECT_EQ(1u, event["pid"].GetUint());
+        EXPECT_EQ(kTrack, event["tid"].GetUint());
+        EXPECT_TRUE(event["args"].IsObject());
+        if (event.HasMember("ts"))
+        {
+            EXPECT_GE(event["ts"].GetDouble(), 0.0);
+        }
+    }
+
+    const js::Value &trackName = events[0];
+    EXPECT_STREQ("thread_name", trackName["name"].GetString());
+    EXPECT_STREQ("M", trackName["ph"].GetString());
+    EXPECT_STREQ("Context 3", trackName["args"]["name"].GetString());
+
+    const js::Value &instant = events[1];
+    EXPECT_STREQ("Draw", instant["name"].GetString());
+    EXPECT_STREQ("i", instant["ph"].GetString());
+    EXPECT_STREQ("t", instant["s"].GetString());
+    EXPECT_EQ(36u, instant["args"]["vertexCount"].GetUint());
+    EXPECT_EQ(2u, instant["args"]["instanceCount"].GetUint());
+
+    const js::Value &sliceBegin = events[2];
+    EXPECT_STREQ("RenderPass", sliceBegin["name"].GetString());
+    EXPECT_STREQ("B", sliceBegin["ph"].GetString());
+    EXPECT_EQ(0u, sliceBegin["args"].MemberCount());
+
+    const js::Value &sliceEnd = events[3];
+    EXPECT_STREQ("RenderPass", sliceEnd["name"].GetString());
+    EXPECT_STREQ("E", sliceEnd["ph"].GetString());
+    EXPECT_STREQ("Swap", sliceEnd["args"]["reason"].GetString());
+    EXPECT_GE(sliceEnd["ts"].GetDouble(), sliceBegin["ts"].GetDouble());
+
+    const js::Value &completeSlice = events[4];
+    EXPECT_STREQ("Submit", completeSlice["name"].GetString());
+    EXPECT_STREQ("X", completeSlice["ph"].GetString());
+    EXPECT_LE(completeSlice["ts"].GetDouble(), instant["ts"].GetDouble());
+    EXPECT_GE(completeSlice["dur"].GetDouble(), 0.0);
+    EXPECT_EQ(1u, completeSlice["args"]["commandBuffers"].GetUint());
+
+    const js::Value &counters = events[5];
+    EXPECT_STREQ("PipelineCache", counters["name"].GetString());
+    EXPECT_STREQ("C", counters["ph"].GetString());
+    EXPECT_EQ(kTrack, counters["id"].GetUint());
+    EXPECT_EQ(5u, counters["args"]["hits"].GetUint());
+    EXPECT_EQ(1u, counters["args"]["misses"].GetUint());
+}
+
+// Tests that events are kept in memory until the buffer is full, and that the events recorded
+// after the buffer is written out are still saved.
+TEST_F(TimelineTracingTest, FlushesBufferedEvents)
+{
+    constexpr js::SizeType kMaxBufferedEvents = TimelineTracer::kMaxBufferedEvents;
+    const std::string kInstantPhase           = "\"ph\":\"i\"";
+
+    std::unique_ptr<TimelineTracer> tracer = TimelineTracer::Create();
+    ASSERT_NE(nullptr, tracer);
+
+    for (js::SizeType eventIndex = 0; eventIndex < kMaxBufferedEvents - 1; ++eventIndex)
+    {
+        tracer->addInstant(kTrack, "Draw", {"index", eventIndex});
+    }
+    EXPECT_EQ(0u, CountOccurrences(readFile(), kInstantPhase));
+
+    tracer->addInstant(kTrack, "Draw", {"index", kMaxBufferedEvents - 1});
+    EXPECT_EQ(kMaxBufferedEvents, CountOccurrences(readFile(), kInstantPhase));
+
+    tracer->addInstant(kTrack, "Dispatch");
+    EXPECT_EQ(kMaxBufferedEvents, CountOccurrences(readFile(), kInstantPhase));
+    tracer.reset();
+
+    const js::Value &events = parseEvents();
+    ASSERT_EQ(kMaxBufferedEvents + 1, events.Size());
+    for (js::SizeType eventIndex = 0; eventIndex < kMaxBufferedEvents; ++eventIndex)
+    {
+        EXPECT_EQ(eventIndex, events[eventIndex]["args"]["index"].GetUint64());
+    }
+    EXPECT_STREQ("Dispatch", events[kMaxBufferedEvents]["name"].GetString());
+    EXPECT_EQ(0u, events[kMaxBufferedEvents]["args"].MemberCount());
+}
+
+// Tests that no tracer is created when tracing is not enabled, or when the file cannot be created.
+TEST_F(TimelineTracingTest, DisabledTracer)
+{
+    ASSERT_TRUE(angle::UnsetEnvironmentVar(kTraceFileVarName));
+    EXPECT_EQ(nullptr, TimelineTracer::Create());
+
+    const std::string missingDirPath = mPath + ".missing/trace.json";
+    ASSERT_TRUE(angle::SetEnvironmentVar(kTraceFileVarName, missingDirPath.c_str()));
+    EXPECT_EQ(nullptr, TimelineTracer::Create());
+}
+}  // anonymous namespace
+}  // namespace vk
+}  // namespace rx
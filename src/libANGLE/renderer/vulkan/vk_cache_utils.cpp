@@ -10,6 +10,8 @@
 
 #include "libANGLE/renderer/vulkan/vk_cache_utils.h"
 
+#include <anglebase/sha1.h>
+
 #include "common/aligned_memory.h"
 #include "common/system_utils.h"
 #include "libANGLE/BlobCache.h"
@@ -23,6 +25,7 @@
 #include "libANGLE/renderer/vulkan/vk_helpers.h"
 #include "libANGLE/renderer/vulkan/vk_renderer.h"
 
+#include <algorithm>
 #include <type_traits>
 
 namespace rx
@@ -33,6 +36,9 @@ constexpr bool kDumpPipelineCacheGraph = true;
 constexpr bool kDumpPipelineCacheGraph = false;
 #endif  // ANGLE_DUMP_PIPELINE_CACHE_GRAPH
 
+// Limit the transformed SPIR-V kept around to 16MB per share group.
+constexpr size_t kMaxSpirvTransformCacheSize = 16 * 1024 * 1024;
+
 namespace vk
 {
 
@@ -7724,4 +7730,121 @@ angle::Result SamplerCache::getSampler(ContextVk *contextVk,
 
     return angle::Result::Continue;
 }
+
+// SpirvTransformCache implementation.
+SpirvTransformCache::SpirvTransformCache() : mPayload(kMaxSpirvTransformCacheSize) {}
+
+SpirvTransformCache::~SpirvTransformCache() = default;
+
+angle::Result SpirvTransformCache::getTransformedSpirv(
+    vk::Context *context,
+    const SpvTransformOptions &options,
+    const ShaderInterfaceVariableInfoMap &variableInfoMap,
+    const angle::spirv::Blob &initialSpirvBlob,
+    std::shared_ptr<const angle::spirv::Blob> *spirvBlobOut)
+{
+    // The options are serialized field by field so padding doesn't affect the key.
+    gl::BinaryOutputStream stream;
+    stream.writeEnum(options.shaderType);
+    stream.writeBool(options.isLastPreFragmentStage);
+    stream.writeBool(options.isTransformFeedbackStage);
+    stream.writeBool(options.isTransformFeedbackEmulated);
+    stream.writeBool(options.isMultisampledFramebufferFetch);
+    stream.writeBool(options.enableSampleShading);
+    stream.writeBool(options.validate);
+    stream.writeBool(options.useSpirvVaryingPrecisionFixer);
+    variableInfoMap.saveShaderInterface(options.shaderType, &stream);
+
+    angle::base::SecureHashAlgorithm hasher;
+    hasher.Init();
+    hasher.Update(initialSpirvBlob.data(), initialSpirvBlob.size() * sizeof(uint32_t));
+    hasher.Update(stream.data(), stream.length());
+    hasher.Final();
+
+    angle::BlobCacheKey key;
+    memcpy(key.data(), hasher.Digest(), angle::base::kSHA1Length);
+
+    {
+        std::unique_lock<angle::SimpleMutex> lock(mMutex);
+        const std::shared_ptr<const angle::spirv::Blob> *cachedBlob = nullptr;
+        if (mPayload.get(key, &cachedBlob))
+        {
+            mCacheStats.hit();
+            *spirvBlobOut = *cachedBlob;
+            return angle::Result::Continue;
+        }
+        mCacheStats.miss();
+    }
+
+    // Transform without holding the lock, so other stages and programs can be transformed in
+    // parallel.
+    auto transformedSpirvBlob = std::make_shared<angle::spirv::Blob>();
+    ANGLE_TRY(SpvTransformSpirvCode(options, variableInfoMap, initialSpirvBlob,
+                                    transformedSpirvBlob.get()));
+    *spirvBlobOut = transformedSpirvBlob;
+
+    std::unique_lock<angle::SimpleMutex> lock(mMutex);
+    const std::shared_ptr<const angle::spirv::Blob> *cachedBlob = nullptr;
+    if (mPayload.get(key, &cachedBlob))
+    {
+        // Another thread transformed the same SPIR-V in the meantime.
+        return angle::Result::Continue;
+    }
+
+    const size_t entryCountBefore                   = mPayload.entryCount();
+    std::shared_ptr<const angle::spirv::Blob> value = std::move(transformedSpirvBlob);
+    if (mPayload.put(key, std::move(value), (*spirvBlobOut)->size() * sizeof(uint32_t)) != nullptr)
+    {
+        mCacheStats.incrementSize();
+        mCacheStats.evict(static_cast<uint32_t>(entryCountBefore + 1 - mPayload.entryCount()));
+    }
+
+    return angle::Result::Continue;
+}
+
+void SpirvTransformCache::getCacheStats(CacheStats *accum) const
+{
+    std::unique_lock<angle::SimpleMutex> lock(mMutex);
+    accum->accumulate(mCacheStats);
+}
+
+// DescriptorSetCache implementation.
+uint32_t DescriptorSetCache::evictLeastRecentlyUsed(
+    size_t maxSize,
+    std::vector<EvictedDescriptorSet> *evictedDescriptorSetsOut)
+{
+    if (mPayload.size() <= maxSize)
+    {
+        return 0;
+    }
+
+    using PayloadIterator = decltype(mPayload)::iterator;
+    std::vector<PayloadIterator> candidates;
+    candidates.reserve(mPayload.size());
+    for (auto iter = mPayload.begin(); iter != mPayload.end(); ++iter)
+    {
+        if (!iter->second->getPool()->isReferenced())
+        {
+            candidates.push_back(iter);
+        }
+    }
+
+    // Only the oldest entries need to be ordered.
+    const size_t evictCount = std::min(candidates.size(), mPayload.size() - maxSize);
+    auto isOlder            = [](const PayloadIterator &lhs, const PayloadIterator &rhs) {
+        return lhs->second->getLastUse() < rhs->second->getLastUse();
+    };
+    std::nth_element(candidates.begin(), candidates.begin() + evictCount, candidates.end(),
+                     isOlder);
+
+    for (size_t index = 0; index < evictCount; ++index)
+    {
+        const dsCacheEntry &entry = *candidates[index]->second;
+        evictedDescriptorSetsOut->push_back({entry.getDescriptorSet(), entry.getPool()});
+        *entry.getSharedCacheKey() = nullptr;
+        mPayload.erase(candidates[index]);
+    }
+
+    return static_cast<uint32_t>(evictCount);
+}
 }  // namespace rx
@@ -15,6 +15,7 @@
 #include "common/FixedVector.h"
 #include "common/SimpleMutex.h"
 #include "common/WorkerThread.h"
+#include "libANGLE/SizedMRUCache.h"
 #include "libANGLE/Uniform.h"
 #include "libANGLE/renderer/vulkan/ShaderInterfaceVariableInfoMap.h"
 #include "libANGLE/renderer/vulkan/vk_resource.h"
@@ -2189,7 +2190,7 @@ enum class VulkanCacheType
     EnumCount
 };
 
-// Base class for all caches. Provides cache hit and miss counters.
+// Base class for all caches. Provides cache hit, miss and eviction counters.
 class CacheStats final : angle::NonCopyable
 {
   public:
@@ -2197,14 +2198,18 @@ class CacheStats final : angle::NonCopyable
     ~CacheStats() {}
 
     CacheStats(const CacheStats &rhs)
-        : mHitCount(rhs.mHitCount), mMissCount(rhs.mMissCount), mSize(rhs.mSize)
+        : mHitCount(rhs.mHitCount),
+          mMissCount(rhs.mMissCount),
+          mEvictionCount(rhs.mEvictionCount),
+          mSize(rhs.mSize)
     {}
 
     CacheStats &operator=(const CacheStats &rhs)
     {
-        mHitCount  = rhs.mHitCount;
-        mMissCount = rhs.mMissCount;
-        mSize      = rhs.mSize;
+        mHitCount      = rhs.mHitCount;
+        mMissCount     = rhs.mMissCount;
+        mEvictionCount = rhs.mEvictionCount;
+        mSize          = rhs.mSize;
         return *this;
     }
 
@@ -2217,15 +2222,25 @@ class CacheStats final : angle::NonCopyable
         mMissCount++;
         mSize++;
     }
+    // Entries removed from the cache to keep it within its budget, as opposed to entries
+    // released because one of their components was deleted.
+    ANGLE_INLINE void evict(uint32_t count)
+    {
+        ASSERT(mSize >= count);
+        mEvictionCount += count;
+        mSize -= count;
+    }
     ANGLE_INLINE void accumulate(const CacheStats &stats)
     {
         mHitCount += stats.mHitCount;
         mMissCount += stats.mMissCount;
+        mEvictionCount += stats.mEvictionCount;
         mSize += stats.mSize;
     }
 
     uint32_t getHitCount() const { return mHitCount; }
     uint32_t getMissCount() const { return mMissCount; }
+    uint32_t getEvictionCount() const { return mEvictionCount; }
 
     ANGLE_INLINE double getHitRatio() const
     {
@@ -2244,26 +2259,30 @@ class CacheStats final : angle::NonCopyable
 
     void reset()
     {
-        mHitCount  = 0;
-        mMissCount = 0;
-        mSize      = 0;
+        mHitCount      = 0;
+        mMissCount     = 0;
+        mEvictionCount = 0;
+        mSize          = 0;
     }
 
     void resetHitAndMissCount()
     {
-        mHitCount  = 0;
-        mMissCount = 0;
+        mHitCount      = 0;
+        mMissCount     = 0;
+        mEvictionCount = 0;
     }
 
     void accumulateCacheStats(VulkanCacheType cacheType, const CacheStats &cacheStats)
     {
         mHitCount += cacheStats.getHitCount();
         mMissCount += cacheStats.getMissCount();
+        mEvictionCount += cacheStats.getEvictionCount();
     }
 
   private:
     uint32_t mHitCount;
     uint32_t mMissCount;
+    uint32_t mEvictionCount;
     uint32_t mSize;
 };
 
@@ -2634,10 +2653,42 @@ class SamplerYcbcrConversionCache final
     SamplerYcbcrConversionMap mVkFormatPayload;
 };
 
+// Transformed SPIR-V Cache.  Every ProgramTransformOptions variant of a program transforms the
+// SPIR-V of each stage again, and programs often share shaders.  The results of
+// SpvTransformSpirvCode are thus cached by a hash of the original SPIR-V, the transform options and
+// the stage's slice of the ShaderInterfaceVariableInfoMap.  Internally thread-safe, as shaders are
+// transformed from link and pipeline warm up tasks.
+class SpirvTransformCache final : angle::NonCopyable
+{
+  public:
+    SpirvTransformCache();
+    ~SpirvTransformCache();
+
+    angle::Result getTransformedSpirv(vk::Context *context,
+                                      const SpvTransformOptions &options,
+                                      const ShaderInterfaceVariableInfoMap &variableInfoMap,
+                                      const angle::spirv::Blob &initialSpirvBlob,
+                                      std::shared_ptr<const angle::spirv::Blob> *spirvBlobOut);
+
+    void getCacheStats(CacheStats *accum) const;
+
+  private:
+    mutable angle::SimpleMutex mMutex;
+    angle::SizedMRUCache<angle::BlobCacheKey, std::shared_ptr<const angle::spirv::Blob>> mPayload;
+    CacheStats mCacheStats;
+};
+
 // Descriptor Set Cache
 class DescriptorSetCache final : angle::NonCopyable
 {
   public:
+    // A descriptor set evicted from the cache, to be recycled by its pool.
+    struct EvictedDescriptorSet
+    {
+        VkDescriptorSet descriptorSet;
+        vk::RefCountedDescriptorPoolHelper *pool;
+    };
+
     DescriptorSetCache() = default;
     ~DescriptorSetCache() { ASSERT(mPayload.empty()); }
 
@@ -2649,6 +2700,7 @@ class DescriptorSetCache final : angle::NonCopyable
     DescriptorSetCache &operator=(DescriptorSetCache &&other)
     {
         std::swap(mPayload, other.mPayload);
+        std::swap(mUseCount, other.mUseCount);
         return *this;
     }
 
@@ -2661,6 +2713,7 @@ class DescriptorSetCache final : angle::NonCopyable
         auto iter = mPayload.find(desc);
         if (iter != mPayload.end())
         {
+            iter->second->setLastUse(++mUseCount);
             *descriptorSetOut = iter->second->getDescriptorSet();
             *poolOut          = iter->second->getPool();
             return true;
@@ -2670,9 +2723,11 @@ class DescriptorSetCache final : angle::NonCopyable
 
     ANGLE_INLINE void insertDescriptorSet(const vk::DescriptorSetDesc &desc,
                                           VkDescriptorSet descriptorSet,
-                                          vk::RefCountedDescriptorPoolHelper *pool)
+                                          vk::RefCountedDescriptorPoolHelper *pool,
+                                          const vk::SharedDescriptorSetCacheKey &sharedCacheKey)
     {
-        mPayload.emplace(desc, std::make_unique<dsCacheEntry>(descriptorSet, pool));
+        mPayload.emplace(desc, std::make_unique<dsCacheEntry>(descriptorSet, pool, sharedCacheKey,
+                                                              ++mUseCount));
     }
 
     ANGLE_INLINE void eraseDescriptorSet(const vk::DescriptorSetDesc &desc)
@@ -2680,6 +2735,14 @@ class DescriptorSetCache final : angle::NonCopyable
         mPayload.erase(desc);
     }
 
+    // Removes the least recently used descriptor sets until at most |maxSize| are left.  Sets
+    // allocated from a pool that is bound to a program may still be in use by that program and
+    // are never evicted.  The shared cache keys of the evicted sets are invalidated, so that the
+    // textures and buffers they reference no longer release them.  Returns the number of evicted
+    // sets.
+    uint32_t evictLeastRecentlyUsed(size_t maxSize,
+                                    std::vector<EvictedDescriptorSet> *evictedDescriptorSetsOut);
+
     ANGLE_INLINE size_t getTotalCacheSize() const { return mPayload.size(); }
 
     size_t getTotalCacheKeySizeBytes() const
@@ -2699,11 +2762,23 @@ class DescriptorSetCache final : angle::NonCopyable
     class dsCacheEntry
     {
       public:
-        dsCacheEntry(VkDescriptorSet descriptorSet, vk::RefCountedDescriptorPoolHelper *pool)
-            : mDescriptorSet(descriptorSet), mPool(pool)
+        dsCacheEntry(VkDescriptorSet descriptorSet,
+                     vk::RefCountedDescriptorPoolHelper *pool,
+                     const vk::SharedDescriptorSetCacheKey &sharedCacheKey,
+                     uint64_t lastUse)
+            : mDescriptorSet(descriptorSet),
+              mPool(pool),
+              mSharedCacheKey(sharedCacheKey),
+              mLastUse(lastUse)
         {}
         VkDescriptorSet getDescriptorSet() const { return mDescriptorSet; }
         vk::RefCountedDescriptorPoolHelper *getPool() const { return mPool; }
+        const vk::SharedDescriptorSetCacheKey &getSharedCacheKey() const
+        {
+            return mSharedCacheKey;
+        }
+        uint64_t getLastUse() const { return mLastUse; }
+        void setLastUse(uint64_t lastUse) { mLastUse = lastUse; }
 
       private:
         VkDescriptorSet mDescriptorSet;
@@ -2711,8 +2786,14 @@ class DescriptorSetCache final : angle::NonCopyable
         // this pool is bound as the current pool in any ProgramExecutableVk or not, so we should
         // not add refcount from the cache.
         vk::RefCountedDescriptorPoolHelper *mPool;
+        // The key handed out to the pool and to the objects the descriptorSet references, which
+        // is invalidated when the entry is evicted.
+        vk::SharedDescriptorSetCacheKey mSharedCacheKey;
+        uint64_t mLastUse;
     };
     angle::HashMap<vk::DescriptorSetDesc, std::unique_ptr<dsCacheEntry>> mPayload;
+    // Incremented on every lookup hit and insertion to order the entries by recency of use.
+    uint64_t mUseCount = 0;
 };
 
 // There is 1 default uniform binding used per stage.
@@ -1091,11 +1091,186 @@ ImageLayerWriteMask GetImageLayerWriteMask(uint32_t layerStart, uint32_t layerCo
     layerMask = (layerMask << rotateShift) | (layerMask >> (kMaxParallelLayerWrites - rotateShift));
     return layerMask;
 }
+
+// Size of the texture data that's read by a load function, which does not include the row padding
+// after the last row.
+size_t GetLoadInputSize(const gl::InternalFormat &formatInfo,
+                        GLenum type,
+                        const gl::Extents &extents,
+                        GLuint inputRowPitch,
+                        GLuint inputDepthPitch)
+{
+    const uint32_t height   = static_cast<uint32_t>(extents.height);
+    const uint32_t rowCount = formatInfo.compressed
+                                  ? UnsignedCeilDivide(height, formatInfo.compressedBlockHeight)
+                                  : height;
+    const size_t lastRowSize =
+        formatInfo.compressed ? inputRowPitch : formatInfo.computePixelBytes(type) * extents.width;
+    return static_cast<size_t>(extents.depth - 1) * inputDepthPitch +
+           static_cast<size_t>(rowCount - 1) * inputRowPitch + lastRowSize;
+}
+
+// Loads texture data into a staging buffer on a worker thread.  The application's data is copied,
+// as it is only valid during the GL call.
+class StagedUpdateLoadTask : public angle::Closure
+{
+  public:
+    StagedUpdateLoadTask(LoadImageFunction loadFunction,
+                         const gl::Extents &extents,
+                         const uint8_t *source,
+                         size_t sourceSize,
+                         GLuint inputRowPitch,
+                         GLuint inputDepthPitch,
+                         uint8_t *stagingPointer,
+                         size_t outputRowPitch,
+                         size_t outputDepthPitch)
+        : mLoadFunction(loadFunction),
+          mExtents(extents),
+          mSource(source, source + sourceSize),
+          mInputRowPitch(inputRowPitch),
+          mInputDepthPitch(inputDepthPitch),
+          mStagingPointer(stagingPointer),
+          mOutputRowPitch(outputRowPitch),
+          mOutputDepthPitch(outputDepthPitch)
+    {}
+
+    void operator()() override
+    {
+        ANGLE_TRACE_EVENT0("gpu.angle", "StagedUpdateLoadTask");
+        // The load function is not given the worker pools, as waiting on other tasks from within a
+        // worker thread could starve the pool.
+        mLoadFunction(angle::ImageLoadContext(), mExtents.width, mExtents.height, mExtents.depth,
+                      mSource.data(), mInputRowPitch, mInputDepthPitch, mStagingPointer,
+                      mOutputRowPitch, mOutputDepthPitch);
+    }
+
+  private:
+    LoadImageFunction mLoadFunction;
+    gl::Extents mExtents;
+    std::vector<uint8_t> mSource;
+    GLuint mInputRowPitch;
+    GLuint mInputDepthPitch;
+    uint8_t *mStagingPointer;
+    size_t mOutputRowPitch;
+    size_t mOutputDepthPitch;
+};
+
+// Tracks the regions of a single-layer image level that have been written since the last barrier,
+// on a grid of at most 256x256 tiles.  The tracking is conservative, i.e. regions that touch a
+// common tile are considered to overlap.  Depth is ignored for the same reason.
+class LevelWriteCoverage final
+{
+  public:
+    LevelWriteCoverage()
+        : mTileWidth(1), mTileHeight(1), mMarkedRowStart(kGridSize), mMarkedRowEnd(0)
+    {
+        for (Row &row : mRows)
+        {
+            row.fill(0);
+        }
+    }
+
+    // Clears the coverage and starts tracking a level of the given size.
+    void reset(const gl::Extents &levelExtents)
+    {
+        clear();
+        mTileWidth  = UnsignedCeilDivide(static_cast<uint32_t>(levelExtents.width), kGridSize);
+        mTileHeight = UnsignedCeilDivide(static_cast<uint32_t>(levelExtents.height), kGridSize);
+    }
+
+    void clear()
+    {
+        for (uint32_t row = mMarkedRowStart; row < mMarkedRowEnd; ++row)
+        {
+            mRows[row].fill(0);
+        }
+        mMarkedRowStart = kGridSize;
+        mMarkedRowEnd   = 0;
+    }
+
+    bool overlaps(const VkOffset3D &offset, const VkExtent3D &extent) const
+    {
+        const TileRange tiles = getTiles(offset, extent);
+        for (uint32_t row = tiles.rowStart; row < tiles.rowEnd; ++row)
+        {
+            for (uint32_t word = tiles.wordStart; word < tiles.wordEnd; ++word)
+            {
+                if ((mRows[row][word] & tiles.getWordMask(word)) != 0)
+                {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    void mark(const VkOffset3D &offset, const VkExtent3D &extent)
+    {
+        const TileRange tiles = getTiles(offset, extent);
+        for (uint32_t row = tiles.rowStart; row < tiles.rowEnd; ++row)
+        {
+            for (uint32_t word = tiles.wordStart; word < tiles.wordEnd; ++word)
+            {
+                mRows[row][word] |= tiles.getWordMask(word);
+            }
+        }
+        mMarkedRowStart = std::min(mMarkedRowStart, tiles.rowStart);
+        mMarkedRowEnd   = std::max(mMarkedRowEnd, tiles.rowEnd);
+    }
+
+  private:
+    static constexpr uint32_t kGridSize    = 256;
+    static constexpr uint32_t kBitsPerWord = 64;
+    using Row                              = std::array<uint64_t, kGridSize / kBitsPerWord>;
+
+    // The tiles covered by a region; the ends of the ranges are exclusive.
+    struct TileRange
+    {
+        uint64_t getWordMask(uint32_t word) const
+        {
+            const uint32_t wordColumn = word * kBitsPerWord;
+            const uint32_t start      = std::max(columnStart, wordColumn) - wordColumn;
+            const uint32_t end        = std::min(columnEnd, wordColumn + kBitsPerWord) - wordColumn;
+            return angle::BitMask<uint64_t>(end) & ~angle::BitMask<uint64_t>(start);
+        }
+
+        uint32_t rowStart;
+        uint32_t rowEnd;
+        uint32_t columnStart;
+        uint32_t columnEnd;
+        uint32_t wordStart;
+        uint32_t wordEnd;
+    };
+
+    TileRange getTiles(const VkOffset3D &offset, const VkExtent3D &extent) const
+    {
+        ASSERT(extent.width > 0 && extent.height > 0);
+        const uint32_t x = static_cast<uint32_t>(offset.x);
+        const uint32_t y = static_cast<uint32_t>(offset.y);
+
+        TileRange tiles;
+        tiles.rowStart    = std::min(y / mTileHeight, kGridSize - 1);
+        tiles.rowEnd      = std::min((y + extent.height - 1) / mTileHeight, kGridSize - 1) + 1;
+        tiles.columnStart = std::min(x / mTileWidth, kGridSize - 1);
+        tiles.columnEnd   = std::min((x + extent.width - 1) / mTileWidth, kGridSize - 1) + 1;
+        tiles.wordStart   = tiles.columnStart / kBitsPerWord;
+        tiles.wordEnd     = (tiles.columnEnd - 1) / kBitsPerWord + 1;
+        return tiles;
+    }
+
+    uint32_t mTileWidth;
+    uint32_t mTileHeight;
+    // The rows that have been marked since the grid was last cleared.
+    uint32_t mMarkedRowStart;
+    uint32_t mMarkedRowEnd;
+    std::array<Row, kGridSize> mRows;
+};
 }  // anonymous namespace
 
 // This is an arbitrary max. We can change this later if necessary.
 uint32_t DynamicDescriptorPool::mMaxSetsPerPool           = 16;
 uint32_t DynamicDescriptorPool::mMaxSetsPerPoolMultiplier = 2;
+uint32_t DynamicDescriptorPool::mMaxCachedDescriptorSets  = 4096;
 
 VkPipelineStageFlags GetRefCountedEventStageMask(Context *context, const RefCountedEvent &event)
 {
@@ -4004,7 +4179,9 @@ bool DescriptorPoolHelper::allocateDescriptorSet(Context *context,
 
 // DynamicDescriptorPool implementation.
 DynamicDescriptorPool::DynamicDescriptorPool()
-    : mCurrentPoolIndex(0), mCachedDescriptorSetLayout(VK_NULL_HANDLE)
+    : mCurrentPoolIndex(0),
+      mCachedDescriptorSetLayout(VK_NULL_HANDLE),
+      mEvictionThreshold(0)
 {}
 
 DynamicDescriptorPool::~DynamicDescriptorPool()
@@ -4025,6 +4202,7 @@ DynamicDescriptorPool &DynamicDescriptorPool::operator=(DynamicDescriptorPool &&
     std::swap(mPoolSizes, other.mPoolSizes);
     std::swap(mCachedDescriptorSetLayout, other.mCachedDescriptorSetLayout);
     std::swap(mDescriptorSetCache, other.mDescriptorSetCache);
+    std::swap(mEvictionThreshold, other.mEvictionThreshold);
     return *this;
 }
 
@@ -4139,16 +4317,54 @@ angle::Result DynamicDescriptorPool::getOrAllocateDescriptorSet(
     commandBufferHelper->retainResource(&bindingOut->get());
     ++context->getPerfCounters().descriptorSetAllocations;
 
-    mDescriptorSetCache.insertDescriptorSet(desc, *descriptorSetOut, bindingOut->getRefCounted());
-    mCacheStats.missAndIncrementSize();
     // Let pool know there is a shared cache key created and destroys the shared cache key
     // when it destroys the pool.
     *newSharedCacheKeyOut = CreateSharedDescriptorSetCacheKey(desc, this);
     bindingOut->get().onNewDescriptorSetAllocated(*newSharedCacheKeyOut);
 
+    mDescriptorSetCache.insertDescriptorSet(desc, *descriptorSetOut, bindingOut->getRefCounted(),
+                                            *newSharedCacheKeyOut);
+    mCacheStats.missAndIncrementSize();
+
+    if (mDescriptorSetCache.getTotalCacheSize() >
+        std::max<size_t>(mMaxCachedDescriptorSets, mEvictionThreshold))
+    {
+        evictCachedDescriptorSets(context->getRenderer());
+    }
+
     return angle::Result::Continue;
 }
 
+void DynamicDescriptorPool::evictCachedDescriptorSets(Renderer *renderer)
+{
+    // Evict down to three quarters of the budget so the cost of the scan is amortized over many
+    // allocations.
+    const size_t targetSize = mMaxCachedDescriptorSets - mMaxCachedDescriptorSets / 4;
+
+    std::vector<DescriptorSetCache::EvictedDescriptorSet> evictedDescriptorSets;
+    uint32_t evictedCount =
+        mDescriptorSetCache.evictLeastRecentlyUsed(targetSize, &evictedDescriptorSets);
+    mCacheStats.evict(evictedCount);
+
+    for (const DescriptorSetCache::EvictedDescriptorSet &evicted : evictedDescriptorSets)
+    {
+        // Same as releaseCachedDescriptorSet, the descriptorSet is recycled once the GPU is done
+        // with the pool.
+        DescriptorSetHelper descriptorSetHelper(evicted.pool->get().getResourceUse(),
+                                                evicted.descriptorSet);
+        evicted.pool->get().addGarbage(std::move(descriptorSetHelper));
+    }
+    for (const DescriptorSetCache::EvictedDescriptorSet &evicted : evictedDescriptorSets)
+    {
+        if (evicted.pool->get().valid())
+        {
+            checkAndReleaseUnusedPool(renderer, evicted.pool);
+        }
+    }
+
+    mEvictionThreshold = mDescriptorSetCache.getTotalCacheSize() + mMaxCachedDescriptorSets / 4;
+}
+
 angle::Result DynamicDescriptorPool::allocateNewPool(Context *context)
 {
     Renderer *renderer = context->getRenderer();
@@ -4274,6 +4490,18 @@ void DynamicDescriptorPool::SetMaxSetsPerPoolMultiplierForTesting(uint32_t maxSe
     mMaxSetsPerPoolMultiplier = maxSetsPerPoolMultiplier;
 }
 
+// For testing only!
+uint32_t DynamicDescriptorPool::GetMaxCachedDescriptorSetsForTesting()
+{
+    return mMaxCachedDescriptorSets;
+}
+
+// For testing only!
+void DynamicDescriptorPool::SetMaxCachedDescriptorSetsForTesting(uint32_t maxCachedDescriptorSets)
+{
+    mMaxCachedDescriptorSets = maxCachedDescriptorSets;
+}
+
 // DynamicallyGrowingPool implementation
 template <typename Pool>
 DynamicallyGrowingPool<Pool>::DynamicallyGrowingPool()
@@ -5674,6 +5902,7 @@ void ImageHelper::resetCachedProperties()
     mAllocationSize              = 0;
     mMemoryAllocationType        = MemoryAllocationType::InvalidEnum;
     mMemoryTypeIndex             = kInvalidMemoryTypeIndex;
+    mUpdateCountAfterPrune.fill(0);
     std::fill(mViewFormats.begin(), mViewFormats.begin() + mViewFormats.max_size(),
               VK_FORMAT_UNDEFINED);
     mYcbcrConversionDesc.reset();
@@ -6176,6 +6405,8 @@ void ImageHelper::releaseStagedUpdates(Renderer *renderer)
 {
     ASSERT(validateSubresourceUpdateRefCountsConsistent());
 
+    finishPendingStagedUpdateLoads();
+
     // Remove updates that never made it to the texture.
     for (std::vector<SubresourceUpdate> &levelUpdates : mSubresourceUpdates)
     {
@@ -6189,6 +6420,7 @@ void ImageHelper::releaseStagedUpdates(Renderer *renderer)
 
     mSubresourceUpdates.clear();
     mTotalStagedBufferUpdateSize = 0;
+    mUpdateCountAfterPrune.fill(0);
     mCurrentSingleClearValue.reset();
 }
 
@@ -7952,6 +8184,8 @@ void ImageHelper::removeSingleSubresourceStagedUpdates(ContextVk *contextVk,
         return;
     }
 
+    finishPendingStagedUpdateLoads();
+
     for (size_t index = 0; index < levelUpdates->size();)
     {
         auto update = levelUpdates->begin() + index;
@@ -8005,6 +8239,8 @@ void ImageHelper::removeStagedUpdates(Context *context,
 {
     ASSERT(validateSubresourceUpdateRefCountsConsistent());
 
+    finishPendingStagedUpdateLoads();
+
     // Remove all updates to levels [start, end].
     for (gl::LevelIndex level = levelGLStart; level <= levelGLEnd; ++level)
     {
@@ -8197,9 +8433,36 @@ angle::Result ImageHelper::stageSubresourceUpdateImpl(ContextVk *contextVk,
                                                 MemoryCoherency::CachedNonCoherent,
                                                 storageFormat.id, &stagingOffset, &stagingPointer));
 
-    loadFunctionInfo.loadFunction(
-        contextVk->getImageLoadContext(), glExtents.width, glExtents.height, glExtents.depth,
-        source, inputRowPitch, inputDepthPitch, stagingPointer, outputRowPitch, outputDepthPitch);
+    // Converting loads may be done on a worker thread, in which case the update is waited on before
+    // it's flushed.  Small updates are not worth the copy of the source data and the task overhead.
+    // Depth/stencil, YUV and paletted data is laid out or read differently, and is always loaded
+    // here.
+    constexpr size_t kMinAsyncLoadSize = 64 * 1024;
+    const std::shared_ptr<angle::WorkerThreadPool> &workerPool =
+        contextVk->getImageLoadContext().multiThreadPool;
+    const bool loadAsync = contextVk->getFeatures().asyncTextureUpload.enabled &&
+                           loadFunctionInfo.requiresConversion &&
+                           allocationSize >= kMinAsyncLoadSize && stencilAllocationSize == 0 &&
+                           !storageFormat.isYUV && !formatInfo.paletted &&
+                           formatInfo.compressedBlockDepth <= 1 && workerPool &&
+                           workerPool->isAsync();
+
+    if (loadAsync)
+    {
+        const size_t sourceSize =
+            GetLoadInputSize(formatInfo, type, glExtents, inputRowPitch, inputDepthPitch);
+        std::shared_ptr<StagedUpdateLoadTask> loadTask = std::make_shared<StagedUpdateLoadTask>(
+            loadFunctionInfo.loadFunction, glExtents, source, sourceSize, inputRowPitch,
+            inputDepthPitch, stagingPointer, outputRowPitch, outputDepthPitch);
+        mPendingStagedUpdateLoads.push_back(workerPool->postWorkerTask(loadTask));
+    }
+    else
+    {
+        loadFunctionInfo.loadFunction(contextVk->getImageLoadContext(), glExtents.width,
+                                      glExtents.height, glExtents.depth, source, inputRowPitch,
+                                      inputDepthPitch, stagingPointer, outputRowPitch,
+                                      outputDepthPitch);
+    }
 
     // YUV formats need special handling.
     if (storageFormat.isYUV)
@@ -8479,6 +8742,9 @@ angle::Result ImageHelper::reformatStagedBufferUpdates(ContextVk *contextVk,
     const gl::InternalFormat &dstFormatInfo =
         gl::GetSizedInternalFormatInfo(dstFormat.glInternalFormat);
 
+    // The staged data is read back below.
+    finishPendingStagedUpdateLoads();
+
     for (std::vector<SubresourceUpdate> &levelUpdates : mSubresourceUpdates)
     {
         for (SubresourceUpdate &update : levelUpdates)
@@ -9496,6 +9762,40 @@ angle::Result ImageHelper::flushStagedUpdatesImpl(ContextVk *contextVk,
     }
     ANGLE_TRY(contextVk->getOutsideRenderPassCommandBufferHelper(transferAccess, &commandBuffer));
 
+    // Consecutive copies from the same buffer to disjoint regions of a level are recorded with a
+    // single command.  This greatly reduces the number of commands (and barriers, see below) when
+    // many small updates are made to a texture, for example to a texture atlas.
+    constexpr size_t kMaxBatchedCopyRegions = 256;
+    VkBuffer batchedCopyBuffer              = VK_NULL_HANDLE;
+    std::vector<VkBufferImageCopy> batchedCopyRegions;
+    VkDeviceSize batchedCopySize = 0;
+
+    // The regions of the level being flushed that have been written since the last barrier.
+    LevelWriteCoverage writeCoverage;
+
+    auto flushBatchedCopies = [&]() {
+        if (batchedCopyRegions.empty())
+        {
+            return angle::Result::Continue;
+        }
+
+        commandBuffer->getCommandBuffer().copyBufferToImage(
+            batchedCopyBuffer, mImage, getCurrentLayout(contextVk),
+            static_cast<uint32_t>(batchedCopyRegions.size()), batchedCopyRegions.data());
+        batchedCopyBuffer = VK_NULL_HANDLE;
+        batchedCopyRegions.clear();
+
+        bool commandBufferWasFlushed = false;
+        ANGLE_TRY(contextVk->onCopyUpdate(batchedCopySize, &commandBufferWasFlushed));
+        batchedCopySize = 0;
+
+        if (commandBufferWasFlushed)
+        {
+            ANGLE_TRY(contextVk->getOutsideRenderPassCommandBufferHelper({}, &commandBuffer));
+        }
+        return angle::Result::Continue;
+    };
+
     // Flush the staged updates in each mip level.
     for (gl::LevelIndex updateMipLevelGL = levelGLStart; updateMipLevelGL < levelGLEnd;
          ++updateMipLevelGL)
@@ -9506,6 +9806,13 @@ angle::Result ImageHelper::flushStagedUpdatesImpl(ContextVk *contextVk,
         std::vector<SubresourceUpdate> updatesToKeep;
         ASSERT(levelUpdates != nullptr);
 
+        // For images with a single layer, the regions written by copies since the last barrier are
+        // tracked, so copies to disjoint regions don't need a barrier between them.  The coverage
+        // is only valid if it includes every write to the level since the last barrier.
+        const bool trackWriteCoverage = mLayerCount == 1 && !transCoding;
+        bool isWriteCoverageValid     = false;
+        writeCoverage.reset(getLevelExtents(toVkLevel(updateMipLevelGL)));
+
         for (SubresourceUpdate &update : *levelUpdates)
         {
             ASSERT(IsClearOfAllChannels(update.updateSource) ||
@@ -9580,6 +9887,35 @@ angle::Result ImageHelper::flushStagedUpdatesImpl(ContextVk *contextVk,
                 }
             }
 
+            // Only copies from staging buffers can be batched.  These buffers are only written by
+            // the host, so accessing them never closes the command buffer the batch is recorded
+            // in.
+            const bool isBufferCopy =
+                update.updateSource == UpdateSource::Buffer &&
+                (!transCoding || update.data.buffer.formatID == actualformat);
+            const bool canBatchCopy =
+                isBufferCopy && update.refCounted.buffer != nullptr &&
+                update.data.buffer.bufferHelper->getBuffer().getHandle() == batchedCopyBuffer &&
+                batchedCopyRegions.size() < kMaxBatchedCopyRegions;
+            if (!canBatchCopy)
+            {
+                ANGLE_TRY(flushBatchedCopies());
+            }
+
+            // The region written by the update, if tracked.
+            const VkOffset3D *updateOffset = nullptr;
+            const VkExtent3D *updateExtent = nullptr;
+            if (trackWriteCoverage && update.updateSource == UpdateSource::Buffer)
+            {
+                updateOffset = &update.data.buffer.copyRegion.imageOffset;
+                updateExtent = &update.data.buffer.copyRegion.imageExtent;
+            }
+            else if (trackWriteCoverage && update.updateSource == UpdateSource::Image)
+            {
+                updateOffset = &update.data.image.copyRegion.dstOffset;
+                updateExtent = &update.data.image.copyRegion.extent;
+            }
+
             // When a barrier is necessary when uploading updates to a level, we could instead move
             // to the next level and continue uploads in parallel.  Once all levels need a barrier,
             // a single barrier can be issued and we could continue with the rest of the updates
@@ -9590,6 +9926,7 @@ angle::Result ImageHelper::flushStagedUpdatesImpl(ContextVk *contextVk,
             if (updateLayerCount >= kMaxParallelLayerWrites)
             {
                 // If there are more subresources than bits we can track, always insert a barrier.
+                ANGLE_TRY(flushBatchedCopies());
                 recordWriteBarrier(contextVk, aspectFlags, barrierLayout, updateMipLevelGL, 1,
                                    updateBaseLayer, updateLayerCount, commandBuffer);
                 mSubresourcesWrittenSinceBarrier[updateMipLevelGL.get()].set();
@@ -9599,15 +9936,36 @@ angle::Result ImageHelper::flushStagedUpdatesImpl(ContextVk *contextVk,
                 ImageLayerWriteMask subresourceHash =
                     GetImageLayerWriteMask(updateBaseLayer, updateLayerCount);
 
-                if (areLevelSubresourcesWrittenWithinMaskRange(updateMipLevelGL.get(),
-                                                               subresourceHash))
+                const bool isWrittenSinceBarrier = areLevelSubresourcesWrittenWithinMaskRange(
+                    updateMipLevelGL.get(), subresourceHash);
+                if (!isWrittenSinceBarrier)
+                {
+                    writeCoverage.clear();
+                    isWriteCoverageValid = trackWriteCoverage;
+                }
+
+                const bool isDisjointWrite = isWriteCoverageValid && updateOffset != nullptr &&
+                                             !writeCoverage.overlaps(*updateOffset, *updateExtent);
+                if (isWrittenSinceBarrier && !isDisjointWrite)
                 {
                     // If there's overlap in subresource upload, issue a barrier.
+                    ANGLE_TRY(flushBatchedCopies());
                     recordWriteBarrier(contextVk, aspectFlags, barrierLayout, updateMipLevelGL, 1,
                                        updateBaseLayer, updateLayerCount, commandBuffer);
                     mSubresourcesWrittenSinceBarrier[updateMipLevelGL.get()].reset();
+                    writeCoverage.clear();
+                    isWriteCoverageValid = trackWriteCoverage;
                 }
                 mSubresourcesWrittenSinceBarrier[updateMipLevelGL.get()] |= subresourceHash;
+
+                if (updateOffset != nullptr)
+                {
+                    writeCoverage.mark(*updateOffset, *updateExtent);
+                }
+                else
+                {
+                    isWriteCoverageValid = false;
+                }
             }
 
             // Add the necessary commands to the outside command buffer.
@@ -9639,37 +9997,38 @@ angle::Result ImageHelper::flushStagedUpdatesImpl(ContextVk *contextVk,
                     CommandBufferAccess bufferAccess;
                     VkBufferImageCopy *copyRegion = &update.data.buffer.copyRegion;
 
-                    if (transCoding && update.data.buffer.formatID != actualformat)
+                    if (!isBufferCopy)
                     {
                         bufferAccess.onBufferComputeShaderRead(currentBuffer);
                         ANGLE_TRY(contextVk->getOutsideRenderPassCommandBufferHelper(
                             bufferAccess, &commandBuffer));
                         ANGLE_TRY(contextVk->getUtils().transCodeEtcToBc(contextVk, currentBuffer,
                                                                          this, copyRegion));
+
+                        bool commandBufferWasFlushed = false;
+                        ANGLE_TRY(contextVk->onCopyUpdate(currentBuffer->getSize(),
+                                                          &commandBufferWasFlushed));
+                        if (commandBufferWasFlushed)
+                        {
+                            ANGLE_TRY(contextVk->getOutsideRenderPassCommandBufferHelper(
+                                {}, &commandBuffer));
+                        }
                     }
                     else
                     {
+                        // The copy is recorded when the batch is flushed.
                         bufferAccess.onBufferTransferRead(currentBuffer);
                         ANGLE_TRY(contextVk->getOutsideRenderPassCommandBufferHelper(
                             bufferAccess, &commandBuffer));
-                        commandBuffer->getCommandBuffer().copyBufferToImage(
-                            currentBuffer->getBuffer().getHandle(), mImage,
-                            getCurrentLayout(contextVk), 1, copyRegion);
+                        batchedCopyBuffer = currentBuffer->getBuffer().getHandle();
+                        batchedCopyRegions.push_back(*copyRegion);
+                        batchedCopySize += currentBuffer->getSize();
                     }
-                    bool commandBufferWasFlushed = false;
-                    ANGLE_TRY(contextVk->onCopyUpdate(currentBuffer->getSize(),
-                                                      &commandBufferWasFlushed));
                     onWrite(updateMipLevelGL, 1, updateBaseLayer, updateLayerCount,
                             copyRegion->imageSubresource.aspectMask);
 
                     // Update total staging buffer size.
                     mTotalStagedBufferUpdateSize -= bufferUpdate.bufferHelper->getSize();
-
-                    if (commandBufferWasFlushed)
-                    {
-                        ANGLE_TRY(
-                            contextVk->getOutsideRenderPassCommandBufferHelper({}, &commandBuffer));
-                    }
                     break;
                 }
                 case UpdateSource::Image:
@@ -9698,8 +10057,12 @@ angle::Result ImageHelper::flushStagedUpdatesImpl(ContextVk *contextVk,
             update.release(renderer);
         }
 
+        ANGLE_TRY(flushBatchedCopies());
+
         // Only remove the updates that were actually applied to the image.
         *levelUpdates = std::move(updatesToKeep);
+        mUpdateCountAfterPrune[updateMipLevelGL.get()] =
+            static_cast<uint32_t>(levelUpdates->size());
     }
 
     if (commandBuffer != nullptr)
@@ -9725,6 +10088,9 @@ angle::Result ImageHelper::flushStagedUpdates(ContextVk *contextVk,
         return angle::Result::Continue;
     }
 
+    // The staging buffers must be fully written before they are copied to the image.
+    finishPendingStagedUpdateLoads();
+
     const gl::TexLevelMask skipLevelsAllFaces = AggregateSkipLevels(skipLevels);
     removeSupersededUpdates(contextVk, skipLevelsAllFaces);
 
@@ -9887,6 +10253,18 @@ bool ImageHelper::hasStagedUpdatesInLevels(gl::LevelIndex levelStart, gl::LevelI
     return false;
 }
 
+void ImageHelper::finishPendingStagedUpdateLoads()
+{
+    if (mPendingStagedUpdateLoads.empty())
+    {
+        return;
+    }
+
+    ANGLE_TRACE_EVENT0("gpu.angle", "ImageHelper::finishPendingStagedUpdateLoads");
+    angle::WaitableEvent::WaitMany(&mPendingStagedUpdateLoads);
+    mPendingStagedUpdateLoads.clear();
+}
+
 bool ImageHelper::hasStagedImageUpdatesWithMismatchedFormat(gl::LevelIndex levelStart,
                                                             gl::LevelIndex levelEnd,
                                                             angle::FormatID formatID) const
@@ -9992,15 +10370,24 @@ void ImageHelper::pruneSupersededUpdatesForLevel(ContextVk *contextVk,
     constexpr int kUpdateCountThreshold                        = 1024;
     std::vector<ImageHelper::SubresourceUpdate> *levelUpdates  = getLevelUpdates(level);
 
-    // If we are below pruning threshold, nothing to do.
+    // If we are below pruning threshold, nothing to do.  Otherwise, pruning for memory is only
+    // done again once the number of updates has grown by half since the level was last pruned.
+    // This keeps the cost of staging many updates that don't supersede each other (such as
+    // uploads to distinct regions of a texture atlas) linear in the number of updates.
     const int updateCount      = static_cast<int>(levelUpdates->size());
     const bool withinThreshold = updateCount < kUpdateCountThreshold &&
                                  mTotalStagedBufferUpdateSize < kSubresourceUpdateSizeBeforePruning;
-    if (updateCount == 1 || (reason == PruneReason::MemoryOptimization && withinThreshold))
+    const bool isRecentlyPruned =
+        updateCount < static_cast<int>(mUpdateCountAfterPrune[level.get()] * 3 / 2);
+    if (updateCount == 1 ||
+        (reason == PruneReason::MemoryOptimization && (withinThreshold || isRecentlyPruned)))
     {
         return;
     }
 
+    // The staging buffers of the superseded updates are released below.
+    finishPendingStagedUpdateLoads();
+
     // Start from the most recent update and define a boundingBox that covers the region to be
     // updated. Walk through all earlier updates and if its update region is contained within the
     // boundingBox, mark it as superseded, otherwise reset the boundingBox and continue.
@@ -10082,6 +10469,7 @@ void ImageHelper::pruneSupersededUpdatesForLevel(ContextVk *contextVk,
     levelUpdates->erase(
         levelUpdates->begin(),
         std::remove_if(levelUpdates->rbegin(), levelUpdates->rend(), canDropUpdate).base());
+    mUpdateCountAfterPrune[level.get()] = static_cast<uint32_t>(levelUpdates->size());
 
     // Update total staging buffer size
     mTotalStagedBufferUpdateSize -= supersededUpdateSize;
@@ -11,6 +11,7 @@
 
 #include "common/MemoryBuffer.h"
 #include "common/SimpleMutex.h"
+#include "common/WorkerThread.h"
 #include "libANGLE/renderer/vulkan/MemoryTracking.h"
 #include "libANGLE/renderer/vulkan/Suballocation.h"
 #include "libANGLE/renderer/vulkan/vk_cache_utils.h"
@@ -402,13 +403,21 @@ class DynamicDescriptorPool final : angle::NonCopyable
     static void SetMaxSetsPerPoolForTesting(uint32_t maxSetsPerPool);
     static uint32_t GetMaxSetsPerPoolMultiplierForTesting();
     static void SetMaxSetsPerPoolMultiplierForTesting(uint32_t maxSetsPerPool);
+    static uint32_t GetMaxCachedDescriptorSetsForTesting();
+    static void SetMaxCachedDescriptorSetsForTesting(uint32_t maxCachedDescriptorSets);
 
   private:
     angle::Result allocateNewPool(Context *context);
 
+    // Evict the least recently used descriptorSets once the cache grows past its budget.
+    void evictCachedDescriptorSets(Renderer *renderer);
+
     static constexpr uint32_t kMaxSetsPerPoolMax = 512;
     static uint32_t mMaxSetsPerPool;
     static uint32_t mMaxSetsPerPoolMultiplier;
+    // The number of descriptorSets the cache may hold before the least recently used ones are
+    // recycled.
+    static uint32_t mMaxCachedDescriptorSets;
     size_t mCurrentPoolIndex;
     std::vector<std::unique_ptr<RefCountedDescriptorPoolHelper>> mDescriptorPools;
     std::vector<VkDescriptorPoolSize> mPoolSizes;
@@ -419,6 +428,10 @@ class DynamicDescriptorPool final : angle::NonCopyable
     // Tracks cache for descriptorSet. Note that cached DescriptorSet can be reuse even if it is GPU
     // busy.
     DescriptorSetCache mDescriptorSetCache;
+    // The cache size past the budget at which eviction is attempted next.  Sets that are bound to
+    // a program cannot be evicted, so this is raised when the cache cannot be brought under budget
+    // to avoid scanning it on every allocation.
+    size_t mEvictionThreshold;
     // Statistics for the cache.
     CacheStats mCacheStats;
 };
@@ -2488,6 +2501,9 @@ class ImageHelper final : public Resource, public angle::Subject
                                         uint32_t layer,
                                         uint32_t layerCount) const;
     bool hasStagedUpdatesInAllocatedLevels() const;
+    // Whether the data of some staged updates is still being loaded on a worker thread.  These
+    // updates are waited on before they are flushed, removed or released.
+    bool hasPendingStagedUpdateLoads() const { return !mPendingStagedUpdateLoads.empty(); }
 
     bool removeStagedClearUpdatesAndReturnColor(gl::LevelIndex levelGL,
                                                 const VkClearColorValue **color);
@@ -2958,6 +2974,10 @@ class ImageHelper final : public Resource, public angle::Subject
     // Whether there are any updates in [start, end).
     bool hasStagedUpdatesInLevels(gl::LevelIndex levelStart, gl::LevelIndex levelEnd) const;
 
+    // Waits for the staged update loads running on worker threads to finish writing to their
+    // staging buffers.
+    void finishPendingStagedUpdateLoads();
+
     // Used only for assertions, these functions verify that
     // SubresourceUpdate::refcountedObject::image or buffer references have the correct ref count.
     // This is to prevent accidental leaks.
@@ -3112,6 +3132,11 @@ class ImageHelper final : public Resource, public angle::Subject
 
     std::vector<std::vector<SubresourceUpdate>> mSubresourceUpdates;
     VkDeviceSize mTotalStagedBufferUpdateSize;
+    // The number of updates left in each level after it was last pruned or flushed, used to
+    // amortize the cost of pruning many updates that don't supersede each other.
+    gl::TexLevelArray<uint32_t> mUpdateCountAfterPrune;
+    // Loads of staged buffer updates that are running on worker threads, see asyncTextureUpload.
+    std::vector<std::shared_ptr<angle::WaitableEvent>> mPendingStagedUpdateLoads;
 
     // Optimization for repeated clear with the same value. If this pointer is not null, the entire
     // image it has been cleared to the specified clear value. If another clear call is made with
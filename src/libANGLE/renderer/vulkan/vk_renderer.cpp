@@ -53,11 +53,6 @@ constexpr bool kExposeNonConformantExtensionsAndVersions = true;
 constexpr bool kExposeNonConformantExtensionsAndVersions = false;
 #endif
 
-#if defined(ANGLE_ENABLE_CRC_FOR_PIPELINE_CACHE)
-constexpr bool kEnableCRCForPipelineCache = true;
-#else
-constexpr bool kEnableCRCForPipelineCache = false;
-#endif
 }  // anonymous namespace
 
 namespace rx
@@ -78,12 +73,12 @@ constexpr uint32_t kPreferredDefaultUniformBufferSize = 64 * 1024u;
 // value will use a dedicated VkDeviceMemory.
 constexpr size_t kImageSizeThresholdForDedicatedMemoryAllocation = 4 * 1024 * 1024;
 
-// Pipeline cache header version. It should be incremented any time there is an update to the cache
-// header or data structure.
-constexpr uint32_t kPipelineCacheVersion = 2;
-
 // Update the pipeline cache every this many swaps.
 constexpr uint32_t kPipelineCacheVkUpdatePeriod = 60;
+// The largest pipeline cache that is synced to the blob cache from a worker thread.  zlib
+// compression ratio normally ranges from 2:1 to 5:1, so this ensures the size can fit into the 32MB
+// blob cache limit on supported platforms.
+constexpr size_t kMaxPipelineCacheTotalSize = 64 * 1024 * 1024;
 // The minimum version of Vulkan that ANGLE requires.  If an instance or device below this version
 // is encountered, initialization will fail.
 constexpr uint32_t kMinimumVulkanAPIVersion = VK_API_VERSION_1_1;
@@ -925,82 +920,8 @@ uint32_t GetMemoryTypeBitsExcludingHostVisible(Renderer *renderer,
     return memoryTypeBitsOut;
 }
 
-// Header data type used for the pipeline cache.
-ANGLE_ENABLE_STRUCT_PADDING_WARNINGS
-
-class CacheDataHeader
-{
-  public:
-    void setData(uint32_t compressedDataCRC,
-                 uint32_t cacheDataSize,
-                 uint16_t numChunks,
-                 uint16_t chunkIndex)
-    {
-        mVersion           = kPipelineCacheVersion;
-        mCompressedDataCRC = compressedDataCRC;
-        mCacheDataSize     = cacheDataSize;
-        mNumChunks         = numChunks;
-        mChunkIndex        = chunkIndex;
-    }
-
-    void getData(uint32_t *versionOut,
-                 uint32_t *compressedDataCRCOut,
-                 uint32_t *cacheDataSizeOut,
-                 size_t *numChunksOut,
-                 size_t *chunkIndexOut) const
-    {
-        *versionOut           = mVersion;
-        *compressedDataCRCOut = mCompressedDataCRC;
-        *cacheDataSizeOut     = mCacheDataSize;
-        *numChunksOut         = static_cast<size_t>(mNumChunks);
-        *chunkIndexOut        = static_cast<size_t>(mChunkIndex);
-    }
-
-  private:
-    // For pipeline cache, the values stored in key data has the following order:
-    // {headerVersion, compressedDataCRC, originalCacheSize, numChunks, chunkIndex;
-    // chunkCompressedData}. The header values are used to validate the data. For example, if the
-    // original and compressed sizes are 70000 bytes (68k) and 68841 bytes (67k), the compressed
-    // data will be divided into two chunks: {ver,crc0,70000,2,0;34421 bytes} and
-    // {ver,crc1,70000,2,1;34420 bytes}.
-    // The version is used to keep track of the cache format. Please note that kPipelineCacheVersion
-    // must be incremented by 1 in case of any updates to the cache header or data structure. While
-    // it is possible to modify the fields in the header, it is recommended to keep the version on
-    // top and the same size unless absolutely necessary.
-
-    uint32_t mVersion;
-    uint32_t mCompressedDataCRC;
-    uint32_t mCacheDataSize;
-    uint16_t mNumChunks;
-    uint16_t mChunkIndex;
-};
-
-ANGLE_DISABLE_STRUCT_PADDING_WARNINGS
-
-// Pack header data for the pipeline cache key data.
-void PackHeaderDataForPipelineCache(uint32_t compressedDataCRC,
-                                    uint32_t cacheDataSize,
-                                    uint16_t numChunks,
-                                    uint16_t chunkIndex,
-                                    CacheDataHeader *dataOut)
-{
-    dataOut->setData(compressedDataCRC, cacheDataSize, numChunks, chunkIndex);
-}
-
-// Unpack header data from the pipeline cache key data.
-void UnpackHeaderDataForPipelineCache(CacheDataHeader *data,
-                                      uint32_t *versionOut,
-                                      uint32_t *compressedDataCRCOut,
-                                      uint32_t *cacheDataSizeOut,
-                                      size_t *numChunksOut,
-                                      size_t *chunkIndexOut)
-{
-    data->getData(versionOut, compressedDataCRCOut, cacheDataSizeOut, numChunksOut, chunkIndexOut);
-}
-
-void ComputePipelineCacheVkChunkKey(VkPhysicalDeviceProperties physicalDeviceProperties,
-                                    const uint8_t chunkIndex,
-                                    angle::BlobCacheKey *hashOut)
+// The prefix of the blob cache keys of the pipeline cache.
+std::string ComputePipelineCacheVkKeyPrefix(VkPhysicalDeviceProperties physicalDeviceProperties)
 {
     std::ostringstream hashStream("ANGLE Pipeline Cache: ", std::ios_base::ate);
     // Add the pipeline cache UUID to make sure the blob cache always gives a compatible pipeline
@@ -1014,276 +935,28 @@ void ComputePipelineCacheVkChunkKey(VkPhysicalDeviceProperties physicalDevicePro
     hashStream << std::hex << physicalDeviceProperties.vendorID;
     hashStream << std::hex << physicalDeviceProperties.deviceID;
 
-    // Add chunkIndex to generate unique key for chunks.
-    hashStream << std::hex << static_cast<uint32_t>(chunkIndex);
-
-    const std::string &hashString = hashStream.str();
-    angle::base::SHA1HashBytes(reinterpret_cast<const unsigned char *>(hashString.c_str()),
-                               hashString.length(), hashOut->data());
+    return hashStream.str();
 }
 
-void CompressAndStorePipelineCacheVk(VkPhysicalDeviceProperties physicalDeviceProperties,
-                                     vk::GlobalOps *globalOps,
-                                     ContextVk *contextVk,
-                                     const std::vector<uint8_t> &cacheData,
-                                     const size_t maxTotalSize)
-{
-    // Though the pipeline cache will be compressed and divided into several chunks to store in blob
-    // cache, the largest total size of blob cache is only 2M in android now, so there is no use to
-    // handle big pipeline cache when android will reject it finally.
-    if (cacheData.size() >= maxTotalSize)
-    {
-        // TODO: handle the big pipeline cache. http://anglebug.com/4722
-        ANGLE_PERF_WARNING(contextVk->getDebug(), GL_DEBUG_SEVERITY_LOW,
-                           "Skip syncing pipeline cache data when it's larger than maxTotalSize.");
-        return;
-    }
-
-    // To make it possible to store more pipeline cache data, compress the whole pipelineCache.
-    angle::MemoryBuffer compressedData;
-
-    if (!angle::CompressBlob(cacheData.size(), cacheData.data(), &compressedData))
-    {
-        ANGLE_PERF_WARNING(contextVk->getDebug(), GL_DEBUG_SEVERITY_LOW,
-                           "Skip syncing pipeline cache data as it failed compression.");
-        return;
-    }
-
-    // If the size of compressedData is larger than (kMaxBlobCacheSize - sizeof(numChunks)),
-    // the pipelineCache still can't be stored in blob cache. Divide the large compressed
-    // pipelineCache into several parts to store seperately. There is no function to
-    // query the limit size in android.
-    constexpr size_t kMaxBlobCacheSize = 64 * 1024;
-    size_t compressedOffset            = 0;
-
-    const size_t numChunks = UnsignedCeilDivide(static_cast<unsigned int>(compressedData.size()),
-                                                kMaxBlobCacheSize - sizeof(CacheDataHeader));
-    ASSERT(numChunks <= UINT16_MAX);
-    size_t chunkSize = UnsignedCeilDivide(static_cast<unsigned int>(compressedData.size()),
-                                          static_cast<unsigned int>(numChunks));
-    uint32_t compressedDataCRC = 0;
-    if (kEnableCRCForPipelineCache)
-    {
-        compressedDataCRC = angle::GenerateCrc(compressedData.data(), compressedData.size());
-    }
-
-    for (size_t chunkIndex = 0; chunkIndex < numChunks; ++chunkIndex)
-    {
-        if (chunkIndex == numChunks - 1)
-        {
-            chunkSize = compressedData.size() - compressedOffset;
-        }
-
-        angle::MemoryBuffer keyData;
-        if (!keyData.resize(sizeof(CacheDataHeader) + chunkSize))
-        {
-            ANGLE_PERF_WARNING(contextVk->getDebug(), GL_DEBUG_SEVERITY_LOW,
-                               "Skip syncing pipeline cache data due to out of memory.");
-            return;
-        }
-
-        // Add the header data, followed by the compressed data.
-        ASSERT(cacheData.size() <= UINT32_MAX);
-        CacheDataHeader headerData = {};
-        PackHeaderDataForPipelineCache(compressedDataCRC, static_cast<uint32_t>(cacheData.size()),
-                                       static_cast<uint16_t>(numChunks),
-                                       static_cast<uint16_t>(chunkIndex), &headerData);
-        memcpy(keyData.data(), &headerData, sizeof(CacheDataHeader));
-        memcpy(keyData.data() + sizeof(CacheDataHeader), compressedData.data() + compressedOffset,
-               chunkSize);
-        compressedOffset += chunkSize;
-
-        // Create unique hash key.
-        angle::BlobCacheKey chunkCacheHash;
-        ComputePipelineCacheVkChunkKey(physicalDeviceProperties, chunkIndex, &chunkCacheHash);
-
-        globalOps->putBlob(chunkCacheHash, keyData);
-    }
-}
-
-class CompressAndStorePipelineCacheTask : public angle::Closure
+class StorePipelineCacheTask : public angle::Closure
 {
   public:
-    CompressAndStorePipelineCacheTask(vk::GlobalOps *globalOps,
-                                      ContextVk *contextVk,
-                                      std::vector<uint8_t> &&cacheData,
-                                      size_t kMaxTotalSize)
-        : mGlobalOps(globalOps),
-          mContextVk(contextVk),
-          mCacheData(std::move(cacheData)),
-          mMaxTotalSize(kMaxTotalSize)
+    StorePipelineCacheTask(Renderer *renderer, vk::GlobalOps *globalOps, size_t maxTotalSize)
+        : mRenderer(renderer), mGlobalOps(globalOps), mMaxTotalSize(maxTotalSize)
     {}
 
     void operator()() override
     {
-        ANGLE_TRACE_EVENT0("gpu.angle", "CompressAndStorePipelineCacheVk");
-        CompressAndStorePipelineCacheVk(mContextVk->getRenderer()->getPhysicalDeviceProperties(),
-                                        mGlobalOps, mContextVk, mCacheData, mMaxTotalSize);
+        ANGLE_TRACE_EVENT0("gpu.angle", "StorePipelineCacheVk");
+        mRenderer->storePipelineCacheData(mGlobalOps, mMaxTotalSize);
     }
 
   private:
+    Renderer *mRenderer;
     vk::GlobalOps *mGlobalOps;
-    ContextVk *mContextVk;
-    std::vector<uint8_t> mCacheData;
     size_t mMaxTotalSize;
 };
 
-angle::Result GetAndDecompressPipelineCacheVk(VkPhysicalDeviceProperties physicalDeviceProperties,
-                                              vk::Context *context,
-                                              vk::GlobalOps *globalOps,
-                                              angle::MemoryBuffer *uncompressedData,
-                                              bool *success)
-{
-    // Make sure that the bool output is initialized to false.
-    *success = false;
-
-    // Compute the hash key of chunkIndex 0 and find the first cache data in blob cache.
-    angle::BlobCacheKey chunkCacheHash;
-    ComputePipelineCacheVkChunkKey(physicalDeviceProperties, 0, &chunkCacheHash);
-    angle::BlobCacheValue keyData;
-
-    if (!globalOps->getBlob(chunkCacheHash, &keyData) || keyData.size() < sizeof(CacheDataHeader))
-    {
-        // Nothing in the cache.
-        return angle::Result::Continue;
-    }
-
-    // Get the number of chunks and other values from the header for data validation.
-    uint32_t cacheVersion;
-    uint32_t compressedDataCRC;
-    uint32_t uncompressedCacheDataSize;
-    size_t numChunks;
-    size_t chunkIndex0;
-
-    CacheDataHeader headerData = {};
-    memcpy(&headerData, keyData.data(), sizeof(CacheDataHeader));
-    UnpackHeaderDataForPipelineCache(&headerData, &cacheVersion, &compressedDataCRC,
-                                     &uncompressedCacheDataSize, &numChunks, &chunkIndex0);
-    if (cacheVersion == kPipelineCacheVersion)
-    {
-        // The data must not contain corruption.
-        if (chunkIndex0 != 0 || numChunks == 0 || uncompressedCacheDataSize == 0)
-        {
-            FATAL() << "Unexpected values while unpacking chunk index 0: " << "cacheVersion = "
-                    << cacheVersion << ", chunkIndex = " << chunkIndex0
-                    << ", numChunks = " << numChunks
-                    << ", uncompressedCacheDataSize = " << uncompressedCacheDataSize;
-        }
-    }
-    else
-    {
-        WARN() << "Change in cache header version detected: " << "newVersion = "
-               << kPipelineCacheVersion << ", existingVersion = " << cacheVersion;
-
-        return angle::Result::Continue;
-    }
-
-    size_t chunkSize      = keyData.size() - sizeof(CacheDataHeader);
-    size_t compressedSize = 0;
-
-    // Allocate enough memory.
-    angle::MemoryBuffer compressedData;
-    ANGLE_VK_CHECK(context, compressedData.resize(chunkSize * numChunks),
-                   VK_ERROR_INITIALIZATION_FAILED);
-
-    // To combine the parts of the pipelineCache data.
-    for (size_t chunkIndex = 0; chunkIndex < numChunks; ++chunkIndex)
-    {
-        // Get the unique key by chunkIndex.
-        ComputePipelineCacheVkChunkKey(physicalDeviceProperties, chunkIndex, &chunkCacheHash);
-
-        if (!globalOps->getBlob(chunkCacheHash, &keyData) ||
-            keyData.size() < sizeof(CacheDataHeader))
-        {
-            // Can't find every part of the cache data.
-            WARN() << "Failed to get pipeline cache chunk " << chunkIndex << " of " << numChunks;
-            return angle::Result::Continue;
-        }
-
-        // Validate the header values and ensure there is enough space to store.
-        uint32_t checkCacheVersion;
-        uint32_t checkCompressedDataCRC;
-        uint32_t checkUncompressedCacheDataSize;
-        size_t checkNumChunks;
-        size_t checkChunkIndex;
-
-        memcpy(&headerData, keyData.data(), sizeof(CacheDataHeader));
-        UnpackHeaderDataForPipelineCache(&headerData, &checkCacheVersion, &checkCompressedDataCRC,
-                                         &checkUncompressedCacheDataSize, &checkNumChunks,
-                                         &checkChunkIndex);
-
-        chunkSize = keyData.size() - sizeof(CacheDataHeader);
-        bool isHeaderDataCorrupted =
-            (checkCacheVersion != cacheVersion) || (checkNumChunks != numChunks) ||
-            (checkUncompressedCacheDataSize != uncompressedCacheDataSize) ||
-            (checkCompressedDataCRC != compressedDataCRC) || (checkChunkIndex != chunkIndex) ||
-            (compressedData.size() < compressedSize + chunkSize);
-        if (isHeaderDataCorrupted)
-        {
-            WARN() << "Pipeline cache chunk header corrupted: " << "checkCacheVersion = "
-                   << checkCacheVersion << ", cacheVersion = " << cacheVersion
-                   << ", checkNumChunks = " << checkNumChunks << ", numChunks = " << numChunks
-                   << ", checkUncompressedCacheDataSize = " << checkUncompressedCacheDataSize
-                   << ", uncompressedCacheDataSize = " << uncompressedCacheDataSize
-                   << ", checkCompressedDataCRC = " << checkCompressedDataCRC
-                   << ", compressedDataCRC = " << compressedDataCRC
-                   << ", checkChunkIndex = " << checkChunkIndex << ", chunkIndex = " << chunkIndex
-                   << ", compressedData.size() = " << compressedData.size()
-                   << ", (compressedSize + chunkSize) = " << (compressedSize + chunkSize);
-            return angle::Result::Continue;
-        }
-
-        memcpy(compressedData.data() + compressedSize, keyData.data() + sizeof(CacheDataHeader),
-               chunkSize);
-        compressedSize += chunkSize;
-    }
-
-    // CRC for compressed data and size for decompressed data should match the values in the header.
-    if (kEnableCRCForPipelineCache)
-    {
-        uint32_t computedCompressedDataCRC =
-            angle::GenerateCrc(compressedData.data(), compressedSize);
-        if (computedCompressedDataCRC != compressedDataCRC)
-        {
-            if (compressedDataCRC == 0)
-            {
-                // This could be due to the cache being populated before kEnableCRCForPipelineCache
-                // was enabled.
-                WARN() << "Expected CRC = " << compressedDataCRC
-                       << ", Actual CRC = " << computedCompressedDataCRC;
-                return angle::Result::Continue;
-            }
-
-            // If the expected CRC is non-zero and does not match the actual CRC from the data,
-            // there has been an unexpected data corruption.
-            ERR() << "Expected CRC = " << compressedDataCRC
-                  << ", Actual CRC = " << computedCompressedDataCRC;
-
-            ERR() << "Data extracted from the cache headers: " << std::hex
-                  << ", compressedDataCRC = 0x" << compressedDataCRC << "numChunks = 0x"
-                  << numChunks << ", uncompressedCacheDataSize = 0x" << uncompressedCacheDataSize;
-
-            FATAL() << "CRC check failed; possible pipeline cache data corruption.";
-            return angle::Result::Stop;
-        }
-    }
-
-    ANGLE_VK_CHECK(context,
-                   angle::DecompressBlob(compressedData.data(), compressedSize,
-                                         uncompressedCacheDataSize, uncompressedData),
-                   VK_ERROR_INITIALIZATION_FAILED);
-
-    if (uncompressedData->size() != uncompressedCacheDataSize)
-    {
-        WARN() << "Expected uncompressed size = " << uncompressedCacheDataSize
-               << ", Actual uncompressed size = " << uncompressedData->size();
-        return angle::Result::Continue;
-    }
-
-    *success = true;
-    return angle::Result::Continue;
-}
-
 // Environment variable (and associated Android property) to enable Vulkan debug-utils markers
 constexpr char kEnableDebugMarkersVarName[]      = "ANGLE_ENABLE_DEBUG_MARKERS";
 constexpr char kEnableDebugMarkersPropertyName[] = "debug.angle.markers";
@@ -1488,6 +1161,8 @@ Renderer::Renderer()
     {
         mPipelineCacheGraphDumpPath = kDefaultPipelineCacheGraphDumpPath;
     }
+
+    mTimelineTracer = vk::TimelineTracer::Create();
 }
 
 Renderer::~Renderer() {}
@@ -1518,6 +1193,13 @@ void Renderer::onDestroy(vk::Context *context)
         oneOffCommandPool.destroy(mDevice);
     }
 
+    // The pipeline cache sync task reads from mPipelineCache.
+    if (mCompressEvent)
+    {
+        mCompressEvent->wait();
+        mCompressEvent.reset();
+    }
+
     mPipelineCache.destroy(mDevice);
     mSamplerCache.destroy(this);
     mYuvConversionCache.destroy(this);
@@ -4509,6 +4191,9 @@ void Renderer::initFeatures(const vk::ExtensionNameList &deviceExtensionNames,
                                 maxComputeWorkGroupInvocations >= 256 &&
                                 ((isAMD && !IsWindows()) || isNvidia || isSamsung));
 
+    // Only enabled by tests and benchmarks.
+    ANGLE_FEATURE_CONDITION(&mFeatures, forceGenerateMipmapOnCPU, false);
+
     bool isAdreno540 = mPhysicalDeviceProperties.deviceID == angle::kDeviceID_Adreno540;
     ANGLE_FEATURE_CONDITION(&mFeatures, forceMaxUniformBufferSize16KB,
                             isQualcommProprietary && isAdreno540);
@@ -4968,6 +4653,10 @@ void Renderer::initFeatures(const vk::ExtensionNameList &deviceExtensionNames,
         &mFeatures, mutableMipmapTextureUpload,
         canPreferDeviceLocalMemoryHostVisible(mPhysicalDeviceProperties.deviceType));
 
+    // Converting texture data asynchronously holds on to a copy of the application's data until
+    // the conversion is done, so it's opt-in for now.
+    ANGLE_FEATURE_CONDITION(&mFeatures, asyncTextureUpload, false);
+
     // Allow passthrough of EGL colorspace attributes on Android platform and for vendors that
     // are known to support wide color gamut.
     ANGLE_FEATURE_CONDITION(&mFeatures, eglColorspaceAttributePassthrough,
@@ -5082,11 +4771,16 @@ angle::Result Renderer::initPipelineCache(vk::Context *context,
                                           vk::PipelineCache *pipelineCache,
                                           bool *success)
 {
+    // Make sure that the bool output is initialized to false.
+    *success = false;
+
+    mPipelineCacheBlobStore.init(ComputePipelineCacheVkKeyPrefix(mPhysicalDeviceProperties));
+
     angle::MemoryBuffer initialData;
     if (!mFeatures.disablePipelineCacheLoadForTesting.enabled)
     {
-        ANGLE_TRY(GetAndDecompressPipelineCacheVk(mPhysicalDeviceProperties, context, mGlobalOps,
-                                                  &initialData, success));
+        *success = mPipelineCacheBlobStore.load(mGlobalOps, kMaxPipelineCacheTotalSize,
+                                                &initialData);
     }
 
     VkPipelineCacheCreateInfo pipelineCacheCreateInfo = {};
@@ -5122,7 +4816,9 @@ angle::Result Renderer::ensurePipelineCacheInitialized(vk::Context *context)
     ANGLE_TRY(initPipelineCache(context, &mPipelineCache, &loadedFromBlobCache));
     if (loadedFromBlobCache)
     {
-        ANGLE_TRY(getPipelineCacheSize(context, &mPipelineCacheSizeAtLastSync));
+        size_t pipelineCacheSize = 0;
+        ANGLE_TRY(getPipelineCacheSize(context, &pipelineCacheSize));
+        mPipelineCacheSizeAtLastSync = pipelineCacheSize;
     }
 
     mPipelineCacheInitialized = true;
@@ -5234,39 +4930,71 @@ angle::Result Renderer::syncPipelineCacheVk(vk::Context *context,
 
     mPipelineCacheVkUpdateTimeout = kPipelineCacheVkUpdatePeriod;
 
-    size_t pipelineCacheSize = 0;
-    ANGLE_TRY(getPipelineCacheSize(context, &pipelineCacheSize));
-    if (pipelineCacheSize <= mPipelineCacheSizeAtLastSync)
+    if (mFeatures.enableAsyncPipelineCacheCompression.enabled)
     {
-        return angle::Result::Continue;
+        // Querying the size of the pipeline cache is cheap, unlike reading its data.  If no
+        // pipelines were added since the last sync, there is nothing new to store, so don't post
+        // a task at all.  The task itself skips storing data whose hash is unchanged.
+        {
+            std::unique_lock<angle::SimpleMutex> lock(mPipelineCacheMutex);
+            size_t pipelineCacheSize = 0;
+            if (mPipelineCache.getCacheData(mDevice, &pipelineCacheSize, nullptr) != VK_SUCCESS ||
+                pipelineCacheSize <= mPipelineCacheSizeAtLastSync)
+            {
+                return angle::Result::Continue;
+            }
+        }
+
+        // Reading, chunking and compressing the pipeline cache is done on a worker thread.  If the
+        // last task hasn't finished, skip this sync.
+        if (mCompressEvent && !mCompressEvent->isReady())
+        {
+            ContextVk *contextVk = vk::GetImpl(contextGL);
+            ANGLE_PERF_WARNING(contextVk->getDebug(), GL_DEBUG_SEVERITY_LOW,
+                               "Skip syncing pipeline cache data when the last task is not ready.");
+            return angle::Result::Continue;
+        }
+
+        mCompressEvent = contextGL->getWorkerThreadPool()->postWorkerTask(
+            std::make_shared<StorePipelineCacheTask>(this, globalOps, kMaxPipelineCacheTotalSize),
+            angle::WorkerTaskPriority::Low);
     }
-    mPipelineCacheSizeAtLastSync = pipelineCacheSize;
+    else
+    {
+        // If enableAsyncPipelineCacheCompression is disabled, the sync happens on this thread, so
+        // limit the size of the cache to keep the sync short.
+        constexpr size_t kMaxTotalSize = 64 * 1024;
+        storePipelineCacheData(globalOps, kMaxTotalSize);
+    }
+
+    return angle::Result::Continue;
+}
 
+void Renderer::storePipelineCacheData(vk::GlobalOps *globalOps, size_t maxTotalSize)
+{
     // Make sure we will receive enough data to hold the pipeline cache header
     // Table 7. Layout for pipeline cache header version VK_PIPELINE_CACHE_HEADER_VERSION_ONE
     const size_t kPipelineCacheHeaderSize = 16 + VK_UUID_SIZE;
-    if (pipelineCacheSize < kPipelineCacheHeaderSize)
-    {
-        // No pipeline cache data to read, so return
-        return angle::Result::Continue;
-    }
 
-    ContextVk *contextVk = vk::GetImpl(contextGL);
+    // The lock serializes access with vkMergePipelineCaches, which requires external
+    // synchronization of mPipelineCache.
+    std::unique_lock<angle::SimpleMutex> lock(mPipelineCacheMutex);
 
-    // Use worker thread pool to complete compression.
-    // If the last task hasn't been finished, skip the syncing.
-    if (mCompressEvent && !mCompressEvent->isReady())
+    size_t pipelineCacheSize = 0;
+    VkResult result          = mPipelineCache.getCacheData(mDevice, &pipelineCacheSize, nullptr);
+    if (result != VK_SUCCESS || pipelineCacheSize <= mPipelineCacheSizeAtLastSync ||
+        pipelineCacheSize < kPipelineCacheHeaderSize)
     {
-        ANGLE_PERF_WARNING(contextVk->getDebug(), GL_DEBUG_SEVERITY_LOW,
-                           "Skip syncing pipeline cache data when the last task is not ready.");
-        return angle::Result::Continue;
+        // Nothing new to store.
+        return;
     }
 
     std::vector<uint8_t> pipelineCacheData(pipelineCacheSize);
 
     size_t oldPipelineCacheSize = pipelineCacheSize;
-    VkResult result =
-        mPipelineCache.getCacheData(mDevice, &pipelineCacheSize, pipelineCacheData.data());
+    result = mPipelineCache.getCacheData(mDevice, &pipelineCacheSize, pipelineCacheData.data());
+    lock.unlock();
+
     // We don't need all of the cache data, so just make sure we at least got the header
     // Vulkan Spec 9.6. Pipeline Cache
     // https://www.khronos.org/registry/vulkan/specs/1.1-extensions/html/chap9.html#pipelines-cache
@@ -5277,16 +5005,17 @@ angle::Result Renderer::syncPipelineCacheVk(vk::Context *context,
     if (ANGLE_UNLIKELY(pipelineCacheSize < kPipelineCacheHeaderSize))
     {
         WARN() << "Not enough pipeline cache data read.";
-        return angle::Result::Continue;
+        return;
     }
     else if (ANGLE_UNLIKELY(result == VK_INCOMPLETE))
     {
         WARN() << "Received VK_INCOMPLETE: Old: " << oldPipelineCacheSize
                << ", New: " << pipelineCacheSize;
     }
-    else
+    else if (ANGLE_UNLIKELY(result != VK_SUCCESS))
     {
-        ANGLE_VK_TRY(context, result);
+        WARN() << "Failed to read pipeline cache data: " << result;
+        return;
     }
 
     // If vkGetPipelineCacheData ends up writing fewer bytes than requested, shrink the buffer to
@@ -5295,27 +5024,12 @@ angle::Result Renderer::syncPipelineCacheVk(vk::Context *context,
     ASSERT(pipelineCacheSize <= pipelineCacheData.size());
     pipelineCacheData.resize(pipelineCacheSize);
 
-    if (mFeatures.enableAsyncPipelineCacheCompression.enabled)
-    {
-        // zlib compression ratio normally ranges from 2:1 to 5:1. Set kMaxTotalSize to 64M to
-        // ensure the size can fit into the 32MB blob cache limit on supported platforms.
-        constexpr size_t kMaxTotalSize = 64 * 1024 * 1024;
-
-        // Create task to compress.
-        mCompressEvent = contextGL->getWorkerThreadPool()->postWorkerTask(
-            std::make_shared<CompressAndStorePipelineCacheTask>(
-                globalOps, contextVk, std::move(pipelineCacheData), kMaxTotalSize));
-    }
-    else
-    {
-        // If enableAsyncPipelineCacheCompression is disabled, to avoid the risk, set kMaxTotalSize
-        // to 64k.
-        constexpr size_t kMaxTotalSize = 64 * 1024;
-        CompressAndStorePipelineCacheVk(mPhysicalDeviceProperties, globalOps, contextVk,
-                                        pipelineCacheData, kMaxTotalSize);
-    }
+    mPipelineCacheSizeAtLastSync = pipelineCacheSize;
 
-    return angle::Result::Continue;
+    // Only the chunks that changed since the last sync are compressed and stored.
+    vk::PipelineCacheBlobStore::StoreStats stats;
+    (void)mPipelineCacheBlobStore.store(globalOps, pipelineCacheData.data(),
+                                        pipelineCacheData.size(), maxTotalSize, &stats);
 }
 
 // These functions look at the mandatory format for support, and fallback to querying the device (if
@@ -27,7 +27,9 @@
 #include "libANGLE/renderer/vulkan/CommandProcessor.h"
 #include "libANGLE/renderer/vulkan/DebugAnnotatorVk.h"
 #include "libANGLE/renderer/vulkan/MemoryTracking.h"
+#include "libANGLE/renderer/vulkan/PipelineCacheBlobStore.h"
 #include "libANGLE/renderer/vulkan/QueryVk.h"
+#include "libANGLE/renderer/vulkan/TimelineTracing.h"
 #include "libANGLE/renderer/vulkan/UtilsVk.h"
 #include "libANGLE/renderer/vulkan/vk_format_utils.h"
 #include "libANGLE/renderer/vulkan/vk_helpers.h"
@@ -242,6 +244,9 @@ class Renderer : angle::NonCopyable
     angle::Result syncPipelineCacheVk(vk::Context *context,
                                       vk::GlobalOps *globalOps,
                                       const gl::Context *contextGL);
+    // Reads the pipeline cache and stores the parts that changed since the last sync in the blob
+    // cache.  May be called from a worker thread.
+    void storePipelineCacheData(vk::GlobalOps *globalOps, size_t maxTotalSize);
 
     const angle::FeaturesVk &getFeatures() const { return mFeatures; }
     uint32_t getMaxVertexAttribDivisor() const { return mMaxVertexAttribDivisor; }
@@ -748,6 +753,9 @@ class Renderer : angle::NonCopyable
         return mPipelineCacheGraphDumpPath.c_str();
     }
 
+    // Returns nullptr unless timeline tracing is enabled.
+    vk::TimelineTracer *getTimelineTracer() const { return mTimelineTracer.get(); }
+
   private:
     angle::Result setupDevice(vk::Context *context,
                               const angle::FeatureOverrides &featureOverrides,
@@ -993,8 +1001,11 @@ class Renderer : angle::NonCopyable
     angle::SimpleMutex mPipelineCacheMutex;
     vk::PipelineCache mPipelineCache;
     uint32_t mPipelineCacheVkUpdateTimeout;
-    size_t mPipelineCacheSizeAtLastSync;
+    // Read when a sync is due and written by the task storing the cache.
+    std::atomic<size_t> mPipelineCacheSizeAtLastSync;
     std::atomic<bool> mPipelineCacheInitialized;
+    // Tracks which parts of the pipeline cache are already in the blob cache.
+    vk::PipelineCacheBlobStore mPipelineCacheBlobStore;
 
     // Latest validation data for debug overlay.
     std::string mLastValidationMessage;
@@ -1085,6 +1096,10 @@ class Renderer : angle::NonCopyable
     std::ostringstream mPipelineCacheGraph;
     bool mDumpPipelineCacheGraph;
     std::string mPipelineCacheGraphDumpPath;
+
+    // A timeline of the work done by the contexts, only created if requested through the
+    // environment.
+    std::unique_ptr<vk::TimelineTracer> mTimelineTracer;
 };
 
 ANGLE_INLINE Serial Renderer::generateQueueSerial(SerialIndex index)
@@ -310,9 +310,12 @@ class GlobalOps : angle::NonCopyable
 
     virtual void putBlob(const angle::BlobCacheKey &key, const angle::MemoryBuffer &value) = 0;
     virtual bool getBlob(const angle::BlobCacheKey &key, angle::BlobCacheValue *valueOut)  = 0;
+    // The codec blobs are compressed with before being put in the blob cache.
+    virtual angle::BlobCompressionCodec getBlobCompressionCodec() const = 0;
 
     virtual std::shared_ptr<angle::WaitableEvent> postMultiThreadWorkerTask(
-        const std::shared_ptr<angle::Closure> &task) = 0;
+        const std::shared_ptr<angle::Closure> &task,
+        angle::WorkerTaskPriority priority) = 0;
 
     virtual void notifyDeviceLost() = 0;
 };
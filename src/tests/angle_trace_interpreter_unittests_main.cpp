@@ -0,0 +1,17 @@
+//
+// Copyright 2024 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// angle_trace_interpreter_unittests_main.cpp:
+//   Entry point for the unit tests of the trace interpreter, which link the capture utilities
+//   instead of the mock capture of angle_unittests.
+
+#include "gtest/gtest.h"
+#include "test_utils/runner/TestSuite.h"
+
+int main(int argc, char **argv)
+{
+    angle::TestSuite testSuite(&argc, argv);
+    return testSuite.run();
+}
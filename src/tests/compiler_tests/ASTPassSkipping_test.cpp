@@ -0,0 +1,169 @@
+//
+// Copyright 2024 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// ASTPassSkipping_test.cpp:
+//   Tests that AST passes are skipped when the shader has nothing for them to do, and that
+//   skipping them doesn't change the output.
+//
+
+#include "GLSLANG/ShaderLang.h"
+#include "angle_gl.h"
+#include "compiler/translator/Compiler.h"
+#include "gtest/gtest.h"
+
+using namespace sh;
+
+namespace
+{
+class ASTPassSkippingTest : public testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        sh::InitBuiltInResources(&mResources);
+        mCompiler =
+            sh::ConstructCompiler(GL_FRAGMENT_SHADER, SH_GLES3_SPEC, SH_ESSL_OUTPUT, &mResources);
+        ASSERT_TRUE(mCompiler != nullptr) << "Compiler could not be constructed.";
+
+        mTranslator = static_cast<TShHandleBase *>(mCompiler)->getAsCompiler();
+        mTranslator->setPassTimingEnabled(true);
+
+        mCompileOptions.objectCode               = true;
+        mCompileOptions.regenerateStructNames    = true;
+        mCompileOptions.clampIndirectArrayBounds = true;
+    }
+
+    void TearDown() override
+    {
+        if (mCompiler)
+        {
+            sh::Destruct(mCompiler);
+            mCompiler = nullptr;
+        }
+    }
+
+    std::string compile(const char *shader, bool skipUntriggeredPasses)
+    {
+        mTranslator->setSkipUntriggeredPassesForTesting(skipUntriggeredPasses);
+        const char *shaderStrings[] = {shader};
+        EXPECT_TRUE(sh::Compile(mCompiler, shaderStrings, 1, mCompileOptions))
+            << sh::GetInfoLog(mCompiler);
+        return sh::GetObjectCode(mCompiler);
+    }
+
+    bool isPassSkipped(const char *name) const
+    {
+        bool skipped = false;
+        bool found   = false;
+        for (const TCompiler::PassTiming &timing : mTranslator->getPassTimings())
+        {
+            if (strcmp(timing.name, name) == 0)
+            {
+                skipped = found ? skipped && timing.skipped : timing.skipped;
+                found   = true;
+            }
+        }
+        EXPECT_TRUE(found) << name;
+        return skipped;
+    }
+
+    void expectSameOutput(const char *shader)
+    {
+        const std::string allPassesOutput = compile(shader, false);
+        const std::string output          = compile(shader, true);
+        EXPECT_EQ(allPassesOutput, output);
+    }
+
+    ShBuiltInResources mResources;
+    ShCompileOptions mCompileOptions = {};
+    ShHandle mCompiler               = nullptr;
+    TCompiler *mTranslator           = nullptr;
+};
+
+// Tests that a shader without loops, switches, short-circuiting operators or dynamic indexing
+// skips the passes that transform them.
+TEST_F(ASTPassSkippingTest, SkipsUntriggeredPasses)
+{
+    constexpr char kShader[] = R"(#version 300 es
+precision mediump float;
+uniform vec4 u;
+out vec4 color;
+void main()
+{
+    color = u * 2.0;
+})";
+
+    expectSameOutput(kShader);
+
+    EXPECT_TRUE(isPassSkipped("RegenerateStructNames"));
+    EXPECT_TRUE(isPassSkipped("ClampIndirectIndices"));
+    EXPECT_TRUE(isPassSkipped("SplitSequenceOperator"));
+    EXPECT_TRUE(isPassSkipped("RemoveArrayLengthMethod"));
+    EXPECT_TRUE(isPassSkipped("PruneEmptyCases"));
+    EXPECT_TRUE(isPassSkipped("SimplifyLoopConditions"));
+    EXPECT_FALSE(isPassSkipped("PruneNoOps"));
+}
+
+// Tests that passes run when their constructs are present.
+TEST_F(ASTPassSkippingTest, RunsTriggeredPasses)
+{
+    constexpr char kShader[] = R"(#version 300 es
+precision mediump float;
+uniform int u;
+uniform vec4 arr[4];
+out vec4 color;
+void main()
+{
+    struct S { vec4 v; };
+    S s = S(vec4(0));
+    int i = 0;
+    do
+    {
+        s.v += arr[i];
+        i++;
+    } while (i < u);
+    switch (u)
+    {
+        case 0:
+            s.v = vec4(1);
+            break;
+        default:
+            break;
+    }
+    color = s.v;
+})";
+
+    expectSameOutput(kShader);
+
+    EXPECT_FALSE(isPassSkipped("SimplifyLoopConditions"));
+    EXPECT_FALSE(isPassSkipped("RegenerateStructNames"));
+    EXPECT_FALSE(isPassSkipped("ClampIndirectIndices"));
+    EXPECT_FALSE(isPassSkipped("PruneEmptyCases"));
+    EXPECT_TRUE(isPassSkipped("SplitSequenceOperator"));
+}
+
+// Tests that the output is unchanged for a shader that uses the sequence operator and the array
+// length method.
+TEST_F(ASTPassSkippingTest, SequenceOperatorAndArrayLength)
+{
+    constexpr char kShader[] = R"(#version 300 es
+precision mediump float;
+uniform vec4 arr[3];
+out vec4 color;
+void main()
+{
+    vec4 v = vec4(0);
+    for (int i = 0; i < arr.length(); i++, v += arr[i - 1])
+    {
+    }
+    color = v;
+})";
+
+    expectSameOutput(kShader);
+
+    EXPECT_FALSE(isPassSkipped("SplitSequenceOperator"));
+    EXPECT_FALSE(isPassSkipped("SimplifyLoopConditions"));
+}
+}  // anonymous namespace
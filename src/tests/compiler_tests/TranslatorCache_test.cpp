@@ -0,0 +1,293 @@
+//
+// Copyright 2024 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// TranslatorCache_test.cpp:
+//   Tests that compilers sharing a translator cache return the results of previous compilations
+//   instead of translating the same shader again.
+//
+
+#include <map>
+#include <vector>
+
+#include "GLSLANG/ShaderLang.h"
+#include "angle_gl.h"
+#include "gtest/gtest.h"
+
+namespace
+{
+constexpr char kVertexShader[] = R"(#version 300 es
+in vec4 position;
+in vec2 texCoord;
+uniform mat4 transform;
+uniform Block { vec4 tint; };
+out vec2 vTexCoord;
+out vec4 vTint;
+void main()
+{
+    vTexCoord   = texCoord;
+    vTint       = tint;
+    gl_Position = transform * position;
+})";
+
+// A map standing in for the persistent storage of an application.
+using Storage = std::map<std::vector<uint8_t>, std::vector<uint8_t>>;
+
+void StorageSet(const void *key,
+                size_t keySize,
+                const void *value,
+                size_t valueSize,
+                void *userData)
+{
+    Storage *storage        = static_cast<Storage *>(userData);
+    const uint8_t *keyPtr   = static_cast<const uint8_t *>(key);
+    const uint8_t *valuePtr = static_cast<const uint8_t *>(value);
+    (*storage)[std::vector<uint8_t>(keyPtr, keyPtr + keySize)].assign(valuePtr,
+                                                                      valuePtr + valueSize);
+}
+
+size_t StorageGet(const void *key, size_t keySize, void *value, size_t valueSize, void *userData)
+{
+    Storage *storage      = static_cast<Storage *>(userData);
+    const uint8_t *keyPtr = static_cast<const uint8_t *>(key);
+    auto iter             = storage->find(std::vector<uint8_t>(keyPtr, keyPtr + keySize));
+    if (iter == storage->end())
+    {
+        return 0;
+    }
+    if (valueSize >= iter->second.size())
+    {
+        memcpy(value, iter->second.data(), iter->second.size());
+    }
+    return iter->second.size();
+}
+
+uint64_t HashName(const char *name, size_t length)
+{
+    uint64_t hash = 0;
+    for (size_t index = 0; index < length; ++index)
+    {
+        hash = hash * 31 + name[index];
+    }
+    return hash;
+}
+
+// Hashes names like HashName from another address, as a new process would with ASLR.  Counting
+// the calls keeps the linker from folding the two functions.
+int gRelocatedHashNameCalls = 0;
+uint64_t RelocatedHashName(const char *name, size_t length)
+{
+    gRelocatedHashNameCalls++;
+    return HashName(name, length);
+}
+
+class TranslatorCacheTest : public testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        sh::InitBuiltInResources(&mResources);
+        mCache = sh::CreateTranslatorCache(1024 * 1024);
+
+        mCompileOptions.objectCode = true;
+    }
+
+    void TearDown() override
+    {
+        for (ShHandle compiler : mCompilers)
+        {
+            sh::Destruct(compiler);
+        }
+        sh::DestroyTranslatorCache(mCache);
+    }
+
+    ShHandle createCompiler(sh::TranslatorCache *cache)
+    {
+        ShHandle compiler =
+            sh::ConstructCompiler(GL_VERTEX_SHADER, SH_GLES3_SPEC, SH_ESSL_OUTPUT, &mResources);
+        EXPECT_NE(nullptr, compiler);
+        sh::SetTranslatorCache(compiler, cache);
+        mCompilers.push_back(compiler);
+        return compiler;
+    }
+
+    bool compile(ShHandle compiler, const char *shader)
+    {
+        const char *shaderStrings[] = {shader};
+        EXPECT_TRUE(sh::Compile(compiler, shaderStrings, 1, mCompileOptions))
+            << sh::GetInfoLog(compiler);
+        return sh::IsCompileResultFromCache(compiler);
+    }
+
+    static void ExpectSameVariables(const std::vector<sh::ShaderVariable> &expected,
+                                    const std::vector<sh::ShaderVariable> &actual)
+    {
+        ASSERT_EQ(expected.size(), actual.size());
+        for (size_t index = 0; index < expected.size(); ++index)
+        {
+            EXPECT_EQ(expected[index], actual[index]) << expected[index].name;
+        }
+    }
+
+    static void ExpectSameResults(ShHandle expected, ShHandle actual)
+    {
+        EXPECT_EQ(sh::GetShaderVersion(expected), sh::GetShaderVersion(actual));
+        EXPECT_EQ(sh::GetInfoLog(expected), sh::GetInfoLog(actual));
+        EXPECT_EQ(sh::GetObjectCode(expected), sh::GetObjectCode(actual));
+        ExpectSameVariables(*sh::GetAttributes(expected), *sh::GetAttributes(actual));
+        ExpectSameVariables(*sh::GetUniforms(expected), *sh::GetUniforms(actual));
+        ExpectSameVariables(*sh::GetOutputVaryings(expected), *sh::GetOutputVaryings(actual));
+        ASSERT_EQ(sh::GetUniformBlocks(expected)->size(), sh::GetUniformBlocks(actual)->size());
+        EXPECT_TRUE(sh::GetUniformBlocks(expected)->front().isSameInterfaceBlockAtLinkTime(
+            sh::GetUniformBlocks(actual)->front()));
+        EXPECT_EQ(sh::GetInterfaceBlocks(expected)->size(), sh::GetInterfaceBlocks(actual)->size());
+        EXPECT_EQ(sh::GetMetadataFlags(expected), sh::GetMetadataFlags(actual));
+    }
+
+    ShBuiltInResources mResources;
+    ShCompileOptions mCompileOptions = {};
+    sh::TranslatorCache *mCache      = nullptr;
+    std::vector<ShHandle> mCompilers;
+};
+
+// Tests that a second compiler sharing the cache returns the results of the first one.
+TEST_F(TranslatorCacheTest, HitAcrossCompilers)
+{
+    ShHandle first  = createCompiler(mCache);
+    ShHandle second = createCompiler(mCache);
+
+    EXPECT_FALSE(compile(first, kVertexShader));
+    EXPECT_TRUE(compile(second, kVertexShader));
+    ExpectSameResults(first, second);
+
+    // A compiler that doesn't use the cache produces the same results.
+    ShHandle uncached = createCompiler(nullptr);
+    EXPECT_FALSE(compile(uncached, kVertexShader));
+    ExpectSameResults(uncached, second);
+}
+
+// Tests that changing the source or the compile options misses the cache.
+TEST_F(TranslatorCacheTest, MissOnDifferentInput)
+{
+    ShHandle compiler = createCompiler(mCache);
+
+    EXPECT_FALSE(compile(compiler, kVertexShader));
+    EXPECT_TRUE(compile(compiler, kVertexShader));
+
+    std::string modifiedShader = std::string(kVertexShader) + "\n";
+    EXPECT_FALSE(compile(compiler, modifiedShader.c_str()));
+
+    mCompileOptions.initOutputVariables = true;
+    EXPECT_FALSE(compile(compiler, kVertexShader));
+    EXPECT_TRUE(compile(compiler, kVertexShader));
+}
+
+// Tests that failed compilations are not cached.
+TEST_F(TranslatorCacheTest, FailedCompilationNotCached)
+{
+    ShHandle compiler           = createCompiler(mCache);
+    const char *shaderStrings[] = {"#version 300 es\nvoid main() { undefined = 1; }"};
+
+    EXPECT_FALSE(sh::Compile(compiler, shaderStrings, 1, mCompileOptions));
+    EXPECT_FALSE(sh::IsCompileResultFromCache(compiler));
+    EXPECT_FALSE(sh::Compile(compiler, shaderStrings, 1, mCompileOptions));
+    EXPECT_FALSE(sh::IsCompileResultFromCache(compiler));
+    EXPECT_NE(std::string::npos, sh::GetInfoLog(compiler).find("undefined"));
+}
+
+// Tests that a new cache finds the results stored by another cache in persistent storage, as a
+// new process would.
+TEST_F(TranslatorCacheTest, PersistentStorage)
+{
+    Storage storage;
+    sh::SetTranslatorCacheStorage(mCache, StorageSet, StorageGet, &storage);
+
+    ShHandle first = createCompiler(mCache);
+    EXPECT_FALSE(compile(first, kVertexShader));
+    EXPECT_EQ(1u, storage.size());
+
+    sh::TranslatorCache *otherCache = sh::CreateTranslatorCache(1024 * 1024);
+    sh::SetTranslatorCacheStorage(otherCache, StorageSet, StorageGet, &storage);
+
+    ShHandle second = createCompiler(otherCache);
+    EXPECT_TRUE(compile(second, kVertexShader));
+    ExpectSameResults(first, second);
+
+    sh::Destruct(second);
+    mCompilers.pop_back();
+    sh::DestroyTranslatorCache(otherCache);
+}
+
+// Tests that corrupt data in the persistent storage is ignored.
+TEST_F(TranslatorCacheTest, CorruptStorage)
+{
+    Storage storage;
+    sh::SetTranslatorCacheStorage(mCache, StorageSet, StorageGet, &storage);
+
+    ShHandle uncached = createCompiler(nullptr);
+    EXPECT_FALSE(compile(uncached, kVertexShader));
+
+    ShHandle first = createCompiler(mCache);
+    EXPECT_FALSE(compile(first, kVertexShader));
+    ASSERT_EQ(1u, storage.size());
+    storage.begin()->second.resize(storage.begin()->second.size() / 2);
+
+    sh::TranslatorCache *otherCache = sh::CreateTranslatorCache(1024 * 1024);
+    sh::SetTranslatorCacheStorage(otherCache, StorageSet, StorageGet, &storage);
+
+    ShHandle second = createCompiler(otherCache);
+    EXPECT_FALSE(compile(second, kVertexShader));
+    ExpectSameResults(uncached, second);
+
+    sh::Destruct(second);
+    mCompilers.pop_back();
+    sh::DestroyTranslatorCache(otherCache);
+}
+
+// Tests that the persistent storage is found regardless of the address of the hash function, but
+// not when names are hashed in only one of the compilations.
+TEST_F(TranslatorCacheTest, PersistentStorageWithHashFunction)
+{
+    Storage storage;
+    sh::SetTranslatorCacheStorage(mCache, StorageSet, StorageGet, &storage);
+
+    mResources.HashFunction = HashName;
+    ShHandle first          = createCompiler(mCache);
+    EXPECT_FALSE(compile(first, kVertexShader));
+    EXPECT_EQ(1u, storage.size());
+
+    sh::TranslatorCache *otherCache = sh::CreateTranslatorCache(1024 * 1024);
+    sh::SetTranslatorCacheStorage(otherCache, StorageSet, StorageGet, &storage);
+
+    mResources.HashFunction = RelocatedHashName;
+    ShHandle second         = createCompiler(otherCache);
+    EXPECT_TRUE(compile(second, kVertexShader));
+    ExpectSameResults(first, second);
+
+    mResources.HashFunction = nullptr;
+    ShHandle unhashed       = createCompiler(otherCache);
+    EXPECT_FALSE(compile(unhashed, kVertexShader));
+    EXPECT_EQ(2u, storage.size());
+
+    sh::Destruct(unhashed);
+    mCompilers.pop_back();
+    sh::Destruct(second);
+    mCompilers.pop_back();
+    sh::DestroyTranslatorCache(otherCache);
+}
+
+// Tests that the cache doesn't grow past its maximum size.
+TEST_F(TranslatorCacheTest, Eviction)
+{
+    sh::TranslatorCache *smallCache = sh::CreateTranslatorCache(1);
+    ShHandle compiler               = createCompiler(smallCache);
+
+    EXPECT_FALSE(compile(compiler, kVertexShader));
+    EXPECT_FALSE(compile(compiler, kVertexShader));
+
+    sh::Destruct(compiler);
+    mCompilers.pop_back();
+    sh::DestroyTranslatorCache(smallCache);
+}
+}  // anonymous namespace
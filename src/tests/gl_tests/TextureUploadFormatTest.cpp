@@ -630,3 +630,217 @@ TEST_P(TextureUploadFormatTest, All)
 }
 
 ANGLE_INSTANTIATE_TEST_ES2_AND_ES3(TextureUploadFormatTest);
+
+namespace
+{
+// Large enough for the staged update to be loaded on a worker thread with asyncTextureUpload.
+constexpr GLsizei kConversionTextureSize = 256;
+
+class TextureUploadConversionTest : public ANGLETest<>
+{
+  protected:
+    TextureUploadConversionTest()
+    {
+        setWindowWidth(16);
+        setWindowHeight(16);
+        setConfigRedBits(8);
+        setConfigGreenBits(8);
+        setConfigBlueBits(8);
+        setConfigAlphaBits(8);
+    }
+
+    void testSetUp() override
+    {
+        mProgram = CompileProgram(essl1_shaders::vs::Texture2D(), essl1_shaders::fs::Texture2D());
+        ASSERT_NE(0u, mProgram);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    }
+
+    void testTearDown() override { glDeleteProgram(mProgram); }
+
+    // RGB data, which is converted to RGBA when RGB8 is emulated.  |seed| makes every upload
+    // different.
+    static std::vector<GLubyte> MakeRGBData(GLsizei width, GLsizei height, GLubyte seed)
+    {
+        std::vector<GLubyte> data;
+        for (GLsizei y = 0; y < height; ++y)
+        {
+            for (GLsizei x = 0; x < width; ++x)
+            {
+                data.push_back(static_cast<GLubyte>(x + seed));
+                data.push_back(static_cast<GLubyte>(y * 3 + seed));
+                data.push_back(static_cast<GLubyte>((x ^ y) + seed));
+            }
+        }
+        return data;
+    }
+
+    // Writes |data| to the |width|x|height| rectangle at (x, y) of the |textureWidth| wide image
+    // in |expected|.
+    static void UpdateExpected(std::vector<GLColor> *expected,
+                               GLsizei textureWidth,
+                               GLint x,
+                               GLint y,
+                               GLsizei width,
+                               GLsizei height,
+                               const std::vector<GLubyte> &data)
+    {
+        for (GLsizei row = 0; row < height; ++row)
+        {
+            for (GLsizei column = 0; column < width; ++column)
+            {
+                const GLubyte *texel = &data[(row * width + column) * 3];
+                (*expected)[(y + row) * textureWidth + x + column] =
+                    GLColor(texel[0], texel[1], texel[2], 255);
+            }
+        }
+    }
+
+    // Draws |texture| to a framebuffer of its size and checks every pixel.
+    void verifyTexture(GLuint texture,
+                       GLsizei width,
+                       GLsizei height,
+                       const std::vector<GLColor> &expected)
+    {
+        GLTexture colorTexture;
+        glBindTexture(GL_TEXTURE_2D, colorTexture);
+        glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, width, height);
+
+        GLFramebuffer framebuffer;
+        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, colorTexture,
+                               0);
+        ASSERT_GL_FRAMEBUFFER_COMPLETE(GL_FRAMEBUFFER);
+
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+        glViewport(0, 0, width, height);
+        drawQuad(mProgram, essl1_shaders::PositionAttrib(), 0.5f);
+        ASSERT_GL_NO_ERROR();
+
+        std::vector<GLColor> actual(width * height);
+        glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, actual.data());
+        ASSERT_GL_NO_ERROR();
+
+        for (GLsizei y = 0; y < height; ++y)
+        {
+            for (GLsizei x = 0; x < width; ++x)
+            {
+                ASSERT_EQ(expected[y * width + x], actual[y * width + x])
+                    << "at (" << x << ", " << y << ")";
+            }
+        }
+
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    }
+
+    GLuint mProgram = 0;
+};
+}  // anonymous namespace
+
+// Tests a large upload that needs conversion followed by a draw.  The application's data is
+// modified right after the upload, which must not affect the texture.
+TEST_P(TextureUploadConversionTest, LargeUploadThenDraw)
+{
+    constexpr GLsizei kSize = kConversionTextureSize;
+
+    std::vector<GLubyte> data = MakeRGBData(kSize, kSize, 0);
+    std::vector<GLColor> expected(kSize * kSize);
+    UpdateExpected(&expected, kSize, 0, 0, kSize, kSize, data);
+
+    GLTexture texture;
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB8, kSize, kSize, 0, GL_RGB, GL_UNSIGNED_BYTE,
+                 data.data());
+    std::fill(data.begin(), data.end(), 0);
+    ASSERT_GL_NO_ERROR();
+
+    verifyTexture(texture, kSize, kSize, expected);
+}
+
+// Tests overlapping glTexSubImage2D calls, whose loads may run in any order but must be applied
+// in the order of the calls.
+TEST_P(TextureUploadConversionTest, OverlappingSubImage)
+{
+    constexpr GLsizei kSize    = kConversionTextureSize;
+    constexpr GLsizei kSubSize = 160;
+
+    std::vector<GLColor> expected(kSize * kSize);
+
+    GLTexture texture;
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGB8, kSize, kSize);
+
+    const std::vector<GLubyte> baseData = MakeRGBData(kSize, kSize, 0);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, kSize, kSize, GL_RGB, GL_UNSIGNED_BYTE,
+                    baseData.data());
+    UpdateExpected(&expected, kSize, 0, 0, kSize, kSize, baseData);
+
+    const std::vector<GLubyte> firstData = MakeRGBData(kSubSize, kSubSize, 50);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 16, 16, kSubSize, kSubSize, GL_RGB, GL_UNSIGNED_BYTE,
+                    firstData.data());
+    UpdateExpected(&expected, kSize, 16, 16, kSubSize, kSubSize, firstData);
+
+    const std::vector<GLubyte> secondData = MakeRGBData(kSubSize, kSubSize, 100);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 80, 64, kSubSize, kSubSize, GL_RGB, GL_UNSIGNED_BYTE,
+                    secondData.data());
+    UpdateExpected(&expected, kSize, 80, 64, kSubSize, kSubSize, secondData);
+    ASSERT_GL_NO_ERROR();
+
+    verifyTexture(texture, kSize, kSize, expected);
+
+    // Overlap an update that was already flushed.
+    const std::vector<GLubyte> thirdData = MakeRGBData(kSubSize, kSubSize, 150);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 40, 90, kSubSize, kSubSize, GL_RGB, GL_UNSIGNED_BYTE,
+                    thirdData.data());
+    UpdateExpected(&expected, kSize, 40, 90, kSubSize, kSubSize, thirdData);
+    ASSERT_GL_NO_ERROR();
+
+    verifyTexture(texture, kSize, kSize, expected);
+}
+
+// Tests redefining a texture while the loads of its previous definition may still be pending.
+TEST_P(TextureUploadConversionTest, RedefineWhileLoadPending)
+{
+    constexpr GLsizei kSize = kConversionTextureSize;
+
+    GLTexture texture;
+    glBindTexture(GL_TEXTURE_2D, texture);
+
+    // Redefine with the same size.
+    const std::vector<GLubyte> firstData = MakeRGBData(kSize, kSize, 0);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB8, kSize, kSize, 0, GL_RGB, GL_UNSIGNED_BYTE,
+                 firstData.data());
+    const std::vector<GLubyte> secondData = MakeRGBData(kSize, kSize, 70);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB8, kSize, kSize, 0, GL_RGB, GL_UNSIGNED_BYTE,
+                 secondData.data());
+    ASSERT_GL_NO_ERROR();
+
+    std::vector<GLColor> expected(kSize * kSize);
+    UpdateExpected(&expected, kSize, 0, 0, kSize, kSize, secondData);
+    verifyTexture(texture, kSize, kSize, expected);
+
+    // Redefine with another size and format, after a partial update.
+    const std::vector<GLubyte> subData = MakeRGBData(kSize, kSize / 2, 140);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, kSize, kSize / 2, GL_RGB, GL_UNSIGNED_BYTE,
+                    subData.data());
+
+    constexpr GLsizei kNewSize = kSize / 2;
+    std::vector<GLColor> newData(kNewSize * kNewSize);
+    for (size_t index = 0; index < newData.size(); ++index)
+    {
+        newData[index] = GLColor(static_cast<GLubyte>(index), static_cast<GLubyte>(index >> 8),
+                                 static_cast<GLubyte>(index * 7), 255);
+    }
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, kNewSize, kNewSize, 0, GL_RGBA, GL_UNSIGNED_BYTE,
+                 newData.data());
+    ASSERT_GL_NO_ERROR();
+
+    verifyTexture(texture, kNewSize, kNewSize, newData);
+}
+
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(TextureUploadConversionTest);
+ANGLE_INSTANTIATE_TEST_ES3_AND(TextureUploadConversionTest,
+                               ES3_VULKAN().enable(Feature::AsyncTextureUpload));
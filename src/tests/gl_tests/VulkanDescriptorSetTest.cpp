@@ -32,6 +32,8 @@ class VulkanDescriptorSetTest : public ANGLETest<>
         mMaxSetsPerPool = rx::vk::DynamicDescriptorPool::GetMaxSetsPerPoolForTesting();
         mMaxSetsPerPoolMultiplier =
             rx::vk::DynamicDescriptorPool::GetMaxSetsPerPoolMultiplierForTesting();
+        mMaxCachedDescriptorSets =
+            rx::vk::DynamicDescriptorPool::GetMaxCachedDescriptorSetsForTesting();
     }
 
     void testTearDown() override
@@ -39,10 +41,13 @@ class VulkanDescriptorSetTest : public ANGLETest<>
         rx::vk::DynamicDescriptorPool::SetMaxSetsPerPoolForTesting(mMaxSetsPerPool);
         rx::vk::DynamicDescriptorPool::SetMaxSetsPerPoolMultiplierForTesting(
             mMaxSetsPerPoolMultiplier);
+        rx::vk::DynamicDescriptorPool::SetMaxCachedDescriptorSetsForTesting(
+            mMaxCachedDescriptorSets);
     }
 
     static constexpr uint32_t kMaxSetsForTesting           = 1;
     static constexpr uint32_t kMaxSetsMultiplierForTesting = 1;
+    static constexpr uint32_t kMaxCachedSetsForTesting     = 4;
 
     void limitMaxSets()
     {
@@ -51,9 +56,16 @@ class VulkanDescriptorSetTest : public ANGLETest<>
             kMaxSetsMultiplierForTesting);
     }
 
+    void limitMaxCachedSets()
+    {
+        rx::vk::DynamicDescriptorPool::SetMaxCachedDescriptorSetsForTesting(
+            kMaxCachedSetsForTesting);
+    }
+
   private:
     uint32_t mMaxSetsPerPool;
     uint32_t mMaxSetsPerPoolMultiplier;
+    uint32_t mMaxCachedDescriptorSets;
 };
 
 // Test atomic counter read.
@@ -98,6 +110,42 @@ TEST_P(VulkanDescriptorSetTest, AtomicCounterReadLimitedDescriptorPool)
     }
 }
 
+// Test that sampling more textures than the descriptor set cache can hold, so that the least
+// recently used descriptor sets are evicted and recycled, keeps rendering correctly.
+TEST_P(VulkanDescriptorSetTest, TextureDescriptorSetCacheEviction)
+{
+    limitMaxSets();
+    limitMaxCachedSets();
+
+    ANGLE_GL_PROGRAM(program, essl1_shaders::vs::Texture2D(), essl1_shaders::fs::Texture2D());
+    glUseProgram(program);
+
+    constexpr size_t kTextureCount = 16;
+    std::array<GLTexture, kTextureCount> textures;
+    std::array<GLColor, kTextureCount> colors;
+    for (size_t i = 0; i < kTextureCount; ++i)
+    {
+        colors[i] = GLColor(static_cast<GLubyte>(i * 16), 255 - static_cast<GLubyte>(i * 16), 0,
+                            255);
+        glBindTexture(GL_TEXTURE_2D, textures[i]);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, &colors[i]);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    }
+
+    // Cycle through the textures several times so evicted descriptor sets are reallocated.
+    for (int iteration = 0; iteration < 3; ++iteration)
+    {
+        for (size_t i = 0; i < kTextureCount; ++i)
+        {
+            glBindTexture(GL_TEXTURE_2D, textures[i]);
+            drawQuad(program, essl1_shaders::PositionAttrib(), 0.5f);
+            ASSERT_GL_NO_ERROR();
+            EXPECT_PIXEL_COLOR_EQ(0, 0, colors[i]);
+        }
+    }
+}
+
 class VulkanDescriptorSetLayoutDescTest : public ANGLETest<>
 {
   protected:
@@ -7919,6 +7919,38 @@ TEST_P(VulkanPerformanceCounterTest, AsyncMonolithicPipelineCreation)
     EXPECT_PIXEL_COLOR_EQ(0, 0, GLColor::red);
 }
 
+// Verify that programs linked from the same shaders reuse the transformed SPIR-V of each other.
+TEST_P(VulkanPerformanceCounterTest, SpirvTransformCacheSharedBetweenPrograms)
+{
+    constexpr char kFS[] = R"(#version 300 es
+precision mediump float;
+uniform vec4 color;
+out vec4 colorOut;
+void main()
+{
+    colorOut = color.zyxw;
+})";
+
+    ANGLE_GL_PROGRAM(program1, essl3_shaders::vs::Simple(), kFS);
+    glUseProgram(program1);
+    glUniform4f(glGetUniformLocation(program1, "color"), 0.0f, 1.0f, 1.0f, 1.0f);
+    drawQuad(program1, essl3_shaders::PositionAttrib(), 0.0f);
+    EXPECT_PIXEL_COLOR_EQ(0, 0, GLColor::yellow);
+
+    const angle::VulkanPerfCounters countersBefore = getPerfCounters();
+
+    // The second program needs exactly the same transformations as the first one.
+    ANGLE_GL_PROGRAM(program2, essl3_shaders::vs::Simple(), kFS);
+    glUseProgram(program2);
+    glUniform4f(glGetUniformLocation(program2, "color"), 1.0f, 1.0f, 0.0f, 1.0f);
+    drawQuad(program2, essl3_shaders::PositionAttrib(), 0.0f);
+    EXPECT_PIXEL_COLOR_EQ(0, 0, GLColor::cyan);
+
+    const angle::VulkanPerfCounters countersAfter = getPerfCounters();
+    EXPECT_GT(countersAfter.spirvTransformCacheHits, countersBefore.spirvTransformCacheHits);
+    EXPECT_EQ(countersAfter.spirvTransformCacheMisses, countersBefore.spirvTransformCacheMisses);
+}
+
 // Verify that changing framebuffer and back doesn't break the render pass.
 TEST_P(VulkanPerformanceCounterTest, FBOChangeAndBackDoesNotBreakRenderPass)
 {
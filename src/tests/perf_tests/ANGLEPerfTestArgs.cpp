@@ -46,6 +46,7 @@ bool gRunToKeyFrame                = false;
 int gFixedTestTime                 = 0;
 int gFixedTestTimeWithWarmup       = 0;
 const char *gTraceInterpreter      = nullptr;
+bool gThreadedReplay               = false;
 const char *gPrintExtensionsToFile = nullptr;
 const char *gRequestedExtensions   = nullptr;
 bool gIncludeInactiveResources     = false;
@@ -82,6 +83,7 @@ bool TraceTestArg(int *argc, char **argv, int argIndex)
            ParseFlag("--vsync", argc, argv, argIndex, &gVsync) ||
            ParseFlag("--minimize-gpu-work", argc, argv, argIndex, &gMinimizeGPUWork) ||
            ParseCStringArg("--trace-interpreter", argc, argv, argIndex, &gTraceInterpreter) ||
+           ParseFlag("--threaded-replay", argc, argv, argIndex, &gThreadedReplay) ||
            ParseIntArg("--screenshot-frame", argc, argv, argIndex, &gScreenshotFrame) ||
            ParseCStringArgWithHandling("--render-test-output-dir", argc, argv, argIndex,
                                        &gRenderTestOutputDir, ArgHandling::Preserve) ||
@@ -33,6 +33,7 @@ extern bool gRetraceMode;
 extern bool gMinimizeGPUWork;
 extern bool gTraceTestValidation;
 extern const char *gTraceInterpreter;
+extern bool gThreadedReplay;
 extern const char *gPerfCounters;
 extern const char *gUseANGLE;
 extern const char *gUseGL;
@@ -45,6 +45,7 @@ struct BindingsParams final : public RenderTestParams
         windowHeight = 720;
 
         numObjects        = 100;
+        numLiveObjects    = 0;
         allocationStyle   = EVERY_ITERATION;
         iterationsPerStep = kIterationsPerStep;
     }
@@ -52,6 +53,9 @@ struct BindingsParams final : public RenderTestParams
     std::string story() const override;
     TestMode testMode = TestMode::MultipleBindings;
     size_t numObjects;
+    // Buffers created before the test starts and kept alive, so that the bound buffers get large
+    // handles.
+    size_t numLiveObjects;
     AllocationStyle allocationStyle;
 };
 
@@ -89,6 +93,11 @@ std::string BindingsParams::story() const
         }
     }
 
+    if (numLiveObjects > 0)
+    {
+        strstr << "_with_" << numLiveObjects << "_live_objects";
+    }
+
     return strstr.str();
 }
 
@@ -105,6 +114,7 @@ class BindingsBenchmark : public ANGLERenderTest,
   private:
     // TODO: Test binding perf of more than just buffers
     std::vector<GLuint> mBuffers;
+    std::vector<GLuint> mLiveBuffers;
     std::vector<GLenum> mBindingPoints;
     GLuint mMaxVertexAttribs = 0;
 };
@@ -121,6 +131,17 @@ void BindingsBenchmark::initializeBenchmark()
 {
     const BindingsParams &params = GetParam();
 
+    mLiveBuffers.resize(params.numLiveObjects, 0);
+    if (!mLiveBuffers.empty())
+    {
+        glGenBuffers(static_cast<GLsizei>(mLiveBuffers.size()), mLiveBuffers.data());
+        for (GLuint buffer : mLiveBuffers)
+        {
+            glBindBuffer(GL_ARRAY_BUFFER, buffer);
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
     mBuffers.resize(params.numObjects, 0);
     if (params.allocationStyle == AT_INITIALIZATION)
     {
@@ -168,6 +189,10 @@ void BindingsBenchmark::destroyBenchmark()
     {
         glDeleteBuffers(static_cast<GLsizei>(mBuffers.size()), mBuffers.data());
     }
+    if (!mLiveBuffers.empty())
+    {
+        glDeleteBuffers(static_cast<GLsizei>(mLiveBuffers.size()), mLiveBuffers.data());
+    }
 }
 
 void BindingsBenchmark::drawBenchmark()
@@ -242,6 +267,13 @@ BindingsParams VulkanParams(AllocationStyle allocationStyle, TestMode testMode)
     return params;
 }
 
+BindingsParams ManyLiveObjectsParams(const BindingsParams &in)
+{
+    BindingsParams params = in;
+    params.numLiveObjects = 1024 * 1024;
+    return params;
+}
+
 TEST_P(BindingsBenchmark, Run)
 {
     run();
@@ -255,6 +287,10 @@ ANGLE_INSTANTIATE_TEST(BindingsBenchmark,
                        OpenGLOrGLESParams(AT_INITIALIZATION),
                        VulkanParams(EVERY_ITERATION, TestMode::MultipleBindings),
                        VulkanParams(AT_INITIALIZATION, TestMode::MultipleBindings),
-                       VulkanParams(AT_INITIALIZATION, TestMode::VertexArray));
+                       VulkanParams(AT_INITIALIZATION, TestMode::VertexArray),
+                       ManyLiveObjectsParams(VulkanParams(EVERY_ITERATION,
+                                                          TestMode::MultipleBindings)),
+                       ManyLiveObjectsParams(VulkanParams(AT_INITIALIZATION,
+                                                          TestMode::MultipleBindings)));
 
 }  // namespace angle
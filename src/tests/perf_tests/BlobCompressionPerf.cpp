@@ -0,0 +1,216 @@
+//
+// Copyright 2024 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// BlobCompressionPerf:
+//   Performance tests for the codecs used to compress blob cache entries.
+//
+
+#include "ANGLEPerfTest.h"
+
+#include <random>
+
+#include "libANGLE/BlobCache.h"
+
+using namespace testing;
+
+namespace
+{
+enum class BlobOperation
+{
+    Compress,
+    Decompress,
+    // Decompress a cache full of program-sized blobs, as done when warm-starting an app.
+    WarmLoad,
+};
+
+struct BlobCompressionParams
+{
+    angle::BlobCompressionCodec codec;
+    BlobOperation operation;
+    size_t blobSize;
+};
+
+std::ostream &operator<<(std::ostream &os, const BlobCompressionParams &params)
+{
+    switch (params.codec)
+    {
+        case angle::BlobCompressionCodec::Gzip:
+            os << "gzip";
+            break;
+        case angle::BlobCompressionCodec::Lz4:
+            os << "lz4";
+            break;
+        case angle::BlobCompressionCodec::DeflateBest:
+            os << "deflate_best";
+            break;
+        default:
+            UNREACHABLE();
+    }
+
+    switch (params.operation)
+    {
+        case BlobOperation::Compress:
+            os << "_compress";
+            break;
+        case BlobOperation::Decompress:
+            os << "_decompress";
+            break;
+        case BlobOperation::WarmLoad:
+            os << "_warm_load";
+            break;
+    }
+
+    os << "_" << params.blobSize / 1024 << "kb";
+    return os;
+}
+
+// Number of programs loaded per step of the WarmLoad test.
+constexpr size_t kWarmLoadProgramCount = 64;
+
+// Generates data resembling a serialized program: SPIR-V-like instruction streams interleaved with
+// variable names and small tables.
+angle::MemoryBuffer MakeProgramLikeBlob(size_t size, uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    angle::MemoryBuffer blob;
+    EXPECT_TRUE(blob.resize(size));
+
+    static constexpr char kNames[] = "uniformBlock.transform position texCoord color sampler2D ";
+    size_t offset                  = 0;
+    while (offset < size)
+    {
+        if (rng() % 8 == 0)
+        {
+            for (size_t i = 0; i < sizeof(kNames) - 1 && offset < size; ++i)
+            {
+                blob[offset++] = static_cast<uint8_t>(kNames[i]);
+            }
+            continue;
+        }
+
+        // An instruction: word count and opcode, followed by a few small ids.
+        const uint32_t wordCount = 2 + rng() % 4;
+        const uint32_t words[]   = {(wordCount << 16) | (rng() % 64), rng() % 512, rng() % 512,
+                                    rng() % 512, rng() % 512, rng() % 512};
+        for (uint32_t word = 0; word < wordCount; ++word)
+        {
+            for (uint32_t byte = 0; byte < 4 && offset < size; ++byte)
+            {
+                blob[offset++] = static_cast<uint8_t>(words[word] >> (byte * 8));
+            }
+        }
+    }
+
+    return blob;
+}
+
+class BlobCompressionPerfTest : public ANGLEPerfTest,
+                                public WithParamInterface<BlobCompressionParams>
+{
+  public:
+    BlobCompressionPerfTest();
+
+    void SetUp() override;
+    void step() override;
+
+    std::string getName();
+
+  private:
+    angle::MemoryBuffer mUncompressed;
+    angle::MemoryBuffer mCompressed;
+    angle::MemoryBuffer mOutput;
+    egl::BlobCache mBlobCache;
+};
+
+BlobCompressionPerfTest::BlobCompressionPerfTest()
+    : ANGLEPerfTest(getName(), "", "_run", 1, "us"),
+      mBlobCache(GetParam().blobSize * kWarmLoadProgramCount * 2)
+{}
+
+void BlobCompressionPerfTest::SetUp()
+{
+    ANGLEPerfTest::SetUp();
+
+    const BlobCompressionParams &params = GetParam();
+    mUncompressed                       = MakeProgramLikeBlob(params.blobSize, 0);
+    ASSERT_TRUE(angle::CompressBlob(mUncompressed.size(), mUncompressed.data(), &mCompressed,
+                                    params.codec));
+
+    if (params.operation == BlobOperation::WarmLoad)
+    {
+        mBlobCache.setCompressionCodec(params.codec);
+        for (uint32_t program = 0; program < kWarmLoadProgramCount; ++program)
+        {
+            egl::BlobCache::Key key = {};
+            memcpy(key.data(), &program, sizeof(program));
+            ASSERT_TRUE(mBlobCache.compressAndPut(
+                key, MakeProgramLikeBlob(params.blobSize, program), nullptr));
+        }
+    }
+}
+
+void BlobCompressionPerfTest::step()
+{
+    const BlobCompressionParams &params = GetParam();
+
+    switch (params.operation)
+    {
+        case BlobOperation::Compress:
+            angle::CompressBlob(mUncompressed.size(), mUncompressed.data(), &mOutput,
+                                params.codec);
+            break;
+
+        case BlobOperation::Decompress:
+            angle::DecompressBlob(mCompressed.data(), mCompressed.size(), params.blobSize,
+                                  &mOutput);
+            break;
+
+        case BlobOperation::WarmLoad:
+            for (uint32_t program = 0; program < kWarmLoadProgramCount; ++program)
+            {
+                egl::BlobCache::Key key = {};
+                memcpy(key.data(), &program, sizeof(program));
+                (void)mBlobCache.getAndDecompress(nullptr, key, params.blobSize, &mOutput);
+            }
+            break;
+    }
+}
+
+std::string BlobCompressionPerfTest::getName()
+{
+    std::stringstream ss;
+    ss << UnitTest::GetInstance()->current_test_suite()->name() << "/" << GetParam();
+    return ss.str();
+}
+
+// Measures compression and decompression speed of each blob cache codec.
+TEST_P(BlobCompressionPerfTest, Run)
+{
+    this->run();
+}
+
+std::vector<BlobCompressionParams> BlobCompressionTestParams()
+{
+    std::vector<BlobCompressionParams> params;
+    for (angle::BlobCompressionCodec codec :
+         {angle::BlobCompressionCodec::Gzip, angle::BlobCompressionCodec::Lz4,
+          angle::BlobCompressionCodec::DeflateBest})
+    {
+        for (size_t blobSize : {64 * 1024, 1024 * 1024})
+        {
+            params.push_back({codec, BlobOperation::Compress, blobSize});
+            params.push_back({codec, BlobOperation::Decompress, blobSize});
+        }
+        params.push_back({codec, BlobOperation::WarmLoad, 32 * 1024});
+    }
+    return params;
+}
+
+INSTANTIATE_TEST_SUITE_P(,
+                         BlobCompressionPerfTest,
+                         ValuesIn(BlobCompressionTestParams()),
+                         PrintToStringParamName());
+
+}  // anonymous namespace
@@ -11,6 +11,8 @@
 
 #include "ANGLEPerfTest.h"
 
+#include <map>
+
 #include "GLSLANG/ShaderLang.h"
 #include "compiler/translator/Compiler.h"
 #include "compiler/translator/InitializeGlobals.h"
@@ -224,15 +226,24 @@ struct CompilerPerfParameters final : public CompilerParameters
 {
     CompilerPerfParameters(ShShaderOutput output,
                            const char *shaderSource,
-                           const char *shaderSourceId)
-        : CompilerParameters(output), shaderSource(shaderSource)
+                           const char *shaderSourceId,
+                           bool skipUntriggeredPasses = true)
+        : CompilerParameters(output),
+          shaderSource(shaderSource),
+          skipUntriggeredPasses(skipUntriggeredPasses)
     {
         testId = shaderSourceId;
         testId += "_";
         testId += CompilerParameters::str();
+        if (!skipUntriggeredPasses)
+        {
+            testId += "_all_passes";
+        }
     }
 
     const char *shaderSource;
+    // If false, every AST pass is run even if the shader has nothing for it to do, as a baseline.
+    bool skipUntriggeredPasses;
     std::string testId;
 };
 
@@ -255,6 +266,7 @@ class CompilerPerfTest : public ANGLEPerfTest,
 
   protected:
     void setTestShader(const char *str) { mTestShader = str; }
+    bool compile();
 
   private:
     const char *mTestShader;
@@ -285,12 +297,39 @@ void CompilerPerfTest::SetUp()
     {
         SafeDelete(mTranslator);
     }
+    mTranslator->setSkipUntriggeredPassesForTesting(params.skipUntriggeredPasses);
 
     setTestShader(params.shaderSource);
 }
 
 void CompilerPerfTest::TearDown()
 {
+    // Compile once more with timing enabled to report the time spent in each AST pass, summed over
+    // the passes that run more than once.
+    if (mTranslator != nullptr)
+    {
+        mTranslator->setPassTimingEnabled(true);
+        compile();
+        mTranslator->setPassTimingEnabled(false);
+
+        std::map<std::string, double> passTimes;
+        size_t skippedPassCount = 0;
+        for (const sh::TCompiler::PassTiming &timing : mTranslator->getPassTimings())
+        {
+            passTimes[timing.name] += timing.seconds;
+            skippedPassCount += timing.skipped ? 1 : 0;
+        }
+
+        for (const auto &passTime : passTimes)
+        {
+            const std::string metric = ".pass_" + passTime.first;
+            mReporter->RegisterFyiMetric(metric, "us");
+            recordDoubleMetric(metric.c_str(), passTime.second * 1'000'000.0, "us");
+        }
+        mReporter->RegisterFyiMetric(".skipped_passes", "count");
+        recordIntegerMetric(".skipped_passes", skippedPassCount, "count");
+    }
+
     SafeDelete(mTranslator);
 
     SetGlobalPoolAllocator(nullptr);
@@ -301,7 +340,7 @@ void CompilerPerfTest::TearDown()
     ANGLEPerfTest::TearDown();
 }
 
-void CompilerPerfTest::step()
+bool CompilerPerfTest::compile()
 {
     const char *shaderStrings[] = {mTestShader};
 
@@ -310,9 +349,14 @@ void CompilerPerfTest::step()
     compileOptions.initializeUninitializedLocals = true;
     compileOptions.initOutputVariables           = true;
 
+    return mTranslator->compile(shaderStrings, 1, compileOptions);
+}
+
+void CompilerPerfTest::step()
+{
 #if !defined(NDEBUG)
     // Make sure that compilation succeeds and print the info log if it doesn't in debug mode.
-    if (!mTranslator->compile(shaderStrings, 1, compileOptions))
+    if (!compile())
     {
         std::cout << "Compiling perf test shader failed with log:\n"
                   << mTranslator->getInfoSink().info.c_str();
@@ -321,7 +365,7 @@ void CompilerPerfTest::step()
 
     for (unsigned int iteration = 0; iteration < kNumIterationsPerStep; ++iteration)
     {
-        mTranslator->compile(shaderStrings, 1, compileOptions);
+        compile();
     }
 }
 
@@ -345,6 +389,16 @@ ANGLE_INSTANTIATE_TEST(
     CompilerPerfParameters(SH_ESSL_OUTPUT, kSimpleESSL100FragSource, kSimpleESSL100Id),
     CompilerPerfParameters(SH_ESSL_OUTPUT, kSimpleESSL300FragSource, kSimpleESSL300Id),
     CompilerPerfParameters(SH_ESSL_OUTPUT, kRealWorldESSL100FragSource, kRealWorldESSL100Id),
-    CompilerPerfParameters(SH_ESSL_OUTPUT, kTrickyESSL300FragSource, kTrickyESSL300Id));
+    CompilerPerfParameters(SH_ESSL_OUTPUT, kTrickyESSL300FragSource, kTrickyESSL300Id),
+    CompilerPerfParameters(SH_GLSL_450_CORE_OUTPUT,
+                           kRealWorldESSL100FragSource,
+                           kRealWorldESSL100Id,
+                           false),
+    CompilerPerfParameters(SH_GLSL_450_CORE_OUTPUT,
+                           kTrickyESSL300FragSource,
+                           kTrickyESSL300Id,
+                           false),
+    CompilerPerfParameters(SH_ESSL_OUTPUT, kRealWorldESSL100FragSource, kRealWorldESSL100Id, false),
+    CompilerPerfParameters(SH_ESSL_OUTPUT, kTrickyESSL300FragSource, kTrickyESSL300Id, false));
 
 }  // anonymous namespace
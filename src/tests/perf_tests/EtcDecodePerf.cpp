@@ -0,0 +1,186 @@
+//
+// Copyright 2024 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// EtcDecodePerf:
+//   Performance test for decoding ETC1, ETC2 and EAC textures and transcoding them to BC formats
+//   on the CPU, as done on backends without native ETC support.
+//
+
+#include "ANGLEPerfTest.h"
+
+#include <random>
+
+#include "common/WorkerThread.h"
+#include "common/system_utils.h"
+#include "image_util/loadimage.h"
+
+using namespace testing;
+
+namespace
+{
+using angle::WorkerThreadPool;
+
+using LoadFunction = void (*)(const angle::ImageLoadContext &,
+                              size_t,
+                              size_t,
+                              size_t,
+                              const uint8_t *,
+                              size_t,
+                              size_t,
+                              uint8_t *,
+                              size_t,
+                              size_t);
+
+struct EtcFormat
+{
+    const char *name;
+    LoadFunction loadFunction;
+    size_t inputBlockSize;
+    // Output bytes per pixel for decoded formats, or per block for transcoded formats.
+    size_t outputPixelSize;
+    size_t outputBlockSize;
+};
+
+constexpr EtcFormat kEtcFormats[] = {
+    {"ETC1_RGB8_to_RGBA8", angle::LoadETC1RGB8ToRGBA8, 8, 4, 0},
+    {"ETC2_RGBA8_to_RGBA8", angle::LoadETC2RGBA8ToRGBA8, 16, 4, 0},
+    {"EAC_R11_to_R16", angle::LoadEACR11ToR16, 8, 2, 0},
+    {"EAC_RG11_to_RG16F", angle::LoadEACRG11ToRG16F, 16, 4, 0},
+    {"ETC2_RGB8_to_BC1", angle::LoadETC2RGB8ToBC1, 8, 0, 8},
+    {"ETC2_RGBA8_to_BC3", angle::LoadETC2RGBA8ToBC3, 16, 0, 16},
+    {"EAC_RG11_to_BC5", angle::LoadEACRG11ToBC5, 16, 0, 16},
+};
+
+struct EtcDecodeParams
+{
+    size_t formatIndex;
+    uint32_t size;
+    bool multithreaded;
+};
+
+std::ostream &operator<<(std::ostream &os, const EtcDecodeParams &params)
+{
+    os << kEtcFormats[params.formatIndex].name << "_" << params.size << "x" << params.size
+       << (params.multithreaded ? "_multithreaded" : "_singlethreaded");
+    return os;
+}
+
+class EtcDecodePerfTest : public ANGLEPerfTest, public WithParamInterface<EtcDecodeParams>
+{
+  public:
+    EtcDecodePerfTest();
+
+    void SetUp() override;
+    void step() override;
+    void TearDown() override;
+
+    std::string getName();
+
+  private:
+    angle::ImageLoadContext mContext;
+    std::vector<uint8_t> mInput;
+    std::vector<uint8_t> mOutput;
+    size_t mInputRowPitch;
+    size_t mOutputRowPitch;
+
+    double mDecodeTime;
+    size_t mDecodedPixels;
+};
+
+EtcDecodePerfTest::EtcDecodePerfTest()
+    : ANGLEPerfTest(getName(), "", "_run", 1, "us"),
+      mInputRowPitch(0),
+      mOutputRowPitch(0),
+      mDecodeTime(0),
+      mDecodedPixels(0)
+{
+    mReporter->RegisterFyiMetric(".decode_rate", "MPix/s");
+}
+
+void EtcDecodePerfTest::SetUp()
+{
+    ANGLEPerfTest::SetUp();
+
+    const EtcDecodeParams &params = GetParam();
+    const EtcFormat &format       = kEtcFormats[params.formatIndex];
+
+    mContext.singleThreadPool = WorkerThreadPool::Create(1, ANGLEPlatformCurrent());
+    if (params.multithreaded)
+    {
+        mContext.multiThreadPool = WorkerThreadPool::Create(0, ANGLEPlatformCurrent());
+    }
+
+    // Random blocks exercise every ETC2 mode.
+    const size_t blocksPerRow = params.size / 4;
+    mInputRowPitch            = blocksPerRow * format.inputBlockSize;
+    mInput.resize(mInputRowPitch * blocksPerRow);
+    std::mt19937 rng(0);
+    for (uint8_t &byte : mInput)
+    {
+        byte = static_cast<uint8_t>(rng());
+    }
+
+    // Transcoded formats are written one row of blocks at a time.
+    mOutputRowPitch = format.outputBlockSize > 0 ? blocksPerRow * format.outputBlockSize
+                                                 : params.size * format.outputPixelSize;
+    const size_t outputRows = format.outputBlockSize > 0 ? blocksPerRow : params.size;
+    mOutput.resize(mOutputRowPitch * outputRows);
+}
+
+void EtcDecodePerfTest::step()
+{
+    const EtcDecodeParams &params = GetParam();
+    const EtcFormat &format       = kEtcFormats[params.formatIndex];
+
+    const double startTime = angle::GetCurrentSystemTime();
+    format.loadFunction(mContext, params.size, params.size, 1, mInput.data(), mInputRowPitch,
+                        mInput.size(), mOutput.data(), mOutputRowPitch, mOutput.size());
+    mDecodeTime += angle::GetCurrentSystemTime() - startTime;
+    mDecodedPixels += params.size * params.size;
+}
+
+void EtcDecodePerfTest::TearDown()
+{
+    ANGLEPerfTest::TearDown();
+
+    if (mDecodeTime > 0)
+    {
+        recordDoubleMetric(".decode_rate", mDecodedPixels / mDecodeTime / 1'000'000.0, "MPix/s");
+    }
+}
+
+std::string EtcDecodePerfTest::getName()
+{
+    std::stringstream ss;
+    ss << UnitTest::GetInstance()->current_test_suite()->name() << "/" << GetParam();
+    return ss.str();
+}
+
+// Measures the speed of decoding ETC textures on the CPU.
+TEST_P(EtcDecodePerfTest, Run)
+{
+    run();
+}
+
+std::vector<EtcDecodeParams> EtcDecodeTestParams()
+{
+    std::vector<EtcDecodeParams> params;
+    for (size_t formatIndex = 0; formatIndex < ArraySize(kEtcFormats); ++formatIndex)
+    {
+        for (uint32_t size : {256, 4096})
+        {
+            params.push_back({formatIndex, size, false});
+            params.push_back({formatIndex, size, true});
+        }
+    }
+    return params;
+}
+
+INSTANTIATE_TEST_SUITE_P(,
+                         EtcDecodePerfTest,
+                         ValuesIn(EtcDecodeTestParams()),
+                         PrintToStringParamName());
+
+}  // anonymous namespace
@@ -33,8 +33,10 @@ struct GenerateMipmapParams final : public RenderTestParams
         textureHeight = 1080;
 
         internalFormat = GL_RGBA;
+        layerCount     = 1;
 
         webgl = false;
+        cpu   = false;
     }
 
     std::string story() const override;
@@ -43,8 +45,12 @@ struct GenerateMipmapParams final : public RenderTestParams
     GLsizei textureHeight;
 
     GLenum internalFormat;
+    // More than one layer makes a 2D array texture.
+    GLsizei layerCount;
 
     bool webgl;
+    // Whether the Vulkan backend is forced to generate the mipmaps on the CPU.
+    bool cpu;
 };
 
 std::ostream &operator<<(std::ostream &os, const GenerateMipmapParams &params)
@@ -68,6 +74,16 @@ std::string GenerateMipmapParams::story() const
         strstr << "_rgb";
     }
 
+    if (layerCount > 1)
+    {
+        strstr << "_" << layerCount << "_layers";
+    }
+
+    if (cpu)
+    {
+        strstr << "_cpu";
+    }
+
     return strstr.str();
 }
 
@@ -91,6 +107,12 @@ class GenerateMipmapBenchmarkBase : public ANGLERenderTest,
 
   protected:
     void initShaders();
+    void defineTexture(GLuint texture);
+
+    GLenum getTarget() const
+    {
+        return GetParam().layerCount > 1 ? GL_TEXTURE_2D_ARRAY : GL_TEXTURE_2D;
+    }
 
     GLuint mProgram = 0;
     GLuint mTexture = 0;
@@ -146,26 +168,43 @@ void GenerateMipmapBenchmarkBase::initializeBenchmark()
     glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
     glViewport(0, 0, getWindow()->getWidth(), getWindow()->getHeight());
 
+    mTextureData.resize(params.textureWidth * params.textureHeight * params.layerCount * 4);
+    FillWithRandomData(&mTextureData);
+
     glGenTextures(1, &mTexture);
-    glBindTexture(GL_TEXTURE_2D, mTexture);
+    defineTexture(mTexture);
+
+    ASSERT_GL_NO_ERROR();
+}
 
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+void GenerateMipmapBenchmarkBase::defineTexture(GLuint texture)
+{
+    const auto &params  = GetParam();
+    const GLenum target = getTarget();
 
-    mTextureData.resize(params.textureWidth * params.textureHeight * 4);
-    FillWithRandomData(&mTextureData);
+    glBindTexture(target, texture);
 
-    glTexImage2D(GL_TEXTURE_2D, 0, params.internalFormat, params.textureWidth, params.textureHeight,
-                 0, params.internalFormat, GL_UNSIGNED_BYTE, mTextureData.data());
+    glTexParameteri(target, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(target, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(target, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(target, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    if (target == GL_TEXTURE_2D_ARRAY)
+    {
+        glTexImage3D(target, 0, params.internalFormat, params.textureWidth, params.textureHeight,
+                     params.layerCount, 0, params.internalFormat, GL_UNSIGNED_BYTE,
+                     mTextureData.data());
+    }
+    else
+    {
+        glTexImage2D(target, 0, params.internalFormat, params.textureWidth, params.textureHeight,
+                     0, params.internalFormat, GL_UNSIGNED_BYTE, mTextureData.data());
+    }
 
     // Perform a draw so the image data is flushed.
     glDrawArrays(GL_TRIANGLES, 0, 3);
 
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-
-    ASSERT_GL_NO_ERROR();
+    glTexParameteri(target, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
 }
 
 void GenerateMipmapBenchmarkBase::initShaders()
@@ -202,7 +241,7 @@ void GenerateMipmapBenchmark::initializeBenchmark()
     GenerateMipmapBenchmarkBase::initializeBenchmark();
 
     // Generate mipmaps once so the texture doesn't need to be redefined.
-    glGenerateMipmap(GL_TEXTURE_2D);
+    glGenerateMipmap(getTarget());
 
     // Perform a draw so the image data is flushed.
     glDrawArrays(GL_TRIANGLES, 0, 3);
@@ -219,11 +258,19 @@ void GenerateMipmapBenchmark::drawBenchmark()
         std::array<uint8_t, 4> randomData;
         FillWithRandomData(&randomData);
 
-        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 1, 1, params.internalFormat, GL_UNSIGNED_BYTE,
-                        randomData.data());
+        if (getTarget() == GL_TEXTURE_2D_ARRAY)
+        {
+            glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, 0, 1, 1, 1, params.internalFormat,
+                            GL_UNSIGNED_BYTE, randomData.data());
+        }
+        else
+        {
+            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 1, 1, params.internalFormat, GL_UNSIGNED_BYTE,
+                            randomData.data());
+        }
 
         // Generate mipmaps
-        glGenerateMipmap(GL_TEXTURE_2D);
+        glGenerateMipmap(getTarget());
 
         // Perform a draw just so the texture data is flushed.  With the position attributes not
         // set, a constant default value is used, resulting in a very cheap draw.
@@ -240,20 +287,7 @@ void GenerateMipmapWithRedefineBenchmark::drawBenchmark()
 
     // Create a new texture every time, so image redefinition happens every time.
     GLTexture texture;
-    glBindTexture(GL_TEXTURE_2D, texture);
-
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-
-    glTexImage2D(GL_TEXTURE_2D, 0, params.internalFormat, params.textureWidth, params.textureHeight,
-                 0, params.internalFormat, GL_UNSIGNED_BYTE, mTextureData.data());
-
-    // Perform a draw so the image data is flushed.
-    glDrawArrays(GL_TRIANGLES, 0, 3);
-
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    defineTexture(texture);
 
     startGpuTimer();
 
@@ -261,7 +295,7 @@ void GenerateMipmapWithRedefineBenchmark::drawBenchmark()
     ASSERT_EQ(params.iterationsPerStep, 1u);
 
     // Generate mipmaps
-    glGenerateMipmap(GL_TEXTURE_2D);
+    glGenerateMipmap(getTarget());
 
     // Perform a draw just so the texture data is flushed.  With the position attributes not
     // set, a constant default value is used, resulting in a very cheap draw.
@@ -332,6 +366,21 @@ GenerateMipmapParams VulkanParams(bool webglCompat, bool singleIteration, bool e
     return params;
 }
 
+// Forces the Vulkan backend to generate the mipmaps on the CPU, which it otherwise only does for
+// formats it can't blit.  The CPU path is dominated by large arrays and cube maps, hence the
+// layered variants.
+GenerateMipmapParams VulkanCPUParams(bool singleIteration,
+                                     GLenum internalFormat,
+                                     GLsizei layerCount)
+{
+    GenerateMipmapParams params = VulkanParams(false, singleIteration, false);
+    params.internalFormat       = internalFormat;
+    params.layerCount           = layerCount;
+    params.cpu                  = true;
+    params.eglParameters.enable(Feature::ForceGenerateMipmapOnCPU);
+    return params;
+}
+
 }  // anonymous namespace
 
 TEST_P(GenerateMipmapBenchmark, Run)
@@ -356,7 +405,10 @@ ANGLE_INSTANTIATE_TEST(GenerateMipmapBenchmark,
                        VulkanParams(false, false, false),
                        VulkanParams(true, false, false),
                        VulkanParams(false, false, true),
-                       VulkanParams(true, false, true));
+                       VulkanParams(true, false, true),
+                       VulkanCPUParams(false, GL_RGBA, 1),
+                       VulkanCPUParams(false, GL_RGBA, 6),
+                       VulkanCPUParams(false, GL_RGB, 1));
 
 ANGLE_INSTANTIATE_TEST(GenerateMipmapWithRedefineBenchmark,
                        D3D11Params(false, true),
@@ -368,4 +420,6 @@ ANGLE_INSTANTIATE_TEST(GenerateMipmapWithRedefineBenchmark,
                        VulkanParams(false, true, false),
                        VulkanParams(true, true, false),
                        VulkanParams(false, true, true),
-                       VulkanParams(true, true, true));
+                       VulkanParams(true, true, true),
+                       VulkanCPUParams(true, GL_RGBA, 1),
+                       VulkanCPUParams(true, GL_RGBA, 6));
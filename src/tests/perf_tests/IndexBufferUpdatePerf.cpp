@@ -0,0 +1,200 @@
+//
+// Copyright 2024 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// IndexBufferUpdatePerf:
+//   Performance test for draws that need the range of a large index buffer that is partially
+//   updated between draws, as done by applications streaming part of their geometry each frame.
+//
+
+#include "ANGLEPerfTest.h"
+
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include "test_utils/draw_call_perf_utils.h"
+
+using namespace angle;
+
+namespace
+{
+constexpr unsigned int kIterationsPerStep = 10;
+
+// Indices refer to a small client-side vertex array, so the draws need the index range while the
+// vertex data to stream stays small.
+constexpr GLsizei kVertexCount = 1024;
+
+struct IndexBufferUpdateParams final : public RenderTestParams
+{
+    IndexBufferUpdateParams()
+    {
+        majorVersion      = 3;
+        minorVersion      = 0;
+        iterationsPerStep = kIterationsPerStep;
+    }
+
+    std::string story() const override;
+
+    GLenum indexType       = GL_UNSIGNED_SHORT;
+    GLsizeiptr bufferSize  = 4 * 1024 * 1024;
+    GLsizei drawIndexCount = 256 * 1024;
+    // Bytes written with glBufferSubData before each draw.  Zero to only draw.
+    GLsizeiptr updateSize = 256;
+};
+
+std::string IndexBufferUpdateParams::story() const
+{
+    std::stringstream strstr;
+
+    strstr << RenderTestParams::story();
+    strstr << (indexType == GL_UNSIGNED_SHORT ? "_ushort" : "_uint");
+    if (updateSize > 0)
+    {
+        strstr << "_update_" << updateSize;
+    }
+    else
+    {
+        strstr << "_no_update";
+    }
+
+    return strstr.str();
+}
+
+std::ostream &operator<<(std::ostream &os, const IndexBufferUpdateParams &params)
+{
+    os << params.backendAndStory().substr(1);
+    return os;
+}
+
+class IndexBufferUpdateBenchmark : public ANGLERenderTest,
+                                   public ::testing::WithParamInterface<IndexBufferUpdateParams>
+{
+  public:
+    IndexBufferUpdateBenchmark();
+
+    void initializeBenchmark() override;
+    void destroyBenchmark() override;
+    void drawBenchmark() override;
+
+  private:
+    GLuint mProgram     = 0;
+    GLuint mIndexBuffer = 0;
+    size_t mIndexSize   = 0;
+    std::vector<GLfloat> mVertexData;
+    std::vector<uint8_t> mUpdateData;
+    std::mt19937 mRNG;
+};
+
+IndexBufferUpdateBenchmark::IndexBufferUpdateBenchmark()
+    : ANGLERenderTest("IndexBufferUpdatePerf", GetParam())
+{}
+
+void IndexBufferUpdateBenchmark::initializeBenchmark()
+{
+    const IndexBufferUpdateParams &params = GetParam();
+
+    mProgram = SetupSimpleDrawProgram();
+    ASSERT_NE(0u, mProgram);
+
+    mIndexSize = params.indexType == GL_UNSIGNED_SHORT ? sizeof(GLushort) : sizeof(GLuint);
+    ASSERT_LE(static_cast<GLsizeiptr>(params.drawIndexCount * mIndexSize), params.bufferSize);
+
+    // Degenerate triangles, so the cost of the draws is in the index handling.
+    mVertexData.resize(kVertexCount * 2, 0.0f);
+
+    std::vector<uint8_t> indexData(params.bufferSize);
+    for (size_t offset = 0; offset < indexData.size(); offset += mIndexSize)
+    {
+        const GLuint index = mRNG() % kVertexCount;
+        memcpy(indexData.data() + offset, &index, mIndexSize);
+    }
+
+    mUpdateData.assign(indexData.begin(), indexData.begin() + params.updateSize);
+
+    glGenBuffers(1, &mIndexBuffer);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mIndexBuffer);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, params.bufferSize, indexData.data(), GL_DYNAMIC_DRAW);
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, mVertexData.data());
+    glEnableVertexAttribArray(0);
+
+    glViewport(0, 0, getWindow()->getWidth(), getWindow()->getHeight());
+
+    ASSERT_GL_NO_ERROR();
+}
+
+void IndexBufferUpdateBenchmark::destroyBenchmark()
+{
+    glDeleteProgram(mProgram);
+    glDeleteBuffers(1, &mIndexBuffer);
+}
+
+void IndexBufferUpdateBenchmark::drawBenchmark()
+{
+    const IndexBufferUpdateParams &params = GetParam();
+
+    const size_t bufferIndexCount = params.bufferSize / mIndexSize;
+    const size_t updateIndexCount = params.updateSize / mIndexSize;
+
+    for (unsigned int iteration = 0; iteration < params.iterationsPerStep; ++iteration)
+    {
+        if (params.updateSize > 0)
+        {
+            const size_t updateIndex = mRNG() % (bufferIndexCount - updateIndexCount + 1);
+            glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, updateIndex * mIndexSize, params.updateSize,
+                            mUpdateData.data());
+        }
+
+        const size_t drawIndex = mRNG() % (bufferIndexCount - params.drawIndexCount + 1);
+        glDrawElements(GL_TRIANGLES, params.drawIndexCount, params.indexType,
+                       reinterpret_cast<const void *>(drawIndex * mIndexSize));
+    }
+
+    ASSERT_GL_NO_ERROR();
+}
+
+IndexBufferUpdateParams IndexBufferUpdateVulkanParams(GLenum indexType, GLsizeiptr updateSize)
+{
+    IndexBufferUpdateParams params;
+    params.eglParameters = egl_platform::VULKAN();
+    params.indexType     = indexType;
+    params.updateSize    = updateSize;
+    return params;
+}
+
+IndexBufferUpdateParams IndexBufferUpdateVulkanNullParams(GLenum indexType, GLsizeiptr updateSize)
+{
+    IndexBufferUpdateParams params = IndexBufferUpdateVulkanParams(indexType, updateSize);
+    params.eglParameters           = egl_platform::VULKAN_NULL();
+    return params;
+}
+
+IndexBufferUpdateParams IndexBufferUpdateOpenGLOrGLESParams(GLenum indexType,
+                                                            GLsizeiptr updateSize)
+{
+    IndexBufferUpdateParams params = IndexBufferUpdateVulkanParams(indexType, updateSize);
+    params.eglParameters           = egl_platform::OPENGL_OR_GLES();
+    return params;
+}
+
+// Measures glBufferSubData of a small part of a large index buffer followed by a draw at a random
+// offset that needs the index range.  Only the modified part of the buffer should be rescanned.
+TEST_P(IndexBufferUpdateBenchmark, Run)
+{
+    run();
+}
+
+ANGLE_INSTANTIATE_TEST(IndexBufferUpdateBenchmark,
+                       IndexBufferUpdateOpenGLOrGLESParams(GL_UNSIGNED_SHORT, 256),
+                       IndexBufferUpdateVulkanParams(GL_UNSIGNED_SHORT, 0),
+                       IndexBufferUpdateVulkanParams(GL_UNSIGNED_SHORT, 256),
+                       IndexBufferUpdateVulkanParams(GL_UNSIGNED_INT, 256),
+                       IndexBufferUpdateVulkanParams(GL_UNSIGNED_SHORT, 64 * 1024),
+                       IndexBufferUpdateVulkanNullParams(GL_UNSIGNED_SHORT, 0),
+                       IndexBufferUpdateVulkanNullParams(GL_UNSIGNED_SHORT, 256),
+                       IndexBufferUpdateVulkanNullParams(GL_UNSIGNED_INT, 256));
+
+}  // namespace
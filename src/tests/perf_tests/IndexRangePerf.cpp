@@ -0,0 +1,171 @@
+//
+// Copyright 2024 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// IndexRangePerf:
+//   Performance test for computing the range of client-side and uncached index data.
+//
+
+#include "ANGLEPerfTest.h"
+
+#include <random>
+
+#include "common/index_range_utils.h"
+#include "common/utilities.h"
+#include "libANGLE/formatutils.h"
+
+using namespace testing;
+
+namespace
+{
+struct IndexRangeParams
+{
+    gl::DrawElementsType indexType;
+    size_t indexCount;
+    bool primitiveRestartEnabled;
+    // If false, uses the scalar kernel as a baseline.
+    bool vectorized;
+};
+
+std::ostream &operator<<(std::ostream &os, const IndexRangeParams &params)
+{
+    switch (params.indexType)
+    {
+        case gl::DrawElementsType::UnsignedByte:
+            os << "ubyte";
+            break;
+        case gl::DrawElementsType::UnsignedShort:
+            os << "ushort";
+            break;
+        case gl::DrawElementsType::UnsignedInt:
+            os << "uint";
+            break;
+        default:
+            UNREACHABLE();
+    }
+
+    os << "_" << params.indexCount;
+    if (params.primitiveRestartEnabled)
+    {
+        os << "_restart";
+    }
+    os << (params.vectorized ? "_vectorized" : "_scalar");
+    return os;
+}
+
+// Roughly the same number of indices is processed in each step regardless of the index count.
+constexpr size_t kIndicesPerStep = 16 * 1024 * 1024;
+
+size_t GetIterationsPerStep(size_t indexCount)
+{
+    return std::max<size_t>(1, kIndicesPerStep / indexCount);
+}
+
+class IndexRangePerfTest : public ANGLEPerfTest, public WithParamInterface<IndexRangeParams>
+{
+  public:
+    IndexRangePerfTest();
+
+    void SetUp() override;
+    void step() override;
+
+    std::string getName();
+
+  private:
+    gl::IndexRangeKernel mKernel;
+    size_t mIterationsPerStep;
+    std::vector<uint8_t> mIndexData;
+};
+
+IndexRangePerfTest::IndexRangePerfTest()
+    : ANGLEPerfTest(getName(),
+                    "",
+                    "_run",
+                    static_cast<unsigned int>(GetIterationsPerStep(GetParam().indexCount)),
+                    "us"),
+      mKernel(GetParam().vectorized ? gl::GetPreferredIndexRangeKernel()
+                                    : gl::IndexRangeKernel::Scalar),
+      mIterationsPerStep(GetIterationsPerStep(GetParam().indexCount))
+{}
+
+void IndexRangePerfTest::SetUp()
+{
+    ANGLEPerfTest::SetUp();
+
+    const IndexRangeParams &params = GetParam();
+    if (params.vectorized && mKernel == gl::IndexRangeKernel::Scalar)
+    {
+        skipTest("No vectorized kernel available on this CPU");
+        return;
+    }
+
+    // Random indices into a vertex buffer of a plausible size, with a primitive restart roughly
+    // every 16 indices.
+    const size_t indexSize    = gl::GetDrawElementsTypeSize(params.indexType);
+    const GLuint restartIndex = gl::GetPrimitiveRestartIndex(params.indexType);
+    const uint32_t maxIndex   = std::min<uint32_t>(restartIndex - 1, 65535);
+
+    std::mt19937 rng(0);
+    mIndexData.resize(params.indexCount * indexSize);
+    for (size_t i = 0; i < params.indexCount; ++i)
+    {
+        const uint32_t index = rng() % 16 == 0 ? restartIndex : rng() % (maxIndex + 1);
+        memcpy(mIndexData.data() + i * indexSize, &index, indexSize);
+    }
+}
+
+void IndexRangePerfTest::step()
+{
+    const IndexRangeParams &params = GetParam();
+
+    size_t sum = 0;
+    for (size_t iteration = 0; iteration < mIterationsPerStep; ++iteration)
+    {
+        const gl::IndexRange range =
+            gl::ComputeIndexRangeWithKernel(mKernel, params.indexType, mIndexData.data(),
+                                            params.indexCount, params.primitiveRestartEnabled);
+        sum += range.end;
+    }
+    ANGLE_UNUSED_VARIABLE(sum);
+}
+
+std::string IndexRangePerfTest::getName()
+{
+    std::stringstream ss;
+    ss << UnitTest::GetInstance()->current_test_suite()->name() << "/" << GetParam();
+    return ss.str();
+}
+
+// Measures the time to compute the range of index data, as done on draws with client-side
+// indices and on index range cache misses.
+TEST_P(IndexRangePerfTest, Run)
+{
+    run();
+}
+
+std::vector<IndexRangeParams> IndexRangeTestParams()
+{
+    std::vector<IndexRangeParams> params;
+    for (gl::DrawElementsType indexType :
+         {gl::DrawElementsType::UnsignedByte, gl::DrawElementsType::UnsignedShort,
+          gl::DrawElementsType::UnsignedInt})
+    {
+        for (size_t indexCount : {64, 4 * 1024, 256 * 1024, 16 * 1024 * 1024})
+        {
+            for (bool primitiveRestartEnabled : {false, true})
+            {
+                params.push_back({indexType, indexCount, primitiveRestartEnabled, false});
+                params.push_back({indexType, indexCount, primitiveRestartEnabled, true});
+            }
+        }
+    }
+    return params;
+}
+
+INSTANTIATE_TEST_SUITE_P(,
+                         IndexRangePerfTest,
+                         ValuesIn(IndexRangeTestParams()),
+                         PrintToStringParamName());
+
+}  // anonymous namespace
@@ -4,12 +4,14 @@
 // found in the LICENSE file.
 //
 // LinkProgramPerfTest:
-//   Performance tests compiling a lot of shaders.
+//   Performance tests compiling a lot of shaders, and loading linked programs from the program
+//   cache.
 //
 
 #include "ANGLEPerfTest.h"
 
 #include <array>
+#include <vector>
 
 #include "common/vector_utils.h"
 #include "util/shader_utils.h"
@@ -23,6 +25,8 @@ enum class TaskOption
 {
     CompileOnly,
     CompileAndLink,
+    // Links programs whose binaries are already in the program cache, so every link is a load.
+    LoadFromCache,
 
     Unspecified
 };
@@ -62,6 +66,10 @@ struct LinkProgramParams final : public RenderTestParams
         {
             strstr << "_compile_and_link";
         }
+        else if (taskOption == TaskOption::LoadFromCache)
+        {
+            strstr << "_load_from_cache";
+        }
 
         if (threadOption == ThreadOption::SingleThread)
         {
@@ -72,6 +80,11 @@ struct LinkProgramParams final : public RenderTestParams
             strstr << "_multi_thread";
         }
 
+        if (uncompressedBlobCache)
+        {
+            strstr << "_uncompressed_cache";
+        }
+
         if (eglParameters.deviceType == EGL_PLATFORM_ANGLE_DEVICE_TYPE_NULL_ANGLE)
         {
             strstr << "_null";
@@ -82,6 +95,7 @@ struct LinkProgramParams final : public RenderTestParams
 
     TaskOption taskOption;
     ThreadOption threadOption;
+    bool uncompressedBlobCache = false;
 };
 
 std::ostream &operator<<(std::ostream &os, const LinkProgramParams &params)
@@ -101,9 +115,19 @@ class LinkProgramBenchmark : public ANGLERenderTest,
     void drawBenchmark() override;
 
   protected:
+    void initializeCachedPrograms();
+    void loadCachedPrograms();
+
     GLuint mVertexBuffer = 0;
+
+    // Shaders of the programs that are placed in the program cache for LoadFromCache.
+    GLuint mCachedVertexShader = 0;
+    std::vector<GLuint> mCachedFragmentShaders;
 };
 
+// Number of distinct programs loaded from the cache in each step of LoadFromCache.
+constexpr size_t kCachedProgramCount = 64;
+
 LinkProgramBenchmark::LinkProgramBenchmark() : ANGLERenderTest("LinkProgram", GetParam()) {}
 
 void LinkProgramBenchmark::initializeBenchmark()
@@ -129,15 +153,92 @@ void LinkProgramBenchmark::initializeBenchmark()
     glBindBuffer(GL_ARRAY_BUFFER, mVertexBuffer);
     glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vector3), vertices.data(),
                  GL_STATIC_DRAW);
+
+    if (GetParam().taskOption == TaskOption::LoadFromCache)
+    {
+        initializeCachedPrograms();
+    }
+}
+
+void LinkProgramBenchmark::initializeCachedPrograms()
+{
+    static const char *vertexShader =
+        "attribute vec2 position;\n"
+        "uniform mat4 transform;\n"
+        "varying vec2 texCoord;\n"
+        "void main() {\n"
+        "    texCoord = position * 0.5 + 0.5;\n"
+        "    gl_Position = transform * vec4(position, 0, 1);\n"
+        "}";
+
+    mCachedVertexShader = CompileShader(GL_VERTEX_SHADER, vertexShader);
+    ASSERT_NE(0u, mCachedVertexShader);
+
+    // Each program gets a different fragment shader so that it has its own cache entry.
+    for (size_t programIndex = 0; programIndex < kCachedProgramCount; ++programIndex)
+    {
+        std::stringstream fragmentShader;
+        fragmentShader << "precision mediump float;\n"
+                          "uniform sampler2D tex;\n"
+                          "uniform vec4 tint["
+                       << (programIndex % 8 + 1)
+                       << "];\n"
+                          "varying vec2 texCoord;\n"
+                          "void main() {\n"
+                          "    gl_FragColor = texture2D(tex, texCoord) * tint["
+                       << (programIndex % 8) << "] * " << programIndex + 1
+                       << ".0;\n"
+                          "}";
+
+        GLuint shader = CompileShader(GL_FRAGMENT_SHADER, fragmentShader.str().c_str());
+        ASSERT_NE(0u, shader);
+        mCachedFragmentShaders.push_back(shader);
+    }
+
+    // Link every program once to place it in the program cache.
+    loadCachedPrograms();
+}
+
+void LinkProgramBenchmark::loadCachedPrograms()
+{
+    // Every program is a new object, so nothing but the program cache is reused between steps.
+    for (GLuint fragmentShader : mCachedFragmentShaders)
+    {
+        GLuint program = glCreateProgram();
+        ASSERT_NE(0u, program);
+
+        glAttachShader(program, mCachedVertexShader);
+        glAttachShader(program, fragmentShader);
+        glLinkProgram(program);
+
+        GLint linkStatus = GL_FALSE;
+        glGetProgramiv(program, GL_LINK_STATUS, &linkStatus);
+        ASSERT_EQ(GL_TRUE, linkStatus);
+
+        glDeleteProgram(program);
+    }
 }
 
 void LinkProgramBenchmark::destroyBenchmark()
 {
     glDeleteBuffers(1, &mVertexBuffer);
+
+    glDeleteShader(mCachedVertexShader);
+    for (GLuint shader : mCachedFragmentShaders)
+    {
+        glDeleteShader(shader);
+    }
+    mCachedFragmentShaders.clear();
 }
 
 void LinkProgramBenchmark::drawBenchmark()
 {
+    if (GetParam().taskOption == TaskOption::LoadFromCache)
+    {
+        loadCachedPrograms();
+        return;
+    }
+
     static const char *vertexShader =
         "attribute vec2 position;\n"
         "void main() {\n"
@@ -210,6 +311,14 @@ LinkProgramParams LinkProgramVulkanParams(TaskOption taskOption, ThreadOption th
     return params;
 }
 
+// Stores the program cache uncompressed, so cached programs are loaded in place.
+LinkProgramParams UncompressedBlobCache(LinkProgramParams params)
+{
+    params.eglParameters.enable(Feature::DisableBlobCacheCompression);
+    params.uncompressedBlobCache = true;
+    return params;
+}
+
 TEST_P(LinkProgramBenchmark, Run)
 {
     run();
@@ -232,6 +341,14 @@ ANGLE_INSTANTIATE_TEST(
     LinkProgramD3D11Params(TaskOption::CompileAndLink, ThreadOption::SingleThread),
     LinkProgramMetalParams(TaskOption::CompileAndLink, ThreadOption::SingleThread),
     LinkProgramOpenGLOrGLESParams(TaskOption::CompileAndLink, ThreadOption::SingleThread),
-    LinkProgramVulkanParams(TaskOption::CompileAndLink, ThreadOption::SingleThread));
+    LinkProgramVulkanParams(TaskOption::CompileAndLink, ThreadOption::SingleThread),
+    LinkProgramD3D11Params(TaskOption::LoadFromCache, ThreadOption::SingleThread),
+    LinkProgramMetalParams(TaskOption::LoadFromCache, ThreadOption::SingleThread),
+    LinkProgramOpenGLOrGLESParams(TaskOption::LoadFromCache, ThreadOption::SingleThread),
+    LinkProgramVulkanParams(TaskOption::LoadFromCache, ThreadOption::SingleThread),
+    UncompressedBlobCache(
+        LinkProgramOpenGLOrGLESParams(TaskOption::LoadFromCache, ThreadOption::SingleThread)),
+    UncompressedBlobCache(
+        LinkProgramVulkanParams(TaskOption::LoadFromCache, ThreadOption::SingleThread)));
 
 }  // anonymous namespace
@@ -10,6 +10,7 @@
 #include "ANGLEPerfTest.h"
 
 #include <array>
+#include <thread>
 
 #include "common/vector_utils.h"
 #include "util/shader_utils.h"
@@ -45,6 +46,7 @@ struct ParallelLinkProgramParams final : public RenderTestParams
         windowWidth      = 256;
         windowHeight     = 256;
         compileLinkOrder = order;
+        threadCount      = 1;
     }
 
     std::string story() const override
@@ -78,10 +80,18 @@ struct ParallelLinkProgramParams final : public RenderTestParams
             strstr << "_null";
         }
 
+        if (threadCount > 1)
+        {
+            strstr << "_" << threadCount << "_threads";
+        }
+
         return strstr.str();
     }
 
     CompileLinkOrder compileLinkOrder;
+    // If more than one, each thread compiles and links the same programs in its own context, so
+    // all but the first step mostly measure concurrent lookups in the program and shader caches.
+    uint32_t threadCount;
 };
 
 std::ostream &operator<<(std::ostream &os, const ParallelLinkProgramParams &params)
@@ -111,7 +121,19 @@ class ParallelLinkProgramBenchmark : public ANGLERenderTest,
         GLuint program;
     };
 
+    // The programs and context of a thread, when the test uses more than one.
+    struct ThreadContext
+    {
+        EGLContext context;
+        std::vector<Program> programs;
+    };
+
+    void createPrograms(std::vector<Program> *programs);
+    void deletePrograms(std::vector<Program> *programs);
+    void compileAndLinkPrograms(std::vector<Program> *programs);
+
     std::vector<Program> mPrograms;
+    std::vector<ThreadContext> mThreadContexts;
 };
 
 ParallelLinkProgramBenchmark::ParallelLinkProgramBenchmark()
@@ -208,54 +230,129 @@ void main()
     color2 = res;
 })";
         mPrograms[i].fragmentShader = fs.str();
+    }
 
-        mPrograms[i].vs      = glCreateShader(GL_VERTEX_SHADER);
-        mPrograms[i].fs      = glCreateShader(GL_FRAGMENT_SHADER);
-        mPrograms[i].program = glCreateProgram();
+    createPrograms(&mPrograms);
+    ASSERT_GL_NO_ERROR();
 
-        const char *vsCStr = mPrograms[i].vertexShader.c_str();
-        const char *fsCStr = mPrograms[i].fragmentShader.c_str();
-        glShaderSource(mPrograms[i].vs, 1, &vsCStr, 0);
-        glShaderSource(mPrograms[i].fs, 1, &fsCStr, 0);
+    if (params.threadCount <= 1)
+    {
+        return;
+    }
 
-        glAttachShader(mPrograms[i].program, mPrograms[i].vs);
-        glAttachShader(mPrograms[i].program, mPrograms[i].fs);
+    // Each thread gets its own context, not shared with the others, with the same programs.
+    EGLDisplay display         = eglGetCurrentDisplay();
+    EGLContext mainContext     = eglGetCurrentContext();
+    EGLSurface mainDrawSurface = eglGetCurrentSurface(EGL_DRAW);
+    EGLSurface mainReadSurface = eglGetCurrentSurface(EGL_READ);
+
+    const char *extensions = eglQueryString(display, EGL_EXTENSIONS);
+    if (extensions == nullptr || strstr(extensions, "EGL_KHR_surfaceless_context") == nullptr)
+    {
+        skipTest("EGL_KHR_surfaceless_context is needed to run on multiple threads");
+        return;
     }
 
-    ASSERT_GL_NO_ERROR();
+    EGLint configID = 0;
+    EGLConfig config;
+    EGLint configCount = 0;
+    ASSERT_TRUE(eglQueryContext(display, mainContext, EGL_CONFIG_ID, &configID));
+    const EGLint configAttribs[] = {EGL_CONFIG_ID, configID, EGL_NONE};
+    ASSERT_TRUE(eglChooseConfig(display, configAttribs, &config, 1, &configCount));
+
+    const EGLint contextAttribs[] = {EGL_CONTEXT_MAJOR_VERSION,
+                                     static_cast<EGLint>(params.majorVersion),
+                                     EGL_CONTEXT_MINOR_VERSION,
+                                     static_cast<EGLint>(params.minorVersion), EGL_NONE};
+
+    mThreadContexts.resize(params.threadCount);
+    for (ThreadContext &threadContext : mThreadContexts)
+    {
+        threadContext.context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttribs);
+        ASSERT_NE(EGL_NO_CONTEXT, threadContext.context);
+        ASSERT_TRUE(eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, threadContext.context));
+
+        threadContext.programs = mPrograms;
+        createPrograms(&threadContext.programs);
+        ASSERT_GL_NO_ERROR();
+    }
+
+    // The contexts are made current on their threads during the test.
+    ASSERT_TRUE(eglMakeCurrent(display, mainDrawSurface, mainReadSurface, mainContext));
 }
 
 void ParallelLinkProgramBenchmark::destroyBenchmark()
 {
-    const ParallelLinkProgramParams &params = GetParam();
+    deletePrograms(&mPrograms);
 
-    for (uint32_t i = 0; i < params.iterationsPerStep; ++i)
+    if (mThreadContexts.empty())
     {
-        glDetachShader(mPrograms[i].program, mPrograms[i].vs);
-        glDetachShader(mPrograms[i].program, mPrograms[i].fs);
-        glDeleteShader(mPrograms[i].vs);
-        glDeleteShader(mPrograms[i].fs);
-        glDeleteProgram(mPrograms[i].program);
+        return;
     }
+
+    EGLDisplay display         = eglGetCurrentDisplay();
+    EGLContext mainContext     = eglGetCurrentContext();
+    EGLSurface mainDrawSurface = eglGetCurrentSurface(EGL_DRAW);
+    EGLSurface mainReadSurface = eglGetCurrentSurface(EGL_READ);
+
+    for (ThreadContext &threadContext : mThreadContexts)
+    {
+        eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, threadContext.context);
+        deletePrograms(&threadContext.programs);
+        eglDestroyContext(display, threadContext.context);
+    }
+
+    eglMakeCurrent(display, mainDrawSurface, mainReadSurface, mainContext);
 }
 
-void ParallelLinkProgramBenchmark::drawBenchmark()
+void ParallelLinkProgramBenchmark::createPrograms(std::vector<Program> *programs)
+{
+    for (Program &program : *programs)
+    {
+        program.vs      = glCreateShader(GL_VERTEX_SHADER);
+        program.fs      = glCreateShader(GL_FRAGMENT_SHADER);
+        program.program = glCreateProgram();
+
+        const char *vsCStr = program.vertexShader.c_str();
+        const char *fsCStr = program.fragmentShader.c_str();
+        glShaderSource(program.vs, 1, &vsCStr, 0);
+        glShaderSource(program.fs, 1, &fsCStr, 0);
+
+        glAttachShader(program.program, program.vs);
+        glAttachShader(program.program, program.fs);
+    }
+}
+
+void ParallelLinkProgramBenchmark::deletePrograms(std::vector<Program> *programs)
+{
+    for (Program &program : *programs)
+    {
+        glDetachShader(program.program, program.vs);
+        glDetachShader(program.program, program.fs);
+        glDeleteShader(program.vs);
+        glDeleteShader(program.fs);
+        glDeleteProgram(program.program);
+    }
+}
+
+void ParallelLinkProgramBenchmark::compileAndLinkPrograms(std::vector<Program> *programs)
 {
     const ParallelLinkProgramParams &params = GetParam();
+    std::vector<Program> &progs             = *programs;
 
     for (uint32_t i = 0; i < params.iterationsPerStep; ++i)
     {
         // Compile the shaders, and if interleaved, link the corresponding programs.
-        glCompileShader(mPrograms[i].vs);
-        glCompileShader(mPrograms[i].fs);
+        glCompileShader(progs[i].vs);
+        glCompileShader(progs[i].fs);
         if (params.compileLinkOrder != CompileLinkOrder::AllCompilesFirst)
         {
-            glLinkProgram(mPrograms[i].program);
+            glLinkProgram(progs[i].program);
 
             if (params.compileLinkOrder == CompileLinkOrder::InterleavedAndImmediateQuery)
             {
                 GLint linkStatus = GL_TRUE;
-                glGetProgramiv(mPrograms[i].program, GL_LINK_STATUS, &linkStatus);
+                glGetProgramiv(progs[i].program, GL_LINK_STATUS, &linkStatus);
                 EXPECT_TRUE(linkStatus) << i;
             }
         }
@@ -266,7 +363,7 @@ void ParallelLinkProgramBenchmark::drawBenchmark()
     {
         for (uint32_t i = 0; i < params.iterationsPerStep; ++i)
         {
-            glLinkProgram(mPrograms[i].program);
+            glLinkProgram(progs[i].program);
         }
     }
 
@@ -274,13 +371,13 @@ void ParallelLinkProgramBenchmark::drawBenchmark()
     for (uint32_t i = 0; i < params.iterationsPerStep; ++i)
     {
         GLint compileResult;
-        glGetShaderiv(mPrograms[i].vs, GL_COMPILE_STATUS, &compileResult);
+        glGetShaderiv(progs[i].vs, GL_COMPILE_STATUS, &compileResult);
         EXPECT_NE(compileResult, 0) << i;
-        glGetShaderiv(mPrograms[i].fs, GL_COMPILE_STATUS, &compileResult);
+        glGetShaderiv(progs[i].fs, GL_COMPILE_STATUS, &compileResult);
         EXPECT_NE(compileResult, 0) << i;
 
         GLint linkStatus = GL_TRUE;
-        glGetProgramiv(mPrograms[i].program, GL_LINK_STATUS, &linkStatus);
+        glGetProgramiv(progs[i].program, GL_LINK_STATUS, &linkStatus);
         EXPECT_TRUE(linkStatus) << i;
     }
 
@@ -288,10 +385,36 @@ void ParallelLinkProgramBenchmark::drawBenchmark()
     // those are all finished by triggerring a wait on the jobs of the last program.  Currently,
     // detaching and attaching shaders does that (among other operations).
     const uint32_t last = params.iterationsPerStep - 1;
-    glDetachShader(mPrograms[last].program, mPrograms[last].vs);
-    glAttachShader(mPrograms[last].program, mPrograms[last].vs);
+    glDetachShader(progs[last].program, progs[last].vs);
+    glAttachShader(progs[last].program, progs[last].vs);
+}
 
-    ASSERT_GL_NO_ERROR();
+void ParallelLinkProgramBenchmark::drawBenchmark()
+{
+    if (mThreadContexts.empty())
+    {
+        compileAndLinkPrograms(&mPrograms);
+        ASSERT_GL_NO_ERROR();
+        return;
+    }
+
+    EGLDisplay display = eglGetCurrentDisplay();
+
+    std::vector<std::thread> threads;
+    for (ThreadContext &threadContext : mThreadContexts)
+    {
+        threads.emplace_back([this, display, &threadContext]() {
+            ASSERT_TRUE(
+                eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, threadContext.context));
+            compileAndLinkPrograms(&threadContext.programs);
+            ASSERT_GL_NO_ERROR();
+            eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        });
+    }
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
 }
 
 using namespace egl_platform;
@@ -325,6 +448,14 @@ ParallelLinkProgramParams ParallelLinkProgramVulkanParams(CompileLinkOrder compi
     return params;
 }
 
+ParallelLinkProgramParams MultithreadedLinkProgramVulkanParams(CompileLinkOrder compileLinkOrder,
+                                                              uint32_t threadCount)
+{
+    ParallelLinkProgramParams params = ParallelLinkProgramVulkanParams(compileLinkOrder);
+    params.threadCount               = threadCount;
+    return params;
+}
+
 ParallelLinkProgramParams SerialLinkProgramVulkanParams(CompileLinkOrder compileLinkOrder)
 {
     ParallelLinkProgramParams params(compileLinkOrder);
@@ -352,6 +483,10 @@ ANGLE_INSTANTIATE_TEST(
     ParallelLinkProgramVulkanParams(CompileLinkOrder::InterleavedAndImmediateQuery),
     SerialLinkProgramVulkanParams(CompileLinkOrder::AllCompilesFirst),
     SerialLinkProgramVulkanParams(CompileLinkOrder::Interleaved),
-    SerialLinkProgramVulkanParams(CompileLinkOrder::InterleavedAndImmediateQuery));
+    SerialLinkProgramVulkanParams(CompileLinkOrder::InterleavedAndImmediateQuery),
+    MultithreadedLinkProgramVulkanParams(CompileLinkOrder::Interleaved, 2),
+    MultithreadedLinkProgramVulkanParams(CompileLinkOrder::Interleaved, 4),
+    MultithreadedLinkProgramVulkanParams(CompileLinkOrder::Interleaved, 8),
+    MultithreadedLinkProgramVulkanParams(CompileLinkOrder::Interleaved, 16));
 
 }  // anonymous namespace
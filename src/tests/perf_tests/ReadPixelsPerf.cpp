@@ -0,0 +1,168 @@
+//
+// Copyright 2024 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// ReadPixelsPerf:
+//   Performance test for the CPU side of glReadPixels, which converts the pixels read back from
+//   the GPU to the format requested by the application.
+//
+
+#include "ANGLEPerfTest.h"
+
+#include <random>
+
+#include "common/system_utils.h"
+#include "libANGLE/renderer/Format.h"
+#include "libANGLE/renderer/renderer_utils.h"
+
+using namespace testing;
+
+namespace
+{
+struct FormatPair
+{
+    const char *name;
+    angle::FormatID sourceFormat;
+    angle::FormatID destFormat;
+};
+
+// The last pair has no specialized conversion and measures the generic path.
+constexpr FormatPair kFormatPairs[] = {
+    {"BGRA8_to_RGBA8", angle::FormatID::B8G8R8A8_UNORM, angle::FormatID::R8G8B8A8_UNORM},
+    {"RGBA8_to_BGRA8", angle::FormatID::R8G8B8A8_UNORM, angle::FormatID::B8G8R8A8_UNORM},
+    {"BGRX8_to_RGBA8", angle::FormatID::B8G8R8X8_UNORM, angle::FormatID::R8G8B8A8_UNORM},
+    {"RGB565_to_RGBA8", angle::FormatID::R5G6B5_UNORM, angle::FormatID::R8G8B8A8_UNORM},
+    {"RGBA8_to_RGB565", angle::FormatID::R8G8B8A8_UNORM, angle::FormatID::R5G6B5_UNORM},
+    {"RGBA16F_to_RGBA32F", angle::FormatID::R16G16B16A16_FLOAT,
+     angle::FormatID::R32G32B32A32_FLOAT},
+    {"RGB10A2_to_RGBA8", angle::FormatID::R10G10B10A2_UNORM, angle::FormatID::R8G8B8A8_UNORM},
+};
+
+struct ReadPixelsParams
+{
+    size_t formatIndex;
+    int width;
+    int height;
+    bool reverseRowOrder;
+};
+
+std::ostream &operator<<(std::ostream &os, const ReadPixelsParams &params)
+{
+    os << kFormatPairs[params.formatIndex].name << "_" << params.width << "x" << params.height
+       << (params.reverseRowOrder ? "_flipped" : "");
+    return os;
+}
+
+class ReadPixelsPerfTest : public ANGLEPerfTest, public WithParamInterface<ReadPixelsParams>
+{
+  public:
+    ReadPixelsPerfTest();
+
+    void SetUp() override;
+    void step() override;
+    void TearDown() override;
+
+    std::string getName();
+
+  private:
+    std::vector<uint8_t> mSource;
+    std::vector<uint8_t> mDest;
+    int mSourceRowPitch;
+    rx::PackPixelsParams mPackParams;
+
+    double mPackTime;
+    size_t mPackedPixels;
+};
+
+ReadPixelsPerfTest::ReadPixelsPerfTest()
+    : ANGLEPerfTest(getName(), "", "_run", 1, "us"),
+      mSourceRowPitch(0),
+      mPackTime(0),
+      mPackedPixels(0)
+{
+    mReporter->RegisterFyiMetric(".pack_rate", "MPix/s");
+}
+
+void ReadPixelsPerfTest::SetUp()
+{
+    ANGLEPerfTest::SetUp();
+
+    const ReadPixelsParams &params    = GetParam();
+    const FormatPair &formatPair      = kFormatPairs[params.formatIndex];
+    const angle::Format &sourceFormat = angle::Format::Get(formatPair.sourceFormat);
+    const angle::Format &destFormat   = angle::Format::Get(formatPair.destFormat);
+
+    // Random bits, except that half floats are kept finite.
+    mSourceRowPitch = params.width * sourceFormat.pixelBytes;
+    mSource.resize(static_cast<size_t>(mSourceRowPitch) * params.height);
+    std::mt19937 rng(0);
+    for (uint8_t &byte : mSource)
+    {
+        byte = static_cast<uint8_t>(rng()) & (sourceFormat.isFloat() ? 0x3F : 0xFF);
+    }
+
+    const GLuint destRowPitch = params.width * destFormat.pixelBytes;
+    mDest.resize(static_cast<size_t>(destRowPitch) * params.height);
+    mPackParams = rx::PackPixelsParams(gl::Rectangle(0, 0, params.width, params.height),
+                                       destFormat, destRowPitch, params.reverseRowOrder, nullptr,
+                                       0);
+}
+
+void ReadPixelsPerfTest::step()
+{
+    const ReadPixelsParams &params = GetParam();
+    const angle::Format &sourceFormat =
+        angle::Format::Get(kFormatPairs[params.formatIndex].sourceFormat);
+
+    const double startTime = angle::GetCurrentSystemTime();
+    rx::PackPixels(mPackParams, sourceFormat, mSourceRowPitch, mSource.data(), mDest.data());
+    mPackTime += angle::GetCurrentSystemTime() - startTime;
+    mPackedPixels += static_cast<size_t>(params.width) * params.height;
+}
+
+void ReadPixelsPerfTest::TearDown()
+{
+    ANGLEPerfTest::TearDown();
+
+    if (mPackTime > 0)
+    {
+        recordDoubleMetric(".pack_rate", mPackedPixels / mPackTime / 1'000'000.0, "MPix/s");
+    }
+}
+
+std::string ReadPixelsPerfTest::getName()
+{
+    std::stringstream ss;
+    ss << UnitTest::GetInstance()->current_test_suite()->name() << "/" << GetParam();
+    return ss.str();
+}
+
+// Measures the speed of converting read back pixels to the format requested by glReadPixels.
+TEST_P(ReadPixelsPerfTest, Run)
+{
+    run();
+}
+
+std::vector<ReadPixelsParams> ReadPixelsTestParams()
+{
+    std::vector<ReadPixelsParams> params;
+    for (size_t formatIndex = 0; formatIndex < ArraySize(kFormatPairs); ++formatIndex)
+    {
+        // 1080p and 4K.
+        for (int height : {1080, 2160})
+        {
+            const int width = height * 16 / 9;
+            params.push_back({formatIndex, width, height, false});
+            params.push_back({formatIndex, width, height, true});
+        }
+    }
+    return params;
+}
+
+INSTANTIATE_TEST_SUITE_P(,
+                         ReadPixelsPerfTest,
+                         ValuesIn(ReadPixelsTestParams()),
+                         PrintToStringParamName());
+
+}  // anonymous namespace
@@ -0,0 +1,180 @@
+//
+// Copyright 2024 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// ResourceManagerPerf:
+//   Performance test for the handle allocation and lookup done by the resource managers, with
+//   up to a million live objects.
+//
+
+#include "ANGLEPerfTest.h"
+
+#include <random>
+
+#include "libANGLE/HandleAllocator.h"
+#include "libANGLE/ResourceMap.h"
+
+using namespace testing;
+
+namespace
+{
+enum class ResourceManagerOperation
+{
+    // Looks up live handles in a random order, as done by glBind* and the get* methods.
+    Query,
+    // Deletes and creates objects, as done by apps that stream their resources.
+    AllocateAndRelease,
+    // Visits every live object, as done when a context is destroyed or captured.
+    Iterate,
+};
+
+struct ResourceManagerParams
+{
+    ResourceManagerOperation operation;
+    size_t liveObjectCount;
+};
+
+std::ostream &operator<<(std::ostream &os, const ResourceManagerParams &params)
+{
+    switch (params.operation)
+    {
+        case ResourceManagerOperation::Query:
+            os << "query";
+            break;
+        case ResourceManagerOperation::AllocateAndRelease:
+            os << "allocate_and_release";
+            break;
+        case ResourceManagerOperation::Iterate:
+            os << "iterate";
+            break;
+        default:
+            UNREACHABLE();
+    }
+
+    os << "_" << params.liveObjectCount << "_objects";
+    return os;
+}
+
+// The number of objects that are looked up, or deleted and created again, in each step.
+constexpr size_t kOperationsPerStep = 64 * 1024;
+
+class ResourceManagerPerfTest : public ANGLEPerfTest,
+                                public WithParamInterface<ResourceManagerParams>
+{
+  public:
+    ResourceManagerPerfTest();
+    ~ResourceManagerPerfTest() override;
+
+    void SetUp() override;
+    void step() override;
+
+    std::string getName();
+
+  private:
+    gl::HandleAllocator mHandleAllocator;
+    gl::ResourceMap<size_t, GLuint> mResourceMap;
+    std::vector<size_t> mObjects;
+    std::vector<GLuint> mHandles;
+    std::mt19937 mRNG;
+};
+
+ResourceManagerPerfTest::ResourceManagerPerfTest()
+    : ANGLEPerfTest(getName(), "", "_run", 1, "us"), mRNG(0)
+{}
+
+ResourceManagerPerfTest::~ResourceManagerPerfTest()
+{
+    mResourceMap.clear();
+}
+
+void ResourceManagerPerfTest::SetUp()
+{
+    ANGLEPerfTest::SetUp();
+
+    const ResourceManagerParams &params = GetParam();
+
+    mObjects.resize(params.liveObjectCount);
+    mHandles.resize(params.liveObjectCount);
+    for (size_t index = 0; index < params.liveObjectCount; ++index)
+    {
+        mHandles[index] = mHandleAllocator.allocate();
+        mResourceMap.assign(mHandles[index], &mObjects[index]);
+    }
+}
+
+void ResourceManagerPerfTest::step()
+{
+    const ResourceManagerParams &params = GetParam();
+
+    size_t sum = 0;
+    switch (params.operation)
+    {
+        case ResourceManagerOperation::Query:
+            for (size_t operation = 0; operation < kOperationsPerStep; ++operation)
+            {
+                const GLuint handle = mHandles[mRNG() % mHandles.size()];
+                sum += *mResourceMap.query(handle);
+            }
+            break;
+
+        case ResourceManagerOperation::AllocateAndRelease:
+            for (size_t operation = 0; operation < kOperationsPerStep; ++operation)
+            {
+                const size_t index = mRNG() % mHandles.size();
+                size_t *object     = nullptr;
+                mResourceMap.erase(mHandles[index], &object);
+                mHandleAllocator.release(mHandles[index]);
+
+                mHandles[index] = mHandleAllocator.allocate();
+                mResourceMap.assign(mHandles[index], object);
+            }
+            break;
+
+        case ResourceManagerOperation::Iterate:
+            for (const auto &handleAndObject : mResourceMap)
+            {
+                sum += handleAndObject.first;
+            }
+            break;
+
+        default:
+            UNREACHABLE();
+    }
+    ANGLE_UNUSED_VARIABLE(sum);
+}
+
+std::string ResourceManagerPerfTest::getName()
+{
+    std::stringstream ss;
+    ss << UnitTest::GetInstance()->current_test_suite()->name() << "/" << GetParam();
+    return ss.str();
+}
+
+// Measures the cost of looking up, creating and deleting GL object handles.
+TEST_P(ResourceManagerPerfTest, Run)
+{
+    run();
+}
+
+std::vector<ResourceManagerParams> ResourceManagerTestParams()
+{
+    std::vector<ResourceManagerParams> params;
+    for (ResourceManagerOperation operation :
+         {ResourceManagerOperation::Query, ResourceManagerOperation::AllocateAndRelease,
+          ResourceManagerOperation::Iterate})
+    {
+        for (size_t liveObjectCount : {1024, 64 * 1024, 1024 * 1024})
+        {
+            params.push_back({operation, liveObjectCount});
+        }
+    }
+    return params;
+}
+
+INSTANTIATE_TEST_SUITE_P(,
+                         ResourceManagerPerfTest,
+                         ValuesIn(ResourceManagerTestParams()),
+                         PrintToStringParamName());
+
+}  // anonymous namespace
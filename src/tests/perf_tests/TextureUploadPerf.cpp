@@ -13,6 +13,7 @@
 #include <random>
 #include <sstream>
 
+#include "common/system_utils.h"
 #include "media/etc2bc_rgba8.inc"
 #include "test_utils/gl_raii.h"
 #include "util/shader_utils.h"
@@ -22,6 +23,7 @@ using namespace angle;
 namespace
 {
 constexpr unsigned int kIterationsPerStep = 2;
+constexpr GLsizei kAtlasUpdatesPerDraw    = 2048;
 
 struct TextureUploadParams final : public RenderTestParams
 {
@@ -33,7 +35,8 @@ struct TextureUploadParams final : public RenderTestParams
         baseSize     = 1024;
         subImageSize = 64;
 
-        webgl = false;
+        webgl       = false;
+        asyncUpload = false;
     }
 
     std::string story() const override;
@@ -42,6 +45,8 @@ struct TextureUploadParams final : public RenderTestParams
     GLsizei subImageSize;
 
     bool webgl;
+    // Whether the data conversion is moved off the GL thread, see asyncTextureUpload.
+    bool asyncUpload;
 };
 
 std::ostream &operator<<(std::ostream &os, const TextureUploadParams &params)
@@ -61,6 +66,11 @@ std::string TextureUploadParams::story() const
         strstr << "_webgl";
     }
 
+    if (asyncUpload)
+    {
+        strstr << "_async_upload";
+    }
+
     return strstr.str();
 }
 
@@ -116,6 +126,67 @@ class TextureUploadFullMipBenchmark : public TextureUploadBenchmarkBase
     void drawBenchmark() override;
 };
 
+// Uploads many small regions of a texture between draws, as done with glyph caches and other
+// texture atlases.
+class TextureUploadAtlasBenchmark : public TextureUploadBenchmarkBase
+{
+  public:
+    TextureUploadAtlasBenchmark() : TextureUploadBenchmarkBase("TextureUploadAtlas") {}
+
+    void initializeBenchmark() override
+    {
+        TextureUploadBenchmarkBase::initializeBenchmark();
+
+        // A mutable texture, so the updates are staged until the draw.
+        const auto &params = GetParam();
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, params.baseSize, params.baseSize, 0, GL_RGBA,
+                     GL_UNSIGNED_BYTE, nullptr);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    }
+
+    void drawBenchmark() override;
+
+  private:
+    GLsizei mNextTile = 0;
+};
+
+// Uploads RGB data to an RGB8 texture, which is converted to RGBA on most Vulkan devices.  Besides
+// the usual timings, this measures the time spent in the upload calls per MB uploaded, which is the
+// time the application is blocked by the upload.
+class TextureUploadConversionBenchmark : public TextureUploadBenchmarkBase
+{
+  public:
+    TextureUploadConversionBenchmark() : TextureUploadBenchmarkBase("TextureUploadConversion")
+    {
+        mReporter->RegisterFyiMetric(".gl_thread_time_per_mb", "ms");
+    }
+
+    void initializeBenchmark() override
+    {
+        TextureUploadBenchmarkBase::initializeBenchmark();
+
+        const auto &params = GetParam();
+        glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGB8, params.baseSize, params.baseSize);
+    }
+
+    void destroyBenchmark() override
+    {
+        if (mUploadedBytes > 0)
+        {
+            recordDoubleMetric(".gl_thread_time_per_mb",
+                               mUploadTime * 1000.0 / (mUploadedBytes / (1024.0 * 1024.0)), "ms");
+        }
+
+        TextureUploadBenchmarkBase::destroyBenchmark();
+    }
+
+    void drawBenchmark() override;
+
+  private:
+    double mUploadTime      = 0;
+    uint64_t mUploadedBytes = 0;
+};
+
 class PBOSubImageBenchmark : public TextureUploadBenchmarkBase
 {
   public:
@@ -403,6 +474,55 @@ void TextureUploadFullMipBenchmark::drawBenchmark()
     ASSERT_GL_NO_ERROR();
 }
 
+void TextureUploadAtlasBenchmark::drawBenchmark()
+{
+    const auto &params        = GetParam();
+    const GLsizei tilesPerRow = params.baseSize / params.subImageSize;
+    const GLsizei tileCount   = tilesPerRow * tilesPerRow;
+
+    startGpuTimer();
+    for (unsigned int iteration = 0; iteration < params.iterationsPerStep; ++iteration)
+    {
+        // Each update is to a different tile of the texture.
+        for (GLsizei update = 0; update < kAtlasUpdatesPerDraw; ++update)
+        {
+            glTexSubImage2D(GL_TEXTURE_2D, 0, (mNextTile % tilesPerRow) * params.subImageSize,
+                            (mNextTile / tilesPerRow) * params.subImageSize, params.subImageSize,
+                            params.subImageSize, GL_RGBA, GL_UNSIGNED_BYTE, mTextureData.data());
+            mNextTile = (mNextTile + 1) % tileCount;
+        }
+
+        // Perform a draw just so the texture data is flushed.  With the position attributes not
+        // set, a constant default value is used, resulting in a very cheap draw.
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+    }
+    stopGpuTimer();
+
+    ASSERT_GL_NO_ERROR();
+}
+
+void TextureUploadConversionBenchmark::drawBenchmark()
+{
+    const auto &params = GetParam();
+
+    startGpuTimer();
+    for (unsigned int iteration = 0; iteration < params.iterationsPerStep; ++iteration)
+    {
+        const double startTime = GetCurrentSystemTime();
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, params.baseSize, params.baseSize, GL_RGB,
+                        GL_UNSIGNED_BYTE, mTextureData.data());
+        mUploadTime += GetCurrentSystemTime() - startTime;
+        mUploadedBytes += params.baseSize * params.baseSize * 3;
+
+        // Perform a draw just so the texture data is flushed.  With the position attributes not
+        // set, a constant default value is used, resulting in a very cheap draw.
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+    }
+    stopGpuTimer();
+
+    ASSERT_GL_NO_ERROR();
+}
+
 void PBOSubImageBenchmark::drawBenchmark()
 {
     const auto &params = GetParam();
@@ -488,6 +608,27 @@ TextureUploadParams ES3VulkanParams(bool webglCompat)
     return params;
 }
 
+TextureUploadParams AtlasParams(const TextureUploadParams &in)
+{
+    TextureUploadParams params = in;
+    params.subImageSize        = 8;
+    return params;
+}
+
+TextureUploadParams ES3VulkanConversionParams(bool asyncUpload)
+{
+    TextureUploadParams params;
+    params.eglParameters = egl_platform::VULKAN();
+    params.majorVersion  = 3;
+    params.minorVersion  = 0;
+    params.asyncUpload   = asyncUpload;
+    if (asyncUpload)
+    {
+        params.enable(Feature::AsyncTextureUpload);
+    }
+    return params;
+}
+
 TextureUploadParams MetalPBOParams(GLsizei baseSize, GLsizei subImageSize)
 {
     TextureUploadParams params;
@@ -541,6 +682,16 @@ TEST_P(TextureUploadFullMipBenchmark, Run)
     run();
 }
 
+TEST_P(TextureUploadAtlasBenchmark, Run)
+{
+    run();
+}
+
+TEST_P(TextureUploadConversionBenchmark, Run)
+{
+    run();
+}
+
 TEST_P(PBOSubImageBenchmark, Run)
 {
     run();
@@ -576,6 +727,16 @@ ANGLE_INSTANTIATE_TEST(TextureUploadFullMipBenchmark,
                        VulkanParams(false),
                        VulkanParams(true));
 
+ANGLE_INSTANTIATE_TEST(TextureUploadAtlasBenchmark,
+                       AtlasParams(D3D11Params(false)),
+                       AtlasParams(MetalParams(false)),
+                       AtlasParams(OpenGLOrGLESParams(false)),
+                       AtlasParams(VulkanParams(false)));
+
+ANGLE_INSTANTIATE_TEST(TextureUploadConversionBenchmark,
+                       ES3VulkanConversionParams(false),
+                       ES3VulkanConversionParams(true));
+
 GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(PBOSubImageBenchmark);
 ANGLE_INSTANTIATE_TEST(PBOSubImageBenchmark,
                        ES3OpenGLPBOParams(1024, 128),
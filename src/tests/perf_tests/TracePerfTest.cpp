@@ -27,6 +27,7 @@
 #include <fstream>
 #include <functional>
 #include <sstream>
+#include <thread>
 
 // When --minimize-gpu-work is specified, we want to reduce GPU work to minimum and lift up the CPU
 // overhead to surface so that we can see how much CPU overhead each driver has for each app trace.
@@ -234,6 +235,15 @@ class TracePerfTest : public ANGLERenderTest
     bool mScreenshotSaved                                               = false;
     int32_t mScreenshotFrame                                            = gScreenshotFrame;
     std::unique_ptr<TraceLibrary> mTraceReplay;
+
+    // Contexts made current on other threads than this one, with threaded replay, don't use the
+    // window surface.
+    std::thread::id mReplayThreadId;
+    EGLDisplay mReplayDisplay = EGL_NO_DISPLAY;
+
+    // Time spent in replayFrame(), for the replay throughput.
+    double mReplayTime           = 0.0;
+    uint32_t mReplayedFrameCount = 0;
 };
 
 TracePerfTest *gCurrentTracePerfTest = nullptr;
@@ -1846,6 +1856,16 @@ void TracePerfTest::initializeBenchmark()
             }
             mTraceReplay->setTraceGzPath(traceGzPath);
         }
+        else if (strcmp(gTraceInterpreter, "binary") == 0)
+        {
+            // The first run parses the trace sources and writes the call stream that later runs
+            // map and decode frame by frame.
+            std::stringstream callStreamPath;
+            callStreamPath << testDataDir << angle::GetPathSeparator() << traceInfo.name
+                           << ".anglecalls";
+            mTraceReplay->setTraceCallStreamPath(callStreamPath.str());
+        }
+        mTraceReplay->setThreadedReplay(gThreadedReplay);
     }
     else
     {
@@ -1929,11 +1949,20 @@ void TracePerfTest::initializeBenchmark()
         }
     }
 
+    mReplayThreadId = std::this_thread::get_id();
+    mReplayDisplay  = eglGetCurrentDisplay();
+
     // Potentially slow. Can load a lot of resources.
+    double setupStartTime = angle::GetCurrentSystemTime();
     mTraceReplay->setupReplay();
 
     glFinish();
 
+    mReporter->RegisterFyiMetric(".setup_time", "ms");
+    mReporter->RegisterFyiMetric(".replay_throughput", "frames/s");
+    recordDoubleMetric(".setup_time", (angle::GetCurrentSystemTime() - setupStartTime) * 1000.0,
+                       "ms");
+
     ASSERT_GE(mEndFrame, mStartFrame);
 
     getWindow()->ignoreSizeEvents();
@@ -1963,6 +1992,11 @@ void TracePerfTest::destroyBenchmark()
         mOffscreenFramebuffers.fill(0);
     }
 
+    if (mReplayTime > 0)
+    {
+        recordDoubleMetric(".replay_throughput", mReplayedFrameCount / mReplayTime, "frames/s");
+    }
+
     mTraceReplay->finishReplay();
     mTraceReplay.reset(nullptr);
 }
@@ -2027,7 +2061,10 @@ void TracePerfTest::drawBenchmark()
     beginInternalTraceEvent(frameName);
 
     startGpuTimer();
+    double replayStartTime = angle::GetCurrentSystemTime();
     mTraceReplay->replayFrame(mCurrentFrame);
+    mReplayTime += angle::GetCurrentSystemTime() - replayStartTime;
+    mReplayedFrameCount++;
     stopGpuTimer();
 
     updatePerfCounters();
@@ -2202,6 +2239,13 @@ void TracePerfTest::onEglMakeCurrent(EGLDisplay display,
                                      EGLSurface read,
                                      EGLContext context)
 {
+    if (std::this_thread::get_id() != mReplayThreadId)
+    {
+        // The window surface stays current on the main thread.
+        eglMakeCurrent(mReplayDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, context);
+        return;
+    }
+
     getGLWindow()->makeCurrentGeneric(reinterpret_cast<GLWindowContext>(context));
 }
 
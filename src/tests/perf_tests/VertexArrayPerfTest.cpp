@@ -4,11 +4,13 @@
 // found in the LICENSE file.
 //
 // VertexArrayPerfTest:
-//   Performance test for glBindVertexArray.
+//   Performance test for glBindVertexArray, and for drawing with client-side vertex arrays in
+//   formats that are converted on the CPU.
 //
 
 #include "ANGLEPerfTest.h"
 #include "DrawCallPerfParams.h"
+#include "common/system_utils.h"
 #include "test_utils/gl_raii.h"
 
 using namespace angle;
@@ -20,8 +22,12 @@ enum class TestMode
     BufferData,
     BindBuffer,
     UpdateBufferData,
+    ConvertClientArray,
 };
 
+// Number of vertices drawn from client arrays per draw call.
+constexpr GLsizei kClientArrayVertexCount = 65536;
+
 struct VertexArrayParams final : public RenderTestParams
 {
     VertexArrayParams()
@@ -41,6 +47,11 @@ struct VertexArrayParams final : public RenderTestParams
     int numBuffers       = 5;
     GLuint bufferSize[5] = {384, 1028, 192, 384, 192};
     TestMode testMode    = TestMode::BufferData;
+
+    // Format of the client array for TestMode::ConvertClientArray.
+    GLenum vertexType          = GL_BYTE;
+    GLint vertexComponentCount = 3;
+    GLboolean vertexNormalized = GL_TRUE;
 };
 
 std::ostream &operator<<(std::ostream &os, const VertexArrayParams &params)
@@ -63,6 +74,29 @@ std::string VertexArrayParams::story() const
     {
         strstr << "_updatebufferdata";
     }
+    else if (testMode == TestMode::ConvertClientArray)
+    {
+        strstr << "_convert_";
+        switch (vertexType)
+        {
+            case GL_BYTE:
+                strstr << "byte";
+                break;
+            case GL_UNSIGNED_SHORT:
+                strstr << "ushort";
+                break;
+            case GL_FIXED:
+                strstr << "fixed";
+                break;
+            case GL_INT_2_10_10_10_REV:
+                strstr << "int_2_10_10_10";
+                break;
+            default:
+                strstr << "0x" << std::hex << vertexType << std::dec;
+                break;
+        }
+        strstr << vertexComponentCount << (vertexNormalized ? "_norm" : "");
+    }
 
     return strstr.str();
 }
@@ -81,16 +115,34 @@ class VertexArrayBenchmark : public ANGLERenderTest,
     void updateBufferData(GLuint vertexArrayID, GLuint bufferID, GLuint bufferSize);
 
   private:
+    void initializeClientArray();
+
     std::vector<GLuint> mBuffers;
     GLuint mProgram       = 0;
     GLint mAttribLocation = 0;
     std::vector<GLuint> mVertexArrays;
+
+    std::vector<uint8_t> mClientArray;
+    double mConversionTime      = 0;
+    uint64_t mConvertedVertices = 0;
 };
 
-VertexArrayBenchmark::VertexArrayBenchmark() : ANGLERenderTest("VertexArrayPerf", GetParam()) {}
+VertexArrayBenchmark::VertexArrayBenchmark() : ANGLERenderTest("VertexArrayPerf", GetParam())
+{
+    if (GetParam().testMode == TestMode::ConvertClientArray)
+    {
+        mReporter->RegisterFyiMetric(".conversion_rate", "MVert/s");
+    }
+}
 
 void VertexArrayBenchmark::initializeBenchmark()
 {
+    if (GetParam().testMode == TestMode::ConvertClientArray)
+    {
+        initializeClientArray();
+        return;
+    }
+
     constexpr char kVS[] = R"(attribute vec4 position;
 attribute float in_attrib;
 varying float v_attrib;
@@ -132,6 +184,60 @@ void main()
     glBindBuffer(GL_ARRAY_BUFFER, mBuffers[0]);
 }
 
+void VertexArrayBenchmark::initializeClientArray()
+{
+    constexpr char kVS[] = R"(attribute vec4 position;
+void main()
+{
+    gl_PointSize = 1.0;
+    gl_Position = position;
+})";
+
+    constexpr char kFS[] = R"(precision mediump float;
+void main()
+{
+    gl_FragColor = vec4(1, 0, 0, 1);
+})";
+
+    mProgram = CompileProgram(kVS, kFS);
+    ASSERT_NE(0u, mProgram);
+    glUseProgram(mProgram);
+
+    mAttribLocation = glGetAttribLocation(mProgram, "position");
+    ASSERT_NE(mAttribLocation, -1);
+
+    const VertexArrayParams &params = GetParam();
+    GLsizei vertexSize              = 4;
+    switch (params.vertexType)
+    {
+        case GL_BYTE:
+            vertexSize = params.vertexComponentCount;
+            break;
+        case GL_UNSIGNED_SHORT:
+            vertexSize = params.vertexComponentCount * 2;
+            break;
+        case GL_FIXED:
+            vertexSize = params.vertexComponentCount * 4;
+            break;
+        default:
+            break;
+    }
+
+    // Fill the vertices with a pattern that has every bit set somewhere.
+    mClientArray.resize(kClientArrayVertexCount * vertexSize);
+    for (size_t i = 0; i < mClientArray.size(); i++)
+    {
+        mClientArray[i] = static_cast<uint8_t>(i * 37);
+    }
+
+    // Client arrays must be specified with no vertex array object bound.
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glEnableVertexAttribArray(mAttribLocation);
+    glVertexAttribPointer(mAttribLocation, params.vertexComponentCount, params.vertexType,
+                          params.vertexNormalized, vertexSize, mClientArray.data());
+    ASSERT_GL_NO_ERROR();
+}
+
 void VertexArrayBenchmark::rebindVertexArray(GLuint vertexArrayID, GLuint bufferID)
 {
     // Rebind a vertex array object and a generic vertex attribute inside of it.
@@ -159,6 +265,12 @@ void VertexArrayBenchmark::updateBufferData(GLuint vertexArrayID,
 
 void VertexArrayBenchmark::destroyBenchmark()
 {
+    if (mConversionTime > 0)
+    {
+        recordDoubleMetric(".conversion_rate", mConvertedVertices / mConversionTime / 1'000'000.0,
+                           "MVert/s");
+    }
+
     glDeleteProgram(mProgram);
     glDeleteVertexArrays(static_cast<GLsizei>(mVertexArrays.size()), mVertexArrays.data());
     mVertexArrays.clear();
@@ -173,6 +285,14 @@ void VertexArrayBenchmark::drawBenchmark()
     {
         glBufferData(GL_ARRAY_BUFFER, 128, nullptr, GL_STATIC_DRAW);
     }
+    else if (params.testMode == TestMode::ConvertClientArray)
+    {
+        // The client array is streamed and converted every draw.
+        const double startTime = GetCurrentSystemTime();
+        glDrawArrays(GL_POINTS, 0, kClientArrayVertexCount);
+        mConversionTime += GetCurrentSystemTime() - startTime;
+        mConvertedVertices += kClientArrayVertexCount;
+    }
     else if (params.testMode == TestMode::UpdateBufferData)
     {
         int bufferSizeIndex = 0;
@@ -220,6 +340,20 @@ VertexArrayParams VulkanNullParams(TestMode testMode)
     return params;
 }
 
+VertexArrayParams ConvertClientArrayParams(const EGLPlatformParameters &eglParameters,
+                                           GLenum vertexType,
+                                           GLint vertexComponentCount,
+                                           GLboolean vertexNormalized)
+{
+    VertexArrayParams params;
+    params.eglParameters        = eglParameters;
+    params.testMode             = TestMode::ConvertClientArray;
+    params.vertexType           = vertexType;
+    params.vertexComponentCount = vertexComponentCount;
+    params.vertexNormalized     = vertexNormalized;
+    return params;
+}
+
 GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(VertexArrayBenchmark);
 ANGLE_INSTANTIATE_TEST(VertexArrayBenchmark,
                        MetalParams(),
@@ -227,5 +361,15 @@ ANGLE_INSTANTIATE_TEST(VertexArrayBenchmark,
                        VulkanNullParams(TestMode::BindBuffer),
                        VulkanNullParams(TestMode::BufferData),
                        VulkanNullParams(TestMode::UpdateBufferData),
+                       ConvertClientArrayParams(egl_platform::VULKAN_NULL(), GL_BYTE, 3, GL_TRUE),
+                       ConvertClientArrayParams(egl_platform::VULKAN_NULL(),
+                                                GL_UNSIGNED_SHORT,
+                                                3,
+                                                GL_TRUE),
+                       ConvertClientArrayParams(egl_platform::VULKAN_NULL(), GL_FIXED, 4, GL_FALSE),
+                       ConvertClientArrayParams(egl_platform::VULKAN_NULL(),
+                                                GL_INT_2_10_10_10_REV,
+                                                4,
+                                                GL_TRUE),
                        params::Native(VertexArrayParams()));
 }  // namespace
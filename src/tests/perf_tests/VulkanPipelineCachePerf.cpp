@@ -8,6 +8,9 @@
 
 #include "ANGLEPerfTest.h"
 
+#include <map>
+
+#include "libANGLE/renderer/vulkan/PipelineCacheBlobStore.h"
 #include "libANGLE/renderer/vulkan/vk_cache_utils.h"
 #include "libANGLE/renderer/vulkan/vk_helpers.h"
 #include "libANGLE/renderer/vulkan/vk_renderer.h"
@@ -142,6 +145,132 @@ void VulkanPipelineCachePerfTest::step()
     fsRefCounted.get().setHandle(VK_NULL_HANDLE);
 }
 
+// Stores blobs in memory, standing in for the application's blob cache.
+class MemoryGlobalOps : public vk::GlobalOps
+{
+  public:
+    void putBlob(const angle::BlobCacheKey &key, const angle::MemoryBuffer &value) override
+    {
+        mBlobs[key].assign(value.data(), value.data() + value.size());
+    }
+
+    bool getBlob(const angle::BlobCacheKey &key, angle::BlobCacheValue *valueOut) override
+    {
+        auto iter = mBlobs.find(key);
+        if (iter == mBlobs.end())
+        {
+            return false;
+        }
+        *valueOut = angle::BlobCacheValue(iter->second.data(), iter->second.size());
+        return true;
+    }
+
+    angle::BlobCompressionCodec getBlobCompressionCodec() const override
+    {
+        return angle::BlobCompressionCodec::Gzip;
+    }
+
+    std::shared_ptr<angle::WaitableEvent> postMultiThreadWorkerTask(
+        const std::shared_ptr<angle::Closure> &task,
+        angle::WorkerTaskPriority priority) override
+    {
+        (*task)();
+        return std::make_shared<angle::WaitableEventDone>();
+    }
+
+    void notifyDeviceLost() override {}
+
+  private:
+    std::map<angle::BlobCacheKey, std::vector<uint8_t>> mBlobs;
+};
+
+struct SyncParams
+{
+    size_t cacheSize;
+    // If false, every sync compresses and stores the whole cache, like before the cache was
+    // chunked by content.
+    bool incremental;
+};
+
+std::ostream &operator<<(std::ostream &os, const SyncParams &params)
+{
+    os << params.cacheSize / 1024 << "kb" << (params.incremental ? "_incremental" : "_full");
+    return os;
+}
+
+class VulkanPipelineCacheSyncPerfTest : public ANGLEPerfTest,
+                                        public ::testing::WithParamInterface<SyncParams>
+{
+  public:
+    VulkanPipelineCacheSyncPerfTest();
+
+    void SetUp() override;
+    void step() override;
+
+    std::string getName();
+
+  private:
+    angle::RNG mRNG;
+    std::vector<uint8_t> mCacheData;
+    MemoryGlobalOps mGlobalOps;
+    vk::PipelineCacheBlobStore mBlobStore;
+};
+
+VulkanPipelineCacheSyncPerfTest::VulkanPipelineCacheSyncPerfTest()
+    : ANGLEPerfTest(getName(), "", "_run", 1, "us"), mRNG(0x12345678u)
+{}
+
+void VulkanPipelineCacheSyncPerfTest::SetUp()
+{
+    ANGLEPerfTest::SetUp();
+
+    mCacheData.resize(GetParam().cacheSize);
+    FillVectorWithRandomUBytes(&mRNG, &mCacheData);
+
+    mBlobStore.init("VulkanPipelineCacheSyncPerf");
+    vk::PipelineCacheBlobStore::StoreStats stats;
+    ASSERT_TRUE(mBlobStore.store(&mGlobalOps, mCacheData.data(), mCacheData.size(),
+                                 std::numeric_limits<size_t>::max(), &stats));
+}
+
+void VulkanPipelineCacheSyncPerfTest::step()
+{
+    // Simulate a few pipelines being added to the cache between syncs by rewriting a small region
+    // at a random offset.
+    constexpr size_t kNewPipelineDataSize = 4096;
+    std::vector<uint8_t> newPipelineData(kNewPipelineDataSize);
+    FillVectorWithRandomUBytes(&mRNG, &newPipelineData);
+    const size_t offset = mRNG.randomIntBetween(0, static_cast<int>(mCacheData.size() -
+                                                                    kNewPipelineDataSize));
+    memcpy(mCacheData.data() + offset, newPipelineData.data(), kNewPipelineDataSize);
+
+    if (!GetParam().incremental)
+    {
+        mBlobStore.reset();
+    }
+
+    vk::PipelineCacheBlobStore::StoreStats stats;
+    mBlobStore.store(&mGlobalOps, mCacheData.data(), mCacheData.size(),
+                     std::numeric_limits<size_t>::max(), &stats);
+}
+
+std::string VulkanPipelineCacheSyncPerfTest::getName()
+{
+    std::stringstream ss;
+    ss << ::testing::UnitTest::GetInstance()->current_test_suite()->name() << "/" << GetParam();
+    return ss.str();
+}
+
+std::vector<SyncParams> SyncTestParams()
+{
+    std::vector<SyncParams> params;
+    for (size_t cacheSize : {256 * 1024, 1024 * 1024, 4 * 1024 * 1024, 16 * 1024 * 1024})
+    {
+        params.push_back({cacheSize, false});
+        params.push_back({cacheSize, true});
+    }
+    return params;
+}
 }  // anonymous namespace
 
 // Test performance of pipeline hash and look up in Vulkan
@@ -153,3 +282,14 @@ TEST_P(VulkanPipelineCachePerfTest, Run)
 INSTANTIATE_TEST_SUITE_P(,
                          VulkanPipelineCachePerfTest,
                          ::testing::ValuesIn(std::vector<Params>{{Params{false}, Params{true}}}));
+
+// Test the cost of syncing the pipeline cache to the blob cache as a function of its size.
+TEST_P(VulkanPipelineCacheSyncPerfTest, Run)
+{
+    run();
+}
+
+INSTANTIATE_TEST_SUITE_P(,
+                         VulkanPipelineCacheSyncPerfTest,
+                         ::testing::ValuesIn(SyncTestParams()),
+                         ::testing::PrintToStringParamName());
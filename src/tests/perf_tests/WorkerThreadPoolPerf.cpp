@@ -0,0 +1,185 @@
+//
+// Copyright 2024 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// WorkerThreadPoolPerf:
+//   Performance tests for the worker thread pools, comparing the work-stealing pool against the
+//   pool with a single shared queue.
+//
+
+#include "ANGLEPerfTest.h"
+
+#include "common/WorkerThread.h"
+
+using namespace testing;
+
+namespace
+{
+using angle::Closure;
+using angle::WaitableEvent;
+using angle::WorkerTaskPriority;
+using angle::WorkerThreadPool;
+
+enum class PoolType
+{
+    SharedQueue,
+    WorkStealing,
+};
+
+enum class Workload
+{
+    // Many small independent tasks posted in a burst, like parallel shader compilation.
+    Burst,
+    // Tasks that post sub-tasks and wait on them, like program link.
+    NestedLink,
+};
+
+struct WorkerThreadPoolParams
+{
+    PoolType poolType;
+    Workload workload;
+};
+
+std::ostream &operator<<(std::ostream &os, const WorkerThreadPoolParams &params)
+{
+    os << (params.poolType == PoolType::SharedQueue ? "shared_queue" : "work_stealing");
+    os << (params.workload == Workload::Burst ? "_burst" : "_nested_link");
+    return os;
+}
+
+constexpr size_t kThreadCount      = 8;
+constexpr size_t kBurstTaskCount   = 2048;
+constexpr size_t kLinkTaskCount    = 64;
+constexpr size_t kLinkSubTaskCount = 8;
+constexpr uint32_t kTaskWorkLoops  = 256;
+
+// A task that does a small amount of work, so the cost of the pool itself dominates.
+class SmallTask : public Closure
+{
+  public:
+    void operator()() override
+    {
+        uint32_t value = 0x12345678;
+        for (uint32_t i = 0; i < kTaskWorkLoops; ++i)
+        {
+            value = value * 1664525u + 1013904223u;
+        }
+        mResult = value;
+    }
+
+  private:
+    volatile uint32_t mResult = 0;
+};
+
+class LinkTask : public Closure
+{
+  public:
+    LinkTask(WorkerThreadPool *pool) : mPool(pool) {}
+
+    void operator()() override
+    {
+        std::vector<std::shared_ptr<WaitableEvent>> waitables;
+        waitables.reserve(kLinkSubTaskCount);
+        for (size_t i = 0; i < kLinkSubTaskCount; ++i)
+        {
+            waitables.push_back(
+                mPool->postWorkerTask(std::make_shared<SmallTask>(), WorkerTaskPriority::High));
+        }
+        WaitableEvent::WaitMany(&waitables);
+    }
+
+  private:
+    WorkerThreadPool *mPool;
+};
+
+class WorkerThreadPoolPerfTest : public ANGLEPerfTest,
+                                 public WithParamInterface<WorkerThreadPoolParams>
+{
+  public:
+    WorkerThreadPoolPerfTest();
+
+    void step() override;
+    void TearDown() override;
+
+    std::string getName();
+
+  private:
+    std::shared_ptr<WorkerThreadPool> mPool;
+    std::vector<std::shared_ptr<WaitableEvent>> mWaitables;
+};
+
+WorkerThreadPoolPerfTest::WorkerThreadPoolPerfTest()
+    : ANGLEPerfTest(getName(), "", "_run", 1, "us"),
+      mPool(GetParam().poolType == PoolType::SharedQueue
+                ? WorkerThreadPool::CreateSharedQueuePoolForTesting(kThreadCount)
+                : WorkerThreadPool::Create(kThreadCount, ANGLEPlatformCurrent()))
+{
+    mReporter->RegisterFyiMetric(".steal_rate", "count");
+    mReporter->RegisterFyiMetric(".peak_queue_depth", "count");
+}
+
+void WorkerThreadPoolPerfTest::step()
+{
+    mWaitables.clear();
+
+    switch (GetParam().workload)
+    {
+        case Workload::Burst:
+            for (size_t i = 0; i < kBurstTaskCount; ++i)
+            {
+                mWaitables.push_back(mPool->postWorkerTask(std::make_shared<SmallTask>()));
+            }
+            break;
+
+        case Workload::NestedLink:
+            for (size_t i = 0; i < kLinkTaskCount; ++i)
+            {
+                mWaitables.push_back(
+                    mPool->postWorkerTask(std::make_shared<LinkTask>(mPool.get())));
+            }
+            break;
+    }
+
+    WaitableEvent::WaitMany(&mWaitables);
+}
+
+void WorkerThreadPoolPerfTest::TearDown()
+{
+    ANGLEPerfTest::TearDown();
+
+    const angle::WorkerThreadPoolCounters counters = mPool->getCounters();
+    if (counters.tasksPosted > 0)
+    {
+        recordDoubleMetric(".steal_rate",
+                           static_cast<double>(counters.tasksStolen) /
+                               static_cast<double>(counters.tasksPosted),
+                           "count");
+    }
+    recordIntegerMetric(".peak_queue_depth", counters.peakQueueDepth, "count");
+}
+
+std::string WorkerThreadPoolPerfTest::getName()
+{
+    std::stringstream ss;
+    ss << UnitTest::GetInstance()->current_test_suite()->name() << "/" << GetParam();
+    return ss.str();
+}
+
+// Measures the overhead of posting, running and waiting on tasks in each pool.
+TEST_P(WorkerThreadPoolPerfTest, Run)
+{
+    this->run();
+}
+
+INSTANTIATE_TEST_SUITE_P(,
+                         WorkerThreadPoolPerfTest,
+                         Values(WorkerThreadPoolParams{PoolType::SharedQueue, Workload::Burst},
+                                WorkerThreadPoolParams{PoolType::WorkStealing, Workload::Burst},
+                                WorkerThreadPoolParams{PoolType::SharedQueue,
+                                                       Workload::NestedLink},
+                                WorkerThreadPoolParams{PoolType::WorkStealing,
+                                                       Workload::NestedLink}),
+                         PrintToStringParamName());
+
+}  // anonymous namespace
@@ -50,6 +50,7 @@ enum class Feature
     AppendAliasedMemoryDecorations,
     AsyncCommandBufferReset,
     AsyncCommandQueue,
+    AsyncTextureUpload,
     Avoid1BitAlphaTextureFormats,
     AvoidOpSelectWithMismatchingRelaxedPrecision,
     AvoidStencilTextureSwizzle,
@@ -82,6 +83,7 @@ enum class Feature
     DisableB5G6R5Support,
     DisableBaseInstanceVertex,
     DisableBlendFuncExtended,
+    DisableBlobCacheCompression,
     DisableClipControl,
     DisableDepthStencilResolveThroughAttachment,
     DisableDrawBuffersIndexed,
@@ -173,6 +175,7 @@ enum class Feature
     ForceDisableFullScreenExclusive,
     ForceFallbackFormat,
     ForceFragmentShaderPrecisionHighpToMediump,
+    ForceGenerateMipmapOnCPU,
     ForceGlErrorChecking,
     ForceInitShaderVariables,
     ForceMaxUniformBufferSize16KB,
@@ -389,6 +392,7 @@ enum class Feature
     UploadDataToIosurfacesWithStagingBuffers,
     UploadTextureDataInChunks,
     UseCullModeDynamicState,
+    UseDeflateBestBlobCacheCompression,
     UseDepthBiasEnableDynamicState,
     UseDepthCompareOpDynamicState,
     UseDepthTestEnableDynamicState,
@@ -396,6 +400,7 @@ enum class Feature
     UseFrontFaceDynamicState,
     UseInstancedPointSpriteEmulation,
     UseIntermediateTextureForGenerateMipmap,
+    UseLz4BlobCacheCompression,
     UseMultipleDescriptorsForExternalFormats,
     UseNonZeroStencilWriteMaskStaticState,
     UsePrimitiveRestartEnableDynamicState,
@@ -274,6 +274,13 @@ uint8_t *TraceLibrary::LoadBinaryData(const char *fileName)
 {
     std::ostringstream pathBuffer;
     pathBuffer << mBinaryDataDir << "/" << fileName;
+
+    if (!mTraceInfo.isBinaryDataCompressed && strstr(fileName, ".angledata") &&
+        mBinaryDataFile.open(pathBuffer.str().c_str()))
+    {
+        return mBinaryDataFile.data();
+    }
+
     FILE *fp = fopen(pathBuffer.str().c_str(), "rb");
     if (fp == 0)
     {
@@ -74,6 +74,7 @@ class TraceLibrary : angle::NonCopyable, angle::TraceCallbacks
     {
         mTraceFunctions->FinishReplay();
         mBinaryData = {};  // set to empty vector to release memory.
+        mBinaryDataFile.close();
     }
 
     const char *getSerializedContextState(uint32_t frameIndex)
@@ -92,6 +93,16 @@ class TraceLibrary : angle::NonCopyable, angle::TraceCallbacks
         mTraceFunctions->SetTraceGzPath(traceGzPath);
     }
 
+    void setTraceCallStreamPath(const std::string &traceCallStreamPath)
+    {
+        mTraceFunctions->SetTraceCallStreamPath(traceCallStreamPath);
+    }
+
+    void setThreadedReplay(bool threadedReplay)
+    {
+        mTraceFunctions->SetThreadedReplay(threadedReplay);
+    }
+
   private:
     template <typename FuncT, typename... ArgsT>
     typename std::invoke_result<FuncT, ArgsT...>::type callFunc(const char *funcName, ArgsT... args)
@@ -110,6 +121,8 @@ class TraceLibrary : angle::NonCopyable, angle::TraceCallbacks
 
     std::unique_ptr<Library> mTraceLibrary;
     std::vector<uint8_t> mBinaryData;
+    // Uncompressed binary data is mapped rather than read, so only the pages in use are loaded.
+    MemoryMappedFile mBinaryDataFile;
     std::string mBinaryDataDir;
     std::string mDebugOutputDir;
     angle::TraceInfo mTraceInfo;
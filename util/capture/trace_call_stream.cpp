@@ -0,0 +1,582 @@
+//
+// Copyright 2024 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// trace_call_stream.cpp:
+//   Implements the binary call stream used by the trace interpreter.
+//
+
+#include "trace_call_stream.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+
+#include "common/mathutil.h"
+#include "common/string_utils.h"
+#include "trace_fixture.h"
+#include "xxhash.h"
+
+namespace angle
+{
+namespace
+{
+constexpr char kReplayFramePrefix[] = "ReplayFrame";
+
+// Returns true if |name| is the function replaying a whole frame, as opposed to one of its parts.
+bool GetReplayFrameIndex(const std::string &name, uint32_t *frameIndexOut)
+{
+    if (!BeginsWith(name, kReplayFramePrefix) || name.size() == strlen(kReplayFramePrefix))
+    {
+        return false;
+    }
+
+    uint32_t frameIndex = 0;
+    for (size_t index = strlen(kReplayFramePrefix); index < name.size(); ++index)
+    {
+        if (!isdigit(name[index]))
+        {
+            return false;
+        }
+        frameIndex = frameIndex * 10 + (name[index] - '0');
+    }
+
+    *frameIndexOut = frameIndex;
+    return true;
+}
+
+template <typename T>
+void Append(std::vector<uint8_t> *out, const T &value)
+{
+    const uint8_t *bytes = reinterpret_cast<const uint8_t *>(&value);
+    out->insert(out->end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T>
+void AppendVector(std::vector<uint8_t> *out, const std::vector<T> &values)
+{
+    const uint8_t *bytes = reinterpret_cast<const uint8_t *>(values.data());
+    out->insert(out->end(), bytes, bytes + values.size() * sizeof(T));
+}
+
+void Align(std::vector<uint8_t> *out)
+{
+    out->resize(rx::roundUpPow2<size_t>(out->size(), 8), 0);
+}
+
+template <typename T>
+const T *GetSection(const uint8_t *data, uint64_t offset)
+{
+    return reinterpret_cast<const T *>(data + offset);
+}
+
+bool IsAligned(uint64_t offset)
+{
+    return offset % 8 == 0;
+}
+}  // anonymous namespace
+
+bool ComputeCallStreamSourceHash(const std::vector<std::string> &paths, uint64_t *hashOut)
+{
+    // Reading and hashing the sources is much cheaper than parsing them, and unlike file times it
+    // is reliable when traces are copied or regenerated.
+    uint64_t hash = 0;
+    for (const std::string &path : paths)
+    {
+        std::string fileData;
+        if (!ReadFileToString(path, &fileData))
+        {
+            return false;
+        }
+        hash = XXH64(fileData.data(), fileData.size(), hash);
+    }
+
+    *hashOut = hash;
+    return true;
+}
+
+CallStreamWriter::CallStreamWriter() = default;
+
+CallStreamWriter::~CallStreamWriter() = default;
+
+uint32_t CallStreamWriter::addString(const char *str, size_t length)
+{
+    std::string key(str, length);
+    auto iter = mStringIndices.find(key);
+    if (iter != mStringIndices.end())
+    {
+        return iter->second;
+    }
+
+    uint32_t stringIndex = static_cast<uint32_t>(mStrings.size());
+    mStrings.push_back(key);
+    mStringIndices.emplace(std::move(key), stringIndex);
+    return stringIndex;
+}
+
+uint32_t CallStreamWriter::addStringArray(const std::vector<std::string> &strings)
+{
+    std::vector<uint32_t> stringIndices;
+    for (const std::string &str : strings)
+    {
+        stringIndices.push_back(addString(str.c_str(), str.size()));
+    }
+
+    auto iter = mStringArrayIndices.find(stringIndices);
+    if (iter != mStringArrayIndices.end())
+    {
+        return iter->second;
+    }
+
+    uint32_t stringArrayIndex = static_cast<uint32_t>(mStringArrays.size());
+    mStringArrays.push_back(stringIndices);
+    mStringArrayIndices.emplace(std::move(stringIndices), stringArrayIndex);
+    return stringArrayIndex;
+}
+
+void CallStreamWriter::beginFunction(const std::string &name)
+{
+    ASSERT(!mInFunction);
+    mInFunction = true;
+
+    CallStreamFunction function = {};
+    function.nameIndex          = addString(name.c_str(), name.size());
+    function.callsOffset        = mCalls.size();
+    mFunctions.push_back(function);
+
+    uint32_t frameIndex = 0;
+    if (GetReplayFrameIndex(name, &frameIndex))
+    {
+        mFrames.push_back({frameIndex, static_cast<uint32_t>(mFunctions.size() - 1)});
+    }
+}
+
+void CallStreamWriter::addCall(EntryPoint entryPoint,
+                               const std::string &customFunctionName,
+                               const std::vector<CallStreamParam> &params)
+{
+    ASSERT(mInFunction);
+
+    CallStreamCall call  = {};
+    call.entryPoint      = static_cast<uint16_t>(entryPoint);
+    call.paramCount      = static_cast<uint16_t>(params.size());
+    call.customNameIndex = entryPoint == EntryPoint::Invalid
+                               ? addString(customFunctionName.c_str(), customFunctionName.size())
+                               : kCallStreamNoName;
+    Append(&mCalls, call);
+    AppendVector(&mCalls, params);
+
+    mFunctions.back().callCount++;
+}
+
+void CallStreamWriter::endFunction()
+{
+    ASSERT(mInFunction);
+    mInFunction = false;
+}
+
+bool CallStreamWriter::save(const std::string &path, uint64_t sourceHash) const
+{
+    ASSERT(!mInFunction);
+
+    std::vector<CallStreamFrame> frames = mFrames;
+    std::sort(frames.begin(), frames.end(),
+              [](const CallStreamFrame &a, const CallStreamFrame &b) {
+                  return a.frameIndex < b.frameIndex;
+              });
+
+    CallStreamHeader header = {};
+    memcpy(header.magic, kCallStreamMagic, sizeof(kCallStreamMagic));
+    header.version          = kCallStreamVersion;
+    header.functionCount    = static_cast<uint32_t>(mFunctions.size());
+    header.frameCount       = static_cast<uint32_t>(frames.size());
+    header.stringCount      = static_cast<uint32_t>(mStrings.size());
+    header.stringArrayCount = static_cast<uint32_t>(mStringArrays.size());
+    header.sourceHash       = sourceHash;
+
+    std::vector<uint8_t> out;
+    out.resize(sizeof(CallStreamHeader));
+
+    // The calls are written first, so function offsets are relative to the end of the header.
+    const uint64_t callsStart = out.size();
+    out.insert(out.end(), mCalls.begin(), mCalls.end());
+    Align(&out);
+
+    header.functionTableOffset = out.size();
+    for (CallStreamFunction function : mFunctions)
+    {
+        function.callsOffset += callsStart;
+        Append(&out, function);
+    }
+
+    header.frameIndexOffset = out.size();
+    AppendVector(&out, frames);
+    Align(&out);
+
+    header.stringTableOffset = out.size();
+    out.resize(out.size() + mStrings.size() * sizeof(uint64_t));
+    header.stringArrayTableOffset = out.size();
+    out.resize(out.size() + mStringArrays.size() * sizeof(uint64_t));
+
+    uint64_t *stringOffsets = reinterpret_cast<uint64_t *>(&out[header.stringTableOffset]);
+    for (size_t stringIndex = 0; stringIndex < mStrings.size(); ++stringIndex)
+    {
+        const std::string &str = mStrings[stringIndex];
+        uint64_t offset        = out.size();
+        out.insert(out.end(), str.begin(), str.end());
+        out.push_back(0);
+
+        // |out| may have been reallocated.
+        stringOffsets              = reinterpret_cast<uint64_t *>(&out[header.stringTableOffset]);
+        stringOffsets[stringIndex] = offset;
+    }
+    Align(&out);
+
+    for (size_t arrayIndex = 0; arrayIndex < mStringArrays.size(); ++arrayIndex)
+    {
+        const std::vector<uint32_t> &stringIndices = mStringArrays[arrayIndex];
+        uint64_t offset                            = out.size();
+        Append(&out, static_cast<uint32_t>(stringIndices.size()));
+        AppendVector(&out, stringIndices);
+        Align(&out);
+
+        uint64_t *arrayOffsets =
+            reinterpret_cast<uint64_t *>(&out[header.stringArrayTableOffset]);
+        arrayOffsets[arrayIndex] = offset;
+    }
+
+    header.fileSize = out.size();
+    memcpy(out.data(), &header, sizeof(header));
+
+    FILE *fp = fopen(path.c_str(), "wb");
+    if (!fp)
+    {
+        return false;
+    }
+    bool written = fwrite(out.data(), 1, out.size(), fp) == out.size();
+    fclose(fp);
+    return written;
+}
+
+CallStreamReader::CallStreamReader() = default;
+
+CallStreamReader::~CallStreamReader() = default;
+
+bool CallStreamReader::init(const uint8_t *data, size_t size)
+{
+    if (size < sizeof(CallStreamHeader))
+    {
+        return false;
+    }
+
+    const CallStreamHeader *header = reinterpret_cast<const CallStreamHeader *>(data);
+    if (memcmp(header->magic, kCallStreamMagic, sizeof(kCallStreamMagic)) != 0 ||
+        header->version != kCallStreamVersion || header->fileSize != size)
+    {
+        return false;
+    }
+
+    // The calls are followed by the tables, in the order they are written.
+    auto tableFits = [size](uint64_t offset, uint64_t count, size_t entrySize) {
+        return IsAligned(offset) && offset <= size && count <= (size - offset) / entrySize;
+    };
+    if (header->functionTableOffset < sizeof(CallStreamHeader) ||
+        header->frameIndexOffset < header->functionTableOffset ||
+        header->stringTableOffset < header->frameIndexOffset ||
+        header->stringArrayTableOffset < header->stringTableOffset ||
+        !tableFits(header->functionTableOffset, header->functionCount,
+                   sizeof(CallStreamFunction)) ||
+        !tableFits(header->frameIndexOffset, header->frameCount, sizeof(CallStreamFrame)) ||
+        !tableFits(header->stringTableOffset, header->stringCount, sizeof(uint64_t)) ||
+        !tableFits(header->stringArrayTableOffset, header->stringArrayCount, sizeof(uint64_t)))
+    {
+        return false;
+    }
+
+    mData               = data;
+    mSize               = size;
+    mHeader             = header;
+    mFunctions          = GetSection<CallStreamFunction>(data, header->functionTableOffset);
+    mFrames             = GetSection<CallStreamFrame>(data, header->frameIndexOffset);
+    mStringOffsets      = GetSection<uint64_t>(data, header->stringTableOffset);
+    mStringArrayOffsets = GetSection<uint64_t>(data, header->stringArrayTableOffset);
+
+    // Decoding trusts the stream, so everything it indexes is checked up front.
+    if (!validateStrings() || !validateFunctions() || !validateFrames())
+    {
+        return false;
+    }
+
+    for (uint32_t functionIndex = 0; functionIndex < header->functionCount; ++functionIndex)
+    {
+        mFunctionIndices[getFunctionName(functionIndex)] = functionIndex;
+    }
+
+    return true;
+}
+
+bool CallStreamReader::validateStrings() const
+{
+    for (uint32_t stringIndex = 0; stringIndex < mHeader->stringCount; ++stringIndex)
+    {
+        uint64_t offset = mStringOffsets[stringIndex];
+        if (offset >= mSize || memchr(mData + offset, 0, mSize - offset) == nullptr)
+        {
+            return false;
+        }
+    }
+
+    for (uint32_t arrayIndex = 0; arrayIndex < mHeader->stringArrayCount; ++arrayIndex)
+    {
+        uint64_t offset = mStringArrayOffsets[arrayIndex];
+        if (!IsAligned(offset) || offset >= mSize)
+        {
+            return false;
+        }
+
+        // A count followed by the string indices.
+        const uint32_t *encoded = GetSection<uint32_t>(mData, offset);
+        uint64_t maxCount       = (mSize - offset) / sizeof(uint32_t);
+        if (maxCount == 0 || encoded[0] >= maxCount)
+        {
+            return false;
+        }
+        for (uint32_t index = 0; index < encoded[0]; ++index)
+        {
+            if (encoded[index + 1] >= mHeader->stringCount)
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool CallStreamReader::validateFunctions() const
+{
+    for (uint32_t functionIndex = 0; functionIndex < mHeader->functionCount; ++functionIndex)
+    {
+        const CallStreamFunction &function = mFunctions[functionIndex];
+        if (function.nameIndex >= mHeader->stringCount || !validateCalls(function))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool CallStreamReader::validateCalls(const CallStreamFunction &function) const
+{
+    // The calls of all functions lie between the header and the function table.
+    const uint64_t callsEnd = mHeader->functionTableOffset;
+    if (!IsAligned(function.callsOffset) || function.callsOffset < sizeof(CallStreamHeader) ||
+        function.callsOffset > callsEnd)
+    {
+        return false;
+    }
+
+    uint64_t offset = function.callsOffset;
+    for (uint32_t callIndex = 0; callIndex < function.callCount; ++callIndex)
+    {
+        if (callsEnd - offset < sizeof(CallStreamCall))
+        {
+            return false;
+        }
+        const CallStreamCall *call = GetSection<CallStreamCall>(mData, offset);
+        offset += sizeof(CallStreamCall);
+
+        if (call->entryPoint == static_cast<uint16_t>(EntryPoint::Invalid) &&
+            call->customNameIndex >= mHeader->stringCount)
+        {
+            return false;
+        }
+
+        if ((callsEnd - offset) / sizeof(CallStreamParam) < call->paramCount)
+        {
+            return false;
+        }
+        const CallStreamParam *params = GetSection<CallStreamParam>(mData, offset);
+        offset += call->paramCount * sizeof(CallStreamParam);
+
+        for (uint16_t paramIndex = 0; paramIndex < call->paramCount; ++paramIndex)
+        {
+            const CallStreamParam &param = params[paramIndex];
+            if (param.type >= kParamTypeCount)
+            {
+                return false;
+            }
+
+            bool valid = true;
+            switch (param.source)
+            {
+                case CallStreamParamSource::Value:
+                case CallStreamParamSource::BinaryData:
+                case CallStreamParamSource::ReadBuffer:
+                case CallStreamParamSource::ResourceIDBuffer:
+                    // The fixture buffers are only allocated when the trace is set up.
+                    break;
+                case CallStreamParamSource::String:
+                    valid = param.payload < mHeader->stringCount;
+                    break;
+                case CallStreamParamSource::StringArray:
+                    valid = param.payload < mHeader->stringArrayCount;
+                    break;
+                case CallStreamParamSource::ClientArray:
+                    valid = param.payload < kMaxClientArrays;
+                    break;
+                default:
+                    valid = false;
+                    break;
+            }
+            if (!valid)
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool CallStreamReader::validateFrames() const
+{
+    for (uint32_t frame = 0; frame < mHeader->frameCount; ++frame)
+    {
+        // Frames are looked up with a binary search.
+        if (mFrames[frame].functionIndex >= mHeader->functionCount ||
+            (frame > 0 && mFrames[frame].frameIndex <= mFrames[frame - 1].frameIndex))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+const char *CallStreamReader::getFunctionName(uint32_t functionIndex) const
+{
+    ASSERT(functionIndex < mHeader->functionCount);
+    return getString(mFunctions[functionIndex].nameIndex);
+}
+
+bool CallStreamReader::findFunction(const char *name, uint32_t *functionIndexOut) const
+{
+    auto iter = mFunctionIndices.find(name);
+    if (iter == mFunctionIndices.end())
+    {
+        return false;
+    }
+    *functionIndexOut = iter->second;
+    return true;
+}
+
+bool CallStreamReader::findFrameFunction(uint32_t frameIndex, uint32_t *functionIndexOut) const
+{
+    const CallStreamFrame *framesEnd = mFrames + mHeader->frameCount;
+    const CallStreamFrame *frame =
+        std::lower_bound(mFrames, framesEnd, frameIndex,
+                         [](const CallStreamFrame &entry, uint32_t index) {
+                             return entry.frameIndex < index;
+                         });
+    if (frame == framesEnd || frame->frameIndex != frameIndex)
+    {
+        return false;
+    }
+    *functionIndexOut = frame->functionIndex;
+    return true;
+}
+
+void CallStreamReader::decodeFunction(uint32_t functionIndex, std::vector<CallCapture> *callsOut)
+{
+    ASSERT(functionIndex < mHeader->functionCount);
+    const CallStreamFunction &function = mFunctions[functionIndex];
+
+    const uint8_t *ptr = mData + function.callsOffset;
+    callsOut->reserve(callsOut->size() + function.callCount);
+    for (uint32_t callIndex = 0; callIndex < function.callCount; ++callIndex)
+    {
+        const CallStreamCall *call = reinterpret_cast<const CallStreamCall *>(ptr);
+        const CallStreamParam *encodedParams =
+            reinterpret_cast<const CallStreamParam *>(ptr + sizeof(CallStreamCall));
+        ptr += sizeof(CallStreamCall) + call->paramCount * sizeof(CallStreamParam);
+        ASSERT(ptr <= mData + mSize);
+
+        ParamBuffer params;
+        for (uint16_t paramIndex = 0; paramIndex < call->paramCount; ++paramIndex)
+        {
+            decodeParam(encodedParams[paramIndex], &params);
+        }
+
+        EntryPoint entryPoint = static_cast<EntryPoint>(call->entryPoint);
+        if (entryPoint == EntryPoint::Invalid)
+        {
+            callsOut->emplace_back(getString(call->customNameIndex), std::move(params));
+        }
+        else
+        {
+            callsOut->emplace_back(entryPoint, std::move(params));
+        }
+    }
+}
+
+const char *CallStreamReader::getString(uint32_t stringIndex) const
+{
+    ASSERT(stringIndex < mHeader->stringCount);
+    return reinterpret_cast<const char *>(mData + mStringOffsets[stringIndex]);
+}
+
+const char *const *CallStreamReader::getStringArray(uint32_t stringArrayIndex)
+{
+    ASSERT(stringArrayIndex < mHeader->stringArrayCount);
+
+    std::vector<const char *> &pointers = mStringArrays[stringArrayIndex];
+    if (pointers.empty())
+    {
+        const uint32_t *encoded =
+            reinterpret_cast<const uint32_t *>(mData + mStringArrayOffsets[stringArrayIndex]);
+        for (uint32_t index = 0; index < encoded[0]; ++index)
+        {
+            pointers.push_back(getString(encoded[index + 1]));
+        }
+    }
+    return pointers.data();
+}
+
+void CallStreamReader::decodeParam(const CallStreamParam &encoded, ParamBuffer *params)
+{
+    ParamCapture param(params->getNextParamName(), static_cast<ParamType>(encoded.type));
+
+    switch (encoded.source)
+    {
+        case CallStreamParamSource::Value:
+            memcpy(&param.value, &encoded.payload, sizeof(ParamValue));
+            break;
+        case CallStreamParamSource::String:
+            param.value.voidConstPointerVal = getString(static_cast<uint32_t>(encoded.payload));
+            break;
+        case CallStreamParamSource::StringArray:
+            param.value.GLcharConstPointerPointerVal =
+                getStringArray(static_cast<uint32_t>(encoded.payload));
+            break;
+        case CallStreamParamSource::BinaryData:
+            ASSERT(gBinaryData);
+            param.value.voidPointerVal = gBinaryData + encoded.payload;
+            break;
+        case CallStreamParamSource::ReadBuffer:
+            param.value.voidPointerVal = gReadBuffer + encoded.payload;
+            break;
+        case CallStreamParamSource::ClientArray:
+            param.value.voidPointerVal = gClientArrays[encoded.payload];
+            break;
+        case CallStreamParamSource::ResourceIDBuffer:
+            param.value.voidPointerVal = gResourceIDBuffer;
+            break;
+        default:
+            UNREACHABLE();
+            break;
+    }
+
+    params->addParam(std::move(param));
+}
+}  // namespace angle
@@ -0,0 +1,186 @@
+//
+// Copyright 2024 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// trace_call_stream.h:
+//   A compact binary form of the calls in a trace, which the interpreter can map into memory and
+//   decode one function at a time instead of parsing the C sources of the whole trace up front.
+//
+//   The file starts with a CallStreamHeader, followed by the calls of all functions, the
+//   function table, the frame index and the string tables.  Every section is 8-byte aligned so
+//   the file can be used in place once mapped.
+//
+//   The header records a hash of the trace sources the stream was generated from, so a stream
+//   left over from another version of the trace is detected and regenerated.
+//
+
+#ifndef ANGLE_TRACE_CALL_STREAM_H_
+#define ANGLE_TRACE_CALL_STREAM_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "common/frame_capture_utils.h"
+
+namespace angle
+{
+constexpr char kCallStreamMagic[8]   = {'A', 'N', 'G', 'L', 'E', 'C', 'S', '\0'};
+constexpr uint32_t kCallStreamVersion = 3;
+constexpr uint32_t kCallStreamNoName  = 0xFFFFFFFFu;
+
+// Where the value of a parameter comes from at replay time.
+enum class CallStreamParamSource : uint8_t
+{
+    // The payload holds the bits of the ParamValue.
+    Value,
+    // The payload is an index in the string table.
+    String,
+    // The payload is an index in the string array table.
+    StringArray,
+    // The payload is an offset in gBinaryData.
+    BinaryData,
+    // The payload is an offset in gReadBuffer.
+    ReadBuffer,
+    // The payload is an index in gClientArrays.
+    ClientArray,
+    // The parameter is gResourceIDBuffer.
+    ResourceIDBuffer,
+};
+
+struct CallStreamHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t functionCount;
+    uint32_t frameCount;
+    uint32_t stringCount;
+    uint32_t stringArrayCount;
+    uint32_t padding;
+    uint64_t functionTableOffset;
+    uint64_t frameIndexOffset;
+    // Offsets of each string, which are stored null-terminated.
+    uint64_t stringTableOffset;
+    // Offsets of each string array, stored as a count followed by string indices.
+    uint64_t stringArrayTableOffset;
+    uint64_t fileSize;
+    // Hash of the trace sources, see ComputeCallStreamSourceHash.
+    uint64_t sourceHash;
+};
+
+struct CallStreamFunction
+{
+    uint32_t nameIndex;
+    uint32_t callCount;
+    uint64_t callsOffset;
+};
+
+struct CallStreamFrame
+{
+    uint32_t frameIndex;
+    uint32_t functionIndex;
+};
+
+// Each call is a CallStreamCall followed by |paramCount| CallStreamParams.
+struct CallStreamCall
+{
+    uint16_t entryPoint;
+    uint16_t paramCount;
+    // Name of the fixture or trace function for calls to EntryPoint::Invalid.
+    uint32_t customNameIndex;
+};
+
+struct CallStreamParam
+{
+    uint16_t type;
+    CallStreamParamSource source;
+    uint8_t padding[5];
+    uint64_t payload;
+};
+
+static_assert(sizeof(CallStreamHeader) % 8 == 0, "Header must keep the sections aligned");
+static_assert(sizeof(CallStreamFunction) == 16, "Unexpected function table entry size");
+static_assert(sizeof(CallStreamCall) == 8, "Unexpected call size");
+static_assert(sizeof(CallStreamParam) == 16, "Unexpected parameter size");
+static_assert(sizeof(ParamValue) <= sizeof(uint64_t), "ParamValue must fit in a payload");
+static_assert(kParamTypeCount <= 0xFFFF, "ParamType must fit in 16 bits");
+
+// Hashes the contents of the files a call stream is generated from.  Returns false if any of them
+// can't be read.
+bool ComputeCallStreamSourceHash(const std::vector<std::string> &paths, uint64_t *hashOut);
+
+class CallStreamWriter : angle::NonCopyable
+{
+  public:
+    CallStreamWriter();
+    ~CallStreamWriter();
+
+    uint32_t addString(const char *str, size_t length);
+    uint32_t addStringArray(const std::vector<std::string> &strings);
+
+    void beginFunction(const std::string &name);
+    void addCall(EntryPoint entryPoint,
+                 const std::string &customFunctionName,
+                 const std::vector<CallStreamParam> &params);
+    void endFunction();
+
+    bool save(const std::string &path, uint64_t sourceHash) const;
+
+  private:
+    std::vector<uint8_t> mCalls;
+    std::vector<CallStreamFunction> mFunctions;
+    std::vector<CallStreamFrame> mFrames;
+    std::vector<std::string> mStrings;
+    std::map<std::string, uint32_t> mStringIndices;
+    std::vector<std::vector<uint32_t>> mStringArrays;
+    std::map<std::vector<uint32_t>, uint32_t> mStringArrayIndices;
+    bool mInFunction = false;
+};
+
+// Decodes a mapped call stream.  The returned strings point into the mapping, so it must outlive
+// the decoded calls.
+class CallStreamReader : angle::NonCopyable
+{
+  public:
+    CallStreamReader();
+    ~CallStreamReader();
+
+    // Returns false if the data is not a call stream of this version, or any offset, count or
+    // index in it is out of range.  The reader must not be used after a failed init.
+    bool init(const uint8_t *data, size_t size);
+
+    uint64_t getSourceHash() const { return mHeader->sourceHash; }
+    uint32_t getFunctionCount() const { return mHeader->functionCount; }
+    const char *getFunctionName(uint32_t functionIndex) const;
+    bool findFunction(const char *name, uint32_t *functionIndexOut) const;
+    bool findFrameFunction(uint32_t frameIndex, uint32_t *functionIndexOut) const;
+
+    // Decodes the calls of a function.  Pointers to trace data are resolved against the current
+    // fixture buffers, so this must only be called after InitReplay.
+    void decodeFunction(uint32_t functionIndex, std::vector<CallCapture> *callsOut);
+
+  private:
+    bool validateStrings() const;
+    bool validateFunctions() const;
+    bool validateCalls(const CallStreamFunction &function) const;
+    bool validateFrames() const;
+
+    const char *getString(uint32_t stringIndex) const;
+    const char *const *getStringArray(uint32_t stringArrayIndex);
+    void decodeParam(const CallStreamParam &encoded, ParamBuffer *params);
+
+    const uint8_t *mData                 = nullptr;
+    size_t mSize                         = 0;
+    const CallStreamHeader *mHeader      = nullptr;
+    const CallStreamFunction *mFunctions = nullptr;
+    const CallStreamFrame *mFrames       = nullptr;
+    const uint64_t *mStringOffsets       = nullptr;
+    const uint64_t *mStringArrayOffsets  = nullptr;
+    std::map<std::string, uint32_t> mFunctionIndices;
+    // String arrays are only materialized on first use.
+    std::map<uint32_t, std::vector<const char *>> mStringArrays;
+};
+}  // namespace angle
+
+#endif  // ANGLE_TRACE_CALL_STREAM_H_
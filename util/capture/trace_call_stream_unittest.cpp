@@ -0,0 +1,323 @@
+//
+// Copyright 2024 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// trace_call_stream_unittest.cpp: Tests writing and reading back the trace call stream.
+
+#include <gtest/gtest.h>
+
+#include <string.h>
+
+#include <fstream>
+
+#include "common/string_utils.h"
+#include "common/system_utils.h"
+#include "trace_call_stream.h"
+#include "util/test_utils.h"
+
+using namespace angle;
+
+namespace
+{
+constexpr uint64_t kSourceHash = 0x0123456789ABCDEFull;
+
+CallStreamParam MakeParam(ParamType type, CallStreamParamSource source, uint64_t payload)
+{
+    CallStreamParam param = {};
+    param.type            = static_cast<uint16_t>(type);
+    param.source          = source;
+    param.payload         = payload;
+    return param;
+}
+
+class TraceCallStreamTest : public testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        Optional<std::string> path = CreateTemporaryFile();
+        ASSERT_TRUE(path.valid());
+        mPath = path.value();
+    }
+
+    void TearDown() override { DeleteSystemFile(mPath.c_str()); }
+
+    // Writes a stream with a setup function calling a custom function, and two frames written
+    // out of order.
+    void writeStream()
+    {
+        CallStreamWriter writer;
+
+        uint32_t nameIndex  = writer.addString("name", 4);
+        uint32_t arrayIndex = writer.addStringArray({"first", "second"});
+
+        writer.beginFunction("SetupReplay");
+        writer.addCall(EntryPoint::Invalid, "SetupReplayContext1", {});
+        writer.endFunction();
+
+        writer.beginFunction("SetupReplayContext1");
+        writer.addCall(EntryPoint::GLGetUniformLocation, "",
+                       {MakeParam(ParamType::TShaderProgramID, CallStreamParamSource::Value, 3),
+                        MakeParam(ParamType::TGLcharConstPointer, CallStreamParamSource::String,
+                                  nameIndex)});
+        writer.addCall(EntryPoint::GLTransformFeedbackVaryings, "",
+                       {MakeParam(ParamType::TShaderProgramID, CallStreamParamSource::Value, 3),
+                        MakeParam(ParamType::TGLsizei, CallStreamParamSource::Value, 2),
+                        MakeParam(ParamType::TGLcharConstPointerPointer,
+                                  CallStreamParamSource::StringArray, arrayIndex),
+                        MakeParam(ParamType::TGLenum, CallStreamParamSource::Value,
+                                  GL_INTERLEAVED_ATTRIBS)});
+        writer.endFunction();
+
+        writer.beginFunction("ReplayFrame2");
+        writer.addCall(EntryPoint::GLClear, "",
+                       {MakeParam(ParamType::TGLbitfield, CallStreamParamSource::Value,
+                                  GL_DEPTH_BUFFER_BIT)});
+        writer.endFunction();
+
+        writer.beginFunction("ReplayFrame1");
+        writer.addCall(EntryPoint::GLClear, "",
+                       {MakeParam(ParamType::TGLbitfield, CallStreamParamSource::Value,
+                                  GL_COLOR_BUFFER_BIT)});
+        writer.endFunction();
+
+        ASSERT_TRUE(writer.save(mPath, kSourceHash));
+    }
+
+    std::vector<uint8_t> readStream()
+    {
+        std::string fileData;
+        EXPECT_TRUE(ReadFileToString(mPath, &fileData));
+        return std::vector<uint8_t>(fileData.begin(), fileData.end());
+    }
+
+    CallStreamHeader *getHeader(std::vector<uint8_t> *data)
+    {
+        return reinterpret_cast<CallStreamHeader *>(data->data());
+    }
+
+    bool initReader(const std::vector<uint8_t> &data)
+    {
+        CallStreamReader reader;
+        return reader.init(data.data(), data.size());
+    }
+
+    std::string mPath;
+};
+
+// Tests that functions, frames and parameters are read back as written.
+TEST_F(TraceCallStreamTest, RoundTrip)
+{
+    writeStream();
+
+    MemoryMappedFile file;
+    ASSERT_TRUE(file.open(mPath.c_str()));
+
+    CallStreamReader reader;
+    ASSERT_TRUE(reader.init(file.data(), file.size()));
+    EXPECT_EQ(kSourceHash, reader.getSourceHash());
+    EXPECT_EQ(4u, reader.getFunctionCount());
+
+    uint32_t functionIndex = 0;
+    EXPECT_FALSE(reader.findFunction("ReplayFrame3", &functionIndex));
+    ASSERT_TRUE(reader.findFunction("SetupReplay", &functionIndex));
+    EXPECT_STREQ("SetupReplay", reader.getFunctionName(functionIndex));
+
+    std::vector<CallCapture> calls;
+    reader.decodeFunction(functionIndex, &calls);
+    ASSERT_EQ(1u, calls.size());
+    EXPECT_EQ(EntryPoint::Invalid, calls[0].entryPoint);
+    EXPECT_EQ("SetupReplayContext1", calls[0].customFunctionName);
+    EXPECT_TRUE(calls[0].params.getParamCaptures().empty());
+
+    ASSERT_TRUE(reader.findFunction("SetupReplayContext1", &functionIndex));
+    calls.clear();
+    reader.decodeFunction(functionIndex, &calls);
+    ASSERT_EQ(2u, calls.size());
+
+    EXPECT_EQ(EntryPoint::GLGetUniformLocation, calls[0].entryPoint);
+    const std::vector<ParamCapture> &uniformParams = calls[0].params.getParamCaptures();
+    ASSERT_EQ(2u, uniformParams.size());
+    EXPECT_EQ(ParamType::TShaderProgramID, uniformParams[0].type);
+    EXPECT_EQ(3u, uniformParams[0].value.ShaderProgramIDVal.value);
+    EXPECT_EQ(ParamType::TGLcharConstPointer, uniformParams[1].type);
+    EXPECT_STREQ("name", static_cast<const char *>(uniformParams[1].value.voidConstPointerVal));
+
+    EXPECT_EQ(EntryPoint::GLTransformFeedbackVaryings, calls[1].entryPoint);
+    const std::vector<ParamCapture> &varyingsParams = calls[1].params.getParamCaptures();
+    ASSERT_EQ(4u, varyingsParams.size());
+    const GLchar *const *varyings = varyingsParams[2].value.GLcharConstPointerPointerVal;
+    EXPECT_STREQ("first", varyings[0]);
+    EXPECT_STREQ("second", varyings[1]);
+    EXPECT_EQ(static_cast<GLenum>(GL_INTERLEAVED_ATTRIBS), varyingsParams[3].value.GLenumVal);
+
+    // Frames are found by index regardless of the order they were written in.
+    const GLbitfield kFrameMasks[] = {GL_COLOR_BUFFER_BIT, GL_DEPTH_BUFFER_BIT};
+    for (uint32_t frameIndex = 1; frameIndex <= 2; ++frameIndex)
+    {
+        ASSERT_TRUE(reader.findFrameFunction(frameIndex, &functionIndex));
+        EXPECT_EQ("ReplayFrame" + std::to_string(frameIndex),
+                  reader.getFunctionName(functionIndex));
+
+        calls.clear();
+        reader.decodeFunction(functionIndex, &calls);
+        ASSERT_EQ(1u, calls.size());
+        EXPECT_EQ(EntryPoint::GLClear, calls[0].entryPoint);
+        EXPECT_EQ(kFrameMasks[frameIndex - 1],
+                  calls[0].params.getParamCaptures()[0].value.GLbitfieldVal);
+    }
+    EXPECT_FALSE(reader.findFrameFunction(3, &functionIndex));
+}
+
+// Tests that streams of another version, or truncated, are rejected.
+TEST_F(TraceCallStreamTest, InvalidHeader)
+{
+    writeStream();
+    std::vector<uint8_t> data = readStream();
+    ASSERT_TRUE(initReader(data));
+
+    std::vector<uint8_t> badMagic = data;
+    badMagic[0]                   = 'X';
+    EXPECT_FALSE(initReader(badMagic));
+
+    std::vector<uint8_t> badVersion = data;
+    getHeader(&badVersion)->version = kCallStreamVersion - 1;
+    EXPECT_FALSE(initReader(badVersion));
+
+    std::vector<uint8_t> truncated(data.begin(), data.end() - 8);
+    EXPECT_FALSE(initReader(truncated));
+
+    // Even if the header is updated to match.
+    getHeader(&truncated)->fileSize = truncated.size();
+    EXPECT_FALSE(initReader(truncated));
+
+    std::vector<uint8_t> headerOnly(data.begin(), data.begin() + sizeof(CallStreamHeader) - 1);
+    EXPECT_FALSE(initReader(headerOnly));
+}
+
+// Tests that out of range offsets, counts and indices in the stream are rejected.
+TEST_F(TraceCallStreamTest, InvalidContents)
+{
+    writeStream();
+    const std::vector<uint8_t> data = readStream();
+    const CallStreamHeader header   = *reinterpret_cast<const CallStreamHeader *>(data.data());
+
+    auto getFunction = [&header](std::vector<uint8_t> *stream, uint32_t functionIndex) {
+        return reinterpret_cast<CallStreamFunction *>(stream->data() +
+                                                      header.functionTableOffset) +
+               functionIndex;
+    };
+
+    // SetupReplayContext1's first call, whose second parameter is a string.
+    const CallStreamFunction *functions =
+        reinterpret_cast<const CallStreamFunction *>(data.data() + header.functionTableOffset);
+    const uint64_t callOffset = functions[1].callsOffset;
+
+    auto getCall = [callOffset](std::vector<uint8_t> *stream) {
+        return reinterpret_cast<CallStreamCall *>(stream->data() + callOffset);
+    };
+    auto getParam = [callOffset](std::vector<uint8_t> *stream, uint32_t paramIndex) {
+        return reinterpret_cast<CallStreamParam *>(stream->data() + callOffset +
+                                                   sizeof(CallStreamCall)) +
+               paramIndex;
+    };
+
+    const uint64_t arrayOffset =
+        *reinterpret_cast<const uint64_t *>(data.data() + header.stringArrayTableOffset);
+    auto getStringArray = [arrayOffset](std::vector<uint8_t> *stream) {
+        return reinterpret_cast<uint32_t *>(stream->data() + arrayOffset);
+    };
+
+    // Table offsets out of the file.
+    std::vector<uint8_t> corrupt                = data;
+    getHeader(&corrupt)->stringArrayTableOffset = data.size();
+    EXPECT_FALSE(initReader(corrupt));
+
+    // Too many functions for the function table.
+    corrupt                            = data;
+    getHeader(&corrupt)->functionCount = header.functionCount + 1000;
+    EXPECT_FALSE(initReader(corrupt));
+
+    // A function name out of the string table.
+    corrupt                             = data;
+    getFunction(&corrupt, 0)->nameIndex = header.stringCount;
+    EXPECT_FALSE(initReader(corrupt));
+
+    // Calls running past the calls section.
+    corrupt                             = data;
+    getFunction(&corrupt, 0)->callCount = 1000;
+    EXPECT_FALSE(initReader(corrupt));
+
+    corrupt                               = data;
+    getFunction(&corrupt, 0)->callsOffset = header.functionTableOffset + 8;
+    EXPECT_FALSE(initReader(corrupt));
+
+    // A call with too many parameters.
+    corrupt                       = data;
+    getCall(&corrupt)->paramCount = 1000;
+    EXPECT_FALSE(initReader(corrupt));
+
+    // A string parameter out of the string table.
+    corrupt                        = data;
+    getParam(&corrupt, 1)->payload = header.stringCount;
+    EXPECT_FALSE(initReader(corrupt));
+
+    // An unknown parameter source.
+    corrupt                       = data;
+    getParam(&corrupt, 1)->source = static_cast<CallStreamParamSource>(0xFF);
+    EXPECT_FALSE(initReader(corrupt));
+
+    // A frame of a function that doesn't exist.
+    corrupt = data;
+    reinterpret_cast<CallStreamFrame *>(corrupt.data() + header.frameIndexOffset)->functionIndex =
+        header.functionCount;
+    EXPECT_FALSE(initReader(corrupt));
+
+    // A string that isn't terminated before the end of the file.
+    corrupt = data;
+    *reinterpret_cast<uint64_t *>(corrupt.data() + header.stringTableOffset) = data.size() - 1;
+    corrupt.back()                                                           = 'x';
+    EXPECT_FALSE(initReader(corrupt));
+
+    // A string array referencing a string that doesn't exist.
+    corrupt                     = data;
+    getStringArray(&corrupt)[1] = header.stringCount;
+    EXPECT_FALSE(initReader(corrupt));
+
+    // A string array longer than the file.
+    corrupt                     = data;
+    getStringArray(&corrupt)[0] = 1000;
+    EXPECT_FALSE(initReader(corrupt));
+}
+
+// Tests that the source hash changes with the contents of any of the sources.
+TEST_F(TraceCallStreamTest, SourceHash)
+{
+    Optional<std::string> otherPath = CreateTemporaryFile();
+    ASSERT_TRUE(otherPath.valid());
+
+    auto writeFile = [](const std::string &path, const char *contents) {
+        std::ofstream out(path, std::ios::binary);
+        out << contents;
+    };
+    writeFile(mPath, "void SetupReplay() {}");
+    writeFile(otherPath.value(), "void ReplayFrame1() {}");
+
+    const std::vector<std::string> paths = {mPath, otherPath.value()};
+    uint64_t hash                         = 0;
+    ASSERT_TRUE(ComputeCallStreamSourceHash(paths, &hash));
+
+    uint64_t sameHash = 0;
+    ASSERT_TRUE(ComputeCallStreamSourceHash(paths, &sameHash));
+    EXPECT_EQ(hash, sameHash);
+
+    writeFile(otherPath.value(), "void ReplayFrame1() { glFlush(); }");
+    uint64_t changedHash = 0;
+    ASSERT_TRUE(ComputeCallStreamSourceHash(paths, &changedHash));
+    EXPECT_NE(hash, changedHash);
+
+    EXPECT_TRUE(DeleteSystemFile(otherPath.value().c_str()));
+    EXPECT_FALSE(ComputeCallStreamSourceHash(paths, &hash));
+}
+}  // anonymous namespace
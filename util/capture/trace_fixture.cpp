@@ -55,8 +55,6 @@ EGLClientBuffer GetClientBuffer(EGLenum target, uintptr_t key)
 
 ValidateSerializedStateCallback gValidateSerializedStateCallback;
 std::unordered_map<GLuint, std::vector<GLint>> gInternalUniformLocationsMap;
-
-constexpr size_t kMaxClientArrays = 16;
 }  // namespace
 
 GLint **gUniformLocations;
@@ -305,6 +303,11 @@ void InitializeReplay(const char *binaryDataFileName,
 
 void FinishReplay()
 {
+    if (gFinishReplayCallback)
+    {
+        gFinishReplayCallback();
+    }
+
     for (uint8_t *&clientArray : gClientArrays)
     {
         delete[] clientArray;
@@ -339,6 +342,9 @@ void SetValidateSerializedStateCallback(ValidateSerializedStateCallback callback
 
 angle::TraceInfo gTraceInfo;
 std::string gTraceGzPath;
+std::string gTraceCallStreamPath;
+bool gThreadedReplay;
+FinishReplayCallback gFinishReplayCallback;
 
 struct TraceFunctionsImpl : angle::TraceFunctions
 {
@@ -360,6 +366,13 @@ struct TraceFunctionsImpl : angle::TraceFunctions
     void SetTraceInfo(const angle::TraceInfo &traceInfo) override { gTraceInfo = traceInfo; }
 
     void SetTraceGzPath(const std::string &traceGzPath) override { gTraceGzPath = traceGzPath; }
+
+    void SetTraceCallStreamPath(const std::string &traceCallStreamPath) override
+    {
+        gTraceCallStreamPath = traceCallStreamPath;
+    }
+
+    void SetThreadedReplay(bool threadedReplay) override { gThreadedReplay = threadedReplay; }
 };
 
 TraceFunctionsImpl gTraceFunctionsImpl;
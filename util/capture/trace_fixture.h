@@ -46,6 +46,13 @@ extern ContextMap gContextMap;
 extern std::string gBinaryDataDir;
 extern angle::TraceInfo gTraceInfo;
 extern std::string gTraceGzPath;
+extern std::string gTraceCallStreamPath;
+extern bool gThreadedReplay;
+
+// Called by FinishReplay before the replay state is released. The interpreter uses it to stop the
+// threads that replay secondary contexts.
+using FinishReplayCallback = void (*)();
+extern FinishReplayCallback gFinishReplayCallback;
 
 using ValidateSerializedStateCallback = void (*)(const char *, const char *, uint32_t);
 
@@ -80,9 +87,11 @@ void UpdateCurrentProgram(GLuint program);
 
 // Global state
 
+constexpr size_t kMaxClientArrays = 16;
+
 extern uint8_t *gBinaryData;
 extern uint8_t *gReadBuffer;
-extern uint8_t *gClientArrays[];
+extern uint8_t *gClientArrays[kMaxClientArrays];
 extern GLuint *gResourceIDBuffer;
 
 extern GLuint *gBufferMap;
@@ -66,6 +66,12 @@ struct TraceFunctions
     virtual void SetReplayResourceMode(const ReplayResourceMode resourceMode) = 0;
     virtual void SetTraceGzPath(const std::string &traceGzPath)               = 0;
     virtual void SetTraceInfo(const TraceInfo &traceInfo)                     = 0;
+    // Only used by the interpreter, which replays from the call stream at this path if it exists
+    // and writes it otherwise.
+    virtual void SetTraceCallStreamPath(const std::string &traceCallStreamPath) = 0;
+    // Only used by the interpreter, which replays the calls of each secondary context on its own
+    // thread when enabled.
+    virtual void SetThreadedReplay(bool threadedReplay) = 0;
 
     virtual ~TraceFunctions() {}
 };
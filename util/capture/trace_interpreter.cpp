@@ -9,10 +9,19 @@
 
 #include "trace_interpreter.h"
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "angle_trace_gl.h"
 #include "anglebase/no_destructor.h"
 #include "common/gl_enum_utils.h"
 #include "common/string_utils.h"
+#include "common/system_utils.h"
+#include "trace_call_stream.h"
 #include "trace_fixture.h"
+#include "trace_replay_schedule.h"
 
 #define USE_SYSTEM_ZLIB
 #include "compression_utils_portable.h"
@@ -26,12 +35,235 @@ bool ShouldParseFile(const std::string &file)
     return EndsWith(file, ".c") || EndsWith(file, ".cpp");
 }
 
+std::string GetTraceFilePath(const std::string &file)
+{
+    std::stringstream pathStream;
+    pathStream << gBinaryDataDir << GetPathSeparator() << file;
+    return pathStream.str();
+}
+
+// Hashes the files the trace is parsed from, to tell whether a saved call stream is up to date.
+bool GetTraceSourceHash(uint64_t *hashOut)
+{
+    std::vector<std::string> paths;
+    if (!gTraceGzPath.empty())
+    {
+        paths.push_back(gTraceGzPath);
+    }
+    else
+    {
+        for (const std::string &file : gTraceInfo.traceFiles)
+        {
+            if (ShouldParseFile(file))
+            {
+                paths.push_back(GetTraceFilePath(file));
+            }
+        }
+    }
+
+    return ComputeCallStreamSourceHash(paths, hashOut);
+}
+
+void MakeContextCurrent(GLuint contextID)
+{
+    eglMakeCurrent(gEGLDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, gContextMap2[contextID]);
+}
+
+void ReplayTraceFunction(const TraceFunction &func, const TraceFunctionMap &customFunctions);
+
+void ReplayTraceCall(const CallCapture &call, const TraceFunctionMap &customFunctions)
+{
+    if (IsMakeCurrentByContextID(call))
+    {
+        // Contexts are created during the replay, so they are looked up when made current.
+        MakeContextCurrent(GetMakeCurrentContextID(call));
+        return;
+    }
+
+    auto iter = customFunctions.find(call.customFunctionName);
+    if (call.entryPoint == EntryPoint::Invalid && iter != customFunctions.end())
+    {
+        ASSERT(call.params.empty());
+        ReplayTraceFunction(iter->second, customFunctions);
+        return;
+    }
+
+    ReplayTraceFunctionCall(call, customFunctions);
+}
+
 void ReplayTraceFunction(const TraceFunction &func, const TraceFunctionMap &customFunctions)
 {
     for (const CallCapture &call : func)
     {
-        ReplayTraceFunctionCall(call, customFunctions);
+        ReplayTraceCall(call, customFunctions);
+    }
+}
+
+void ReplaySegmentCalls(const ReplaySegment &segment, const TraceFunctionMap &customFunctions)
+{
+    for (const CallCapture *call : segment.calls)
+    {
+        ReplayTraceFunctionCall(*call, customFunctions);
+    }
+}
+
+// Replays the segments of one context in order, with the context current for the lifetime of the
+// thread.
+class ContextReplayThread : angle::NonCopyable
+{
+  public:
+    ContextReplayThread(GLuint contextID, const TraceFunctionMap &customFunctions)
+        : mContextID(contextID),
+          mCustomFunctions(customFunctions),
+          mThread(&ContextReplayThread::threadMain, this)
+    {}
+
+    ~ContextReplayThread()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mStopping = true;
+        }
+        mCondition.notify_all();
+        mThread.join();
+    }
+
+    void enqueue(const ReplaySegment *segment)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mSegments.push_back(segment);
+            if (segment->writesSharedObjects)
+            {
+                mPendingWriteCount++;
+            }
+        }
+        mCondition.notify_all();
+    }
+
+    void waitIdle()
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mCondition.wait(lock, [this] { return mSegments.empty(); });
+    }
+
+    // Returns true while a segment writing shared objects is queued or being replayed.
+    bool hasPendingWrites()
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mPendingWriteCount > 0;
+    }
+
+  private:
+    void threadMain()
+    {
+        MakeContextCurrent(mContextID);
+
+        std::unique_lock<std::mutex> lock(mMutex);
+        while (true)
+        {
+            mCondition.wait(lock, [this] { return mStopping || !mSegments.empty(); });
+            if (mSegments.empty())
+            {
+                break;
+            }
+
+            // The segment is only removed once replayed, so waitIdle() also waits for it.
+            const ReplaySegment *segment = mSegments.front();
+            lock.unlock();
+            ReplaySegmentCalls(*segment, mCustomFunctions);
+            lock.lock();
+
+            mSegments.pop_front();
+            if (segment->writesSharedObjects)
+            {
+                mPendingWriteCount--;
+            }
+            mCondition.notify_all();
+        }
+        lock.unlock();
+
+        // Release the context so it can be made current on the main thread again.
+        eglMakeCurrent(gEGLDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
     }
+
+    GLuint mContextID;
+    const TraceFunctionMap &mCustomFunctions;
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    std::deque<const ReplaySegment *> mSegments;
+    size_t mPendingWriteCount = 0;
+    bool mStopping            = false;
+    std::thread mThread;
+};
+
+uint64_t GetTokenOffset(const Token &token, const char *prefixString)
+{
+    return strtoull(&token[strlen(prefixString)], nullptr, 10);
+}
+
+// Records where each parameter of a parsed call comes from, so the call stream can resolve
+// pointers to trace data when it is decoded in another process.
+void WriteCallToStream(CallStreamWriter *writer,
+                       const CallCapture &call,
+                       const Token *paramTokens,
+                       const TraceStringMap &strings)
+{
+    const std::vector<ParamCapture> &params = call.params.getParamCaptures();
+    std::vector<CallStreamParam> encodedParams(params.size());
+
+    for (size_t paramIndex = 0; paramIndex < params.size(); ++paramIndex)
+    {
+        const ParamCapture &param = params[paramIndex];
+        const Token &token        = paramTokens[paramIndex];
+        CallStreamParam &encoded  = encodedParams[paramIndex];
+
+        encoded.type   = static_cast<uint16_t>(param.type);
+        encoded.source = CallStreamParamSource::Value;
+
+        if (token[0] == '"')
+        {
+            ASSERT(param.data.size() == 1 && !param.data[0].empty());
+            const std::vector<uint8_t> &str = param.data[0];
+            encoded.source                  = CallStreamParamSource::String;
+            encoded.payload =
+                writer->addString(reinterpret_cast<const char *>(str.data()), str.size() - 1);
+        }
+        else if (BeginsWith(token, "&gBinaryData["))
+        {
+            encoded.source  = CallStreamParamSource::BinaryData;
+            encoded.payload = GetTokenOffset(token, "&gBinaryData[");
+        }
+        else if (BeginsWith(token, "&gReadBuffer["))
+        {
+            encoded.source  = CallStreamParamSource::ReadBuffer;
+            encoded.payload = GetTokenOffset(token, "&gReadBuffer[");
+        }
+        else if (strcmp(token, "gReadBuffer") == 0)
+        {
+            encoded.source = CallStreamParamSource::ReadBuffer;
+        }
+        else if (BeginsWith(token, "gClientArrays["))
+        {
+            encoded.source  = CallStreamParamSource::ClientArray;
+            encoded.payload = GetTokenOffset(token, "gClientArrays[");
+        }
+        else if (strcmp(token, "gResourceIDBuffer") == 0)
+        {
+            encoded.source = CallStreamParamSource::ResourceIDBuffer;
+        }
+        else if (param.type == ParamType::TGLcharConstPointerPointer)
+        {
+            encoded.source  = CallStreamParamSource::StringArray;
+            encoded.payload = writer->addStringArray(strings.at(token).strings);
+        }
+        else
+        {
+            memcpy(&encoded.payload, &param.value, sizeof(ParamValue));
+        }
+    }
+
+    writer->addCall(call.entryPoint, call.customFunctionName, encodedParams);
 }
 
 class Parser : angle::NonCopyable
@@ -40,10 +272,12 @@ class Parser : angle::NonCopyable
     Parser(const std::string &stream,
            TraceFunctionMap &functionsIn,
            TraceStringMap &stringsIn,
+           CallStreamWriter *callStreamWriter,
            bool verboseLogging)
         : mStream(stream),
           mFunctions(functionsIn),
           mStrings(stringsIn),
+          mCallStreamWriter(callStreamWriter),
           mIndex(0),
           mVerboseLogging(verboseLogging)
     {}
@@ -210,6 +444,11 @@ class Parser : angle::NonCopyable
             return;
         }
 
+        if (mCallStreamWriter)
+        {
+            mCallStreamWriter->beginFunction(funcName);
+        }
+
         skipLine();
         ASSERT(peek() == '{');
         skipLine();
@@ -265,11 +504,25 @@ class Parser : angle::NonCopyable
 
             // We pass in the strings for specific use with C string array parameters.
             CallCapture call = ParseCallCapture(nameToken, numParams, paramTokens, mStrings);
+
+            if (call.entryPoint == EntryPoint::EGLMakeCurrent)
+            {
+                ParseMakeCurrentContextID(paramTokens[3], &call);
+            }
+            if (mCallStreamWriter)
+            {
+                WriteCallToStream(mCallStreamWriter, call, paramTokens, mStrings);
+            }
             func.push_back(std::move(call));
             skipLine();
         }
         skipLine();
 
+        if (mCallStreamWriter)
+        {
+            mCallStreamWriter->endFunction();
+        }
+
         addFunction(funcName, func);
     }
 
@@ -326,6 +579,7 @@ class Parser : angle::NonCopyable
     const std::string &mStream;
     TraceFunctionMap &mFunctions;
     TraceStringMap &mStrings;
+    CallStreamWriter *mCallStreamWriter;
     size_t mIndex;
     bool mVerboseLogging = false;
 };
@@ -517,25 +771,167 @@ class TraceInterpreter : angle::NonCopyable
     void setupReplay();
     void resetReplay();
     const char *getSerializedContextState(uint32_t frameIndex);
+    void stopContextThreads();
 
   private:
-    void runTraceFunction(const char *name) const;
-    void parseTraceUncompressed();
-    void parseTraceGz();
+    void replayFrameThreaded(uint32_t frameIndex, const TraceFunction &frameFunc);
+    // Returns false if the function enables storage writes, which changes how earlier calls
+    // are scheduled.
+    bool scheduleFunction(const TraceFunction &func, GLuint contextID, ReplaySchedule *schedule);
+    void waitForContextThreads();
+    void runTraceFunction(const char *name);
+    void parseTraceUncompressed(CallStreamWriter *callStreamWriter);
+    void parseTraceGz(CallStreamWriter *callStreamWriter);
+    bool loadCallStream(uint64_t sourceHash);
+    const TraceFunction *getTraceFunction(const char *name);
+    const TraceFunction &decodeTraceFunction(uint32_t functionIndex);
 
     TraceFunctionMap mTraceFunctions;
     TraceStringMap mTraceStrings;
     bool mVerboseLogging = true;
+
+    // When replaying from a call stream, functions are decoded from the mapped file the first
+    // time they are needed.
+    MemoryMappedFile mCallStreamFile;
+    std::unique_ptr<CallStreamReader> mCallStream;
+    std::vector<const TraceFunction *> mDecodedFunctions;
+
+    // With threaded replay, frames are split into segments the first time they are replayed.
+    std::map<uint32_t, ReplaySchedule> mFrameSchedules;
+    std::map<GLuint, std::unique_ptr<ContextReplayThread>> mContextThreads;
+    // Whether storage buffers, images or transform feedback are used by the setup or any frame
+    // scheduled so far.
+    bool mShaderWritesEnabled = false;
 };
 
 void TraceInterpreter::replayFrame(uint32_t frameIndex)
 {
-    char funcName[kMaxTokenSize];
-    snprintf(funcName, kMaxTokenSize, "ReplayFrame%u", frameIndex);
-    runTraceFunction(funcName);
+    const TraceFunction *frameFunc = nullptr;
+    uint32_t functionIndex         = 0;
+    if (mCallStream && mCallStream->findFrameFunction(frameIndex, &functionIndex))
+    {
+        frameFunc = &decodeTraceFunction(functionIndex);
+    }
+    else
+    {
+        char funcName[kMaxTokenSize];
+        snprintf(funcName, kMaxTokenSize, "ReplayFrame%u", frameIndex);
+        frameFunc = getTraceFunction(funcName);
+        if (frameFunc == nullptr)
+        {
+            printf("Cannot find function: %s\n", funcName);
+            UNREACHABLE();
+            return;
+        }
+    }
+
+    if (gThreadedReplay)
+    {
+        replayFrameThreaded(frameIndex, *frameFunc);
+        return;
+    }
+
+    // Without threaded replay, the other contexts are made current on this thread again.
+    stopContextThreads();
+    ReplayTraceFunction(*frameFunc, mTraceFunctions);
+}
+
+void TraceInterpreter::replayFrameThreaded(uint32_t frameIndex, const TraceFunction &frameFunc)
+{
+    // Frames start and end on the context of the window surface.
+    const GLuint mainContextID = static_cast<GLuint>(gTraceInfo.windowSurfaceContextId);
+
+    auto scheduleIter = mFrameSchedules.find(frameIndex);
+    if (scheduleIter == mFrameSchedules.end())
+    {
+        ReplaySchedule schedule;
+        if (!scheduleFunction(frameFunc, mainContextID, &schedule))
+        {
+            // Storage writes enabled by this frame also apply to the frames scheduled before it.
+            mFrameSchedules.clear();
+            schedule.clear();
+            scheduleFunction(frameFunc, mainContextID, &schedule);
+        }
+        scheduleIter = mFrameSchedules.emplace(frameIndex, std::move(schedule)).first;
+    }
+
+    if (mContextThreads.empty())
+    {
+        // Release any other context from this thread before its own thread makes it current.
+        MakeContextCurrent(mainContextID);
+    }
+
+    for (const ReplaySegment &segment : scheduleIter->second)
+    {
+        if (segment.isSyncPoint)
+        {
+            waitForContextThreads();
+        }
+        else
+        {
+            // Switching contexts orders the segment after the earlier segments of the other
+            // contexts, unless neither writes objects shared between them.
+            for (auto &contextThread : mContextThreads)
+            {
+                if (contextThread.first != segment.contextID &&
+                    (segment.writesSharedObjects || contextThread.second->hasPendingWrites()))
+                {
+                    contextThread.second->waitIdle();
+                }
+            }
+        }
+
+        if (segment.contextID == mainContextID)
+        {
+            ReplaySegmentCalls(segment, mTraceFunctions);
+            continue;
+        }
+
+        std::unique_ptr<ContextReplayThread> &thread = mContextThreads[segment.contextID];
+        if (!thread)
+        {
+            thread.reset(new ContextReplayThread(segment.contextID, mTraceFunctions));
+        }
+        thread->enqueue(&segment);
+
+        if (segment.isSyncPoint)
+        {
+            thread->waitIdle();
+        }
+    }
+
+    waitForContextThreads();
+}
+
+bool TraceInterpreter::scheduleFunction(const TraceFunction &func,
+                                        GLuint contextID,
+                                        ReplaySchedule *schedule)
+{
+    // Which framebuffer is bound is only tracked within the function.
+    ReplayScheduleState state;
+    state.contextID           = contextID;
+    state.shaderWritesEnabled = mShaderWritesEnabled;
+    ScheduleTraceFunction(func, mTraceFunctions, &state, schedule);
+
+    bool wereShaderWritesEnabled = mShaderWritesEnabled;
+    mShaderWritesEnabled         = state.shaderWritesEnabled;
+    return wereShaderWritesEnabled || !mShaderWritesEnabled;
+}
+
+void TraceInterpreter::waitForContextThreads()
+{
+    for (auto &contextThread : mContextThreads)
+    {
+        contextThread.second->waitIdle();
+    }
+}
+
+void TraceInterpreter::stopContextThreads()
+{
+    mContextThreads.clear();
 }
 
-void TraceInterpreter::parseTraceUncompressed()
+void TraceInterpreter::parseTraceUncompressed(CallStreamWriter *callStreamWriter)
 {
     for (const std::string &file : gTraceInfo.traceFiles)
     {
@@ -552,9 +948,7 @@ void TraceInterpreter::parseTraceUncompressed()
         {
             printf("Parsing functions from %s\n", file.c_str());
         }
-        std::stringstream pathStream;
-        pathStream << gBinaryDataDir << GetPathSeparator() << file;
-        std::string path = pathStream.str();
+        std::string path = GetTraceFilePath(file);
 
         std::string fileData;
         if (!ReadFileToString(path, &fileData))
@@ -562,12 +956,13 @@ void TraceInterpreter::parseTraceUncompressed()
             UNREACHABLE();
         }
 
-        Parser parser(fileData, mTraceFunctions, mTraceStrings, mVerboseLogging);
+        Parser parser(fileData, mTraceFunctions, mTraceStrings, callStreamWriter,
+                      mVerboseLogging);
         parser.parse();
     }
 }
 
-void TraceInterpreter::parseTraceGz()
+void TraceInterpreter::parseTraceGz(CallStreamWriter *callStreamWriter)
 {
     if (mVerboseLogging)
     {
@@ -603,22 +998,137 @@ void TraceInterpreter::parseTraceGz()
         exit(1);
     }
 
-    Parser parser(uncompressedData, mTraceFunctions, mTraceStrings, mVerboseLogging);
+    Parser parser(uncompressedData, mTraceFunctions, mTraceStrings, callStreamWriter,
+                  mVerboseLogging);
     parser.parse();
 }
 
-void TraceInterpreter::setupReplay()
+bool TraceInterpreter::loadCallStream(uint64_t sourceHash)
 {
-    if (!gTraceGzPath.empty())
+    if (!mCallStreamFile.open(gTraceCallStreamPath.c_str()))
     {
-        parseTraceGz();
+        return false;
     }
-    else
+
+    mCallStream.reset(new CallStreamReader());
+    if (!mCallStream->init(mCallStreamFile.data(), mCallStreamFile.size()))
+    {
+        printf("Ignoring invalid call stream: %s\n", gTraceCallStreamPath.c_str());
+        mCallStream.reset();
+        mCallStreamFile.close();
+        return false;
+    }
+
+    if (mCallStream->getSourceHash() != sourceHash)
+    {
+        printf("Ignoring stale call stream: %s\n", gTraceCallStreamPath.c_str());
+        mCallStream.reset();
+        mCallStreamFile.close();
+        return false;
+    }
+
+    if (mVerboseLogging)
+    {
+        printf("Loaded %u functions from %s\n", mCallStream->getFunctionCount(),
+               gTraceCallStreamPath.c_str());
+    }
+
+    mDecodedFunctions.resize(mCallStream->getFunctionCount(), nullptr);
+
+    // Run initialize immediately so we can load the binary data before decoding pointers to it,
+    // like the parser does.
+    uint32_t functionIndex = 0;
+    if (mCallStream->findFunction("InitReplay", &functionIndex))
+    {
+        TraceFunction initFunc;
+        mCallStream->decodeFunction(functionIndex, &initFunc);
+        ReplayTraceFunction(initFunc, {});
+
+        mDecodedFunctions[functionIndex] = &mTraceFunctions["InitReplay"];
+    }
+
+    return true;
+}
+
+const TraceFunction *TraceInterpreter::getTraceFunction(const char *name)
+{
+    auto iter = mTraceFunctions.find(name);
+    if (iter != mTraceFunctions.end())
     {
-        parseTraceUncompressed();
+        return &iter->second;
     }
 
-    if (mTraceFunctions.count("SetupReplay") == 0)
+    uint32_t functionIndex = 0;
+    if (mCallStream && mCallStream->findFunction(name, &functionIndex))
+    {
+        return &decodeTraceFunction(functionIndex);
+    }
+
+    return nullptr;
+}
+
+const TraceFunction &TraceInterpreter::decodeTraceFunction(uint32_t functionIndex)
+{
+    if (mDecodedFunctions[functionIndex])
+    {
+        return *mDecodedFunctions[functionIndex];
+    }
+
+    TraceFunction &func = mTraceFunctions[mCallStream->getFunctionName(functionIndex)];
+    mDecodedFunctions[functionIndex] = &func;
+    mCallStream->decodeFunction(functionIndex, &func);
+
+    // Functions are replayed by name from within other functions, so decode the callees too.
+    for (const CallCapture &call : func)
+    {
+        uint32_t calleeIndex = 0;
+        if (call.entryPoint == EntryPoint::Invalid &&
+            mCallStream->findFunction(call.customFunctionName.c_str(), &calleeIndex))
+        {
+            decodeTraceFunction(calleeIndex);
+        }
+    }
+
+    return func;
+}
+
+void TraceInterpreter::setupReplay()
+{
+    uint64_t sourceHash = 0;
+    bool useCallStream  = !gTraceCallStreamPath.empty() && GetTraceSourceHash(&sourceHash);
+
+    if (!useCallStream || !loadCallStream(sourceHash))
+    {
+        // Write the call stream while parsing, so the next replay doesn't need to parse.
+        std::unique_ptr<CallStreamWriter> callStreamWriter;
+        if (useCallStream)
+        {
+            callStreamWriter.reset(new CallStreamWriter());
+        }
+
+        if (!gTraceGzPath.empty())
+        {
+            parseTraceGz(callStreamWriter.get());
+        }
+        else
+        {
+            parseTraceUncompressed(callStreamWriter.get());
+        }
+
+        if (callStreamWriter)
+        {
+            if (callStreamWriter->save(gTraceCallStreamPath, sourceHash))
+            {
+                printf("Saved call stream to %s\n", gTraceCallStreamPath.c_str());
+            }
+            else
+            {
+                printf("Could not save call stream to %s\n", gTraceCallStreamPath.c_str());
+            }
+        }
+    }
+
+    if (getTraceFunction("SetupReplay") == nullptr)
     {
         printf("Did not find a SetupReplay function to run among %zu parsed functions.\n",
                mTraceFunctions.size());
@@ -626,10 +1136,17 @@ void TraceInterpreter::setupReplay()
     }
 
     runTraceFunction("SetupReplay");
+
+    // The setup can enable storage writes for the frames that follow.
+    ReplaySchedule setupSchedule;
+    scheduleFunction(*getTraceFunction("SetupReplay"),
+                     static_cast<GLuint>(gTraceInfo.windowSurfaceContextId), &setupSchedule);
 }
 
 void TraceInterpreter::resetReplay()
 {
+    // Resetting makes the other contexts current on this thread.
+    stopContextThreads();
     runTraceFunction("ResetReplay");
 }
 
@@ -640,16 +1157,16 @@ const char *TraceInterpreter::getSerializedContextState(uint32_t frameIndex)
     return nullptr;
 }
 
-void TraceInterpreter::runTraceFunction(const char *name) const
+void TraceInterpreter::runTraceFunction(const char *name)
 {
-    auto iter = mTraceFunctions.find(name);
-    if (iter == mTraceFunctions.end())
+    const TraceFunction *func = getTraceFunction(name);
+    if (func == nullptr)
     {
         printf("Cannot find function: %s\n", name);
         UNREACHABLE();
+        return;
     }
-    const TraceFunction &func = iter->second;
-    ReplayTraceFunction(func, mTraceFunctions);
+    ReplayTraceFunction(*func, mTraceFunctions);
 }
 
 TraceInterpreter &GetInterpreter()
@@ -658,6 +1175,11 @@ TraceInterpreter &GetInterpreter()
         new TraceInterpreter());
     return *sTraceInterpreter.get()->get();
 }
+
+void StopInterpreterContextThreads()
+{
+    GetInterpreter().stopContextThreads();
+}
 }  // anonymous namespace
 
 template <>
@@ -1042,6 +1564,9 @@ extern "C" {
 void SetupReplay()
 {
     angle::GetInterpreter().setupReplay();
+
+    // The context threads must be stopped before the replay state is released.
+    gFinishReplayCallback = angle::StopInterpreterContextThreads;
 }
 
 void ReplayFrame(uint32_t frameIndex)
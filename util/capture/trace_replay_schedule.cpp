@@ -0,0 +1,235 @@
+//
+// Copyright 2024 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// trace_replay_schedule.cpp:
+//   Implements the splitting of frames for threaded replay.
+//
+
+#include "trace_replay_schedule.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "common/string_utils.h"
+
+namespace angle
+{
+namespace
+{
+constexpr char kContextMapPrefix[] = "gContextMap2[";
+
+bool BeginsWithAny(const char *name, const char *const *prefixes, size_t prefixCount)
+{
+    for (size_t prefixIndex = 0; prefixIndex < prefixCount; ++prefixIndex)
+    {
+        if (BeginsWith(name, prefixes[prefixIndex]))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+GLuint GetUIntParam(const CallCapture &call, size_t index)
+{
+    const ParamCapture &param = call.params.getParamCaptures()[index];
+    if (param.type == ParamType::TFramebufferID)
+    {
+        return param.value.FramebufferIDVal.value;
+    }
+    ASSERT(param.type == ParamType::TGLuint || param.type == ParamType::TGLenum);
+    return param.value.GLuintVal;
+}
+
+// Storage buffers, images and transform feedback let shaders write to buffers and textures.
+bool EnablesShaderWrites(const CallCapture &call)
+{
+    switch (call.entryPoint)
+    {
+        case EntryPoint::GLBeginTransformFeedback:
+        case EntryPoint::GLBindImageTexture:
+        case EntryPoint::GLBindImageTextures:
+            return true;
+        case EntryPoint::GLBindBufferBase:
+        case EntryPoint::GLBindBufferRange:
+        {
+            GLenum target = GetUIntParam(call, 0);
+            return target == GL_SHADER_STORAGE_BUFFER || target == GL_ATOMIC_COUNTER_BUFFER ||
+                   target == GL_TRANSFORM_FEEDBACK_BUFFER;
+        }
+        default:
+            return false;
+    }
+}
+
+void UpdateDrawFramebuffer(const CallCapture &call, ReplayScheduleState *state)
+{
+    if (call.entryPoint != EntryPoint::GLBindFramebuffer &&
+        call.entryPoint != EntryPoint::GLBindFramebufferOES)
+    {
+        return;
+    }
+
+    GLenum target = GetUIntParam(call, 0);
+    if (target != GL_FRAMEBUFFER && target != GL_DRAW_FRAMEBUFFER)
+    {
+        return;
+    }
+
+    if (GetUIntParam(call, 1) == 0)
+    {
+        state->defaultFramebufferContexts.insert(state->contextID);
+    }
+    else
+    {
+        state->defaultFramebufferContexts.erase(state->contextID);
+    }
+}
+}  // namespace
+
+bool IsMakeCurrentByContextID(const CallCapture &call)
+{
+    return call.entryPoint == EntryPoint::EGLMakeCurrent &&
+           call.params.getParamCaptures()[3].type == ParamType::TContextID;
+}
+
+GLuint GetMakeCurrentContextID(const CallCapture &call)
+{
+    return call.params.getParamCaptures()[3].value.ContextIDVal.value;
+}
+
+bool ParseMakeCurrentContextID(const char *contextToken, CallCapture *call)
+{
+    if (call->entryPoint != EntryPoint::EGLMakeCurrent ||
+        !BeginsWith(contextToken, kContextMapPrefix))
+    {
+        return false;
+    }
+
+    gl::ContextID contextID = {
+        static_cast<GLuint>(strtoul(&contextToken[strlen(kContextMapPrefix)], nullptr, 10))};
+    call->params.setValueParamAtIndex("ctx", ParamType::TContextID, contextID, 3);
+    return true;
+}
+
+// Besides the calls that the capture orders across contexts, this includes the calls that read or
+// write replay state shared by all contexts: the resource ID maps updated by most fixture
+// functions, the read buffer and the current program that uniform locations are looked up with.
+bool IsContextSyncPoint(const CallCapture &call)
+{
+    if (call.entryPoint == EntryPoint::Invalid)
+    {
+        return call.customFunctionName != "UpdateClientBufferData" &&
+               call.customFunctionName != "UpdateClientBufferDataWithOffset";
+    }
+
+    constexpr const char *kSyncPointPrefixes[] = {
+        "glFinish",     "glFlush",        "glFenceSync",    "glClientWaitSync",
+        "glWaitSync",   "glDeleteSync",   "eglCreateSync",  "eglClientWaitSync",
+        "eglWaitSync",  "eglDestroySync", "eglCreateImage", "eglDestroyImage",
+        "glCreate",     "glDelete",       "glGen",          "glGet",
+        "glReadPixels", "glReadnPixels",
+    };
+    if (BeginsWithAny(call.name(), kSyncPointPrefixes, ArraySize(kSyncPointPrefixes)))
+    {
+        return true;
+    }
+
+    for (const ParamCapture &param : call.params.getParamCaptures())
+    {
+        if (param.type == ParamType::TUniformLocation)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool WritesSharedObjects(const CallCapture &call, const ReplayScheduleState &state)
+{
+    // The client arrays updated by the fixture are read by the draws of all contexts.
+    if (call.entryPoint == EntryPoint::Invalid)
+    {
+        return true;
+    }
+
+    constexpr const char *kWritePrefixes[] = {
+        // Buffer data.
+        "glBufferData", "glBufferSubData", "glBufferStorage", "glCopyBufferSubData", "glMapBuffer",
+        "glUnmapBuffer", "glFlushMappedBufferRange",
+        // Texture data and parameters.
+        "glTexImage", "glTexSubImage", "glTexStorage", "glTexBuffer", "glTexParameter",
+        "glCompressedTex", "glCopyTex", "glCopyImageSubData", "glGenerateMipmap",
+        "glEGLImageTarget", "glSamplerParameter",
+        // Framebuffer attachments and their contents.
+        "glFramebufferTexture", "glFramebufferRenderbuffer", "glRenderbufferStorage",
+        "glBlitFramebuffer", "glInvalidate",
+        // Shaders and programs.
+        "glShaderSource", "glShaderBinary", "glCompileShader", "glAttachShader", "glDetachShader",
+        "glLinkProgram", "glProgramBinary", "glProgramParameter", "glBindAttribLocation",
+        "glUniformBlockBinding", "glTransformFeedbackVaryings",
+        // Compute shaders only produce results through writes to buffers and textures.
+        "glDispatchCompute",
+    };
+    const char *name = call.name();
+    if (BeginsWithAny(name, kWritePrefixes, ArraySize(kWritePrefixes)))
+    {
+        return true;
+    }
+
+    // Draws and clears write the attachments of the draw framebuffer, and with storage writes
+    // enabled, any buffer or texture.
+    constexpr const char *kDrawPrefixes[] = {"glDraw", "glMultiDraw", "glClearBuffer"};
+    bool isDraw = strcmp(name, "glClear") == 0 ||
+                  (BeginsWithAny(name, kDrawPrefixes, ArraySize(kDrawPrefixes)) &&
+                   !BeginsWith(name, "glDrawBuffers"));
+    if (isDraw)
+    {
+        return state.shaderWritesEnabled ||
+               state.defaultFramebufferContexts.count(state.contextID) == 0;
+    }
+
+    return false;
+}
+
+void ScheduleTraceFunction(const TraceFunction &func,
+                           const TraceFunctionMap &customFunctions,
+                           ReplayScheduleState *state,
+                           ReplaySchedule *schedule)
+{
+    for (const CallCapture &call : func)
+    {
+        if (IsMakeCurrentByContextID(call))
+        {
+            // Each thread keeps its context current.
+            state->contextID = GetMakeCurrentContextID(call);
+            continue;
+        }
+
+        auto iter = customFunctions.find(call.customFunctionName);
+        if (call.entryPoint == EntryPoint::Invalid && iter != customFunctions.end())
+        {
+            ScheduleTraceFunction(iter->second, customFunctions, state, schedule);
+            continue;
+        }
+
+        UpdateDrawFramebuffer(call, state);
+        state->shaderWritesEnabled = state->shaderWritesEnabled || EnablesShaderWrites(call);
+
+        if (schedule->empty() || schedule->back().contextID != state->contextID)
+        {
+            schedule->emplace_back();
+            schedule->back().contextID = state->contextID;
+        }
+
+        ReplaySegment &segment = schedule->back();
+        segment.calls.push_back(&call);
+        segment.isSyncPoint = segment.isSyncPoint || IsContextSyncPoint(call);
+        segment.writesSharedObjects =
+            segment.writesSharedObjects || WritesSharedObjects(call, *state);
+    }
+}
+}  // namespace angle
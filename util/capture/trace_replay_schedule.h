@@ -0,0 +1,73 @@
+//
+// Copyright 2024 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// trace_replay_schedule.h:
+//   Splits the calls of a frame where the capture switches contexts, so the interpreter can
+//   replay each context on its own thread.
+//
+//   A context switch orders the segments of the contexts involved, like it does in the captured
+//   application.  Segments of different contexts are only allowed to overlap when neither writes
+//   objects that are shared between the contexts.
+//
+
+#ifndef ANGLE_TRACE_REPLAY_SCHEDULE_H_
+#define ANGLE_TRACE_REPLAY_SCHEDULE_H_
+
+#include <set>
+#include <vector>
+
+#include "frame_capture_test_utils.h"
+
+namespace angle
+{
+struct ReplaySegment
+{
+    GLuint contextID = 0;
+    std::vector<const CallCapture *> calls;
+    // Segments that synchronize with other contexts are replayed once the previous segments of all
+    // contexts are done, and before any of the following segments start.
+    bool isSyncPoint = false;
+    // Segments that write shared objects don't overlap with the segments of other contexts.
+    bool writesSharedObjects = false;
+};
+using ReplaySchedule = std::vector<ReplaySegment>;
+
+// What the scheduler knows of the replay state, which decides whether calls write shared objects.
+struct ReplayScheduleState
+{
+    // The context the next calls are replayed on.
+    GLuint contextID = 0;
+    // The contexts that are known to draw to their default framebuffer, which is not shared with
+    // other contexts.  Draws to framebuffer objects write the attached textures and renderbuffers.
+    std::set<GLuint> defaultFramebufferContexts;
+    // Set once storage buffers, images or transform feedback are bound, after which any draw or
+    // dispatch may write to buffers and textures.
+    bool shaderWritesEnabled = false;
+};
+
+bool IsMakeCurrentByContextID(const CallCapture &call);
+GLuint GetMakeCurrentContextID(const CallCapture &call);
+
+// Contexts are made current by ID, because they are only created during the replay.  Turns the
+// context parameter of a parsed eglMakeCurrent into a TContextID if it names an entry of
+// gContextMap2.
+bool ParseMakeCurrentContextID(const char *contextToken, CallCapture *call);
+
+// Returns true for the calls that the capture orders across contexts, and the calls that read or
+// write replay state shared by all contexts.
+bool IsContextSyncPoint(const CallCapture &call);
+
+// Returns true for the calls that write buffer or texture data, framebuffer attachments or other
+// objects that another context could be using.
+bool WritesSharedObjects(const CallCapture &call, const ReplayScheduleState &state);
+
+// Appends the calls of |func| to |schedule|, expanding the calls to other trace functions.
+void ScheduleTraceFunction(const TraceFunction &func,
+                           const TraceFunctionMap &customFunctions,
+                           ReplayScheduleState *state,
+                           ReplaySchedule *schedule);
+}  // namespace angle
+
+#endif  // ANGLE_TRACE_REPLAY_SCHEDULE_H_
@@ -0,0 +1,219 @@
+//
+// Copyright 2024 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// trace_replay_schedule_unittest.cpp: Tests splitting frames for threaded replay.
+
+#include <gtest/gtest.h>
+
+#include "trace_replay_schedule.h"
+
+using namespace angle;
+
+namespace
+{
+constexpr GLuint kMainContext  = 1;
+constexpr GLuint kOtherContext = 2;
+
+CallCapture MakeCall(EntryPoint entryPoint)
+{
+    return CallCapture(entryPoint, ParamBuffer());
+}
+
+CallCapture MakeEnumCall(EntryPoint entryPoint, GLenum target, GLuint value)
+{
+    ParamBuffer params;
+    params.addUnnamedParam(ParamType::TGLuint, static_cast<GLuint>(target));
+    params.addUnnamedParam(ParamType::TGLuint, value);
+    return CallCapture(entryPoint, std::move(params));
+}
+
+// Makes an eglMakeCurrent call like the parser does, with the context taken from |contextToken|.
+CallCapture MakeCurrentCall(const char *contextToken)
+{
+    ParamBuffer params;
+    for (int paramIndex = 0; paramIndex < 4; ++paramIndex)
+    {
+        params.addUnnamedParam(ParamType::TvoidPointer, static_cast<void *>(nullptr));
+    }
+    CallCapture call(EntryPoint::EGLMakeCurrent, std::move(params));
+    ParseMakeCurrentContextID(contextToken, &call);
+    return call;
+}
+
+ReplaySchedule Schedule(const TraceFunction &func,
+                        const TraceFunctionMap &customFunctions,
+                        ReplayScheduleState *state)
+{
+    ReplaySchedule schedule;
+    ScheduleTraceFunction(func, customFunctions, state, &schedule);
+    return schedule;
+}
+
+// Tests that eglMakeCurrent calls with a context from gContextMap2 are made current by ID.
+TEST(TraceReplayScheduleTest, ParseMakeCurrentContextID)
+{
+    CallCapture byID = MakeCurrentCall("gContextMap2[7]");
+    EXPECT_TRUE(IsMakeCurrentByContextID(byID));
+    EXPECT_EQ(GetMakeCurrentContextID(byID), 7u);
+
+    CallCapture noContext = MakeCurrentCall("EGL_NO_CONTEXT");
+    EXPECT_FALSE(IsMakeCurrentByContextID(noContext));
+    EXPECT_EQ(noContext.params.getParamCaptures()[3].type, ParamType::TvoidPointer);
+
+    CallCapture other = MakeEnumCall(EntryPoint::GLBindFramebuffer, GL_FRAMEBUFFER, 0);
+    EXPECT_FALSE(ParseMakeCurrentContextID("gContextMap2[7]", &other));
+    EXPECT_FALSE(IsMakeCurrentByContextID(other));
+}
+
+// Tests which calls synchronize the contexts.
+TEST(TraceReplayScheduleTest, IsContextSyncPoint)
+{
+    EXPECT_TRUE(IsContextSyncPoint(MakeCall(EntryPoint::GLFinish)));
+    EXPECT_TRUE(IsContextSyncPoint(MakeCall(EntryPoint::GLFenceSync)));
+    EXPECT_TRUE(IsContextSyncPoint(MakeCall(EntryPoint::GLGenBuffers)));
+    EXPECT_TRUE(IsContextSyncPoint(MakeCall(EntryPoint::GLDeleteTextures)));
+    EXPECT_TRUE(IsContextSyncPoint(MakeCall(EntryPoint::GLGetIntegerv)));
+    EXPECT_TRUE(IsContextSyncPoint(MakeCall(EntryPoint::GLReadPixels)));
+    EXPECT_TRUE(IsContextSyncPoint(CallCapture("UpdateResourceIDBuffer", ParamBuffer())));
+
+    ParamBuffer uniformParams;
+    uniformParams.addUnnamedParam(ParamType::TUniformLocation, gl::UniformLocation{3});
+    uniformParams.addUnnamedParam(ParamType::TGLfloat, 1.0f);
+    EXPECT_TRUE(IsContextSyncPoint(CallCapture(EntryPoint::GLUniform1f, std::move(uniformParams))));
+
+    EXPECT_FALSE(IsContextSyncPoint(CallCapture("UpdateClientBufferData", ParamBuffer())));
+    EXPECT_FALSE(
+        IsContextSyncPoint(CallCapture("UpdateClientBufferDataWithOffset", ParamBuffer())));
+    EXPECT_FALSE(IsContextSyncPoint(MakeCall(EntryPoint::GLDrawArrays)));
+    EXPECT_FALSE(IsContextSyncPoint(MakeCall(EntryPoint::GLBufferSubData)));
+    EXPECT_FALSE(IsContextSyncPoint(MakeCall(EntryPoint::GLTexSubImage2D)));
+}
+
+// Tests which calls write objects shared between contexts.
+TEST(TraceReplayScheduleTest, WritesSharedObjects)
+{
+    ReplayScheduleState state;
+    state.contextID = kMainContext;
+
+    EXPECT_TRUE(WritesSharedObjects(MakeCall(EntryPoint::GLBufferSubData), state));
+    EXPECT_TRUE(WritesSharedObjects(MakeCall(EntryPoint::GLTexSubImage2D), state));
+    EXPECT_TRUE(WritesSharedObjects(MakeCall(EntryPoint::GLFramebufferTexture2D), state));
+    EXPECT_TRUE(WritesSharedObjects(MakeCall(EntryPoint::GLGenerateMipmap), state));
+    EXPECT_TRUE(WritesSharedObjects(CallCapture("UpdateClientBufferData", ParamBuffer()), state));
+    EXPECT_FALSE(WritesSharedObjects(MakeCall(EntryPoint::GLBindTexture), state));
+    EXPECT_FALSE(WritesSharedObjects(MakeCall(EntryPoint::GLClearColor), state));
+    EXPECT_FALSE(WritesSharedObjects(MakeCall(EntryPoint::GLDrawBuffers), state));
+
+    // Without knowing which framebuffer is bound, draws may write to shared textures.
+    EXPECT_TRUE(WritesSharedObjects(MakeCall(EntryPoint::GLDrawArrays), state));
+    EXPECT_TRUE(WritesSharedObjects(MakeCall(EntryPoint::GLClear), state));
+
+    state.defaultFramebufferContexts.insert(kMainContext);
+    EXPECT_FALSE(WritesSharedObjects(MakeCall(EntryPoint::GLDrawArrays), state));
+    EXPECT_FALSE(WritesSharedObjects(MakeCall(EntryPoint::GLDrawElementsInstanced), state));
+    EXPECT_FALSE(WritesSharedObjects(MakeCall(EntryPoint::GLClear), state));
+
+    state.shaderWritesEnabled = true;
+    EXPECT_TRUE(WritesSharedObjects(MakeCall(EntryPoint::GLDrawArrays), state));
+}
+
+// Tests that frames are split where the context changes, including within called functions.
+TEST(TraceReplayScheduleTest, SplitsOnContextSwitch)
+{
+    TraceFunctionMap customFunctions;
+    customFunctions["UploadTexture"].push_back(MakeCall(EntryPoint::GLTexSubImage2D));
+
+    TraceFunction frame;
+    frame.push_back(MakeCall(EntryPoint::GLBindTexture));
+    frame.push_back(MakeCurrentCall("gContextMap2[2]"));
+    frame.push_back(MakeCall(EntryPoint::GLBufferSubData));
+    frame.push_back(CallCapture("UploadTexture", ParamBuffer()));
+    frame.push_back(MakeCurrentCall("gContextMap2[2]"));
+    frame.push_back(MakeCall(EntryPoint::GLBindBuffer));
+    frame.push_back(MakeCurrentCall("gContextMap2[1]"));
+    frame.push_back(MakeCall(EntryPoint::GLFinish));
+
+    ReplayScheduleState state;
+    state.contextID         = kMainContext;
+    ReplaySchedule schedule = Schedule(frame, customFunctions, &state);
+    EXPECT_EQ(state.contextID, kMainContext);
+
+    ASSERT_EQ(schedule.size(), 3u);
+
+    EXPECT_EQ(schedule[0].contextID, kMainContext);
+    ASSERT_EQ(schedule[0].calls.size(), 1u);
+    EXPECT_EQ(schedule[0].calls[0], &frame[0]);
+    EXPECT_FALSE(schedule[0].isSyncPoint);
+    EXPECT_FALSE(schedule[0].writesSharedObjects);
+
+    EXPECT_EQ(schedule[1].contextID, kOtherContext);
+    ASSERT_EQ(schedule[1].calls.size(), 3u);
+    EXPECT_EQ(schedule[1].calls[0], &frame[2]);
+    EXPECT_EQ(schedule[1].calls[1], &customFunctions["UploadTexture"][0]);
+    EXPECT_EQ(schedule[1].calls[2], &frame[5]);
+    EXPECT_FALSE(schedule[1].isSyncPoint);
+    EXPECT_TRUE(schedule[1].writesSharedObjects);
+
+    EXPECT_EQ(schedule[2].contextID, kMainContext);
+    ASSERT_EQ(schedule[2].calls.size(), 1u);
+    EXPECT_TRUE(schedule[2].isSyncPoint);
+}
+
+// Tests that draws are only scheduled as writes while a framebuffer object may be bound.
+TEST(TraceReplayScheduleTest, TracksDrawFramebuffer)
+{
+    TraceFunction frame;
+    frame.push_back(MakeEnumCall(EntryPoint::GLBindFramebuffer, GL_FRAMEBUFFER, 0));
+    frame.push_back(MakeCall(EntryPoint::GLDrawArrays));
+    frame.push_back(MakeCurrentCall("gContextMap2[2]"));
+    frame.push_back(MakeCall(EntryPoint::GLDrawArrays));
+    frame.push_back(MakeCurrentCall("gContextMap2[1]"));
+    frame.push_back(MakeEnumCall(EntryPoint::GLBindFramebuffer, GL_READ_FRAMEBUFFER, 4));
+    frame.push_back(MakeCall(EntryPoint::GLDrawArrays));
+    frame.push_back(MakeCurrentCall("gContextMap2[2]"));
+    frame.push_back(MakeEnumCall(EntryPoint::GLBindFramebuffer, GL_DRAW_FRAMEBUFFER, 0));
+    frame.push_back(MakeCall(EntryPoint::GLDrawArrays));
+    frame.push_back(MakeCurrentCall("gContextMap2[1]"));
+    frame.push_back(MakeEnumCall(EntryPoint::GLBindFramebuffer, GL_FRAMEBUFFER, 4));
+    frame.push_back(MakeCall(EntryPoint::GLDrawArrays));
+
+    ReplayScheduleState state;
+    state.contextID         = kMainContext;
+    ReplaySchedule schedule = Schedule(frame, {}, &state);
+
+    ASSERT_EQ(schedule.size(), 5u);
+    EXPECT_FALSE(schedule[0].writesSharedObjects);
+    EXPECT_TRUE(schedule[1].writesSharedObjects);
+    EXPECT_FALSE(schedule[2].writesSharedObjects);
+    EXPECT_FALSE(schedule[3].writesSharedObjects);
+    EXPECT_TRUE(schedule[4].writesSharedObjects);
+}
+
+// Tests that binding storage buffers makes all following draws write shared objects.
+TEST(TraceReplayScheduleTest, TracksShaderWrites)
+{
+    TraceFunction frame;
+    frame.push_back(MakeEnumCall(EntryPoint::GLBindFramebuffer, GL_FRAMEBUFFER, 0));
+    frame.push_back(MakeCall(EntryPoint::GLDrawArrays));
+    frame.push_back(MakeCurrentCall("gContextMap2[2]"));
+    frame.push_back(MakeEnumCall(EntryPoint::GLBindBufferBase, GL_UNIFORM_BUFFER, 0));
+    frame.push_back(MakeCurrentCall("gContextMap2[1]"));
+    frame.push_back(MakeCall(EntryPoint::GLDrawArrays));
+    frame.push_back(MakeCurrentCall("gContextMap2[2]"));
+    frame.push_back(MakeEnumCall(EntryPoint::GLBindBufferBase, GL_SHADER_STORAGE_BUFFER, 0));
+    frame.push_back(MakeCurrentCall("gContextMap2[1]"));
+    frame.push_back(MakeCall(EntryPoint::GLDrawArrays));
+
+    ReplayScheduleState state;
+    state.contextID         = kMainContext;
+    ReplaySchedule schedule = Schedule(frame, {}, &state);
+    EXPECT_TRUE(state.shaderWritesEnabled);
+
+    ASSERT_EQ(schedule.size(), 5u);
+    EXPECT_FALSE(schedule[0].writesSharedObjects);
+    EXPECT_FALSE(schedule[2].writesSharedObjects);
+    EXPECT_TRUE(schedule[4].writesSharedObjects);
+}
+}  // namespace